@@ -0,0 +1,47 @@
+########################################################################
+# Find FFTW3F (single precision FFTW, already required by gnuradio-fft)
+#
+# FFTW3F_FOUND - System has FFTW3F
+# FFTW3F_INCLUDE_DIRS - The FFTW3F include directories
+# FFTW3F_LIBRARIES - Link to this
+# FFTW3F_THREADS_LIBRARIES - Link to this for multithreaded plans (if found)
+########################################################################
+
+INCLUDE(FindPkgConfig)
+PKG_CHECK_MODULES(PC_FFTW3F fftw3f)
+
+FIND_PATH(
+    FFTW3F_INCLUDE_DIRS
+    NAMES fftw3.h
+    HINTS $ENV{FFTW3_DIR}/include
+          ${PC_FFTW3F_INCLUDEDIR}
+    PATHS /usr/local/include
+          /usr/include
+          /opt/local/include
+)
+
+FIND_LIBRARY(
+    FFTW3F_LIBRARIES
+    NAMES fftw3f libfftw3f
+    HINTS $ENV{FFTW3_DIR}/lib
+          ${PC_FFTW3F_LIBDIR}
+    PATHS /usr/local/lib
+          /usr/lib
+          /usr/lib64
+          /opt/local/lib
+)
+
+FIND_LIBRARY(
+    FFTW3F_THREADS_LIBRARIES
+    NAMES fftw3f_threads libfftw3f_threads
+    HINTS $ENV{FFTW3_DIR}/lib
+          ${PC_FFTW3F_LIBDIR}
+    PATHS /usr/local/lib
+          /usr/lib
+          /usr/lib64
+          /opt/local/lib
+)
+
+INCLUDE(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(FFTW3F DEFAULT_MSG FFTW3F_LIBRARIES FFTW3F_INCLUDE_DIRS)
+MARK_AS_ADVANCED(FFTW3F_LIBRARIES FFTW3F_THREADS_LIBRARIES FFTW3F_INCLUDE_DIRS)
@@ -88,6 +88,10 @@ GalileoE1Pvt::GalileoE1Pvt(ConfigurationInterface* configuration,
             rtcm_msg_rate_ms[k] = rtcm_MSM_rate_ms;
         }
 
+    // Receiver state kept for a hot restart
+    std::string state_filename = configuration->property(role + ".state_file", std::string(""));
+    int state_rate_ms = configuration->property(role + ".state_rate_ms", 10000);
+
     // make PVT object
     pvt_ = galileo_e1_make_pvt_cc(in_streams_,
             dump_,
@@ -104,7 +108,9 @@ GalileoE1Pvt::GalileoE1Pvt(ConfigurationInterface* configuration,
             rtcm_tcp_port,
             rtcm_station_id,
             rtcm_msg_rate_ms,
-            rtcm_dump_devname);
+            rtcm_dump_devname,
+            state_filename,
+            state_rate_ms);
 
     DLOG(INFO) << "pvt(" << pvt_->unique_id() << ")";
 }
@@ -103,6 +103,10 @@ GpsL1CaPvt::GpsL1CaPvt(ConfigurationInterface* configuration,
     //std::string ref_time_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ref_time_xml", ref_time_default_xml_filename);
     //std::string ref_location_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ref_location_xml", ref_location_default_xml_filename);
 
+    // Receiver state kept for a hot restart
+    std::string state_filename = configuration->property(role + ".state_file", std::string(""));
+    int state_rate_ms = configuration->property(role + ".state_rate_ms", 10000);
+
     // make PVT object
     pvt_ = gps_l1_ca_make_pvt_cc(in_streams_,
             dump_,
@@ -119,7 +123,9 @@ GpsL1CaPvt::GpsL1CaPvt(ConfigurationInterface* configuration,
             rtcm_tcp_port,
             rtcm_station_id,
             rtcm_msg_rate_ms,
-            rtcm_dump_devname );
+            rtcm_dump_devname,
+            state_filename,
+            state_rate_ms);
 
     DLOG(INFO) << "pvt(" << pvt_->unique_id() << ")";
 }
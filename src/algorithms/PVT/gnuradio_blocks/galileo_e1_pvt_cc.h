@@ -32,6 +32,7 @@
 #define GNSS_SDR_GALILEO_E1_PVT_CC_H
 
 #include <fstream>
+#include <memory>
 #include <string>
 #include <utility>
 #include <gnuradio/block.h>
@@ -41,6 +42,7 @@
 #include "geojson_printer.h"
 #include "rtcm_printer.h"
 #include "galileo_e1_ls_pvt.h"
+#include "gnss_receiver_state.h"
 
 
 class galileo_e1_pvt_cc;
@@ -62,7 +64,9 @@ galileo_e1_pvt_cc_sptr galileo_e1_make_pvt_cc(unsigned int n_channels,
                                               unsigned short rtcm_tcp_port,
                                               unsigned short rtcm_station_id,
                                               std::map<int,int> rtcm_msg_rate_ms,
-                                              std::string rtcm_dump_devname);
+                                              std::string rtcm_dump_devname,
+                                              std::string state_filename,
+                                              int state_rate_ms);
 
 /*!
  * \brief This class implements a block that computes the PVT solution with Galileo E1 signals
@@ -85,7 +89,9 @@ private:
                                                          unsigned short rtcm_tcp_port,
                                                          unsigned short rtcm_station_id,
                                                          std::map<int,int> rtcm_msg_rate_ms,
-                                                         std::string rtcm_dump_devname);
+                                                         std::string rtcm_dump_devname,
+                                                         std::string state_filename,
+                                                         int state_rate_ms);
     galileo_e1_pvt_cc(unsigned int nchannels,
                       bool dump, std::string dump_filename,
                       int averaging_depth,
@@ -100,7 +106,9 @@ private:
                       unsigned short rtcm_tcp_port,
                       unsigned short rtcm_station_id,
                       std::map<int,int> rtcm_msg_rate_ms,
-                      std::string rtcm_dump_devname);
+                      std::string rtcm_dump_devname,
+                      std::string state_filename,
+                      int state_rate_ms);
 
     void msg_handler_telemetry(pmt::pmt_t msg);
 
@@ -132,6 +140,16 @@ private:
 
     double d_rx_time;
     std::shared_ptr<galileo_e1_ls_pvt> d_ls_pvt;
+
+    // Navigation data and last fix kept for a hot restart
+    void load_state();
+    void save_state();
+    Gnss_Receiver_State d_state;
+    std::string d_state_filename;
+    int d_state_rate_ms;
+    double d_state_saved_rx_time;
+    std::unique_ptr<Gnss_Receiver_State_Writer> d_state_writer;
+
     bool pseudoranges_pairCompare_min(const std::pair<int,Gnss_Synchro>& a, const std::pair<int,Gnss_Synchro>& b);
 
 public:
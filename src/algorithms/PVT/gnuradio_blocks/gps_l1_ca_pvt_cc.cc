@@ -29,9 +29,13 @@
 
 #include "gps_l1_ca_pvt_cc.h"
 #include <algorithm>
+#include <cmath>
+#include <ctime>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <utility>
+#include <vector>
 #include <boost/math/common_factor_rt.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <gnuradio/gr_complex.h>
@@ -40,9 +44,18 @@
 #include "concurrent_map.h"
 #include "sbas_telemetry_data.h"
 #include "sbas_ionospheric_correction.h"
+#include "gps_ref_location.h"
+#include "gps_ref_time.h"
+#include "gps_acq_assist.h"
 
 using google::LogMessage;
 
+extern concurrent_map<Gps_Ephemeris> global_gps_ephemeris_map;
+extern concurrent_map<Gps_Ref_Location> global_gps_ref_location_map;
+extern concurrent_map<Gps_Ref_Time> global_gps_ref_time_map;
+extern concurrent_map<Gnss_Synchro> global_channel_synchro_map;
+extern concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
+
 gps_l1_ca_pvt_cc_sptr
 gps_l1_ca_make_pvt_cc(unsigned int nchannels,
         bool dump, std::string dump_filename,
@@ -58,7 +71,9 @@ gps_l1_ca_make_pvt_cc(unsigned int nchannels,
         unsigned short rtcm_tcp_port,
         unsigned short rtcm_station_id,
         std::map<int,int> rtcm_msg_rate_ms,
-        std::string rtcm_dump_devname)
+        std::string rtcm_dump_devname,
+        std::string state_filename,
+        int state_rate_ms)
 {
     return gps_l1_ca_pvt_cc_sptr(new gps_l1_ca_pvt_cc(nchannels,
             dump,
@@ -75,7 +90,9 @@ gps_l1_ca_make_pvt_cc(unsigned int nchannels,
             rtcm_tcp_port,
             rtcm_station_id,
             rtcm_msg_rate_ms,
-            rtcm_dump_devname));
+            rtcm_dump_devname,
+            state_filename,
+            state_rate_ms));
 }
 
 
@@ -94,6 +111,7 @@ void gps_l1_ca_pvt_cc::msg_handler_telemetry(pmt::pmt_t msg)
                             << gps_eph->i_GPS_week;
                     // update/insert new ephemeris record to the global ephemeris map
                     d_ls_pvt->gps_ephemeris_map[gps_eph->i_satellite_PRN] = *gps_eph;
+                    global_gps_ephemeris_map.write(gps_eph->i_satellite_PRN, *gps_eph);
                 }
             else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gps_Iono>) )
                 {
@@ -162,6 +180,23 @@ void gps_l1_ca_pvt_cc::msg_handler_telemetry(pmt::pmt_t msg)
                             rp->log_rinex_sbs(rp->sbsFile, sbas_raw_msg);
                         }
                 }
+            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gps_CNAV_Ephemeris>) )
+                {
+                    // ### GPS CNAV EPHEMERIS ###
+                    // Not used by the solution yet, only kept in the receiver state
+                    std::shared_ptr<Gps_CNAV_Ephemeris> gps_cnav_eph;
+                    gps_cnav_eph = boost::any_cast<std::shared_ptr<Gps_CNAV_Ephemeris>>(pmt::any_ref(msg));
+                    d_state.gps_cnav_ephemeris_map[gps_cnav_eph->i_satellite_PRN] = *gps_cnav_eph;
+                    DLOG(INFO) << "New CNAV ephemeris record has arrived from SAT ID " << gps_cnav_eph->i_satellite_PRN;
+                }
+            else if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gps_CNAV_Iono>) )
+                {
+                    // ### GPS CNAV IONO ###
+                    std::shared_ptr<Gps_CNAV_Iono> gps_cnav_iono;
+                    gps_cnav_iono = boost::any_cast<std::shared_ptr<Gps_CNAV_Iono>>(pmt::any_ref(msg));
+                    d_state.gps_cnav_iono = *gps_cnav_iono;
+                    DLOG(INFO) << "New CNAV IONO record has arrived ";
+                }
             else
                 {
                     LOG(WARNING) << "msg_handler_telemetry unknown object type!";
@@ -193,7 +228,9 @@ gps_l1_ca_pvt_cc::gps_l1_ca_pvt_cc(unsigned int nchannels,
         unsigned short rtcm_tcp_port,
         unsigned short rtcm_station_id,
         std::map<int,int> rtcm_msg_rate_ms,
-        std::string rtcm_dump_devname) :
+        std::string rtcm_dump_devname,
+        std::string state_filename,
+        int state_rate_ms) :
              gr::block("gps_l1_ca_pvt_cc", gr::io_signature::make(nchannels, nchannels,  sizeof(Gnss_Synchro)),
              gr::io_signature::make(0, 0, sizeof(gr_complex)) )
 {
@@ -208,6 +245,8 @@ gps_l1_ca_pvt_cc::gps_l1_ca_pvt_cc(unsigned int nchannels,
     this->message_port_register_in(pmt::mp("telemetry"));
     this->set_msg_handler(pmt::mp("telemetry"),
             boost::bind(&gps_l1_ca_pvt_cc::msg_handler_telemetry, this, _1));
+    // Vector tracking aids message port out
+    this->message_port_register_out(pmt::mp("vector_aid"));
 
     //initialize kml_printer
     std::string kml_dump_filename;
@@ -256,6 +295,15 @@ gps_l1_ca_pvt_cc::gps_l1_ca_pvt_cc(unsigned int nchannels,
     d_ls_pvt = std::make_shared<gps_l1_ca_ls_pvt>((int)nchannels, dump_ls_pvt_filename, d_dump);
     d_ls_pvt->set_averaging_depth(d_averaging_depth);
 
+    d_state_filename = state_filename;
+    d_state_rate_ms = state_rate_ms;
+    d_state_saved_rx_time = 0.0;
+    if (!d_state_filename.empty())
+        {
+            load_state();
+            d_state_writer.reset(new Gnss_Receiver_State_Writer(d_state_filename));
+        }
+
     d_sample_counter = 0;
     d_last_sample_nav_output = 0;
     d_rx_time = 0.0;
@@ -288,7 +336,90 @@ gps_l1_ca_pvt_cc::gps_l1_ca_pvt_cc(unsigned int nchannels,
 
 
 gps_l1_ca_pvt_cc::~gps_l1_ca_pvt_cc()
-{}
+{
+    // Without a fix in this run the file already holds the best state
+    if (!d_state_filename.empty() && d_state.position_valid)
+        {
+            save_state();
+        }
+}
+
+
+void gps_l1_ca_pvt_cc::load_state()
+{
+    // Only the data this block keeps up to date are saved again, so that the
+    // file does not carry the data of constellations that are not tracked
+    Gnss_Receiver_State state;
+    if (!state.load(d_state_filename))
+        {
+            LOG(INFO) << "No receiver state could be read from " << d_state_filename;
+            return;
+        }
+    double now = static_cast<double>(std::time(0));
+    LOG(INFO) << "Receiver state read from " << d_state_filename << ", saved " << state.age(now) << " s ago";
+    // Each ephemeris is only used within its own validity interval, which
+    // can end before or after the state was saved
+    unsigned int stale = state.remove_stale_ephemerides(now);
+    if (stale > 0)
+        {
+            LOG(INFO) << stale << " ephemerides in the receiver state are too old to be used";
+        }
+    d_state.gps_cnav_ephemeris_map = state.gps_cnav_ephemeris_map;
+    d_ls_pvt->gps_ephemeris_map = state.gps_ephemeris_map;
+    for (std::map<int,Gps_Ephemeris>::const_iterator it = state.gps_ephemeris_map.begin(); it != state.gps_ephemeris_map.end(); ++it)
+        {
+            global_gps_ephemeris_map.write(it->first, it->second);
+        }
+    if (state.models_usable(now))
+        {
+            d_state.gps_cnav_iono = state.gps_cnav_iono;
+            d_ls_pvt->gps_iono = state.gps_iono;
+            d_ls_pvt->gps_utc_model = state.gps_utc_model;
+        }
+    if (state.position_valid)
+        {
+            Gps_Ref_Location ref_location;
+            ref_location.valid = true;
+            ref_location.lat = state.latitude_deg;
+            ref_location.lon = state.longitude_deg;
+            ref_location.uncertainty = 100.0;
+            global_gps_ref_location_map.write(0, ref_location);
+            Gps_Ref_Time ref_time;
+            ref_time.valid = true;
+            ref_time.d_TOW = state.rx_time;
+            ref_time.d_tv_sec = state.saved_at;
+            global_gps_ref_time_map.write(0, ref_time);
+        }
+
+    // The last Doppler values include the receiver clock drift, so while they
+    // are fresh they are better than any prediction from the orbits
+    if (state.doppler_usable(now))
+        {
+            for (unsigned int prn = 1; prn <= 32; prn++)
+                {
+                    double doppler;
+                    if (state.get_doppler('G', "1C", prn, doppler))
+                        {
+                            Gps_Acq_Assist acq_assist;
+                            acq_assist.i_satellite_PRN = prn;
+                            acq_assist.d_TOW = state.rx_time;
+                            acq_assist.d_Doppler0 = doppler;
+                            acq_assist.dopplerUncertainty = state.doppler_uncertainty(now);
+                            global_gps_acq_assist_map.write(prn, acq_assist);
+                        }
+                }
+        }
+}
+
+
+void gps_l1_ca_pvt_cc::save_state()
+{
+    d_state.gps_ephemeris_map = d_ls_pvt->gps_ephemeris_map;
+    d_state.gps_iono = d_ls_pvt->gps_iono;
+    d_state.gps_utc_model = d_ls_pvt->gps_utc_model;
+    // The file is written by another thread, away from the signal processing
+    d_state_writer->write(d_state);
+}
 
 
 bool pseudoranges_pairCompare_min(const std::pair<int,Gnss_Synchro>& a, const std::pair<int,Gnss_Synchro>& b)
@@ -338,6 +469,18 @@ int gps_l1_ca_pvt_cc::general_work (int noutput_items __attribute__((unused)), g
                 }
         }
 
+    // Last C/N0 of each tracking channel, used by the flowgraph to rank the signals
+    if ((d_sample_counter % d_output_rate_ms) == 0)
+        {
+            for (unsigned int i = 0; i < d_nchannels; i++)
+                {
+                    if (in[i][0].Flag_valid_pseudorange == true)
+                        {
+                            global_channel_synchro_map.write(i, in[i][0]);
+                        }
+                }
+        }
+
     // ############ 2 COMPUTE THE PVT ################################
     if (gnss_pseudoranges_map.size() > 0 and d_ls_pvt->gps_ephemeris_map.size() > 0)
         {
@@ -353,6 +496,36 @@ int gps_l1_ca_pvt_cc::general_work (int noutput_items __attribute__((unused)), g
                             d_geojson_printer->print_position(d_ls_pvt, d_flag_averaging);
                             d_nmea_printer->Print_Nmea_Line(d_ls_pvt, d_flag_averaging);
 
+                            // Feed the solution back to the vector tracking loops
+                            for (std::vector<Gnss_Vector_Aid>::const_iterator aid = d_ls_pvt->d_vector_aids.begin(); aid != d_ls_pvt->d_vector_aids.end(); ++aid)
+                                {
+                                    this->message_port_pub(pmt::mp("vector_aid"), pmt::make_any(std::make_shared<Gnss_Vector_Aid>(*aid)));
+                                }
+
+                            // Keep the last fix for the local acquisition assistance
+                            Gps_Ref_Location ref_location;
+                            ref_location.valid = true;
+                            ref_location.lat = d_ls_pvt->d_latitude_d;
+                            ref_location.lon = d_ls_pvt->d_longitude_d;
+                            ref_location.uncertainty = 100.0;
+                            global_gps_ref_location_map.write(0, ref_location);
+                            Gps_Ref_Time ref_time;
+                            ref_time.valid = true;
+                            ref_time.d_TOW = d_rx_time;
+                            ref_time.d_tv_sec = static_cast<double>(std::time(0));
+                            global_gps_ref_time_map.write(0, ref_time);
+
+                            if (!d_state_filename.empty())
+                                {
+                                    d_state.set_fix(d_rx_time, d_ls_pvt->d_latitude_d, d_ls_pvt->d_longitude_d, d_ls_pvt->d_height_m, d_ls_pvt->d_rx_dt_m);
+                                    d_state.set_observations(gnss_pseudoranges_map);
+                                    if (std::fabs(d_rx_time - d_state_saved_rx_time) * 1000.0 >= d_state_rate_ms)
+                                        {
+                                            save_state();
+                                            d_state_saved_rx_time = d_rx_time;
+                                        }
+                                }
+
                             if (!b_rinex_header_writen)
                                 {
                                     std::map<int,Gps_Ephemeris>::iterator gps_ephemeris_iter;
@@ -31,6 +31,7 @@
 #define GNSS_SDR_GPS_L1_CA_PVT_CC_H
 
 #include <fstream>
+#include <memory>
 #include <string>
 #include <gnuradio/block.h>
 #include "nmea_printer.h"
@@ -39,6 +40,7 @@
 #include "geojson_printer.h"
 #include "rtcm_printer.h"
 #include "gps_l1_ca_ls_pvt.h"
+#include "gnss_receiver_state.h"
 
 
 class gps_l1_ca_pvt_cc;
@@ -60,7 +62,9 @@ gps_l1_ca_pvt_cc_sptr gps_l1_ca_make_pvt_cc(unsigned int n_channels,
                                             unsigned short rtcm_tcp_port,
                                             unsigned short rtcm_station_id,
                                             std::map<int,int> rtcm_msg_rate_ms,
-                                            std::string rtcm_dump_devname
+                                            std::string rtcm_dump_devname,
+                                            std::string state_filename,
+                                            int state_rate_ms
 );
 
 /*!
@@ -84,7 +88,9 @@ private:
                                                        unsigned short rtcm_tcp_port,
                                                        unsigned short rtcm_station_id,
                                                        std::map<int,int> rtcm_msg_rate_ms,
-                                                       std::string rtcm_dump_devname);
+                                                       std::string rtcm_dump_devname,
+                                                       std::string state_filename,
+                                                       int state_rate_ms);
     gps_l1_ca_pvt_cc(unsigned int nchannels,
                      bool dump,
                      std::string dump_filename,
@@ -100,7 +106,9 @@ private:
                      unsigned short rtcm_tcp_port,
                      unsigned short rtcm_station_id,
                      std::map<int,int> rtcm_msg_rate_ms,
-                     std::string rtcm_dump_devname);
+                     std::string rtcm_dump_devname,
+                     std::string state_filename,
+                     int state_rate_ms);
 
     void msg_handler_telemetry(pmt::pmt_t msg);
 
@@ -135,6 +143,15 @@ private:
     double d_rx_time;
     std::shared_ptr<gps_l1_ca_ls_pvt> d_ls_pvt;
 
+    // Navigation data and last fix kept for a hot restart
+    void load_state();
+    void save_state();
+    Gnss_Receiver_State d_state;
+    std::string d_state_filename;
+    int d_state_rate_ms;
+    double d_state_saved_rx_time;
+    std::unique_ptr<Gnss_Receiver_State_Writer> d_state_writer;
+
     std::map<int,Gnss_Synchro> gnss_pseudoranges_map;
 
 public:
@@ -46,6 +46,10 @@ gps_l1_ca_ls_pvt::gps_l1_ca_ls_pvt(int nchannels, std::string dump_filename, boo
     d_flag_dump_enabled = flag_dump_to_file;
     d_flag_averaging = false;
     d_GPS_current_time = 0;
+    d_rx_vel_m_s[0] = 0.0;
+    d_rx_vel_m_s[1] = 0.0;
+    d_rx_vel_m_s[2] = 0.0;
+    d_rx_clock_drift_m_s = 0.0;
 
     // ############# ENABLE DATA FILE LOG #################
     if (d_flag_dump_enabled == true)
@@ -85,6 +89,9 @@ bool gps_l1_ca_ls_pvt::get_PVT(std::map<int,Gnss_Synchro> gnss_pseudoranges_map,
     arma::mat W = arma::eye(valid_pseudoranges, valid_pseudoranges); //channels weights matrix
     arma::vec obs = arma::zeros(valid_pseudoranges);                 // pseudoranges observation vector
     arma::mat satpos = arma::zeros(3, valid_pseudoranges);           //satellite positions matrix
+    arma::mat satvel = arma::zeros(3, valid_pseudoranges);           //satellite velocities matrix
+    std::vector<Gnss_Synchro> synchro;                               //observations, in the order of obs
+    synchro.reserve(valid_pseudoranges);
 
     int GPS_week = 0;
     double utc = 0;
@@ -92,6 +99,7 @@ bool gps_l1_ca_ls_pvt::get_PVT(std::map<int,Gnss_Synchro> gnss_pseudoranges_map,
     double SV_clock_bias_s = 0;
 
     d_flag_averaging = flag_averaging;
+    d_vector_aids.clear();
 
     // ********************************************************************************
     // ****** PREPARE THE LEAST SQUARES DATA (SV POSITIONS MATRIX AND OBS VECTORS) ****
@@ -102,6 +110,7 @@ bool gps_l1_ca_ls_pvt::get_PVT(std::map<int,Gnss_Synchro> gnss_pseudoranges_map,
             gnss_pseudoranges_iter != gnss_pseudoranges_map.end();
             gnss_pseudoranges_iter++)
         {
+            synchro.push_back(gnss_pseudoranges_iter->second);
             // 1- find the ephemeris for the current SV observation. The SV PRN ID is the map key
             gps_ephemeris_iter = gps_ephemeris_map.find(gnss_pseudoranges_iter->first);
             if (gps_ephemeris_iter != gps_ephemeris_map.end())
@@ -126,6 +135,9 @@ bool gps_l1_ca_ls_pvt::get_PVT(std::map<int,Gnss_Synchro> gnss_pseudoranges_map,
                     satpos(0, obs_counter) = gps_ephemeris_iter->second.d_satpos_X;
                     satpos(1, obs_counter) = gps_ephemeris_iter->second.d_satpos_Y;
                     satpos(2, obs_counter) = gps_ephemeris_iter->second.d_satpos_Z;
+                    satvel(0, obs_counter) = gps_ephemeris_iter->second.d_satvel_X;
+                    satvel(1, obs_counter) = gps_ephemeris_iter->second.d_satvel_Y;
+                    satvel(2, obs_counter) = gps_ephemeris_iter->second.d_satvel_Z;
 
                     // 4- fill the observations vector with the corrected pseudoranges
                     obs(obs_counter) = gnss_pseudoranges_iter->second.Pseudorange_m + SV_clock_bias_s * GPS_C_m_s;
@@ -173,6 +185,9 @@ bool gps_l1_ca_ls_pvt::get_PVT(std::map<int,Gnss_Synchro> gnss_pseudoranges_map,
             cart2geo(static_cast<double>(mypos(0)), static_cast<double>(mypos(1)), static_cast<double>(mypos(2)), 4);
 
             d_rx_dt_m = mypos(3)/GPS_C_m_s; // Convert RX time offset from meters to seconds
+            d_x_m = mypos(0);
+            d_y_m = mypos(1);
+            d_z_m = mypos(2);
 
             //ToDo: Find an Observables/PVT random bug with some satellite configurations that gives an erratic PVT solution (i.e. height>50 km)
             if (d_height_m > 50000)
@@ -194,6 +209,9 @@ bool gps_l1_ca_ls_pvt::get_PVT(std::map<int,Gnss_Synchro> gnss_pseudoranges_map,
             // ###### Compute DOPs ########
             compute_DOP();
 
+            // ###### Velocity and vector tracking aids ########
+            compute_vector_aids(synchro, satpos, satvel, W, mypos);
+
             // ######## LOG FILE #########
             if(d_flag_dump_enabled == true)
                 {
@@ -243,3 +261,63 @@ bool gps_l1_ca_ls_pvt::get_PVT(std::map<int,Gnss_Synchro> gnss_pseudoranges_map,
 }
 
 
+
+void gps_l1_ca_ls_pvt::compute_vector_aids(const std::vector<Gnss_Synchro>& synchro, const arma::mat& satpos,
+        const arma::mat& satvel, const arma::mat& W, const arma::vec& pos)
+{
+    d_vector_aids.clear();
+    std::vector<unsigned int> used;
+    for (unsigned int i = 0; i < synchro.size(); i++)
+        {
+            if (W(i, i) > 0.0) used.push_back(i);
+        }
+    if (used.size() < 4 || d_residuals_m.n_elem != synchro.size())
+        {
+            return;
+        }
+
+    // Range rate model: rate_i = (v_sat_i - v_rx) * u_i + drift, with u_i the
+    // line of sight unit vector and the range rate measured as -lambda * Doppler
+    const double lambda_m = GPS_C_m_s / GPS_L1_FREQ_HZ;
+    const unsigned int n = used.size();
+    arma::mat H = arma::zeros(n, 4);
+    arma::vec y = arma::zeros(n);
+    arma::vec sat_rate = arma::zeros(n);
+    for (unsigned int k = 0; k < n; k++)
+        {
+            unsigned int i = used[k];
+            arma::vec los = satpos.col(i) - pos.subvec(0, 2);
+            los = los / arma::norm(los, 2);
+            sat_rate(k) = arma::dot(satvel.col(i), los);
+            H(k, 0) = -los(0);
+            H(k, 1) = -los(1);
+            H(k, 2) = -los(2);
+            H(k, 3) = 1.0;
+            y(k) = -synchro[i].Carrier_Doppler_hz * lambda_m - sat_rate(k);
+        }
+    arma::vec vel;
+    if (!arma::solve(vel, H, y))
+        {
+            LOG(WARNING) << "Velocity solution failed, no vector tracking aids";
+            return;
+        }
+    d_rx_vel_m_s[0] = vel(0);
+    d_rx_vel_m_s[1] = vel(1);
+    d_rx_vel_m_s[2] = vel(2);
+    d_rx_clock_drift_m_s = vel(3);
+    DLOG(INFO) << "Velocity in ECEF (X,Y,Z) = " << vel.subvec(0, 2).t() << " [m/s] Clock drift= " << vel(3) << " [m/s]";
+
+    arma::vec predicted_rate = sat_rate + H * vel;
+    for (unsigned int k = 0; k < n; k++)
+        {
+            unsigned int i = used[k];
+            Gnss_Vector_Aid aid;
+            aid.System = synchro[i].System;
+            aid.PRN = synchro[i].PRN;
+            aid.Channel_ID = synchro[i].Channel_ID;
+            aid.Tracking_timestamp_secs = synchro[i].Tracking_timestamp_secs;
+            aid.Carrier_Doppler_hz = -predicted_rate(k) / lambda_m;
+            aid.Code_error_m = d_residuals_m(i);
+            d_vector_aids.push_back(aid);
+        }
+}
@@ -34,9 +34,11 @@
 #include <fstream>
 #include <map>
 #include <string>
+#include <vector>
 #include "ls_pvt.h"
 #include "GPS_L1_CA.h"
 #include "gnss_synchro.h"
+#include "gnss_vector_aid.h"
 #include "gps_ephemeris.h"
 #include "gps_navigation_message.h"
 #include "gps_utc_model.h"
@@ -71,11 +73,24 @@ public:
 
     double d_GPS_current_time;
 
+    std::vector<Gnss_Vector_Aid> d_vector_aids; //!< Aids to the channels used in the last valid solution
+    double d_rx_vel_m_s[3];                      //!< ECEF receiver velocity of the last valid solution [m/s]
+    double d_rx_clock_drift_m_s;                 //!< Receiver clock drift of the last valid solution [m/s]
+
     bool d_flag_dump_enabled;
     bool d_flag_averaging;
 
     std::string d_dump_filename;
     std::ofstream d_dump_file;
+
+private:
+    /*
+     * Estimates the receiver velocity and clock drift from the carrier Doppler
+     * of the channels used in the solution, and computes the aids to the
+     * vector tracking loops.
+     */
+    void compute_vector_aids(const std::vector<Gnss_Synchro>& synchro, const arma::mat& satpos,
+            const arma::mat& satvel, const arma::mat& W, const arma::vec& pos);
 };
 
 #endif
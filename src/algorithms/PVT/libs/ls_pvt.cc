@@ -143,6 +143,7 @@ arma::vec Ls_Pvt::leastSquarePos(const arma::mat & satpos, const arma::vec & obs
                 break; // exit the loop because we assume that the LS algorithm has converged (err < 0.1 cm)
             }
         }
+    d_residuals_m = omc - A * x;
 
     try
     {
@@ -45,6 +45,7 @@ public:
     Ls_Pvt();
 
     arma::vec leastSquarePos(const arma::mat & satpos, const arma::vec & obs, const arma::mat & w);
+    arma::vec d_residuals_m; //!< Post-fit pseudorange residuals (observed minus computed) of the last solution [m]
     double d_x_m;
     double d_y_m;
     double d_z_m;
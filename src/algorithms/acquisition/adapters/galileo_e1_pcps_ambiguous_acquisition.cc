@@ -73,6 +73,13 @@ GalileoE1PcpsAmbiguousAcquisition::GalileoE1PcpsAmbiguousAcquisition(
 
     dump_filename_ = configuration_->property(role + ".dump_filename", default_dump_filename);
 
+    fft_planner_ = configuration_->property(role + ".fft_planner", std::string("off"));
+
+    // Coarse-to-fine Doppler search (coarse_segments = 0 searches every bin)
+    coarse_segments_ = configuration_->property(role + ".coarse_segments", 0);
+    coarse_noncoherent_segments_ = configuration_->property(role + ".coarse_noncoherent_segments", 1);
+    coarse_candidates_ = configuration_->property(role + ".coarse_candidates", 3);
+
     //--- Find number of samples per spreading code (4 ms)  -----------------
     code_length_ = round(fs_in_ / (Galileo_E1_CODE_CHIP_RATE_HZ / Galileo_E1_B_CODE_LENGTH_CHIPS));
     int samples_per_ms = round(code_length_ / 4.0);
@@ -97,7 +104,9 @@ GalileoE1PcpsAmbiguousAcquisition::GalileoE1PcpsAmbiguousAcquisition(
                 item_size_ = sizeof(gr_complex);
                 acquisition_cc_ = pcps_make_acquisition_cc(sampled_ms_, max_dwells_,
                         doppler_max_, if_, fs_in_, samples_per_ms, code_length_,
-                        bit_transition_flag_, use_CFAR_algorithm_flag_, dump_, dump_filename_);
+                        bit_transition_flag_, use_CFAR_algorithm_flag_, dump_, dump_filename_,
+                        fft_planner_);
+                acquisition_cc_->set_coarse_search(coarse_segments_, coarse_noncoherent_segments_, coarse_candidates_);
                 DLOG(INFO) << "acquisition(" << acquisition_cc_->unique_id() << ")";
         }
 
@@ -195,6 +204,16 @@ void GalileoE1PcpsAmbiguousAcquisition::set_doppler_step(unsigned int doppler_st
 }
 
 
+void GalileoE1PcpsAmbiguousAcquisition::set_doppler_window(int doppler_center, unsigned int doppler_window)
+{
+    // The cshort implementation always searches the whole grid
+    if (item_type_.compare("cshort") != 0)
+        {
+            acquisition_cc_->set_doppler_window(doppler_center, doppler_window);
+        }
+}
+
+
 void GalileoE1PcpsAmbiguousAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
 {
     gnss_synchro_ = gnss_synchro;
@@ -107,6 +107,11 @@ public:
      */
     void set_doppler_step(unsigned int doppler_step);
 
+    /*!
+     * \brief Searches only doppler_center +/- doppler_window of the grid (0: all of it)
+     */
+    void set_doppler_window(int doppler_center, unsigned int doppler_window);
+
     /*!
      * \brief Initializes acquisition algorithm.
      */
@@ -155,6 +160,10 @@ private:
     long if_;
     bool dump_;
     std::string dump_filename_;
+    std::string fft_planner_;
+    unsigned int coarse_segments_;
+    unsigned int coarse_noncoherent_segments_;
+    unsigned int coarse_candidates_;
     std::complex<float> * code_;
     Gnss_Synchro * gnss_synchro_;
     std::string role_;
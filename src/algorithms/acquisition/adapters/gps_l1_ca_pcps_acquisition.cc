@@ -69,6 +69,13 @@ GpsL1CaPcpsAcquisition::GpsL1CaPcpsAcquisition(
 
     dump_filename_ = configuration_->property(role + ".dump_filename", default_dump_filename);
 
+    fft_planner_ = configuration_->property(role + ".fft_planner", std::string("off"));
+
+    // Coarse-to-fine Doppler search (coarse_segments = 0 searches every bin)
+    coarse_segments_ = configuration_->property(role + ".coarse_segments", 0);
+    coarse_noncoherent_segments_ = configuration_->property(role + ".coarse_noncoherent_segments", 1);
+    coarse_candidates_ = configuration_->property(role + ".coarse_candidates", 3);
+
     //--- Find number of samples per spreading code -------------------------
     code_length_ = round(fs_in_ / (GPS_L1_CA_CODE_RATE_HZ / GPS_L1_CA_CODE_LENGTH_CHIPS));
 
@@ -89,22 +96,26 @@ GpsL1CaPcpsAcquisition::GpsL1CaPcpsAcquisition(
                     bit_transition_flag_, use_CFAR_algorithm_flag_, dump_, dump_filename_);
             DLOG(INFO) << "acquisition(" << acquisition_sc_->unique_id() << ")";
 
+        }else if (item_type_.compare("cbyte") == 0)
+        {
+            item_size_ = sizeof(lv_8sc_t);
+            acquisition_8sc_ = pcps_make_acquisition_8sc(sampled_ms_, max_dwells_,
+                    doppler_max_, if_, fs_in_, code_length_, code_length_,
+                    bit_transition_flag_, use_CFAR_algorithm_flag_, dump_, dump_filename_);
+            DLOG(INFO) << "acquisition(" << acquisition_8sc_->unique_id() << ")";
+
         }else{
                 item_size_ = sizeof(gr_complex);
                 acquisition_cc_ = pcps_make_acquisition_cc(sampled_ms_, max_dwells_,
                         doppler_max_, if_, fs_in_, code_length_, code_length_,
-                        bit_transition_flag_, use_CFAR_algorithm_flag_, dump_, dump_filename_);
+                        bit_transition_flag_, use_CFAR_algorithm_flag_, dump_, dump_filename_,
+                        fft_planner_);
+                acquisition_cc_->set_coarse_search(coarse_segments_, coarse_noncoherent_segments_, coarse_candidates_);
                 DLOG(INFO) << "acquisition(" << acquisition_cc_->unique_id() << ")";
         }
 
     stream_to_vector_ = gr::blocks::stream_to_vector::make(item_size_, vector_length_);
     DLOG(INFO) << "stream_to_vector(" << stream_to_vector_->unique_id() << ")";
-    
-    if (item_type_.compare("cbyte") == 0)
-        {
-            cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
-            float_to_complex_ = gr::blocks::float_to_complex::make();
-        }
 
     channel_ = 0;
     threshold_ = 0.0;
@@ -126,6 +137,10 @@ void GpsL1CaPcpsAcquisition::set_channel(unsigned int channel)
         {
             acquisition_sc_->set_channel(channel_);
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            acquisition_8sc_->set_channel(channel_);
+        }
     else
         {
             acquisition_cc_->set_channel(channel_);
@@ -154,6 +169,10 @@ void GpsL1CaPcpsAcquisition::set_threshold(float threshold)
         {
             acquisition_sc_->set_threshold(threshold_);
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            acquisition_8sc_->set_threshold(threshold_);
+        }
     else
         {
             acquisition_cc_->set_threshold(threshold_);
@@ -169,6 +188,10 @@ void GpsL1CaPcpsAcquisition::set_doppler_max(unsigned int doppler_max)
         {
             acquisition_sc_->set_doppler_max(doppler_max_);
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            acquisition_8sc_->set_doppler_max(doppler_max_);
+        }
     else
         {
             acquisition_cc_->set_doppler_max(doppler_max_);
@@ -184,6 +207,10 @@ void GpsL1CaPcpsAcquisition::set_doppler_step(unsigned int doppler_step)
         {
             acquisition_sc_->set_doppler_step(doppler_step_);
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            acquisition_8sc_->set_doppler_step(doppler_step_);
+        }
     else
         {
             acquisition_cc_->set_doppler_step(doppler_step_);
@@ -191,6 +218,16 @@ void GpsL1CaPcpsAcquisition::set_doppler_step(unsigned int doppler_step)
 
 }
 
+
+void GpsL1CaPcpsAcquisition::set_doppler_window(int doppler_center, unsigned int doppler_window)
+{
+    // The cshort and cbyte implementations always search the whole grid
+    if (item_type_.compare("cshort") != 0 && item_type_.compare("cbyte") != 0)
+        {
+            acquisition_cc_->set_doppler_window(doppler_center, doppler_window);
+        }
+}
+
 void GpsL1CaPcpsAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
 {
     gnss_synchro_ = gnss_synchro;
@@ -199,6 +236,10 @@ void GpsL1CaPcpsAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
         {
             acquisition_sc_->set_gnss_synchro(gnss_synchro_);
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            acquisition_8sc_->set_gnss_synchro(gnss_synchro_);
+        }
     else
         {
             acquisition_cc_->set_gnss_synchro(gnss_synchro_);
@@ -212,6 +253,10 @@ signed int GpsL1CaPcpsAcquisition::mag()
         {
             return acquisition_sc_->mag();
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            return acquisition_8sc_->mag();
+        }
     else
         {
             return acquisition_cc_->mag();
@@ -225,6 +270,10 @@ void GpsL1CaPcpsAcquisition::init()
         {
             acquisition_sc_->init();
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            acquisition_8sc_->init();
+        }
     else
         {
             acquisition_cc_->init();
@@ -251,6 +300,10 @@ void GpsL1CaPcpsAcquisition::set_local_code()
         {
             acquisition_sc_->set_local_code(code_);
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            acquisition_8sc_->set_local_code(code_);
+        }
     else
         {
             acquisition_cc_->set_local_code(code_);
@@ -266,6 +319,10 @@ void GpsL1CaPcpsAcquisition::reset()
         {
             acquisition_sc_->set_active(true);
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            acquisition_8sc_->set_active(true);
+        }
     else
         {
             acquisition_cc_->set_active(true);
@@ -279,6 +336,10 @@ void GpsL1CaPcpsAcquisition::set_state(int state)
         {
             acquisition_sc_->set_state(state);
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            acquisition_8sc_->set_state(state);
+        }
     else
         {
             acquisition_cc_->set_state(state);
@@ -319,10 +380,7 @@ void GpsL1CaPcpsAcquisition::connect(gr::top_block_sptr top_block)
         }
     else if (item_type_.compare("cbyte") == 0)
         {
-            top_block->connect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->connect(float_to_complex_, 0, stream_to_vector_, 0);
-            top_block->connect(stream_to_vector_, 0, acquisition_cc_, 0);
+            top_block->connect(stream_to_vector_, 0, acquisition_8sc_, 0);
         }
     else
         {
@@ -343,12 +401,7 @@ void GpsL1CaPcpsAcquisition::disconnect(gr::top_block_sptr top_block)
         }
     else if (item_type_.compare("cbyte") == 0)
         {
-            // Since a byte-based acq implementation is not available,
-            // we just convert cshorts to gr_complex
-            top_block->disconnect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->disconnect(float_to_complex_, 0, stream_to_vector_, 0);
-            top_block->disconnect(stream_to_vector_, 0, acquisition_cc_, 0);
+            top_block->disconnect(stream_to_vector_, 0, acquisition_8sc_, 0);
         }
     else
         {
@@ -369,7 +422,7 @@ gr::basic_block_sptr GpsL1CaPcpsAcquisition::get_left_block()
         }
     else if (item_type_.compare("cbyte") == 0)
         {
-            return cbyte_to_float_x2_;
+            return stream_to_vector_;
         }
     else
         {
@@ -385,6 +438,10 @@ gr::basic_block_sptr GpsL1CaPcpsAcquisition::get_right_block()
         {
             return acquisition_sc_;
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            return acquisition_8sc_;
+        }
     else
         {
             return acquisition_cc_;
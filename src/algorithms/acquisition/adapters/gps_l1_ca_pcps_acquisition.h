@@ -38,12 +38,11 @@
 
 #include <string>
 #include <gnuradio/blocks/stream_to_vector.h>
-#include <gnuradio/blocks/float_to_complex.h>
 #include "gnss_synchro.h"
 #include "acquisition_interface.h"
 #include "pcps_acquisition_cc.h"
 #include "pcps_acquisition_sc.h"
-#include "complex_byte_to_float_x2.h"
+#include "pcps_acquisition_8sc.h"
 #include <volk_gnsssdr/volk_gnsssdr.h>
 
 
@@ -112,6 +111,11 @@ public:
      */
     void set_doppler_step(unsigned int doppler_step);
 
+    /*!
+     * \brief Searches only doppler_center +/- doppler_window of the grid (0: all of it)
+     */
+    void set_doppler_window(int doppler_center, unsigned int doppler_window);
+
     /*!
      * \brief Initializes acquisition algorithm.
      */
@@ -141,9 +145,8 @@ private:
     ConfigurationInterface* configuration_;
     pcps_acquisition_cc_sptr acquisition_cc_;
     pcps_acquisition_sc_sptr acquisition_sc_;
+    pcps_acquisition_8sc_sptr acquisition_8sc_;
     gr::blocks::stream_to_vector::sptr stream_to_vector_;
-    gr::blocks::float_to_complex::sptr float_to_complex_;
-    complex_byte_to_float_x2_sptr cbyte_to_float_x2_;
     size_t item_size_;
     std::string item_type_;
     unsigned int vector_length_;
@@ -160,6 +163,10 @@ private:
     long if_;
     bool dump_;
     std::string dump_filename_;
+    std::string fft_planner_;
+    unsigned int coarse_segments_;
+    unsigned int coarse_noncoherent_segments_;
+    unsigned int coarse_candidates_;
     std::complex<float> * code_;
     Gnss_Synchro * gnss_synchro_;
     std::string role_;
@@ -67,6 +67,13 @@ GpsL2MPcpsAcquisition::GpsL2MPcpsAcquisition(
 
     dump_filename_ = configuration_->property(role + ".dump_filename", default_dump_filename);
 
+    fft_planner_ = configuration_->property(role + ".fft_planner", std::string("off"));
+
+    // Coarse-to-fine Doppler search (coarse_segments = 0 searches every bin)
+    coarse_segments_ = configuration_->property(role + ".coarse_segments", 0);
+    coarse_noncoherent_segments_ = configuration_->property(role + ".coarse_noncoherent_segments", 1);
+    coarse_candidates_ = configuration_->property(role + ".coarse_candidates", 3);
+
     //--- Find number of samples per spreading code -------------------------
     code_length_ = round(static_cast<double>(fs_in_)
             / (GPS_L2_M_CODE_RATE_HZ / static_cast<double>(GPS_L2_M_CODE_LENGTH_CHIPS)));
@@ -92,7 +99,9 @@ GpsL2MPcpsAcquisition::GpsL2MPcpsAcquisition(
                 item_size_ = sizeof(gr_complex);
                 acquisition_cc_ = pcps_make_acquisition_cc(1, max_dwells_,
                         doppler_max_, if_, fs_in_, code_length_, code_length_,
-                        bit_transition_flag_, use_CFAR_algorithm_flag_, dump_, dump_filename_);
+                        bit_transition_flag_, use_CFAR_algorithm_flag_, dump_, dump_filename_,
+                        fft_planner_);
+                acquisition_cc_->set_coarse_search(coarse_segments_, coarse_noncoherent_segments_, coarse_candidates_);
                 DLOG(INFO) << "acquisition(" << acquisition_cc_->unique_id() << ")";
         }
 
@@ -194,6 +203,16 @@ void GpsL2MPcpsAcquisition::set_doppler_step(unsigned int doppler_step)
 }
 
 
+void GpsL2MPcpsAcquisition::set_doppler_window(int doppler_center, unsigned int doppler_window)
+{
+    // The cshort implementation always searches the whole grid
+    if (item_type_.compare("cshort") != 0)
+        {
+            acquisition_cc_->set_doppler_window(doppler_center, doppler_window);
+        }
+}
+
+
 void GpsL2MPcpsAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
 {
     gnss_synchro_ = gnss_synchro;
@@ -36,7 +36,7 @@
 #include <string>
 #include <gnuradio/block.h>
 #include <gnuradio/gr_complex.h>
-#include <gnuradio/fft/fft.h>
+#include "gnss_fft.h"
 #include "gnss_synchro.h"
 
 class galileo_pcps_8ms_acquisition_cc;
@@ -89,8 +89,8 @@ private:
     unsigned int d_num_doppler_bins;
     gr_complex* d_fft_code_A;
     gr_complex* d_fft_code_B;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro *d_gnss_synchro;
     unsigned int d_code_phase;
     float d_doppler_freq;
@@ -33,6 +33,9 @@
  */
 
 #include "pcps_acquisition_cc.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <sstream>
 #include <boost/filesystem.hpp>
 #include <gnuradio/io_signature.h>
@@ -41,6 +44,7 @@
 #include <volk_gnsssdr/volk_gnsssdr.h>
 #include "control_message_factory.h"
 #include "GPS_L1_CA.h" //GPS_TWO_PI
+#include "gnss_signal_processing.h"
 
 
 using google::LogMessage;
@@ -51,11 +55,13 @@ pcps_acquisition_cc_sptr pcps_make_acquisition_cc(
                                  int samples_per_ms, int samples_per_code,
                                  bool bit_transition_flag, bool use_CFAR_algorithm_flag,
                                  bool dump,
-                                 std::string dump_filename)
+                                 std::string dump_filename,
+                                 std::string fft_planner)
 {
     return pcps_acquisition_cc_sptr(
             new pcps_acquisition_cc(sampled_ms, max_dwells, doppler_max, freq, fs_in, samples_per_ms,
-                    samples_per_code, bit_transition_flag, use_CFAR_algorithm_flag, dump, dump_filename));
+                    samples_per_code, bit_transition_flag, use_CFAR_algorithm_flag, dump, dump_filename,
+                    fft_planner));
 }
 
 
@@ -65,7 +71,8 @@ pcps_acquisition_cc::pcps_acquisition_cc(
                          int samples_per_ms, int samples_per_code,
                          bool bit_transition_flag, bool use_CFAR_algorithm_flag,
                          bool dump,
-                         std::string dump_filename) :
+                         std::string dump_filename,
+                         std::string fft_planner) :
     gr::block("pcps_acquisition_cc",
     gr::io_signature::make(1, 1, sizeof(gr_complex) * sampled_ms * samples_per_ms * ( bit_transition_flag ? 2 : 1 )),
     gr::io_signature::make(0, 0, sizeof(gr_complex) * sampled_ms * samples_per_ms * ( bit_transition_flag ? 2 : 1 )) )
@@ -114,14 +121,34 @@ pcps_acquisition_cc::pcps_acquisition_cc(
             d_max_dwells = 1; //Activation of d_bit_transition_flag invalidates the value of d_max_dwells
         }
 
+    // The snapshot may be resampled (circular correlation) or zero-padded
+    // (linear correlation) to an FFT length that FFTW handles faster
+    d_input_size = d_fft_size;
+    d_fft_plan = Gnss_Fft_Planner::plan(d_input_size, d_bit_transition_flag, fft_planner);
+    d_fft_size = d_fft_plan.fft_size;
+    d_fs_fft = static_cast<double>(d_fs_in);
+    d_resampled_in = 0;
+    if (d_fft_plan.strategy == FFT_STRATEGY_RESAMPLE)
+        {
+            d_fs_fft = static_cast<double>(d_fs_in) * static_cast<double>(d_fft_size) / static_cast<double>(d_input_size);
+            d_resampled_in = static_cast<gr_complex*>(volk_malloc(d_fft_size * sizeof(gr_complex), volk_get_alignment()));
+        }
+    LOG(INFO) << "Acquisition FFT plan: " << d_fft_plan.to_string();
+
     d_fft_codes = static_cast<gr_complex*>(volk_malloc(d_fft_size * sizeof(gr_complex), volk_get_alignment()));
     d_magnitude = static_cast<float*>(volk_malloc(d_fft_size * sizeof(float), volk_get_alignment()));
+    d_coarse_magnitude = static_cast<float*>(volk_malloc(d_fft_size * sizeof(float), volk_get_alignment()));
+    d_coarse_segments = 0;
+    d_doppler_window_center = 0;
+    d_doppler_window = 0;
+    d_coarse_noncoherent_segments = 0;
+    d_coarse_candidates = 0;
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft(d_fft_size, true);
 
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft(d_fft_size, false);
 
     // For dumping samples into a file
     d_dump = dump;
@@ -145,6 +172,11 @@ pcps_acquisition_cc::~pcps_acquisition_cc()
 
     volk_free(d_fft_codes);
     volk_free(d_magnitude);
+    volk_free(d_coarse_magnitude);
+    if (d_resampled_in != 0)
+        {
+            volk_free(d_resampled_in);
+        }
 
     delete d_ifft;
     delete d_fft_if;
@@ -162,12 +194,21 @@ void pcps_acquisition_cc::set_local_code(std::complex<float> * code)
     // Here we want to create a buffer that looks like this:
     // [ 0 0 0 ... 0 c_0 c_1 ... c_L]
     // where c_i is the local code and there are L zeros and L chips
+    // If the FFT is longer than two code periods, the zeros take up the
+    // extra length so that the code still ends at the end of the buffer.
     if( d_bit_transition_flag )
         {
-            int offset = d_fft_size/2;
+            int code_size = d_input_size/2;
+            int offset = d_fft_size - code_size;
             std::fill_n( d_fft_if->get_inbuf(), offset, gr_complex( 0.0, 0.0 ) );
-            memcpy(d_fft_if->get_inbuf() + offset, code, sizeof(gr_complex) * offset);
+            memcpy(d_fft_if->get_inbuf() + offset, code, sizeof(gr_complex) * code_size);
         } 
+    else if (d_fft_plan.strategy == FFT_STRATEGY_RESAMPLE)
+        {
+            // Nearest neighbour keeps the chips sharp, as if the code had been generated at d_fs_fft
+            resampler(code, d_fft_if->get_inbuf(), static_cast<float>(d_fs_in), static_cast<float>(d_fs_fft),
+                    d_input_size, d_fft_size);
+        }
     else 
         {
             memcpy(d_fft_if->get_inbuf(), code, sizeof(gr_complex) * d_fft_size);
@@ -180,13 +221,101 @@ void pcps_acquisition_cc::set_local_code(std::complex<float> * code)
 
 void pcps_acquisition_cc::update_local_carrier(gr_complex* carrier_vector, int correlator_length_samples, float freq)
 {
-    float phase_step_rad = GPS_TWO_PI * freq / static_cast<float>(d_fs_in);
+    float phase_step_rad = GPS_TWO_PI * freq / static_cast<float>(d_fs_fft);
     float _phase[1];
     _phase[0] = 0;
     volk_gnsssdr_s32f_sincos_32fc(carrier_vector, - phase_step_rad, _phase, correlator_length_samples);
 }
 
 
+void pcps_acquisition_cc::set_coarse_search(unsigned int segments, unsigned int noncoherent_segments, unsigned int candidates)
+{
+    if (segments > 1 && d_bit_transition_flag)
+        {
+            LOG(WARNING) << "The coarse Doppler search is not available with bit_transition_flag. Searching all the Doppler bins";
+            segments = 0;
+        }
+    if (segments > 1)
+        {
+            d_coarse_segments = segments;
+            d_coarse_noncoherent_segments = std::max(std::min(noncoherent_segments, segments), 1u);
+            d_coarse_candidates = std::max(candidates, 1u);
+            LOG(INFO) << "Coarse Doppler search in " << d_coarse_segments << " segments, "
+                      << d_coarse_noncoherent_segments << " of them added up, "
+                      << d_coarse_candidates << " candidates refined";
+        }
+    else
+        {
+            d_coarse_segments = 0;
+        }
+}
+
+
+void pcps_acquisition_cc::coarse_search(const gr_complex* in, unsigned int snapshot_size)
+{
+#if VOLK_GT_122
+    uint16_t indext = 0;
+#else
+    unsigned int indext = 0;
+#endif
+    unsigned int segment_size = snapshot_size / d_coarse_segments;
+    unsigned int coarse_bins = (d_num_doppler_bins + d_coarse_segments - 1) / d_coarse_segments;
+
+    // The code is periodic, so correlating a zero-padded segment with the
+    // whole code gives the partial correlation at every code phase.
+    d_coarse_scores.assign(coarse_bins, 0.0);
+    for (unsigned int coarse_index = 0; coarse_index < coarse_bins; coarse_index++)
+        {
+            // The fine bin at the centre of the coarse cell provides the wipe-off.
+            // Its phase at the start of each segment does not change the magnitude.
+            unsigned int center = std::min(coarse_index * d_coarse_segments + d_coarse_segments / 2, d_num_doppler_bins - 1);
+            std::fill_n(d_coarse_magnitude, d_fft_size, 0.0);
+            for (unsigned int segment = 0; segment < d_coarse_noncoherent_segments; segment++)
+                {
+                    unsigned int start = segment * segment_size;
+                    std::fill_n(d_fft_if->get_inbuf(), d_fft_size, gr_complex(0.0, 0.0));
+                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf() + start, in + start,
+                            d_grid_doppler_wipeoffs[center] + start, segment_size);
+                    d_fft_if->execute();
+                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
+                            d_fft_if->get_outbuf(), d_fft_codes, d_fft_size);
+                    d_ifft->execute();
+                    volk_32fc_magnitude_squared_32f(d_magnitude, d_ifft->get_outbuf(), d_fft_size);
+                    volk_32f_x2_add_32f(d_coarse_magnitude, d_coarse_magnitude, d_magnitude, d_fft_size);
+                }
+            volk_32f_index_max_16u(&indext, d_coarse_magnitude, d_fft_size);
+            d_coarse_scores[coarse_index] = d_coarse_magnitude[indext];
+        }
+
+    // Refine the best cells, half a coarse cell beyond each side in case the
+    // signal sits between two of them
+    d_search_mask.assign(d_num_doppler_bins, false);
+    unsigned int candidates = std::min(d_coarse_candidates, coarse_bins);
+    for (unsigned int n = 0; n < candidates; n++)
+        {
+            unsigned int best = std::max_element(d_coarse_scores.begin(), d_coarse_scores.end()) - d_coarse_scores.begin();
+            d_coarse_scores[best] = -1.0;
+            unsigned int first = best * d_coarse_segments;
+            unsigned int half = d_coarse_segments / 2;
+            unsigned int low = (first > half) ? first - half : 0;
+            unsigned int high = std::min(first + d_coarse_segments + half, d_num_doppler_bins);
+            for (unsigned int doppler_index = low; doppler_index < high; doppler_index++)
+                {
+                    d_search_mask[doppler_index] = true;
+                }
+        }
+    for (unsigned int doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+        {
+            if (d_search_mask[doppler_index])
+                {
+                    d_search_bins.push_back(doppler_index);
+                }
+        }
+    DLOG(INFO) << "Coarse search: " << coarse_bins * d_coarse_noncoherent_segments << " segment correlations, "
+               << d_search_bins.size() << " of " << d_num_doppler_bins << " fine bins to search";
+}
+
+
 void pcps_acquisition_cc::init()
 {
     d_gnss_synchro->Flag_valid_acquisition = false;
@@ -272,7 +401,7 @@ int pcps_acquisition_cc::general_work(int noutput_items,
                     d_state = 1;
                 }
 
-            d_sample_counter += d_fft_size * ninput_items[0]; // sample counter
+            d_sample_counter += d_input_size * ninput_items[0]; // sample counter
             consume_each(ninput_items[0]);
 
             //DLOG(INFO) << "Consumed " << ninput_items[0] << " items";
@@ -292,14 +421,24 @@ int pcps_acquisition_cc::general_work(int noutput_items,
             float magt = 0.0;
             const gr_complex *in = (const gr_complex *)input_items[0]; //Get the input samples pointer
 
-            int effective_fft_size = ( d_bit_transition_flag ? d_fft_size/2 : d_fft_size );
+            // Samples correlated in each Doppler bin
+            unsigned int snapshot_size = d_input_size;
+            if (d_fft_plan.strategy == FFT_STRATEGY_RESAMPLE)
+                {
+                    linear_resampler(in, d_resampled_in, d_input_size, d_fft_size);
+                    in = d_resampled_in;
+                    snapshot_size = d_fft_size;
+                }
 
-            float fft_normalization_factor = static_cast<float>(d_fft_size) * static_cast<float>(d_fft_size);
+            int effective_fft_size = ( d_bit_transition_flag ? d_input_size/2 : d_fft_size );
+
+            // Keeps the test statistics on the scale of the snapshot length whatever the FFT length
+            float fft_normalization_factor = static_cast<float>(d_fft_size) * static_cast<float>(snapshot_size);
 
             d_input_power = 0.0;
             d_mag = 0.0;
 
-            d_sample_counter += d_fft_size; // sample counter
+            d_sample_counter += d_input_size; // sample counter
 
             d_well_count++;
 
@@ -312,18 +451,55 @@ int pcps_acquisition_cc::general_work(int noutput_items,
             if (d_use_CFAR_algorithm_flag == true)
                 {
                     // 1- (optional) Compute the input signal power estimation
-                    volk_32fc_magnitude_squared_32f(d_magnitude, in, d_fft_size);
-                    volk_32f_accumulator_s32f(&d_input_power, d_magnitude, d_fft_size);
-                    d_input_power /= static_cast<float>(d_fft_size);
+                    volk_32fc_magnitude_squared_32f(d_magnitude, in, snapshot_size);
+                    volk_32f_accumulator_s32f(&d_input_power, d_magnitude, snapshot_size);
+                    d_input_power /= static_cast<float>(snapshot_size);
+                }
+            // 2- Doppler frequency search loop. With a Doppler window (assisted
+            // acquisition) only its bins are searched, and with the coarse search
+            // only the fine bins around the best coarse cells.
+            d_search_bins.clear();
+            if (d_doppler_window > 0)
+                {
+                    // Half a step of margin, so the bins at the edges are included
+                    int margin = static_cast<int>(d_doppler_window + d_doppler_step / 2);
+                    for (unsigned int doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                        {
+                            doppler = -static_cast<int>(d_doppler_max) + d_doppler_step * doppler_index;
+                            if (std::abs(doppler - d_doppler_window_center) <= margin)
+                                {
+                                    d_search_bins.push_back(doppler_index);
+                                }
+                        }
+                }
+            if (!d_search_bins.empty())
+                {
+                    DLOG(INFO) << "Searching " << d_search_bins.size() << " of " << d_num_doppler_bins
+                               << " Doppler bins around " << d_doppler_window_center << " Hz";
+                }
+            else if (d_coarse_segments > 1)
+                {
+                    coarse_search(in, snapshot_size);
+                }
+            else
+                {
+                    for (unsigned int doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                        {
+                            d_search_bins.push_back(doppler_index);
+                        }
                 }
-            // 2- Doppler frequency search loop
-            for (unsigned int doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+            for (unsigned int bin = 0; bin < d_search_bins.size(); bin++)
                 {
+                    unsigned int doppler_index = d_search_bins[bin];
                     // doppler search steps
                     doppler = -static_cast<int>(d_doppler_max) + d_doppler_step * doppler_index;
 
                     volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in,
-                            d_grid_doppler_wipeoffs[doppler_index], d_fft_size);
+                            d_grid_doppler_wipeoffs[doppler_index], snapshot_size);
+                    if (snapshot_size < d_fft_size)
+                        {
+                            std::fill_n(d_fft_if->get_inbuf() + snapshot_size, d_fft_size - snapshot_size, gr_complex(0.0, 0.0));
+                        }
 
                     // 3- Perform the FFT-based convolution  (parallel time search)
                     // Compute the FFT of the carrier wiped--off incoming signal
@@ -370,7 +546,16 @@ int pcps_acquisition_cc::general_work(int noutput_items,
 
                             if (d_test_statistics < (d_mag / d_input_power) || !d_bit_transition_flag)
                                 {
-                                    d_gnss_synchro->Acq_delay_samples = static_cast<double>(indext % d_samples_per_code);
+                                    if (d_fft_plan.strategy == FFT_STRATEGY_RESAMPLE)
+                                        {
+                                            // Back to samples at the input rate
+                                            double delay = static_cast<double>(indext) * static_cast<double>(d_input_size) / static_cast<double>(d_fft_size);
+                                            d_gnss_synchro->Acq_delay_samples = std::fmod(delay, static_cast<double>(d_samples_per_code));
+                                        }
+                                    else
+                                        {
+                                            d_gnss_synchro->Acq_delay_samples = static_cast<double>(indext % d_samples_per_code);
+                                        }
                                     d_gnss_synchro->Acq_doppler_hz = static_cast<double>(doppler);
                                     d_gnss_synchro->Acq_samplestamp_samples = d_sample_counter;
 
@@ -453,7 +638,7 @@ int pcps_acquisition_cc::general_work(int noutput_items,
 
             d_active = false;
             d_state = 0;
-            d_sample_counter += d_fft_size * ninput_items[0]; // sample counter
+            d_sample_counter += d_input_size * ninput_items[0]; // sample counter
             consume_each(ninput_items[0]);
 
             acquisition_message = 1;
@@ -478,7 +663,7 @@ int pcps_acquisition_cc::general_work(int noutput_items,
             d_active = false;
             d_state = 0;
 
-            d_sample_counter += d_fft_size * ninput_items[0]; // sample counter
+            d_sample_counter += d_input_size * ninput_items[0]; // sample counter
             consume_each(ninput_items[0]);
             acquisition_message = 2;
             this->message_port_pub(pmt::mp("events"), pmt::from_long(acquisition_message));
@@ -52,9 +52,11 @@
 
 #include <fstream>
 #include <string>
+#include <vector>
 #include <gnuradio/block.h>
 #include <gnuradio/gr_complex.h>
-#include <gnuradio/fft/fft.h>
+#include "gnss_fft.h"
+#include "gnss_fft_planner.h"
 #include "gnss_synchro.h"
 
 class pcps_acquisition_cc;
@@ -67,13 +69,18 @@ pcps_make_acquisition_cc(unsigned int sampled_ms, unsigned int max_dwells,
                          int samples_per_ms, int samples_per_code,
                          bool bit_transition_flag, bool use_CFAR_algorithm_flag,
                          bool dump,
-                         std::string dump_filename);
+                         std::string dump_filename,
+                         std::string fft_planner);
 
 /*!
  * \brief This class implements a Parallel Code Phase Search Acquisition.
  *
  * Check \ref Navitec2012 "An Open Source Galileo E1 Software Receiver",
  * Algorithm 1, for a pseudocode description of this implementation.
+ *
+ * The FFT length is chosen by Gnss_Fft_Planner: it is the snapshot length
+ * unless fft_planner allows resampling the snapshot (or zero-padding it, when
+ * bit_transition_flag is set) to a faster length.
  */
 class pcps_acquisition_cc: public gr::block
 {
@@ -84,17 +91,21 @@ private:
             int samples_per_ms, int samples_per_code,
             bool bit_transition_flag, bool use_CFAR_algorithm_flag,
             bool dump,
-            std::string dump_filename);
+            std::string dump_filename,
+            std::string fft_planner);
 
     pcps_acquisition_cc(unsigned int sampled_ms, unsigned int max_dwells,
             unsigned int doppler_max, long freq, long fs_in,
             int samples_per_ms, int samples_per_code,
             bool bit_transition_flag, bool use_CFAR_algorithm_flag,
             bool dump,
-            std::string dump_filename);
+            std::string dump_filename,
+            std::string fft_planner);
 
     void update_local_carrier(gr_complex* carrier_vector, int correlator_length_samples, float freq);
 
+    void coarse_search(const gr_complex* in, unsigned int snapshot_size);
+
     long d_fs_in;
     long d_freq;
     int d_samples_per_ms;
@@ -108,17 +119,30 @@ private:
     unsigned int d_max_dwells;
     unsigned int d_well_count;
     unsigned int d_fft_size;
+    unsigned int d_input_size;
+    Gnss_Fft_Plan d_fft_plan;
+    double d_fs_fft;
+    gr_complex* d_resampled_in;
     unsigned long int d_sample_counter;
     gr_complex** d_grid_doppler_wipeoffs;
     unsigned int d_num_doppler_bins;
     gr_complex* d_fft_codes;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro *d_gnss_synchro;
     unsigned int d_code_phase;
     float d_doppler_freq;
     float d_mag;
     float* d_magnitude;
+    float* d_coarse_magnitude;
+    unsigned int d_coarse_segments;
+    unsigned int d_coarse_noncoherent_segments;
+    unsigned int d_coarse_candidates;
+    std::vector<unsigned int> d_search_bins;
+    std::vector<float> d_coarse_scores;
+    std::vector<bool> d_search_mask;
+    int d_doppler_window_center;
+    unsigned int d_doppler_window;
     float d_input_power;
     float d_test_statistics;
     bool d_bit_transition_flag;
@@ -219,6 +243,33 @@ public:
          d_doppler_step = doppler_step;
      }
 
+     /*!
+      * \brief Enables the coarse-to-fine Doppler search.
+      *
+      * A coarse pass first correlates short segments of the snapshot (1/segments
+      * of it, so the Doppler step can be segments times wider) and adds up
+      * noncoherent_segments of them. Only the fine bins around the best
+      * candidates coarse cells are then searched with the whole snapshot.
+      * \param segments - Number of segments the snapshot is split into. 0 or 1
+      * searches every fine bin.
+      * \param noncoherent_segments - Segments added up in the coarse pass.
+      * \param candidates - Coarse cells refined in the fine pass.
+      */
+     void set_coarse_search(unsigned int segments, unsigned int noncoherent_segments, unsigned int candidates);
+
+     /*!
+      * \brief Restricts the search to the bins of the grid within
+      * doppler_center +/- doppler_window, e.g. around a predicted Doppler.
+      * The coarse search is skipped while a window is set.
+      * \param doppler_center - Centre of the window [Hz].
+      * \param doppler_window - Half width of the window [Hz]. 0 searches the whole grid.
+      */
+     void set_doppler_window(int doppler_center, unsigned int doppler_window)
+     {
+         d_doppler_window_center = doppler_center;
+         d_doppler_window = doppler_window;
+     }
+
      /*!
       * \brief Parallel Code Phase Search Acquisition signal processing.
       */
@@ -85,10 +85,10 @@ pcps_acquisition_fine_doppler_cc::pcps_acquisition_fine_doppler_cc(
     d_magnitude = static_cast<float*>(volk_malloc(d_fft_size * sizeof(float), volk_get_alignment()));
 
     // Direct FFT
-    d_fft_if = new gr::fft::fft_complex(d_fft_size, true);
+    d_fft_if = new Gnss_Fft(d_fft_size, true);
 
     // Inverse FFT
-    d_ifft = new gr::fft::fft_complex(d_fft_size, false);
+    d_ifft = new Gnss_Fft(d_fft_size, false);
 
     // For dumping samples into a file
     d_dump = dump;
@@ -333,7 +333,7 @@ int pcps_acquisition_fine_doppler_cc::estimate_Doppler(gr_vector_const_void_star
     // Direct FFT
     int zero_padding_factor = 2;
     int fft_size_extended = d_fft_size * zero_padding_factor;
-    gr::fft::fft_complex *fft_operator = new gr::fft::fft_complex(fft_size_extended, true);
+    Gnss_Fft *fft_operator = new Gnss_Fft(fft_size_extended, true);
 
     //zero padding the entire vector
     memset(fft_operator->get_inbuf(), 0, fft_size_extended * sizeof(gr_complex));
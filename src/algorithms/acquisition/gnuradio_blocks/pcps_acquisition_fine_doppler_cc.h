@@ -52,7 +52,7 @@
 #include <string>
 #include <gnuradio/block.h>
 #include <gnuradio/gr_complex.h>
-#include <gnuradio/fft/fft.h>
+#include "gnss_fft.h"
 #include "gnss_synchro.h"
 
 class pcps_acquisition_fine_doppler_cc;
@@ -120,8 +120,8 @@ private:
     float** d_grid_data;
     gr_complex** d_grid_doppler_wipeoffs;
 
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro *d_gnss_synchro;
     unsigned int d_code_phase;
     float d_doppler_freq;
@@ -54,7 +54,7 @@
 #include <string>
 #include <gnuradio/block.h>
 #include <gnuradio/gr_complex.h>
-#include <gnuradio/fft/fft.h>
+#include "gnss_fft.h"
 #include "gnss_synchro.h"
 
 class pcps_acquisition_sc;
@@ -115,8 +115,8 @@ private:
     unsigned int d_num_doppler_bins;
     gr_complex* d_fft_codes;
     gr_complex* d_in_32fc;
-    gr::fft::fft_complex* d_fft_if;
-    gr::fft::fft_complex* d_ifft;
+    Gnss_Fft* d_fft_if;
+    Gnss_Fft* d_ifft;
     Gnss_Synchro *d_gnss_synchro;
     unsigned int d_code_phase;
     float d_doppler_freq;
@@ -77,8 +77,6 @@ Channel::Channel(ConfigurationInterface *configuration, unsigned int channel,
 
     acq_->set_threshold(threshold);
 
-    acq_->init();
-
     repeat_ = configuration->property("Acquisition_" + implementation_ + boost::lexical_cast<std::string>(channel_) + ".repeat_satellite", false);
     DLOG(INFO) << "Channel " << channel_ << " satellite repeat = " << repeat_;
 
@@ -114,9 +112,10 @@ void Channel::connect(gr::top_block_sptr top_block)
     nav_->connect(top_block);
 
     //Synchronous ports
-    top_block->connect(pass_through_->get_right_block(), 0, acq_->get_left_block(), 0);
+    gr::basic_block_sptr input_block = sample_source_ ? sample_source_ : pass_through_->get_right_block();
+    top_block->connect(input_block, 0, acq_->get_left_block(), 0);
     DLOG(INFO) << "pass_through_ -> acquisition";
-    top_block->connect(pass_through_->get_right_block(), 0, trk_->get_left_block(), 0);
+    top_block->connect(input_block, 0, trk_->get_left_block(), 0);
     DLOG(INFO) << "pass_through_ -> tracking";
     top_block->connect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
     DLOG(INFO) << "tracking -> telemetry_decoder";
@@ -140,8 +139,9 @@ void Channel::disconnect(gr::top_block_sptr top_block)
             LOG(WARNING) << "Channel already disconnected internally";
             return;
         }
-    top_block->disconnect(pass_through_->get_right_block(), 0, acq_->get_left_block(), 0);
-    top_block->disconnect(pass_through_->get_right_block(), 0, trk_->get_left_block(), 0);
+    gr::basic_block_sptr input_block = sample_source_ ? sample_source_ : pass_through_->get_right_block();
+    top_block->disconnect(input_block, 0, acq_->get_left_block(), 0);
+    top_block->disconnect(input_block, 0, trk_->get_left_block(), 0);
     top_block->disconnect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
     pass_through_->disconnect(top_block);
     acq_->disconnect(top_block);
@@ -163,6 +163,12 @@ gr::basic_block_sptr Channel::get_right_block()
 }
 
 
+gr::basic_block_sptr Channel::get_tracking_block()
+{
+    return trk_->get_right_block();
+}
+
+
 void Channel::set_signal(const Gnss_Signal& gnss_signal)
 {
     gnss_signal_ = gnss_signal;
@@ -177,6 +183,37 @@ void Channel::set_signal(const Gnss_Signal& gnss_signal)
 }
 
 
+void Channel::set_sample_source(gr::basic_block_sptr source)
+{
+    if (connected_)
+        {
+            LOG(WARNING) << "Unable to change the sample source of a connected channel";
+            return;
+        }
+    sample_source_ = source;
+}
+
+
+void Channel::init()
+{
+    // Only touches the acquisition buffers of this channel, so the factory
+    // runs it for all the channels at once
+    acq_->init();
+}
+
+
+void Channel::set_doppler_window(int doppler_center, unsigned int doppler_window)
+{
+    acq_->set_doppler_window(doppler_center, doppler_window);
+}
+
+
+void Channel::set_event_queue(std::shared_ptr<Channel_Event_Queue> events)
+{
+    channel_fsm_.set_event_queue(events);
+}
+
+
 void Channel::start_acquisition()
 {
     channel_fsm_.Event_start_acquisition();
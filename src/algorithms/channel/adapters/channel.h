@@ -67,10 +67,13 @@ public:
             boost::shared_ptr<gr::msg_queue> queue);
     //! Virtual destructor
     virtual ~Channel();
+    //! Computes the acquisition grids. Must be called once before the first acquisition
+    void init();
     void connect(gr::top_block_sptr top_block);
     void disconnect(gr::top_block_sptr top_block);
     gr::basic_block_sptr get_left_block();
     gr::basic_block_sptr get_right_block();
+    gr::basic_block_sptr get_tracking_block();
     std::string role(){ return role_; }
 
     //! Returns "Channel"
@@ -82,6 +85,9 @@ public:
     std::shared_ptr<TelemetryDecoderInterface> telemetry(){ return nav_; }
     void start_acquisition();                   //!< Start the State Machine
     void set_signal(const Gnss_Signal& gnss_signal_);  //!< Sets the channel GNSS signal
+    void set_sample_source(gr::basic_block_sptr source); //!< Reads samples from source (e.g. a sample ring reader) instead of pass_through_
+    void set_doppler_window(int doppler_center, unsigned int doppler_window); //!< Narrows the acquisition Doppler search (0: whole grid)
+    void set_event_queue(std::shared_ptr<Channel_Event_Queue> events); //!< Posts the FSM events through events
 
     void msg_handler_events(pmt::pmt_t msg);
 
@@ -89,6 +95,7 @@ public:
 private:
     channel_msg_receiver_cc_sptr channel_msg_rx;
     std::shared_ptr<GNSSBlockInterface> pass_through_;
+    gr::basic_block_sptr sample_source_;
     std::shared_ptr<AcquisitionInterface> acq_;
     std::shared_ptr<TrackingInterface> trk_;
     std::shared_ptr<TelemetryDecoderInterface> nav_;
@@ -195,6 +195,11 @@ void ChannelFsm::set_queue(boost::shared_ptr<gr::msg_queue> queue)
     queue_ = queue;
 }
 
+void ChannelFsm::set_event_queue(std::shared_ptr<Channel_Event_Queue> events)
+{
+    events_ = events;
+}
+
 void ChannelFsm::set_channel(unsigned int channel)
 {
     channel_ = channel;
@@ -208,27 +213,29 @@ void ChannelFsm::start_acquisition()
 void ChannelFsm::start_tracking()
 {
     trk_->start_tracking();
-    std::unique_ptr<ControlMessageFactory> cmf(new ControlMessageFactory());
-    if (queue_ != gr::msg_queue::make())
-        {
-            queue_->handle(cmf->GetQueueMessage(channel_, 1));
-        }
+    notify(1);
 }
 
 void ChannelFsm::request_satellite()
 {
-    std::unique_ptr<ControlMessageFactory> cmf(new ControlMessageFactory());
-    if (queue_ != gr::msg_queue::make())
-        {
-            queue_->handle(cmf->GetQueueMessage(channel_, 0));
-        }
+    notify(0);
 }
 
 void ChannelFsm::notify_stop_tracking()
 {
+    notify(2);
+}
+
+void ChannelFsm::notify(unsigned int what)
+{
+    // The event queue neither locks nor allocates. The message queue is only used if it is full
+    if (events_ && events_->push(channel_, what))
+        {
+            return;
+        }
     std::unique_ptr<ControlMessageFactory> cmf(new ControlMessageFactory());
     if (queue_ != gr::msg_queue::make())
         {
-            queue_->handle(cmf->GetQueueMessage(channel_, 2));
+            queue_->handle(cmf->GetQueueMessage(channel_, what));
         }
 }
@@ -33,9 +33,11 @@
 #define GNSS_SDR_CHANNEL_FSM_H
 
 
+#include <memory>
 #include <boost/statechart/state_machine.hpp>
 #include <gnuradio/msg_queue.h>
 #include "acquisition_interface.h"
+#include "channel_event_queue.h"
 #include "tracking_interface.h"
 #include "telemetry_decoder_interface.h"
 
@@ -60,6 +62,8 @@ public:
     void set_acquisition(std::shared_ptr<AcquisitionInterface> acquisition);
     void set_tracking(std::shared_ptr<TrackingInterface> tracking);
     void set_queue(boost::shared_ptr<gr::msg_queue> queue);
+    //! Posts the control events through events instead of the message queue
+    void set_event_queue(std::shared_ptr<Channel_Event_Queue> events);
     void set_channel(unsigned int channel);
     void start_acquisition();
     void start_tracking();
@@ -75,9 +79,11 @@ public:
     void Event_failed_tracking_standby();
 
 private:
+    void notify(unsigned int what);
     std::shared_ptr<AcquisitionInterface> acq_;
     std::shared_ptr<TrackingInterface> trk_;
     boost::shared_ptr<gr::msg_queue> queue_;
+    std::shared_ptr<Channel_Event_Queue> events_;
     unsigned int channel_;
 };
 
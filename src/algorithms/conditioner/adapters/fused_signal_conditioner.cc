@@ -0,0 +1,218 @@
+/*!
+ * \file fused_signal_conditioner.cc
+ * \brief Signal conditioner that compiles the configured data type adapter,
+ * input filter and resampler into a single processing block.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "fused_signal_conditioner.h"
+#include <algorithm>
+#include <cmath>
+#include <glog/logging.h>
+#include "configuration_interface.h"
+#include "fir_filter.h"
+#include "freq_xlating_fir_filter.h"
+#include "pfb_resampler_conditioner.h"
+
+
+using google::LogMessage;
+
+// Constructor
+FusedSignalConditioner::FusedSignalConditioner(ConfigurationInterface *configuration,
+        std::shared_ptr<GNSSBlockInterface> data_type_adapt, std::shared_ptr<GNSSBlockInterface> in_filt,
+        std::shared_ptr<GNSSBlockInterface> res, std::string role, std::string implementation) :
+                data_type_adapt_(data_type_adapt),
+                in_filt_(in_filt), res_(res), role_(role), implementation_(implementation)
+{
+    tile_size_ = configuration->property(role_ + ".tile_size", 4096);
+    fusable_ = init_stages();
+    if (fusable_)
+        {
+            conditioner_ = fused_signal_conditioner_make_cc(input_item_type_, taps_, decimation_factor_,
+                    intermediate_freq_, sampling_freq_, resampler_freq_out_, resampler_passband_ratio_,
+                    resampler_taps_per_phase_, tile_size_);
+            DLOG(INFO) << "fused_signal_conditioner(" << conditioner_->unique_id() << ")";
+        }
+}
+
+
+// Destructor
+FusedSignalConditioner::~FusedSignalConditioner()
+{}
+
+
+bool FusedSignalConditioner::init_stages()
+{
+    std::string dta = data_type_adapt_->implementation();
+    std::string filt = in_filt_->implementation();
+    std::string res = res_->implementation();
+
+    taps_.clear();
+    decimation_factor_ = 1;
+    intermediate_freq_ = 0.0;
+    sampling_freq_ = 0.0;
+    resampler_freq_out_ = 0.0;
+    resampler_passband_ratio_ = 0.8;
+    resampler_taps_per_phase_ = 0;
+
+    // Type of the samples delivered to the filter (or to the resampler if there is no filter)
+    std::string complex_type;
+    if (dta.compare("Ishort_To_Complex") == 0)
+        {
+            input_item_type_ = "ishort";
+            complex_type = "gr_complex";
+        }
+    else if (dta.compare("Ibyte_To_Complex") == 0)
+        {
+            input_item_type_ = "ibyte";
+            complex_type = "gr_complex";
+        }
+    else if (dta.compare("Pass_Through") != 0)
+        {
+            LOG(WARNING) << "DataTypeAdapter " << dta << " cannot be fused";
+            return false;
+        }
+
+    if (filt.compare("Fir_Filter") == 0)
+        {
+            std::shared_ptr<FirFilter> fir = std::dynamic_pointer_cast<FirFilter>(in_filt_);
+            if (complex_type.empty())
+                {
+                    complex_type = fir->input_item_type();
+                }
+            if ((fir->input_item_type().compare(complex_type) != 0) || (fir->output_item_type().compare("gr_complex") != 0))
+                {
+                    LOG(WARNING) << "Fir_Filter from " << fir->input_item_type() << " to " << fir->output_item_type() << " cannot be fused";
+                    return false;
+                }
+            taps_ = fir->taps();
+        }
+    else if (filt.compare("Freq_Xlating_Fir_Filter") == 0)
+        {
+            std::shared_ptr<FreqXlatingFirFilter> fir = std::dynamic_pointer_cast<FreqXlatingFirFilter>(in_filt_);
+            if (complex_type.empty())
+                {
+                    complex_type = fir->input_item_type();
+                }
+            // Real-valued (float, short, byte) inputs are not supported
+            if ((complex_type.compare("gr_complex") != 0) || (fir->input_item_type().compare("gr_complex") != 0)
+                    || (fir->output_item_type().compare("gr_complex") != 0))
+                {
+                    LOG(WARNING) << "Freq_Xlating_Fir_Filter from " << fir->input_item_type() << " to " << fir->output_item_type() << " cannot be fused";
+                    return false;
+                }
+            taps_ = fir->taps();
+            decimation_factor_ = static_cast<unsigned int>(std::max(fir->decimation_factor(), 1));
+            intermediate_freq_ = fir->intermediate_freq();
+            sampling_freq_ = fir->sampling_freq();
+        }
+    else if (filt.compare("Pass_Through") != 0)
+        {
+            LOG(WARNING) << "InputFilter " << filt << " cannot be fused";
+            return false;
+        }
+
+    if (res.compare("Pfb_Resampler") == 0)
+        {
+            std::shared_ptr<PfbResamplerConditioner> pfb = std::dynamic_pointer_cast<PfbResamplerConditioner>(res_);
+            if (complex_type.empty())
+                {
+                    complex_type = pfb->item_type();
+                }
+            if ((pfb->item_type().compare("gr_complex") != 0) || (complex_type.compare("gr_complex") != 0))
+                {
+                    LOG(WARNING) << "Pfb_Resampler with item_type " << pfb->item_type() << " cannot be fused";
+                    return false;
+                }
+            if (sampling_freq_ == 0.0)
+                {
+                    sampling_freq_ = pfb->sample_freq_in();
+                }
+            else if (std::abs(sampling_freq_ / static_cast<double>(decimation_factor_) - pfb->sample_freq_in()) > 0.5)
+                {
+                    LOG(WARNING) << "Resampler sample_freq_in (" << pfb->sample_freq_in()
+                                 << ") does not match the input filter output rate. Using "
+                                 << sampling_freq_ / static_cast<double>(decimation_factor_);
+                }
+            resampler_freq_out_ = pfb->sample_freq_out();
+            resampler_passband_ratio_ = pfb->passband_ratio();
+            resampler_taps_per_phase_ = pfb->taps_per_phase();
+        }
+    else if (res.compare("Pass_Through") != 0)
+        {
+            LOG(WARNING) << "Resampler " << res << " cannot be fused";
+            return false;
+        }
+
+    if (complex_type.empty())
+        {
+            // All the stages are Pass_Through
+            complex_type = (data_type_adapt_->item_size() == sizeof(gr_complex)) ? "gr_complex" : "";
+        }
+    if (input_item_type_.empty())
+        {
+            input_item_type_ = complex_type;
+        }
+    if ((input_item_type_.compare("gr_complex") != 0) && (input_item_type_.compare("cshort") != 0)
+            && (input_item_type_.compare("cbyte") != 0) && (input_item_type_.compare("ishort") != 0)
+            && (input_item_type_.compare("ibyte") != 0))
+        {
+            LOG(WARNING) << "Input item type " << input_item_type_ << " cannot be fused";
+            return false;
+        }
+    if (sampling_freq_ == 0.0)
+        {
+            sampling_freq_ = 1.0; // only used for the frequency shift, which is disabled here
+        }
+
+    LOG(INFO) << "Fusing " << dta << " -> " << filt << " -> " << res << " into a single block";
+    return true;
+}
+
+
+void FusedSignalConditioner::connect(gr::top_block_sptr top_block)
+{
+    if(top_block) { /* top_block is not null */};
+    DLOG(INFO) << "nothing to connect internally";
+}
+
+
+void FusedSignalConditioner::disconnect(gr::top_block_sptr top_block)
+{
+    if(top_block) { /* top_block is not null */};
+    // Nothing to disconnect
+}
+
+
+gr::basic_block_sptr FusedSignalConditioner::get_left_block()
+{
+    return conditioner_;
+}
+
+gr::basic_block_sptr FusedSignalConditioner::get_right_block()
+{
+    return conditioner_;
+}
@@ -0,0 +1,104 @@
+/*!
+ * \file fused_signal_conditioner.h
+ * \brief Signal conditioner that compiles the configured data type adapter,
+ * input filter and resampler into a single processing block.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FUSED_SIGNAL_CONDITIONER_H_
+#define GNSS_SDR_FUSED_SIGNAL_CONDITIONER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "gnss_block_interface.h"
+#include "fused_signal_conditioner_cc.h"
+
+class ConfigurationInterface;
+
+/*!
+ * \brief This class takes the same DataTypeAdapter, InputFilter and Resampler
+ * blocks as SignalConditioner, but instead of connecting them it extracts
+ * their parameters and runs all of them in a single GNU Radio block.
+ *
+ * Supported stages (the output must be gr_complex):
+ * - DataTypeAdapter: Pass_Through, Ishort_To_Complex, Ibyte_To_Complex
+ * - InputFilter: Pass_Through, Fir_Filter, Freq_Xlating_Fir_Filter (gr_complex input)
+ * - Resampler: Pass_Through, Pfb_Resampler (gr_complex)
+ *
+ * Other combinations are reported by fusable(), so the caller can fall back to SignalConditioner.
+ */
+class FusedSignalConditioner: public GNSSBlockInterface
+{
+public:
+    //! Constructor
+    FusedSignalConditioner(ConfigurationInterface *configuration,
+            std::shared_ptr<GNSSBlockInterface> data_type_adapt, std::shared_ptr<GNSSBlockInterface> in_filt,
+            std::shared_ptr<GNSSBlockInterface> res, std::string role, std::string implementation);
+
+    //! Virtual destructor
+    virtual ~FusedSignalConditioner();
+
+    void connect(gr::top_block_sptr top_block);
+    void disconnect(gr::top_block_sptr top_block);
+    gr::basic_block_sptr get_left_block();
+    gr::basic_block_sptr get_right_block();
+
+    std::string role(){ return role_; }
+    //! Returns "Fused_Signal_Conditioner"
+    std::string implementation(){ return "Fused_Signal_Conditioner"; }
+    size_t item_size(){ return sizeof(gr_complex); }
+
+    //! True if the configured stages can be run by a single fused block
+    bool fusable(){ return fusable_; }
+
+    std::shared_ptr<GNSSBlockInterface> data_type_adapter(){ return data_type_adapt_; }
+    std::shared_ptr<GNSSBlockInterface> input_filter(){ return in_filt_; }
+    std::shared_ptr<GNSSBlockInterface> resampler(){ return res_; }
+
+private:
+    bool init_stages();
+
+    std::shared_ptr<GNSSBlockInterface> data_type_adapt_;
+    std::shared_ptr<GNSSBlockInterface> in_filt_;
+    std::shared_ptr<GNSSBlockInterface> res_;
+    std::string role_;
+    std::string implementation_;
+    bool fusable_;
+
+    std::string input_item_type_;
+    std::vector<float> taps_;
+    unsigned int decimation_factor_;
+    double intermediate_freq_;
+    double sampling_freq_;
+    double resampler_freq_out_;
+    float resampler_passband_ratio_;
+    unsigned int resampler_taps_per_phase_;
+    unsigned int tile_size_;
+    fused_signal_conditioner_cc_sptr conditioner_;
+};
+
+#endif /*GNSS_SDR_FUSED_SIGNAL_CONDITIONER_H_*/
@@ -0,0 +1,348 @@
+/*!
+ * \file fused_signal_conditioner_cc.cc
+ * \brief Signal conditioner that performs data type adaptation, input
+ *        filtering and resampling in a single GNU Radio block
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include "fused_signal_conditioner_cc.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <gnuradio/io_signature.h>
+#include <gnuradio/math.h>
+#include <glog/logging.h>
+#include <volk/volk.h>
+
+using google::LogMessage;
+
+#define FUSED_CONDITIONER_DEFAULT_TILE 4096
+
+namespace
+{
+size_t fused_input_item_size(const std::string& item_type)
+{
+    if (item_type.compare("gr_complex") == 0)
+        {
+            return sizeof(gr_complex);
+        }
+    else if (item_type.compare("cshort") == 0)
+        {
+            return sizeof(lv_16sc_t);
+        }
+    else if (item_type.compare("cbyte") == 0)
+        {
+            return sizeof(lv_8sc_t);
+        }
+    else if (item_type.compare("ishort") == 0)
+        {
+            return sizeof(int16_t);
+        }
+    else if (item_type.compare("ibyte") == 0)
+        {
+            return sizeof(int8_t);
+        }
+    LOG(WARNING) << item_type << " unrecognized item type for the fused signal conditioner. Using gr_complex";
+    return sizeof(gr_complex);
+}
+}
+
+
+fused_signal_conditioner_cc_sptr fused_signal_conditioner_make_cc(std::string input_item_type,
+        const std::vector<float>& taps, unsigned int decimation_factor,
+        double intermediate_freq, double sampling_freq,
+        double resampler_freq_out, float resampler_bandwidth,
+        unsigned int resampler_taps_per_phase, unsigned int tile_size)
+{
+    return fused_signal_conditioner_cc_sptr(new fused_signal_conditioner_cc(input_item_type,
+            taps, decimation_factor, intermediate_freq, sampling_freq,
+            resampler_freq_out, resampler_bandwidth, resampler_taps_per_phase, tile_size));
+}
+
+
+
+fused_signal_conditioner_cc::fused_signal_conditioner_cc(std::string input_item_type,
+        const std::vector<float>& taps, unsigned int decimation_factor,
+        double intermediate_freq, double sampling_freq,
+        double resampler_freq_out, float resampler_bandwidth,
+        unsigned int resampler_taps_per_phase, unsigned int tile_size) :
+        gr::block("fused_signal_conditioner_cc",
+                gr::io_signature::make(1, 1, fused_input_item_size(input_item_type)),
+                gr::io_signature::make(1, 1, sizeof(gr_complex)))
+{
+    d_input_item_type = input_item_type;
+    if ((d_input_item_type.compare("ishort") == 0) || (d_input_item_type.compare("ibyte") == 0))
+        {
+            d_items_per_sample = 2;
+        }
+    else
+        {
+            d_items_per_sample = 1;
+        }
+    d_tile_size = (tile_size > 0) ? tile_size : FUSED_CONDITIONER_DEFAULT_TILE;
+
+    // Frequency translation of intermediate_freq down to zero Hz
+    d_mix = (intermediate_freq != 0.0);
+    d_phase = gr_complex(1.0, 0.0);
+    d_phase_inc = std::polar<float>(1.0, -2.0 * GR_M_PI * intermediate_freq / sampling_freq);
+
+    // Low-pass filter
+    d_filter = !taps.empty();
+    d_ntaps = taps.size();
+    d_decimation = std::max(decimation_factor, 1u);
+    if (!d_filter && (d_decimation > 1))
+        {
+            LOG(WARNING) << "Decimation without an input filter is not supported by the fused signal conditioner. Ignoring decimation_factor";
+            d_decimation = 1;
+        }
+    d_taps = nullptr;
+    d_filter_buffer = nullptr;
+    d_filter_len = 0;
+    d_filter_idx = 0;
+    if (d_filter)
+        {
+            d_taps = static_cast<float*>(volk_malloc(d_ntaps * sizeof(float), volk_get_alignment()));
+            for (unsigned int i = 0; i < d_ntaps; i++)
+                {
+                    d_taps[i] = taps[d_ntaps - 1 - i];
+                }
+            d_filter_buffer = static_cast<gr_complex*>(volk_malloc((d_ntaps + d_decimation + d_tile_size) * sizeof(gr_complex), volk_get_alignment()));
+        }
+    d_stage_buffer = static_cast<gr_complex*>(volk_malloc(d_tile_size * sizeof(gr_complex), volk_get_alignment()));
+
+    // Polyphase resampler, running at the filter output rate
+    double resampler_freq_in = sampling_freq / static_cast<double>(d_decimation);
+    d_resampler_buffer = nullptr;
+    d_resampler_len = 0;
+    d_resampler_idx = 0;
+    d_acc = 0;
+    d_relative_rate = 1.0 / static_cast<double>(d_decimation);
+    if (resampler_freq_out > 0.0)
+        {
+            d_filterbank = std::unique_ptr<pfb_filterbank>(new pfb_filterbank(resampler_freq_in,
+                    resampler_freq_out, resampler_bandwidth, resampler_taps_per_phase));
+            d_resampler_buffer = static_cast<gr_complex*>(volk_malloc((d_filterbank->ntaps() + d_tile_size + 2) * sizeof(gr_complex), volk_get_alignment()));
+            d_relative_rate *= resampler_freq_out / resampler_freq_in;
+        }
+
+    LOG(INFO) << "Fused signal conditioner: input " << d_input_item_type
+              << ", frequency shift " << (d_mix ? intermediate_freq : 0.0) << " Hz"
+              << ", filter taps " << d_ntaps << ", decimation " << d_decimation
+              << ", resampler " << (d_filterbank ? "on" : "off")
+              << ", tile size " << d_tile_size;
+
+    set_relative_rate(d_relative_rate / static_cast<double>(d_items_per_sample));
+    // Room for the output of at least one input sample (one filter output, and
+    // up to ceil(L / M) + 1 resampler outputs), so that general_work never
+    // returns without consuming anything because noutput_items is too small
+    int min_output = 1;
+    if (d_filterbank)
+        {
+            min_output = static_cast<int>((d_filterbank->interpolation() + d_filterbank->decimation() - 1) / d_filterbank->decimation()) + 1;
+        }
+    set_output_multiple(min_output);
+}
+
+
+
+fused_signal_conditioner_cc::~fused_signal_conditioner_cc()
+{
+    if (d_taps != nullptr)
+        {
+            volk_free(d_taps);
+        }
+    if (d_filter_buffer != nullptr)
+        {
+            volk_free(d_filter_buffer);
+        }
+    if (d_resampler_buffer != nullptr)
+        {
+            volk_free(d_resampler_buffer);
+        }
+    volk_free(d_stage_buffer);
+}
+
+
+
+void fused_signal_conditioner_cc::convert(const void* in, gr_complex* out, int nsamples)
+{
+    if (d_input_item_type.compare("gr_complex") == 0)
+        {
+            std::memcpy(out, in, nsamples * sizeof(gr_complex));
+        }
+    else if ((d_input_item_type.compare("cshort") == 0) || (d_input_item_type.compare("ishort") == 0))
+        {
+            volk_16i_s32f_convert_32f(reinterpret_cast<float*>(out), static_cast<const int16_t*>(in), 1.0, 2 * nsamples);
+        }
+    else
+        {
+            volk_8i_s32f_convert_32f(reinterpret_cast<float*>(out), static_cast<const int8_t*>(in), 1.0, 2 * nsamples);
+        }
+    if (d_mix)
+        {
+            volk_32fc_s32fc_x2_rotator_32fc(out, out, d_phase_inc, &d_phase, nsamples);
+        }
+}
+
+
+
+int fused_signal_conditioner_cc::filter_tile(gr_complex* out)
+{
+    int k = 0;
+    while (d_filter_idx + static_cast<int>(d_ntaps) <= d_filter_len)
+        {
+            volk_32fc_32f_dot_prod_32fc(&out[k], d_filter_buffer + d_filter_idx, d_taps, d_ntaps);
+            k++;
+            d_filter_idx += d_decimation;
+        }
+    // Keep the samples still needed by the next output in front of the buffer
+    if (d_filter_idx <= d_filter_len)
+        {
+            d_filter_len -= d_filter_idx;
+            std::memmove(d_filter_buffer, d_filter_buffer + d_filter_idx, d_filter_len * sizeof(gr_complex));
+            d_filter_idx = 0;
+        }
+    else
+        {
+            d_filter_idx -= d_filter_len;
+            d_filter_len = 0;
+        }
+    return k;
+}
+
+
+
+int fused_signal_conditioner_cc::resample_tile(const gr_complex* in, int nsamples, gr_complex* out)
+{
+    std::memcpy(d_resampler_buffer + d_resampler_len, in, nsamples * sizeof(gr_complex));
+    d_resampler_len += nsamples;
+    const int ntaps = static_cast<int>(d_filterbank->ntaps());
+    int k = 0;
+    while (d_resampler_idx + ntaps <= d_resampler_len)
+        {
+            out[k] = d_filterbank->filter<gr_complex>(d_resampler_buffer + d_resampler_idx, d_acc);
+            k++;
+            d_resampler_idx += static_cast<int>(d_filterbank->advance(d_acc));
+        }
+    d_resampler_len -= d_resampler_idx;
+    std::memmove(d_resampler_buffer, d_resampler_buffer + d_resampler_idx, d_resampler_len * sizeof(gr_complex));
+    d_resampler_idx = 0;
+    return k;
+}
+
+
+
+/*
+ * Upper bound of the output of nsamples more input samples. Each stage
+ * produces all the outputs its buffer allows at every tile, so only the new
+ * samples add outputs: the filter outputs the windows that now fit in its
+ * buffer, and the resampler at most ceil(n L / M) outputs from n new samples.
+ */
+int fused_signal_conditioner_cc::max_output(int nsamples) const
+{
+    int n = nsamples;
+    if (d_filter)
+        {
+            int last = d_filter_len + nsamples - static_cast<int>(d_ntaps) - d_filter_idx;
+            n = (last >= 0) ? last / static_cast<int>(d_decimation) + 1 : 0;
+        }
+    if (d_filterbank)
+        {
+            uint64_t interpolation = d_filterbank->interpolation();
+            uint64_t decimation = d_filterbank->decimation();
+            n = static_cast<int>((static_cast<uint64_t>(n) * interpolation + decimation - 1) / decimation) + 1;
+        }
+    return n;
+}
+
+
+
+void fused_signal_conditioner_cc::forecast(int noutput_items,
+        gr_vector_int &ninput_items_required)
+{
+    // Internal stages keep their own history, so there is no extra input requirement
+    int nsamples = std::max(1, static_cast<int>(static_cast<double>(noutput_items) / d_relative_rate));
+    nsamples = std::min(nsamples, static_cast<int>(d_tile_size));
+    ninput_items_required[0] = nsamples * d_items_per_sample;
+}
+
+
+
+int fused_signal_conditioner_cc::general_work(int noutput_items,
+        gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+{
+    const char *in = static_cast<const char *>(input_items[0]);
+    gr_complex *out = static_cast<gr_complex *>(output_items[0]);
+    const size_t sample_size = input_signature()->sizeof_stream_item(0) * d_items_per_sample;
+    const int nsamples_available = ninput_items[0] / d_items_per_sample;
+
+    int consumed = 0;
+    int produced = 0;
+    while (consumed < nsamples_available)
+        {
+            int nsamples = std::min(static_cast<int>(d_tile_size), nsamples_available - consumed);
+            while ((nsamples > 0) && (max_output(nsamples) > noutput_items - produced))
+                {
+                    nsamples /= 2;
+                }
+            if (nsamples == 0)
+                {
+                    break;
+                }
+
+            // Stage 1: data type adaptation and frequency shift
+            // Stage 2: low-pass filter and decimation
+            gr_complex *stage_out = d_filterbank ? d_stage_buffer : out + produced;
+            int nstage;
+            if (d_filter)
+                {
+                    convert(in + consumed * sample_size, d_filter_buffer + d_filter_len, nsamples);
+                    d_filter_len += nsamples;
+                    nstage = filter_tile(stage_out);
+                }
+            else
+                {
+                    convert(in + consumed * sample_size, stage_out, nsamples);
+                    nstage = nsamples;
+                }
+
+            // Stage 3: resampling
+            if (d_filterbank)
+                {
+                    produced += resample_tile(d_stage_buffer, nstage, out + produced);
+                }
+            else
+                {
+                    produced += nstage;
+                }
+            consumed += nsamples;
+        }
+
+    consume_each(consumed * d_items_per_sample);
+    return produced;
+}
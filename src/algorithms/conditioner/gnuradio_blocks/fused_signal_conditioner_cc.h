@@ -0,0 +1,130 @@
+/*!
+ * \file fused_signal_conditioner_cc.h
+ * \brief Signal conditioner that performs data type adaptation, input
+ *        filtering and resampling in a single GNU Radio block
+ *
+ * Samples are processed in tiles small enough to stay in cache: each tile is
+ * converted to gr_complex, optionally shifted in frequency, low-pass filtered
+ * and decimated, and finally resampled, without going through the GNU Radio
+ * scheduler buffers between stages.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FUSED_SIGNAL_CONDITIONER_CC_H
+#define GNSS_SDR_FUSED_SIGNAL_CONDITIONER_CC_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <gnuradio/block.h>
+#include "pfb_filterbank.h"
+
+class fused_signal_conditioner_cc;
+typedef boost::shared_ptr<fused_signal_conditioner_cc> fused_signal_conditioner_cc_sptr;
+
+/*!
+ * \brief Makes a fused signal conditioner.
+ *
+ * \param[in] input_item_type One of "gr_complex", "cshort", "cbyte", "ishort" or "ibyte"
+ * \param[in] taps Low-pass filter taps. Empty for no filter
+ * \param[in] decimation_factor Integer decimation applied after the filter
+ * \param[in] intermediate_freq Frequency shifted down to 0 Hz before the filter (0 for no shift)
+ * \param[in] sampling_freq Sampling frequency of the input signal
+ * \param[in] resampler_freq_out Sampling frequency after resampling (0 for no resampler)
+ * \param[in] resampler_bandwidth Fraction of the smaller Nyquist band kept by the resampler
+ * \param[in] resampler_taps_per_phase Taps of each resampler filter (0 for automatic)
+ * \param[in] tile_size Number of input samples processed end to end at once
+ */
+fused_signal_conditioner_cc_sptr
+fused_signal_conditioner_make_cc(std::string input_item_type,
+        const std::vector<float>& taps, unsigned int decimation_factor,
+        double intermediate_freq, double sampling_freq,
+        double resampler_freq_out, float resampler_bandwidth,
+        unsigned int resampler_taps_per_phase, unsigned int tile_size);
+
+/*!
+ * \brief This class implements a fused signal conditioner with gr_complex output
+ */
+class fused_signal_conditioner_cc: public gr::block
+{
+private:
+    friend fused_signal_conditioner_cc_sptr
+    fused_signal_conditioner_make_cc(std::string input_item_type,
+            const std::vector<float>& taps, unsigned int decimation_factor,
+            double intermediate_freq, double sampling_freq,
+            double resampler_freq_out, float resampler_bandwidth,
+            unsigned int resampler_taps_per_phase, unsigned int tile_size);
+
+    fused_signal_conditioner_cc(std::string input_item_type,
+            const std::vector<float>& taps, unsigned int decimation_factor,
+            double intermediate_freq, double sampling_freq,
+            double resampler_freq_out, float resampler_bandwidth,
+            unsigned int resampler_taps_per_phase, unsigned int tile_size);
+
+    void convert(const void* in, gr_complex* out, int nsamples);
+    int filter_tile(gr_complex* out);
+    int resample_tile(const gr_complex* in, int nsamples, gr_complex* out);
+    int max_output(int nsamples) const;
+
+    std::string d_input_item_type;
+    int d_items_per_sample;      // 2 for interleaved (ishort, ibyte) inputs
+    unsigned int d_tile_size;
+
+    // Frequency translation
+    bool d_mix;
+    gr_complex d_phase;
+    gr_complex d_phase_inc;
+
+    // Low-pass filter and decimation. d_filter_buffer keeps the last
+    // taps - 1 samples of the previous tile in front of the current one.
+    bool d_filter;
+    unsigned int d_ntaps;
+    unsigned int d_decimation;
+    float* d_taps;              // stored in reverse order
+    gr_complex* d_filter_buffer;
+    int d_filter_len;
+    int d_filter_idx;
+
+    // Polyphase resampler
+    std::unique_ptr<pfb_filterbank> d_filterbank;
+    gr_complex* d_resampler_buffer;
+    int d_resampler_len;
+    int d_resampler_idx;
+    uint64_t d_acc;
+
+    gr_complex* d_stage_buffer; // filter output feeding the resampler
+    double d_relative_rate;
+
+public:
+    ~fused_signal_conditioner_cc();
+
+    void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+            gr_vector_const_void_star &input_items,
+            gr_vector_void_star &output_items);
+};
+
+#endif /* GNSS_SDR_FUSED_SIGNAL_CONDITIONER_CC_H */
@@ -89,6 +89,19 @@ public:
     gr::basic_block_sptr get_left_block();
     gr::basic_block_sptr get_right_block();
 
+    std::vector<float> taps()
+    {
+        return taps_;
+    }
+    std::string input_item_type()
+    {
+        return input_item_type_;
+    }
+    std::string output_item_type()
+    {
+        return output_item_type_;
+    }
+
 private:
     gr::filter::fir_filter_ccf::sptr fir_filter_ccf_;
     ConfigurationInterface* config_;
@@ -45,16 +45,15 @@ FreqXlatingFirFilter::FreqXlatingFirFilter(ConfigurationInterface* configuration
 {
     size_t item_size;
     (*this).init();
-    int decimation_factor;
     int default_decimation_factor = 1;
-    decimation_factor = config_->property(role_ + ".decimation_factor", default_decimation_factor);
+    decimation_factor_ = config_->property(role_ + ".decimation_factor", default_decimation_factor);
 
     if ((taps_item_type_.compare("float") == 0) && (input_item_type_.compare("gr_complex") == 0)
             && (output_item_type_.compare("gr_complex") == 0))
         {
             item_size = sizeof(gr_complex); //output
             input_size_ = sizeof(gr_complex); //input
-            freq_xlating_fir_filter_ccf_ = gr::filter::freq_xlating_fir_filter_ccf::make(decimation_factor, taps_, intermediate_freq_, sampling_freq_);
+            freq_xlating_fir_filter_ccf_ = gr::filter::freq_xlating_fir_filter_ccf::make(decimation_factor_, taps_, intermediate_freq_, sampling_freq_);
             DLOG(INFO) << "input_filter(" << freq_xlating_fir_filter_ccf_->unique_id() << ")";
         }
     else if((taps_item_type_.compare("float") == 0) && (input_item_type_.compare("float") == 0)
@@ -62,7 +61,7 @@ FreqXlatingFirFilter::FreqXlatingFirFilter(ConfigurationInterface* configuration
         {
             item_size = sizeof(gr_complex);
             input_size_ = sizeof(float); //input
-            freq_xlating_fir_filter_fcf_ = gr::filter::freq_xlating_fir_filter_fcf::make(decimation_factor, taps_, intermediate_freq_, sampling_freq_);
+            freq_xlating_fir_filter_fcf_ = gr::filter::freq_xlating_fir_filter_fcf::make(decimation_factor_, taps_, intermediate_freq_, sampling_freq_);
             DLOG(INFO) << "input_filter(" << freq_xlating_fir_filter_fcf_->unique_id() << ")";
         }
     else if((taps_item_type_.compare("float") == 0) && (input_item_type_.compare("short") == 0)
@@ -70,7 +69,7 @@ FreqXlatingFirFilter::FreqXlatingFirFilter(ConfigurationInterface* configuration
         {
             item_size = sizeof(gr_complex);
             input_size_ = sizeof(int16_t); //input
-            freq_xlating_fir_filter_scf_ = gr::filter::freq_xlating_fir_filter_scf::make(decimation_factor, taps_, intermediate_freq_, sampling_freq_);
+            freq_xlating_fir_filter_scf_ = gr::filter::freq_xlating_fir_filter_scf::make(decimation_factor_, taps_, intermediate_freq_, sampling_freq_);
             DLOG(INFO) << "input_filter(" << freq_xlating_fir_filter_scf_->unique_id() << ")";
         }
     else if((taps_item_type_.compare("float") == 0) && (input_item_type_.compare("short") == 0)
@@ -78,7 +77,7 @@ FreqXlatingFirFilter::FreqXlatingFirFilter(ConfigurationInterface* configuration
         {
             item_size = sizeof(lv_16sc_t);
             input_size_ = sizeof(int16_t); //input
-            freq_xlating_fir_filter_scf_ = gr::filter::freq_xlating_fir_filter_scf::make(decimation_factor, taps_, intermediate_freq_, sampling_freq_);
+            freq_xlating_fir_filter_scf_ = gr::filter::freq_xlating_fir_filter_scf::make(decimation_factor_, taps_, intermediate_freq_, sampling_freq_);
             DLOG(INFO) << "input_filter(" << freq_xlating_fir_filter_scf_->unique_id() << ")";
             complex_to_float_ = gr::blocks::complex_to_float::make();
             float_to_short_1_ = gr::blocks::float_to_short::make();
@@ -91,7 +90,7 @@ FreqXlatingFirFilter::FreqXlatingFirFilter(ConfigurationInterface* configuration
             item_size = sizeof(gr_complex);
             input_size_ = sizeof(int8_t); //input
             gr_char_to_short_ = gr::blocks::char_to_short::make();
-            freq_xlating_fir_filter_scf_ = gr::filter::freq_xlating_fir_filter_scf::make(decimation_factor, taps_, intermediate_freq_, sampling_freq_);
+            freq_xlating_fir_filter_scf_ = gr::filter::freq_xlating_fir_filter_scf::make(decimation_factor_, taps_, intermediate_freq_, sampling_freq_);
             DLOG(INFO) << "input_filter(" << freq_xlating_fir_filter_scf_->unique_id() << ")";
         }
     else if((taps_item_type_.compare("float") == 0) && (input_item_type_.compare("byte") == 0)
@@ -100,7 +99,7 @@ FreqXlatingFirFilter::FreqXlatingFirFilter(ConfigurationInterface* configuration
             item_size = sizeof(lv_8sc_t);
             input_size_ = sizeof(int8_t); //input
             gr_char_to_short_ = gr::blocks::char_to_short::make();
-            freq_xlating_fir_filter_scf_ = gr::filter::freq_xlating_fir_filter_scf::make(decimation_factor, taps_, intermediate_freq_, sampling_freq_);
+            freq_xlating_fir_filter_scf_ = gr::filter::freq_xlating_fir_filter_scf::make(decimation_factor_, taps_, intermediate_freq_, sampling_freq_);
             DLOG(INFO) << "input_filter(" << freq_xlating_fir_filter_scf_->unique_id() << ")";
             complex_to_complex_byte_ = make_complex_float_to_complex_byte();
         }
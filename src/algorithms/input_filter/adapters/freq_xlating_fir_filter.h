@@ -87,6 +87,31 @@ public:
     gr::basic_block_sptr get_left_block();
     gr::basic_block_sptr get_right_block();
 
+    std::vector<float> taps()
+    {
+        return taps_;
+    }
+    double intermediate_freq()
+    {
+        return intermediate_freq_;
+    }
+    double sampling_freq()
+    {
+        return sampling_freq_;
+    }
+    int decimation_factor()
+    {
+        return decimation_factor_;
+    }
+    std::string input_item_type()
+    {
+        return input_item_type_;
+    }
+    std::string output_item_type()
+    {
+        return output_item_type_;
+    }
+
 private:
     gr::filter::freq_xlating_fir_filter_ccf::sptr freq_xlating_fir_filter_ccf_;
     gr::filter::freq_xlating_fir_filter_fcf::sptr freq_xlating_fir_filter_fcf_;
@@ -101,6 +126,7 @@ private:
     std::vector <float> taps_;
     double intermediate_freq_;
     double sampling_freq_;
+    int decimation_factor_;
     std::string role_;
     unsigned int in_streams_;
     unsigned int out_streams_;
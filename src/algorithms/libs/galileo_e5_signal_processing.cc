@@ -34,6 +34,7 @@
 #include "galileo_e5_signal_processing.h"
 #include <gnuradio/math.h>
 #include "Galileo_E5a.h"
+#include "gnss_code_bank.h"
 #include "gnss_signal_processing.h"
 
 
@@ -103,38 +104,25 @@ void galileo_e5_a_code_gen_complex_primary(std::complex<float>* _dest, signed in
 void galileo_e5_a_code_gen_complex_sampled(std::complex<float>* _dest, char _Signal[3],
         unsigned int _prn, signed int _fs, unsigned int _chip_shift)
 {
-    unsigned int _samplesPerCode;
-    unsigned int delay;
     const unsigned int _codeLength = Galileo_E5a_CODE_LENGTH_CHIPS;
-    const int _codeFreqBasis = Galileo_E5a_CODE_CHIP_RATE_HZ;
+    const unsigned int _codeFreqBasis = static_cast<unsigned int>(Galileo_E5a_CODE_CHIP_RATE_HZ);
+    const unsigned int _samplesPerCode = Gnss_Code_Bank::samples_per_code(_codeLength, _codeFreqBasis, _fs);
+    const unsigned int delay = ((_codeLength - _chip_shift) % _codeLength) * _samplesPerCode / _codeLength;
 
-    std::complex<float>* _code = new std::complex<float>[_codeLength]();
-
-    galileo_e5_a_code_gen_complex_primary(_code , _prn , _Signal);
-
-    _samplesPerCode = static_cast<unsigned int>(static_cast<double>(_fs) / ( static_cast<double>(_codeFreqBasis) / static_cast<double>(_codeLength)));
-
-    delay = ((_codeLength - _chip_shift) % _codeLength) * _samplesPerCode / _codeLength;
-
-    if (_fs != _codeFreqBasis)
-        {
-            std::complex<float>* _resampled_signal;
-            if (posix_memalign((void**)&_resampled_signal, 16, _samplesPerCode * sizeof(gr_complex)) == 0){};
-            resampler(_code, _resampled_signal, _codeFreqBasis, _fs, _codeLength, _samplesPerCode); //resamples code to fs
-            delete[] _code;
-            _code = _resampled_signal;
-        }
-
-    for (unsigned int i = 0; i < _samplesPerCode; i++)
+    const uint64_t* _code_i = nullptr;
+    const uint64_t* _code_q = nullptr;
+    if (_Signal[0] == '5' && (_Signal[1] == 'I' || _Signal[1] == 'X'))
         {
-            _dest[(i + delay) % _samplesPerCode] = _code[i];
+            _code_i = Gnss_Code_Bank::instance().code(GALILEO_E5A_I_CODE, _prn);
         }
-    if (_fs != _codeFreqBasis)
+    if (_Signal[0] == '5' && (_Signal[1] == 'Q' || _Signal[1] == 'X'))
         {
-            free(_code);
-        }
-    else
-        {
-            delete[] _code;
+            _code_q = Gnss_Code_Bank::instance().code(GALILEO_E5A_Q_CODE, _prn);
         }
+
+    // The code is shifted by rotating the sampled code by delay samples
+    Gnss_Code_Bank::expand_sampled(_dest + delay, _code_i, _code_q, _codeLength, _codeFreqBasis, _fs, 0,
+            0, _samplesPerCode - delay, 1.0f);
+    Gnss_Code_Bank::expand_sampled(_dest, _code_i, _code_q, _codeLength, _codeFreqBasis, _fs, 0,
+            _samplesPerCode - delay, delay, 1.0f);
 }
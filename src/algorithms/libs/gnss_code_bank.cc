@@ -0,0 +1,265 @@
+/*!
+ * \file gnss_code_bank.cc
+ * \brief Bit-packed spreading codes of all the supported signals, and the
+ * routines that expand them into sampled local replicas.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_code_bank.h"
+#include <algorithm>
+#include <glog/logging.h>
+#include "galileo_e5_signal_processing.h"
+#include "gps_l2c_signal.h"
+#include "gps_sdr_signal_processing.h"
+#include "Galileo_E5a.h"
+#include "GPS_L1_CA.h"
+#include "GPS_L2C.h"
+
+using google::LogMessage;
+
+namespace
+{
+const unsigned int GPS_L1_CA_MAX_PRN = 138;
+const unsigned int GPS_L2_M_MAX_PRN = 50;
+
+// Number of PRN slots of each code
+const unsigned int code_slots[GNSS_CODE_BANK_SIZE] = {GPS_L1_CA_MAX_PRN + 1, GPS_L2_M_MAX_PRN + 1,
+        Galileo_E5a_NUMBER_OF_CODES + 1, Galileo_E5a_NUMBER_OF_CODES + 1};
+}
+
+
+Gnss_Code_Bank& Gnss_Code_Bank::instance()
+{
+    static Gnss_Code_Bank bank;
+    return bank;
+}
+
+
+Gnss_Code_Bank::Gnss_Code_Bank()
+{
+    for (int id = 0; id < GNSS_CODE_BANK_SIZE; id++)
+        {
+            d_codes[id].assign(code_slots[id] * words(static_cast<Gnss_Code_Id>(id)), 0);
+            d_valid[id].assign(code_slots[id], false);
+        }
+
+    std::vector<std::complex<float>> code(std::max(GPS_L2_M_CODE_LENGTH_CHIPS, Galileo_E5a_CODE_LENGTH_CHIPS));
+    for (unsigned int prn = 1; prn <= GPS_L1_CA_MAX_PRN; prn++)
+        {
+            if (prn <= 32 || prn >= 120)
+                {
+                    gps_l1_ca_code_gen_complex(code.data(), prn, 0);
+                    pack(GPS_L1_CA_CODE, prn, code.data(), false);
+                }
+        }
+    for (unsigned int prn = 1; prn <= GPS_L2_M_MAX_PRN; prn++)
+        {
+            gps_l2c_m_code_gen_complex(code.data(), prn);
+            pack(GPS_L2_M_CODE, prn, code.data(), false);
+        }
+    char signal_i[3] = "5I";
+    char signal_q[3] = "5Q";
+    for (int prn = 1; prn <= Galileo_E5a_NUMBER_OF_CODES; prn++)
+        {
+            galileo_e5_a_code_gen_complex_primary(code.data(), prn, signal_i);
+            pack(GALILEO_E5A_I_CODE, prn, code.data(), false);
+            galileo_e5_a_code_gen_complex_primary(code.data(), prn, signal_q);
+            pack(GALILEO_E5A_Q_CODE, prn, code.data(), true);
+        }
+    DLOG(INFO) << "Code bank generated, " << size_bytes() << " bytes";
+}
+
+
+unsigned int Gnss_Code_Bank::code_length(Gnss_Code_Id id)
+{
+    switch (id)
+    {
+    case GPS_L1_CA_CODE:
+        return static_cast<unsigned int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    case GPS_L2_M_CODE:
+        return static_cast<unsigned int>(GPS_L2_M_CODE_LENGTH_CHIPS);
+    case GALILEO_E5A_I_CODE:
+    case GALILEO_E5A_Q_CODE:
+        return static_cast<unsigned int>(Galileo_E5a_CODE_LENGTH_CHIPS);
+    default:
+        return 0;
+    }
+}
+
+
+unsigned int Gnss_Code_Bank::chip_rate(Gnss_Code_Id id)
+{
+    switch (id)
+    {
+    case GPS_L1_CA_CODE:
+        return static_cast<unsigned int>(GPS_L1_CA_CODE_RATE_HZ);
+    case GPS_L2_M_CODE:
+        return static_cast<unsigned int>(GPS_L2_M_CODE_RATE_HZ);
+    case GALILEO_E5A_I_CODE:
+    case GALILEO_E5A_Q_CODE:
+        return static_cast<unsigned int>(Galileo_E5a_CODE_CHIP_RATE_HZ);
+    default:
+        return 0;
+    }
+}
+
+
+unsigned int Gnss_Code_Bank::words(Gnss_Code_Id id)
+{
+    return (code_length(id) + 63) / 64;
+}
+
+
+void Gnss_Code_Bank::pack(Gnss_Code_Id id, unsigned int prn, const std::complex<float>* code, bool imaginary)
+{
+    uint64_t* packed = &d_codes[id][prn * words(id)];
+    for (unsigned int k = 0; k < code_length(id); k++)
+        {
+            float value = imaginary ? code[k].imag() : code[k].real();
+            if (value < 0.0)
+                {
+                    packed[k >> 6] |= static_cast<uint64_t>(1) << (k & 63);
+                }
+        }
+    d_valid[id][prn] = true;
+}
+
+
+const uint64_t* Gnss_Code_Bank::code(Gnss_Code_Id id, unsigned int prn) const
+{
+    if (id < 0 || id >= GNSS_CODE_BANK_SIZE || prn >= code_slots[id] || !d_valid[id][prn])
+        {
+            return nullptr;
+        }
+    return &d_codes[id][prn * words(id)];
+}
+
+
+size_t Gnss_Code_Bank::size_bytes() const
+{
+    size_t bytes = 0;
+    for (int id = 0; id < GNSS_CODE_BANK_SIZE; id++)
+        {
+            bytes += d_codes[id].size() * sizeof(uint64_t);
+        }
+    return bytes;
+}
+
+
+unsigned int Gnss_Code_Bank::samples_per_code(unsigned int code_length, unsigned int chip_rate, unsigned int fs)
+{
+    return static_cast<unsigned int>(static_cast<uint64_t>(fs) * code_length / chip_rate);
+}
+
+
+template <typename T>
+void Gnss_Code_Bank::expand(std::complex<T>* dest, const uint64_t* in_phase, const uint64_t* quadrature,
+        unsigned int code_length, unsigned int chip_shift, T amplitude)
+{
+    expand_sampled(dest, in_phase, quadrature, code_length, 1, 1, chip_shift, 0, code_length, amplitude);
+}
+
+
+template <typename T>
+void Gnss_Code_Bank::expand_sampled(std::complex<T>* dest, const uint64_t* in_phase, const uint64_t* quadrature,
+        unsigned int code_length, unsigned int chip_rate, unsigned int fs, unsigned int chip_shift,
+        unsigned int first_sample, unsigned int num_samples, T amplitude, bool previous_chip_at_edge)
+{
+    // Value of the replica for each pair of (in-phase, quadrature) chip bits
+    const T zero = static_cast<T>(0);
+    const T minus = static_cast<T>(-amplitude);
+    std::complex<T> values[4];
+    for (unsigned int b = 0; b < 4; b++)
+        {
+            values[b] = std::complex<T>(in_phase == nullptr ? zero : ((b & 1) ? minus : amplitude),
+                    quadrature == nullptr ? zero : ((b & 2) ? minus : amplitude));
+        }
+    chip_shift %= code_length;
+    auto chip_value = [&](unsigned int k) -> const std::complex<T>&
+            {
+                k += chip_shift;
+                if (k >= code_length) k -= code_length;
+                unsigned int b = 0;
+                if (in_phase != nullptr) b = chip(in_phase, k);
+                if (quadrature != nullptr) b |= chip(quadrature, k) << 1;
+                return values[b];
+            };
+
+    if (fs == chip_rate)
+        {
+            for (unsigned int n = 0; n < num_samples; n++)
+                {
+                    dest[n] = chip_value(first_sample + n);
+                }
+            return;
+        }
+
+    const unsigned int samples = samples_per_code(code_length, chip_rate, fs);
+    const unsigned int end = first_sample + num_samples;
+    const unsigned int last = (end >= samples) ? samples - 1 : end;    // The last sample of the period is set apart
+
+    // Chip of sample i: k = floor((i + 1) * chip_rate / fs), with remainder r
+    uint64_t q = static_cast<uint64_t>(first_sample + 1) * chip_rate;
+    if (previous_chip_at_edge)
+        {
+            // ceil((i + 1) * chip_rate / fs) - 1
+            q -= 1;
+        }
+    uint64_t k = q / fs;
+    uint64_t r = q % fs;
+    unsigned int i = first_sample;
+    while (i < last)
+        {
+            // Number of samples until the chip changes
+            unsigned int run = static_cast<unsigned int>((fs - r + chip_rate - 1) / chip_rate);
+            run = std::min(run, last - i);
+            const std::complex<T> value = chip_value(static_cast<unsigned int>(std::min(k, static_cast<uint64_t>(code_length - 1))));
+            std::fill(dest + (i - first_sample), dest + (i - first_sample + run), value);
+            i += run;
+            r += static_cast<uint64_t>(run) * chip_rate;
+            k += r / fs;
+            r %= fs;
+        }
+    if (end >= samples && samples > first_sample)
+        {
+            dest[samples - 1 - first_sample] = chip_value(code_length - 1);
+        }
+}
+
+
+template void Gnss_Code_Bank::expand<float>(std::complex<float>*, const uint64_t*, const uint64_t*,
+        unsigned int, unsigned int, float);
+template void Gnss_Code_Bank::expand<int16_t>(std::complex<int16_t>*, const uint64_t*, const uint64_t*,
+        unsigned int, unsigned int, int16_t);
+template void Gnss_Code_Bank::expand<int8_t>(std::complex<int8_t>*, const uint64_t*, const uint64_t*,
+        unsigned int, unsigned int, int8_t);
+
+template void Gnss_Code_Bank::expand_sampled<float>(std::complex<float>*, const uint64_t*, const uint64_t*,
+        unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, float, bool);
+template void Gnss_Code_Bank::expand_sampled<int16_t>(std::complex<int16_t>*, const uint64_t*, const uint64_t*,
+        unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, int16_t, bool);
+template void Gnss_Code_Bank::expand_sampled<int8_t>(std::complex<int8_t>*, const uint64_t*, const uint64_t*,
+        unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, int8_t, bool);
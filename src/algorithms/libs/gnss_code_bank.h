@@ -0,0 +1,127 @@
+/*!
+ * \file gnss_code_bank.h
+ * \brief Bit-packed spreading codes of all the supported signals, and the
+ * routines that expand them into sampled local replicas.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_CODE_BANK_H_
+#define GNSS_SDR_GNSS_CODE_BANK_H_
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum Gnss_Code_Id
+{
+    GPS_L1_CA_CODE = 0,      //!< GPS L1 C/A, PRN 1 to 32 and SBAS PRN 120 to 138
+    GPS_L2_M_CODE = 1,       //!< GPS L2C M, PRN 1 to 50
+    GALILEO_E5A_I_CODE = 2,  //!< Galileo E5a-I primary code, PRN 1 to 50
+    GALILEO_E5A_Q_CODE = 3,  //!< Galileo E5a-Q primary code, PRN 1 to 50
+    GNSS_CODE_BANK_SIZE = 4
+};
+
+/*!
+ * \brief Process-wide bank of spreading codes, stored with one bit per chip.
+ *
+ * All the codes of all the PRNs are generated once, when the bank is first
+ * used (the flowgraph does it at startup), and take a few hundred kilobytes.
+ * A set bit is a chip of value -1.
+ *
+ * The sampled replicas are expanded from the packed codes with exact integer
+ * arithmetic: the chip of sample i is floor((i + 1) * chip_rate / fs), as in
+ * the former floating point generators (but without their rounding errors
+ * near the chip edges), and each chip is written as a run of samples, with
+ * one integer division per run instead of a floating point division per
+ * sample. The same routines write std::complex<float>, lv_16sc_t and lv_8sc_t
+ * replicas, so acquisition, tracking and the signal generator share them
+ * whatever their sample type.
+ */
+class Gnss_Code_Bank
+{
+public:
+    static Gnss_Code_Bank& instance();
+
+    //! Returns the packed code, or nullptr if the PRN does not exist for that code
+    const uint64_t* code(Gnss_Code_Id id, unsigned int prn) const;
+
+    static unsigned int code_length(Gnss_Code_Id id);
+
+    //! Chip rate, in chips per second
+    static unsigned int chip_rate(Gnss_Code_Id id);
+
+    //! Memory taken by the packed codes, in bytes
+    size_t size_bytes() const;
+
+    //! Chip k of a packed code, as a bit (1 for a chip of value -1)
+    static inline unsigned int chip(const uint64_t* code, unsigned int k)
+    {
+        return static_cast<unsigned int>((code[k >> 6] >> (k & 63)) & 1);
+    }
+
+    /*!
+     * \brief Writes the code at one sample per chip, starting at chip_shift.
+     * \param[out] dest code_length samples
+     * \param[in] in_phase Packed code of the real part, or nullptr for zeros
+     * \param[in] quadrature Packed code of the imaginary part, or nullptr for zeros
+     * \param[in] amplitude Value of a +1 chip
+     */
+    template <typename T>
+    static void expand(std::complex<T>* dest, const uint64_t* in_phase, const uint64_t* quadrature,
+            unsigned int code_length, unsigned int chip_shift, T amplitude);
+
+    /*!
+     * \brief Writes samples first_sample to first_sample + num_samples - 1 of
+     * one code period sampled at fs, starting at chip_shift.
+     *
+     * A period has fs * code_length / chip_rate samples (truncated), and its
+     * last sample always takes the last chip. If fs is equal to the chip rate
+     * the code is copied chip by chip.
+     * \param[in] previous_chip_at_edge If true, a sample that ends exactly at
+     * a chip edge takes the chip before the edge (the GPS L2C generator rule)
+     */
+    template <typename T>
+    static void expand_sampled(std::complex<T>* dest, const uint64_t* in_phase, const uint64_t* quadrature,
+            unsigned int code_length, unsigned int chip_rate, unsigned int fs, unsigned int chip_shift,
+            unsigned int first_sample, unsigned int num_samples, T amplitude, bool previous_chip_at_edge = false);
+
+    //! Samples in one code period at fs
+    static unsigned int samples_per_code(unsigned int code_length, unsigned int chip_rate, unsigned int fs);
+
+private:
+    Gnss_Code_Bank();
+    Gnss_Code_Bank(const Gnss_Code_Bank&) = delete;
+    Gnss_Code_Bank& operator=(const Gnss_Code_Bank&) = delete;
+
+    static unsigned int words(Gnss_Code_Id id);
+    void pack(Gnss_Code_Id id, unsigned int prn, const std::complex<float>* code, bool imaginary);
+
+    std::vector<uint64_t> d_codes[GNSS_CODE_BANK_SIZE];    // PRN slots of words(id) words
+    std::vector<bool> d_valid[GNSS_CODE_BANK_SIZE];
+};
+
+#endif /* GNSS_SDR_GNSS_CODE_BANK_H_ */
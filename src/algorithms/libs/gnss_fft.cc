@@ -0,0 +1,296 @@
+/*!
+ * \file gnss_fft.cc
+ * \brief Process-wide registry of FFTW plans and the executors that run them
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_fft.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <gnuradio/fft/fft.h>
+#include <glog/logging.h>
+#include <volk/volk.h>
+
+using google::LogMessage;
+
+
+bool Gnss_Fft_Registry::Key::operator<(const Key& other) const
+{
+    if (size != other.size) return size < other.size;
+    if (forward != other.forward) return forward < other.forward;
+    if (in_alignment != other.in_alignment) return in_alignment < other.in_alignment;
+    if (out_alignment != other.out_alignment) return out_alignment < other.out_alignment;
+    return nthreads < other.nthreads;
+}
+
+
+Gnss_Fft_Registry& Gnss_Fft_Registry::instance()
+{
+    static Gnss_Fft_Registry registry;
+    return registry;
+}
+
+
+Gnss_Fft_Registry::Gnss_Fft_Registry() :
+        d_flags(FFTW_MEASURE),
+        d_wisdom_loaded(false),
+        d_wisdom_dirty(false),
+        d_plans_reused(0),
+        d_executors(0)
+{
+    // The planner mutex is a function-local static too. Taking it here
+    // constructs it before the registry, so it is destroyed after it.
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());
+#ifdef HAVE_FFTW3F_THREADS
+    fftwf_init_threads();
+#endif
+}
+
+
+Gnss_Fft_Registry::~Gnss_Fft_Registry()
+{
+    // Normally release_plans() has already emptied the cache
+    release_plans();
+}
+
+
+void Gnss_Fft_Registry::destroy_plans()
+{
+    // Called with both d_mutex and the gr::fft planner mutex held
+    for (std::map<Key, fftwf_plan>::iterator it = d_plans.begin(); it != d_plans.end(); ++it)
+        {
+            fftwf_destroy_plan(it->second);
+        }
+    d_plans.clear();
+}
+
+
+bool Gnss_Fft_Registry::release_plans()
+{
+    save_wisdom();
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_executors > 0)
+        {
+            LOG(WARNING) << "FFTW plans not released: " << d_executors << " FFT executors still exist";
+            return false;
+        }
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());
+    destroy_plans();
+    return true;
+}
+
+
+void Gnss_Fft_Registry::configure(const std::string& wisdom_filename, const std::string& rigor)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (rigor.compare("estimate") == 0)
+        {
+            d_flags = FFTW_ESTIMATE;
+        }
+    else if (rigor.compare("measure") == 0)
+        {
+            d_flags = FFTW_MEASURE;
+        }
+    else if (rigor.compare("patient") == 0)
+        {
+            d_flags = FFTW_PATIENT;
+        }
+    else if (rigor.compare("exhaustive") == 0)
+        {
+            d_flags = FFTW_EXHAUSTIVE;
+        }
+    else
+        {
+            LOG(WARNING) << rigor << " is not a valid FFTW planning rigor. Use estimate, measure, patient or exhaustive. Using measure";
+            d_flags = FFTW_MEASURE;
+        }
+    if (wisdom_filename.compare(d_wisdom_filename) != 0)
+        {
+            // Wisdom is merged, so the new file is read even if another one was
+            d_wisdom_filename = wisdom_filename;
+            d_wisdom_loaded = false;
+        }
+}
+
+
+std::string Gnss_Fft_Registry::wisdom_filename()
+{
+    if (!d_wisdom_filename.empty())
+        {
+            return d_wisdom_filename;
+        }
+    const char* home = std::getenv("HOME");
+    if (home == nullptr)
+        {
+            return std::string();
+        }
+    return std::string(home) + "/.gr_fftw_wisdom";
+}
+
+
+void Gnss_Fft_Registry::load_wisdom()
+{
+    // Called with both d_mutex and the gr::fft planner mutex held
+    if (d_wisdom_loaded)
+        {
+            return;
+        }
+    d_wisdom_loaded = true;
+    std::string filename = wisdom_filename();
+    if (filename.empty())
+        {
+            return;
+        }
+    if (fftwf_import_wisdom_from_filename(filename.c_str()) != 0)
+        {
+            LOG(INFO) << "FFTW wisdom read from " << filename;
+        }
+    else
+        {
+            LOG(INFO) << "No FFTW wisdom could be read from " << filename;
+        }
+}
+
+
+bool Gnss_Fft_Registry::save_wisdom()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (!d_wisdom_dirty)
+        {
+            return true;
+        }
+    std::string filename = wisdom_filename();
+    if (filename.empty())
+        {
+            return false;
+        }
+    // Write a temporary file and rename it, so that concurrent receivers never read half a file
+    std::string tmp_filename = filename + ".tmp";
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());
+    if (fftwf_export_wisdom_to_filename(tmp_filename.c_str()) == 0 || std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        {
+            std::remove(tmp_filename.c_str());
+            return false;
+        }
+    d_wisdom_dirty = false;
+    return true;
+}
+
+
+fftwf_plan Gnss_Fft_Registry::get_plan(unsigned int size, bool forward, unsigned int nthreads,
+        fftwf_complex* in, fftwf_complex* out)
+{
+    Key key;
+    key.size = size;
+    key.forward = forward;
+    key.in_alignment = fftwf_alignment_of(reinterpret_cast<float*>(in));
+    key.out_alignment = fftwf_alignment_of(reinterpret_cast<float*>(out));
+#ifdef HAVE_FFTW3F_THREADS
+    key.nthreads = std::max(nthreads, 1u);
+#else
+    key.nthreads = 1;
+#endif
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_executors++;
+    std::map<Key, fftwf_plan>::const_iterator it = d_plans.find(key);
+    if (it != d_plans.end())
+        {
+            d_plans_reused++;
+            return it->second;
+        }
+
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());
+    load_wisdom();
+#ifdef HAVE_FFTW3F_THREADS
+    fftwf_plan_with_nthreads(key.nthreads);
+#endif
+    // Planning with FFTW_MEASURE or above overwrites the buffers
+    fftwf_plan plan = fftwf_plan_dft_1d(size, in, out, forward ? FFTW_FORWARD : FFTW_BACKWARD, d_flags);
+    if (plan == nullptr)
+        {
+            LOG(ERROR) << "Unable to create an FFTW plan of length " << size;
+            d_executors--;
+            return plan;
+        }
+    d_plans[key] = plan;
+    d_wisdom_dirty = true;
+    DLOG(INFO) << "New FFTW plan: length " << size << (forward ? " forward" : " backward")
+               << ", " << key.nthreads << " thread(s)";
+    return plan;
+}
+
+
+unsigned int Gnss_Fft_Registry::plans_created()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_plans.size();
+}
+
+
+unsigned int Gnss_Fft_Registry::plans_reused()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_plans_reused;
+}
+
+
+Gnss_Fft::Gnss_Fft(unsigned int size, bool forward, unsigned int nthreads) : d_size(size)
+{
+    d_inbuf = static_cast<gr_complex*>(volk_malloc(d_size * sizeof(gr_complex), volk_get_alignment()));
+    d_outbuf = static_cast<gr_complex*>(volk_malloc(d_size * sizeof(gr_complex), volk_get_alignment()));
+    d_plan = Gnss_Fft_Registry::instance().get_plan(d_size, forward, nthreads,
+            reinterpret_cast<fftwf_complex*>(d_inbuf), reinterpret_cast<fftwf_complex*>(d_outbuf));
+    if (d_plan == nullptr)
+        {
+            volk_free(d_inbuf);
+            volk_free(d_outbuf);
+            throw std::runtime_error("fftwf_plan_dft_1d failed");
+        }
+    std::fill_n(d_inbuf, d_size, gr_complex(0.0, 0.0));
+    std::fill_n(d_outbuf, d_size, gr_complex(0.0, 0.0));
+}
+
+
+Gnss_Fft::~Gnss_Fft()
+{
+    Gnss_Fft_Registry& registry = Gnss_Fft_Registry::instance();
+    {
+        std::lock_guard<std::mutex> lock(registry.d_mutex);
+        registry.d_executors--;
+    }
+    volk_free(d_inbuf);
+    volk_free(d_outbuf);
+}
+
+
+void Gnss_Fft::execute()
+{
+    // The new-array execute function is thread safe, so executors share plans
+    fftwf_execute_dft(d_plan, reinterpret_cast<fftwf_complex*>(d_inbuf), reinterpret_cast<fftwf_complex*>(d_outbuf));
+}
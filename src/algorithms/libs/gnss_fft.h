@@ -0,0 +1,152 @@
+/*!
+ * \file gnss_fft.h
+ * \brief Process-wide registry of FFTW plans and the executors that run them
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_FFT_H_
+#define GNSS_SDR_GNSS_FFT_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <fftw3.h>
+#include <gnuradio/gr_complex.h>
+
+/*!
+ * \brief Process-wide cache of FFTW plans.
+ *
+ * Plans are keyed by length, direction, buffer alignment and number of
+ * threads, so all the blocks that use the same transform share one plan and
+ * the planning cost is paid once per process. Wisdom is read from a file
+ * before the first plan is made and written back with save_wisdom(), so that
+ * later runs skip the measurements altogether.
+ *
+ * FFTW plans are only created while holding the gr::fft planner mutex, so
+ * this registry can be used together with gr::fft::fft_complex.
+ *
+ * The plans should be freed with release_plans() once all the blocks are
+ * destroyed, rather than left to the destruction of the static registry,
+ * which runs in no defined order with respect to the other libraries.
+ */
+class Gnss_Fft_Registry
+{
+public:
+    static Gnss_Fft_Registry& instance();
+
+    /*!
+     * \brief Sets the wisdom file and the planning rigor ("estimate",
+     * "measure", "patient" or "exhaustive"). An empty filename selects
+     * $HOME/.gr_fftw_wisdom, the file used by gr::fft.
+     */
+    void configure(const std::string& wisdom_filename, const std::string& rigor);
+
+    std::string wisdom_filename();
+
+    //! Writes the accumulated wisdom, if there is any new, to the wisdom file
+    bool save_wisdom();
+
+    /*!
+     * \brief Saves the wisdom and destroys all the plans. It does nothing and
+     * returns false while any Gnss_Fft still exists. New plans can be made
+     * afterwards.
+     */
+    bool release_plans();
+
+    unsigned int plans_created();
+    unsigned int plans_reused();
+
+private:
+    struct Key
+    {
+        unsigned int size;
+        bool forward;
+        int in_alignment;
+        int out_alignment;
+        unsigned int nthreads;
+        bool operator<(const Key& other) const;
+    };
+
+    Gnss_Fft_Registry();
+    ~Gnss_Fft_Registry();
+    Gnss_Fft_Registry(const Gnss_Fft_Registry&) = delete;
+    Gnss_Fft_Registry& operator=(const Gnss_Fft_Registry&) = delete;
+
+    /*
+     * Returns a plan for buffers with the same alignment as in and out, or
+     * nullptr if FFTW fails. Each plan returned counts one executor, until
+     * the Gnss_Fft that asked for it is destroyed.
+     */
+    fftwf_plan get_plan(unsigned int size, bool forward, unsigned int nthreads,
+            fftwf_complex* in, fftwf_complex* out);
+    void load_wisdom();
+    void destroy_plans();
+
+    friend class Gnss_Fft;
+
+    std::mutex d_mutex;
+    std::map<Key, fftwf_plan> d_plans;
+    std::string d_wisdom_filename;
+    unsigned int d_flags;
+    bool d_wisdom_loaded;
+    bool d_wisdom_dirty;
+    unsigned int d_plans_reused;
+    unsigned int d_executors; // Gnss_Fft instances using the plans
+};
+
+
+/*!
+ * \brief FFT executor with its own input and output buffers, running a plan
+ * shared through Gnss_Fft_Registry.
+ *
+ * It is a drop-in replacement for gr::fft::fft_complex. Each block (thread)
+ * owns its executors, and executing a shared plan on different buffers is
+ * thread safe in FFTW. Like gr::fft::fft_complex, the constructor throws
+ * std::runtime_error if FFTW cannot make the plan.
+ */
+class Gnss_Fft
+{
+public:
+    Gnss_Fft(unsigned int size, bool forward, unsigned int nthreads = 1);
+    ~Gnss_Fft();
+
+    Gnss_Fft(const Gnss_Fft&) = delete;
+    Gnss_Fft& operator=(const Gnss_Fft&) = delete;
+
+    gr_complex* get_inbuf() const { return d_inbuf; }
+    gr_complex* get_outbuf() const { return d_outbuf; }
+    unsigned int size() const { return d_size; }
+
+    void execute();
+
+private:
+    unsigned int d_size;
+    gr_complex* d_inbuf;
+    gr_complex* d_outbuf;
+    fftwf_plan d_plan;
+};
+
+#endif /* GNSS_SDR_GNSS_FFT_H_ */
@@ -0,0 +1,315 @@
+/*!
+ * \file gnss_fft_planner.cc
+ * \brief Chooses fast FFT lengths for the acquisition blocks, either by
+ * resampling the input snapshot or by zero-padding the local code.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_fft_planner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include <glog/logging.h>
+#include "gnss_fft.h"
+
+// Element-wise operations per sample and Doppler bin besides the two FFTs
+// (carrier wipe-off, product with the code spectrum, magnitude and maximum)
+#define GNSS_FFT_PLANNER_LINEAR_OPS 4.0
+
+// A resampled snapshot loses a little sensitivity, so only switch to it
+// when it is clearly faster. Zero-padding is exact.
+#define GNSS_FFT_PLANNER_RESAMPLE_MARGIN 0.8
+#define GNSS_FFT_PLANNER_ZERO_PAD_MARGIN 0.95
+
+// Minimum time spent timing each length in the "measure" mode, in seconds
+#define GNSS_FFT_PLANNER_MEASURE_TIME 0.02
+
+using google::LogMessage;
+
+namespace
+{
+std::mutex timings_mutex;
+std::map<unsigned int, double> timings;
+bool timings_loaded = false;
+
+std::string timings_filename()
+{
+    const char* home = std::getenv("HOME");
+    if (home == nullptr)
+        {
+            return std::string();
+        }
+    return std::string(home) + "/.gnss_sdr_fft_timings";
+}
+
+void load_timings()
+{
+    if (timings_loaded)
+        {
+            return;
+        }
+    timings_loaded = true;
+    std::string filename = timings_filename();
+    if (filename.empty())
+        {
+            return;
+        }
+    std::ifstream file(filename.c_str());
+    unsigned int n;
+    double seconds;
+    while (file >> n >> seconds)
+        {
+            timings[n] = seconds;
+        }
+}
+
+void save_timings()
+{
+    std::string filename = timings_filename();
+    if (filename.empty())
+        {
+            return;
+        }
+    // Write a temporary file and rename it, so that concurrent receivers never read half a file
+    std::string tmp_filename = filename + ".tmp";
+    std::ofstream file(tmp_filename.c_str(), std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+        {
+            LOG(WARNING) << "Unable to write the FFT timings to " << tmp_filename;
+            return;
+        }
+    file.precision(9);
+    for (std::map<unsigned int, double>::const_iterator it = timings.begin(); it != timings.end(); ++it)
+        {
+            file << it->first << " " << it->second << std::endl;
+        }
+    file.close();
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        {
+            LOG(WARNING) << "Unable to write the FFT timings to " << filename;
+        }
+}
+
+const char* strategy_name(Gnss_Fft_Strategy strategy)
+{
+    switch (strategy)
+    {
+    case FFT_STRATEGY_RESAMPLE:
+        return "resample";
+    case FFT_STRATEGY_ZERO_PAD:
+        return "zero-pad";
+    default:
+        return "direct";
+    }
+}
+}
+
+
+std::string Gnss_Fft_Plan::to_string() const
+{
+    std::stringstream ss;
+    ss << strategy_name(strategy) << " (snapshot " << input_size << " samples, FFT length " << fft_size;
+    if (strategy != FFT_STRATEGY_DIRECT && direct_cost > 0.0)
+        {
+            ss << ", " << std::fixed;
+            ss.precision(2);
+            ss << cost / direct_cost << "x the cost of length " << input_size;
+        }
+    ss << ")";
+    return ss.str();
+}
+
+
+bool Gnss_Fft_Planner::is_smooth(unsigned int n)
+{
+    return (n > 0) && (largest_prime_factor(n) <= 7);
+}
+
+
+unsigned int Gnss_Fft_Planner::largest_prime_factor(unsigned int n)
+{
+    if (n < 2)
+        {
+            return n;
+        }
+    unsigned int largest = 1;
+    for (unsigned int p = 2; p * p <= n; p++)
+        {
+            while (n % p == 0)
+                {
+                    largest = p;
+                    n /= p;
+                }
+        }
+    return std::max(largest, n);
+}
+
+
+unsigned int Gnss_Fft_Planner::next_smooth(unsigned int n)
+{
+    unsigned int m = std::max(n, 1u);
+    while (!is_smooth(m))
+        {
+            m++;
+        }
+    return m;
+}
+
+
+unsigned int Gnss_Fft_Planner::next_power_of_two(unsigned int n)
+{
+    unsigned int m = 1;
+    while (m < n)
+        {
+            m <<= 1;
+        }
+    return m;
+}
+
+
+double Gnss_Fft_Planner::estimated_cost(unsigned int n)
+{
+    if (n < 2)
+        {
+            return 1.0;
+        }
+    // FFTW has hard-coded kernels for small radices. Lengths with a large
+    // prime factor go through Rader's or Bluestein's algorithm, which costs
+    // about as much as several transforms of a fast length.
+    unsigned int p = largest_prime_factor(n);
+    double weight;
+    if (p == 2)
+        {
+            weight = 1.0;
+        }
+    else if (p <= 7)
+        {
+            weight = 1.2;
+        }
+    else if (p <= 13)
+        {
+            weight = 1.6;
+        }
+    else
+        {
+            weight = 4.0;
+        }
+    return weight * static_cast<double>(n) * std::log2(static_cast<double>(n));
+}
+
+
+double Gnss_Fft_Planner::measured_cost(unsigned int n)
+{
+    std::lock_guard<std::mutex> lock(timings_mutex);
+    load_timings();
+    std::map<unsigned int, double>::const_iterator it = timings.find(n);
+    if (it != timings.end())
+        {
+            return it->second;
+        }
+
+    Gnss_Fft fft(n, true);
+    fft.execute();
+    unsigned int iterations = 0;
+    double elapsed = 0.0;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    while ((iterations < 3) || (elapsed < GNSS_FFT_PLANNER_MEASURE_TIME && iterations < 1000))
+        {
+            fft.execute();
+            iterations++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        }
+    double seconds = elapsed / static_cast<double>(iterations);
+    DLOG(INFO) << "FFT of length " << n << " takes " << seconds << " s";
+    timings[n] = seconds;
+    save_timings();
+    return seconds;
+}
+
+
+Gnss_Fft_Plan Gnss_Fft_Planner::plan(unsigned int input_size, bool linear_correlation, const std::string& mode)
+{
+    Gnss_Fft_Plan direct;
+    direct.strategy = FFT_STRATEGY_DIRECT;
+    direct.input_size = input_size;
+    direct.fft_size = input_size;
+    direct.cost = 0.0;
+    direct.direct_cost = 0.0;
+
+    bool measure = (mode.compare("measure") == 0);
+    if (!measure && mode.compare("estimate") != 0)
+        {
+            if (mode.compare("off") != 0)
+                {
+                    LOG(WARNING) << mode << " is not a valid FFT planner mode. Use off, estimate or measure";
+                }
+            return direct;
+        }
+    if (input_size < 2)
+        {
+            return direct;
+        }
+
+    std::vector<unsigned int> candidates;
+    candidates.push_back(next_smooth(input_size));
+    candidates.push_back(next_power_of_two(input_size));
+
+    // Cost of the element-wise operations, in the units of the FFT cost
+    unsigned int reference = next_power_of_two(input_size);
+    double unit = (measure ? measured_cost(reference) : estimated_cost(reference))
+            / (static_cast<double>(reference) * std::log2(static_cast<double>(reference)));
+
+    direct.cost = 2.0 * (measure ? measured_cost(input_size) : estimated_cost(input_size))
+            + GNSS_FFT_PLANNER_LINEAR_OPS * unit * static_cast<double>(input_size);
+    direct.direct_cost = direct.cost;
+
+    Gnss_Fft_Plan best = direct;
+    double margin = linear_correlation ? GNSS_FFT_PLANNER_ZERO_PAD_MARGIN : GNSS_FFT_PLANNER_RESAMPLE_MARGIN;
+    for (unsigned int i = 0; i < candidates.size(); i++)
+        {
+            unsigned int n = candidates.at(i);
+            if (n == input_size)
+                {
+                    continue;
+                }
+            double cost = 2.0 * (measure ? measured_cost(n) : estimated_cost(n))
+                    + GNSS_FFT_PLANNER_LINEAR_OPS * unit * static_cast<double>(n);
+            if (cost < margin * direct.cost && cost < best.cost)
+                {
+                    best.strategy = linear_correlation ? FFT_STRATEGY_ZERO_PAD : FFT_STRATEGY_RESAMPLE;
+                    best.fft_size = n;
+                    best.cost = cost;
+                }
+        }
+    return best;
+}
@@ -0,0 +1,102 @@
+/*!
+ * \file gnss_fft_planner.h
+ * \brief Chooses fast FFT lengths for the acquisition blocks, either by
+ * resampling the input snapshot or by zero-padding the local code.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_FFT_PLANNER_H_
+#define GNSS_SDR_GNSS_FFT_PLANNER_H_
+
+#include <string>
+
+enum Gnss_Fft_Strategy
+{
+    FFT_STRATEGY_DIRECT = 0,   //!< FFT length equal to the snapshot length
+    FFT_STRATEGY_RESAMPLE = 1, //!< Snapshot and code resampled to a fast length
+    FFT_STRATEGY_ZERO_PAD = 2  //!< Linear correlation zero-padded to a fast length
+};
+
+/*!
+ * \brief FFT length chosen for an acquisition snapshot
+ */
+struct Gnss_Fft_Plan
+{
+    Gnss_Fft_Strategy strategy;
+    unsigned int input_size; //!< Samples in the input snapshot
+    unsigned int fft_size;   //!< Length of the transforms
+    double cost;             //!< Cost of one Doppler bin with this length
+    double direct_cost;      //!< Cost of one Doppler bin with the input length
+
+    std::string to_string() const;
+};
+
+/*!
+ * \brief Picks the FFT length of the parallel code phase search.
+ *
+ * The snapshot length of an acquisition block is set by the sampling rate
+ * and the code period, and often has large prime factors for which FFTW is
+ * several times slower than for a nearby 2^a 3^b 5^c 7^d length. For
+ * circular correlation the planner can resample the snapshot (and the local
+ * code) to a longer, fast length. For linear correlation (the
+ * bit_transition_flag mode, where the code is already zero-padded to twice
+ * its length) it can simply pad to a longer, fast length, which is exact.
+ *
+ * Modes:
+ * - "off": always use the snapshot length
+ * - "estimate": compare lengths with an operation count model
+ * - "measure": time the candidate lengths. The timings are kept in
+ *   $HOME/.gnss_sdr_fft_timings so the benchmark is only run once per length
+ *   and machine, and the plans made for it are kept by Gnss_Fft_Registry,
+ *   which also saves the FFTW wisdom.
+ */
+class Gnss_Fft_Planner
+{
+public:
+    /*!
+     * \brief Returns the plan for a snapshot of input_size samples.
+     * \param[in] input_size Samples in the snapshot
+     * \param[in] linear_correlation True if the second half of the code
+     * replica is zero-padded (bit_transition_flag mode)
+     * \param[in] mode "off", "estimate" or "measure"
+     */
+    static Gnss_Fft_Plan plan(unsigned int input_size, bool linear_correlation, const std::string& mode);
+
+    //! True if n has no prime factor larger than 7
+    static bool is_smooth(unsigned int n);
+
+    static unsigned int largest_prime_factor(unsigned int n);
+    static unsigned int next_smooth(unsigned int n);
+    static unsigned int next_power_of_two(unsigned int n);
+
+    //! Relative cost of one FFT of length n according to the operation count model
+    static double estimated_cost(unsigned int n);
+
+    //! Execution time of one FFT of length n, in seconds
+    static double measured_cost(unsigned int n);
+};
+
+#endif /* GNSS_SDR_GNSS_FFT_PLANNER_H_ */
@@ -0,0 +1,346 @@
+/*!
+ * \file gnss_sample_ring.cc
+ * \brief Single-producer / multi-consumer ring of signal samples shared by
+ * all the channels fed by the same signal conditioner.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_sample_ring.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <sys/mman.h>
+#include <glog/logging.h>
+
+// Huge pages are 2 MB on the platforms that support MAP_HUGETLB
+#define GNSS_SAMPLE_RING_HUGEPAGE_SIZE (2 * 1024 * 1024)
+
+using google::LogMessage;
+
+Gnss_Sample_Ring::Gnss_Sample_Ring(size_t item_size, uint64_t capacity, unsigned int max_read_items, bool use_hugepages) :
+        d_item_size(item_size),
+        d_max_read_items(max_read_items),
+        d_hugepages(false),
+        d_alloc_size(0),
+        d_buffer(nullptr),
+        d_write_stamp(0),
+        d_reserve_stamp(0),
+        d_done(false)
+{
+    // Round the capacity up to a power of two so that stamps map to slots with a mask
+    d_capacity = 1;
+    while (d_capacity < std::max<uint64_t>(capacity, 2 * static_cast<uint64_t>(max_read_items)))
+        {
+            d_capacity <<= 1;
+        }
+    d_mask = d_capacity - 1;
+    d_hugepages = use_hugepages;
+    allocate();
+    LOG(INFO) << "Sample ring of " << d_capacity << " items of " << d_item_size << " bytes"
+              << (d_hugepages ? " backed by huge pages" : "");
+}
+
+
+Gnss_Sample_Ring::~Gnss_Sample_Ring()
+{
+    if (d_buffer != nullptr)
+        {
+            munmap(d_buffer, d_alloc_size);
+        }
+}
+
+
+void Gnss_Sample_Ring::allocate()
+{
+    size_t size = (d_capacity + d_max_read_items) * d_item_size;
+    void* buffer = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (d_hugepages)
+        {
+            d_alloc_size = ((size + GNSS_SAMPLE_RING_HUGEPAGE_SIZE - 1) / GNSS_SAMPLE_RING_HUGEPAGE_SIZE) * GNSS_SAMPLE_RING_HUGEPAGE_SIZE;
+            buffer = mmap(nullptr, d_alloc_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (buffer == MAP_FAILED)
+                {
+                    LOG(WARNING) << "Unable to allocate the sample ring in huge pages, using regular pages";
+                }
+        }
+#endif
+    if (buffer == MAP_FAILED)
+        {
+            d_hugepages = false;
+            d_alloc_size = size;
+            buffer = mmap(nullptr, d_alloc_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (buffer == MAP_FAILED)
+                {
+                    LOG(ERROR) << "Unable to allocate " << d_alloc_size << " bytes for the sample ring";
+                    d_alloc_size = 0;
+                    d_capacity = 0;
+                    return;
+                }
+#ifdef MADV_HUGEPAGE
+            // Let transparent huge pages back the ring if they are enabled
+            madvise(buffer, d_alloc_size, MADV_HUGEPAGE);
+#endif
+        }
+    d_buffer = static_cast<char*>(buffer);
+}
+
+
+uint64_t Gnss_Sample_Ring::oldest_stamp() const
+{
+    uint64_t reserve = d_reserve_stamp.load(std::memory_order_acquire);
+    return (reserve > d_capacity) ? reserve - d_capacity : 0;
+}
+
+
+void Gnss_Sample_Ring::write(const void* items, uint64_t nitems)
+{
+    if (d_buffer == nullptr)
+        {
+            return;
+        }
+    const char* in = static_cast<const char*>(items);
+    uint64_t stamp = d_write_stamp.load(std::memory_order_relaxed);
+    while (nitems > 0)
+        {
+            uint64_t idx = stamp & d_mask;
+            uint64_t n = std::min(nitems, d_capacity - idx);
+            // Announce the slots about to be overwritten before touching them
+            d_reserve_stamp.store(stamp + n, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(d_buffer + idx * d_item_size, in, n * d_item_size);
+            if (idx < d_max_read_items)
+                {
+                    uint64_t nmirror = std::min<uint64_t>(n, d_max_read_items - idx);
+                    std::memcpy(d_buffer + (d_capacity + idx) * d_item_size, in, nmirror * d_item_size);
+                }
+            stamp += n;
+            in += n * d_item_size;
+            nitems -= n;
+            d_write_stamp.store(stamp, std::memory_order_release);
+        }
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+    }
+    d_cond.notify_all();
+}
+
+
+void Gnss_Sample_Ring::set_done()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_done.store(true, std::memory_order_release);
+    }
+    d_cond.notify_all();
+}
+
+
+bool Gnss_Sample_Ring::wait(uint64_t stamp, unsigned int timeout_ms)
+{
+    if (write_stamp() > stamp)
+        {
+            return true;
+        }
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_cond.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this, stamp]
+            {
+                return (write_stamp() > stamp) || done();
+            });
+    return write_stamp() > stamp;
+}
+
+
+unsigned int Gnss_Sample_Ring::add_reader()
+{
+    std::unique_ptr<Reader> reader(new Reader);
+    reader->cursor.store(write_stamp());
+    reader->overrun_items.store(0);
+    reader->zero_fill_stamp.store(0);
+    d_readers.push_back(std::move(reader));
+    return d_readers.size() - 1;
+}
+
+
+uint64_t Gnss_Sample_Ring::cursor(unsigned int reader) const
+{
+    return d_readers.at(reader)->cursor.load(std::memory_order_relaxed);
+}
+
+
+void Gnss_Sample_Ring::seek(unsigned int reader, uint64_t stamp)
+{
+    d_readers.at(reader)->cursor.store(stamp, std::memory_order_relaxed);
+}
+
+
+uint64_t Gnss_Sample_Ring::available(unsigned int reader) const
+{
+    uint64_t cursor = d_readers.at(reader)->cursor.load(std::memory_order_relaxed);
+    uint64_t stamp = write_stamp();
+    return (stamp > cursor) ? stamp - cursor : 0;
+}
+
+
+uint64_t Gnss_Sample_Ring::overrun_items(unsigned int reader) const
+{
+    return d_readers.at(reader)->overrun_items.load(std::memory_order_relaxed);
+}
+
+
+bool Gnss_Sample_Ring::is_valid(uint64_t stamp) const
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t reserve = d_reserve_stamp.load(std::memory_order_relaxed);
+    return reserve <= stamp + d_capacity;
+}
+
+
+void Gnss_Sample_Ring::copy_out(uint64_t stamp, void* out, unsigned int nitems) const
+{
+    char* dst = static_cast<char*>(out);
+    while (nitems > 0)
+        {
+            uint64_t idx = stamp & d_mask;
+            unsigned int n = static_cast<unsigned int>(std::min<uint64_t>(nitems, d_capacity - idx));
+            std::memcpy(dst, d_buffer + idx * d_item_size, n * d_item_size);
+            dst += n * d_item_size;
+            stamp += n;
+            nitems -= n;
+        }
+}
+
+
+unsigned int Gnss_Sample_Ring::read(unsigned int reader, void* out, unsigned int nitems, uint64_t& lost_items)
+{
+    Reader* r = d_readers.at(reader).get();
+    uint64_t cursor = r->cursor.load(std::memory_order_relaxed);
+    lost_items = 0;
+    if (d_buffer == nullptr)
+        {
+            return 0;
+        }
+    uint64_t stamp = write_stamp();
+    if (!is_valid(cursor))
+        {
+            // Overrun: skip the lost samples and resume from the live data
+            lost_items = stamp - cursor;
+            cursor = stamp;
+        }
+    unsigned int n = 0;
+    if (stamp > cursor)
+        {
+            n = static_cast<unsigned int>(std::min<uint64_t>(nitems, stamp - cursor));
+        }
+    if (n > 0)
+        {
+            copy_out(cursor, out, n);
+            if (!is_valid(cursor))
+                {
+                    // The producer lapped us while copying
+                    uint64_t now = write_stamp();
+                    lost_items += now - cursor;
+                    cursor = now;
+                    n = 0;
+                }
+            else
+                {
+                    cursor += n;
+                }
+        }
+    if (lost_items > 0)
+        {
+            r->overrun_items.fetch_add(lost_items, std::memory_order_relaxed);
+        }
+    r->cursor.store(cursor, std::memory_order_relaxed);
+    return n;
+}
+
+
+unsigned int Gnss_Sample_Ring::read_zero_filled(unsigned int reader, void* out, unsigned int nitems, uint64_t& lost_items)
+{
+    Reader* r = d_readers.at(reader).get();
+    uint64_t cursor = r->cursor.load(std::memory_order_relaxed);
+    uint64_t zero_fill_stamp = r->zero_fill_stamp.load(std::memory_order_relaxed);
+    lost_items = 0;
+    if (d_buffer == nullptr)
+        {
+            return 0;
+        }
+    if ((cursor >= zero_fill_stamp) && !is_valid(cursor))
+        {
+            // Overrun: the lost samples, up to the live data, are output as zeros
+            zero_fill_stamp = write_stamp();
+            lost_items = zero_fill_stamp - cursor;
+            r->overrun_items.fetch_add(lost_items, std::memory_order_relaxed);
+            r->zero_fill_stamp.store(zero_fill_stamp, std::memory_order_relaxed);
+        }
+    if (cursor < zero_fill_stamp)
+        {
+            unsigned int n = static_cast<unsigned int>(std::min<uint64_t>(nitems, zero_fill_stamp - cursor));
+            std::memset(out, 0, n * d_item_size);
+            r->cursor.store(cursor + n, std::memory_order_relaxed);
+            return n;
+        }
+    uint64_t stamp = write_stamp();
+    unsigned int n = 0;
+    if (stamp > cursor)
+        {
+            n = static_cast<unsigned int>(std::min<uint64_t>(nitems, stamp - cursor));
+        }
+    if (n > 0)
+        {
+            copy_out(cursor, out, n);
+            if (!is_valid(cursor))
+                {
+                    // The producer lapped us while copying: the next call fills the gap
+                    return 0;
+                }
+            r->cursor.store(cursor + n, std::memory_order_relaxed);
+        }
+    return n;
+}
+
+
+bool Gnss_Sample_Ring::read_at(uint64_t stamp, void* out, unsigned int nitems) const
+{
+    if ((d_buffer == nullptr) || (stamp + nitems > write_stamp()) || !is_valid(stamp))
+        {
+            return false;
+        }
+    copy_out(stamp, out, nitems);
+    return is_valid(stamp);
+}
+
+
+const void* Gnss_Sample_Ring::peek(uint64_t stamp) const
+{
+    if (d_buffer == nullptr)
+        {
+            return nullptr;
+        }
+    return d_buffer + (stamp & d_mask) * d_item_size;
+}
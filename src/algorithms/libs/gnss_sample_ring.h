@@ -0,0 +1,175 @@
+/*!
+ * \file gnss_sample_ring.h
+ * \brief Single-producer / multi-consumer ring of signal samples shared by
+ * all the channels fed by the same signal conditioner.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SAMPLE_RING_H_
+#define GNSS_SDR_GNSS_SAMPLE_RING_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*!
+ * \brief Ring buffer of samples written by one producer and read by any
+ * number of consumers, each one with its own read cursor.
+ *
+ * Samples are addressed by their sample stamp, that is, the absolute index of
+ * the sample since the ring was created. The producer never waits for the
+ * consumers: a reader that falls more than capacity() samples behind loses
+ * the overwritten samples and is moved forward to the live data, so a
+ * latency spike in one channel does not stall the rest of the RF chain.
+ *
+ * The first max_read_items() slots are mirrored after the end of the
+ * buffer, so peek() always returns a contiguous block of up to
+ * max_read_items() samples.
+ */
+class Gnss_Sample_Ring
+{
+public:
+    /*!
+     * \param[in] item_size Size of each sample, in bytes
+     * \param[in] capacity Number of samples kept in the ring (rounded up to a power of two)
+     * \param[in] max_read_items Largest contiguous block returned by peek()
+     * \param[in] use_hugepages Try to back the ring with huge pages
+     */
+    Gnss_Sample_Ring(size_t item_size, uint64_t capacity, unsigned int max_read_items, bool use_hugepages);
+    ~Gnss_Sample_Ring();
+
+    Gnss_Sample_Ring(const Gnss_Sample_Ring&) = delete;
+    Gnss_Sample_Ring& operator=(const Gnss_Sample_Ring&) = delete;
+
+    size_t item_size() const { return d_item_size; }
+    uint64_t capacity() const { return d_capacity; }
+    unsigned int max_read_items() const { return d_max_read_items; }
+    bool hugepages() const { return d_hugepages; }
+
+    //! Stamp of the next sample to be written
+    uint64_t write_stamp() const { return d_write_stamp.load(std::memory_order_acquire); }
+
+    //! Stamp of the oldest sample still held in the ring
+    uint64_t oldest_stamp() const;
+
+    /*!
+     * \brief Appends nitems samples. Only one thread may call it.
+     */
+    void write(const void* items, uint64_t nitems);
+
+    /*!
+     * \brief Signals the readers that no more samples will be written
+     */
+    void set_done();
+    bool done() const { return d_done.load(std::memory_order_acquire); }
+
+    /*!
+     * \brief Blocks until the sample with the given stamp has been written, the
+     * ring is done or timeout_ms milliseconds have elapsed. Returns true if
+     * the sample is available.
+     */
+    bool wait(uint64_t stamp, unsigned int timeout_ms);
+
+    /*!
+     * \brief Registers a new reader whose cursor starts at the current write stamp
+     */
+    unsigned int add_reader();
+    unsigned int readers() const { return d_readers.size(); }
+
+    uint64_t cursor(unsigned int reader) const;
+    void seek(unsigned int reader, uint64_t stamp);
+
+    //! Samples written but not yet read by this reader
+    uint64_t available(unsigned int reader) const;
+
+    //! Number of samples this reader has lost because of overruns
+    uint64_t overrun_items(unsigned int reader) const;
+
+    /*!
+     * \brief Copies up to nitems samples at the reader cursor and advances it.
+     * Returns the number of samples copied, which is zero if no new samples are
+     * available. If the reader has been overrun, the cursor is moved to the
+     * write stamp first and the number of lost samples is stored in lost_items.
+     */
+    unsigned int read(unsigned int reader, void* out, unsigned int nitems, uint64_t& lost_items);
+
+    /*!
+     * \brief Same as read(), but the samples lost in an overrun are replaced by
+     * zeros, up to the write stamp at the time the overrun was detected, so the
+     * n-th sample returned to the reader is always the one with stamp
+     * start + n, and sample counters downstream keep the absolute time.
+     * lost_items is set by the call that detects the overrun.
+     */
+    unsigned int read_zero_filled(unsigned int reader, void* out, unsigned int nitems, uint64_t& lost_items);
+
+    /*!
+     * \brief Copies nitems samples starting at stamp without touching any cursor.
+     * Returns false if part of the requested span has not been written yet or
+     * has already been overwritten.
+     */
+    bool read_at(uint64_t stamp, void* out, unsigned int nitems) const;
+
+    /*!
+     * \brief Returns a pointer to the sample with the given stamp, valid for
+     * max_read_items() contiguous samples. The caller must check with
+     * is_valid() after using the data that it was not overwritten meanwhile.
+     */
+    const void* peek(uint64_t stamp) const;
+    bool is_valid(uint64_t stamp) const;
+
+private:
+    struct Reader
+    {
+        std::atomic<uint64_t> cursor;
+        std::atomic<uint64_t> overrun_items;
+        std::atomic<uint64_t> zero_fill_stamp; // read_zero_filled() outputs zeros up to this stamp
+    };
+
+    void allocate();
+    void copy_out(uint64_t stamp, void* out, unsigned int nitems) const;
+
+    size_t d_item_size;
+    uint64_t d_capacity;
+    uint64_t d_mask;
+    unsigned int d_max_read_items;
+    bool d_hugepages;
+    size_t d_alloc_size;
+    char* d_buffer;
+
+    std::atomic<uint64_t> d_write_stamp;   // samples published to the readers
+    std::atomic<uint64_t> d_reserve_stamp; // samples the producer may be overwriting
+    std::atomic<bool> d_done;
+    std::vector<std::unique_ptr<Reader>> d_readers;
+
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+};
+
+#endif /* GNSS_SDR_GNSS_SAMPLE_RING_H_ */
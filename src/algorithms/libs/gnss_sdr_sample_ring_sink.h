@@ -0,0 +1,62 @@
+/*!
+ * \file gnss_sdr_sample_ring_sink.h
+ * \brief GNU Radio block that writes its input stream into a Gnss_Sample_Ring
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_SAMPLE_RING_SINK_H_
+#define GNSS_SDR_GNSS_SDR_SAMPLE_RING_SINK_H_
+
+#include <memory>
+#include <gnuradio/sync_block.h>
+#include <boost/shared_ptr.hpp>
+#include "gnss_sample_ring.h"
+
+class gnss_sdr_sample_ring_sink;
+
+typedef boost::shared_ptr<gnss_sdr_sample_ring_sink> gnss_sdr_sample_ring_sink_sptr;
+
+gnss_sdr_sample_ring_sink_sptr gnss_sdr_make_sample_ring_sink(std::shared_ptr<Gnss_Sample_Ring> ring);
+
+/*!
+ * \brief Implementation of a GNU Radio block that copies every sample it
+ * receives into a Gnss_Sample_Ring, from where the channels read it.
+ */
+class gnss_sdr_sample_ring_sink : public gr::sync_block
+{
+    friend gnss_sdr_sample_ring_sink_sptr gnss_sdr_make_sample_ring_sink(std::shared_ptr<Gnss_Sample_Ring> ring);
+    gnss_sdr_sample_ring_sink(std::shared_ptr<Gnss_Sample_Ring> ring);
+    std::shared_ptr<Gnss_Sample_Ring> d_ring;
+
+public:
+    std::shared_ptr<Gnss_Sample_Ring> ring() { return d_ring; }
+    bool stop();
+    int work(int noutput_items,
+            gr_vector_const_void_star &input_items,
+            gr_vector_void_star &output_items);
+};
+
+#endif /*GNSS_SDR_GNSS_SDR_SAMPLE_RING_SINK_H_*/
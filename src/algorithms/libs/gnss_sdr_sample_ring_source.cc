@@ -0,0 +1,80 @@
+/*!
+ * \file gnss_sdr_sample_ring_source.cc
+ * \brief GNU Radio block that reads a Gnss_Sample_Ring through its own cursor
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_sample_ring_source.h"
+#include <gnuradio/io_signature.h>
+#include <glog/logging.h>
+
+// Longest wait for new samples before returning control to the scheduler
+#define GNSS_SDR_SAMPLE_RING_SOURCE_TIMEOUT_MS 100
+
+using google::LogMessage;
+
+gnss_sdr_sample_ring_source::gnss_sdr_sample_ring_source(std::shared_ptr<Gnss_Sample_Ring> ring) : gr::sync_block("sample_ring_source",
+                gr::io_signature::make(0, 0, 0),
+                gr::io_signature::make(1, 1, ring->item_size())),
+                d_ring(ring)
+{
+    d_reader = d_ring->add_reader();
+}
+
+
+gnss_sdr_sample_ring_source_sptr gnss_sdr_make_sample_ring_source(std::shared_ptr<Gnss_Sample_Ring> ring)
+{
+    gnss_sdr_sample_ring_source_sptr source_(new gnss_sdr_sample_ring_source(ring));
+    return source_;
+}
+
+
+int gnss_sdr_sample_ring_source::work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+{
+    if (d_ring->available(d_reader) == 0)
+        {
+            if (!d_ring->wait(d_ring->cursor(d_reader), GNSS_SDR_SAMPLE_RING_SOURCE_TIMEOUT_MS))
+                {
+                    if (d_ring->done())
+                        {
+                            return -1; // Done!
+                        }
+                    return 0;
+                }
+        }
+    uint64_t lost_items = 0;
+    // The lost samples are replaced by zeros, so that the sample counters of
+    // the channels keep counting the absolute time of the receiver
+    int n = d_ring->read_zero_filled(d_reader, output_items[0], noutput_items, lost_items);
+    if (lost_items > 0)
+        {
+            LOG(WARNING) << "Sample ring reader " << d_reader << " overrun, " << lost_items << " samples lost and replaced by zeros";
+            add_item_tag(0, nitems_written(0), pmt::mp("ring_overrun"), pmt::from_uint64(lost_items));
+        }
+    return n;
+}
@@ -0,0 +1,71 @@
+/*!
+ * \file gnss_sdr_sample_ring_source.h
+ * \brief GNU Radio block that reads a Gnss_Sample_Ring through its own cursor
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_SAMPLE_RING_SOURCE_H_
+#define GNSS_SDR_GNSS_SDR_SAMPLE_RING_SOURCE_H_
+
+#include <memory>
+#include <gnuradio/sync_block.h>
+#include <boost/shared_ptr.hpp>
+#include "gnss_sample_ring.h"
+
+class gnss_sdr_sample_ring_source;
+
+typedef boost::shared_ptr<gnss_sdr_sample_ring_source> gnss_sdr_sample_ring_source_sptr;
+
+gnss_sdr_sample_ring_source_sptr gnss_sdr_make_sample_ring_source(std::shared_ptr<Gnss_Sample_Ring> ring);
+
+/*!
+ * \brief Implementation of a GNU Radio block that outputs the samples of a
+ * Gnss_Sample_Ring, starting at the stamp the ring had when the block was
+ * created.
+ *
+ * Each instance registers its own reader, so a slow channel only delays
+ * itself. If the producer overruns the reader, the lost samples are output
+ * as zeros, so the stream keeps the absolute sample count that the tracking
+ * timestamps are based on (the channel loses lock if the gap is long). The
+ * count is logged and a "ring_overrun" stream tag carrying the number of
+ * lost samples is added at the first zero.
+ */
+class gnss_sdr_sample_ring_source : public gr::sync_block
+{
+    friend gnss_sdr_sample_ring_source_sptr gnss_sdr_make_sample_ring_source(std::shared_ptr<Gnss_Sample_Ring> ring);
+    gnss_sdr_sample_ring_source(std::shared_ptr<Gnss_Sample_Ring> ring);
+    std::shared_ptr<Gnss_Sample_Ring> d_ring;
+    unsigned int d_reader;
+
+public:
+    std::shared_ptr<Gnss_Sample_Ring> ring() { return d_ring; }
+    unsigned int reader() const { return d_reader; }
+    int work(int noutput_items,
+            gr_vector_const_void_star &input_items,
+            gr_vector_void_star &output_items);
+};
+
+#endif /*GNSS_SDR_GNSS_SDR_SAMPLE_RING_SOURCE_H_*/
@@ -179,3 +179,24 @@ void resampler(std::complex<float>* _from, std::complex<float>* _dest, float _fs
     //--- Correct the last index (due to number rounding issues) -----------
     _dest[_length_out - 1] = _from[_length_in - 1];
 }
+
+
+void linear_resampler(const std::complex<float>* _from, std::complex<float>* _dest,
+        unsigned int _length_in, unsigned int _length_out)
+{
+    const double step = static_cast<double>(_length_in) / static_cast<double>(_length_out);
+    for (unsigned int i = 0; i < _length_out; i++)
+        {
+            double t = step * static_cast<double>(i);
+            unsigned int k = static_cast<unsigned int>(t);
+            if (k + 1 >= _length_in)
+                {
+                    _dest[i] = _from[_length_in - 1];
+                }
+            else
+                {
+                    float frac = static_cast<float>(t - static_cast<double>(k));
+                    _dest[i] = _from[k] + frac * (_from[k + 1] - _from[k]);
+                }
+        }
+}
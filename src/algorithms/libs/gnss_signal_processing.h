@@ -68,4 +68,12 @@ void resampler(std::complex<float>* _from, std::complex<float>* _dest,
         float _fs_in, float _fs_out, unsigned int _length_in,
         unsigned int _length_out);
 
+/*!
+ * \brief This function resamples a sequence of complex values by linear
+ * interpolation, so that _length_in samples span _length_out samples.
+ *
+ */
+void linear_resampler(const std::complex<float>* _from, std::complex<float>* _dest,
+        unsigned int _length_in, unsigned int _length_out);
+
 #endif /* GNSS_SDR_GNSS_SIGNAL_PROCESSING_H_ */
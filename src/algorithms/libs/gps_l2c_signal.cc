@@ -34,6 +34,7 @@
 #include <cstdint>
 #include <cmath>
 #include "GPS_L2C.h"
+#include "gnss_code_bank.h"
 
 
 int32_t gps_l2c_m_shift(int32_t x)
@@ -77,47 +78,11 @@ void gps_l2c_m_code_gen_complex(std::complex<float>* _dest, unsigned int _prn)
  */
 void gps_l2c_m_code_gen_complex_sampled(std::complex<float>* _dest, unsigned int _prn, signed int _fs)
 {
-    int32_t* _code = new int32_t[GPS_L2_M_CODE_LENGTH_CHIPS];
-    if (_prn > 0 and _prn < 51)
-        {
-            gps_l2c_m_code(_code, _prn);
-        }
-
-    signed int _samplesPerCode, _codeValueIndex;
-    float _ts;
-    float _tc;
-    const signed int _codeLength = GPS_L2_M_CODE_LENGTH_CHIPS;
-
-    //--- Find number of samples per spreading code ----------------------------
-    _samplesPerCode = static_cast<int>(static_cast<double>(_fs) / (static_cast<double>(GPS_L2_M_CODE_RATE_HZ) / static_cast<double>(_codeLength)));
-
-    //--- Find time constants --------------------------------------------------
-    _ts = 1.0 / static_cast<float>(_fs);   // Sampling period in sec
-    _tc = 1.0 / static_cast<float>(GPS_L2_M_CODE_RATE_HZ);  // C/A chip period in sec
-
-    //float aux;
-    for (signed int i = 0; i < _samplesPerCode; i++)
-        {
-            //=== Digitizing =======================================================
-
-            //--- Make index array to read L2C code values -------------------------
-            //TODO: Check this formula! Seems to start with an extra sample
-            _codeValueIndex = ceil((_ts * ((float)i + 1)) / _tc) - 1;
-            //aux = (_ts * (i + 1)) / _tc;
-            //_codeValueIndex = static_cast<int>(static_cast<long>(aux)) - 1;
-
-            //--- Make the digitized version of the L2C code -----------------------
-            if (i == _samplesPerCode - 1)
-                {
-                    //--- Correct the last index (due to number rounding issues) -----------
-                    _dest[i] = std::complex<float>(1.0 - 2.0 * _code[_codeLength - 1], 0);
-                }
-            else
-                {
-                    _dest[i] = std::complex<float>(1.0 - 2.0 * _code[_codeValueIndex], 0); //repeat the chip -> upsample
-                }
-        }
-    delete[] _code;
+    const unsigned int _codeLength = GPS_L2_M_CODE_LENGTH_CHIPS;
+    const unsigned int _codeFreqBasis = static_cast<unsigned int>(GPS_L2_M_CODE_RATE_HZ);
+    const unsigned int _samplesPerCode = Gnss_Code_Bank::samples_per_code(_codeLength, _codeFreqBasis, _fs);
+    Gnss_Code_Bank::expand_sampled(_dest, Gnss_Code_Bank::instance().code(GPS_L2_M_CODE, _prn), nullptr,
+            _codeLength, _codeFreqBasis, _fs, 0, 0, _samplesPerCode, 1.0f, true);
 }
 
 
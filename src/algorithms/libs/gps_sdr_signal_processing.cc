@@ -31,8 +31,7 @@
  */
 
 #include "gps_sdr_signal_processing.h"
-
-auto auxCeil = [](float x){ return static_cast<int>(static_cast<long>((x)+1)); };
+#include "gnss_code_bank.h"
 
 void gps_l1_ca_code_gen_complex(std::complex<float>* _dest, signed int _prn, unsigned int _chip_shift)
 {
@@ -120,49 +119,12 @@ void gps_l1_ca_code_gen_complex(std::complex<float>* _dest, signed int _prn, uns
  */
 void gps_l1_ca_code_gen_complex_sampled(std::complex<float>* _dest, unsigned int _prn, signed int _fs, unsigned int _chip_shift)
 {
-    // This function is based on the GNU software GPS for MATLAB in the Kay Borre book
-    std::complex<float> _code[1023];
-    signed int _samplesPerCode, _codeValueIndex;
-    float _ts;
-    float _tc;
-    float aux;
-    const signed int _codeFreqBasis = 1023000; //Hz
-    const signed int _codeLength = 1023;
-
-    //--- Find number of samples per spreading code ----------------------------
-    _samplesPerCode = static_cast<signed int>(static_cast<double>(_fs) / static_cast<double>(_codeFreqBasis / _codeLength));
-
-    //--- Find time constants --------------------------------------------------
-    _ts = 1.0 / static_cast<float>(_fs);   // Sampling period in sec
-    _tc = 1.0 / static_cast<float>(_codeFreqBasis);  // C/A chip period in sec
-    gps_l1_ca_code_gen_complex(_code, _prn, _chip_shift); //generate C/A code 1 sample per chip
-
-    for (signed int i = 0; i < _samplesPerCode; i++)
-        {
-            //=== Digitizing =======================================================
-
-            //--- Make index array to read C/A code values -------------------------
-            // The length of the index array depends on the sampling frequency -
-            // number of samples per millisecond (because one C/A code period is one
-            // millisecond).
-
-            // _codeValueIndex = ceil((_ts * ((float)i + 1)) / _tc) - 1;
-            aux = (_ts * (i + 1)) / _tc;   
-            _codeValueIndex = auxCeil( aux ) - 1;
-
-            //--- Make the digitized version of the C/A code -----------------------
-            // The "upsampled" code is made by selecting values form the CA code
-            // chip array (caCode) for the time instances of each sample.
-            if (i == _samplesPerCode - 1)
-                {
-                    //--- Correct the last index (due to number rounding issues) -----------
-                    _dest[i] = _code[_codeLength - 1];
-
-                }
-            else
-                {
-                    _dest[i] = _code[_codeValueIndex]; //repeat the chip -> upsample
-                }
-        }
+    // Nearest chip sampling, as in the GNU software GPS for MATLAB in the Kay Borre book,
+    // expanded from the packed code of the bank
+    const unsigned int _codeFreqBasis = 1023000; //Hz
+    const unsigned int _codeLength = 1023;
+    const unsigned int _samplesPerCode = Gnss_Code_Bank::samples_per_code(_codeLength, _codeFreqBasis, _fs);
+    Gnss_Code_Bank::expand_sampled(_dest, Gnss_Code_Bank::instance().code(GPS_L1_CA_CODE, _prn), nullptr,
+            _codeLength, _codeFreqBasis, _fs, _chip_shift, 0, _samplesPerCode, 1.0f);
 }
 
@@ -292,6 +292,103 @@ static inline void volk_gnsssdr_16ic_x2_multiply_16ic_a_avx2(lv_16sc_t* out, con
 #endif /* LV_HAVE_AVX2  */
 
 
+#ifdef LV_HAVE_AVX512BW
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_x2_multiply_16ic_u_avx512bw(lv_16sc_t* out, const lv_16sc_t* in_a, const lv_16sc_t* in_b, unsigned int num_points)
+{
+    unsigned int number = 0;
+    const unsigned int avx512_points = num_points / 16;
+
+    const lv_16sc_t* _in_a = in_a;
+    const lv_16sc_t* _in_b = in_b;
+    lv_16sc_t* _out = out;
+
+    __m512i a, b, c, c_sr, real, imag, imag1, imag2, b_sl, a_sl, result;
+
+    for(;number < avx512_points; number++)
+        {
+            a = _mm512_loadu_si512((void*)_in_a); // Load the ar + ai, br + bi as ar,ai,br,bi
+            b = _mm512_loadu_si512((void*)_in_b); // Load the cr + ci, dr + di as cr,ci,dr,di
+            c = _mm512_mullo_epi16(a, b);
+
+            c_sr = _mm512_bsrli_epi128(c, 2); // Shift a right by imm8 bytes while shifting in zeros, and store the results in dst.
+            real = _mm512_subs_epi16(c, c_sr); // a3.r*b3.r-a3.i*b3.i , x,  a3.r*b3.r- a3.i*b3.i
+
+            b_sl = _mm512_bslli_epi128(b, 2); // b3.r, b2.i ....
+            a_sl = _mm512_bslli_epi128(a, 2); // a3.r, a2.i ....
+
+            imag1 = _mm512_mullo_epi16(a, b_sl); // a3.i*b3.r, ....
+            imag2 = _mm512_mullo_epi16(b, a_sl); // b3.i*a3.r, ....
+
+            imag = _mm512_adds_epi16(imag1, imag2); // x, a3.i*b3.r+b3.i*a3.r, ...
+
+            // real parts from the even 16 bit words, imaginary parts from the odd ones
+            result = _mm512_mask_blend_epi16(0xAAAAAAAA, real, imag);
+
+            _mm512_storeu_si512((void*)_out, result);
+
+            _in_a += 16;
+            _in_b += 16;
+            _out += 16;
+        }
+    _mm256_zeroupper();
+    number = avx512_points * 16;
+    for(;number < num_points; number++)
+        {
+            *_out++ = (*_in_a++) * (*_in_b++);
+        }
+}
+#endif /* LV_HAVE_AVX512BW  */
+
+#ifdef LV_HAVE_AVX512BW
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_x2_multiply_16ic_a_avx512bw(lv_16sc_t* out, const lv_16sc_t* in_a, const lv_16sc_t* in_b, unsigned int num_points)
+{
+    unsigned int number = 0;
+    const unsigned int avx512_points = num_points / 16;
+
+    const lv_16sc_t* _in_a = in_a;
+    const lv_16sc_t* _in_b = in_b;
+    lv_16sc_t* _out = out;
+
+    __m512i a, b, c, c_sr, real, imag, imag1, imag2, b_sl, a_sl, result;
+
+    for(;number < avx512_points; number++)
+        {
+            a = _mm512_load_si512((void*)_in_a); // Load the ar + ai, br + bi as ar,ai,br,bi
+            b = _mm512_load_si512((void*)_in_b); // Load the cr + ci, dr + di as cr,ci,dr,di
+            c = _mm512_mullo_epi16(a, b);
+
+            c_sr = _mm512_bsrli_epi128(c, 2); // Shift a right by imm8 bytes while shifting in zeros, and store the results in dst.
+            real = _mm512_subs_epi16(c, c_sr); // a3.r*b3.r-a3.i*b3.i , x,  a3.r*b3.r- a3.i*b3.i
+
+            b_sl = _mm512_bslli_epi128(b, 2); // b3.r, b2.i ....
+            a_sl = _mm512_bslli_epi128(a, 2); // a3.r, a2.i ....
+
+            imag1 = _mm512_mullo_epi16(a, b_sl); // a3.i*b3.r, ....
+            imag2 = _mm512_mullo_epi16(b, a_sl); // b3.i*a3.r, ....
+
+            imag = _mm512_adds_epi16(imag1, imag2); // x, a3.i*b3.r+b3.i*a3.r, ...
+
+            // real parts from the even 16 bit words, imaginary parts from the odd ones
+            result = _mm512_mask_blend_epi16(0xAAAAAAAA, real, imag);
+
+            _mm512_store_si512((void*)_out, result);
+
+            _in_a += 16;
+            _in_b += 16;
+            _out += 16;
+        }
+    _mm256_zeroupper();
+    number = avx512_points * 16;
+    for(;number < num_points; number++)
+        {
+            *_out++ = (*_in_a++) * (*_in_b++);
+        }
+}
+#endif /* LV_HAVE_AVX512BW  */
 
 #ifdef LV_HAVE_NEON
 #include <arm_neon.h>
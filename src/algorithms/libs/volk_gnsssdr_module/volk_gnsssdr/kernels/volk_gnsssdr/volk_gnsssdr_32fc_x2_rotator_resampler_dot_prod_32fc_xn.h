@@ -0,0 +1,1216 @@
+/*!
+ * \file volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: resamples a local code into N delayed replicas on the fly,
+ * and multiplies them by a common vector, phase rotated, accumulating the results in N float complex outputs.
+ *
+ * VOLK_GNSSSDR kernel that fuses volk_gnsssdr_32fc_xn_resampler_32fc_xn and
+ * volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn: the index of the chip of each replica
+ * is computed for each sample, and the chip is read from the local code table while
+ * the common vector is rotated and accumulated, so the resampled replicas are never
+ * written to memory.
+ * It is optimized to perform the N tap correlation process in GNSS receivers.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn
+ *
+ * \b Overview
+ *
+ * Rotates the reference complex vector, multiplies it by \p num_out_vectors replicas of \p local_code,
+ * each one resampled at \p code_phase_step_chips chips per sample and delayed by its entry of \p shifts_chips,
+ * accumulates the results and stores them in the output vector.
+ * The rotation is done at a fixed rate per sample, from an initial \p phase offset.
+ * The result is the same as resampling the replicas with volk_gnsssdr_32fc_xn_resampler_32fc_xn
+ * and correlating them with volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn, without the
+ * intermediate vectors.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_32fc_t* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:             Pointer to the vector to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc:             Phase increment = lv_cmake(cos(phase_step_rad), sin(phase_step_rad))
+ * \li phase:                 Initial phase = lv_cmake(cos(initial_phase_rad), sin(initial_phase_rad))
+ * \li local_code:            Local code, one sample per chip.
+ * \li rem_code_phase_chips:  Remnant code phase [chips].
+ * \li code_phase_step_chips: Phase increment per sample [chips/sample].
+ * \li shifts_chips:          Vector of floats that defines the spacing (in chips) between the replicas of \p local_code
+ * \li code_length_chips:     Code length in chips.
+ * \li num_out_vectors:       Number of replicas (correlator taps).
+ * \li num_points:            Number of complex values to be rotated, multiplied and accumulated.
+ *
+ * \b Outputs
+ * \li phase:                 Final phase.
+ * \li result:                Vector of \p num_out_vectors components with the correlation of \p in_common with each replica.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn_H
+
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+#include <stdlib.h> /* abs */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn_generic(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_32fc_t* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    lv_32fc_t tmp32_1;
+    const unsigned int ROTATOR_RELOAD = 256;
+    int local_code_chip_index;
+    int n_vec;
+    unsigned int n;
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake(0,0);
+        }
+    for (n = 0; n < num_points; n++)
+        {
+            tmp32_1 = in_common[n] * (*phase);
+            (*phase) *= phase_inc;
+            // Regenerate phase
+            if ((n + 1) % ROTATOR_RELOAD == 0)
+                {
+#ifdef __cplusplus
+                    (*phase) /= std::abs((*phase));
+#else
+                    (*phase) /= hypotf(lv_creal(*phase), lv_cimag(*phase));
+#endif
+                }
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    //Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index < 0) local_code_chip_index += (int)code_length_chips * (abs(local_code_chip_index) / code_length_chips + 1);
+                    local_code_chip_index = local_code_chip_index % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index];
+                }
+        }
+}
+
+#endif /*LV_HAVE_GENERIC*/
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+static inline void volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn_u_sse4_1(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_32fc_t* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    lv_32fc_t dotProduct = lv_cmake(0,0);
+    lv_32fc_t tmp32_1;
+    const unsigned int sse_iters = num_points / 4;
+    int n_vec;
+    int i;
+    unsigned int number;
+    unsigned int n;
+    int local_code_chip_index_;
+    const lv_32fc_t* _in_common = in_common;
+
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t dotProductVector[2];
+    __VOLK_ATTR_ALIGNED(16) int local_code_chip_index[4];
+
+    // accumulators, followed by the shift of each tap
+    __m128* acc = (__m128*)volk_gnsssdr_malloc(2 * num_out_vectors * sizeof(__m128), volk_gnsssdr_get_alignment());
+    __m128* shifts_chips_reg = acc + num_out_vectors;
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm_setzero_ps();
+            shifts_chips_reg[n_vec] = _mm_set_ps1(shifts_chips[n_vec]);
+        }
+
+    // phase rotation registers
+    __m128 a, two_phase_acc_reg, two_phase_inc_reg, yl0, yh0, yl1, yh1, tmp1, tmp1p, tmp2, tmp2p, z1;
+
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t two_phase_inc[2];
+    two_phase_inc[0] = phase_inc * phase_inc;
+    two_phase_inc[1] = phase_inc * phase_inc;
+    two_phase_inc_reg = _mm_load_ps((float*) two_phase_inc);
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t two_phase_acc[2];
+    two_phase_acc[0] = (*phase);
+    two_phase_acc[1] = (*phase) * phase_inc;
+    two_phase_acc_reg = _mm_load_ps((float*)two_phase_acc);
+
+    const __m128 ylp = _mm_moveldup_ps(two_phase_inc_reg);
+    const __m128 yhp = _mm_movehdup_ps(two_phase_inc_reg);
+
+    // code resampling registers
+    const __m128 fours = _mm_set1_ps(4.0f);
+    const __m128 rem_code_phase_chips_reg = _mm_set_ps1(rem_code_phase_chips);
+    const __m128 code_phase_step_chips_reg = _mm_set_ps1(code_phase_step_chips);
+    const __m128 zeros_f = _mm_setzero_ps();
+    const __m128i zeros = _mm_setzero_si128();
+    const __m128 code_length_chips_reg_f = _mm_set_ps1((float)code_length_chips);
+    const __m128i code_length_chips_reg_i = _mm_set1_epi32((int)code_length_chips);
+    __m128i local_code_chip_index_reg, aux_i, negatives, ii;
+    __m128 aux, step_indexn, c, cTrunc, base, code;
+    __m128 indexn = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+
+    for(number = 0; number < sse_iters; number++)
+        {
+            // Phase rotation on samples 0 and 1 of in_common starts here:
+            a = _mm_loadu_ps((float*)_in_common);
+            yl0 = _mm_moveldup_ps(two_phase_acc_reg); // Load yl with cr,cr,dr,dr
+            yh0 = _mm_movehdup_ps(two_phase_acc_reg);
+            tmp1 = _mm_mul_ps(a, yl0);
+            tmp1p = _mm_mul_ps(two_phase_acc_reg, ylp);
+            a = _mm_shuffle_ps(a, a, 0xB1);
+            two_phase_acc_reg = _mm_shuffle_ps(two_phase_acc_reg, two_phase_acc_reg, 0xB1);
+            tmp2 = _mm_mul_ps(a, yh0);
+            tmp2p = _mm_mul_ps(two_phase_acc_reg, yhp);
+            z1 = _mm_addsub_ps(tmp1, tmp2);
+            two_phase_acc_reg = _mm_addsub_ps(tmp1p, tmp2p);
+            yl0 = _mm_moveldup_ps(z1);
+            yh0 = _mm_movehdup_ps(z1);
+
+            // ... and on samples 2 and 3
+            a = _mm_loadu_ps((float*)(_in_common + 2));
+            yl1 = _mm_moveldup_ps(two_phase_acc_reg);
+            yh1 = _mm_movehdup_ps(two_phase_acc_reg);
+            tmp1 = _mm_mul_ps(a, yl1);
+            tmp1p = _mm_mul_ps(two_phase_acc_reg, ylp);
+            a = _mm_shuffle_ps(a, a, 0xB1);
+            two_phase_acc_reg = _mm_shuffle_ps(two_phase_acc_reg, two_phase_acc_reg, 0xB1);
+            tmp2 = _mm_mul_ps(a, yh1);
+            tmp2p = _mm_mul_ps(two_phase_acc_reg, yhp);
+            z1 = _mm_addsub_ps(tmp1, tmp2);
+            two_phase_acc_reg = _mm_addsub_ps(tmp1p, tmp2p);
+            yl1 = _mm_moveldup_ps(z1);
+            yh1 = _mm_movehdup_ps(z1);
+
+            //next four samples
+            _in_common += 4;
+
+            step_indexn = _mm_mul_ps(code_phase_step_chips_reg, indexn);
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // chip index of the four samples for this tap
+                    aux = _mm_add_ps(step_indexn, shifts_chips_reg[n_vec]);
+                    aux = _mm_sub_ps(aux, rem_code_phase_chips_reg);
+                    // floor
+                    aux = _mm_floor_ps(aux);
+                    if (_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(aux, zeros_f), _mm_cmplt_ps(aux, code_length_chips_reg_f))) == 0xF)
+                        {
+                            // usual case: the four chips are within the code period
+                            local_code_chip_index_reg = _mm_cvttps_epi32(aux);
+                        }
+                    else
+                        {
+                            // fmod
+                            c = _mm_div_ps(aux, code_length_chips_reg_f);
+                            ii = _mm_cvttps_epi32(c);
+                            cTrunc = _mm_cvtepi32_ps(ii);
+                            base = _mm_mul_ps(cTrunc, code_length_chips_reg_f);
+                            local_code_chip_index_reg = _mm_cvtps_epi32(_mm_sub_ps(aux, base));
+                            negatives = _mm_cmplt_epi32(local_code_chip_index_reg, zeros);
+                            aux_i = _mm_and_si128(code_length_chips_reg_i, negatives);
+                            local_code_chip_index_reg = _mm_add_epi32(local_code_chip_index_reg, aux_i);
+                        }
+                    _mm_store_si128((__m128i*)local_code_chip_index, local_code_chip_index_reg);
+
+                    // multiply the rotated samples 0 and 1 by their chips
+                    code = _mm_loadl_pi(zeros_f, (const __m64*)&local_code[local_code_chip_index[0]]);
+                    code = _mm_loadh_pi(code, (const __m64*)&local_code[local_code_chip_index[1]]);
+                    tmp1 = _mm_mul_ps(code, yl0);
+                    code = _mm_shuffle_ps(code, code, 0xB1);
+                    tmp2 = _mm_mul_ps(code, yh0);
+                    acc[n_vec] = _mm_add_ps(acc[n_vec], _mm_addsub_ps(tmp1, tmp2));
+
+                    // ... and samples 2 and 3
+                    code = _mm_loadl_pi(zeros_f, (const __m64*)&local_code[local_code_chip_index[2]]);
+                    code = _mm_loadh_pi(code, (const __m64*)&local_code[local_code_chip_index[3]]);
+                    tmp1 = _mm_mul_ps(code, yl1);
+                    code = _mm_shuffle_ps(code, code, 0xB1);
+                    tmp2 = _mm_mul_ps(code, yh1);
+                    acc[n_vec] = _mm_add_ps(acc[n_vec], _mm_addsub_ps(tmp1, tmp2));
+                }
+            indexn = _mm_add_ps(indexn, fours);
+
+            // Regenerate phase
+            if ((number % 64) == 0)
+                {
+                    tmp1 = _mm_mul_ps(two_phase_acc_reg, two_phase_acc_reg);
+                    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                    tmp2 = _mm_sqrt_ps(tmp1);
+                    two_phase_acc_reg = _mm_div_ps(two_phase_acc_reg, tmp2);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            _mm_store_ps((float*)dotProductVector, acc[n_vec]); // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0,0);
+            for (i = 0; i < 2; ++i)
+                {
+                    dotProduct = dotProduct + dotProductVector[i];
+                }
+            result[n_vec] = dotProduct;
+        }
+    volk_gnsssdr_free(acc);
+
+    _mm_store_ps((float*)two_phase_acc, two_phase_acc_reg);
+    (*phase) = two_phase_acc[0];
+
+    for(n = sse_iters * 4; n < num_points; n++)
+        {
+            tmp32_1 = in_common[n] * (*phase);
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    //Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+static inline void volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn_a_sse4_1(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_32fc_t* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    lv_32fc_t dotProduct = lv_cmake(0,0);
+    lv_32fc_t tmp32_1;
+    const unsigned int sse_iters = num_points / 4;
+    int n_vec;
+    int i;
+    unsigned int number;
+    unsigned int n;
+    int local_code_chip_index_;
+    const lv_32fc_t* _in_common = in_common;
+
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t dotProductVector[2];
+    __VOLK_ATTR_ALIGNED(16) int local_code_chip_index[4];
+
+    // accumulators, followed by the shift of each tap
+    __m128* acc = (__m128*)volk_gnsssdr_malloc(2 * num_out_vectors * sizeof(__m128), volk_gnsssdr_get_alignment());
+    __m128* shifts_chips_reg = acc + num_out_vectors;
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm_setzero_ps();
+            shifts_chips_reg[n_vec] = _mm_set_ps1(shifts_chips[n_vec]);
+        }
+
+    // phase rotation registers
+    __m128 a, two_phase_acc_reg, two_phase_inc_reg, yl0, yh0, yl1, yh1, tmp1, tmp1p, tmp2, tmp2p, z1;
+
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t two_phase_inc[2];
+    two_phase_inc[0] = phase_inc * phase_inc;
+    two_phase_inc[1] = phase_inc * phase_inc;
+    two_phase_inc_reg = _mm_load_ps((float*) two_phase_inc);
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t two_phase_acc[2];
+    two_phase_acc[0] = (*phase);
+    two_phase_acc[1] = (*phase) * phase_inc;
+    two_phase_acc_reg = _mm_load_ps((float*)two_phase_acc);
+
+    const __m128 ylp = _mm_moveldup_ps(two_phase_inc_reg);
+    const __m128 yhp = _mm_movehdup_ps(two_phase_inc_reg);
+
+    // code resampling registers
+    const __m128 fours = _mm_set1_ps(4.0f);
+    const __m128 rem_code_phase_chips_reg = _mm_set_ps1(rem_code_phase_chips);
+    const __m128 code_phase_step_chips_reg = _mm_set_ps1(code_phase_step_chips);
+    const __m128 zeros_f = _mm_setzero_ps();
+    const __m128i zeros = _mm_setzero_si128();
+    const __m128 code_length_chips_reg_f = _mm_set_ps1((float)code_length_chips);
+    const __m128i code_length_chips_reg_i = _mm_set1_epi32((int)code_length_chips);
+    __m128i local_code_chip_index_reg, aux_i, negatives, ii;
+    __m128 aux, step_indexn, c, cTrunc, base, code;
+    __m128 indexn = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+
+    for(number = 0; number < sse_iters; number++)
+        {
+            // Phase rotation on samples 0 and 1 of in_common starts here:
+            a = _mm_load_ps((float*)_in_common);
+            yl0 = _mm_moveldup_ps(two_phase_acc_reg); // Load yl with cr,cr,dr,dr
+            yh0 = _mm_movehdup_ps(two_phase_acc_reg);
+            tmp1 = _mm_mul_ps(a, yl0);
+            tmp1p = _mm_mul_ps(two_phase_acc_reg, ylp);
+            a = _mm_shuffle_ps(a, a, 0xB1);
+            two_phase_acc_reg = _mm_shuffle_ps(two_phase_acc_reg, two_phase_acc_reg, 0xB1);
+            tmp2 = _mm_mul_ps(a, yh0);
+            tmp2p = _mm_mul_ps(two_phase_acc_reg, yhp);
+            z1 = _mm_addsub_ps(tmp1, tmp2);
+            two_phase_acc_reg = _mm_addsub_ps(tmp1p, tmp2p);
+            yl0 = _mm_moveldup_ps(z1);
+            yh0 = _mm_movehdup_ps(z1);
+
+            // ... and on samples 2 and 3
+            a = _mm_load_ps((float*)(_in_common + 2));
+            yl1 = _mm_moveldup_ps(two_phase_acc_reg);
+            yh1 = _mm_movehdup_ps(two_phase_acc_reg);
+            tmp1 = _mm_mul_ps(a, yl1);
+            tmp1p = _mm_mul_ps(two_phase_acc_reg, ylp);
+            a = _mm_shuffle_ps(a, a, 0xB1);
+            two_phase_acc_reg = _mm_shuffle_ps(two_phase_acc_reg, two_phase_acc_reg, 0xB1);
+            tmp2 = _mm_mul_ps(a, yh1);
+            tmp2p = _mm_mul_ps(two_phase_acc_reg, yhp);
+            z1 = _mm_addsub_ps(tmp1, tmp2);
+            two_phase_acc_reg = _mm_addsub_ps(tmp1p, tmp2p);
+            yl1 = _mm_moveldup_ps(z1);
+            yh1 = _mm_movehdup_ps(z1);
+
+            //next four samples
+            _in_common += 4;
+
+            step_indexn = _mm_mul_ps(code_phase_step_chips_reg, indexn);
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // chip index of the four samples for this tap
+                    aux = _mm_add_ps(step_indexn, shifts_chips_reg[n_vec]);
+                    aux = _mm_sub_ps(aux, rem_code_phase_chips_reg);
+                    // floor
+                    aux = _mm_floor_ps(aux);
+                    if (_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(aux, zeros_f), _mm_cmplt_ps(aux, code_length_chips_reg_f))) == 0xF)
+                        {
+                            // usual case: the four chips are within the code period
+                            local_code_chip_index_reg = _mm_cvttps_epi32(aux);
+                        }
+                    else
+                        {
+                            // fmod
+                            c = _mm_div_ps(aux, code_length_chips_reg_f);
+                            ii = _mm_cvttps_epi32(c);
+                            cTrunc = _mm_cvtepi32_ps(ii);
+                            base = _mm_mul_ps(cTrunc, code_length_chips_reg_f);
+                            local_code_chip_index_reg = _mm_cvtps_epi32(_mm_sub_ps(aux, base));
+                            negatives = _mm_cmplt_epi32(local_code_chip_index_reg, zeros);
+                            aux_i = _mm_and_si128(code_length_chips_reg_i, negatives);
+                            local_code_chip_index_reg = _mm_add_epi32(local_code_chip_index_reg, aux_i);
+                        }
+                    _mm_store_si128((__m128i*)local_code_chip_index, local_code_chip_index_reg);
+
+                    // multiply the rotated samples 0 and 1 by their chips
+                    code = _mm_loadl_pi(zeros_f, (const __m64*)&local_code[local_code_chip_index[0]]);
+                    code = _mm_loadh_pi(code, (const __m64*)&local_code[local_code_chip_index[1]]);
+                    tmp1 = _mm_mul_ps(code, yl0);
+                    code = _mm_shuffle_ps(code, code, 0xB1);
+                    tmp2 = _mm_mul_ps(code, yh0);
+                    acc[n_vec] = _mm_add_ps(acc[n_vec], _mm_addsub_ps(tmp1, tmp2));
+
+                    // ... and samples 2 and 3
+                    code = _mm_loadl_pi(zeros_f, (const __m64*)&local_code[local_code_chip_index[2]]);
+                    code = _mm_loadh_pi(code, (const __m64*)&local_code[local_code_chip_index[3]]);
+                    tmp1 = _mm_mul_ps(code, yl1);
+                    code = _mm_shuffle_ps(code, code, 0xB1);
+                    tmp2 = _mm_mul_ps(code, yh1);
+                    acc[n_vec] = _mm_add_ps(acc[n_vec], _mm_addsub_ps(tmp1, tmp2));
+                }
+            indexn = _mm_add_ps(indexn, fours);
+
+            // Regenerate phase
+            if ((number % 64) == 0)
+                {
+                    tmp1 = _mm_mul_ps(two_phase_acc_reg, two_phase_acc_reg);
+                    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                    tmp2 = _mm_sqrt_ps(tmp1);
+                    two_phase_acc_reg = _mm_div_ps(two_phase_acc_reg, tmp2);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            _mm_store_ps((float*)dotProductVector, acc[n_vec]); // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0,0);
+            for (i = 0; i < 2; ++i)
+                {
+                    dotProduct = dotProduct + dotProductVector[i];
+                }
+            result[n_vec] = dotProduct;
+        }
+    volk_gnsssdr_free(acc);
+
+    _mm_store_ps((float*)two_phase_acc, two_phase_acc_reg);
+    (*phase) = two_phase_acc[0];
+
+    for(n = sse_iters * 4; n < num_points; n++)
+        {
+            tmp32_1 = in_common[n] * (*phase);
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    //Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+}
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn_u_avx(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_32fc_t* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    lv_32fc_t dotProduct = lv_cmake(0,0);
+    lv_32fc_t tmp32_1;
+    const unsigned int avx_iters = num_points / 8;
+    int n_vec;
+    int i;
+    unsigned int number;
+    unsigned int n;
+    int local_code_chip_index_;
+    const lv_32fc_t* _in_common = in_common;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t dotProductVector[4];
+    __VOLK_ATTR_ALIGNED(32) int local_code_chip_index[8];
+
+    // accumulators, followed by the shift of each tap
+    __m256* acc = (__m256*)volk_gnsssdr_malloc(2 * num_out_vectors * sizeof(__m256), volk_gnsssdr_get_alignment());
+    __m256* shifts_chips_reg = acc + num_out_vectors;
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm256_setzero_ps();
+            shifts_chips_reg[n_vec] = _mm256_set1_ps(shifts_chips[n_vec]);
+        }
+
+    // phase rotation registers
+    __m256 a, four_phase_acc_reg, yl0, yh0, yl1, yh1, tmp1, tmp1p, tmp2, tmp2p, z;
+
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t four_phase_inc[4];
+    const lv_32fc_t phase_inc2 = phase_inc * phase_inc;
+    const lv_32fc_t phase_inc3 = phase_inc2 * phase_inc;
+    const lv_32fc_t phase_inc4 = phase_inc3 * phase_inc;
+    four_phase_inc[0] = phase_inc4;
+    four_phase_inc[1] = phase_inc4;
+    four_phase_inc[2] = phase_inc4;
+    four_phase_inc[3] = phase_inc4;
+    const __m256 four_phase_inc_reg = _mm256_load_ps((float*)four_phase_inc);
+
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t four_phase_acc[4];
+    four_phase_acc[0] = _phase;
+    four_phase_acc[1] = _phase * phase_inc;
+    four_phase_acc[2] = _phase * phase_inc2;
+    four_phase_acc[3] = _phase * phase_inc3;
+    four_phase_acc_reg = _mm256_load_ps((float*)four_phase_acc);
+
+    const __m256 ylp = _mm256_moveldup_ps(four_phase_inc_reg);
+    const __m256 yhp = _mm256_movehdup_ps(four_phase_inc_reg);
+
+    // code resampling registers
+    const __m256 eights = _mm256_set1_ps(8.0f);
+    const __m256 rem_code_phase_chips_reg = _mm256_set1_ps(rem_code_phase_chips);
+    const __m256 code_phase_step_chips_reg = _mm256_set1_ps(code_phase_step_chips);
+    const __m256 zeros = _mm256_setzero_ps();
+    const __m128 zeros_128 = _mm_setzero_ps();
+    const __m256 code_length_chips_reg_f = _mm256_set1_ps((float)code_length_chips);
+    __m256i local_code_chip_index_reg, ii;
+    __m256 aux, aux3, step_indexn, c, cTrunc, base, negatives, code;
+    __m128 code_lo, code_hi;
+    __m256 indexn = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    for(number = 0; number < avx_iters; number++)
+        {
+            // Phase rotation on samples 0 to 3 of in_common starts here:
+            a = _mm256_loadu_ps((float*)_in_common);
+            __builtin_prefetch(_in_common + 16);
+            yl0 = _mm256_moveldup_ps(four_phase_acc_reg); // Load yl with cr,cr,dr,dr
+            yh0 = _mm256_movehdup_ps(four_phase_acc_reg);
+            tmp1 = _mm256_mul_ps(a, yl0);
+            tmp1p = _mm256_mul_ps(four_phase_acc_reg, ylp);
+            a = _mm256_shuffle_ps(a, a, 0xB1);
+            four_phase_acc_reg = _mm256_shuffle_ps(four_phase_acc_reg, four_phase_acc_reg, 0xB1);
+            tmp2 = _mm256_mul_ps(a, yh0);
+            tmp2p = _mm256_mul_ps(four_phase_acc_reg, yhp);
+            z = _mm256_addsub_ps(tmp1, tmp2);
+            four_phase_acc_reg = _mm256_addsub_ps(tmp1p, tmp2p);
+            yl0 = _mm256_moveldup_ps(z);
+            yh0 = _mm256_movehdup_ps(z);
+
+            // ... and on samples 4 to 7
+            a = _mm256_loadu_ps((float*)(_in_common + 4));
+            yl1 = _mm256_moveldup_ps(four_phase_acc_reg);
+            yh1 = _mm256_movehdup_ps(four_phase_acc_reg);
+            tmp1 = _mm256_mul_ps(a, yl1);
+            tmp1p = _mm256_mul_ps(four_phase_acc_reg, ylp);
+            a = _mm256_shuffle_ps(a, a, 0xB1);
+            four_phase_acc_reg = _mm256_shuffle_ps(four_phase_acc_reg, four_phase_acc_reg, 0xB1);
+            tmp2 = _mm256_mul_ps(a, yh1);
+            tmp2p = _mm256_mul_ps(four_phase_acc_reg, yhp);
+            z = _mm256_addsub_ps(tmp1, tmp2);
+            four_phase_acc_reg = _mm256_addsub_ps(tmp1p, tmp2p);
+            yl1 = _mm256_moveldup_ps(z);
+            yh1 = _mm256_movehdup_ps(z);
+
+            //next eight samples
+            _in_common += 8;
+
+            step_indexn = _mm256_mul_ps(code_phase_step_chips_reg, indexn);
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // chip index of the eight samples for this tap
+                    aux = _mm256_add_ps(step_indexn, shifts_chips_reg[n_vec]);
+                    aux = _mm256_sub_ps(aux, rem_code_phase_chips_reg);
+                    // floor
+                    aux = _mm256_floor_ps(aux);
+                    if (_mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(aux, zeros, 0x0D), _mm256_cmp_ps(aux, code_length_chips_reg_f, 0x01))) != 0xFF)
+                        {
+                            // fmod, unless the eight chips are within the code period (usual case)
+                            c = _mm256_div_ps(aux, code_length_chips_reg_f);
+                            ii = _mm256_cvttps_epi32(c);
+                            cTrunc = _mm256_cvtepi32_ps(ii);
+                            base = _mm256_mul_ps(cTrunc, code_length_chips_reg_f);
+                            aux = _mm256_sub_ps(aux, base);
+                            // no negatives
+                            negatives = _mm256_cmp_ps(aux, zeros, 0x01);
+                            aux3 = _mm256_and_ps(code_length_chips_reg_f, negatives);
+                            aux = _mm256_add_ps(aux, aux3);
+                        }
+                    local_code_chip_index_reg = _mm256_cvttps_epi32(aux);
+                    _mm256_store_si256((__m256i*)local_code_chip_index, local_code_chip_index_reg);
+
+                    // multiply the rotated samples 0 to 3 by their chips
+                    code_lo = _mm_loadl_pi(zeros_128, (const __m64*)&local_code[local_code_chip_index[0]]);
+                    code_lo = _mm_loadh_pi(code_lo, (const __m64*)&local_code[local_code_chip_index[1]]);
+                    code_hi = _mm_loadl_pi(zeros_128, (const __m64*)&local_code[local_code_chip_index[2]]);
+                    code_hi = _mm_loadh_pi(code_hi, (const __m64*)&local_code[local_code_chip_index[3]]);
+                    code = _mm256_insertf128_ps(_mm256_castps128_ps256(code_lo), code_hi, 1);
+                    tmp1 = _mm256_mul_ps(code, yl0);
+                    code = _mm256_shuffle_ps(code, code, 0xB1);
+                    tmp2 = _mm256_mul_ps(code, yh0);
+                    acc[n_vec] = _mm256_add_ps(acc[n_vec], _mm256_addsub_ps(tmp1, tmp2));
+
+                    // ... and samples 4 to 7
+                    code_lo = _mm_loadl_pi(zeros_128, (const __m64*)&local_code[local_code_chip_index[4]]);
+                    code_lo = _mm_loadh_pi(code_lo, (const __m64*)&local_code[local_code_chip_index[5]]);
+                    code_hi = _mm_loadl_pi(zeros_128, (const __m64*)&local_code[local_code_chip_index[6]]);
+                    code_hi = _mm_loadh_pi(code_hi, (const __m64*)&local_code[local_code_chip_index[7]]);
+                    code = _mm256_insertf128_ps(_mm256_castps128_ps256(code_lo), code_hi, 1);
+                    tmp1 = _mm256_mul_ps(code, yl1);
+                    code = _mm256_shuffle_ps(code, code, 0xB1);
+                    tmp2 = _mm256_mul_ps(code, yh1);
+                    acc[n_vec] = _mm256_add_ps(acc[n_vec], _mm256_addsub_ps(tmp1, tmp2));
+                }
+            indexn = _mm256_add_ps(indexn, eights);
+
+            // Regenerate phase
+            if ((number % 64) == 0)
+                {
+                    tmp1 = _mm256_mul_ps(four_phase_acc_reg, four_phase_acc_reg);
+                    tmp2 = _mm256_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm256_shuffle_ps(tmp2, tmp2, 0xD8);
+                    tmp2 = _mm256_sqrt_ps(tmp1);
+                    four_phase_acc_reg = _mm256_div_ps(four_phase_acc_reg, tmp2);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            _mm256_store_ps((float*)dotProductVector, acc[n_vec]); // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0,0);
+            for (i = 0; i < 4; ++i)
+                {
+                    dotProduct = dotProduct + dotProductVector[i];
+                }
+            result[n_vec] = dotProduct;
+        }
+    volk_gnsssdr_free(acc);
+
+    tmp1 = _mm256_mul_ps(four_phase_acc_reg, four_phase_acc_reg);
+    tmp2 = _mm256_hadd_ps(tmp1, tmp1);
+    tmp1 = _mm256_shuffle_ps(tmp2, tmp2, 0xD8);
+    tmp2 = _mm256_sqrt_ps(tmp1);
+    four_phase_acc_reg = _mm256_div_ps(four_phase_acc_reg, tmp2);
+
+    _mm256_store_ps((float*)four_phase_acc, four_phase_acc_reg);
+    _phase = four_phase_acc[0];
+    _mm256_zeroupper();
+
+    for(n = avx_iters * 8; n < num_points; n++)
+        {
+            tmp32_1 = in_common[n] * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    //Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+    (*phase) = _phase;
+}
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn_a_avx(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_32fc_t* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    lv_32fc_t dotProduct = lv_cmake(0,0);
+    lv_32fc_t tmp32_1;
+    const unsigned int avx_iters = num_points / 8;
+    int n_vec;
+    int i;
+    unsigned int number;
+    unsigned int n;
+    int local_code_chip_index_;
+    const lv_32fc_t* _in_common = in_common;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t dotProductVector[4];
+    __VOLK_ATTR_ALIGNED(32) int local_code_chip_index[8];
+
+    // accumulators, followed by the shift of each tap
+    __m256* acc = (__m256*)volk_gnsssdr_malloc(2 * num_out_vectors * sizeof(__m256), volk_gnsssdr_get_alignment());
+    __m256* shifts_chips_reg = acc + num_out_vectors;
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm256_setzero_ps();
+            shifts_chips_reg[n_vec] = _mm256_set1_ps(shifts_chips[n_vec]);
+        }
+
+    // phase rotation registers
+    __m256 a, four_phase_acc_reg, yl0, yh0, yl1, yh1, tmp1, tmp1p, tmp2, tmp2p, z;
+
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t four_phase_inc[4];
+    const lv_32fc_t phase_inc2 = phase_inc * phase_inc;
+    const lv_32fc_t phase_inc3 = phase_inc2 * phase_inc;
+    const lv_32fc_t phase_inc4 = phase_inc3 * phase_inc;
+    four_phase_inc[0] = phase_inc4;
+    four_phase_inc[1] = phase_inc4;
+    four_phase_inc[2] = phase_inc4;
+    four_phase_inc[3] = phase_inc4;
+    const __m256 four_phase_inc_reg = _mm256_load_ps((float*)four_phase_inc);
+
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t four_phase_acc[4];
+    four_phase_acc[0] = _phase;
+    four_phase_acc[1] = _phase * phase_inc;
+    four_phase_acc[2] = _phase * phase_inc2;
+    four_phase_acc[3] = _phase * phase_inc3;
+    four_phase_acc_reg = _mm256_load_ps((float*)four_phase_acc);
+
+    const __m256 ylp = _mm256_moveldup_ps(four_phase_inc_reg);
+    const __m256 yhp = _mm256_movehdup_ps(four_phase_inc_reg);
+
+    // code resampling registers
+    const __m256 eights = _mm256_set1_ps(8.0f);
+    const __m256 rem_code_phase_chips_reg = _mm256_set1_ps(rem_code_phase_chips);
+    const __m256 code_phase_step_chips_reg = _mm256_set1_ps(code_phase_step_chips);
+    const __m256 zeros = _mm256_setzero_ps();
+    const __m128 zeros_128 = _mm_setzero_ps();
+    const __m256 code_length_chips_reg_f = _mm256_set1_ps((float)code_length_chips);
+    __m256i local_code_chip_index_reg, ii;
+    __m256 aux, aux3, step_indexn, c, cTrunc, base, negatives, code;
+    __m128 code_lo, code_hi;
+    __m256 indexn = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    for(number = 0; number < avx_iters; number++)
+        {
+            // Phase rotation on samples 0 to 3 of in_common starts here:
+            a = _mm256_load_ps((float*)_in_common);
+            __builtin_prefetch(_in_common + 16);
+            yl0 = _mm256_moveldup_ps(four_phase_acc_reg); // Load yl with cr,cr,dr,dr
+            yh0 = _mm256_movehdup_ps(four_phase_acc_reg);
+            tmp1 = _mm256_mul_ps(a, yl0);
+            tmp1p = _mm256_mul_ps(four_phase_acc_reg, ylp);
+            a = _mm256_shuffle_ps(a, a, 0xB1);
+            four_phase_acc_reg = _mm256_shuffle_ps(four_phase_acc_reg, four_phase_acc_reg, 0xB1);
+            tmp2 = _mm256_mul_ps(a, yh0);
+            tmp2p = _mm256_mul_ps(four_phase_acc_reg, yhp);
+            z = _mm256_addsub_ps(tmp1, tmp2);
+            four_phase_acc_reg = _mm256_addsub_ps(tmp1p, tmp2p);
+            yl0 = _mm256_moveldup_ps(z);
+            yh0 = _mm256_movehdup_ps(z);
+
+            // ... and on samples 4 to 7
+            a = _mm256_load_ps((float*)(_in_common + 4));
+            yl1 = _mm256_moveldup_ps(four_phase_acc_reg);
+            yh1 = _mm256_movehdup_ps(four_phase_acc_reg);
+            tmp1 = _mm256_mul_ps(a, yl1);
+            tmp1p = _mm256_mul_ps(four_phase_acc_reg, ylp);
+            a = _mm256_shuffle_ps(a, a, 0xB1);
+            four_phase_acc_reg = _mm256_shuffle_ps(four_phase_acc_reg, four_phase_acc_reg, 0xB1);
+            tmp2 = _mm256_mul_ps(a, yh1);
+            tmp2p = _mm256_mul_ps(four_phase_acc_reg, yhp);
+            z = _mm256_addsub_ps(tmp1, tmp2);
+            four_phase_acc_reg = _mm256_addsub_ps(tmp1p, tmp2p);
+            yl1 = _mm256_moveldup_ps(z);
+            yh1 = _mm256_movehdup_ps(z);
+
+            //next eight samples
+            _in_common += 8;
+
+            step_indexn = _mm256_mul_ps(code_phase_step_chips_reg, indexn);
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // chip index of the eight samples for this tap
+                    aux = _mm256_add_ps(step_indexn, shifts_chips_reg[n_vec]);
+                    aux = _mm256_sub_ps(aux, rem_code_phase_chips_reg);
+                    // floor
+                    aux = _mm256_floor_ps(aux);
+                    if (_mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(aux, zeros, 0x0D), _mm256_cmp_ps(aux, code_length_chips_reg_f, 0x01))) != 0xFF)
+                        {
+                            // fmod, unless the eight chips are within the code period (usual case)
+                            c = _mm256_div_ps(aux, code_length_chips_reg_f);
+                            ii = _mm256_cvttps_epi32(c);
+                            cTrunc = _mm256_cvtepi32_ps(ii);
+                            base = _mm256_mul_ps(cTrunc, code_length_chips_reg_f);
+                            aux = _mm256_sub_ps(aux, base);
+                            // no negatives
+                            negatives = _mm256_cmp_ps(aux, zeros, 0x01);
+                            aux3 = _mm256_and_ps(code_length_chips_reg_f, negatives);
+                            aux = _mm256_add_ps(aux, aux3);
+                        }
+                    local_code_chip_index_reg = _mm256_cvttps_epi32(aux);
+                    _mm256_store_si256((__m256i*)local_code_chip_index, local_code_chip_index_reg);
+
+                    // multiply the rotated samples 0 to 3 by their chips
+                    code_lo = _mm_loadl_pi(zeros_128, (const __m64*)&local_code[local_code_chip_index[0]]);
+                    code_lo = _mm_loadh_pi(code_lo, (const __m64*)&local_code[local_code_chip_index[1]]);
+                    code_hi = _mm_loadl_pi(zeros_128, (const __m64*)&local_code[local_code_chip_index[2]]);
+                    code_hi = _mm_loadh_pi(code_hi, (const __m64*)&local_code[local_code_chip_index[3]]);
+                    code = _mm256_insertf128_ps(_mm256_castps128_ps256(code_lo), code_hi, 1);
+                    tmp1 = _mm256_mul_ps(code, yl0);
+                    code = _mm256_shuffle_ps(code, code, 0xB1);
+                    tmp2 = _mm256_mul_ps(code, yh0);
+                    acc[n_vec] = _mm256_add_ps(acc[n_vec], _mm256_addsub_ps(tmp1, tmp2));
+
+                    // ... and samples 4 to 7
+                    code_lo = _mm_loadl_pi(zeros_128, (const __m64*)&local_code[local_code_chip_index[4]]);
+                    code_lo = _mm_loadh_pi(code_lo, (const __m64*)&local_code[local_code_chip_index[5]]);
+                    code_hi = _mm_loadl_pi(zeros_128, (const __m64*)&local_code[local_code_chip_index[6]]);
+                    code_hi = _mm_loadh_pi(code_hi, (const __m64*)&local_code[local_code_chip_index[7]]);
+                    code = _mm256_insertf128_ps(_mm256_castps128_ps256(code_lo), code_hi, 1);
+                    tmp1 = _mm256_mul_ps(code, yl1);
+                    code = _mm256_shuffle_ps(code, code, 0xB1);
+                    tmp2 = _mm256_mul_ps(code, yh1);
+                    acc[n_vec] = _mm256_add_ps(acc[n_vec], _mm256_addsub_ps(tmp1, tmp2));
+                }
+            indexn = _mm256_add_ps(indexn, eights);
+
+            // Regenerate phase
+            if ((number % 64) == 0)
+                {
+                    tmp1 = _mm256_mul_ps(four_phase_acc_reg, four_phase_acc_reg);
+                    tmp2 = _mm256_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm256_shuffle_ps(tmp2, tmp2, 0xD8);
+                    tmp2 = _mm256_sqrt_ps(tmp1);
+                    four_phase_acc_reg = _mm256_div_ps(four_phase_acc_reg, tmp2);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            _mm256_store_ps((float*)dotProductVector, acc[n_vec]); // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0,0);
+            for (i = 0; i < 4; ++i)
+                {
+                    dotProduct = dotProduct + dotProductVector[i];
+                }
+            result[n_vec] = dotProduct;
+        }
+    volk_gnsssdr_free(acc);
+
+    tmp1 = _mm256_mul_ps(four_phase_acc_reg, four_phase_acc_reg);
+    tmp2 = _mm256_hadd_ps(tmp1, tmp1);
+    tmp1 = _mm256_shuffle_ps(tmp2, tmp2, 0xD8);
+    tmp2 = _mm256_sqrt_ps(tmp1);
+    four_phase_acc_reg = _mm256_div_ps(four_phase_acc_reg, tmp2);
+
+    _mm256_store_ps((float*)four_phase_acc, four_phase_acc_reg);
+    _phase = four_phase_acc[0];
+    _mm256_zeroupper();
+
+    for(n = avx_iters * 8; n < num_points; n++)
+        {
+            tmp32_1 = in_common[n] * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    //Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+    (*phase) = _phase;
+}
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn_u_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_32fc_t* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    lv_32fc_t dotProduct = lv_cmake(0,0);
+    lv_32fc_t tmp32_1;
+    const unsigned int avx512_iters = num_points / 16;
+    int n_vec;
+    int i;
+    unsigned int number;
+    unsigned int n;
+    int local_code_chip_index_;
+    const lv_32fc_t* _in_common = in_common;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(64) lv_32fc_t dotProductVector[8];
+
+    // accumulators, followed by the shift of each tap
+    __m512* acc = (__m512*)volk_gnsssdr_malloc(2 * num_out_vectors * sizeof(__m512), volk_gnsssdr_get_alignment());
+    __m512* shifts_chips_reg = acc + num_out_vectors;
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm512_setzero_ps();
+            shifts_chips_reg[n_vec] = _mm512_set1_ps(shifts_chips[n_vec]);
+        }
+
+    // phase rotation registers
+    __m512 a, eight_phase_acc_reg, yl0, yh0, yl1, yh1, tmp1, tmp2, z;
+
+    __VOLK_ATTR_ALIGNED(64) lv_32fc_t eight_phase_inc[8];
+    __VOLK_ATTR_ALIGNED(64) lv_32fc_t eight_phase_acc[8];
+    lv_32fc_t phase_inc_k = lv_cmake(1, 0);
+    for (i = 0; i < 8; ++i)
+        {
+            eight_phase_acc[i] = _phase * phase_inc_k;
+            phase_inc_k *= phase_inc;
+        }
+    for (i = 0; i < 8; ++i)
+        {
+            eight_phase_inc[i] = phase_inc_k;
+        }
+    const __m512 eight_phase_inc_reg = _mm512_load_ps((float*)eight_phase_inc);
+    eight_phase_acc_reg = _mm512_load_ps((float*)eight_phase_acc);
+
+    const __m512 ylp = _mm512_moveldup_ps(eight_phase_inc_reg);
+    const __m512 yhp = _mm512_movehdup_ps(eight_phase_inc_reg);
+
+    // code resampling registers
+    const __m512 sixteens = _mm512_set1_ps(16.0f);
+    const __m512 rem_code_phase_chips_reg = _mm512_set1_ps(rem_code_phase_chips);
+    const __m512 code_phase_step_chips_reg = _mm512_set1_ps(code_phase_step_chips);
+    const __m512 zeros = _mm512_setzero_ps();
+    const __m512 code_length_chips_reg_f = _mm512_set1_ps((float)code_length_chips);
+    __m512i local_code_chip_index_reg, ii;
+    __m512 aux, step_indexn, c, cTrunc, base, code;
+    __mmask16 in_range;
+    __m512 indexn = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f, 7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    for(number = 0; number < avx512_iters; number++)
+        {
+            // Phase rotation on samples 0 to 7 of in_common starts here:
+            a = _mm512_loadu_ps((float*)_in_common);
+            __builtin_prefetch(_in_common + 32);
+            yl0 = _mm512_moveldup_ps(eight_phase_acc_reg); // Load yl with cr,cr,dr,dr
+            yh0 = _mm512_movehdup_ps(eight_phase_acc_reg);
+            tmp2 = _mm512_mul_ps(_mm512_permute_ps(a, 0xB1), yh0);
+            z = _mm512_fmaddsub_ps(a, yl0, tmp2);
+            tmp2 = _mm512_mul_ps(_mm512_permute_ps(eight_phase_acc_reg, 0xB1), yhp);
+            eight_phase_acc_reg = _mm512_fmaddsub_ps(eight_phase_acc_reg, ylp, tmp2);
+            yl0 = _mm512_moveldup_ps(z);
+            yh0 = _mm512_movehdup_ps(z);
+
+            // ... and on samples 8 to 15
+            a = _mm512_loadu_ps((float*)(_in_common + 8));
+            yl1 = _mm512_moveldup_ps(eight_phase_acc_reg);
+            yh1 = _mm512_movehdup_ps(eight_phase_acc_reg);
+            tmp2 = _mm512_mul_ps(_mm512_permute_ps(a, 0xB1), yh1);
+            z = _mm512_fmaddsub_ps(a, yl1, tmp2);
+            tmp2 = _mm512_mul_ps(_mm512_permute_ps(eight_phase_acc_reg, 0xB1), yhp);
+            eight_phase_acc_reg = _mm512_fmaddsub_ps(eight_phase_acc_reg, ylp, tmp2);
+            yl1 = _mm512_moveldup_ps(z);
+            yh1 = _mm512_movehdup_ps(z);
+
+            //next sixteen samples
+            _in_common += 16;
+
+            step_indexn = _mm512_mul_ps(code_phase_step_chips_reg, indexn);
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // chip index of the sixteen samples for this tap
+                    aux = _mm512_add_ps(step_indexn, shifts_chips_reg[n_vec]);
+                    aux = _mm512_sub_ps(aux, rem_code_phase_chips_reg);
+                    // floor
+                    aux = _mm512_roundscale_ps(aux, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+                    in_range = _mm512_cmp_ps_mask(aux, zeros, _CMP_GE_OS) & _mm512_cmp_ps_mask(aux, code_length_chips_reg_f, _CMP_LT_OS);
+                    if (in_range != 0xFFFF)
+                        {
+                            // fmod, unless the sixteen chips are within the code period (usual case)
+                            c = _mm512_div_ps(aux, code_length_chips_reg_f);
+                            ii = _mm512_cvttps_epi32(c);
+                            cTrunc = _mm512_cvtepi32_ps(ii);
+                            base = _mm512_mul_ps(cTrunc, code_length_chips_reg_f);
+                            aux = _mm512_sub_ps(aux, base);
+                            // no negatives
+                            aux = _mm512_mask_add_ps(aux, _mm512_cmp_ps_mask(aux, zeros, _CMP_LT_OS), aux, code_length_chips_reg_f);
+                        }
+                    local_code_chip_index_reg = _mm512_cvttps_epi32(aux);
+
+                    // gather the chips of samples 0 to 7 (a complex chip is one 64 bit word) and accumulate
+                    code = _mm512_castpd_ps(_mm512_i32gather_pd(_mm512_castsi512_si256(local_code_chip_index_reg), (const double*)local_code, 8));
+                    tmp2 = _mm512_mul_ps(_mm512_permute_ps(code, 0xB1), yh0);
+                    acc[n_vec] = _mm512_add_ps(acc[n_vec], _mm512_fmaddsub_ps(code, yl0, tmp2));
+
+                    // ... and samples 8 to 15
+                    code = _mm512_castpd_ps(_mm512_i32gather_pd(_mm512_extracti64x4_epi64(local_code_chip_index_reg, 1), (const double*)local_code, 8));
+                    tmp2 = _mm512_mul_ps(_mm512_permute_ps(code, 0xB1), yh1);
+                    acc[n_vec] = _mm512_add_ps(acc[n_vec], _mm512_fmaddsub_ps(code, yl1, tmp2));
+                }
+            indexn = _mm512_add_ps(indexn, sixteens);
+
+            // Regenerate phase
+            if ((number % 32) == 0)
+                {
+                    tmp1 = _mm512_mul_ps(eight_phase_acc_reg, eight_phase_acc_reg);
+                    tmp2 = _mm512_add_ps(tmp1, _mm512_permute_ps(tmp1, 0xB1));
+                    eight_phase_acc_reg = _mm512_div_ps(eight_phase_acc_reg, _mm512_sqrt_ps(tmp2));
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            _mm512_store_ps((float*)dotProductVector, acc[n_vec]); // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0,0);
+            for (i = 0; i < 8; ++i)
+                {
+                    dotProduct = dotProduct + dotProductVector[i];
+                }
+            result[n_vec] = dotProduct;
+        }
+    volk_gnsssdr_free(acc);
+
+    tmp1 = _mm512_mul_ps(eight_phase_acc_reg, eight_phase_acc_reg);
+    tmp2 = _mm512_add_ps(tmp1, _mm512_permute_ps(tmp1, 0xB1));
+    eight_phase_acc_reg = _mm512_div_ps(eight_phase_acc_reg, _mm512_sqrt_ps(tmp2));
+
+    _mm512_store_ps((float*)eight_phase_acc, eight_phase_acc_reg);
+    _phase = eight_phase_acc[0];
+    _mm256_zeroupper();
+
+    for(n = avx512_iters * 16; n < num_points; n++)
+        {
+            tmp32_1 = in_common[n] * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    //Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+    (*phase) = _phase;
+}
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn_a_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_32fc_t* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    lv_32fc_t dotProduct = lv_cmake(0,0);
+    lv_32fc_t tmp32_1;
+    const unsigned int avx512_iters = num_points / 16;
+    int n_vec;
+    int i;
+    unsigned int number;
+    unsigned int n;
+    int local_code_chip_index_;
+    const lv_32fc_t* _in_common = in_common;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(64) lv_32fc_t dotProductVector[8];
+
+    // accumulators, followed by the shift of each tap
+    __m512* acc = (__m512*)volk_gnsssdr_malloc(2 * num_out_vectors * sizeof(__m512), volk_gnsssdr_get_alignment());
+    __m512* shifts_chips_reg = acc + num_out_vectors;
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm512_setzero_ps();
+            shifts_chips_reg[n_vec] = _mm512_set1_ps(shifts_chips[n_vec]);
+        }
+
+    // phase rotation registers
+    __m512 a, eight_phase_acc_reg, yl0, yh0, yl1, yh1, tmp1, tmp2, z;
+
+    __VOLK_ATTR_ALIGNED(64) lv_32fc_t eight_phase_inc[8];
+    __VOLK_ATTR_ALIGNED(64) lv_32fc_t eight_phase_acc[8];
+    lv_32fc_t phase_inc_k = lv_cmake(1, 0);
+    for (i = 0; i < 8; ++i)
+        {
+            eight_phase_acc[i] = _phase * phase_inc_k;
+            phase_inc_k *= phase_inc;
+        }
+    for (i = 0; i < 8; ++i)
+        {
+            eight_phase_inc[i] = phase_inc_k;
+        }
+    const __m512 eight_phase_inc_reg = _mm512_load_ps((float*)eight_phase_inc);
+    eight_phase_acc_reg = _mm512_load_ps((float*)eight_phase_acc);
+
+    const __m512 ylp = _mm512_moveldup_ps(eight_phase_inc_reg);
+    const __m512 yhp = _mm512_movehdup_ps(eight_phase_inc_reg);
+
+    // code resampling registers
+    const __m512 sixteens = _mm512_set1_ps(16.0f);
+    const __m512 rem_code_phase_chips_reg = _mm512_set1_ps(rem_code_phase_chips);
+    const __m512 code_phase_step_chips_reg = _mm512_set1_ps(code_phase_step_chips);
+    const __m512 zeros = _mm512_setzero_ps();
+    const __m512 code_length_chips_reg_f = _mm512_set1_ps((float)code_length_chips);
+    __m512i local_code_chip_index_reg, ii;
+    __m512 aux, step_indexn, c, cTrunc, base, code;
+    __mmask16 in_range;
+    __m512 indexn = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f, 7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    for(number = 0; number < avx512_iters; number++)
+        {
+            // Phase rotation on samples 0 to 7 of in_common starts here:
+            a = _mm512_load_ps((float*)_in_common);
+            __builtin_prefetch(_in_common + 32);
+            yl0 = _mm512_moveldup_ps(eight_phase_acc_reg); // Load yl with cr,cr,dr,dr
+            yh0 = _mm512_movehdup_ps(eight_phase_acc_reg);
+            tmp2 = _mm512_mul_ps(_mm512_permute_ps(a, 0xB1), yh0);
+            z = _mm512_fmaddsub_ps(a, yl0, tmp2);
+            tmp2 = _mm512_mul_ps(_mm512_permute_ps(eight_phase_acc_reg, 0xB1), yhp);
+            eight_phase_acc_reg = _mm512_fmaddsub_ps(eight_phase_acc_reg, ylp, tmp2);
+            yl0 = _mm512_moveldup_ps(z);
+            yh0 = _mm512_movehdup_ps(z);
+
+            // ... and on samples 8 to 15
+            a = _mm512_load_ps((float*)(_in_common + 8));
+            yl1 = _mm512_moveldup_ps(eight_phase_acc_reg);
+            yh1 = _mm512_movehdup_ps(eight_phase_acc_reg);
+            tmp2 = _mm512_mul_ps(_mm512_permute_ps(a, 0xB1), yh1);
+            z = _mm512_fmaddsub_ps(a, yl1, tmp2);
+            tmp2 = _mm512_mul_ps(_mm512_permute_ps(eight_phase_acc_reg, 0xB1), yhp);
+            eight_phase_acc_reg = _mm512_fmaddsub_ps(eight_phase_acc_reg, ylp, tmp2);
+            yl1 = _mm512_moveldup_ps(z);
+            yh1 = _mm512_movehdup_ps(z);
+
+            //next sixteen samples
+            _in_common += 16;
+
+            step_indexn = _mm512_mul_ps(code_phase_step_chips_reg, indexn);
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // chip index of the sixteen samples for this tap
+                    aux = _mm512_add_ps(step_indexn, shifts_chips_reg[n_vec]);
+                    aux = _mm512_sub_ps(aux, rem_code_phase_chips_reg);
+                    // floor
+                    aux = _mm512_roundscale_ps(aux, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+                    in_range = _mm512_cmp_ps_mask(aux, zeros, _CMP_GE_OS) & _mm512_cmp_ps_mask(aux, code_length_chips_reg_f, _CMP_LT_OS);
+                    if (in_range != 0xFFFF)
+                        {
+                            // fmod, unless the sixteen chips are within the code period (usual case)
+                            c = _mm512_div_ps(aux, code_length_chips_reg_f);
+                            ii = _mm512_cvttps_epi32(c);
+                            cTrunc = _mm512_cvtepi32_ps(ii);
+                            base = _mm512_mul_ps(cTrunc, code_length_chips_reg_f);
+                            aux = _mm512_sub_ps(aux, base);
+                            // no negatives
+                            aux = _mm512_mask_add_ps(aux, _mm512_cmp_ps_mask(aux, zeros, _CMP_LT_OS), aux, code_length_chips_reg_f);
+                        }
+                    local_code_chip_index_reg = _mm512_cvttps_epi32(aux);
+
+                    // gather the chips of samples 0 to 7 (a complex chip is one 64 bit word) and accumulate
+                    code = _mm512_castpd_ps(_mm512_i32gather_pd(_mm512_castsi512_si256(local_code_chip_index_reg), (const double*)local_code, 8));
+                    tmp2 = _mm512_mul_ps(_mm512_permute_ps(code, 0xB1), yh0);
+                    acc[n_vec] = _mm512_add_ps(acc[n_vec], _mm512_fmaddsub_ps(code, yl0, tmp2));
+
+                    // ... and samples 8 to 15
+                    code = _mm512_castpd_ps(_mm512_i32gather_pd(_mm512_extracti64x4_epi64(local_code_chip_index_reg, 1), (const double*)local_code, 8));
+                    tmp2 = _mm512_mul_ps(_mm512_permute_ps(code, 0xB1), yh1);
+                    acc[n_vec] = _mm512_add_ps(acc[n_vec], _mm512_fmaddsub_ps(code, yl1, tmp2));
+                }
+            indexn = _mm512_add_ps(indexn, sixteens);
+
+            // Regenerate phase
+            if ((number % 32) == 0)
+                {
+                    tmp1 = _mm512_mul_ps(eight_phase_acc_reg, eight_phase_acc_reg);
+                    tmp2 = _mm512_add_ps(tmp1, _mm512_permute_ps(tmp1, 0xB1));
+                    eight_phase_acc_reg = _mm512_div_ps(eight_phase_acc_reg, _mm512_sqrt_ps(tmp2));
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            _mm512_store_ps((float*)dotProductVector, acc[n_vec]); // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0,0);
+            for (i = 0; i < 8; ++i)
+                {
+                    dotProduct = dotProduct + dotProductVector[i];
+                }
+            result[n_vec] = dotProduct;
+        }
+    volk_gnsssdr_free(acc);
+
+    tmp1 = _mm512_mul_ps(eight_phase_acc_reg, eight_phase_acc_reg);
+    tmp2 = _mm512_add_ps(tmp1, _mm512_permute_ps(tmp1, 0xB1));
+    eight_phase_acc_reg = _mm512_div_ps(eight_phase_acc_reg, _mm512_sqrt_ps(tmp2));
+
+    _mm512_store_ps((float*)eight_phase_acc, eight_phase_acc_reg);
+    _phase = eight_phase_acc[0];
+    _mm256_zeroupper();
+
+    for(n = avx512_iters * 16; n < num_points; n++)
+        {
+            tmp32_1 = in_common[n] * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    //Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+    (*phase) = _phase;
+}
+#endif /* LV_HAVE_AVX512F */
+
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn_H */
@@ -518,6 +518,150 @@ static inline void volk_gnsssdr_32fc_xn_resampler_32fc_xn_u_avx(lv_32fc_t** resu
 #endif
 
 
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_xn_resampler_32fc_xn_a_avx512f(lv_32fc_t** result, const lv_32fc_t* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    lv_32fc_t** _result = result;
+    const unsigned int avx512_iters = num_points / 16;
+    int current_correlator_tap;
+    unsigned int n;
+    const __m512 sixteens = _mm512_set1_ps(16.0f);
+    const __m512 rem_code_phase_chips_reg = _mm512_set1_ps(rem_code_phase_chips);
+    const __m512 code_phase_step_chips_reg = _mm512_set1_ps(code_phase_step_chips);
+
+    int local_code_chip_index_;
+
+    const __m512 zeros = _mm512_setzero_ps();
+    const __m512 code_length_chips_reg_f = _mm512_set1_ps((float)code_length_chips);
+    const __m512 n0 = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f, 7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    __m512i local_code_chip_index_reg, i;
+    __m512 aux, shifts_chips_reg, c, cTrunc, base, indexn;
+    __m512d chips;
+
+    for (current_correlator_tap = 0; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            shifts_chips_reg = _mm512_set1_ps((float)shifts_chips[current_correlator_tap]);
+            indexn = n0;
+            for(n = 0; n < avx512_iters; n++)
+                {
+                    __builtin_prefetch(&_result[current_correlator_tap][16 * n + 15], 1, 0);
+                    aux = _mm512_mul_ps(code_phase_step_chips_reg, indexn);
+                    aux = _mm512_add_ps(aux, shifts_chips_reg);
+                    aux = _mm512_sub_ps(aux, rem_code_phase_chips_reg);
+                    // floor
+                    aux = _mm512_roundscale_ps(aux, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+
+                    // fmod
+                    c = _mm512_div_ps(aux, code_length_chips_reg_f);
+                    i = _mm512_cvttps_epi32(c);
+                    cTrunc = _mm512_cvtepi32_ps(i);
+                    base = _mm512_mul_ps(cTrunc, code_length_chips_reg_f);
+                    aux = _mm512_sub_ps(aux, base);
+
+                    // no negatives
+                    aux = _mm512_mask_add_ps(aux, _mm512_cmp_ps_mask(aux, zeros, _CMP_LT_OS), aux, code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm512_cvttps_epi32(aux);
+
+                    // gather eight complex chips (one 64 bit word each) at a time
+                    chips = _mm512_i32gather_pd(_mm512_castsi512_si256(local_code_chip_index_reg), (const double*)local_code, 8);
+                    _mm512_store_pd((double*)&_result[current_correlator_tap][n * 16], chips);
+                    chips = _mm512_i32gather_pd(_mm512_extracti64x4_epi64(local_code_chip_index_reg, 1), (const double*)local_code, 8);
+                    _mm512_store_pd((double*)&_result[current_correlator_tap][n * 16 + 8], chips);
+
+                    indexn = _mm512_add_ps(indexn, sixteens);
+                }
+        }
+    _mm256_zeroupper();
+    for (current_correlator_tap = 0; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            for(n = avx512_iters * 16; n < num_points; n++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[current_correlator_tap] - rem_code_phase_chips);
+                    //Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1) ;
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    _result[current_correlator_tap][n] = local_code[local_code_chip_index_];
+                }
+        }
+}
+
+#endif
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_xn_resampler_32fc_xn_u_avx512f(lv_32fc_t** result, const lv_32fc_t* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    lv_32fc_t** _result = result;
+    const unsigned int avx512_iters = num_points / 16;
+    int current_correlator_tap;
+    unsigned int n;
+    const __m512 sixteens = _mm512_set1_ps(16.0f);
+    const __m512 rem_code_phase_chips_reg = _mm512_set1_ps(rem_code_phase_chips);
+    const __m512 code_phase_step_chips_reg = _mm512_set1_ps(code_phase_step_chips);
+
+    int local_code_chip_index_;
+
+    const __m512 zeros = _mm512_setzero_ps();
+    const __m512 code_length_chips_reg_f = _mm512_set1_ps((float)code_length_chips);
+    const __m512 n0 = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f, 7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    __m512i local_code_chip_index_reg, i;
+    __m512 aux, shifts_chips_reg, c, cTrunc, base, indexn;
+    __m512d chips;
+
+    for (current_correlator_tap = 0; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            shifts_chips_reg = _mm512_set1_ps((float)shifts_chips[current_correlator_tap]);
+            indexn = n0;
+            for(n = 0; n < avx512_iters; n++)
+                {
+                    __builtin_prefetch(&_result[current_correlator_tap][16 * n + 15], 1, 0);
+                    aux = _mm512_mul_ps(code_phase_step_chips_reg, indexn);
+                    aux = _mm512_add_ps(aux, shifts_chips_reg);
+                    aux = _mm512_sub_ps(aux, rem_code_phase_chips_reg);
+                    // floor
+                    aux = _mm512_roundscale_ps(aux, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+
+                    // fmod
+                    c = _mm512_div_ps(aux, code_length_chips_reg_f);
+                    i = _mm512_cvttps_epi32(c);
+                    cTrunc = _mm512_cvtepi32_ps(i);
+                    base = _mm512_mul_ps(cTrunc, code_length_chips_reg_f);
+                    aux = _mm512_sub_ps(aux, base);
+
+                    // no negatives
+                    aux = _mm512_mask_add_ps(aux, _mm512_cmp_ps_mask(aux, zeros, _CMP_LT_OS), aux, code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm512_cvttps_epi32(aux);
+
+                    // gather eight complex chips (one 64 bit word each) at a time
+                    chips = _mm512_i32gather_pd(_mm512_castsi512_si256(local_code_chip_index_reg), (const double*)local_code, 8);
+                    _mm512_storeu_pd((double*)&_result[current_correlator_tap][n * 16], chips);
+                    chips = _mm512_i32gather_pd(_mm512_extracti64x4_epi64(local_code_chip_index_reg, 1), (const double*)local_code, 8);
+                    _mm512_storeu_pd((double*)&_result[current_correlator_tap][n * 16 + 8], chips);
+
+                    indexn = _mm512_add_ps(indexn, sixteens);
+                }
+        }
+    _mm256_zeroupper();
+    for (current_correlator_tap = 0; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            for(n = avx512_iters * 16; n < num_points; n++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[current_correlator_tap] - rem_code_phase_chips);
+                    //Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1) ;
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    _result[current_correlator_tap][n] = local_code[local_code_chip_index_];
+                }
+        }
+}
+
+#endif
+
 #ifdef LV_HAVE_NEON
 #include <arm_neon.h>
 
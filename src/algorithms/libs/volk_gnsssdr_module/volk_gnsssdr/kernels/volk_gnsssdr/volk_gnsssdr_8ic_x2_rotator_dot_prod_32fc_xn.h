@@ -0,0 +1,714 @@
+/*!
+ * \file volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: multiplies N 8 bits complex vectors by a common vector,
+ * phase rotated, and accumulates the results in N float complex outputs.
+ *
+ * VOLK_GNSSSDR kernel that multiplies N 8 bits complex vectors by a common vector, which is
+ * phase-rotated by phase offset and phase increment, and accumulates the results
+ * in N 32 bits float complex outputs.
+ * The inputs are converted to float on the fly, so the signal and the code replicas
+ * take a quarter of the memory bandwidth of the 32fc kernel, and the accumulators
+ * cannot saturate (an 8 bits accumulator would saturate after a few samples).
+ * It is optimized to perform the N tap correlation process in GNSS receivers
+ * fed with low resolution (2 to 8 bits) samples.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn
+ *
+ * \b Overview
+ *
+ * Rotates and multiplies the reference complex vector with an arbitrary number of other complex vectors,
+ * accumulates the results and stores them in the output vector.
+ * The rotation is done at a fixed rate per sample, from an initial \p phase offset.
+ * This function can be used for Doppler wipe-off and multiple correlator.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn(lv_32fc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_8sc_t** in_a, int num_a_vectors, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:     Pointer to one of the vectors to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc:     Phase increment = lv_cmake(cos(phase_step_rad), sin(phase_step_rad))
+ * \li phase:         Initial phase = lv_cmake(cos(initial_phase_rad), sin(initial_phase_rad))
+ * \li in_a:          Pointer to an array of pointers to multiple vectors to be multiplied and accumulated.
+ * \li num_a_vectors: Number of vectors to be multiplied by the reference vector and accumulated.
+ * \li num_points:    Number of complex values to be multiplied together, accumulated and stored into \p result.
+ *
+ * \b Outputs
+ * \li phase:         Final phase.
+ * \li result:        Vector of \p num_a_vectors components with the multiple vectors of \p in_a rotated, multiplied by \p in_common and accumulated.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn_H
+
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn_generic(lv_32fc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_8sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    lv_32fc_t tmp32_1, tmp32_2;
+    int n_vec;
+    unsigned int n;
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake(0,0);
+        }
+    for (n = 0; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * (*phase);
+
+            // Regenerate phase
+            if (n % 256 == 0)
+                {
+#ifdef __cplusplus
+                    (*phase) /= std::abs((*phase));
+#else
+                    (*phase) /= hypotf(lv_creal(*phase), lv_cimag(*phase));
+#endif
+                }
+
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    tmp32_2 = tmp32_1 * lv_cmake((float)lv_creal(in_a[n_vec][n]), (float)lv_cimag(in_a[n_vec][n]));
+                    result[n_vec] += tmp32_2;
+                }
+        }
+}
+
+#endif /*LV_HAVE_GENERIC*/
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn_u_sse4_1(lv_32fc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_8sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    lv_32fc_t dotProduct = lv_cmake(0,0);
+    lv_32fc_t tmp32_1, tmp32_2;
+    const unsigned int sse_iters = num_points / 8;
+    int n_vec;
+    int i;
+    int k;
+    unsigned int number;
+    unsigned int n;
+    const lv_8sc_t** _in_a = in_a;
+    const lv_8sc_t* _in_common = in_common;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t dotProductVector[2];
+
+    // The real and imaginary parts of the rotated samples are accumulated
+    // separately, so the complex product is completed only once at the end
+    __m128* acc = (__m128*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m128), volk_gnsssdr_get_alignment());
+
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm_setzero_ps();
+        }
+
+    // Each iteration takes 8 samples (16 bytes), converted to four registers
+    // of two float complex samples, each one with its own phase register
+    __m128i in8, code8;
+    __m128 a, tmp1, tmp1p, tmp2, tmp2p;
+    __m128 z[4], yl[4], yh[4], phase_acc_reg[4];
+
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t two_phase[2];
+    lv_32fc_t eight_phase_inc = phase_inc;
+    for (k = 0; k < 3; k++)
+        {
+            eight_phase_inc *= eight_phase_inc;
+        }
+    two_phase[0] = eight_phase_inc;
+    two_phase[1] = eight_phase_inc;
+    const __m128 eight_phase_inc_reg = _mm_load_ps((float*)two_phase);
+    const __m128 ylp = _mm_moveldup_ps(eight_phase_inc_reg);
+    const __m128 yhp = _mm_movehdup_ps(eight_phase_inc_reg);
+
+    two_phase[0] = _phase;
+    two_phase[1] = _phase * phase_inc;
+    const lv_32fc_t phase_inc2 = phase_inc * phase_inc;
+    for (k = 0; k < 4; k++)
+        {
+            phase_acc_reg[k] = _mm_load_ps((float*)two_phase);
+            two_phase[0] *= phase_inc2;
+            two_phase[1] *= phase_inc2;
+        }
+
+    for(number = 0; number < sse_iters; number++)
+        {
+            // Phase rotation on operand in_common starts here:
+            in8 = _mm_loadu_si128((__m128i*)_in_common);
+            for (k = 0; k < 4; k++)
+                {
+                    a = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(in8));
+                    in8 = _mm_srli_si128(in8, 4);
+                    yl[k] = _mm_moveldup_ps(phase_acc_reg[k]); // Load yl with cr,cr,dr,dr
+                    yh[k] = _mm_movehdup_ps(phase_acc_reg[k]);
+                    tmp1 = _mm_mul_ps(a, yl[k]);
+                    tmp1p = _mm_mul_ps(phase_acc_reg[k], ylp);
+                    a = _mm_shuffle_ps(a, a, 0xB1);
+                    phase_acc_reg[k] = _mm_shuffle_ps(phase_acc_reg[k], phase_acc_reg[k], 0xB1);
+                    tmp2 = _mm_mul_ps(a, yh[k]);
+                    tmp2p = _mm_mul_ps(phase_acc_reg[k], yhp);
+                    z[k] = _mm_addsub_ps(tmp1, tmp2);
+                    phase_acc_reg[k] = _mm_addsub_ps(tmp1p, tmp2p);
+
+                    yl[k] = _mm_moveldup_ps(z[k]); // Load yl with cr,cr,dr,dr
+                    yh[k] = _mm_movehdup_ps(z[k]);
+                }
+
+            //next eight samples
+            _in_common += 8;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code8 = _mm_loadu_si128((__m128i*)&(_in_a[n_vec][number * 8]));
+                    for (k = 0; k < 4; k++)
+                        {
+                            a = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(code8));
+                            code8 = _mm_srli_si128(code8, 4);
+                            acc[2 * n_vec] = _mm_add_ps(acc[2 * n_vec], _mm_mul_ps(a, yl[k]));
+                            acc[2 * n_vec + 1] = _mm_add_ps(acc[2 * n_vec + 1], _mm_mul_ps(a, yh[k]));
+                        }
+                }
+            // Regenerate phase
+            if ((number % 32) == 0)
+                {
+                    for (k = 0; k < 4; k++)
+                        {
+                            tmp1 = _mm_mul_ps(phase_acc_reg[k], phase_acc_reg[k]);
+                            tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                            tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                            tmp2 = _mm_sqrt_ps(tmp1);
+                            phase_acc_reg[k] = _mm_div_ps(phase_acc_reg[k], tmp2);
+                        }
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            tmp2 = _mm_shuffle_ps(acc[2 * n_vec + 1], acc[2 * n_vec + 1], 0xB1);
+            tmp1 = _mm_addsub_ps(acc[2 * n_vec], tmp2);
+            _mm_store_ps((float*)dotProductVector, tmp1); // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0,0);
+            for (i = 0; i < 2; ++i)
+                {
+                    dotProduct = dotProduct + dotProductVector[i];
+                }
+            result[n_vec] = dotProduct;
+        }
+    volk_gnsssdr_free(acc);
+
+    _mm_store_ps((float*)two_phase, phase_acc_reg[0]);
+    _phase = two_phase[0];
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    for(n = sse_iters * 8; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    tmp32_2 = tmp32_1 * lv_cmake((float)lv_creal(_in_a[n_vec][n]), (float)lv_cimag(_in_a[n_vec][n]));
+                    result[n_vec] += tmp32_2;
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn_a_sse4_1(lv_32fc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_8sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    lv_32fc_t dotProduct = lv_cmake(0,0);
+    lv_32fc_t tmp32_1, tmp32_2;
+    const unsigned int sse_iters = num_points / 8;
+    int n_vec;
+    int i;
+    int k;
+    unsigned int number;
+    unsigned int n;
+    const lv_8sc_t** _in_a = in_a;
+    const lv_8sc_t* _in_common = in_common;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t dotProductVector[2];
+
+    // The real and imaginary parts of the rotated samples are accumulated
+    // separately, so the complex product is completed only once at the end
+    __m128* acc = (__m128*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m128), volk_gnsssdr_get_alignment());
+
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm_setzero_ps();
+        }
+
+    // Each iteration takes 8 samples (16 bytes), converted to four registers
+    // of two float complex samples, each one with its own phase register
+    __m128i in8, code8;
+    __m128 a, tmp1, tmp1p, tmp2, tmp2p;
+    __m128 z[4], yl[4], yh[4], phase_acc_reg[4];
+
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t two_phase[2];
+    lv_32fc_t eight_phase_inc = phase_inc;
+    for (k = 0; k < 3; k++)
+        {
+            eight_phase_inc *= eight_phase_inc;
+        }
+    two_phase[0] = eight_phase_inc;
+    two_phase[1] = eight_phase_inc;
+    const __m128 eight_phase_inc_reg = _mm_load_ps((float*)two_phase);
+    const __m128 ylp = _mm_moveldup_ps(eight_phase_inc_reg);
+    const __m128 yhp = _mm_movehdup_ps(eight_phase_inc_reg);
+
+    two_phase[0] = _phase;
+    two_phase[1] = _phase * phase_inc;
+    const lv_32fc_t phase_inc2 = phase_inc * phase_inc;
+    for (k = 0; k < 4; k++)
+        {
+            phase_acc_reg[k] = _mm_load_ps((float*)two_phase);
+            two_phase[0] *= phase_inc2;
+            two_phase[1] *= phase_inc2;
+        }
+
+    for(number = 0; number < sse_iters; number++)
+        {
+            // Phase rotation on operand in_common starts here:
+            in8 = _mm_load_si128((__m128i*)_in_common);
+            for (k = 0; k < 4; k++)
+                {
+                    a = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(in8));
+                    in8 = _mm_srli_si128(in8, 4);
+                    yl[k] = _mm_moveldup_ps(phase_acc_reg[k]); // Load yl with cr,cr,dr,dr
+                    yh[k] = _mm_movehdup_ps(phase_acc_reg[k]);
+                    tmp1 = _mm_mul_ps(a, yl[k]);
+                    tmp1p = _mm_mul_ps(phase_acc_reg[k], ylp);
+                    a = _mm_shuffle_ps(a, a, 0xB1);
+                    phase_acc_reg[k] = _mm_shuffle_ps(phase_acc_reg[k], phase_acc_reg[k], 0xB1);
+                    tmp2 = _mm_mul_ps(a, yh[k]);
+                    tmp2p = _mm_mul_ps(phase_acc_reg[k], yhp);
+                    z[k] = _mm_addsub_ps(tmp1, tmp2);
+                    phase_acc_reg[k] = _mm_addsub_ps(tmp1p, tmp2p);
+
+                    yl[k] = _mm_moveldup_ps(z[k]); // Load yl with cr,cr,dr,dr
+                    yh[k] = _mm_movehdup_ps(z[k]);
+                }
+
+            //next eight samples
+            _in_common += 8;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code8 = _mm_load_si128((__m128i*)&(_in_a[n_vec][number * 8]));
+                    for (k = 0; k < 4; k++)
+                        {
+                            a = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(code8));
+                            code8 = _mm_srli_si128(code8, 4);
+                            acc[2 * n_vec] = _mm_add_ps(acc[2 * n_vec], _mm_mul_ps(a, yl[k]));
+                            acc[2 * n_vec + 1] = _mm_add_ps(acc[2 * n_vec + 1], _mm_mul_ps(a, yh[k]));
+                        }
+                }
+            // Regenerate phase
+            if ((number % 32) == 0)
+                {
+                    for (k = 0; k < 4; k++)
+                        {
+                            tmp1 = _mm_mul_ps(phase_acc_reg[k], phase_acc_reg[k]);
+                            tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                            tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                            tmp2 = _mm_sqrt_ps(tmp1);
+                            phase_acc_reg[k] = _mm_div_ps(phase_acc_reg[k], tmp2);
+                        }
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            tmp2 = _mm_shuffle_ps(acc[2 * n_vec + 1], acc[2 * n_vec + 1], 0xB1);
+            tmp1 = _mm_addsub_ps(acc[2 * n_vec], tmp2);
+            _mm_store_ps((float*)dotProductVector, tmp1); // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0,0);
+            for (i = 0; i < 2; ++i)
+                {
+                    dotProduct = dotProduct + dotProductVector[i];
+                }
+            result[n_vec] = dotProduct;
+        }
+    volk_gnsssdr_free(acc);
+
+    _mm_store_ps((float*)two_phase, phase_acc_reg[0]);
+    _phase = two_phase[0];
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    for(n = sse_iters * 8; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    tmp32_2 = tmp32_1 * lv_cmake((float)lv_creal(_in_a[n_vec][n]), (float)lv_cimag(_in_a[n_vec][n]));
+                    result[n_vec] += tmp32_2;
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn_u_avx2(lv_32fc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_8sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    lv_32fc_t dotProduct = lv_cmake(0,0);
+    lv_32fc_t tmp32_1, tmp32_2;
+    const unsigned int avx_iters = num_points / 16;
+    int n_vec;
+    int i;
+    int k;
+    unsigned int number;
+    unsigned int n;
+    const lv_8sc_t** _in_a = in_a;
+    const lv_8sc_t* _in_common = in_common;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t dotProductVector[4];
+
+    // The real and imaginary parts of the rotated samples are accumulated
+    // separately, so the complex product is completed only once at the end
+    __m256* acc = (__m256*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m256), volk_gnsssdr_get_alignment());
+
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm256_setzero_ps();
+        }
+
+    // Each iteration takes 16 samples (32 bytes), converted to four registers
+    // of four float complex samples, each one with its own phase register
+    __m128i in8[2], code8[2];
+    __m256 a, tmp1, tmp1p, tmp2, tmp2p;
+    __m256 z[4], yl[4], yh[4], phase_acc_reg[4];
+
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t four_phase[4];
+    lv_32fc_t sixteen_phase_inc = phase_inc;
+    for (k = 0; k < 4; k++)
+        {
+            sixteen_phase_inc *= sixteen_phase_inc;
+        }
+    for (k = 0; k < 4; k++)
+        {
+            four_phase[k] = sixteen_phase_inc;
+        }
+    const __m256 sixteen_phase_inc_reg = _mm256_load_ps((float*)four_phase);
+    const __m256 ylp = _mm256_moveldup_ps(sixteen_phase_inc_reg);
+    const __m256 yhp = _mm256_movehdup_ps(sixteen_phase_inc_reg);
+
+    four_phase[0] = _phase;
+    for (k = 1; k < 4; k++)
+        {
+            four_phase[k] = four_phase[k - 1] * phase_inc;
+        }
+    const lv_32fc_t phase_inc2 = phase_inc * phase_inc;
+    const lv_32fc_t phase_inc4 = phase_inc2 * phase_inc2;
+    for (k = 0; k < 4; k++)
+        {
+            phase_acc_reg[k] = _mm256_load_ps((float*)four_phase);
+            for (i = 0; i < 4; i++)
+                {
+                    four_phase[i] *= phase_inc4;
+                }
+        }
+
+    for(number = 0; number < avx_iters; number++)
+        {
+            // Phase rotation on operand in_common starts here:
+            in8[0] = _mm_loadu_si128((__m128i*)_in_common);
+            in8[1] = _mm_loadu_si128((__m128i*)(_in_common + 8));
+            for (k = 0; k < 4; k++)
+                {
+                    a = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(in8[k / 2]));
+                    in8[k / 2] = _mm_srli_si128(in8[k / 2], 8);
+                    yl[k] = _mm256_moveldup_ps(phase_acc_reg[k]); // Load yl with cr,cr,dr,dr
+                    yh[k] = _mm256_movehdup_ps(phase_acc_reg[k]);
+                    tmp1 = _mm256_mul_ps(a, yl[k]);
+                    tmp1p = _mm256_mul_ps(phase_acc_reg[k], ylp);
+                    a = _mm256_shuffle_ps(a, a, 0xB1);
+                    phase_acc_reg[k] = _mm256_shuffle_ps(phase_acc_reg[k], phase_acc_reg[k], 0xB1);
+                    tmp2 = _mm256_mul_ps(a, yh[k]);
+                    tmp2p = _mm256_mul_ps(phase_acc_reg[k], yhp);
+                    z[k] = _mm256_addsub_ps(tmp1, tmp2);
+                    phase_acc_reg[k] = _mm256_addsub_ps(tmp1p, tmp2p);
+
+                    yl[k] = _mm256_moveldup_ps(z[k]); // Load yl with cr,cr,dr,dr
+                    yh[k] = _mm256_movehdup_ps(z[k]);
+                }
+
+            //next sixteen samples
+            _in_common += 16;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code8[0] = _mm_loadu_si128((__m128i*)&(_in_a[n_vec][number * 16]));
+                    code8[1] = _mm_loadu_si128((__m128i*)&(_in_a[n_vec][number * 16 + 8]));
+                    for (k = 0; k < 4; k++)
+                        {
+                            a = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(code8[k / 2]));
+                            code8[k / 2] = _mm_srli_si128(code8[k / 2], 8);
+                            acc[2 * n_vec] = _mm256_add_ps(acc[2 * n_vec], _mm256_mul_ps(a, yl[k]));
+                            acc[2 * n_vec + 1] = _mm256_add_ps(acc[2 * n_vec + 1], _mm256_mul_ps(a, yh[k]));
+                        }
+                }
+            // Regenerate phase
+            if ((number % 32) == 0)
+                {
+                    for (k = 0; k < 4; k++)
+                        {
+                            tmp1 = _mm256_mul_ps(phase_acc_reg[k], phase_acc_reg[k]);
+                            tmp2 = _mm256_hadd_ps(tmp1, tmp1);
+                            tmp1 = _mm256_shuffle_ps(tmp2, tmp2, 0xD8);
+                            tmp2 = _mm256_sqrt_ps(tmp1);
+                            phase_acc_reg[k] = _mm256_div_ps(phase_acc_reg[k], tmp2);
+                        }
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            tmp2 = _mm256_shuffle_ps(acc[2 * n_vec + 1], acc[2 * n_vec + 1], 0xB1);
+            tmp1 = _mm256_addsub_ps(acc[2 * n_vec], tmp2);
+            _mm256_store_ps((float*)dotProductVector, tmp1); // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0,0);
+            for (i = 0; i < 4; ++i)
+                {
+                    dotProduct = dotProduct + dotProductVector[i];
+                }
+            result[n_vec] = dotProduct;
+        }
+    volk_gnsssdr_free(acc);
+
+    _mm256_store_ps((float*)four_phase, phase_acc_reg[0]);
+    _phase = four_phase[0];
+    _mm256_zeroupper();
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    for(n = avx_iters * 16; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    tmp32_2 = tmp32_1 * lv_cmake((float)lv_creal(_in_a[n_vec][n]), (float)lv_cimag(_in_a[n_vec][n]));
+                    result[n_vec] += tmp32_2;
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_AVX2
+
+static inline void volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn_a_avx2(lv_32fc_t* result, const lv_8sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const lv_8sc_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    lv_32fc_t dotProduct = lv_cmake(0,0);
+    lv_32fc_t tmp32_1, tmp32_2;
+    const unsigned int avx_iters = num_points / 16;
+    int n_vec;
+    int i;
+    int k;
+    unsigned int number;
+    unsigned int n;
+    const lv_8sc_t** _in_a = in_a;
+    const lv_8sc_t* _in_common = in_common;
+    lv_32fc_t _phase = (*phase);
+
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t dotProductVector[4];
+
+    // The real and imaginary parts of the rotated samples are accumulated
+    // separately, so the complex product is completed only once at the end
+    __m256* acc = (__m256*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m256), volk_gnsssdr_get_alignment());
+
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm256_setzero_ps();
+        }
+
+    // Each iteration takes 16 samples (32 bytes), converted to four registers
+    // of four float complex samples, each one with its own phase register
+    __m128i in8[2], code8[2];
+    __m256 a, tmp1, tmp1p, tmp2, tmp2p;
+    __m256 z[4], yl[4], yh[4], phase_acc_reg[4];
+
+    __VOLK_ATTR_ALIGNED(32) lv_32fc_t four_phase[4];
+    lv_32fc_t sixteen_phase_inc = phase_inc;
+    for (k = 0; k < 4; k++)
+        {
+            sixteen_phase_inc *= sixteen_phase_inc;
+        }
+    for (k = 0; k < 4; k++)
+        {
+            four_phase[k] = sixteen_phase_inc;
+        }
+    const __m256 sixteen_phase_inc_reg = _mm256_load_ps((float*)four_phase);
+    const __m256 ylp = _mm256_moveldup_ps(sixteen_phase_inc_reg);
+    const __m256 yhp = _mm256_movehdup_ps(sixteen_phase_inc_reg);
+
+    four_phase[0] = _phase;
+    for (k = 1; k < 4; k++)
+        {
+            four_phase[k] = four_phase[k - 1] * phase_inc;
+        }
+    const lv_32fc_t phase_inc2 = phase_inc * phase_inc;
+    const lv_32fc_t phase_inc4 = phase_inc2 * phase_inc2;
+    for (k = 0; k < 4; k++)
+        {
+            phase_acc_reg[k] = _mm256_load_ps((float*)four_phase);
+            for (i = 0; i < 4; i++)
+                {
+                    four_phase[i] *= phase_inc4;
+                }
+        }
+
+    for(number = 0; number < avx_iters; number++)
+        {
+            // Phase rotation on operand in_common starts here:
+            in8[0] = _mm_load_si128((__m128i*)_in_common);
+            in8[1] = _mm_load_si128((__m128i*)(_in_common + 8));
+            for (k = 0; k < 4; k++)
+                {
+                    a = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(in8[k / 2]));
+                    in8[k / 2] = _mm_srli_si128(in8[k / 2], 8);
+                    yl[k] = _mm256_moveldup_ps(phase_acc_reg[k]); // Load yl with cr,cr,dr,dr
+                    yh[k] = _mm256_movehdup_ps(phase_acc_reg[k]);
+                    tmp1 = _mm256_mul_ps(a, yl[k]);
+                    tmp1p = _mm256_mul_ps(phase_acc_reg[k], ylp);
+                    a = _mm256_shuffle_ps(a, a, 0xB1);
+                    phase_acc_reg[k] = _mm256_shuffle_ps(phase_acc_reg[k], phase_acc_reg[k], 0xB1);
+                    tmp2 = _mm256_mul_ps(a, yh[k]);
+                    tmp2p = _mm256_mul_ps(phase_acc_reg[k], yhp);
+                    z[k] = _mm256_addsub_ps(tmp1, tmp2);
+                    phase_acc_reg[k] = _mm256_addsub_ps(tmp1p, tmp2p);
+
+                    yl[k] = _mm256_moveldup_ps(z[k]); // Load yl with cr,cr,dr,dr
+                    yh[k] = _mm256_movehdup_ps(z[k]);
+                }
+
+            //next sixteen samples
+            _in_common += 16;
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code8[0] = _mm_load_si128((__m128i*)&(_in_a[n_vec][number * 16]));
+                    code8[1] = _mm_load_si128((__m128i*)&(_in_a[n_vec][number * 16 + 8]));
+                    for (k = 0; k < 4; k++)
+                        {
+                            a = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(code8[k / 2]));
+                            code8[k / 2] = _mm_srli_si128(code8[k / 2], 8);
+                            acc[2 * n_vec] = _mm256_add_ps(acc[2 * n_vec], _mm256_mul_ps(a, yl[k]));
+                            acc[2 * n_vec + 1] = _mm256_add_ps(acc[2 * n_vec + 1], _mm256_mul_ps(a, yh[k]));
+                        }
+                }
+            // Regenerate phase
+            if ((number % 32) == 0)
+                {
+                    for (k = 0; k < 4; k++)
+                        {
+                            tmp1 = _mm256_mul_ps(phase_acc_reg[k], phase_acc_reg[k]);
+                            tmp2 = _mm256_hadd_ps(tmp1, tmp1);
+                            tmp1 = _mm256_shuffle_ps(tmp2, tmp2, 0xD8);
+                            tmp2 = _mm256_sqrt_ps(tmp1);
+                            phase_acc_reg[k] = _mm256_div_ps(phase_acc_reg[k], tmp2);
+                        }
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            tmp2 = _mm256_shuffle_ps(acc[2 * n_vec + 1], acc[2 * n_vec + 1], 0xB1);
+            tmp1 = _mm256_addsub_ps(acc[2 * n_vec], tmp2);
+            _mm256_store_ps((float*)dotProductVector, tmp1); // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0,0);
+            for (i = 0; i < 4; ++i)
+                {
+                    dotProduct = dotProduct + dotProductVector[i];
+                }
+            result[n_vec] = dotProduct;
+        }
+    volk_gnsssdr_free(acc);
+
+    _mm256_store_ps((float*)four_phase, phase_acc_reg[0]);
+    _phase = four_phase[0];
+    _mm256_zeroupper();
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    for(n = avx_iters * 16; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    tmp32_2 = tmp32_1 * lv_cmake((float)lv_creal(_in_a[n_vec][n]), (float)lv_cimag(_in_a[n_vec][n]));
+                    result[n_vec] += tmp32_2;
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_gnsssdr_8ic_x2_rotator_dot_prod_32fc_xn_H */
@@ -773,6 +773,274 @@ static inline void volk_gnsssdr_s32f_sincos_32fc_u_avx2(lv_32fc_t* out, const fl
 #endif /* LV_HAVE_AVX2  */
 
 
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+/* Based on algorithms from the cephes library http://www.netlib.org/cephes/
+ * Adapted to AVX-512F from the AVX2 implementation */
+static inline void volk_gnsssdr_s32f_sincos_32fc_a_avx512f(lv_32fc_t* out, const float phase_inc, float* phase, unsigned int num_points)
+{
+    lv_32fc_t* bPtr = out;
+
+    const unsigned int avx512_iters = num_points / 16;
+    unsigned int number = 0;
+    unsigned int k;
+
+    float _phase = (*phase);
+
+    __m512 sine, cosine, x, sixteen_phases_reg, y, y2, z, lo, hi;
+    __m512i emm0, emm2, emm4, sign_bit_sin, sign_bit_cos;
+    __mmask16 poly_mask;
+
+    /* declare some AVX-512 constants */
+    const __m512i inv_sign_mask = _mm512_set1_epi32(~0x80000000);
+    const __m512i sign_mask = _mm512_set1_epi32((int)0x80000000);
+    const __m512 cephes_FOPI = _mm512_set1_ps(1.27323954473516);
+    const __m512i pi32_1 = _mm512_set1_epi32(1);
+    const __m512i pi32_inv1 = _mm512_set1_epi32(~1);
+    const __m512i pi32_2 = _mm512_set1_epi32(2);
+    const __m512i pi32_4 = _mm512_set1_epi32(4);
+    const __m512 minus_cephes_DP1 = _mm512_set1_ps(-0.78515625);
+    const __m512 minus_cephes_DP2 = _mm512_set1_ps(-2.4187564849853515625e-4);
+    const __m512 minus_cephes_DP3 = _mm512_set1_ps(-3.77489497744594108e-8);
+    const __m512 coscof_p0 = _mm512_set1_ps(2.443315711809948E-005);
+    const __m512 coscof_p1 = _mm512_set1_ps(-1.388731625493765E-003);
+    const __m512 coscof_p2 = _mm512_set1_ps(4.166664568298827E-002);
+    const __m512 sincof_p0 = _mm512_set1_ps(-1.9515295891E-4);
+    const __m512 sincof_p1 = _mm512_set1_ps(8.3321608736E-3);
+    const __m512 sincof_p2 = _mm512_set1_ps(-1.6666654611E-1);
+    const __m512 ps_0p5 = _mm512_set1_ps(0.5f);
+    const __m512 ps_1 = _mm512_set1_ps(1.0f);
+
+    /* 128 bit lanes of the (cos, sin) pairs, in output order */
+    const __m512i first_half = _mm512_set_epi32(23, 22, 21, 20, 7, 6, 5, 4, 19, 18, 17, 16, 3, 2, 1, 0);
+    const __m512i second_half = _mm512_set_epi32(31, 30, 29, 28, 15, 14, 13, 12, 27, 26, 25, 24, 11, 10, 9, 8);
+
+    __VOLK_ATTR_ALIGNED(64) float sixteen_phases[16];
+    for (k = 0; k < 16; k++)
+        {
+            sixteen_phases[k] = _phase + k * phase_inc;
+        }
+    sixteen_phases_reg = _mm512_load_ps(sixteen_phases);
+    const __m512 sixteen_phases_inc_reg = _mm512_set1_ps(16 * phase_inc);
+
+    for(;number < avx512_iters; number++)
+        {
+            /* take the absolute value */
+            x = _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(sixteen_phases_reg), inv_sign_mask));
+            /* extract the sign bit (upper one) */
+            sign_bit_sin = _mm512_and_si512(_mm512_castps_si512(sixteen_phases_reg), sign_mask);
+
+            /* scale by 4/Pi */
+            y = _mm512_mul_ps(x, cephes_FOPI);
+
+            /* store the integer part of y in emm2 */
+            emm2 = _mm512_cvttps_epi32(y);
+
+            /* j=(j+1) & (~1) (see the cephes sources) */
+            emm2 = _mm512_add_epi32(emm2, pi32_1);
+            emm2 = _mm512_and_si512(emm2, pi32_inv1);
+            y = _mm512_cvtepi32_ps(emm2);
+
+            emm4 = emm2;
+
+            /* get the swap sign flag for the sine */
+            emm0 = _mm512_and_si512(emm2, pi32_4);
+            emm0 = _mm512_slli_epi32(emm0, 29);
+
+            /* get the polynom selection mask for the sine */
+            poly_mask = _mm512_testn_epi32_mask(emm2, pi32_2);
+
+            /* The magic pass: "Extended precision modular arithmetic"
+               x = ((x - y * DP1) - y * DP2) - y * DP3; */
+            x = _mm512_fmadd_ps(y, minus_cephes_DP1, x);
+            x = _mm512_fmadd_ps(y, minus_cephes_DP2, x);
+            x = _mm512_fmadd_ps(y, minus_cephes_DP3, x);
+
+            emm4 = _mm512_sub_epi32(emm4, pi32_2);
+            emm4 = _mm512_andnot_si512(emm4, pi32_4);
+            sign_bit_cos = _mm512_slli_epi32(emm4, 29);
+
+            sign_bit_sin = _mm512_xor_si512(sign_bit_sin, emm0);
+
+            /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+            z = _mm512_mul_ps(x, x);
+            y = _mm512_fmadd_ps(coscof_p0, z, coscof_p1);
+            y = _mm512_fmadd_ps(y, z, coscof_p2);
+            y = _mm512_mul_ps(y, z);
+            y = _mm512_mul_ps(y, z);
+            y = _mm512_fnmadd_ps(z, ps_0p5, y);
+            y = _mm512_add_ps(y, ps_1);
+
+            /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+            y2 = _mm512_fmadd_ps(sincof_p0, z, sincof_p1);
+            y2 = _mm512_fmadd_ps(y2, z, sincof_p2);
+            y2 = _mm512_mul_ps(y2, z);
+            y2 = _mm512_fmadd_ps(y2, x, x);
+
+            /* select the correct result from the two polynoms */
+            sine = _mm512_mask_blend_ps(poly_mask, y, y2);
+            cosine = _mm512_mask_blend_ps(poly_mask, y2, y);
+
+            /* update the sign */
+            sine = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(sine), sign_bit_sin));
+            cosine = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(cosine), sign_bit_cos));
+
+            /* write the output */
+            lo = _mm512_unpacklo_ps(cosine, sine);
+            hi = _mm512_unpackhi_ps(cosine, sine);
+            _mm512_store_ps((float*)bPtr, _mm512_permutex2var_ps(lo, first_half, hi));
+            bPtr += 8;
+            _mm512_store_ps((float*)bPtr, _mm512_permutex2var_ps(lo, second_half, hi));
+            bPtr += 8;
+
+            sixteen_phases_reg = _mm512_add_ps(sixteen_phases_reg, sixteen_phases_inc_reg);
+        }
+    _mm256_zeroupper();
+    _phase = _phase + phase_inc * (avx512_iters * 16);
+    for(number = avx512_iters * 16; number < num_points; number++)
+        {
+            out[number] = lv_cmake((float)cos(_phase), (float)sin(_phase) );
+            _phase += phase_inc;
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_AVX512F  */
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+/* Based on algorithms from the cephes library http://www.netlib.org/cephes/
+ * Adapted to AVX-512F from the AVX2 implementation */
+static inline void volk_gnsssdr_s32f_sincos_32fc_u_avx512f(lv_32fc_t* out, const float phase_inc, float* phase, unsigned int num_points)
+{
+    lv_32fc_t* bPtr = out;
+
+    const unsigned int avx512_iters = num_points / 16;
+    unsigned int number = 0;
+    unsigned int k;
+
+    float _phase = (*phase);
+
+    __m512 sine, cosine, x, sixteen_phases_reg, y, y2, z, lo, hi;
+    __m512i emm0, emm2, emm4, sign_bit_sin, sign_bit_cos;
+    __mmask16 poly_mask;
+
+    /* declare some AVX-512 constants */
+    const __m512i inv_sign_mask = _mm512_set1_epi32(~0x80000000);
+    const __m512i sign_mask = _mm512_set1_epi32((int)0x80000000);
+    const __m512 cephes_FOPI = _mm512_set1_ps(1.27323954473516);
+    const __m512i pi32_1 = _mm512_set1_epi32(1);
+    const __m512i pi32_inv1 = _mm512_set1_epi32(~1);
+    const __m512i pi32_2 = _mm512_set1_epi32(2);
+    const __m512i pi32_4 = _mm512_set1_epi32(4);
+    const __m512 minus_cephes_DP1 = _mm512_set1_ps(-0.78515625);
+    const __m512 minus_cephes_DP2 = _mm512_set1_ps(-2.4187564849853515625e-4);
+    const __m512 minus_cephes_DP3 = _mm512_set1_ps(-3.77489497744594108e-8);
+    const __m512 coscof_p0 = _mm512_set1_ps(2.443315711809948E-005);
+    const __m512 coscof_p1 = _mm512_set1_ps(-1.388731625493765E-003);
+    const __m512 coscof_p2 = _mm512_set1_ps(4.166664568298827E-002);
+    const __m512 sincof_p0 = _mm512_set1_ps(-1.9515295891E-4);
+    const __m512 sincof_p1 = _mm512_set1_ps(8.3321608736E-3);
+    const __m512 sincof_p2 = _mm512_set1_ps(-1.6666654611E-1);
+    const __m512 ps_0p5 = _mm512_set1_ps(0.5f);
+    const __m512 ps_1 = _mm512_set1_ps(1.0f);
+
+    /* 128 bit lanes of the (cos, sin) pairs, in output order */
+    const __m512i first_half = _mm512_set_epi32(23, 22, 21, 20, 7, 6, 5, 4, 19, 18, 17, 16, 3, 2, 1, 0);
+    const __m512i second_half = _mm512_set_epi32(31, 30, 29, 28, 15, 14, 13, 12, 27, 26, 25, 24, 11, 10, 9, 8);
+
+    __VOLK_ATTR_ALIGNED(64) float sixteen_phases[16];
+    for (k = 0; k < 16; k++)
+        {
+            sixteen_phases[k] = _phase + k * phase_inc;
+        }
+    sixteen_phases_reg = _mm512_load_ps(sixteen_phases);
+    const __m512 sixteen_phases_inc_reg = _mm512_set1_ps(16 * phase_inc);
+
+    for(;number < avx512_iters; number++)
+        {
+            /* take the absolute value */
+            x = _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(sixteen_phases_reg), inv_sign_mask));
+            /* extract the sign bit (upper one) */
+            sign_bit_sin = _mm512_and_si512(_mm512_castps_si512(sixteen_phases_reg), sign_mask);
+
+            /* scale by 4/Pi */
+            y = _mm512_mul_ps(x, cephes_FOPI);
+
+            /* store the integer part of y in emm2 */
+            emm2 = _mm512_cvttps_epi32(y);
+
+            /* j=(j+1) & (~1) (see the cephes sources) */
+            emm2 = _mm512_add_epi32(emm2, pi32_1);
+            emm2 = _mm512_and_si512(emm2, pi32_inv1);
+            y = _mm512_cvtepi32_ps(emm2);
+
+            emm4 = emm2;
+
+            /* get the swap sign flag for the sine */
+            emm0 = _mm512_and_si512(emm2, pi32_4);
+            emm0 = _mm512_slli_epi32(emm0, 29);
+
+            /* get the polynom selection mask for the sine */
+            poly_mask = _mm512_testn_epi32_mask(emm2, pi32_2);
+
+            /* The magic pass: "Extended precision modular arithmetic"
+               x = ((x - y * DP1) - y * DP2) - y * DP3; */
+            x = _mm512_fmadd_ps(y, minus_cephes_DP1, x);
+            x = _mm512_fmadd_ps(y, minus_cephes_DP2, x);
+            x = _mm512_fmadd_ps(y, minus_cephes_DP3, x);
+
+            emm4 = _mm512_sub_epi32(emm4, pi32_2);
+            emm4 = _mm512_andnot_si512(emm4, pi32_4);
+            sign_bit_cos = _mm512_slli_epi32(emm4, 29);
+
+            sign_bit_sin = _mm512_xor_si512(sign_bit_sin, emm0);
+
+            /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+            z = _mm512_mul_ps(x, x);
+            y = _mm512_fmadd_ps(coscof_p0, z, coscof_p1);
+            y = _mm512_fmadd_ps(y, z, coscof_p2);
+            y = _mm512_mul_ps(y, z);
+            y = _mm512_mul_ps(y, z);
+            y = _mm512_fnmadd_ps(z, ps_0p5, y);
+            y = _mm512_add_ps(y, ps_1);
+
+            /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+            y2 = _mm512_fmadd_ps(sincof_p0, z, sincof_p1);
+            y2 = _mm512_fmadd_ps(y2, z, sincof_p2);
+            y2 = _mm512_mul_ps(y2, z);
+            y2 = _mm512_fmadd_ps(y2, x, x);
+
+            /* select the correct result from the two polynoms */
+            sine = _mm512_mask_blend_ps(poly_mask, y, y2);
+            cosine = _mm512_mask_blend_ps(poly_mask, y2, y);
+
+            /* update the sign */
+            sine = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(sine), sign_bit_sin));
+            cosine = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(cosine), sign_bit_cos));
+
+            /* write the output */
+            lo = _mm512_unpacklo_ps(cosine, sine);
+            hi = _mm512_unpackhi_ps(cosine, sine);
+            _mm512_storeu_ps((float*)bPtr, _mm512_permutex2var_ps(lo, first_half, hi));
+            bPtr += 8;
+            _mm512_storeu_ps((float*)bPtr, _mm512_permutex2var_ps(lo, second_half, hi));
+            bPtr += 8;
+
+            sixteen_phases_reg = _mm512_add_ps(sixteen_phases_reg, sixteen_phases_inc_reg);
+        }
+    _mm256_zeroupper();
+    _phase = _phase + phase_inc * (avx512_iters * 16);
+    for(number = avx512_iters * 16; number < num_points; number++)
+        {
+            out[number] = lv_cmake((float)cos(_phase), (float)sin(_phase) );
+            _phase += phase_inc;
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_AVX512F  */
+
 #ifdef LV_HAVE_NEON
 #include <arm_neon.h>
 /* Adapted from http://gruntthepeon.free.fr/ssemath/neon_mathfun.h, original code from Julien Pommier  */
@@ -0,0 +1,108 @@
+/*!
+ * \file pfb_resampler_conditioner.h
+ * \brief Interface of an adapter of a polyphase filterbank resampler
+ * conditioner block to a SignalConditionerInterface
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_PFB_RESAMPLER_CONDITIONER_ADAPTER_H_
+#define GNSS_SDR_PFB_RESAMPLER_CONDITIONER_ADAPTER_H_
+
+#include <string>
+#include <gnuradio/hier_block2.h>
+#include "gnss_block_interface.h"
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Interface of an adapter of a polyphase filterbank resampler
+ * conditioner block to a SignalConditionerInterface
+ */
+class PfbResamplerConditioner: public GNSSBlockInterface
+{
+public:
+    PfbResamplerConditioner(ConfigurationInterface* configuration,
+            std::string role, unsigned int in_stream,
+            unsigned int out_stream);
+
+    virtual ~PfbResamplerConditioner();
+    std::string role()
+    {
+        return role_;
+    }
+    //! returns "Pfb_Resampler"
+    std::string implementation()
+    {
+        return "Pfb_Resampler";
+    }
+    size_t item_size()
+    {
+        return item_size_;
+    }
+    void connect(gr::top_block_sptr top_block);
+    void disconnect(gr::top_block_sptr top_block);
+    gr::basic_block_sptr get_left_block();
+    gr::basic_block_sptr get_right_block();
+
+    std::string item_type()
+    {
+        return item_type_;
+    }
+    double sample_freq_in()
+    {
+        return sample_freq_in_;
+    }
+    double sample_freq_out()
+    {
+        return sample_freq_out_;
+    }
+    float passband_ratio()
+    {
+        return passband_ratio_;
+    }
+    unsigned int taps_per_phase()
+    {
+        return taps_per_phase_;
+    }
+
+private:
+    std::string role_;
+    unsigned int in_stream_;
+    unsigned int out_stream_;
+    std::string item_type_;
+    size_t item_size_;
+    bool dump_;
+    std::string dump_filename_;
+    double sample_freq_in_;
+    double sample_freq_out_;
+    float passband_ratio_;
+    unsigned int taps_per_phase_;
+    gr::block_sptr resampler_;
+    gr::block_sptr file_sink_;
+};
+
+#endif /*GNSS_SDR_PFB_RESAMPLER_CONDITIONER_ADAPTER_H_*/
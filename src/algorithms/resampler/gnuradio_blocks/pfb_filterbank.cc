@@ -0,0 +1,160 @@
+/*!
+ * \file pfb_filterbank.cc
+ * \brief Bank of polyphase FIR filters for rational / arbitrary resampling
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "pfb_filterbank.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <gnuradio/math.h>
+#include <glog/logging.h>
+
+using google::LogMessage;
+
+// Maximum number of filters of the bank. Rational ratios L/M with L above
+// this value are implemented by interpolating between adjacent filters.
+#define PFB_FILTERBANK_MAX_FILTERS 128
+#define PFB_FILTERBANK_MIN_TAPS 8
+#define PFB_FILTERBANK_MAX_TAPS 256
+
+
+namespace
+{
+uint64_t pfb_gcd(uint64_t a, uint64_t b)
+{
+    while (b != 0)
+        {
+            uint64_t t = a % b;
+            a = b;
+            b = t;
+        }
+    return a;
+}
+}
+
+
+
+pfb_filterbank::pfb_filterbank(double sample_freq_in, double sample_freq_out,
+        float bandwidth, unsigned int taps_per_phase) :
+        d_sample_freq_in(sample_freq_in), d_sample_freq_out(sample_freq_out)
+{
+    // Express the resampling ratio as an irreducible fraction L/M (sampling frequencies rounded to 1 Hz)
+    uint64_t fs_in = static_cast<uint64_t>(std::round(sample_freq_in));
+    uint64_t fs_out = static_cast<uint64_t>(std::round(sample_freq_out));
+    uint64_t g = pfb_gcd(fs_in, fs_out);
+    d_interpolation = fs_out / g;
+    d_decimation = fs_in / g;
+
+    if (d_interpolation <= PFB_FILTERBANK_MAX_FILTERS)
+        {
+            d_nfilters = static_cast<unsigned int>(d_interpolation);
+            d_exact = true;
+        }
+    else
+        {
+            d_nfilters = PFB_FILTERBANK_MAX_FILTERS;
+            d_exact = false;
+        }
+    d_phase_scale = static_cast<double>(d_nfilters) / static_cast<double>(d_interpolation);
+
+    if ((bandwidth <= 0.0) || (bandwidth >= 1.0))
+        {
+            LOG(WARNING) << "Invalid resampler bandwidth " << bandwidth << ", using 0.8";
+            bandwidth = 0.8;
+        }
+    // Band edges normalized to the input sampling frequency. The smaller Nyquist band
+    // sets the cut-off, so this is both an anti-imaging and an anti-aliasing filter.
+    double f_min = std::min(d_sample_freq_in, d_sample_freq_out);
+    double f_stop = 0.5 * f_min / d_sample_freq_in;
+    double f_pass = bandwidth * f_stop;
+    double f_cut = 0.5 * (f_pass + f_stop);
+    double transition = f_stop - f_pass;
+
+    if (taps_per_phase == 0)
+        {
+            // Blackman-Harris main lobe: transition width of about 4 / N input samples
+            taps_per_phase = static_cast<unsigned int>(std::ceil(4.0 / transition));
+            taps_per_phase = std::max(taps_per_phase, static_cast<unsigned int>(PFB_FILTERBANK_MIN_TAPS));
+            taps_per_phase = std::min(taps_per_phase, static_cast<unsigned int>(PFB_FILTERBANK_MAX_TAPS));
+        }
+    // The filter must be longer than the decimation step, so the resampler never
+    // needs to skip input samples beyond the current window.
+    unsigned int min_taps = static_cast<unsigned int>((d_decimation + d_interpolation - 1) / d_interpolation) + 1;
+    d_ntaps = std::max(taps_per_phase, min_taps);
+
+    // Windowed-sinc prototype sampled at d_nfilters times the input rate
+    unsigned int prototype_length = d_nfilters * d_ntaps;
+    std::vector<double> prototype(prototype_length);
+    double center = static_cast<double>(prototype_length - 1) / 2.0;
+    double sum = 0.0;
+    for (unsigned int k = 0; k < prototype_length; k++)
+        {
+            double t = (static_cast<double>(k) - center) / static_cast<double>(d_nfilters);
+            double x = 2.0 * GR_M_PI * f_cut * t;
+            double sinc = (std::abs(x) < 1e-12) ? 1.0 : std::sin(x) / x;
+            double w = 1.0;
+            if (prototype_length > 1)
+                {
+                    double arg = 2.0 * GR_M_PI * static_cast<double>(k) / static_cast<double>(prototype_length - 1);
+                    w = 0.35875 - 0.48829 * std::cos(arg) + 0.14128 * std::cos(2.0 * arg) - 0.01168 * std::cos(3.0 * arg);
+                }
+            prototype[k] = 2.0 * f_cut * sinc * w;
+            sum += prototype[k];
+        }
+
+    // Unit DC gain for each branch of the bank
+    double gain = static_cast<double>(d_nfilters) / sum;
+
+    // Filter p, tap j is prototype[j * d_nfilters + p]. One extra filter
+    // (p = d_nfilters, equal to filter 0 advanced one sample) is appended to
+    // allow interpolation beyond the last phase. Taps are stored reversed so
+    // the oldest sample of the window multiplies the first stored tap.
+    d_taps = static_cast<float*>(volk_malloc((d_nfilters + 1) * d_ntaps * sizeof(float), volk_get_alignment()));
+    for (unsigned int p = 0; p <= d_nfilters; p++)
+        {
+            for (unsigned int j = 0; j < d_ntaps; j++)
+                {
+                    unsigned int k = j * d_nfilters + p;
+                    float tap = (k < prototype_length) ? static_cast<float>(prototype[k] * gain) : 0.0;
+                    d_taps[p * d_ntaps + (d_ntaps - 1 - j)] = tap;
+                }
+        }
+
+    LOG(INFO) << "Polyphase resampler from " << d_sample_freq_in << " to " << d_sample_freq_out
+              << " sps: L/M=" << d_interpolation << "/" << d_decimation
+              << ", " << d_nfilters << " filters of " << d_ntaps << " taps"
+              << (d_exact ? " (exact)" : " (interpolated)")
+              << ", cut-off " << f_cut * d_sample_freq_in << " Hz";
+}
+
+
+
+pfb_filterbank::~pfb_filterbank()
+{
+    volk_free(d_taps);
+}
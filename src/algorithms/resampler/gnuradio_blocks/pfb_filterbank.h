@@ -0,0 +1,144 @@
+/*!
+ * \file pfb_filterbank.h
+ * \brief Bank of polyphase FIR filters for rational / arbitrary resampling
+ *
+ * The filters are obtained from a Blackman-Harris windowed-sinc prototype.
+ * This class only holds the filter bank and the phase arithmetic, so it can be
+ * shared by the stand-alone resampler block and by other blocks that
+ * resample internally.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PFB_FILTERBANK_H
+#define GNSS_SDR_PFB_FILTERBANK_H
+
+#include <cstdint>
+#include <gnuradio/gr_complex.h>
+#include <volk/volk.h>
+
+
+/*!
+ * \brief Dot product between a window of input samples and a real filter.
+ *
+ * The generic version accumulates in floating point and is unrolled by the
+ * compiler across taps. The gr_complex version goes through VOLK.
+ */
+template <typename T>
+inline gr_complex pfb_dot_prod(const T* in, const float* taps, unsigned int ntaps)
+{
+    float acc_real = 0.0;
+    float acc_imag = 0.0;
+    for (unsigned int n = 0; n < ntaps; n++)
+        {
+            acc_real += static_cast<float>(in[n].real()) * taps[n];
+            acc_imag += static_cast<float>(in[n].imag()) * taps[n];
+        }
+    return gr_complex(acc_real, acc_imag);
+}
+
+
+template <>
+inline gr_complex pfb_dot_prod<gr_complex>(const gr_complex* in, const float* taps, unsigned int ntaps)
+{
+    gr_complex result;
+    volk_32fc_32f_dot_prod_32fc(&result, in, taps, ntaps);
+    return result;
+}
+
+
+/*!
+ * \brief Bank of polyphase filters that resamples from sample_freq_in to sample_freq_out
+ *
+ * The resampling ratio is reduced to an irreducible fraction L/M. The position of the
+ * next output sample is kept as an integer accumulator in units of 1/L input samples,
+ * so the resampler never drifts. If L is small enough there is one filter per output
+ * phase (exact resampling); otherwise the output is linearly interpolated between
+ * the two closest filters of the bank.
+ */
+class pfb_filterbank
+{
+public:
+    /*!
+     * \param[in] bandwidth Fraction (0, 1) of the smaller Nyquist band kept in the passband
+     * \param[in] taps_per_phase Number of taps of each polyphase filter (0 for automatic)
+     */
+    pfb_filterbank(double sample_freq_in, double sample_freq_out,
+            float bandwidth, unsigned int taps_per_phase);
+    ~pfb_filterbank();
+
+    uint64_t interpolation() const { return d_interpolation; }
+    uint64_t decimation() const { return d_decimation; }
+    unsigned int nfilters() const { return d_nfilters; }
+    unsigned int ntaps() const { return d_ntaps; }
+    bool exact() const { return d_exact; }
+
+    /*!
+     * \brief Computes the output sample at fractional position acc / L within
+     * the window in[0] ... in[ntaps() - 1] (in[0] is the oldest sample)
+     */
+    template <typename T>
+    gr_complex filter(const T* in, uint64_t acc) const
+    {
+        if (d_exact)
+            {
+                return pfb_dot_prod<T>(in, d_taps + acc * d_ntaps, d_ntaps);
+            }
+        double pos = static_cast<double>(acc) * d_phase_scale;
+        unsigned int phase = static_cast<unsigned int>(pos);
+        float mu = static_cast<float>(pos - static_cast<double>(phase));
+        gr_complex y0 = pfb_dot_prod<T>(in, d_taps + phase * d_ntaps, d_ntaps);
+        gr_complex y1 = pfb_dot_prod<T>(in, d_taps + (phase + 1) * d_ntaps, d_ntaps);
+        return y0 + mu * (y1 - y0);
+    }
+
+    /*!
+     * \brief Moves acc to the next output sample and returns the number of
+     * input samples the filter window must be shifted. Never larger than ntaps() - 1.
+     */
+    unsigned int advance(uint64_t& acc) const
+    {
+        acc += d_decimation;
+        unsigned int step = static_cast<unsigned int>(acc / d_interpolation);
+        acc = acc % d_interpolation;
+        return step;
+    }
+
+private:
+    pfb_filterbank(const pfb_filterbank&) = delete;
+    pfb_filterbank& operator=(const pfb_filterbank&) = delete;
+
+    double d_sample_freq_in;
+    double d_sample_freq_out;
+    uint64_t d_interpolation; // L in the L/M rational ratio
+    uint64_t d_decimation;    // M in the L/M rational ratio
+    unsigned int d_nfilters;  // Number of filters (phases) in the bank
+    unsigned int d_ntaps;     // Number of taps of each filter
+    bool d_exact;             // True if there is one filter per output phase
+    double d_phase_scale;     // d_nfilters / d_interpolation
+    float* d_taps;            // (d_nfilters + 1) x d_ntaps, each filter stored in reverse order
+};
+
+#endif /* GNSS_SDR_PFB_FILTERBANK_H */
@@ -0,0 +1,161 @@
+/*!
+ * \file pfb_resampler.cc
+ * \brief Polyphase filterbank rational / arbitrary resampler, templated
+ *        over the sample type (gr_complex, cshort and cbyte)
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include "pfb_resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <gnuradio/io_signature.h>
+
+namespace
+{
+template <typename I>
+inline I pfb_saturate(float x)
+{
+    float r = std::round(x);
+    r = std::max(r, static_cast<float>(std::numeric_limits<I>::min()));
+    r = std::min(r, static_cast<float>(std::numeric_limits<I>::max()));
+    return static_cast<I>(r);
+}
+
+
+template <typename T>
+inline T pfb_to_sample(const gr_complex& x)
+{
+    typedef typename T::value_type value_type;
+    return T(pfb_saturate<value_type>(x.real()), pfb_saturate<value_type>(x.imag()));
+}
+
+
+template <>
+inline gr_complex pfb_to_sample<gr_complex>(const gr_complex& x)
+{
+    return x;
+}
+}
+
+
+
+template <typename T>
+boost::shared_ptr<pfb_resampler<T> > pfb_make_resampler(
+        double sample_freq_in, double sample_freq_out, float bandwidth, unsigned int taps_per_phase)
+{
+    return boost::shared_ptr<pfb_resampler<T> >(
+            new pfb_resampler<T>(sample_freq_in, sample_freq_out, bandwidth, taps_per_phase));
+}
+
+
+pfb_resampler_cc_sptr pfb_make_resampler_cc(
+        double sample_freq_in, double sample_freq_out, float bandwidth, unsigned int taps_per_phase)
+{
+    return pfb_make_resampler<gr_complex>(sample_freq_in, sample_freq_out, bandwidth, taps_per_phase);
+}
+
+
+pfb_resampler_cs_sptr pfb_make_resampler_cs(
+        double sample_freq_in, double sample_freq_out, float bandwidth, unsigned int taps_per_phase)
+{
+    return pfb_make_resampler<lv_16sc_t>(sample_freq_in, sample_freq_out, bandwidth, taps_per_phase);
+}
+
+
+pfb_resampler_cb_sptr pfb_make_resampler_cb(
+        double sample_freq_in, double sample_freq_out, float bandwidth, unsigned int taps_per_phase)
+{
+    return pfb_make_resampler<lv_8sc_t>(sample_freq_in, sample_freq_out, bandwidth, taps_per_phase);
+}
+
+
+
+template <typename T>
+pfb_resampler<T>::pfb_resampler(
+        double sample_freq_in, double sample_freq_out, float bandwidth, unsigned int taps_per_phase) :
+            gr::block("pfb_resampler", gr::io_signature::make(1, 1, sizeof(T)),
+                    gr::io_signature::make(1, 1, sizeof(T))),
+                    d_sample_freq_in(sample_freq_in), d_sample_freq_out(sample_freq_out),
+                    d_filterbank(sample_freq_in, sample_freq_out, bandwidth, taps_per_phase), d_acc(0)
+{
+    set_relative_rate(sample_freq_out / sample_freq_in);
+    set_output_multiple(1);
+}
+
+
+
+template <typename T>
+pfb_resampler<T>::~pfb_resampler()
+{}
+
+
+
+template <typename T>
+void pfb_resampler<T>::forecast(int noutput_items,
+        gr_vector_int &ninput_items_required)
+{
+    // The filter window is kept in the input buffer (not consumed) between calls
+    int nreqd = static_cast<int>((static_cast<uint64_t>(noutput_items) * d_filterbank.decimation() + d_acc)
+            / d_filterbank.interpolation()) + d_filterbank.ntaps();
+    unsigned ninputs = ninput_items_required.size();
+    for (unsigned i = 0; i < ninputs; i++)
+        {
+            ninput_items_required[i] = nreqd;
+        }
+}
+
+
+
+template <typename T>
+int pfb_resampler<T>::general_work(int noutput_items,
+        gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+{
+    const T *in = reinterpret_cast<const T *>(input_items[0]);
+    T *out = reinterpret_cast<T *>(output_items[0]);
+
+    int lcv = 0;
+    int idx = 0; // oldest sample of the current filter window
+    const int ninput = ninput_items[0];
+    const int ntaps = static_cast<int>(d_filterbank.ntaps());
+
+    while ((lcv < noutput_items) && (idx + ntaps <= ninput))
+        {
+            out[lcv] = pfb_to_sample<T>(d_filterbank.filter<T>(in + idx, d_acc));
+            lcv++;
+            idx += static_cast<int>(d_filterbank.advance(d_acc));
+        }
+
+    consume_each(idx);
+    return lcv;
+}
+
+
+template class pfb_resampler<gr_complex>;
+template class pfb_resampler<lv_16sc_t>;
+template class pfb_resampler<lv_8sc_t>;
@@ -0,0 +1,127 @@
+/*!
+ * \file pfb_resampler.h
+ * \brief Polyphase filterbank rational / arbitrary resampler, templated
+ *        over the sample type (gr_complex, cshort and cbyte)
+ *
+ * This block takes in a signal stream and performs band-limited
+ * resampling by means of a bank of polyphase FIR filters obtained from a
+ * windowed-sinc prototype. When the ratio between the output and the input
+ * sampling frequencies can be expressed as L/M with L small enough, one
+ * filter per output phase is computed and the resampling is exact. Otherwise,
+ * the output is linearly interpolated between the two closest filters
+ * of the bank. The prototype filter bandwidth is always set by the smaller
+ * of both sampling rates, so the block can also be used as an anti-aliased
+ * decimator (e.g., from 25 Msps down to 5 Msps).
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PFB_RESAMPLER_H
+#define GNSS_SDR_PFB_RESAMPLER_H
+
+#include <cstdint>
+#include <gnuradio/block.h>
+#include <volk/volk.h>
+#include "pfb_filterbank.h"
+
+template <typename T> class pfb_resampler;
+
+template <typename T>
+boost::shared_ptr<pfb_resampler<T> >
+pfb_make_resampler(double sample_freq_in, double sample_freq_out,
+        float bandwidth, unsigned int taps_per_phase);
+
+/*!
+ * \brief This class implements a polyphase filterbank resampler conditioner
+ *
+ * T is the type of the input and output samples. Products are always
+ * accumulated in single-precision floating point.
+ */
+template <typename T>
+class pfb_resampler: public gr::block
+{
+private:
+    friend boost::shared_ptr<pfb_resampler<T> >
+    pfb_make_resampler<T>(double sample_freq_in, double sample_freq_out,
+            float bandwidth, unsigned int taps_per_phase);
+
+    double d_sample_freq_in;  //! Specifies the sampling frequency of the input signal
+    double d_sample_freq_out; //! Specifies the sampling frequency of the output signal
+    pfb_filterbank d_filterbank;
+    uint64_t d_acc;           //! Fractional position of the next output sample, in units of 1/L input samples
+
+    pfb_resampler(double sample_freq_in, double sample_freq_out,
+            float bandwidth, unsigned int taps_per_phase);
+
+public:
+    ~pfb_resampler();
+    double sample_freq_in() const
+    {
+        return d_sample_freq_in;
+    }
+    double sample_freq_out() const
+    {
+        return d_sample_freq_out;
+    }
+    unsigned int nfilters() const
+    {
+        return d_filterbank.nfilters();
+    }
+    unsigned int taps_per_phase() const
+    {
+        return d_filterbank.ntaps();
+    }
+    void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+            gr_vector_const_void_star &input_items,
+            gr_vector_void_star &output_items);
+};
+
+typedef pfb_resampler<gr_complex> pfb_resampler_cc;
+typedef pfb_resampler<lv_16sc_t> pfb_resampler_cs;
+typedef pfb_resampler<lv_8sc_t> pfb_resampler_cb;
+
+typedef boost::shared_ptr<pfb_resampler_cc> pfb_resampler_cc_sptr;
+typedef boost::shared_ptr<pfb_resampler_cs> pfb_resampler_cs_sptr;
+typedef boost::shared_ptr<pfb_resampler_cb> pfb_resampler_cb_sptr;
+
+/*!
+ * \brief Makes a gr_complex in, gr_complex out polyphase resampler.
+ * \param[in] bandwidth Fraction (0, 1) of the smaller Nyquist band kept in the passband
+ * \param[in] taps_per_phase Number of taps of each polyphase filter (0 for automatic)
+ */
+pfb_resampler_cc_sptr
+pfb_make_resampler_cc(double sample_freq_in, double sample_freq_out,
+        float bandwidth = 0.8, unsigned int taps_per_phase = 0);
+
+pfb_resampler_cs_sptr
+pfb_make_resampler_cs(double sample_freq_in, double sample_freq_out,
+        float bandwidth = 0.8, unsigned int taps_per_phase = 0);
+
+pfb_resampler_cb_sptr
+pfb_make_resampler_cb(double sample_freq_in, double sample_freq_out,
+        float bandwidth = 0.8, unsigned int taps_per_phase = 0);
+
+#endif /* GNSS_SDR_PFB_RESAMPLER_H */
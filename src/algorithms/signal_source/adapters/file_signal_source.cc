@@ -48,6 +48,15 @@ using google::LogMessage;
 DEFINE_string(signal_source, "-",
         "If defined, path to the file containing the signal samples (overrides the configuration file)");
 
+DEFINE_int64(signal_source_first_sample, -1,
+        "If defined, index of the first sample of the file to be processed (overrides seconds_to_skip)");
+
+DEFINE_int64(signal_source_samples, -1,
+        "If defined, number of samples of the file to be processed (overrides samples)");
+
+DEFINE_double(signal_source_replay_speed, 0.0,
+        "If defined, replays the file at this multiple of real time (overrides replay_speed and enables the throttle)");
+
 
 FileSignalSource::FileSignalSource(ConfigurationInterface* configuration,
         std::string role, unsigned int in_streams, unsigned int out_streams,
@@ -72,6 +81,12 @@ FileSignalSource::FileSignalSource(ConfigurationInterface* configuration,
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_filename);
     enable_throttle_control_ = configuration->property(role + ".enable_throttle_control", false);
+    replay_speed_ = configuration->property(role + ".replay_speed", 1.0);
+    if (FLAGS_signal_source_replay_speed > 0.0)
+        {
+            enable_throttle_control_ = true;
+            replay_speed_ = FLAGS_signal_source_replay_speed;
+        }
     std::string s = "InputFilter";
     //double IF = configuration->property(s + ".IF", 0.0);
     double seconds_to_skip = configuration->property(role + ".seconds_to_skip", default_seconds_to_skip );
@@ -112,6 +127,13 @@ FileSignalSource::FileSignalSource(ConfigurationInterface* configuration,
                     << " unrecognized item type. Using gr_complex.";
             item_size_ = sizeof(gr_complex);
         }
+
+    // Interleaved I/Q types carry two items per sample
+    unsigned int items_per_sample = is_complex ? 2 : 1;
+    if (FLAGS_signal_source_samples >= 0)
+        {
+            samples_ = FLAGS_signal_source_samples * items_per_sample;
+        }
     try
     {
             file_source_ = gr::blocks::file_source::make(item_size_, filename_.c_str(), repeat_);
@@ -126,6 +148,10 @@ FileSignalSource::FileSignalSource(ConfigurationInterface* configuration,
                     samples_to_skip *= 2;
                 }
             }
+            if( FLAGS_signal_source_first_sample >= 0 )
+            {
+                samples_to_skip = static_cast< long >(FLAGS_signal_source_first_sample) * items_per_sample;
+            }
             if( header_size > 0 )
             {
                 samples_to_skip += header_size;
@@ -236,7 +262,10 @@ FileSignalSource::FileSignalSource(ConfigurationInterface* configuration,
 
     if (enable_throttle_control_)
         {
-            throttle_ = gr::blocks::throttle::make(item_size_, sampling_frequency_);
+            // The throttle counts items, so interleaved types need twice the sample rate
+            double items_per_second = static_cast<double>(sampling_frequency_) * static_cast<double>(items_per_sample) * replay_speed_;
+            throttle_ = gr::blocks::throttle::make(item_size_, items_per_second);
+            LOG(INFO) << "Replaying " << filename_ << " at " << replay_speed_ << "x real time";
 
         }
     DLOG(INFO) << "File source filename " << filename_;
@@ -118,6 +118,7 @@ private:
     size_t item_size_;
     // Throttle control
     bool enable_throttle_control_;
+    double replay_speed_;
 };
 
 #endif /*GNSS_SDR_FILE_SIGNAL_SOURCE_H_*/
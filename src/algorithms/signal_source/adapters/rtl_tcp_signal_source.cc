@@ -70,19 +70,17 @@ RtlTcpSignalSource::RtlTcpSignalSource(ConfigurationInterface* configuration,
     port_ = configuration->property(role + ".port", default_port);
     flip_iq_ = configuration->property(role + ".flip_iq", false);
 
-    if (item_type_.compare("short") == 0)
-        {
-            item_size_ = sizeof(short);
-        }
-    else if (item_type_.compare("gr_complex") == 0)
+    buffer_size_ = configuration->property(role + ".buffer_size", 4 * 1024 * 1024);
+
+    if ((item_type_.compare("gr_complex") == 0) || (item_type_.compare("cshort") == 0))
         {
-            item_size_ = sizeof(gr_complex);
+            item_size_ = (item_type_.compare("cshort") == 0) ? sizeof(lv_16sc_t) : sizeof(gr_complex);
             // 1. Make the gr block
             try
             {
                     std::cout << "Connecting to " << address_ << ":" << port_ << std::endl;
                     LOG (INFO) << "Connecting to " << address_ << ":" << port_;
-                    signal_source_ = rtl_tcp_make_signal_source_c (address_, port_, flip_iq_);
+                    signal_source_ = rtl_tcp_make_signal_source_c (address_, port_, flip_iq_, item_type_, buffer_size_, queue_);
             }
             catch( boost::exception & e )
             {
@@ -121,7 +119,7 @@ RtlTcpSignalSource::RtlTcpSignalSource(ConfigurationInterface* configuration,
         }
     else
         {
-            LOG(WARNING) << item_type_ << " unrecognized item type. Using short.";
+            LOG(WARNING) << item_type_ << " unrecognized item type. Use gr_complex or cshort.";
             item_size_ = sizeof(short);
         }
 
@@ -88,6 +88,7 @@ private:
     bool AGC_enabled_;
     double sample_rate_;
     bool flip_iq_;
+    unsigned int buffer_size_;
 
     unsigned int in_stream_;
     unsigned int out_stream_;
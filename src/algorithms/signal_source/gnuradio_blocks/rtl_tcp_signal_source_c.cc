@@ -31,10 +31,15 @@
  */
 
 #include "rtl_tcp_signal_source_c.h"
-#include "rtl_tcp_commands.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
 #include <glog/logging.h>
 #include <boost/thread/thread.hpp>
-#include <map>
+#include <volk/volk.h>
+#include "control_message_factory.h"
+#include "rtl_tcp_commands.h"
 
 using google::LogMessage;
 
@@ -42,42 +47,60 @@ namespace ip = boost::asio::ip;
 using boost::asio::ip::tcp;
 
 // Buffer constants
-// TODO: Make these configurable
 enum {
-    RTL_TCP_BUFFER_SIZE = 1024 * 16, // 16 KB
-    RTL_TCP_PAYLOAD_SIZE = 1024 * 4  //  4 KB
+    RTL_TCP_PAYLOAD_SIZE = 1024 * 16, // 16 KB, largest single read
+    RTL_TCP_MIN_BUFFER_SIZE = 1024 * 64, // 64 KB
+    RTL_TCP_WAIT_US = 500 // polling period of work() while the ring is empty
 };
 
 rtl_tcp_signal_source_c_sptr
 rtl_tcp_make_signal_source_c(const std::string &address,
         short port,
-        bool flip_iq)
+        bool flip_iq,
+        const std::string &item_type,
+        size_t buffer_size,
+        gr::msg_queue::sptr queue)
 {
     return gnuradio::get_initial_sptr (new rtl_tcp_signal_source_c (address,
             port,
-            flip_iq));
+            flip_iq,
+            item_type,
+            buffer_size,
+            queue));
 }
 
 
 rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
         short port,
-        bool flip_iq)
+        bool flip_iq,
+        const std::string &item_type,
+        size_t buffer_size,
+        gr::msg_queue::sptr queue)
 : gr::sync_block ("rtl_tcp_signal_source_c",
         gr::io_signature::make(0, 0, 0),
-        gr::io_signature::make(1, 1, sizeof(gr_complex))),
+        gr::io_signature::make(1, 1, (item_type.compare("cshort") == 0) ? sizeof(lv_16sc_t) : sizeof(gr_complex))),
         socket_ (io_service_),
         data_ (RTL_TCP_PAYLOAD_SIZE),
         flip_iq_(flip_iq),
-        buffer_ (RTL_TCP_BUFFER_SIZE),
-        unread_ (0)
+        cshort_(item_type.compare("cshort") == 0),
+        queue_(queue),
+        write_index_ (0),
+        read_index_ (0),
+        stopped_ (false),
+        overruns_ (0),
+        overrun_bytes_ (0),
+        overrunning_ (false)
 {
     boost::system::error_code ec;
 
-    // 1. Setup lookup table
-    for (unsigned i = 0; i < 0xff; i++)
+    // 1. Allocate the ring. A power of two keeps I/Q pairs from straddling its end
+    size_t ring_size = RTL_TCP_MIN_BUFFER_SIZE;
+    while (ring_size < buffer_size)
         {
-            lookup_[i] = ((float)(i & 0xff) - 127.4f) * (1.0f / 128.0f);
+            ring_size <<= 1;
         }
+    ring_.resize (ring_size);
+    ring_mask_ = ring_size - 1;
 
     // 2. Set socket options
     ip::address addr = ip::address::from_string (address, ec);
@@ -144,9 +167,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
         }
 
     // 6. Start reading
-    boost::asio::async_read (socket_, boost::asio::buffer (data_),
-            boost::bind (&rtl_tcp_signal_source_c::handle_read,
-                    this, _1, _2));
+    start_read ();
     boost::thread (boost::bind (&boost::asio::io_service::run, &io_service_));
 }
 
@@ -161,34 +182,72 @@ int rtl_tcp_signal_source_c::work (int noutput_items,
         gr_vector_const_void_star &/*input_items*/,
         gr_vector_void_star &output_items)
 {
-    gr_complex *out = reinterpret_cast <gr_complex *>( output_items[0] );
-    int i = 0;
-    if (io_service_.stopped ())
+    size_t read_index = read_index_.load (std::memory_order_relaxed);
+    size_t available = write_index_.load (std::memory_order_acquire) - read_index;
+    while (available < 2)
         {
-            return -1;
+            if (stopped_.load (std::memory_order_acquire))
+                {
+                    // Check once more, the last bytes may have arrived before the stop
+                    available = write_index_.load (std::memory_order_acquire) - read_index;
+                    if (available < 2)
+                        {
+                            return -1;
+                        }
+                    break;
+                }
+            // interruption point, so that the flowgraph can be stopped while waiting
+            boost::this_thread::sleep (boost::posix_time::microseconds (RTL_TCP_WAIT_US));
+            available = write_index_.load (std::memory_order_acquire) - read_index;
         }
 
-    {
-        boost::mutex::scoped_lock lock (mutex_);
-        not_empty_.wait (lock, boost::bind (&rtl_tcp_signal_source_c::not_empty,
-                this));
-
-        for ( ; i < noutput_items && unread_ > 1; i++ )
-            {
-                float re = buffer_[--unread_];
-                float im = buffer_[--unread_];
-                if (flip_iq_)
-                    {
-                        out[i] = gr_complex (im, re);
-                    }
-                else
-                    {
-                        out[i] = gr_complex (re, im);
-                    }
-            }
-    }
-    not_full_.notify_one ();
-    return i == 0 ? -1 : i;
+    size_t nsamples = std::min (static_cast<size_t> (noutput_items), available / 2);
+    size_t done = 0;
+    while (done < nsamples)
+        {
+            // Convert the contiguous part of the ring. The read index is always
+            // even and the ring size a power of two, so pairs are never split
+            size_t offset = read_index & ring_mask_;
+            size_t n = std::min (nsamples - done, (ring_.size () - offset) / 2);
+            unsigned char *bytes = &ring_[offset];
+
+            // rtl_tcp sends offset binary: flipping the MSB gives two's complement
+            size_t nwords = (2 * n) / sizeof (uint64_t);
+            for (size_t w = 0; w < nwords; w++)
+                {
+                    uint64_t word;
+                    std::memcpy (&word, bytes + w * sizeof (uint64_t), sizeof (uint64_t));
+                    word ^= 0x8080808080808080ULL;
+                    std::memcpy (bytes + w * sizeof (uint64_t), &word, sizeof (uint64_t));
+                }
+            for (size_t b = nwords * sizeof (uint64_t); b < 2 * n; b++)
+                {
+                    bytes[b] ^= 0x80;
+                }
+            if (flip_iq_)
+                {
+                    for (size_t k = 0; k < n; k++)
+                        {
+                            std::swap (bytes[2 * k], bytes[2 * k + 1]);
+                        }
+                }
+
+            // Widen straight into the output buffer
+            if (cshort_)
+                {
+                    lv_16sc_t *out = reinterpret_cast<lv_16sc_t *> (output_items[0]) + done;
+                    volk_8i_convert_16i (reinterpret_cast<int16_t *> (out), reinterpret_cast<const int8_t *> (bytes), 2 * n);
+                }
+            else
+                {
+                    gr_complex *out = reinterpret_cast<gr_complex *> (output_items[0]) + done;
+                    volk_8i_s32f_convert_32f (reinterpret_cast<float *> (out), reinterpret_cast<const int8_t *> (bytes), 128.0f, 2 * n);
+                }
+            read_index += 2 * n;
+            done += n;
+        }
+    read_index_.store (read_index, std::memory_order_release);
+    return nsamples;
 }
 
 
@@ -314,48 +373,79 @@ void rtl_tcp_signal_source_c::set_if_gain (int gain)
 
 
 
+void rtl_tcp_signal_source_c::start_read ()
+{
+    size_t write_index = write_index_.load (std::memory_order_relaxed);
+    size_t free_bytes = ring_.size () - (write_index - read_index_.load (std::memory_order_acquire));
+    if (free_bytes == 0)
+        {
+            // The ring is full: keep draining the socket and count the loss.
+            // async_read fills the whole scratch buffer, so the number of
+            // discarded bytes is always even and I/Q pairs stay aligned
+            if (!overrunning_)
+                {
+                    overrunning_ = true;
+                    overruns_++;
+                    if (queue_)
+                        {
+                            std::unique_ptr<ControlMessageFactory> cmf (new ControlMessageFactory ());
+                            queue_->handle (cmf->GetQueueMessage (200, 1));
+                        }
+                }
+            boost::asio::async_read (socket_,
+                    boost::asio::buffer (data_),
+                    boost::bind (&rtl_tcp_signal_source_c::handle_discard,
+                            this, _1, _2));
+            return;
+        }
+    if (overrunning_)
+        {
+            overrunning_ = false;
+            LOG (WARNING) << "rtl_tcp overrun: " << overrun_bytes_.load () << " bytes lost in "
+                          << overruns_.load () << " overruns so far";
+        }
+    // Receive straight into the ring
+    size_t offset = write_index & ring_mask_;
+    size_t n = std::min (free_bytes, ring_.size () - offset);
+    n = std::min (n, static_cast<size_t> (RTL_TCP_PAYLOAD_SIZE));
+    socket_.async_read_some (boost::asio::buffer (&ring_[offset], n),
+            boost::bind (&rtl_tcp_signal_source_c::handle_read,
+                    this, _1, _2));
+}
+
+
+void rtl_tcp_signal_source_c::handle_error (const boost::system::error_code &ec)
+{
+    std::cout << "Error during read: " << ec << std::endl;
+    LOG (WARNING) << "Error during read: " << ec;
+    stopped_.store (true, std::memory_order_release);
+    io_service_.stop ();
+}
+
+
 void rtl_tcp_signal_source_c::handle_read (const boost::system::error_code &ec,
         size_t bytes_transferred)
 {
     if (ec)
         {
-            std::cout << "Error during read: " << ec << std::endl;
-            LOG (WARNING) << "Error during read: " << ec;
-            boost::mutex::scoped_lock lock (mutex_);
-            io_service_.stop ();
-            not_empty_.notify_one ();
+            handle_error (ec);
+            return;
         }
-    else
+    // publish the new bytes to work()
+    write_index_.store (write_index_.load (std::memory_order_relaxed) + bytes_transferred,
+            std::memory_order_release);
+    start_read ();
+}
+
+
+void rtl_tcp_signal_source_c::handle_discard (const boost::system::error_code &ec,
+        size_t bytes_transferred)
+{
+    overrun_bytes_ += bytes_transferred;
+    if (ec)
         {
-            {
-                // Unpack read data
-                boost::mutex::scoped_lock lock (mutex_);
-                not_full_.wait (lock,
-                        boost::bind (&rtl_tcp_signal_source_c::not_full,
-                                this));
-
-                for (size_t i = 0; i < bytes_transferred; i++)
-                    {
-                        while (!not_full( ))
-                            {
-                                // uh-oh, buffer overflow
-                                // wait until there's space for more
-                                not_empty_.notify_one (); // needed?
-                                not_full_.wait (lock,
-                                        boost::bind (&rtl_tcp_signal_source_c::not_full,
-                                                this));
-                            }
-
-                        buffer_.push_front (lookup_[data_[i]]);
-                        unread_++;
-                    }
-            }
-            // let woker know that more data is available
-            not_empty_.notify_one ();
-            // Read some more
-            boost::asio::async_read (socket_,
-                    boost::asio::buffer (data_),
-                    boost::bind (&rtl_tcp_signal_source_c::handle_read,
-                            this, _1, _2));
+            handle_error (ec);
+            return;
         }
+    start_read ();
 }
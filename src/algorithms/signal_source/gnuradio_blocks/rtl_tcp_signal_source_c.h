@@ -7,8 +7,9 @@
  * sources. The data format and command structure is taken from the
  * original Osmocom rtl_tcp_source_f (http://git.osmocom.org/gr-osmosdr).
  * The aynchronous reading code comes from the examples provides
- * by Boost.Asio and the bounded buffer producer-consumer solution is
- * taken from the Boost.CircularBuffer examples (http://boost.org/).
+ * by Boost.Asio (http://boost.org/). The network thread and the GNU Radio
+ * work thread share a pre-allocated single-producer / single-consumer
+ * ring of raw bytes, without locks.
  *
  * -------------------------------------------------------------------------
  *
@@ -39,27 +40,39 @@
 #define    GNSS_SDR_RTL_TCP_SIGNAL_SOURCE_C_H
 
 #include "rtl_tcp_dongle_info.h"
+#include <atomic>
+#include <string>
+#include <vector>
 #include <boost/asio.hpp>
+#include <gnuradio/msg_queue.h>
 #include <gnuradio/sync_block.h>
-#include <string>
-#include <boost/thread/mutex.hpp>
-#include <boost/thread/condition.hpp>
-#include <boost/array.hpp>
-#include <boost/circular_buffer.hpp>
 
 class rtl_tcp_signal_source_c;
 
 typedef boost::shared_ptr<rtl_tcp_signal_source_c>
         rtl_tcp_signal_source_c_sptr;
 
+/*!
+ * \param[in] item_type Output type, "gr_complex" or "cshort"
+ * \param[in] buffer_size Size of the ring between the network and the work threads, in bytes
+ * \param[in] queue If not null, the control thread is notified of every overrun
+ */
 rtl_tcp_signal_source_c_sptr
 rtl_tcp_make_signal_source_c(const std::string &address,
                              short port,
-                             bool flip_iq = false);
+                             bool flip_iq = false,
+                             const std::string &item_type = "gr_complex",
+                             size_t buffer_size = 4 * 1024 * 1024,
+                             gr::msg_queue::sptr queue = gr::msg_queue::sptr());
 
 /*!
  * \brief This class reads interleaved I/Q samples
  * from an rtl_tcp server and outputs complex types.
+ *
+ * The network thread never waits for the receiver: if the ring is full, the
+ * incoming data is discarded and counted as an overrun, so the TCP stream
+ * keeps flowing and the loss is visible instead of silently delaying the
+ * samples.
  */
 class rtl_tcp_signal_source_c : public gr::sync_block
 {
@@ -76,47 +89,58 @@ public:
     void set_gain (int gain);
     void set_if_gain (int gain);
 
-private:
-    typedef boost::circular_buffer_space_optimized<float> buffer_type;
+    //! Number of times the ring has overflowed
+    unsigned long long overruns () const { return overruns_.load (); }
+    //! Number of bytes (two per sample) discarded because the ring was full
+    unsigned long long overrun_bytes () const { return overrun_bytes_.load (); }
 
+private:
     friend rtl_tcp_signal_source_c_sptr
     rtl_tcp_make_signal_source_c(const std::string &address,
             short port,
-            bool flip_iq);
+            bool flip_iq,
+            const std::string &item_type,
+            size_t buffer_size,
+            gr::msg_queue::sptr queue);
 
     rtl_tcp_signal_source_c(const std::string &address,
             short port,
-            bool flip_iq);
+            bool flip_iq,
+            const std::string &item_type,
+            size_t buffer_size,
+            gr::msg_queue::sptr queue);
 
     rtl_tcp_dongle_info info_;
 
     // IO members
     boost::asio::io_service io_service_;
     boost::asio::ip::tcp::socket socket_;
-    std::vector<unsigned char> data_;
+    std::vector<unsigned char> data_; // scratch buffer used while the ring is full
     bool flip_iq_;
+    bool cshort_;
+    gr::msg_queue::sptr queue_;
+
+    // single-producer / single-consumer ring. The indexes grow monotonically
+    std::vector<unsigned char> ring_;
+    size_t ring_mask_;
+    std::atomic<size_t> write_index_;
+    std::atomic<size_t> read_index_;
+    std::atomic<bool> stopped_;
 
-    // producer-consumer helpers
-    boost::mutex mutex_;
-    boost::condition not_full_;
-    boost::condition not_empty_;
-    buffer_type buffer_;
-    size_t unread_;
+    // overrun statistics
+    std::atomic<unsigned long long> overruns_;
+    std::atomic<unsigned long long> overrun_bytes_;
+    bool overrunning_;
 
-    // lookup for scaling data
-    boost::array<float, 0xff> lookup_;
+    // starts the next asynchronous read, into the ring if it has room
+    void start_read ();
 
-    // async read callback
+    // async read callbacks
     void handle_read (const boost::system::error_code &ec,
             size_t bytes_transferred);
-
-    inline bool not_full ( ) const {
-        return unread_ < buffer_.capacity( );
-    }
-
-    inline bool not_empty ( ) const {
-        return unread_ > 0 || io_service_.stopped ();
-    }
+    void handle_discard (const boost::system::error_code &ec,
+            size_t bytes_transferred);
+    void handle_error (const boost::system::error_code &ec);
 };
 
 #endif //GNSS_SDR_RTL_TCP_SIGNAL_SOURCE_C_H
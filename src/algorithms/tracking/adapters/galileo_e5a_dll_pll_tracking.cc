@@ -37,9 +37,11 @@
  */
 
 #include "galileo_e5a_dll_pll_tracking.h"
+#include <cmath>
 #include <glog/logging.h>
 #include "Galileo_E5a.h"
 #include "configuration_interface.h"
+#include "dll_pll_signal_traits.h"
 
 
 using google::LogMessage;
@@ -51,52 +53,43 @@ GalileoE5aDllPllTracking::GalileoE5aDllPllTracking(
 {
     DLOG(INFO) << "role " << role;
     //################# CONFIGURATION PARAMETERS ########################
-    int fs_in;
-    int vector_length;
-    int f_if;
-    bool dump;
-    std::string dump_filename;
+    Dll_Pll_Conf conf;
     std::string item_type;
     std::string default_item_type = "gr_complex";
-    float pll_bw_hz;
-    float dll_bw_hz;
-    float pll_bw_init_hz;
-    float dll_bw_init_hz;
-    int ti_ms;
-    float early_late_space_chips;
     item_type = configuration->property(role + ".item_type", default_item_type);
-    //vector_length = configuration->property(role + ".vector_length", 2048);
-    fs_in = configuration->property("GNSS-SDR.internal_fs_hz", 12000000);
-    f_if = configuration->property(role + ".if", 0);
-    dump = configuration->property(role + ".dump", false);
-    pll_bw_hz = configuration->property(role + ".pll_bw_hz", 5.0);
-    dll_bw_hz = configuration->property(role + ".dll_bw_hz", 2.0);
-    pll_bw_init_hz = configuration->property(role + ".pll_bw_init_hz", 20.0);
-    dll_bw_init_hz = configuration->property(role + ".dll_bw_init_hz", 20.0);
-    ti_ms = configuration->property(role + ".ti_ms", 3);
-
-    early_late_space_chips = configuration->property(role + ".early_late_space_chips", 0.5);
+    conf.fs_in = configuration->property("GNSS-SDR.internal_fs_hz", 12000000);
+    conf.if_freq = configuration->property(role + ".if", 0);
+    conf.dump = configuration->property(role + ".dump", false);
+    // pll_bw_hz and dll_bw_hz apply once the secondary code is synchronized
+    conf.pll_bw_hz = configuration->property(role + ".pll_bw_init_hz", 20.0);
+    conf.dll_bw_hz = configuration->property(role + ".dll_bw_init_hz", 20.0);
+    conf.pll_bw_narrow_hz = configuration->property(role + ".pll_bw_hz", 5.0);
+    conf.dll_bw_narrow_hz = configuration->property(role + ".dll_bw_hz", 2.0);
+    conf.extend_correlation_ms = configuration->property(role + ".ti_ms", 3);
+    conf.early_late_space_chips = configuration->property(role + ".early_late_space_chips", 0.5);
+    conf.cn0_samples = configuration->property(role + ".cn0_samples", 0);
+    conf.cn0_min = configuration->property(role + ".cn0_min", 25.0);
+    conf.carrier_lock_th = configuration->property(role + ".carrier_lock_th", 0.0);
     std::string default_dump_filename = "./track_ch";
-    dump_filename = configuration->property(role + ".dump_filename",
-            default_dump_filename); //unused!
-    vector_length = std::round(fs_in / (Galileo_E5a_CODE_CHIP_RATE_HZ / Galileo_E5a_CODE_LENGTH_CHIPS));
+    conf.dump_filename = configuration->property(role + ".dump_filename",
+            default_dump_filename);
+    conf.vector_length = std::round(conf.fs_in / (Galileo_E5a_CODE_CHIP_RATE_HZ / Galileo_E5a_CODE_LENGTH_CHIPS));
 
     //################# MAKE TRACKING GNURadio object ###################
     if (item_type.compare("gr_complex") == 0)
         {
             item_size_ = sizeof(gr_complex);
-            tracking_ = galileo_e5a_dll_pll_make_tracking_cc(
-                    f_if,
-                    fs_in,
-                    vector_length,
-                    dump,
-                    dump_filename,
-                    pll_bw_hz,
-                    dll_bw_hz,
-                    pll_bw_init_hz,
-                    dll_bw_init_hz,
-                    ti_ms,
-                    early_late_space_chips);
+            tracking_ = dll_pll_make_tracking<Galileo_E5a_Dll_Pll_Traits, gr_complex>(conf);
+        }
+    else if (item_type.compare("cshort") == 0)
+        {
+            item_size_ = sizeof(lv_16sc_t);
+            tracking_ = dll_pll_make_tracking<Galileo_E5a_Dll_Pll_Traits, lv_16sc_t>(conf);
+        }
+    else if (item_type.compare("cbyte") == 0)
+        {
+            item_size_ = sizeof(lv_8sc_t);
+            tracking_ = dll_pll_make_tracking<Galileo_E5a_Dll_Pll_Traits, lv_8sc_t>(conf);
         }
     else
         {
@@ -41,13 +41,17 @@
 
 #include <string>
 #include "tracking_interface.h"
-#include "galileo_e5a_dll_pll_tracking_cc.h"
+#include "dll_pll_tracking.h"
 
 
 class ConfigurationInterface;
 
 /*!
- * \brief This class implements a code DLL + carrier PLL tracking loop
+ * \brief This class implements a code DLL + carrier PLL tracking loop for
+ * Galileo E5a, with the dll_pll_tracking block template. The loop tracks the
+ * E5a Q pilot, and switches from the initial bandwidths (pll_bw_init_hz,
+ * dll_bw_init_hz) to pll_bw_hz and dll_bw_hz with ti_ms of coherent
+ * integration once the secondary code is synchronized.
  */
 class GalileoE5aDllPllTracking : public TrackingInterface
 {
@@ -94,7 +98,7 @@ public:
     void start_tracking();
 
 private:
-    galileo_e5a_dll_pll_tracking_cc_sptr tracking_;
+    dll_pll_tracking_base_sptr tracking_;
     size_t item_size_;
     unsigned int channel_;
     std::string role_;
@@ -0,0 +1,197 @@
+/*!
+ * \file generic_dll_pll_tracking.cc
+ * \brief  Implementation of an adapter of the DLL+PLL tracking block template
+ * (dll_pll_tracking) to a TrackingInterface, for any of the signals it supports
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "generic_dll_pll_tracking.h"
+#include <cmath>
+#include <glog/logging.h>
+#include "configuration_interface.h"
+#include "dll_pll_signal_traits.h"
+
+
+using google::LogMessage;
+
+GenericDllPllTracking::GenericDllPllTracking(
+        ConfigurationInterface* configuration, std::string role,
+        std::string implementation,
+        unsigned int in_streams, unsigned int out_streams) :
+                role_(role), implementation_(implementation), in_streams_(in_streams), out_streams_(out_streams)
+{
+    DLOG(INFO) << "role " << role;
+    bool galileo_e1 = (implementation.compare("Galileo_E1_DLL_PLL_Generic_Tracking") == 0);
+    bool galileo_e5a = (implementation.compare("Galileo_E5a_DLL_PLL_Generic_Tracking") == 0);
+    // Galileo E1 can be tracked on the E1 C pilot, with the CS25 secondary code wiped off
+    bool track_pilot = configuration->property(role + ".track_pilot", false);
+    //################# CONFIGURATION PARAMETERS ########################
+    Dll_Pll_Conf conf;
+    std::string item_type;
+    std::string default_item_type = "gr_complex";
+    item_type = configuration->property(role + ".item_type", default_item_type);
+    conf.fs_in = configuration->property("GNSS-SDR.internal_fs_hz", 2048000);
+    conf.if_freq = configuration->property(role + ".if", 0);
+    conf.dump = configuration->property(role + ".dump", false);
+    // Defaults of the block each signal had before this one
+    conf.pll_bw_hz = configuration->property(role + ".pll_bw_hz", galileo_e5a ? 20.0 : 50.0);
+    conf.dll_bw_hz = configuration->property(role + ".dll_bw_hz", galileo_e5a ? 20.0 : 2.0);
+    conf.pll_bw_narrow_hz = configuration->property(role + ".pll_bw_narrow_hz", (galileo_e5a or (galileo_e1 and track_pilot)) ? 5.0 : 20.0);
+    conf.dll_bw_narrow_hz = configuration->property(role + ".dll_bw_narrow_hz", 2.0);
+    conf.extend_correlation_ms = configuration->property(role + ".extend_correlation_ms", 1);
+    conf.early_late_space_chips = configuration->property(role + ".early_late_space_chips", galileo_e1 ? 0.15 : 0.5);
+    conf.very_early_late_space_chips = configuration->property(role + ".very_early_late_space_chips", 0.6);
+    conf.cn0_samples = configuration->property(role + ".cn0_samples", 0);
+    conf.cn0_min = configuration->property(role + ".cn0_min", 25.0);
+    conf.carrier_lock_th = configuration->property(role + ".carrier_lock_th", 0.0);
+    conf.monitor_taps = configuration->property(role + ".monitor_taps", 0);
+    conf.monitor_spacing_chips = configuration->property(role + ".monitor_spacing_chips", 0.1);
+    conf.monitor_period = configuration->property(role + ".monitor_period", 1000);
+    // The 2nd order loops are only stable for a bandwidth well below the update rate
+    if (conf.pll_bw_narrow_hz * static_cast<float>(conf.extend_correlation_ms) / 1000.0 > 0.1)
+        {
+            LOG(WARNING) << role << ".pll_bw_narrow_hz=" << conf.pll_bw_narrow_hz << " is too wide for "
+                         << conf.extend_correlation_ms << " ms of coherent integration, it will be reduced to "
+                         << 100.0 / static_cast<float>(conf.extend_correlation_ms) << " Hz";
+        }
+    // The monitor correlators are centered on the prompt
+    if (conf.monitor_taps > 0 && conf.monitor_taps % 2 == 0)
+        {
+            LOG(WARNING) << role << ".monitor_taps=" << conf.monitor_taps << " is even, "
+                         << conf.monitor_taps + 1 << " correlators will be used so that the prompt is the middle one";
+        }
+    std::string default_dump_filename = "./track_ch";
+    conf.dump_filename = configuration->property(role + ".dump_filename",
+            default_dump_filename);
+
+    //################# MAKE TRACKING GNURadio object ###################
+    if (implementation.compare("GPS_L1_CA_DLL_PLL_Generic_Tracking") == 0)
+        {
+            make_tracking<Gps_L1_Ca_Dll_Pll_Traits>(conf, item_type);
+        }
+    else if (implementation.compare("GPS_L2_M_DLL_PLL_Generic_Tracking") == 0)
+        {
+            make_tracking<Gps_L2_M_Dll_Pll_Traits>(conf, item_type);
+        }
+    else if (galileo_e1 and track_pilot)
+        {
+            make_tracking<Galileo_E1_C_Dll_Pll_Traits>(conf, item_type);
+        }
+    else if (galileo_e1)
+        {
+            make_tracking<Galileo_E1_B_Dll_Pll_Traits>(conf, item_type);
+        }
+    else if (galileo_e5a)
+        {
+            make_tracking<Galileo_E5a_Dll_Pll_Traits>(conf, item_type);
+        }
+    else
+        {
+            item_size_ = sizeof(gr_complex);
+            LOG(WARNING) << implementation << " unknown signal for the generic DLL/PLL tracking.";
+        }
+    channel_ = 0;
+    if (tracking_)
+        {
+            DLOG(INFO) << "tracking(" << tracking_->unique_id() << ")";
+        }
+}
+
+
+template <class Traits>
+void GenericDllPllTracking::make_tracking(const Dll_Pll_Conf& conf, const std::string& item_type)
+{
+    Dll_Pll_Conf trk_conf = conf;
+    // one primary code period per call
+    trk_conf.vector_length = std::round(trk_conf.fs_in * Traits::code_period_s());
+    if (item_type.compare("gr_complex") == 0)
+        {
+            item_size_ = sizeof(gr_complex);
+            tracking_ = dll_pll_make_tracking<Traits, gr_complex>(trk_conf);
+        }
+    else if (item_type.compare("cshort") == 0)
+        {
+            item_size_ = sizeof(lv_16sc_t);
+            tracking_ = dll_pll_make_tracking<Traits, lv_16sc_t>(trk_conf);
+        }
+    else if (item_type.compare("cbyte") == 0)
+        {
+            item_size_ = sizeof(lv_8sc_t);
+            tracking_ = dll_pll_make_tracking<Traits, lv_8sc_t>(trk_conf);
+        }
+    else
+        {
+            item_size_ = sizeof(gr_complex);
+            LOG(WARNING) << item_type << " unknown tracking item type.";
+        }
+}
+
+
+GenericDllPllTracking::~GenericDllPllTracking()
+{}
+
+
+void GenericDllPllTracking::start_tracking()
+{
+    tracking_->start_tracking();
+}
+
+/*
+ * Set tracking channel unique ID
+ */
+void GenericDllPllTracking::set_channel(unsigned int channel)
+{
+    channel_ = channel;
+    tracking_->set_channel(channel);
+}
+
+
+void GenericDllPllTracking::set_gnss_synchro(Gnss_Synchro* p_gnss_synchro)
+{
+    tracking_->set_gnss_synchro(p_gnss_synchro);
+}
+
+void GenericDllPllTracking::connect(gr::top_block_sptr top_block)
+{
+    if(top_block) { /* top_block is not null */};
+    //nothing to connect
+}
+
+void GenericDllPllTracking::disconnect(gr::top_block_sptr top_block)
+{
+    if(top_block) { /* top_block is not null */};
+    //nothing to disconnect
+}
+
+gr::basic_block_sptr GenericDllPllTracking::get_left_block()
+{
+    return tracking_;
+}
+
+gr::basic_block_sptr GenericDllPllTracking::get_right_block()
+{
+    return tracking_;
+}
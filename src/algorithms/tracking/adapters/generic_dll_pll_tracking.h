@@ -0,0 +1,110 @@
+/*!
+ * \file generic_dll_pll_tracking.h
+ * \brief  Interface of an adapter of the DLL+PLL tracking block template
+ * (dll_pll_tracking) to a TrackingInterface, for any of the signals it supports
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GENERIC_DLL_PLL_TRACKING_H_
+#define GNSS_SDR_GENERIC_DLL_PLL_TRACKING_H_
+
+#include <string>
+#include "tracking_interface.h"
+#include "dll_pll_tracking.h"
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief This class adapts the DLL+PLL tracking block template to a
+ * TrackingInterface. The signal is selected by the implementation name:
+ *
+ *  - GPS_L1_CA_DLL_PLL_Generic_Tracking
+ *  - GPS_L2_M_DLL_PLL_Generic_Tracking
+ *  - Galileo_E1_DLL_PLL_Generic_Tracking
+ *  - Galileo_E5a_DLL_PLL_Generic_Tracking
+ *
+ * and the sample type by the item_type property (gr_complex, cshort or cbyte).
+ * Galileo E1 is tracked on the E1 C pilot if the track_pilot property is set.
+ */
+class GenericDllPllTracking : public TrackingInterface
+{
+public:
+    GenericDllPllTracking(ConfigurationInterface* configuration,
+            std::string role,
+            std::string implementation,
+            unsigned int in_streams,
+            unsigned int out_streams);
+
+    virtual ~GenericDllPllTracking();
+
+    std::string role()
+    {
+        return role_;
+    }
+
+    //! Returns the implementation name the block was created with
+    std::string implementation()
+    {
+        return implementation_;
+    }
+    size_t item_size()
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block);
+    void disconnect(gr::top_block_sptr top_block);
+    gr::basic_block_sptr get_left_block();
+    gr::basic_block_sptr get_right_block();
+
+    /*!
+     * \brief Set tracking channel unique ID
+     */
+    void set_channel(unsigned int channel);
+
+    /*!
+     * \brief Set acquisition/tracking common Gnss_Synchro object pointer
+     * to efficiently exchange synchronization data between acquisition and tracking blocks
+     */
+    void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro);
+
+    void start_tracking();
+
+private:
+    template <class Traits>
+    void make_tracking(const Dll_Pll_Conf& conf, const std::string& item_type);
+
+    dll_pll_tracking_base_sptr tracking_;
+    size_t item_size_;
+    unsigned int channel_;
+    std::string role_;
+    std::string implementation_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+};
+
+#endif /* GNSS_SDR_GENERIC_DLL_PLL_TRACKING_H_ */
@@ -114,6 +114,22 @@ GpsL1CaDllPllCAidTracking::GpsL1CaDllPllCAidTracking(
                     early_late_space_chips);
             DLOG(INFO) << "tracking(" << tracking_sc->unique_id() << ")";
         }
+    else if(item_type_.compare("cbyte") == 0)
+        {
+            item_size_ = sizeof(lv_8sc_t);
+            tracking_8sc = gps_l1_ca_dll_pll_c_aid_make_tracking_8sc(
+                    f_if,
+                    fs_in,
+                    vector_length,
+                    dump,
+                    dump_filename,
+                    pll_bw_hz,
+                    dll_bw_hz,
+                    pll_bw_narrow_hz,
+                    dll_bw_narrow_hz,
+                    early_late_space_chips);
+            DLOG(INFO) << "tracking(" << tracking_8sc->unique_id() << ")";
+        }
     else
         {
             item_size_ = sizeof(gr_complex);
@@ -138,6 +154,10 @@ void GpsL1CaDllPllCAidTracking::start_tracking()
         {
             tracking_sc->start_tracking();
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            tracking_8sc->start_tracking();
+        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown tracking item type";
@@ -159,6 +179,10 @@ void GpsL1CaDllPllCAidTracking::set_channel(unsigned int channel)
         {
             tracking_sc->set_channel(channel);
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            tracking_8sc->set_channel(channel);
+        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown tracking item type";
@@ -175,6 +199,10 @@ void GpsL1CaDllPllCAidTracking::set_gnss_synchro(Gnss_Synchro* p_gnss_synchro)
         {
             tracking_sc->set_gnss_synchro(p_gnss_synchro);
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            tracking_8sc->set_gnss_synchro(p_gnss_synchro);
+        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown tracking item type";
@@ -203,6 +231,10 @@ gr::basic_block_sptr GpsL1CaDllPllCAidTracking::get_left_block()
         {
             return tracking_sc;
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            return tracking_8sc;
+        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown tracking item type";
@@ -220,6 +252,10 @@ gr::basic_block_sptr GpsL1CaDllPllCAidTracking::get_right_block()
         {
             return tracking_sc;
         }
+    else if (item_type_.compare("cbyte") == 0)
+        {
+            return tracking_8sc;
+        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown tracking item type";
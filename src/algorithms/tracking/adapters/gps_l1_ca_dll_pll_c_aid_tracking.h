@@ -42,6 +42,7 @@
 #include "tracking_interface.h"
 #include "gps_l1_ca_dll_pll_c_aid_tracking_cc.h"
 #include "gps_l1_ca_dll_pll_c_aid_tracking_sc.h"
+#include "gps_l1_ca_dll_pll_c_aid_tracking_8sc.h"
 
 
 class ConfigurationInterface;
@@ -98,6 +99,7 @@ public:
 private:
     gps_l1_ca_dll_pll_c_aid_tracking_cc_sptr tracking_cc;
     gps_l1_ca_dll_pll_c_aid_tracking_sc_sptr tracking_sc;
+    gps_l1_ca_dll_pll_c_aid_tracking_8sc_sptr tracking_8sc;
     size_t item_size_;
     std::string item_type_;
     unsigned int channel_;
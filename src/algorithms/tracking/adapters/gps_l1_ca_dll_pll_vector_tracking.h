@@ -0,0 +1,103 @@
+/*!
+ * \file gps_l1_ca_dll_pll_vector_tracking.h
+ * \brief Interface of an adapter of a DLL+PLL tracking loop block aided
+ * by the PVT solution (vector DLL / FLL) for GPS L1 C/A to a TrackingInterface
+ *
+ * Scalar code DLL + carrier PLL according to the algorithms described in:
+ * K.Borre, D.M.Akos, N.Bertelsen, P.Rinder, and S.H.Jensen,
+ * A Software-Defined GPS and Galileo Receiver. A Single-Frequency
+ * Approach, Birkhauser, 2007
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GPS_L1_CA_DLL_PLL_VECTOR_TRACKING_H_
+#define GNSS_SDR_GPS_L1_CA_DLL_PLL_VECTOR_TRACKING_H_
+
+#include <string>
+#include "tracking_interface.h"
+#include "gps_l1_ca_dll_pll_vector_tracking_cc.h"
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief This class implements a code DLL + carrier PLL tracking loop aided
+ * by the PVT solution
+ */
+class GpsL1CaDllPllVectorTracking : public TrackingInterface
+{
+public:
+    GpsL1CaDllPllVectorTracking(ConfigurationInterface* configuration,
+            std::string role,
+            unsigned int in_streams,
+            unsigned int out_streams);
+
+    virtual ~GpsL1CaDllPllVectorTracking();
+
+    std::string role()
+    {
+        return role_;
+    }
+
+    //! Returns "GPS_L1_CA_DLL_PLL_Vector_Tracking"
+    std::string implementation()
+    {
+        return "GPS_L1_CA_DLL_PLL_Vector_Tracking";
+    }
+
+    size_t item_size()
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block);
+    void disconnect(gr::top_block_sptr top_block);
+    gr::basic_block_sptr get_left_block();
+    gr::basic_block_sptr get_right_block();
+
+    /*!
+     * \brief Set tracking channel unique ID
+     */
+    void set_channel(unsigned int channel);
+
+    /*!
+     * \brief Set acquisition/tracking common Gnss_Synchro object pointer
+     * to efficiently exchange synchronization data between acquisition and tracking blocks
+     */
+    void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro);
+
+    void start_tracking();
+
+private:
+    gps_l1_ca_dll_pll_vector_tracking_cc_sptr tracking_;
+    size_t item_size_;
+    unsigned int channel_;
+    std::string role_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+};
+
+#endif // GNSS_SDR_GPS_L1_CA_DLL_PLL_VECTOR_TRACKING_H_
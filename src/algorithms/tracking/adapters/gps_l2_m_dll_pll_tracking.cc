@@ -91,6 +91,12 @@ GpsL2MDllPllTracking::GpsL2MDllPllTracking(
             item_size_ = sizeof(gr_complex);
             LOG(WARNING) << item_type << " unknown tracking item type.";
         }
+    if (tracking_ && configuration->property(role + ".kalman_filter", false))
+        {
+            tracking_->enable_kalman_filter(configuration->property(role + ".kf_clock_noise", 1.0),
+                    configuration->property(role + ".kf_dynamics_noise", 1.0),
+                    configuration->property(role + ".kf_code_noise", 1e-4));
+        }
     channel_ = 0;
     DLOG(INFO) << "tracking(" << tracking_->unique_id() << ")";
 }
@@ -0,0 +1,87 @@
+/*!
+ * \file dll_pll_signal_traits.cc
+ * \brief Local code generators of the signals tracked by dll_pll_tracking
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "dll_pll_signal_traits.h"
+#include "galileo_e1_signal_processing.h"
+#include "gnss_code_bank.h"
+
+// Definitions of the constants that are bound to references (e.g. by std::min)
+constexpr int Gps_L1_Ca_Dll_Pll_Traits::n_taps;
+constexpr int Gps_L2_M_Dll_Pll_Traits::n_taps;
+constexpr int Galileo_E1_B_Dll_Pll_Traits::n_taps;
+constexpr int Galileo_E1_C_Dll_Pll_Traits::n_taps;
+constexpr int Galileo_E5a_Dll_Pll_Traits::n_taps;
+
+
+void Gps_L1_Ca_Dll_Pll_Traits::loop_code(std::complex<float>* dest, unsigned int prn)
+{
+    Gnss_Code_Bank::expand(dest, Gnss_Code_Bank::instance().code(GPS_L1_CA_CODE, prn), nullptr,
+            static_cast<unsigned int>(code_length_chips), 0, 1.0f);
+}
+
+
+void Gps_L2_M_Dll_Pll_Traits::loop_code(std::complex<float>* dest, unsigned int prn)
+{
+    Gnss_Code_Bank::expand(dest, Gnss_Code_Bank::instance().code(GPS_L2_M_CODE, prn), nullptr,
+            static_cast<unsigned int>(code_length_chips), 0, 1.0f);
+}
+
+
+void Galileo_E1_B_Dll_Pll_Traits::loop_code(std::complex<float>* dest, unsigned int prn)
+{
+    char signal_b[3] = "1B";
+    galileo_e1_code_gen_complex_sampled(dest, signal_b, false, prn, static_cast<signed int>(samples_per_chip * Galileo_E1_CODE_CHIP_RATE_HZ), 0);
+}
+
+
+void Galileo_E1_C_Dll_Pll_Traits::loop_code(std::complex<float>* dest, unsigned int prn)
+{
+    char signal_c[3] = "1C";
+    galileo_e1_code_gen_complex_sampled(dest, signal_c, false, prn, static_cast<signed int>(samples_per_chip * Galileo_E1_CODE_CHIP_RATE_HZ), 0);
+}
+
+
+void Galileo_E1_C_Dll_Pll_Traits::data_code(std::complex<float>* dest, unsigned int prn)
+{
+    Galileo_E1_B_Dll_Pll_Traits::loop_code(dest, prn);
+}
+
+
+void Galileo_E5a_Dll_Pll_Traits::loop_code(std::complex<float>* dest, unsigned int prn)
+{
+    Gnss_Code_Bank::expand(dest, nullptr, Gnss_Code_Bank::instance().code(GALILEO_E5A_Q_CODE, prn),
+            static_cast<unsigned int>(code_length_chips), 0, 1.0f);
+}
+
+
+void Galileo_E5a_Dll_Pll_Traits::data_code(std::complex<float>* dest, unsigned int prn)
+{
+    Gnss_Code_Bank::expand(dest, Gnss_Code_Bank::instance().code(GALILEO_E5A_I_CODE, prn), nullptr,
+            static_cast<unsigned int>(code_length_chips), 0, 1.0f);
+}
@@ -0,0 +1,213 @@
+/*!
+ * \file dll_pll_signal_traits.h
+ * \brief Compile-time description of the signals tracked by dll_pll_tracking
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DLL_PLL_SIGNAL_TRAITS_H_
+#define GNSS_SDR_DLL_PLL_SIGNAL_TRAITS_H_
+
+#include <complex>
+#include "Galileo_E1.h"
+#include "Galileo_E5a.h"
+#include "GPS_L1_CA.h"
+#include "GPS_L2C.h"
+
+/*
+ * Each traits class describes one signal to the dll_pll_tracking template:
+ *
+ *  - system, signal(): system character and signal code of the Gnss_Synchro.
+ *  - code_length_chips, code_rate_hz(), code_period_s(): primary code.
+ *  - samples_per_chip: resolution of the local replica (2 for the BOC signals).
+ *  - n_taps: 3 (Early, Prompt, Late) or 5 (Very Early, Early, Prompt, Late, Very Late).
+ *  - pilot: the loop tracks the pilot component given by loop_code(), and a
+ *    single prompt correlator despreads the data component given by data_code().
+ *  - secondary_code_length, secondary_chip(): secondary code of the component
+ *    tracked by the loop (0 if none). Once it is synchronized, it is wiped off
+ *    and the coherent integration can be extended.
+ *  - data_secondary_code_length, data_secondary_chip(): secondary code of the
+ *    data component of a pilot signal, wiped off from its prompt output.
+ *  - cn0_estimation_samples, carrier_lock_threshold(): default window and
+ *    threshold of the lock detectors. The secondary code is searched for in
+ *    the signs of the prompts of its last period, at each lock check.
+ *  - correlation_length_ms: length of each prompt output.
+ *
+ * The integers are compile-time constants, so that the loops over the taps are
+ * unrolled and the unused signal components are compiled out. The floating
+ * point constants are returned by inline functions, which are folded as well.
+ */
+
+/*!
+ * \brief GPS L1 C/A (and SBAS L1)
+ */
+class Gps_L1_Ca_Dll_Pll_Traits
+{
+public:
+    static constexpr char system = 'G';
+    static constexpr int code_length_chips = 1023;
+    static constexpr int samples_per_chip = 1;
+    static constexpr int n_taps = 3;
+    static constexpr bool pilot = false;
+    static constexpr int secondary_code_length = 0;
+    static constexpr int data_secondary_code_length = 0;
+    static constexpr int cn0_estimation_samples = 20;
+    static constexpr int correlation_length_ms = 1;
+
+    static const char* signal() { return "1C"; }
+    static double code_rate_hz() { return GPS_L1_CA_CODE_RATE_HZ; }
+    static double code_period_s() { return GPS_L1_CA_CODE_PERIOD; }
+    static double carrier_freq_hz() { return GPS_L1_FREQ_HZ; }
+    static double carrier_lock_threshold() { return 0.85; }
+    static void loop_code(std::complex<float>* dest, unsigned int prn);
+    static void data_code(std::complex<float>* dest __attribute__((unused)), unsigned int prn __attribute__((unused))) {}
+    static int secondary_chip(unsigned int prn __attribute__((unused)), int k __attribute__((unused))) { return 1; }
+    static int data_secondary_chip(int k __attribute__((unused))) { return 1; }
+};
+
+
+/*!
+ * \brief GPS L2C M
+ */
+class Gps_L2_M_Dll_Pll_Traits
+{
+public:
+    static constexpr char system = 'G';
+    static constexpr int code_length_chips = GPS_L2_M_CODE_LENGTH_CHIPS;
+    static constexpr int samples_per_chip = 1;
+    static constexpr int n_taps = 3;
+    static constexpr bool pilot = false;
+    static constexpr int secondary_code_length = 0;
+    static constexpr int data_secondary_code_length = 0;
+    static constexpr int cn0_estimation_samples = 10;
+    static constexpr int correlation_length_ms = 20;
+
+    static const char* signal() { return "2S"; }
+    static double code_rate_hz() { return GPS_L2_M_CODE_RATE_HZ; }
+    static double code_period_s() { return GPS_L2_M_PERIOD; }
+    static double carrier_freq_hz() { return GPS_L2_FREQ_HZ; }
+    static double carrier_lock_threshold() { return 0.75; }
+    static void loop_code(std::complex<float>* dest, unsigned int prn);
+    static void data_code(std::complex<float>* dest __attribute__((unused)), unsigned int prn __attribute__((unused))) {}
+    static int secondary_chip(unsigned int prn __attribute__((unused)), int k __attribute__((unused))) { return 1; }
+    static int data_secondary_chip(int k __attribute__((unused))) { return 1; }
+};
+
+
+/*!
+ * \brief Galileo E1 B, with a sinBOC(1,1) replica
+ */
+class Galileo_E1_B_Dll_Pll_Traits
+{
+public:
+    static constexpr char system = 'E';
+    static constexpr int code_length_chips = 4092;
+    static constexpr int samples_per_chip = 2;
+    static constexpr int n_taps = 5;
+    static constexpr bool pilot = false;
+    static constexpr int secondary_code_length = 0;
+    static constexpr int data_secondary_code_length = 0;
+    static constexpr int cn0_estimation_samples = 20;
+    static constexpr int correlation_length_ms = 4;
+
+    static const char* signal() { return "1B"; }
+    static double code_rate_hz() { return Galileo_E1_CODE_CHIP_RATE_HZ; }
+    static double code_period_s() { return Galileo_E1_CODE_PERIOD; }
+    static double carrier_freq_hz() { return Galileo_E1_FREQ_HZ; }
+    static double carrier_lock_threshold() { return 0.85; }
+    static void loop_code(std::complex<float>* dest, unsigned int prn);
+    static void data_code(std::complex<float>* dest __attribute__((unused)), unsigned int prn __attribute__((unused))) {}
+    static int secondary_chip(unsigned int prn __attribute__((unused)), int k __attribute__((unused))) { return 1; }
+    static int data_secondary_chip(int k __attribute__((unused))) { return 1; }
+};
+
+
+/*!
+ * \brief Galileo E1, tracked on the E1 C pilot. The CS25 secondary code is
+ * wiped off once synchronized, so that the coherent integration can be
+ * extended up to 100 ms. The E1 B data prompt is output for the telemetry.
+ */
+class Galileo_E1_C_Dll_Pll_Traits
+{
+public:
+    static constexpr char system = 'E';
+    static constexpr int code_length_chips = 4092;
+    static constexpr int samples_per_chip = 2;
+    static constexpr int n_taps = 5;
+    static constexpr bool pilot = true;
+    static constexpr int secondary_code_length = 25;
+    static constexpr int data_secondary_code_length = 0;
+    static constexpr int cn0_estimation_samples = 20;
+    static constexpr int correlation_length_ms = 4;
+
+    static const char* signal() { return "1B"; }
+    static double code_rate_hz() { return Galileo_E1_CODE_CHIP_RATE_HZ; }
+    static double code_period_s() { return Galileo_E1_CODE_PERIOD; }
+    static double carrier_freq_hz() { return Galileo_E1_FREQ_HZ; }
+    static double carrier_lock_threshold() { return 0.85; }
+    static void loop_code(std::complex<float>* dest, unsigned int prn);
+    static void data_code(std::complex<float>* dest, unsigned int prn);
+    static int secondary_chip(unsigned int prn __attribute__((unused)), int k)
+    {
+        return Galileo_E1_C_SECONDARY_CODE[k] == '0' ? 1 : -1;
+    }
+    static int data_secondary_chip(int k __attribute__((unused))) { return 1; }
+};
+
+
+/*!
+ * \brief Galileo E5a, tracked on the Q (pilot) component
+ */
+class Galileo_E5a_Dll_Pll_Traits
+{
+public:
+    static constexpr char system = 'E';
+    static constexpr int code_length_chips = Galileo_E5a_CODE_LENGTH_CHIPS;
+    static constexpr int samples_per_chip = 1;
+    static constexpr int n_taps = 3;
+    static constexpr bool pilot = true;
+    static constexpr int secondary_code_length = Galileo_E5a_Q_SECONDARY_CODE_LENGTH;
+    static constexpr int data_secondary_code_length = Galileo_E5a_I_SECONDARY_CODE_LENGTH;
+    static constexpr int cn0_estimation_samples = 20;
+    static constexpr int correlation_length_ms = 1;
+
+    static const char* signal() { return "5X"; }
+    static double code_rate_hz() { return Galileo_E5a_CODE_CHIP_RATE_HZ; }
+    static double code_period_s() { return GALILEO_E5a_CODE_PERIOD; }
+    static double carrier_freq_hz() { return Galileo_E5a_FREQ_HZ; }
+    static double carrier_lock_threshold() { return 0.85; }
+    static void loop_code(std::complex<float>* dest, unsigned int prn);
+    static void data_code(std::complex<float>* dest, unsigned int prn);
+    static int secondary_chip(unsigned int prn, int k)
+    {
+        return Galileo_E5a_Q_SECONDARY_CODE[prn - 1][k] == '0' ? 1 : -1;
+    }
+    static int data_secondary_chip(int k)
+    {
+        return Galileo_E5a_I_SECONDARY_CODE[k] == '0' ? 1 : -1;
+    }
+};
+
+#endif /* GNSS_SDR_DLL_PLL_SIGNAL_TRAITS_H_ */
@@ -0,0 +1,930 @@
+/*!
+ * \file dll_pll_tracking.cc
+ * \brief Implementation of a DLL + PLL tracking block for any signal, as a
+ * template on the signal traits and the sample type
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "dll_pll_tracking.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <boost/lexical_cast.hpp>
+#include <gnuradio/io_signature.h>
+#include <glog/logging.h>
+#include <volk/volk.h>
+#include "dll_pll_signal_traits.h"
+#include "gnss_correlation_shape.h"
+#include "tracking_discriminators.h"
+
+
+#define DLL_PLL_MAXIMUM_LOCK_FAIL_COUNTER 50
+#define DLL_PLL_TWO_PI 6.283185307179586
+#define DLL_PLL_MAXIMUM_BW_PDI 0.1 // largest stable loop bandwidth [Hz] times integration time [s]
+#define DLL_PLL_SECONDARY_MIN_CORRELATION 0.7 // fraction of the prompt signs the secondary code delay must match
+#define DLL_PLL_SECONDARY_MAX_RUNNER_UP 0.5   // largest correlation of any other delay, relative to the best one
+#define DLL_PLL_MINIMUM_LOCK_WINDOW 5 // fewest prompts of each lock estimate at the longest integrations
+
+
+using google::LogMessage;
+
+namespace
+{
+template <typename T>
+void convert_code(std::complex<T>* dest, const gr_complex* src, int length)
+{
+    for (int i = 0; i < length; i++)
+        {
+            dest[i] = std::complex<T>(static_cast<T>(src[i].real()), static_cast<T>(src[i].imag()));
+        }
+}
+
+template <typename T>
+inline gr_complex to_gr_complex(const std::complex<T>& value)
+{
+    return gr_complex(static_cast<float>(value.real()), static_cast<float>(value.imag()));
+}
+}
+
+
+dll_pll_tracking_base::dll_pll_tracking_base(const std::string& name, size_t item_size) :
+        gr::block(name, gr::io_signature::make(1, 1, item_size),
+                gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
+{}
+
+
+template <class Traits, typename SampleT>
+dll_pll_tracking_base_sptr dll_pll_make_tracking(const Dll_Pll_Conf& conf)
+{
+    return dll_pll_tracking_base_sptr(new dll_pll_tracking<Traits, SampleT>(conf));
+}
+
+
+template <class Traits, typename SampleT>
+constexpr int dll_pll_tracking<Traits, SampleT>::replica_length;
+template <class Traits, typename SampleT>
+constexpr int dll_pll_tracking<Traits, SampleT>::prompt_tap;
+template <class Traits, typename SampleT>
+constexpr int dll_pll_tracking<Traits, SampleT>::secondary_period;
+template <class Traits, typename SampleT>
+constexpr int dll_pll_tracking<Traits, SampleT>::data_secondary_period;
+
+
+template <class Traits, typename SampleT>
+void dll_pll_tracking<Traits, SampleT>::forecast (int noutput_items,
+        gr_vector_int &ninput_items_required)
+{
+    if (noutput_items != 0)
+        {
+            ninput_items_required[0] = static_cast<int>(d_conf.vector_length) * 2; //set the required available samples in each call
+        }
+}
+
+
+template <class Traits, typename SampleT>
+dll_pll_tracking<Traits, SampleT>::dll_pll_tracking(const Dll_Pll_Conf& conf) :
+        dll_pll_tracking_base("dll_pll_tracking", sizeof(SampleT))
+{
+    // Telemetry bit synchronization message port input
+    this->message_port_register_in(pmt::mp("preamble_timestamp_s"));
+    this->message_port_register_out(pmt::mp("events"));
+    this->message_port_register_out(pmt::mp("correlation_shape"));
+
+    // initialize internal vars
+    d_conf = conf;
+    d_current_prn_length_samples = static_cast<int>(d_conf.vector_length);
+
+    // Initialize tracking  ==========================================
+    d_code_loop_filter.set_pdi(Traits::code_period_s());
+    d_carrier_loop_filter.set_pdi(Traits::code_period_s());
+    d_code_loop_filter.set_DLL_BW(d_conf.dll_bw_hz);
+    d_carrier_loop_filter.set_PLL_BW(d_conf.pll_bw_hz);
+
+    // Local code replicas, with Traits::samples_per_chip samples per chip
+    d_local_code = static_cast<SampleT*>(volk_malloc(replica_length * sizeof(SampleT), volk_get_alignment()));
+
+    // correlator outputs (scalar)
+    d_correlator_outs = static_cast<correlator_output_type*>(volk_malloc(Traits::n_taps * sizeof(correlator_output_type), volk_get_alignment()));
+    d_local_code_shift_chips = static_cast<float*>(volk_malloc(Traits::n_taps * sizeof(float), volk_get_alignment()));
+    // Set TAPs delay values [replica samples]
+    if (Traits::n_taps == 5)
+        {
+            d_local_code_shift_chips[0] = - d_conf.very_early_late_space_chips * Traits::samples_per_chip;
+            d_local_code_shift_chips[4] = d_conf.very_early_late_space_chips * Traits::samples_per_chip;
+        }
+    d_local_code_shift_chips[prompt_tap - 1] = - d_conf.early_late_space_chips * Traits::samples_per_chip;
+    d_local_code_shift_chips[prompt_tap] = 0.0;
+    d_local_code_shift_chips[prompt_tap + 1] = d_conf.early_late_space_chips * Traits::samples_per_chip;
+    d_correlator.init(2 * d_conf.vector_length, Traits::n_taps);
+
+    // Correlation shape monitor: an odd number of taps (an even monitor_taps is
+    // rounded up, the adapter warns about it), centered on the prompt, in a
+    // correlator that also computes the tracking taps
+    d_monitor_taps = d_conf.monitor_taps > 0 ? (d_conf.monitor_taps | 1) : 0;
+    d_monitor_shift_chips = nullptr;
+    d_monitor_outs = nullptr;
+    if (d_monitor_taps > 0)
+        {
+            const int n_correlators = Traits::n_taps + d_monitor_taps;
+            d_monitor_shift_chips = static_cast<float*>(volk_malloc(n_correlators * sizeof(float), volk_get_alignment()));
+            d_monitor_outs = static_cast<correlator_output_type*>(volk_malloc(n_correlators * sizeof(correlator_output_type), volk_get_alignment()));
+            for (int n = 0; n < Traits::n_taps; n++)
+                {
+                    d_monitor_shift_chips[n] = d_local_code_shift_chips[n];
+                }
+            for (int k = 0; k < d_monitor_taps; k++)
+                {
+                    d_monitor_shift_chips[Traits::n_taps + k] = static_cast<float>(k - d_monitor_taps / 2) * d_conf.monitor_spacing_chips * Traits::samples_per_chip;
+                }
+            d_monitor_correlator.init(2 * d_conf.vector_length, n_correlators);
+            d_monitor_shape.resize(d_monitor_taps);
+        }
+    d_monitoring = false;
+    d_monitor_epoch_counter = 0;
+    d_monitor_timestamp_secs = 0.0;
+
+    // Single prompt correlator of the data component
+    d_data_code = nullptr;
+    d_data_prompt_out = nullptr;
+    if (Traits::pilot)
+        {
+            d_data_code = static_cast<SampleT*>(volk_malloc(replica_length * sizeof(SampleT), volk_get_alignment()));
+            d_data_prompt_out = static_cast<correlator_output_type*>(volk_malloc(sizeof(correlator_output_type), volk_get_alignment()));
+            d_data_correlator.init(2 * d_conf.vector_length, 1);
+        }
+
+    for (int n = 0; n < Traits::n_taps; n++)
+        {
+            d_correlator_outs[n] = correlator_output_type(0, 0);
+            d_epoch_outs[n] = gr_complex(0, 0);
+            d_accumulated_outs[n] = gr_complex(0, 0);
+        }
+    d_data_prompt = gr_complex(0, 0);
+
+    //--- Perform initializations ------------------------------
+    // define initial code frequency basis of NCO
+    d_code_freq_chips = Traits::code_rate_hz();
+    // define residual code phase (in chips)
+    d_rem_code_phase_samples = 0.0;
+    // define residual carrier phase
+    d_rem_carr_phase_rad = 0.0;
+
+    // sample synchronization
+    d_sample_counter = 0;
+    d_acq_sample_stamp = 0;
+
+    d_enable_tracking = false;
+    d_pull_in = false;
+
+    d_secondary_lock = false;
+    d_secondary_index = 0;
+    d_data_symbol_sync = false;
+    d_integration_epochs = 1;
+    d_integration_counter = 0;
+
+    d_carr_error_hz = 0.0;
+    d_carr_error_filt_hz = 0.0;
+    d_code_error_chips = 0.0;
+    d_code_error_filt_chips = 0.0;
+    d_code_error_filt_secs = 0.0;
+
+    // CN0 estimation and lock detectors
+    d_lock_window = d_conf.cn0_samples > 0 ? d_conf.cn0_samples : Traits::cn0_estimation_samples;
+    d_lock_detector.set_window(d_lock_window);
+    d_lock_detector.set_cn0_threshold(d_conf.cn0_min);
+    d_lock_detector.set_carrier_lock_threshold(d_conf.carrier_lock_th > 0.0 ? d_conf.carrier_lock_th : Traits::carrier_lock_threshold());
+    d_prompt_counter = 0;
+    d_carrier_lock_test = 1;
+    d_CN0_SNV_dB_Hz = 0;
+    d_carrier_lock_fail_counter = 0;
+
+    systemName["G"] = std::string("GPS");
+    systemName["S"] = std::string("SBAS");
+    systemName["E"] = std::string("Galileo");
+
+    d_acquisition_gnss_synchro = 0;
+    d_channel = 0;
+    d_acq_code_phase_samples = 0.0;
+    d_acq_carrier_doppler_hz = 0.0;
+    d_carrier_doppler_hz = 0.0;
+    d_acc_carrier_phase_rad = 0.0;
+
+    set_relative_rate(1.0 / static_cast<double>(d_conf.vector_length));
+}
+
+
+template <class Traits, typename SampleT>
+void dll_pll_tracking<Traits, SampleT>::start_tracking()
+{
+    /*
+     *  correct the code phase according to the delay between acq and trk
+     */
+    d_acq_code_phase_samples = d_acquisition_gnss_synchro->Acq_delay_samples;
+    d_acq_carrier_doppler_hz = d_acquisition_gnss_synchro->Acq_doppler_hz;
+    d_acq_sample_stamp = d_acquisition_gnss_synchro->Acq_samplestamp_samples;
+
+    long int acq_trk_diff_samples = static_cast<long int>(d_sample_counter) - static_cast<long int>(d_acq_sample_stamp);
+    DLOG(INFO) << "Number of samples between Acquisition and Tracking =" << acq_trk_diff_samples;
+    double acq_trk_diff_seconds = static_cast<double>(acq_trk_diff_samples) / static_cast<double>(d_conf.fs_in);
+    // Doppler effect Fd=(C/(C+Vr))*F
+    double radial_velocity = (Traits::carrier_freq_hz() + d_acq_carrier_doppler_hz) / Traits::carrier_freq_hz();
+    // new chip and prn sequence periods based on acq Doppler
+    d_code_freq_chips = radial_velocity * Traits::code_rate_hz();
+    double T_prn_mod_seconds = Traits::code_length_chips / d_code_freq_chips;
+    double T_prn_mod_samples = T_prn_mod_seconds * static_cast<double>(d_conf.fs_in);
+
+    d_current_prn_length_samples = std::round(T_prn_mod_samples);
+
+    double T_prn_true_seconds = Traits::code_length_chips / Traits::code_rate_hz();
+    double T_prn_true_samples = T_prn_true_seconds * static_cast<double>(d_conf.fs_in);
+    double T_prn_diff_seconds = T_prn_true_seconds - T_prn_mod_seconds;
+    double N_prn_diff = acq_trk_diff_seconds / T_prn_true_seconds;
+    double corrected_acq_phase_samples = std::fmod((d_acq_code_phase_samples + T_prn_diff_seconds * N_prn_diff * static_cast<double>(d_conf.fs_in)), T_prn_true_samples);
+    if (corrected_acq_phase_samples < 0)
+        {
+            corrected_acq_phase_samples = T_prn_mod_samples + corrected_acq_phase_samples;
+        }
+    double delay_correction_samples = d_acq_code_phase_samples - corrected_acq_phase_samples;
+    d_acq_code_phase_samples = corrected_acq_phase_samples;
+
+    d_carrier_doppler_hz = d_acq_carrier_doppler_hz;
+
+    // DLL/PLL filter initialization, with the bandwidths used until the secondary code is synchronized
+    d_code_loop_filter.set_DLL_BW(d_conf.dll_bw_hz);
+    d_carrier_loop_filter.set_PLL_BW(d_conf.pll_bw_hz);
+    d_carrier_loop_filter.initialize(); // initialize the carrier filter
+    d_code_loop_filter.initialize();    // initialize the code filter
+
+    // generate local reference ALWAYS starting at chip 1
+    std::vector<gr_complex> code(replica_length);
+    Traits::loop_code(code.data(), d_acquisition_gnss_synchro->PRN);
+    convert_code(d_local_code, code.data(), replica_length);
+    d_correlator.set_local_code_and_taps(replica_length, d_local_code, d_local_code_shift_chips);
+    if (Traits::pilot)
+        {
+            Traits::data_code(code.data(), d_acquisition_gnss_synchro->PRN);
+            convert_code(d_data_code, code.data(), replica_length);
+            d_data_correlator.set_local_code_and_taps(replica_length, d_data_code, &d_local_code_shift_chips[prompt_tap]);
+        }
+    if (d_monitor_taps > 0)
+        {
+            d_monitor_correlator.set_local_code_and_taps(replica_length, d_local_code, d_monitor_shift_chips);
+        }
+    d_monitoring = false;
+    d_monitor_epoch_counter = 0;
+    for (int n = 0; n < Traits::n_taps; n++)
+        {
+            d_correlator_outs[n] = correlator_output_type(0, 0);
+            d_accumulated_outs[n] = gr_complex(0, 0);
+        }
+
+    d_secondary_lock = false;
+    d_secondary_index = 0;
+    d_data_symbol_sync = false;
+    d_integration_counter = 0;
+    d_code_error_filt_secs = 0.0;
+
+    d_lock_detector.reset();
+    set_integration_epochs(1);
+    d_prompt_counter = 0;
+    d_carrier_lock_fail_counter = 0;
+    d_rem_code_phase_samples = 0.0;
+    d_rem_carr_phase_rad = 0.0;
+    d_acc_carrier_phase_rad = 0.0;
+
+    std::string sys_ = &d_acquisition_gnss_synchro->System;
+    sys = sys_.substr(0, 1);
+
+    // DEBUG OUTPUT
+    std::cout << "Tracking start on channel " << d_channel << " for satellite " << Gnss_Satellite(systemName[sys], d_acquisition_gnss_synchro->PRN) << std::endl;
+    LOG(INFO) << "Starting tracking of satellite " << Gnss_Satellite(systemName[sys], d_acquisition_gnss_synchro->PRN) << " on channel " << d_channel;
+
+    // enable tracking
+    d_pull_in = true;
+    d_enable_tracking = true;
+
+    LOG(INFO) << "PULL-IN Doppler [Hz]=" << d_carrier_doppler_hz
+              << " Code Phase correction [samples]=" << delay_correction_samples
+              << " PULL-IN Code Phase [samples]=" << d_acq_code_phase_samples;
+}
+
+
+template <class Traits, typename SampleT>
+dll_pll_tracking<Traits, SampleT>::~dll_pll_tracking()
+{
+    d_dump_file.close();
+    d_monitor_dump_file.close();
+
+    volk_free(d_local_code_shift_chips);
+    volk_free(d_correlator_outs);
+    volk_free(d_local_code);
+    d_correlator.free();
+    if (Traits::pilot)
+        {
+            volk_free(d_data_prompt_out);
+            volk_free(d_data_code);
+            d_data_correlator.free();
+        }
+    if (d_monitor_taps > 0)
+        {
+            volk_free(d_monitor_shift_chips);
+            volk_free(d_monitor_outs);
+            d_monitor_correlator.free();
+        }
+}
+
+
+template <class Traits, typename SampleT>
+int dll_pll_tracking<Traits, SampleT>::extended_epochs() const
+{
+    return std::max(1, std::min(d_conf.extend_correlation_ms
+            / static_cast<int>(std::round(Traits::code_period_s() * 1000.0)), secondary_period));
+}
+
+
+/*
+ * Sets the primary code periods of each coherent integration, and scales the
+ * lock detector window with them, so that a lock estimate takes about the same
+ * time at any integration. The loop bandwidths are set by the caller.
+ */
+template <class Traits, typename SampleT>
+void dll_pll_tracking<Traits, SampleT>::set_integration_epochs(int epochs)
+{
+    d_integration_epochs = epochs;
+    double pdi = d_integration_epochs * Traits::code_period_s();
+    d_code_loop_filter.set_pdi(pdi);
+    d_carrier_loop_filter.set_pdi(pdi);
+    d_lock_detector.set_integration(d_conf.fs_in, static_cast<double>(d_integration_epochs) * Traits::code_length_chips);
+    d_lock_detector.set_window(std::max(std::min(d_lock_window, DLL_PLL_MINIMUM_LOCK_WINDOW), d_lock_window / d_integration_epochs));
+}
+
+
+/*
+ * Searches the secondary code in the signs of the prompt outputs (each one of
+ * a single primary code period) of its last whole period, where the
+ * correlation of any wrong delay is low. The best delay is accepted if it
+ * matches most of the signs, and no other delay is close to it, so that a few
+ * sign errors of a weak or not yet locked signal do not prevent the
+ * synchronization. The carrier NCO is rotated half a cycle if needed, so that
+ * the four quadrant discriminator locks without slipping.
+ */
+template <class Traits, typename SampleT>
+void dll_pll_tracking<Traits, SampleT>::acquire_secondary()
+{
+    const int length = secondary_period;
+    if (d_prompt_counter < static_cast<unsigned int>(length))
+        {
+            return;
+        }
+    // d_Prompt_buffer is circular, the oldest prompt is the next one to be overwritten
+    const int oldest = d_prompt_counter % length;
+    int signs[secondary_period];
+    for (int j = 0; j < length; j++)
+        {
+            signs[j] = d_Prompt_buffer[(oldest + j) % length].real() > 0 ? 1 : -1;
+        }
+    int best_corr = 0;
+    int second_corr = 0;
+    int best_delay = 0;
+    int best_sign = 1;
+    for (int delay = 0; delay < length; delay++)
+        {
+            int corr = 0;
+            for (int j = 0; j < length; j++)
+                {
+                    corr += signs[j] * Traits::secondary_chip(d_acquisition_gnss_synchro->PRN, (delay + j) % length);
+                }
+            if (std::abs(corr) > best_corr)
+                {
+                    second_corr = best_corr;
+                    best_corr = std::abs(corr);
+                    best_delay = delay;
+                    best_sign = corr > 0 ? 1 : -1;
+                }
+            else if (std::abs(corr) > second_corr)
+                {
+                    second_corr = std::abs(corr);
+                }
+        }
+    if (best_corr >= DLL_PLL_SECONDARY_MIN_CORRELATION * length && second_corr < DLL_PLL_SECONDARY_MAX_RUNNER_UP * best_corr)
+        {
+            d_secondary_lock = true;
+            // chip of the last buffered epoch, which is the current one
+            d_secondary_index = (best_delay + length - 1) % length;
+            if (best_sign < 0)
+                {
+                    d_rem_carr_phase_rad = std::fmod(d_rem_carr_phase_rad + DLL_PLL_TWO_PI / 2.0, DLL_PLL_TWO_PI);
+                    d_acc_carrier_phase_rad -= DLL_PLL_TWO_PI / 2.0;
+                }
+        }
+}
+
+
+/*
+ * Discriminators and loop filters, once per coherent integration
+ */
+template <class Traits, typename SampleT>
+void dll_pll_tracking<Traits, SampleT>::update_loop()
+{
+    // ################## PLL ##########################################################
+    // Without secondary code wipe-off (or data) the prompt sign is unknown: Costas discriminator
+    if (Traits::secondary_code_length > 0 && d_secondary_lock)
+        {
+            d_carr_error_hz = pll_four_quadrant_atan(d_accumulated_outs[prompt_tap]) / DLL_PLL_TWO_PI;
+        }
+    else
+        {
+            d_carr_error_hz = pll_cloop_two_quadrant_atan(d_accumulated_outs[prompt_tap]) / DLL_PLL_TWO_PI;
+        }
+    // Carrier discriminator filter
+    d_carr_error_filt_hz = d_carrier_loop_filter.get_carrier_nco(d_carr_error_hz);
+    // New carrier Doppler frequency estimation
+    d_carrier_doppler_hz = d_acq_carrier_doppler_hz + d_carr_error_filt_hz;
+    // New code Doppler frequency estimation
+    d_code_freq_chips = Traits::code_rate_hz() + ((d_carrier_doppler_hz * Traits::code_rate_hz()) / Traits::carrier_freq_hz());
+
+    // ################## DLL ##########################################################
+    // DLL discriminator
+    if (Traits::n_taps == 5)
+        {
+            d_code_error_chips = dll_nc_vemlp_normalized(d_accumulated_outs[0], d_accumulated_outs[1], d_accumulated_outs[3], d_accumulated_outs[4]); //[chips/Ti]
+        }
+    else
+        {
+            d_code_error_chips = dll_nc_e_minus_l_normalized(d_accumulated_outs[prompt_tap - 1], d_accumulated_outs[prompt_tap + 1]); //[chips/Ti]
+        }
+    // Code discriminator filter
+    d_code_error_filt_chips = d_code_loop_filter.get_code_nco(d_code_error_chips); //[chips/second]
+    // Code phase correction of each primary code period
+    d_code_error_filt_secs = (Traits::code_period_s() * d_code_error_filt_chips) / Traits::code_rate_hz(); //[seconds]
+
+    // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
+    if (Traits::secondary_code_length > 0 && !d_secondary_lock)
+        {
+            d_Prompt_buffer[d_prompt_counter % secondary_period] = d_accumulated_outs[prompt_tap];
+            d_prompt_counter++;
+        }
+    if (d_lock_detector.update(d_accumulated_outs[prompt_tap]))
+        {
+            check_lock();
+        }
+}
+
+
+template <class Traits, typename SampleT>
+void dll_pll_tracking<Traits, SampleT>::check_lock()
+{
+    bool lock_ok;
+    // Code periods covered by this lock estimate
+    const int check_epochs = d_lock_detector.get_window() * d_integration_epochs;
+    // Code lock indicator
+    d_CN0_SNV_dB_Hz = d_lock_detector.get_cn0_snv_db_hz();
+    if (Traits::secondary_code_length > 0 && !d_secondary_lock)
+        {
+            // The prompt signs follow the secondary code until it is wiped off
+            acquire_secondary();
+            if (d_secondary_lock)
+                {
+                    LOG(INFO) << "Secondary code locked in channel " << d_channel << ", delay " << d_secondary_index;
+                    d_code_loop_filter.set_DLL_BW(d_conf.dll_bw_narrow_hz);
+                    if (extended_epochs() == 1)
+                        {
+                            d_carrier_loop_filter.set_PLL_BW(d_conf.pll_bw_narrow_hz);
+                        }
+                }
+            lock_ok = d_secondary_lock;
+        }
+    else
+        {
+            // Carrier lock indicator
+            d_carrier_lock_test = d_lock_detector.get_carrier_lock_test();
+            lock_ok = d_lock_detector.carrier_lock() and d_lock_detector.code_lock();
+            if (d_lock_detector.cycle_slip())
+                {
+                    LOG(INFO) << "Possible cycle slip in channel " << d_channel;
+                }
+            if (Traits::secondary_code_length > 0 && lock_ok && d_integration_epochs < extended_epochs())
+                {
+                    // Extend the coherent integration in steps, once the loop is locked at
+                    // each one, so that the residual Doppler never rotates the prompt within
+                    // an integration. The PLL bandwidth is narrowed along down to pll_bw_narrow_hz
+                    // at the full extension, and both bandwidths are kept below the stability
+                    // limit of the loop filters at the new integration time.
+                    set_integration_epochs(std::min(extended_epochs(), d_integration_epochs * 4));
+                    float max_bw_hz = static_cast<float>(DLL_PLL_MAXIMUM_BW_PDI / (d_integration_epochs * Traits::code_period_s()));
+                    d_code_loop_filter.set_DLL_BW(std::min(d_conf.dll_bw_narrow_hz, max_bw_hz));
+                    if (d_integration_epochs == extended_epochs())
+                        {
+                            d_carrier_loop_filter.set_PLL_BW(std::min(d_conf.pll_bw_narrow_hz, max_bw_hz));
+                        }
+                    else
+                        {
+                            d_carrier_loop_filter.set_PLL_BW(std::min(std::max(d_conf.pll_bw_hz, d_conf.pll_bw_narrow_hz), max_bw_hz));
+                        }
+                    LOG(INFO) << "Coherent integration extended to " << d_integration_epochs << " code periods in channel " << d_channel;
+                }
+            else if (!lock_ok && d_integration_epochs > 1)
+                {
+                    // Go back to the shortest integration and the wide bandwidths, which pull
+                    // the loop in again faster, and extend again once it is locked
+                    set_integration_epochs(1);
+                    d_code_loop_filter.set_DLL_BW(d_conf.dll_bw_hz);
+                    d_carrier_loop_filter.set_PLL_BW(d_conf.pll_bw_hz);
+                    LOG(INFO) << "Lock check failed, coherent integration back to one code period in channel " << d_channel;
+                }
+        }
+    // Loss of lock detection. The counter is kept in code periods, so that the
+    // time to detect a loss of lock does not depend on the integration time
+    if (!lock_ok)
+        {
+            d_carrier_lock_fail_counter += check_epochs;
+        }
+    else
+        {
+            d_carrier_lock_fail_counter = std::max(0, d_carrier_lock_fail_counter - check_epochs);
+        }
+    if (d_carrier_lock_fail_counter > DLL_PLL_MAXIMUM_LOCK_FAIL_COUNTER * d_lock_window)
+        {
+            std::cout << "Loss of lock in channel " << d_channel << "!" << std::endl;
+            LOG(INFO) << "Loss of lock in channel " << d_channel << "!";
+            this->message_port_pub(pmt::mp("events"), pmt::from_long(3));//3 -> loss of lock
+            d_carrier_lock_fail_counter = 0;
+            d_enable_tracking = false;
+        }
+}
+
+
+/*
+ * Publishes the correlation function of the last coherent integration, and
+ * writes it to the dump file as the timestamp (double) followed by the
+ * monitor_taps correlator outputs (pairs of float I and Q), from the earliest.
+ */
+template <class Traits, typename SampleT>
+void dll_pll_tracking<Traits, SampleT>::publish_correlation_shape()
+{
+    std::shared_ptr<Gnss_Correlation_Shape> shape = std::make_shared<Gnss_Correlation_Shape>();
+    shape->System = Traits::system;
+    shape->PRN = d_acquisition_gnss_synchro->PRN;
+    shape->Channel_ID = static_cast<int>(d_channel);
+    shape->Tracking_timestamp_secs = d_monitor_timestamp_secs;
+    shape->Integration_time_s = d_integration_epochs * Traits::code_period_s();
+    shape->Spacing_chips = d_conf.monitor_spacing_chips;
+    shape->Correlation.assign(d_monitor_shape.begin(), d_monitor_shape.end());
+    this->message_port_pub(pmt::mp("correlation_shape"), pmt::make_any(shape));
+
+    if (d_monitor_dump_file.is_open())
+        {
+            try
+            {
+                    d_monitor_dump_file.write(reinterpret_cast<char*>(&d_monitor_timestamp_secs), sizeof(double));
+                    d_monitor_dump_file.write(reinterpret_cast<char*>(d_monitor_shape.data()), d_monitor_taps * sizeof(gr_complex));
+            }
+            catch (const std::ifstream::failure &e)
+            {
+                    LOG(WARNING) << "Exception writing trk correlation shape dump file " << e.what();
+            }
+        }
+}
+
+
+template <class Traits, typename SampleT>
+int dll_pll_tracking<Traits, SampleT>::general_work (int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
+        gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    // Block input data and block output stream pointers
+    const SampleT* in = reinterpret_cast<const SampleT*>(input_items[0]); //PRN start block alignment
+    Gnss_Synchro **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
+
+    // GNSS_SYNCHRO OBJECT to interchange data between tracking->telemetry_decoder
+    Gnss_Synchro current_synchro_data = Gnss_Synchro();
+
+    if (d_enable_tracking == true)
+        {
+            // Fill the acquisition data
+            current_synchro_data = *d_acquisition_gnss_synchro;
+            // Receiver signal alignment
+            if (d_pull_in == true)
+                {
+                    long int acq_to_trk_delay_samples = static_cast<long int>(d_sample_counter) - static_cast<long int>(d_acq_sample_stamp);
+                    double acq_trk_shif_correction_samples = d_current_prn_length_samples - std::fmod(static_cast<double>(acq_to_trk_delay_samples), static_cast<double>(d_current_prn_length_samples));
+                    int samples_offset = std::round(d_acq_code_phase_samples + acq_trk_shif_correction_samples);
+                    current_synchro_data.Tracking_timestamp_secs = (static_cast<double>(d_sample_counter) + d_rem_code_phase_samples) / static_cast<double>(d_conf.fs_in);
+                    d_sample_counter = d_sample_counter + samples_offset; //count for the processed samples
+                    d_pull_in = false;
+                    current_synchro_data.Flag_valid_symbol_output = false;
+                    *out[0] = current_synchro_data;
+                    consume_each(samples_offset); //shift input to perform alignment with local replica
+                    return 1;
+                }
+
+            // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
+            const double carrier_phase_step_rad = DLL_PLL_TWO_PI * (static_cast<double>(d_conf.if_freq) + d_carrier_doppler_hz) / static_cast<double>(d_conf.fs_in);
+            const double code_phase_step = d_code_freq_chips * Traits::samples_per_chip / static_cast<double>(d_conf.fs_in);
+            const double rem_code_phase = d_rem_code_phase_samples * code_phase_step;
+            // A correlation shape covers a whole coherent integration
+            if (d_monitor_taps > 0 && d_integration_counter == 0 && d_monitor_epoch_counter >= d_conf.monitor_period)
+                {
+                    d_monitoring = true;
+                    d_monitor_epoch_counter = 0;
+                    d_monitor_timestamp_secs = (static_cast<double>(d_sample_counter) + d_rem_code_phase_samples) / static_cast<double>(d_conf.fs_in);
+                    std::fill(d_monitor_shape.begin(), d_monitor_shape.end(), gr_complex(0, 0));
+                }
+            d_monitor_epoch_counter++;
+            if (d_monitoring)
+                {
+                    d_monitor_correlator.set_input_output_vectors(d_monitor_outs, in);
+                    d_monitor_correlator.Carrier_wipeoff_multicorrelator_resampler(d_rem_carr_phase_rad,
+                            carrier_phase_step_rad,
+                            rem_code_phase,
+                            code_phase_step,
+                            d_current_prn_length_samples);
+                    std::copy(d_monitor_outs, d_monitor_outs + Traits::n_taps, d_correlator_outs);
+                }
+            else
+                {
+                    d_correlator.set_input_output_vectors(d_correlator_outs, in);
+                    d_correlator.Carrier_wipeoff_multicorrelator_resampler(d_rem_carr_phase_rad,
+                            carrier_phase_step_rad,
+                            rem_code_phase,
+                            code_phase_step,
+                            d_current_prn_length_samples);
+                }
+            if (Traits::pilot)
+                {
+                    d_data_correlator.set_input_output_vectors(d_data_prompt_out, in);
+                    d_data_correlator.Carrier_wipeoff_multicorrelator_resampler(d_rem_carr_phase_rad,
+                            carrier_phase_step_rad,
+                            rem_code_phase,
+                            code_phase_step,
+                            d_current_prn_length_samples);
+                }
+
+            // Secondary code wipe-off and coherent integration
+            float secondary_chip = 1.0;
+            if (Traits::secondary_code_length > 0 && d_secondary_lock)
+                {
+                    secondary_chip = static_cast<float>(Traits::secondary_chip(d_acquisition_gnss_synchro->PRN, d_secondary_index));
+                }
+            if (d_integration_counter == 0)
+                {
+                    for (int n = 0; n < Traits::n_taps; n++)
+                        {
+                            d_accumulated_outs[n] = gr_complex(0, 0);
+                        }
+                }
+            for (int n = 0; n < Traits::n_taps; n++)
+                {
+                    d_epoch_outs[n] = to_gr_complex(d_correlator_outs[n]);
+                    d_accumulated_outs[n] += d_epoch_outs[n] * secondary_chip;
+                }
+            if (d_monitoring)
+                {
+                    for (int k = 0; k < d_monitor_taps; k++)
+                        {
+                            d_monitor_shape[k] += to_gr_complex(d_monitor_outs[Traits::n_taps + k]) * secondary_chip;
+                        }
+                }
+            if (Traits::pilot)
+                {
+                    d_data_prompt = to_gr_complex(*d_data_prompt_out);
+                    if (Traits::data_secondary_code_length > 0)
+                        {
+                            d_data_prompt *= static_cast<float>(Traits::data_secondary_chip(d_secondary_index % data_secondary_period));
+                        }
+                }
+            else
+                {
+                    d_data_prompt = d_epoch_outs[prompt_tap];
+                }
+
+            // Carrier phase of the next epoch, and accumulated carrier phase for the Doppler measurements
+            d_rem_carr_phase_rad = std::fmod(d_rem_carr_phase_rad + carrier_phase_step_rad * d_current_prn_length_samples, DLL_PLL_TWO_PI);
+            d_acc_carrier_phase_rad -= DLL_PLL_TWO_PI * d_carrier_doppler_hz * static_cast<double>(d_current_prn_length_samples) / static_cast<double>(d_conf.fs_in);
+
+            d_integration_counter++;
+            if (d_integration_counter == d_integration_epochs)
+                {
+                    d_integration_counter = 0;
+                    if (d_monitoring)
+                        {
+                            publish_correlation_shape();
+                            d_monitoring = false;
+                        }
+                    update_loop();
+                }
+
+            // ################## CARRIER AND CODE NCO BUFFER ALIGNEMENT #######################
+            // Compute the next buffer length based in the new period of the PRN sequence and the code phase error estimation
+            double T_prn_samples = Traits::code_length_chips / d_code_freq_chips * static_cast<double>(d_conf.fs_in);
+            double K_blk_samples = T_prn_samples + d_rem_code_phase_samples + d_code_error_filt_secs * static_cast<double>(d_conf.fs_in);
+
+            // ########### Output the tracking data to navigation and PVT ##########
+            // Tracking_timestamp_secs is aligned with the CURRENT PRN start sample
+            current_synchro_data.Tracking_timestamp_secs = (static_cast<double>(d_sample_counter) + d_rem_code_phase_samples) / static_cast<double>(d_conf.fs_in);
+            d_current_prn_length_samples = std::round(K_blk_samples); //round to a discrete samples
+            //compute remnant code phase samples AFTER the Tracking timestamp
+            d_rem_code_phase_samples = K_blk_samples - d_current_prn_length_samples; //rounding error < 1 sample
+
+            // The data symbols of a signal with a data secondary code start at its first chip
+            if (Traits::data_secondary_code_length > 0 && d_secondary_lock && (d_secondary_index % data_secondary_period) == 0)
+                {
+                    d_data_symbol_sync = true;
+                }
+            if (Traits::data_secondary_code_length == 0 || d_data_symbol_sync)
+                {
+                    current_synchro_data.Prompt_I = static_cast<double>(d_data_prompt.real());
+                    current_synchro_data.Prompt_Q = static_cast<double>(d_data_prompt.imag());
+                    current_synchro_data.Flag_valid_symbol_output = true;
+                }
+            else
+                {
+                    current_synchro_data.Prompt_I = 0.0;
+                    current_synchro_data.Prompt_Q = 0.0;
+                    current_synchro_data.Flag_valid_symbol_output = false;
+                }
+            // This tracking block aligns the Tracking_timestamp_secs with the start sample of the PRN, thus, Code_phase_secs=0
+            current_synchro_data.Code_phase_secs = 0;
+            current_synchro_data.Carrier_phase_rads = d_acc_carrier_phase_rad;
+            current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
+            current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
+            current_synchro_data.correlation_length_ms = Traits::correlation_length_ms;
+
+            if (Traits::secondary_code_length > 0 && d_secondary_lock)
+                {
+                    d_secondary_index = (d_secondary_index + 1) % secondary_period;
+                }
+        }
+    else
+        {
+            for (int n = 0; n < Traits::n_taps; n++)
+                {
+                    d_epoch_outs[n] = gr_complex(0, 0);
+                }
+            d_data_prompt = gr_complex(0, 0);
+            current_synchro_data.Tracking_timestamp_secs = (static_cast<double>(d_sample_counter) + d_rem_code_phase_samples) / static_cast<double>(d_conf.fs_in);
+            current_synchro_data.System = Traits::system;
+        }
+
+    //assign the GNURadio block output data
+    *out[0] = current_synchro_data;
+    if (d_conf.dump)
+        {
+            // MULTIPLEXED FILE RECORDING - Record results to file
+            float prompt_I = d_data_prompt.real();
+            float prompt_Q = d_data_prompt.imag();
+            float tmp_float;
+            double tmp_double;
+            try
+            {
+                // Magnitude of the correlator outputs, from the earliest to the latest
+                for (int n = 0; n < Traits::n_taps; n++)
+                    {
+                        tmp_float = std::abs(d_epoch_outs[n]);
+                        d_dump_file.write(reinterpret_cast<char*>(&tmp_float), sizeof(float));
+                    }
+                // PROMPT I and Q (to analyze navigation symbols)
+                d_dump_file.write(reinterpret_cast<char*>(&prompt_I), sizeof(float));
+                d_dump_file.write(reinterpret_cast<char*>(&prompt_Q), sizeof(float));
+                // PRN start sample stamp
+                d_dump_file.write(reinterpret_cast<char*>(&d_sample_counter), sizeof(unsigned long int));
+                // accumulated carrier phase
+                d_dump_file.write(reinterpret_cast<char*>(&d_acc_carrier_phase_rad), sizeof(double));
+
+                // carrier and code frequency
+                d_dump_file.write(reinterpret_cast<char*>(&d_carrier_doppler_hz), sizeof(double));
+                d_dump_file.write(reinterpret_cast<char*>(&d_code_freq_chips), sizeof(double));
+
+                //PLL commands
+                d_dump_file.write(reinterpret_cast<char*>(&d_carr_error_hz), sizeof(double));
+                d_dump_file.write(reinterpret_cast<char*>(&d_carr_error_filt_hz), sizeof(double));
+
+                //DLL commands
+                d_dump_file.write(reinterpret_cast<char*>(&d_code_error_chips), sizeof(double));
+                d_dump_file.write(reinterpret_cast<char*>(&d_code_error_filt_chips), sizeof(double));
+
+                // CN0 and carrier lock test
+                d_dump_file.write(reinterpret_cast<char*>(&d_CN0_SNV_dB_Hz), sizeof(double));
+                d_dump_file.write(reinterpret_cast<char*>(&d_carrier_lock_test), sizeof(double));
+
+                // AUX vars (for debug purposes)
+                tmp_double = d_rem_code_phase_samples;
+                d_dump_file.write(reinterpret_cast<char*>(&tmp_double), sizeof(double));
+                tmp_double = static_cast<double>(d_sample_counter + d_current_prn_length_samples);
+                d_dump_file.write(reinterpret_cast<char*>(&tmp_double), sizeof(double));
+            }
+            catch (const std::ifstream::failure &e)
+            {
+                    LOG(WARNING) << "Exception writing trk dump file " << e.what();
+            }
+        }
+
+    consume_each(d_current_prn_length_samples); // this is necessary in gr::block derivates
+    d_sample_counter += d_current_prn_length_samples; //count for the processed samples
+
+    return 1; //output tracking result ALWAYS even in the case of d_enable_tracking==false
+}
+
+
+template <class Traits, typename SampleT>
+void dll_pll_tracking<Traits, SampleT>::set_channel(unsigned int channel)
+{
+    d_channel = channel;
+    LOG(INFO) << "Tracking Channel set to " << d_channel;
+    // ############# ENABLE DATA FILE LOG #################
+    if (d_conf.dump == true)
+        {
+            if (d_dump_file.is_open() == false)
+                {
+                    try
+                    {
+                            std::string dump_filename = d_conf.dump_filename + boost::lexical_cast<std::string>(d_channel) + ".dat";
+                            d_dump_file.exceptions (std::ifstream::failbit | std::ifstream::badbit);
+                            d_dump_file.open(dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            LOG(INFO) << "Tracking dump enabled on channel " << d_channel << " Log file: " << dump_filename.c_str();
+                    }
+                    catch (const std::ifstream::failure &e)
+                    {
+                            LOG(WARNING) << "channel " << d_channel << " Exception opening trk dump file " << e.what();
+                    }
+                }
+            if (d_monitor_taps > 0 && d_monitor_dump_file.is_open() == false)
+                {
+                    try
+                    {
+                            std::string dump_filename = d_conf.dump_filename + boost::lexical_cast<std::string>(d_channel) + "_shape.dat";
+                            d_monitor_dump_file.exceptions (std::ifstream::failbit | std::ifstream::badbit);
+                            d_monitor_dump_file.open(dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            LOG(INFO) << "Correlation shape dump enabled on channel " << d_channel << " Log file: " << dump_filename.c_str();
+                    }
+                    catch (const std::ifstream::failure &e)
+                    {
+                            LOG(WARNING) << "channel " << d_channel << " Exception opening correlation shape dump file " << e.what();
+                    }
+                }
+        }
+}
+
+
+template <class Traits, typename SampleT>
+void dll_pll_tracking<Traits, SampleT>::set_gnss_synchro(Gnss_Synchro* p_gnss_synchro)
+{
+    d_acquisition_gnss_synchro = p_gnss_synchro;
+}
+
+
+// Signals and sample types available to the adapters
+template class dll_pll_tracking<Gps_L1_Ca_Dll_Pll_Traits, gr_complex>;
+template class dll_pll_tracking<Gps_L1_Ca_Dll_Pll_Traits, lv_16sc_t>;
+template class dll_pll_tracking<Gps_L1_Ca_Dll_Pll_Traits, lv_8sc_t>;
+template class dll_pll_tracking<Gps_L2_M_Dll_Pll_Traits, gr_complex>;
+template class dll_pll_tracking<Gps_L2_M_Dll_Pll_Traits, lv_16sc_t>;
+template class dll_pll_tracking<Gps_L2_M_Dll_Pll_Traits, lv_8sc_t>;
+template class dll_pll_tracking<Galileo_E1_B_Dll_Pll_Traits, gr_complex>;
+template class dll_pll_tracking<Galileo_E1_B_Dll_Pll_Traits, lv_16sc_t>;
+template class dll_pll_tracking<Galileo_E1_B_Dll_Pll_Traits, lv_8sc_t>;
+template class dll_pll_tracking<Galileo_E1_C_Dll_Pll_Traits, gr_complex>;
+template class dll_pll_tracking<Galileo_E1_C_Dll_Pll_Traits, lv_16sc_t>;
+template class dll_pll_tracking<Galileo_E1_C_Dll_Pll_Traits, lv_8sc_t>;
+template class dll_pll_tracking<Galileo_E5a_Dll_Pll_Traits, gr_complex>;
+template class dll_pll_tracking<Galileo_E5a_Dll_Pll_Traits, lv_16sc_t>;
+template class dll_pll_tracking<Galileo_E5a_Dll_Pll_Traits, lv_8sc_t>;
+
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Gps_L1_Ca_Dll_Pll_Traits, gr_complex>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Gps_L1_Ca_Dll_Pll_Traits, lv_16sc_t>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Gps_L1_Ca_Dll_Pll_Traits, lv_8sc_t>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Gps_L2_M_Dll_Pll_Traits, gr_complex>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Gps_L2_M_Dll_Pll_Traits, lv_16sc_t>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Gps_L2_M_Dll_Pll_Traits, lv_8sc_t>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Galileo_E1_B_Dll_Pll_Traits, gr_complex>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Galileo_E1_B_Dll_Pll_Traits, lv_16sc_t>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Galileo_E1_B_Dll_Pll_Traits, lv_8sc_t>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Galileo_E1_C_Dll_Pll_Traits, gr_complex>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Galileo_E1_C_Dll_Pll_Traits, lv_16sc_t>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Galileo_E1_C_Dll_Pll_Traits, lv_8sc_t>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Galileo_E5a_Dll_Pll_Traits, gr_complex>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Galileo_E5a_Dll_Pll_Traits, lv_16sc_t>(const Dll_Pll_Conf&);
+template dll_pll_tracking_base_sptr dll_pll_make_tracking<Galileo_E5a_Dll_Pll_Traits, lv_8sc_t>(const Dll_Pll_Conf&);
@@ -0,0 +1,252 @@
+/*!
+ * \file dll_pll_tracking.h
+ * \brief Interface of a DLL + PLL tracking block for any signal, as a template
+ * on the signal traits and the sample type
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DLL_PLL_TRACKING_H_
+#define GNSS_SDR_DLL_PLL_TRACKING_H_
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <gnuradio/block.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include "cpu_multicorrelator.h"
+#include "cpu_multicorrelator_16sc.h"
+#include "cpu_multicorrelator_8sc.h"
+#include "dll_pll_conf.h"
+#include "gnss_synchro.h"
+#include "tracking_2nd_DLL_filter.h"
+#include "tracking_2nd_PLL_filter.h"
+#include "tracking_lock_detector.h"
+
+
+/*!
+ * \brief Common interface of all the dll_pll_tracking instantiations, so that
+ * a single adapter drives any of them
+ */
+class dll_pll_tracking_base: public gr::block
+{
+public:
+    virtual ~dll_pll_tracking_base() {}
+    virtual void set_channel(unsigned int channel) = 0;
+    virtual void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro) = 0;
+    virtual void start_tracking() = 0;
+
+protected:
+    dll_pll_tracking_base(const std::string& name, size_t item_size);
+};
+
+typedef boost::shared_ptr<dll_pll_tracking_base> dll_pll_tracking_base_sptr;
+
+
+/*!
+ * \brief Correlator of each sample type: the local code is stored with the
+ * sample type, and the correlator outputs are converted to gr_complex.
+ */
+template <typename SampleT> class Dll_Pll_Correlator;
+
+template <> class Dll_Pll_Correlator<gr_complex>
+{
+public:
+    typedef cpu_multicorrelator type;
+    typedef gr_complex output_type;
+};
+
+template <> class Dll_Pll_Correlator<lv_16sc_t>
+{
+public:
+    typedef cpu_multicorrelator_16sc type;
+    typedef lv_16sc_t output_type;
+};
+
+template <> class Dll_Pll_Correlator<lv_8sc_t>
+{
+public:
+    typedef cpu_multicorrelator_8sc type;
+    typedef lv_32fc_t output_type;
+};
+
+
+template <class Traits, typename SampleT>
+dll_pll_tracking_base_sptr dll_pll_make_tracking(const Dll_Pll_Conf& conf);
+
+
+/*!
+ * \brief This class implements a DLL + PLL tracking loop block for the signal
+ * described by Traits (see dll_pll_signal_traits.h), on samples of type
+ * SampleT (gr_complex, lv_16sc_t or lv_8sc_t).
+ *
+ * Each call to general_work correlates one primary code period. If the signal
+ * has a secondary code on the component tracked by the loop, it is searched
+ * for in the prompt signs, and once synchronized it is wiped off, the
+ * discriminators switch to a four quadrant (pure PLL) one, and the loop
+ * switches to the narrow bandwidths. The coherent integration is then
+ * extended in steps of four, each one after a successful lock check, up to
+ * conf.extend_correlation_ms, with the bandwidths kept below 0.1 / T. The lock
+ * detector window shrinks as the integration grows, so that the lock checks
+ * (and the loss of lock detection) keep their pace, and a failed lock check
+ * takes the loop back to one code period and the wide bandwidths.
+ *
+ * If conf.monitor_taps is set, one coherent integration every
+ * conf.monitor_period code periods is also correlated with a dense set of
+ * conf.monitor_taps correlators centered on the prompt, and the correlation
+ * function is published on the "correlation_shape" message port (and dumped).
+ * The monitor correlators run in the same pass over the samples as the
+ * tracking ones, so the carrier wipe-off and the code resampling of each
+ * sample are shared, and the other integrations cost nothing extra.
+ */
+template <class Traits, typename SampleT>
+class dll_pll_tracking: public dll_pll_tracking_base
+{
+public:
+    ~dll_pll_tracking();
+
+    void set_channel(unsigned int channel);
+    void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro);
+    void start_tracking();
+
+    int general_work (int noutput_items, gr_vector_int &ninput_items,
+            gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
+
+    void forecast (int noutput_items, gr_vector_int &ninput_items_required);
+
+private:
+    friend dll_pll_tracking_base_sptr dll_pll_make_tracking<Traits, SampleT>(const Dll_Pll_Conf& conf);
+
+    dll_pll_tracking(const Dll_Pll_Conf& conf);
+
+    typedef typename Dll_Pll_Correlator<SampleT>::type correlator_type;
+    typedef typename Dll_Pll_Correlator<SampleT>::output_type correlator_output_type;
+
+    // Length of the local replica, in samples
+    static constexpr int replica_length = Traits::code_length_chips * Traits::samples_per_chip;
+    static constexpr int prompt_tap = Traits::n_taps / 2;
+    // Divisors that are valid even for the signals without secondary codes
+    static constexpr int secondary_period = Traits::secondary_code_length > 0 ? Traits::secondary_code_length : 1;
+    static constexpr int data_secondary_period = Traits::data_secondary_code_length > 0 ? Traits::data_secondary_code_length : 1;
+
+    void acquire_secondary();
+    // Primary code periods of each coherent integration once the secondary code is wiped off
+    int extended_epochs() const;
+    void set_integration_epochs(int epochs);
+    void update_loop();
+    void check_lock();
+    void publish_correlation_shape();
+
+    // tracking configuration vars
+    Dll_Pll_Conf d_conf;
+
+    Gnss_Synchro* d_acquisition_gnss_synchro;
+    unsigned int d_channel;
+
+    // remaining code phase and carrier phase between tracking loops
+    double d_rem_code_phase_samples;
+    double d_rem_carr_phase_rad;
+
+    // PLL and DLL filter library
+    Tracking_2nd_DLL_filter d_code_loop_filter;
+    Tracking_2nd_PLL_filter d_carrier_loop_filter;
+
+    // acquisition
+    double d_acq_code_phase_samples;
+    double d_acq_carrier_doppler_hz;
+
+    // correlators
+    SampleT* d_local_code;
+    SampleT* d_data_code;
+    float* d_local_code_shift_chips;
+    correlator_output_type* d_correlator_outs;
+    correlator_output_type* d_data_prompt_out;
+    correlator_type d_correlator;
+    correlator_type d_data_correlator;
+
+    // correlator outputs of the current epoch, and accumulated over the coherent integration
+    gr_complex d_epoch_outs[Traits::n_taps];
+    gr_complex d_accumulated_outs[Traits::n_taps];
+    gr_complex d_data_prompt;
+
+    // secondary code and coherent integration
+    bool d_secondary_lock;
+    int d_secondary_index;           // secondary code chip of the current epoch
+    bool d_data_symbol_sync;
+    int d_integration_epochs;
+    int d_integration_counter;
+
+    // loop discriminators and filter outputs (kept for the dump)
+    double d_carr_error_hz;
+    double d_carr_error_filt_hz;
+    double d_code_error_chips;
+    double d_code_error_filt_chips;
+    double d_code_error_filt_secs;
+
+    // tracking vars
+    double d_code_freq_chips;
+    double d_carrier_doppler_hz;
+    double d_acc_carrier_phase_rad;
+
+    // PRN period in samples
+    int d_current_prn_length_samples;
+
+    // processing samples counters
+    unsigned long int d_sample_counter;
+    unsigned long int d_acq_sample_stamp;
+
+    // CN0 estimation and lock detector
+    Tracking_Lock_Detector d_lock_detector;
+    int d_lock_window;               // prompts of each lock estimate with one code period integrations
+    unsigned int d_prompt_counter;   // prompts since the start of the secondary code search
+    gr_complex d_Prompt_buffer[secondary_period];  // prompts of the last secondary code period, searched for its delay
+    double d_carrier_lock_test;
+    double d_CN0_SNV_dB_Hz;
+    int d_carrier_lock_fail_counter;
+
+    // correlation shape monitor
+    int d_monitor_taps;
+    float* d_monitor_shift_chips;    // the tracking taps, followed by the monitor taps
+    correlator_output_type* d_monitor_outs;
+    correlator_type d_monitor_correlator;
+    std::vector<gr_complex> d_monitor_shape;
+    bool d_monitoring;               // the current coherent integration is monitored
+    int d_monitor_epoch_counter;
+    double d_monitor_timestamp_secs;
+    std::ofstream d_monitor_dump_file;
+
+    // control vars
+    bool d_enable_tracking;
+    bool d_pull_in;
+
+    // file dump
+    std::ofstream d_dump_file;
+
+    std::map<std::string, std::string> systemName;
+    std::string sys;
+};
+
+#endif /* GNSS_SDR_DLL_PLL_TRACKING_H_ */
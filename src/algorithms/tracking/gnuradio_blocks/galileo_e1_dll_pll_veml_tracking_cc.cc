@@ -45,7 +45,6 @@
 #include <volk/volk.h>
 #include "galileo_e1_signal_processing.h"
 #include "tracking_discriminators.h"
-#include "lock_detectors.h"
 #include "Galileo_E1.h"
 #include "control_message_factory.h"
 
@@ -175,13 +174,14 @@ galileo_e1_dll_pll_veml_tracking_cc::galileo_e1_dll_pll_veml_tracking_cc(
 
     d_current_prn_length_samples = static_cast<int>(d_vector_length);
 
-    // CN0 estimation and lock detector buffers
-    d_cn0_estimation_counter = 0;
-    d_Prompt_buffer = new gr_complex[CN0_ESTIMATION_SAMPLES];
+    // CN0 estimation and lock detector
+    d_lock_detector.set_window(CN0_ESTIMATION_SAMPLES);
+    d_lock_detector.set_integration(d_fs_in, Galileo_E1_B_CODE_LENGTH_CHIPS);
+    d_lock_detector.set_cn0_threshold(MINIMUM_VALID_CN0);
+    d_lock_detector.set_carrier_lock_threshold(CARRIER_LOCK_THRESHOLD);
     d_carrier_lock_test = 1;
     d_CN0_SNV_dB_Hz = 0;
     d_carrier_lock_fail_counter = 0;
-    d_carrier_lock_threshold = CARRIER_LOCK_THRESHOLD;
 
     systemName["E"] = std::string("Galileo");
     *d_Very_Early = gr_complex(0,0);
@@ -223,6 +223,7 @@ void galileo_e1_dll_pll_veml_tracking_cc::start_tracking()
             d_correlator_outs[n] = gr_complex(0,0);
         }
 
+    d_lock_detector.reset();
     d_carrier_lock_fail_counter = 0;
     d_rem_code_phase_samples = 0.0;
     d_rem_carr_phase_rad = 0.0;
@@ -255,7 +256,6 @@ galileo_e1_dll_pll_veml_tracking_cc::~galileo_e1_dll_pll_veml_tracking_cc()
     volk_free(d_correlator_outs);
     volk_free(d_ca_code);
 
-    delete[] d_Prompt_buffer;
     multicorrelator_cpu.free();
 }
 
@@ -353,24 +353,20 @@ int galileo_e1_dll_pll_veml_tracking_cc::general_work (int noutput_items __attri
             //d_rem_code_phase_samples = K_blk_samples - d_current_prn_length_samples; //rounding error < 1 sample
 
             // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
-            if (d_cn0_estimation_counter < CN0_ESTIMATION_SAMPLES)
+            if (d_lock_detector.update(*d_Prompt)) //prompt
                 {
-                    // fill buffer with prompt correlator output values
-                    d_Prompt_buffer[d_cn0_estimation_counter] = *d_Prompt;
-                    d_cn0_estimation_counter++;
-                }
-            else
-                {
-                    d_cn0_estimation_counter = 0;
-
                     // Code lock indicator
-                    d_CN0_SNV_dB_Hz = cn0_svn_estimator(d_Prompt_buffer, CN0_ESTIMATION_SAMPLES, d_fs_in, Galileo_E1_B_CODE_LENGTH_CHIPS);
+                    d_CN0_SNV_dB_Hz = d_lock_detector.get_cn0_snv_db_hz();
 
                     // Carrier lock indicator
-                    d_carrier_lock_test = carrier_lock_detector(d_Prompt_buffer, CN0_ESTIMATION_SAMPLES);
+                    d_carrier_lock_test = d_lock_detector.get_carrier_lock_test();
+                    if (d_lock_detector.cycle_slip())
+                        {
+                            LOG(INFO) << "Possible cycle slip in channel " << d_channel;
+                        }
 
                     // Loss of lock detection
-                    if (d_carrier_lock_test < d_carrier_lock_threshold or d_CN0_SNV_dB_Hz < MINIMUM_VALID_CN0)
+                    if (!d_lock_detector.carrier_lock() or !d_lock_detector.code_lock())
                         {
                             d_carrier_lock_fail_counter++;
                         }
@@ -39,6 +39,7 @@
 #include "gnss_synchro.h"
 #include "tracking_2nd_DLL_filter.h"
 #include "tracking_2nd_PLL_filter.h"
+#include "tracking_lock_detector.h"
 #include "cpu_multicorrelator.h"
 
 class galileo_e1_dll_pll_veml_tracking_cc;
@@ -157,11 +158,9 @@ private:
     unsigned long int d_acq_sample_stamp;
 
     // CN0 estimation and lock detector
-    int d_cn0_estimation_counter;
-    gr_complex* d_Prompt_buffer;
+    Tracking_Lock_Detector d_lock_detector;
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
-    double d_carrier_lock_threshold;
     int d_carrier_lock_fail_counter;
 
     // control vars
@@ -1,13 +1,14 @@
 /*!
- * \file galileo_e5a_dll_pll_tracking_cc.h
- * \brief Implementation of a code DLL + carrier PLL
- *  tracking block for Galileo E5a signals
- * \author Marc Sales, 2014. marcsales92(at)gmail.com
- * \based on work from:
- *          <ul>
- *          <li> Javier Arribas, 2011. jarribas(at)cttc.es
- *          <li> Luis Esteve, 2012. luis(at)epsilon-formacion.com
- *          </ul>
+ * \file gps_l1_ca_dll_pll_c_aid_tracking_8sc.h
+ * \brief Interface of a code DLL + carrier PLL tracking block for 8 bits
+ * complex (cbyte) samples
+ * \author Carlos Aviles, 2010. carlos.avilesr(at)googlemail.com
+ *         Javier Arribas, 2011. jarribas(at)cttc.es
+ *
+ * Code DLL + carrier PLL according to the algorithms described in:
+ * K.Borre, D.M.Akos, N.Bertelsen, P.Rinder, and S.H.Jensen,
+ * A Software-Defined GPS and Galileo Receiver. A Single-Frequency Approach,
+ * Birkhauser, 2007
  *
  * -------------------------------------------------------------------------
  *
@@ -34,45 +35,50 @@
  * -------------------------------------------------------------------------
  */
 
-#ifndef GNSS_SDR_GALILEO_E5A_DLL_PLL_TRACKING_CC_H_
-#define GNSS_SDR_GALILEO_E5A_DLL_PLL_TRACKING_CC_H_
+#ifndef GNSS_SDR_GPS_L1_CA_DLL_PLL_C_AID_TRACKING_8SC_H
+#define GNSS_SDR_GPS_L1_CA_DLL_PLL_C_AID_TRACKING_8SC_H
 
 #include <fstream>
 #include <map>
 #include <string>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <gnuradio/block.h>
+#include <volk/volk.h>
+#include "gps_sdr_signal_processing.h"
 #include "gnss_synchro.h"
 #include "tracking_2nd_DLL_filter.h"
-#include "tracking_2nd_PLL_filter.h"
-#include "cpu_multicorrelator.h"
+#include "tracking_FLL_PLL_filter.h"
+#include "tracking_lock_detector.h"
+#include "cpu_multicorrelator_8sc.h"
 
-class Galileo_E5a_Dll_Pll_Tracking_cc;
+class gps_l1_ca_dll_pll_c_aid_tracking_8sc;
 
-typedef boost::shared_ptr<Galileo_E5a_Dll_Pll_Tracking_cc>
-        galileo_e5a_dll_pll_tracking_cc_sptr;
+typedef boost::shared_ptr<gps_l1_ca_dll_pll_c_aid_tracking_8sc>
+        gps_l1_ca_dll_pll_c_aid_tracking_8sc_sptr;
 
-galileo_e5a_dll_pll_tracking_cc_sptr
-galileo_e5a_dll_pll_make_tracking_cc(long if_freq,
+gps_l1_ca_dll_pll_c_aid_tracking_8sc_sptr
+gps_l1_ca_dll_pll_c_aid_make_tracking_8sc(long if_freq,
                                    long fs_in, unsigned
                                    int vector_length,
                                    bool dump,
                                    std::string dump_filename,
                                    float pll_bw_hz,
                                    float dll_bw_hz,
-                                   float pll_bw_init_hz,
-                                   float dll_bw_init_hz,
-                                   int ti_ms,
+                                   float pll_bw_narrow_hz,
+                                   float dll_bw_narrow_hz,
                                    float early_late_space_chips);
 
 
 
 /*!
- * \brief This class implements a DLL + PLL tracking loop block
+ * \brief This class implements a DLL + PLL tracking loop block that works
+ * directly on 8 bits complex samples, with 8 bits code replicas
  */
-class Galileo_E5a_Dll_Pll_Tracking_cc: public gr::block
+class gps_l1_ca_dll_pll_c_aid_tracking_8sc: public gr::block
 {
 public:
-    ~Galileo_E5a_Dll_Pll_Tracking_cc();
+    ~gps_l1_ca_dll_pll_c_aid_tracking_8sc();
 
     void set_channel(unsigned int channel);
     void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro);
@@ -84,119 +90,90 @@ public:
     void forecast (int noutput_items, gr_vector_int &ninput_items_required);
 
 private:
-    friend galileo_e5a_dll_pll_tracking_cc_sptr
-    galileo_e5a_dll_pll_make_tracking_cc(long if_freq,
+    friend gps_l1_ca_dll_pll_c_aid_tracking_8sc_sptr
+    gps_l1_ca_dll_pll_c_aid_make_tracking_8sc(long if_freq,
             long fs_in, unsigned
             int vector_length,
             bool dump,
             std::string dump_filename,
             float pll_bw_hz,
             float dll_bw_hz,
-            float pll_bw_init_hz,
-            float dll_bw_init_hz,
-            int ti_ms,
+            float pll_bw_narrow_hz,
+            float dll_bw_narrow_hz,
             float early_late_space_chips);
 
-    Galileo_E5a_Dll_Pll_Tracking_cc(long if_freq,
+    gps_l1_ca_dll_pll_c_aid_tracking_8sc(long if_freq,
             long fs_in, unsigned
             int vector_length,
             bool dump,
             std::string dump_filename,
             float pll_bw_hz,
             float dll_bw_hz,
-            float pll_bw_init_hz,
-            float dll_bw_init_hz,
-            int ti_ms,
+            float pll_bw_narrow_hz,
+            float dll_bw_narrow_hz,
             float early_late_space_chips);
-    void acquire_secondary();
+
     // tracking configuration vars
     unsigned int d_vector_length;
-    int d_current_ti_ms;
-    int d_ti_ms;
     bool d_dump;
 
-
     Gnss_Synchro* d_acquisition_gnss_synchro;
     unsigned int d_channel;
+
     long d_if_freq;
     long d_fs_in;
 
     double d_early_late_spc_chips;
-    double d_dll_bw_hz;
-    double d_pll_bw_hz;
-    double d_dll_bw_init_hz;
-    double d_pll_bw_init_hz;
-
-    gr_complex* d_codeQ;
-    gr_complex* d_codeI;
-
-    gr_complex d_Early;
-    gr_complex d_Prompt;
-    gr_complex d_Late;
-    gr_complex d_Prompt_data;
-
-    gr_complex* d_Single_Early;
-    gr_complex* d_Single_Prompt;
-    gr_complex* d_Single_Late;
-    gr_complex* d_Single_Prompt_data;
+    int d_n_correlator_taps;
 
+    lv_8sc_t* d_ca_code_8sc;
+    float* d_local_code_shift_chips;
+    gr_complex* d_correlator_outs;
+    //cpu_multicorrelator multicorrelator_cpu;
+    cpu_multicorrelator_8sc multicorrelator_cpu_8sc;
 
-    float tmp_E;
-    float tmp_P;
-    float tmp_L;
     // remaining code phase and carrier phase between tracking loops
     double d_rem_code_phase_samples;
     double d_rem_code_phase_chips;
-    double d_rem_carr_phase_rad;
+    double d_rem_carrier_phase_rad;
 
     // PLL and DLL filter library
     Tracking_2nd_DLL_filter d_code_loop_filter;
-    Tracking_2nd_PLL_filter d_carrier_loop_filter;
+    Tracking_FLL_PLL_filter d_carrier_loop_filter;
 
     // acquisition
     double d_acq_code_phase_samples;
     double d_acq_carrier_doppler_hz;
-    // correlator
-    int d_n_correlator_taps;
-    float* d_local_code_shift_chips;
-    gr_complex* d_correlator_outs;
-    cpu_multicorrelator multicorrelator_cpu_I;
-    cpu_multicorrelator multicorrelator_cpu_Q;
 
     // tracking vars
+    float d_dll_bw_hz;
+    float d_pll_bw_hz;
+    float d_dll_bw_narrow_hz;
+    float d_pll_bw_narrow_hz;
     double d_code_freq_chips;
-    double d_carrier_doppler_hz;
-    double d_acc_carrier_phase_rad;
-    double d_code_phase_samples;
-    double d_acc_code_phase_secs;
-    double d_code_error_filt_secs;
     double d_code_phase_step_chips;
+    double d_carrier_doppler_hz;
     double d_carrier_phase_step_rad;
+    double d_acc_carrier_phase_cycles;
+    double d_code_phase_samples;
+    double d_pll_to_dll_assist_secs_Ti;
 
-
-    //PRN period in samples
-    int d_current_prn_length_samples;
+    //Integration period in samples
+    int d_correlation_length_samples;
 
     //processing samples counters
     unsigned long int d_sample_counter;
     unsigned long int d_acq_sample_stamp;
 
     // CN0 estimation and lock detector
-    int d_cn0_estimation_counter;
-    gr_complex* d_Prompt_buffer;
+    Tracking_Lock_Detector d_lock_detector;
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
-    double d_carrier_lock_threshold;
     int d_carrier_lock_fail_counter;
 
     // control vars
-    int d_state;
-    bool d_first_transition;
-
-    // Secondary code acquisition
-    bool d_secondary_lock;
-    int d_secondary_delay;
-    int d_integration_counter;
+    bool d_enable_tracking;
+    bool d_pull_in;
 
     // file dump
     std::string d_dump_filename;
@@ -206,4 +183,4 @@ private:
     std::string sys;
 };
 
-#endif /* GNSS_SDR_GALILEO_E5A_DLL_PLL_TRACKING_CC_H_ */
+#endif //GNSS_SDR_GPS_L1_CA_DLL_PLL_C_AID_TRACKING_8SC_H
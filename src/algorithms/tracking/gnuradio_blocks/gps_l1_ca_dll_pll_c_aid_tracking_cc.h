@@ -47,6 +47,7 @@
 #include "tracking_2nd_DLL_filter.h"
 #include "tracking_FLL_PLL_filter.h"
 #include "tracking_loop_filter.h"
+#include "tracking_lock_detector.h"
 #include "cpu_multicorrelator.h"
 
 class gps_l1_ca_dll_pll_c_aid_tracking_cc;
@@ -180,11 +181,9 @@ private:
     unsigned long int d_acq_sample_stamp;
 
     // CN0 estimation and lock detector
-    int d_cn0_estimation_counter;
-    gr_complex* d_Prompt_buffer;
+    Tracking_Lock_Detector d_lock_detector;
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
-    double d_carrier_lock_threshold;
     int d_carrier_lock_fail_counter;
 
     // control vars
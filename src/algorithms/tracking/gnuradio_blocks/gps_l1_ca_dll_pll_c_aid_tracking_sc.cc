@@ -38,9 +38,8 @@
 #include <volk/volk.h>
 #include <glog/logging.h>
 #include "gnss_synchro.h"
-#include "gps_sdr_signal_processing.h"
+#include "gnss_code_bank.h"
 #include "tracking_discriminators.h"
-#include "lock_detectors.h"
 #include "GPS_L1_CA.h"
 #include "control_message_factory.h"
 
@@ -124,7 +123,6 @@ gps_l1_ca_dll_pll_c_aid_tracking_sc::gps_l1_ca_dll_pll_c_aid_tracking_sc(
 
     // Initialization of local code replica
     // Get space for a vector with the C/A code replica sampled 1x/chip
-    d_ca_code = static_cast<gr_complex*>(volk_malloc(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS) * sizeof(gr_complex), volk_get_alignment()));
     d_ca_code_16sc = static_cast<lv_16sc_t*>(volk_malloc(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS) * sizeof(lv_16sc_t), volk_get_alignment()));
 
     // correlator outputs (scalar)
@@ -160,13 +158,14 @@ gps_l1_ca_dll_pll_c_aid_tracking_sc::gps_l1_ca_dll_pll_c_aid_tracking_sc(
     d_enable_tracking = false;
     d_pull_in = false;
 
-    // CN0 estimation and lock detector buffers
-    d_cn0_estimation_counter = 0;
-    d_Prompt_buffer = new gr_complex[CN0_ESTIMATION_SAMPLES];
+    // CN0 estimation and lock detector
+    d_lock_detector.set_window(CN0_ESTIMATION_SAMPLES);
+    d_lock_detector.set_integration(d_fs_in, GPS_L1_CA_CODE_LENGTH_CHIPS);
+    d_lock_detector.set_cn0_threshold(MINIMUM_VALID_CN0);
+    d_lock_detector.set_carrier_lock_threshold(CARRIER_LOCK_THRESHOLD);
     d_carrier_lock_test = 1;
     d_CN0_SNV_dB_Hz = 0;
     d_carrier_lock_fail_counter = 0;
-    d_carrier_lock_threshold = CARRIER_LOCK_THRESHOLD;
 
     systemName["G"] = std::string("GPS");
     systemName["S"] = std::string("SBAS");
@@ -241,8 +240,8 @@ void gps_l1_ca_dll_pll_c_aid_tracking_sc::start_tracking()
     d_code_loop_filter.initialize();    // initialize the code filter
 
     // generate local reference ALWAYS starting at chip 1 (1 sample per chip)
-    gps_l1_ca_code_gen_complex(d_ca_code, d_acquisition_gnss_synchro->PRN, 0);
-    volk_gnsssdr_32fc_convert_16ic(d_ca_code_16sc, d_ca_code, static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    Gnss_Code_Bank::expand(d_ca_code_16sc, Gnss_Code_Bank::instance().code(GPS_L1_CA_CODE, d_acquisition_gnss_synchro->PRN), nullptr,
+            static_cast<unsigned int>(GPS_L1_CA_CODE_LENGTH_CHIPS), 0, static_cast<int16_t>(1));
 
     multicorrelator_cpu_16sc.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), d_ca_code_16sc, d_local_code_shift_chips);
     for (int n = 0; n < d_n_correlator_taps; n++)
@@ -250,6 +249,7 @@ void gps_l1_ca_dll_pll_c_aid_tracking_sc::start_tracking()
             d_correlator_outs_16sc[n] = lv_16sc_t(0,0);
         }
 
+    d_lock_detector.reset();
     d_carrier_lock_fail_counter = 0;
     d_rem_code_phase_samples = 0.0;
     d_rem_carrier_phase_rad = 0.0;
@@ -280,11 +280,9 @@ gps_l1_ca_dll_pll_c_aid_tracking_sc::~gps_l1_ca_dll_pll_c_aid_tracking_sc()
     d_dump_file.close();
 
     volk_free(d_local_code_shift_chips);
-    volk_free(d_ca_code);
     volk_free(d_ca_code_16sc);
     volk_free(d_correlator_outs_16sc);
 
-    delete[] d_Prompt_buffer;
     multicorrelator_cpu_16sc.free();
 }
 
@@ -397,21 +395,18 @@ int gps_l1_ca_dll_pll_c_aid_tracking_sc::general_work (int noutput_items __attri
             d_rem_code_phase_chips = d_rem_code_phase_samples * (d_code_freq_chips / static_cast<double>(d_fs_in));
 
             // ####### CN0 ESTIMATION AND LOCK DETECTORS #######################################
-            if (d_cn0_estimation_counter < CN0_ESTIMATION_SAMPLES)
+            if (d_lock_detector.update(std::complex<float>(d_correlator_outs_16sc[1].real(),d_correlator_outs_16sc[1].imag()))) //prompt
                 {
-                    // fill buffer with prompt correlator output values
-                    d_Prompt_buffer[d_cn0_estimation_counter] = std::complex<float>(d_correlator_outs_16sc[1].real(),d_correlator_outs_16sc[1].imag()); //prompt
-                    d_cn0_estimation_counter++;
-                }
-            else
-                {
-                    d_cn0_estimation_counter = 0;
                     // Code lock indicator
-                    d_CN0_SNV_dB_Hz = cn0_svn_estimator(d_Prompt_buffer, CN0_ESTIMATION_SAMPLES, d_fs_in, GPS_L1_CA_CODE_LENGTH_CHIPS);
+                    d_CN0_SNV_dB_Hz = d_lock_detector.get_cn0_snv_db_hz();
                     // Carrier lock indicator
-                    d_carrier_lock_test = carrier_lock_detector(d_Prompt_buffer, CN0_ESTIMATION_SAMPLES);
+                    d_carrier_lock_test = d_lock_detector.get_carrier_lock_test();
+                    if (d_lock_detector.cycle_slip())
+                        {
+                            LOG(INFO) << "Possible cycle slip in channel " << d_channel;
+                        }
                     // Loss of lock detection
-                    if (d_carrier_lock_test < d_carrier_lock_threshold or d_CN0_SNV_dB_Hz < MINIMUM_VALID_CN0)
+                    if (!d_lock_detector.carrier_lock() or !d_lock_detector.code_lock())
                         {
                             d_carrier_lock_fail_counter++;
                         }
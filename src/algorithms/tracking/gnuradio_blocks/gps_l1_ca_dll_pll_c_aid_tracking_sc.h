@@ -48,6 +48,7 @@
 #include "gnss_synchro.h"
 #include "tracking_2nd_DLL_filter.h"
 #include "tracking_FLL_PLL_filter.h"
+#include "tracking_lock_detector.h"
 #include "cpu_multicorrelator_16sc.h"
 
 class gps_l1_ca_dll_pll_c_aid_tracking_sc;
@@ -123,7 +124,6 @@ private:
     double d_early_late_spc_chips;
     int d_n_correlator_taps;
 
-    gr_complex* d_ca_code;
     lv_16sc_t* d_ca_code_16sc;
     float* d_local_code_shift_chips;
     //gr_complex* d_correlator_outs;
@@ -165,11 +165,9 @@ private:
     unsigned long int d_acq_sample_stamp;
 
     // CN0 estimation and lock detector
-    int d_cn0_estimation_counter;
-    gr_complex* d_Prompt_buffer;
+    Tracking_Lock_Detector d_lock_detector;
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
-    double d_carrier_lock_threshold;
     int d_carrier_lock_fail_counter;
 
     // control vars
@@ -43,9 +43,8 @@
 #include <gnuradio/io_signature.h>
 #include <glog/logging.h>
 #include <volk/volk.h>
-#include "gps_sdr_signal_processing.h"
+#include "gnss_code_bank.h"
 #include "tracking_discriminators.h"
-#include "lock_detectors.h"
 #include "GPS_L1_CA.h"
 #include "control_message_factory.h"
 
@@ -57,6 +56,7 @@
 #define MINIMUM_VALID_CN0 25
 #define MAXIMUM_LOCK_FAIL_COUNTER 50
 #define CARRIER_LOCK_THRESHOLD 0.85
+#define KALMAN_INITIAL_DOPPLER_STD_HZ 50
 
 
 using google::LogMessage;
@@ -117,6 +117,7 @@ Gps_L1_Ca_Dll_Pll_Tracking_cc::Gps_L1_Ca_Dll_Pll_Tracking_cc(
     // Initialize tracking  ==========================================
     d_code_loop_filter.set_DLL_BW(dll_bw_hz);
     d_carrier_loop_filter.set_PLL_BW(pll_bw_hz);
+    d_use_kalman_filter = false;
 
     //--- DLL variables --------------------------------------------------------
     d_early_late_spc_chips = early_late_space_chips; // Define early-late offset (in chips)
@@ -156,13 +157,14 @@ Gps_L1_Ca_Dll_Pll_Tracking_cc::Gps_L1_Ca_Dll_Pll_Tracking_cc(
     d_enable_tracking = false;
     d_pull_in = false;
 
-    // CN0 estimation and lock detector buffers
-    d_cn0_estimation_counter = 0;
-    d_Prompt_buffer = new gr_complex[CN0_ESTIMATION_SAMPLES];
+    // CN0 estimation and lock detector
+    d_lock_detector.set_window(CN0_ESTIMATION_SAMPLES);
+    d_lock_detector.set_integration(d_fs_in, GPS_L1_CA_CODE_LENGTH_CHIPS);
+    d_lock_detector.set_cn0_threshold(MINIMUM_VALID_CN0);
+    d_lock_detector.set_carrier_lock_threshold(CARRIER_LOCK_THRESHOLD);
     d_carrier_lock_test = 1;
     d_CN0_SNV_dB_Hz = 0;
     d_carrier_lock_fail_counter = 0;
-    d_carrier_lock_threshold = CARRIER_LOCK_THRESHOLD;
 
     systemName["G"] = std::string("GPS");
     systemName["S"] = std::string("SBAS");
@@ -232,9 +234,11 @@ void Gps_L1_Ca_Dll_Pll_Tracking_cc::start_tracking()
     // DLL/PLL filter initialization
     d_carrier_loop_filter.initialize(); // initialize the carrier filter
     d_code_loop_filter.initialize();    // initialize the code filter
+    d_kalman_filter.initialize(d_acq_carrier_doppler_hz, KALMAN_INITIAL_DOPPLER_STD_HZ);
 
     // generate local reference ALWAYS starting at chip 1 (1 sample per chip)
-    gps_l1_ca_code_gen_complex(d_ca_code, d_acquisition_gnss_synchro->PRN, 0);
+    Gnss_Code_Bank::expand(d_ca_code, Gnss_Code_Bank::instance().code(GPS_L1_CA_CODE, d_acquisition_gnss_synchro->PRN), nullptr,
+            static_cast<unsigned int>(GPS_L1_CA_CODE_LENGTH_CHIPS), 0, 1.0f);
 
     multicorrelator_cpu.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), d_ca_code, d_local_code_shift_chips);
     for (int n = 0; n < d_n_correlator_taps; n++)
@@ -242,6 +246,7 @@ void Gps_L1_Ca_Dll_Pll_Tracking_cc::start_tracking()
             d_correlator_outs[n] = gr_complex(0,0);
         }
 
+    d_lock_detector.reset();
     d_carrier_lock_fail_counter = 0;
     d_rem_code_phase_samples = 0;
     d_rem_carr_phase_rad = 0.0;
@@ -275,7 +280,6 @@ Gps_L1_Ca_Dll_Pll_Tracking_cc::~Gps_L1_Ca_Dll_Pll_Tracking_cc()
     volk_free(d_correlator_outs);
     volk_free(d_ca_code);
 
-    delete[] d_Prompt_buffer;
     multicorrelator_cpu.free();
 }
 
@@ -331,13 +335,28 @@ int Gps_L1_Ca_Dll_Pll_Tracking_cc::general_work (int noutput_items __attribute__
             // PLL discriminator
             // Update PLL discriminator [rads/Ti -> Secs/Ti]
             carr_error_hz = pll_cloop_two_quadrant_atan(d_correlator_outs[1]) / GPS_TWO_PI; //prompt output
-            // Carrier discriminator filter
-            carr_error_filt_hz = d_carrier_loop_filter.get_carrier_nco(carr_error_hz);
-            // New carrier Doppler frequency estimation
-            d_carrier_doppler_hz = d_acq_carrier_doppler_hz + carr_error_filt_hz;
+            // DLL discriminator
+            code_error_chips = dll_nc_e_minus_l_normalized(d_correlator_outs[0], d_correlator_outs[2]); //[chips/Ti] //early and late
+            double carrier_doppler_estimate_hz;
+            if (d_use_kalman_filter)
+                {
+                    // The Kalman filter processes both discriminators, and commands both NCOs
+                    d_kalman_filter.update(carr_error_hz, code_error_chips);
+                    d_carrier_doppler_hz = d_kalman_filter.get_nco_doppler_hz();
+                    carr_error_filt_hz = d_carrier_doppler_hz - d_acq_carrier_doppler_hz;
+                    carrier_doppler_estimate_hz = d_kalman_filter.get_doppler_hz();
+                }
+            else
+                {
+                    // Carrier discriminator filter
+                    carr_error_filt_hz = d_carrier_loop_filter.get_carrier_nco(carr_error_hz);
+                    // New carrier Doppler frequency estimation
+                    d_carrier_doppler_hz = d_acq_carrier_doppler_hz + carr_error_filt_hz;
+                    carrier_doppler_estimate_hz = d_carrier_doppler_hz;
+                }
 
             // New code Doppler frequency estimation
-            d_code_freq_chips = GPS_L1_CA_CODE_RATE_HZ + ((d_carrier_doppler_hz * GPS_L1_CA_CODE_RATE_HZ) / GPS_L1_FREQ_HZ);
+            d_code_freq_chips = GPS_L1_CA_CODE_RATE_HZ + ((carrier_doppler_estimate_hz * GPS_L1_CA_CODE_RATE_HZ) / GPS_L1_FREQ_HZ);
             //carrier phase accumulator for (K) doppler estimation
             d_acc_carrier_phase_rad -= GPS_TWO_PI * d_carrier_doppler_hz * GPS_L1_CA_CODE_PERIOD;
             //remanent carrier phase to prevent overflow in the code NCO
@@ -345,10 +364,15 @@ int Gps_L1_Ca_Dll_Pll_Tracking_cc::general_work (int noutput_items __attribute__
             d_rem_carr_phase_rad = fmod(d_rem_carr_phase_rad, GPS_TWO_PI);
 
             // ################## DLL ##########################################################
-            // DLL discriminator
-            code_error_chips = dll_nc_e_minus_l_normalized(d_correlator_outs[0], d_correlator_outs[2]); //[chips/Ti] //early and late
             // Code discriminator filter
-            code_error_filt_chips = d_code_loop_filter.get_code_nco(code_error_chips); //[chips/second]
+            if (d_use_kalman_filter)
+                {
+                    code_error_filt_chips = d_kalman_filter.get_code_correction_chips() / GPS_L1_CA_CODE_PERIOD; //[chips/second]
+                }
+            else
+                {
+                    code_error_filt_chips = d_code_loop_filter.get_code_nco(code_error_chips); //[chips/second]
+                }
             //Code phase accumulator
             double code_error_filt_secs;
             code_error_filt_secs = (GPS_L1_CA_CODE_PERIOD * code_error_filt_chips) / GPS_L1_CA_CODE_RATE_HZ; //[seconds]
@@ -378,21 +402,22 @@ int Gps_L1_Ca_Dll_Pll_Tracking_cc::general_work (int noutput_items __attribute__
             d_rem_code_phase_chips = d_rem_code_phase_samples * (d_code_freq_chips / static_cast<double>(d_fs_in));
 
             // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
-            if (d_cn0_estimation_counter < CN0_ESTIMATION_SAMPLES)
-                {
-                    // fill buffer with prompt correlator output values
-                    d_Prompt_buffer[d_cn0_estimation_counter] = d_correlator_outs[1]; //prompt
-                    d_cn0_estimation_counter++;
-                }
-            else
+            if (d_lock_detector.update(d_correlator_outs[1])) //prompt
                 {
-                    d_cn0_estimation_counter = 0;
                     // Code lock indicator
-                    d_CN0_SNV_dB_Hz = cn0_svn_estimator(d_Prompt_buffer, CN0_ESTIMATION_SAMPLES, d_fs_in, GPS_L1_CA_CODE_LENGTH_CHIPS);
+                    d_CN0_SNV_dB_Hz = d_lock_detector.get_cn0_snv_db_hz();
                     // Carrier lock indicator
-                    d_carrier_lock_test = carrier_lock_detector(d_Prompt_buffer, CN0_ESTIMATION_SAMPLES);
+                    d_carrier_lock_test = d_lock_detector.get_carrier_lock_test();
+                    if (d_use_kalman_filter)
+                        {
+                            d_kalman_filter.set_cn0(d_CN0_SNV_dB_Hz);
+                        }
+                    if (d_lock_detector.cycle_slip())
+                        {
+                            LOG(INFO) << "Possible cycle slip in channel " << d_channel;
+                        }
                     // Loss of lock detection
-                    if (d_carrier_lock_test < d_carrier_lock_threshold or d_CN0_SNV_dB_Hz < MINIMUM_VALID_CN0)
+                    if (!d_lock_detector.carrier_lock() or !d_lock_detector.code_lock())
                         {
                             d_carrier_lock_fail_counter++;
                         }
@@ -422,7 +447,7 @@ int Gps_L1_Ca_Dll_Pll_Tracking_cc::general_work (int noutput_items __attribute__
             // This tracking block aligns the Tracking_timestamp_secs with the start sample of the PRN, thus, Code_phase_secs=0
             current_synchro_data.Code_phase_secs = 0;
             current_synchro_data.Carrier_phase_rads = d_acc_carrier_phase_rad;
-            current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
+            current_synchro_data.Carrier_Doppler_hz = carrier_doppler_estimate_hz;
             current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
             current_synchro_data.Flag_valid_symbol_output = true;
             current_synchro_data.correlation_length_ms = 1;
@@ -529,6 +554,16 @@ void Gps_L1_Ca_Dll_Pll_Tracking_cc::set_channel(unsigned int channel)
 }
 
 
+void Gps_L1_Ca_Dll_Pll_Tracking_cc::enable_kalman_filter(float clock_noise, float dynamics_noise, float code_noise)
+{
+    d_kalman_filter.set_pdi(GPS_L1_CA_CODE_PERIOD);
+    d_kalman_filter.set_early_late_space_chips(d_early_late_spc_chips);
+    d_kalman_filter.set_process_noise(clock_noise, dynamics_noise, code_noise);
+    d_use_kalman_filter = true;
+    LOG(INFO) << "Kalman filter tracking loop enabled";
+}
+
+
 void Gps_L1_Ca_Dll_Pll_Tracking_cc::set_gnss_synchro(Gnss_Synchro* p_gnss_synchro)
 {
     d_acquisition_gnss_synchro = p_gnss_synchro;
@@ -0,0 +1,680 @@
+/*!
+ * \file gps_l1_ca_dll_pll_vector_tracking_cc.cc
+ * \brief Implementation of a code DLL + carrier PLL tracking block aided by
+ * the PVT solution (vector DLL / FLL)
+ *
+ * Scalar code DLL + carrier PLL according to the algorithms described in:
+ * [1] K.Borre, D.M.Akos, N.Bertelsen, P.Rinder, and S.H.Jensen,
+ * A Software-Defined GPS and Galileo Receiver. A Single-Frequency
+ * Approach, Birkhauser, 2007
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gps_l1_ca_dll_pll_vector_tracking_cc.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <boost/any.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <gnuradio/io_signature.h>
+#include <glog/logging.h>
+#include <volk/volk.h>
+#include "gnss_code_bank.h"
+#include "tracking_discriminators.h"
+#include "GPS_L1_CA.h"
+#include "control_message_factory.h"
+
+
+/*!
+ * \todo Include in definition header file
+ */
+#define CN0_ESTIMATION_SAMPLES 20
+#define MINIMUM_VALID_CN0 25
+#define MAXIMUM_LOCK_FAIL_COUNTER 50
+#define CARRIER_LOCK_THRESHOLD 0.85
+
+
+using google::LogMessage;
+
+gps_l1_ca_dll_pll_vector_tracking_cc_sptr
+gps_l1_ca_dll_pll_make_vector_tracking_cc(
+        long if_freq,
+        long fs_in,
+        unsigned int vector_length,
+        bool dump,
+        std::string dump_filename,
+        float pll_bw_hz,
+        float dll_bw_hz,
+        float early_late_space_chips,
+        float vector_dll_bw_hz,
+        float vector_code_gain,
+        float vector_carrier_gain,
+        float aid_timeout_s,
+        float coast_time_s,
+        float max_aid_doppler_error_hz)
+{
+    return gps_l1_ca_dll_pll_vector_tracking_cc_sptr(new Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc(if_freq,
+            fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips,
+            vector_dll_bw_hz, vector_code_gain, vector_carrier_gain, aid_timeout_s, coast_time_s,
+            max_aid_doppler_error_hz));
+}
+
+
+
+void Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc::forecast (int noutput_items,
+        gr_vector_int &ninput_items_required)
+{
+    if (noutput_items != 0)
+        {
+            ninput_items_required[0] = static_cast<int>(d_vector_length) * 2; //set the required available samples in each call
+        }
+}
+
+
+
+Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc::Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc(
+        long if_freq,
+        long fs_in,
+        unsigned int vector_length,
+        bool dump,
+        std::string dump_filename,
+        float pll_bw_hz,
+        float dll_bw_hz,
+        float early_late_space_chips,
+        float vector_dll_bw_hz,
+        float vector_code_gain,
+        float vector_carrier_gain,
+        float aid_timeout_s,
+        float coast_time_s,
+        float max_aid_doppler_error_hz) :
+        gr::block("Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)))
+{
+    // Telemetry bit synchronization message port input
+    this->message_port_register_in(pmt::mp("preamble_timestamp_s"));
+    this->message_port_register_out(pmt::mp("events"));
+    // PVT solution feedback message port input
+    this->message_port_register_in(pmt::mp("vector_aid"));
+    this->set_msg_handler(pmt::mp("vector_aid"),
+            boost::bind(&Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc::msg_handler_vector_aid, this, _1));
+
+    // initialize internal vars
+    d_dump = dump;
+    d_if_freq = if_freq;
+    d_fs_in = fs_in;
+    d_vector_length = vector_length;
+    d_dump_filename = dump_filename;
+
+    d_current_prn_length_samples = static_cast<int>(d_vector_length);
+
+    // Initialize tracking  ==========================================
+    d_code_loop_filter.set_DLL_BW(dll_bw_hz);
+    d_carrier_loop_filter.set_PLL_BW(pll_bw_hz);
+    d_dll_bw_hz = dll_bw_hz;
+
+    // Vector tracking
+    d_vector_dll_bw_hz = vector_dll_bw_hz;
+    d_vector_code_gain = vector_code_gain;
+    d_vector_carrier_gain = vector_carrier_gain;
+    d_aid_timeout_s = aid_timeout_s;
+    d_coast_time_s = coast_time_s;
+    d_max_aid_doppler_error_hz = max_aid_doppler_error_hz;
+    d_rejected_aids = 0;
+    d_aid_pending = false;
+    d_last_aid_timestamp_s = 0.0;
+    d_last_aid_doppler_hz = 0.0;
+    d_vector_dll = false;
+    d_coasting = false;
+    d_coast_start_s = 0.0;
+
+    //--- DLL variables --------------------------------------------------------
+    d_early_late_spc_chips = early_late_space_chips; // Define early-late offset (in chips)
+
+    // Initialization of local code replica
+    // Get space for a vector with the C/A code replica sampled 1x/chip
+    d_ca_code = static_cast<gr_complex*>(volk_malloc(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS) * sizeof(gr_complex), volk_get_alignment()));
+
+    // correlator outputs (scalar)
+    d_n_correlator_taps = 3; // Early, Prompt, and Late
+    d_correlator_outs = static_cast<gr_complex*>(volk_malloc(d_n_correlator_taps*sizeof(gr_complex), volk_get_alignment()));
+    for (int n = 0; n < d_n_correlator_taps; n++)
+        {
+            d_correlator_outs[n] = gr_complex(0,0);
+        }
+    d_local_code_shift_chips = static_cast<float*>(volk_malloc(d_n_correlator_taps*sizeof(float), volk_get_alignment()));
+    // Set TAPs delay values [chips]
+    d_local_code_shift_chips[0] = - d_early_late_spc_chips;
+    d_local_code_shift_chips[1] = 0.0;
+    d_local_code_shift_chips[2] = d_early_late_spc_chips;
+
+    multicorrelator_cpu.init(2 * d_current_prn_length_samples, d_n_correlator_taps);
+
+    //--- Perform initializations ------------------------------
+    // define initial code frequency basis of NCO
+    d_code_freq_chips = GPS_L1_CA_CODE_RATE_HZ;
+    // define residual code phase (in chips)
+    d_rem_code_phase_samples = 0.0;
+    // define residual carrier phase
+    d_rem_carr_phase_rad = 0.0;
+
+    // sample synchronization
+    d_sample_counter = 0;
+    //d_sample_counter_seconds = 0;
+    d_acq_sample_stamp = 0;
+
+    d_enable_tracking = false;
+    d_pull_in = false;
+
+    // CN0 estimation and lock detector
+    d_lock_detector.set_window(CN0_ESTIMATION_SAMPLES);
+    d_lock_detector.set_integration(d_fs_in, GPS_L1_CA_CODE_LENGTH_CHIPS);
+    d_lock_detector.set_cn0_threshold(MINIMUM_VALID_CN0);
+    d_lock_detector.set_carrier_lock_threshold(CARRIER_LOCK_THRESHOLD);
+    d_carrier_lock_test = 1;
+    d_CN0_SNV_dB_Hz = 0;
+    d_carrier_lock_fail_counter = 0;
+
+    systemName["G"] = std::string("GPS");
+    systemName["S"] = std::string("SBAS");
+
+    d_acquisition_gnss_synchro = 0;
+    d_channel = 0;
+    d_acq_code_phase_samples = 0.0;
+    d_acq_carrier_doppler_hz = 0.0;
+    d_carrier_doppler_hz = 0.0;
+    d_acc_carrier_phase_rad = 0.0;
+    d_code_phase_samples = 0.0;
+    d_acc_code_phase_secs = 0.0;
+    d_rem_code_phase_chips = 0.0;
+    d_code_phase_step_chips = 0.0;
+    d_carrier_phase_step_rad = 0.0;
+
+    set_relative_rate(1.0 / static_cast<double>(d_vector_length));
+}
+
+
+void Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc::start_tracking()
+{
+    /*
+     *  correct the code phase according to the delay between acq and trk
+     */
+    d_acq_code_phase_samples = d_acquisition_gnss_synchro->Acq_delay_samples;
+    d_acq_carrier_doppler_hz = d_acquisition_gnss_synchro->Acq_doppler_hz;
+    d_acq_sample_stamp = d_acquisition_gnss_synchro->Acq_samplestamp_samples;
+
+    long int acq_trk_diff_samples;
+    double acq_trk_diff_seconds;
+    acq_trk_diff_samples = static_cast<long int>(d_sample_counter) - static_cast<long int>(d_acq_sample_stamp);//-d_vector_length;
+    DLOG(INFO) << "Number of samples between Acquisition and Tracking =" << acq_trk_diff_samples;
+    acq_trk_diff_seconds = static_cast<float>(acq_trk_diff_samples) / static_cast<float>(d_fs_in);
+    //doppler effect
+    // Fd=(C/(C+Vr))*F
+    double radial_velocity = (GPS_L1_FREQ_HZ + d_acq_carrier_doppler_hz) / GPS_L1_FREQ_HZ;
+    // new chip and prn sequence periods based on acq Doppler
+    double T_chip_mod_seconds;
+    double T_prn_mod_seconds;
+    double T_prn_mod_samples;
+    d_code_freq_chips = radial_velocity * GPS_L1_CA_CODE_RATE_HZ;
+    d_code_phase_step_chips = static_cast<double>(d_code_freq_chips) / static_cast<double>(d_fs_in);
+    T_chip_mod_seconds = 1/d_code_freq_chips;
+    T_prn_mod_seconds = T_chip_mod_seconds * GPS_L1_CA_CODE_LENGTH_CHIPS;
+    T_prn_mod_samples = T_prn_mod_seconds * static_cast<double>(d_fs_in);
+
+    d_current_prn_length_samples = round(T_prn_mod_samples);
+
+    double T_prn_true_seconds = GPS_L1_CA_CODE_LENGTH_CHIPS / GPS_L1_CA_CODE_RATE_HZ;
+    double T_prn_true_samples = T_prn_true_seconds * static_cast<double>(d_fs_in);
+    double T_prn_diff_seconds = T_prn_true_seconds - T_prn_mod_seconds;
+    double N_prn_diff = acq_trk_diff_seconds / T_prn_true_seconds;
+    double corrected_acq_phase_samples, delay_correction_samples;
+    corrected_acq_phase_samples = fmod((d_acq_code_phase_samples + T_prn_diff_seconds * N_prn_diff * static_cast<double>(d_fs_in)), T_prn_true_samples);
+    if (corrected_acq_phase_samples < 0)
+        {
+            corrected_acq_phase_samples = T_prn_mod_samples + corrected_acq_phase_samples;
+        }
+    delay_correction_samples = d_acq_code_phase_samples - corrected_acq_phase_samples;
+
+    d_acq_code_phase_samples = corrected_acq_phase_samples;
+
+    d_carrier_doppler_hz = d_acq_carrier_doppler_hz;
+    d_carrier_phase_step_rad = GPS_TWO_PI * d_carrier_doppler_hz / static_cast<double>(d_fs_in);
+
+    // DLL/PLL filter initialization
+    d_carrier_loop_filter.initialize(); // initialize the carrier filter
+    d_code_loop_filter.set_DLL_BW(d_dll_bw_hz);
+    d_code_loop_filter.initialize();    // initialize the code filter
+
+    // forget the aids to the previous satellite
+    d_aid = Gnss_Vector_Aid();
+    d_aid_pending = false;
+    d_rejected_aids = 0;
+    d_last_aid_timestamp_s = 0.0;
+    d_last_aid_doppler_hz = 0.0;
+    d_vector_dll = false;
+    d_coasting = false;
+
+    // generate local reference ALWAYS starting at chip 1 (1 sample per chip)
+    Gnss_Code_Bank::expand(d_ca_code, Gnss_Code_Bank::instance().code(GPS_L1_CA_CODE, d_acquisition_gnss_synchro->PRN), nullptr,
+            static_cast<unsigned int>(GPS_L1_CA_CODE_LENGTH_CHIPS), 0, 1.0f);
+
+    multicorrelator_cpu.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), d_ca_code, d_local_code_shift_chips);
+    for (int n = 0; n < d_n_correlator_taps; n++)
+        {
+            d_correlator_outs[n] = gr_complex(0,0);
+        }
+
+    d_lock_detector.reset();
+    d_carrier_lock_fail_counter = 0;
+    d_rem_code_phase_samples = 0;
+    d_rem_carr_phase_rad = 0.0;
+    d_rem_code_phase_chips = 0.0;
+    d_acc_carrier_phase_rad = 0.0;
+    d_acc_code_phase_secs = 0.0;
+
+    d_code_phase_samples = d_acq_code_phase_samples;
+
+    std::string sys_ = &d_acquisition_gnss_synchro->System;
+    sys = sys_.substr(0,1);
+
+    // DEBUG OUTPUT
+    std::cout << "Tracking start on channel " << d_channel << " for satellite " << Gnss_Satellite(systemName[sys], d_acquisition_gnss_synchro->PRN) << std::endl;
+    LOG(INFO) << "Starting tracking of satellite " << Gnss_Satellite(systemName[sys], d_acquisition_gnss_synchro->PRN) << " on channel " << d_channel;
+
+    // enable tracking
+    d_pull_in = true;
+    d_enable_tracking = true;
+
+    LOG(INFO) << "PULL-IN Doppler [Hz]=" << d_carrier_doppler_hz
+            << " Code Phase correction [samples]=" << delay_correction_samples
+            << " PULL-IN Code Phase [samples]=" << d_acq_code_phase_samples;
+}
+
+Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc::~Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc()
+{
+    d_dump_file.close();
+
+    volk_free(d_local_code_shift_chips);
+    volk_free(d_correlator_outs);
+    volk_free(d_ca_code);
+
+    multicorrelator_cpu.free();
+}
+
+
+
+int Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc::general_work (int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
+        gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    // process vars
+    double carr_error_hz = 0.0;
+    double carr_error_filt_hz = 0.0;
+    double code_error_chips = 0.0;
+    double code_error_filt_chips = 0.0;
+    double vector_code_correction_secs = 0.0;
+
+    // Block input data and block output stream pointers
+    const gr_complex* in = (gr_complex*) input_items[0]; //PRN start block alignment
+    Gnss_Synchro **out = (Gnss_Synchro **) &output_items[0];
+
+    // GNSS_SYNCHRO OBJECT to interchange data between tracking->telemetry_decoder
+    Gnss_Synchro current_synchro_data = Gnss_Synchro();
+
+    if (d_enable_tracking == true)
+        {
+            // Fill the acquisition data
+            current_synchro_data = *d_acquisition_gnss_synchro;
+            // Receiver signal alignment
+            if (d_pull_in == true)
+                {
+                    int samples_offset;
+                    double acq_trk_shif_correction_samples;
+                    int acq_to_trk_delay_samples;
+                    acq_to_trk_delay_samples = d_sample_counter - d_acq_sample_stamp;
+                    acq_trk_shif_correction_samples = d_current_prn_length_samples - fmod(static_cast<float>(acq_to_trk_delay_samples), static_cast<float>(d_current_prn_length_samples));
+                    samples_offset = round(d_acq_code_phase_samples + acq_trk_shif_correction_samples);
+                    current_synchro_data.Tracking_timestamp_secs = (static_cast<double>(d_sample_counter) + static_cast<double>(d_rem_code_phase_samples)) / static_cast<double>(d_fs_in);
+                    d_sample_counter = d_sample_counter + samples_offset; //count for the processed samples
+                    d_pull_in = false;
+                    *out[0] = current_synchro_data;
+                    consume_each(samples_offset); //shift input to perform alignment with local replica
+                    return 1;
+                }
+
+            // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
+            // perform carrier wipe-off and compute Early, Prompt and Late correlation
+            multicorrelator_cpu.set_input_output_vectors(d_correlator_outs, in);
+            multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(d_rem_carr_phase_rad,
+                    d_carrier_phase_step_rad,
+                    d_rem_code_phase_chips,
+                    d_code_phase_step_chips,
+                    d_current_prn_length_samples);
+
+            // ################## PLL ##########################################################
+            // PLL discriminator
+            // Update PLL discriminator [rads/Ti -> Secs/Ti]
+            carr_error_hz = pll_cloop_two_quadrant_atan(d_correlator_outs[1]) / GPS_TWO_PI; //prompt output
+            // Carrier discriminator filter
+            carr_error_filt_hz = d_carrier_loop_filter.get_carrier_nco(carr_error_hz);
+
+            // ################## VECTOR AIDING ################################################
+            double timestamp_secs = (static_cast<double>(d_sample_counter) + static_cast<double>(d_rem_code_phase_samples)) / static_cast<double>(d_fs_in);
+            // While the carrier lock test fails the PLL follows the noise, so the
+            // aids are checked against the last one applied, if not too old
+            double reference_doppler_hz = d_carrier_doppler_hz;
+            if (d_carrier_lock_fail_counter > 0 and d_last_aid_timestamp_s > 0.0
+                    and timestamp_secs - d_last_aid_timestamp_s < d_aid_timeout_s)
+                {
+                    reference_doppler_hz = d_last_aid_doppler_hz;
+                }
+            if (d_aid_pending and std::abs(d_aid.Carrier_Doppler_hz - reference_doppler_hz) > d_max_aid_doppler_error_hz)
+                {
+                    // A solution this far from the tracked signal is wrong (bad geometry, ephemeris
+                    // or measurements): the channel is no longer aided, and does not coast on it
+                    d_rejected_aids++;
+                    LOG(WARNING) << "Channel " << d_channel << ": vector aid rejected, predicted Doppler " << d_aid.Carrier_Doppler_hz
+                                 << " Hz, expected " << reference_doppler_hz << " Hz (" << d_rejected_aids << " rejected)";
+                    d_aid = Gnss_Vector_Aid();
+                    d_aid_pending = false;
+                }
+            double aid_age_secs = timestamp_secs - d_aid.Tracking_timestamp_secs;
+            bool aided = (d_aid.Channel_ID >= 0) and (aid_age_secs >= 0.0) and (aid_age_secs < d_aid_timeout_s);
+            if (aided != d_vector_dll)
+                {
+                    // the navigation solution steers the code, the scalar DLL only tracks the residual
+                    d_code_loop_filter.set_DLL_BW(aided ? d_vector_dll_bw_hz : d_dll_bw_hz);
+                    d_vector_dll = aided;
+                    DLOG(INFO) << "Vector DLL " << (aided ? "enabled" : "disabled") << " in channel " << d_channel;
+                }
+            if (d_aid_pending and aided)
+                {
+                    // the gains are rates [1/s], so that the loops do not depend on the PVT output rate
+                    double aid_interval_s = 0.0;
+                    if (d_last_aid_timestamp_s > 0.0)
+                        {
+                            aid_interval_s = std::max(0.0, std::min(d_aid.Tracking_timestamp_secs - d_last_aid_timestamp_s, d_aid_timeout_s));
+                        }
+                    d_last_aid_timestamp_s = d_aid.Tracking_timestamp_secs;
+                    d_last_aid_doppler_hz = d_aid.Carrier_Doppler_hz;
+                    // VDLL: remove part of the pseudorange residual (positive if the local code is late)
+                    vector_code_correction_secs = - std::min(1.0, d_vector_code_gain * aid_interval_s) * d_aid.Code_error_m / GPS_C_m_s;
+                    // VFLL: steer the PLL toward the predicted Doppler when the carrier is weak
+                    if (d_coasting)
+                        {
+                            d_acq_carrier_doppler_hz = d_aid.Carrier_Doppler_hz;
+                            d_carrier_loop_filter.initialize();
+                            carr_error_filt_hz = 0.0;
+                        }
+                    else if (d_carrier_lock_fail_counter > 0)
+                        {
+                            d_acq_carrier_doppler_hz += std::min(1.0, d_vector_carrier_gain * aid_interval_s) * (d_aid.Carrier_Doppler_hz - d_carrier_doppler_hz);
+                        }
+                }
+            d_aid_pending = false;
+
+            // New carrier Doppler frequency estimation
+            d_carrier_doppler_hz = d_acq_carrier_doppler_hz + carr_error_filt_hz;
+
+            // New code Doppler frequency estimation
+            d_code_freq_chips = GPS_L1_CA_CODE_RATE_HZ + ((d_carrier_doppler_hz * GPS_L1_CA_CODE_RATE_HZ) / GPS_L1_FREQ_HZ);
+            //carrier phase accumulator for (K) doppler estimation
+            d_acc_carrier_phase_rad -= GPS_TWO_PI * d_carrier_doppler_hz * GPS_L1_CA_CODE_PERIOD;
+            //remanent carrier phase to prevent overflow in the code NCO
+            d_rem_carr_phase_rad = d_rem_carr_phase_rad + GPS_TWO_PI * ( d_if_freq + d_carrier_doppler_hz ) * GPS_L1_CA_CODE_PERIOD;
+            d_rem_carr_phase_rad = fmod(d_rem_carr_phase_rad, GPS_TWO_PI);
+
+            // ################## DLL ##########################################################
+            // DLL discriminator
+            code_error_chips = dll_nc_e_minus_l_normalized(d_correlator_outs[0], d_correlator_outs[2]); //[chips/Ti] //early and late
+            // Code discriminator filter
+            code_error_filt_chips = d_code_loop_filter.get_code_nco(code_error_chips); //[chips/second]
+            //Code phase accumulator
+            double code_error_filt_secs;
+            code_error_filt_secs = (GPS_L1_CA_CODE_PERIOD * code_error_filt_chips) / GPS_L1_CA_CODE_RATE_HZ; //[seconds]
+            d_acc_code_phase_secs = d_acc_code_phase_secs + code_error_filt_secs;
+
+            // ################## CARRIER AND CODE NCO BUFFER ALIGNEMENT #######################
+            // keep alignment parameters for the next input buffer
+            double T_chip_seconds;
+            double T_prn_seconds;
+            double T_prn_samples;
+            double K_blk_samples;
+            // Compute the next buffer length based in the new period of the PRN sequence and the code phase error estimation
+            T_chip_seconds = 1 / static_cast<double>(d_code_freq_chips);
+            T_prn_seconds = T_chip_seconds * GPS_L1_CA_CODE_LENGTH_CHIPS;
+            T_prn_samples = T_prn_seconds * static_cast<double>(d_fs_in);
+            K_blk_samples = T_prn_samples + d_rem_code_phase_samples + (code_error_filt_secs + vector_code_correction_secs) * static_cast<double>(d_fs_in);
+            d_current_prn_length_samples = round(K_blk_samples); //round to a discrete samples
+
+            //################### PLL COMMANDS #################################################
+            //carrier phase step (NCO phase increment per sample) [rads/sample]
+            d_carrier_phase_step_rad = GPS_TWO_PI * d_carrier_doppler_hz / static_cast<double>(d_fs_in);
+
+            //################### DLL COMMANDS #################################################
+            //code phase step (Code resampler phase increment per sample) [chips/sample]
+            d_code_phase_step_chips = d_code_freq_chips / static_cast<double>(d_fs_in);
+            //remnant code phase [chips]
+            d_rem_code_phase_chips = d_rem_code_phase_samples * (d_code_freq_chips / static_cast<double>(d_fs_in));
+
+            // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
+            if (d_lock_detector.update(d_correlator_outs[1])) //prompt
+                {
+                    // Code lock indicator
+                    d_CN0_SNV_dB_Hz = d_lock_detector.get_cn0_snv_db_hz();
+                    // Carrier lock indicator
+                    d_carrier_lock_test = d_lock_detector.get_carrier_lock_test();
+                    if (d_lock_detector.cycle_slip())
+                        {
+                            LOG(INFO) << "Possible cycle slip in channel " << d_channel;
+                        }
+                    // Loss of lock detection
+                    if (!d_lock_detector.carrier_lock() or !d_lock_detector.code_lock())
+                        {
+                            d_carrier_lock_fail_counter++;
+                        }
+                    else
+                        {
+                            if (d_carrier_lock_fail_counter > 0) d_carrier_lock_fail_counter--;
+                        }
+                    if (d_carrier_lock_fail_counter > MAXIMUM_LOCK_FAIL_COUNTER)
+                        {
+                            if (aided and (!d_coasting or timestamp_secs - d_coast_start_s < d_coast_time_s))
+                                {
+                                    // keep the channel on the navigation solution prediction
+                                    if (!d_coasting)
+                                        {
+                                            LOG(INFO) << "Channel " << d_channel << " coasting on the PVT solution";
+                                            d_coasting = true;
+                                            d_coast_start_s = timestamp_secs;
+                                        }
+                                    d_carrier_lock_fail_counter = MAXIMUM_LOCK_FAIL_COUNTER;
+                                }
+                            else
+                                {
+                                    std::cout << "Loss of lock in channel " << d_channel << "!" << std::endl;
+                                    LOG(INFO) << "Loss of lock in channel " << d_channel << "!";
+                                    this->message_port_pub(pmt::mp("events"), pmt::from_long(3));//3 -> loss of lock
+                                    d_carrier_lock_fail_counter = 0;
+                                    d_coasting = false;
+                                    d_enable_tracking = false; // TODO: check if disabling tracking is consistent with the channel state machine
+                                }
+                        }
+                    else if (d_coasting and d_carrier_lock_fail_counter == 0)
+                        {
+                            LOG(INFO) << "Channel " << d_channel << " carrier lock recovered after "
+                                      << timestamp_secs - d_coast_start_s << " s of coasting";
+                            d_coasting = false;
+                        }
+                }
+            // ########### Output the tracking data to navigation and PVT ##########
+            current_synchro_data.Prompt_I = static_cast<double>((d_correlator_outs[1]).real());
+            current_synchro_data.Prompt_Q = static_cast<double>((d_correlator_outs[1]).imag());
+
+            // Tracking_timestamp_secs is aligned with the CURRENT PRN start sample (Hybridization OK!, but some glitches??)
+            current_synchro_data.Tracking_timestamp_secs = (static_cast<double>(d_sample_counter) + static_cast<double>(d_rem_code_phase_samples)) / static_cast<double>(d_fs_in);
+            //compute remnant code phase samples AFTER the Tracking timestamp
+            d_rem_code_phase_samples = K_blk_samples - d_current_prn_length_samples; //rounding error < 1 sample
+
+            //current_synchro_data.Tracking_timestamp_secs = ((double)d_sample_counter)/static_cast<double>(d_fs_in);
+            // This tracking block aligns the Tracking_timestamp_secs with the start sample of the PRN, thus, Code_phase_secs=0
+            current_synchro_data.Code_phase_secs = 0;
+            current_synchro_data.Carrier_phase_rads = d_acc_carrier_phase_rad;
+            current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
+            current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
+            current_synchro_data.Flag_valid_symbol_output = true;
+            current_synchro_data.correlation_length_ms = 1;
+        }
+    else
+        {
+            for (int n = 0; n < d_n_correlator_taps; n++)
+                {
+                    d_correlator_outs[n] = gr_complex(0,0);
+                }
+
+            current_synchro_data.Tracking_timestamp_secs = (static_cast<double>(d_sample_counter) + static_cast<double>(d_rem_code_phase_samples)) / static_cast<double>(d_fs_in);
+            current_synchro_data.System = {'G'};
+        }
+
+    //assign the GNURadio block output data
+    *out[0] = current_synchro_data;
+    if(d_dump)
+        {
+            // MULTIPLEXED FILE RECORDING - Record results to file
+            float prompt_I;
+            float prompt_Q;
+            float tmp_E, tmp_P, tmp_L;
+            double tmp_double;
+            prompt_I = d_correlator_outs[1].real();
+            prompt_Q = d_correlator_outs[1].imag();
+            tmp_E = std::abs<float>(d_correlator_outs[0]);
+            tmp_P = std::abs<float>(d_correlator_outs[1]);
+            tmp_L = std::abs<float>(d_correlator_outs[2]);
+            try
+            {
+                // EPR
+                d_dump_file.write(reinterpret_cast<char*>(&tmp_E), sizeof(float));
+                d_dump_file.write(reinterpret_cast<char*>(&tmp_P), sizeof(float));
+                d_dump_file.write(reinterpret_cast<char*>(&tmp_L), sizeof(float));
+                // PROMPT I and Q (to analyze navigation symbols)
+                d_dump_file.write(reinterpret_cast<char*>(&prompt_I), sizeof(float));
+                d_dump_file.write(reinterpret_cast<char*>(&prompt_Q), sizeof(float));
+                // PRN start sample stamp
+                //tmp_float=(float)d_sample_counter;
+                d_dump_file.write(reinterpret_cast<char*>(&d_sample_counter), sizeof(unsigned long int));
+                // accumulated carrier phase
+                d_dump_file.write(reinterpret_cast<char*>(&d_acc_carrier_phase_rad), sizeof(double));
+
+                // carrier and code frequency
+                d_dump_file.write(reinterpret_cast<char*>(&d_carrier_doppler_hz), sizeof(double));
+                d_dump_file.write(reinterpret_cast<char*>(&d_code_freq_chips), sizeof(double));
+
+                //PLL commands
+                d_dump_file.write(reinterpret_cast<char*>(&carr_error_hz), sizeof(double));
+                d_dump_file.write(reinterpret_cast<char*>(&d_carrier_doppler_hz), sizeof(double));
+
+                //DLL commands
+                d_dump_file.write(reinterpret_cast<char*>(&code_error_chips), sizeof(double));
+                d_dump_file.write(reinterpret_cast<char*>(&code_error_filt_chips), sizeof(double));
+
+                // CN0 and carrier lock test
+                d_dump_file.write(reinterpret_cast<char*>(&d_CN0_SNV_dB_Hz), sizeof(double));
+                d_dump_file.write(reinterpret_cast<char*>(&d_carrier_lock_test), sizeof(double));
+
+                // AUX vars (for debug purposes)
+                tmp_double = d_rem_code_phase_samples;
+                d_dump_file.write(reinterpret_cast<char*>(&tmp_double), sizeof(double));
+                tmp_double = static_cast<double>(d_sample_counter + d_current_prn_length_samples);
+                d_dump_file.write(reinterpret_cast<char*>(&tmp_double), sizeof(double));
+            }
+            catch (const std::ifstream::failure &e)
+            {
+                    LOG(WARNING) << "Exception writing trk dump file " << e.what();
+            }
+        }
+
+    consume_each(d_current_prn_length_samples); // this is necessary in gr::block derivates
+    d_sample_counter += d_current_prn_length_samples; //count for the processed samples
+
+    return 1; //output tracking result ALWAYS even in the case of d_enable_tracking==false
+}
+
+
+
+void Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc::set_channel(unsigned int channel)
+{
+    d_channel = channel;
+    LOG(INFO) << "Tracking Channel set to " << d_channel;
+    // ############# ENABLE DATA FILE LOG #################
+    if (d_dump == true)
+        {
+            if (d_dump_file.is_open() == false)
+                {
+                    try
+                    {
+                            d_dump_filename.append(boost::lexical_cast<std::string>(d_channel));
+                            d_dump_filename.append(".dat");
+                            d_dump_file.exceptions (std::ifstream::failbit | std::ifstream::badbit);
+                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            LOG(INFO) << "Tracking dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
+                    }
+                    catch (const std::ifstream::failure &e)
+                    {
+                            LOG(WARNING) << "channel " << d_channel << " Exception opening trk dump file " << e.what();
+                    }
+                }
+        }
+}
+
+
+void Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc::msg_handler_vector_aid(pmt::pmt_t msg)
+{
+    try
+    {
+            if (pmt::any_ref(msg).type() == typeid(std::shared_ptr<Gnss_Vector_Aid>))
+                {
+                    std::shared_ptr<Gnss_Vector_Aid> aid = boost::any_cast<std::shared_ptr<Gnss_Vector_Aid>>(pmt::any_ref(msg));
+                    // The PVT block sends the aids of all the channels to every channel
+                    if (d_enable_tracking and aid->Channel_ID == static_cast<int>(d_channel)
+                            and aid->PRN == d_acquisition_gnss_synchro->PRN)
+                        {
+                            d_aid = *aid;
+                            d_aid_pending = true;
+                        }
+                }
+    }
+    catch(boost::bad_any_cast& e)
+    {
+            LOG(WARNING) << "msg_handler_vector_aid Bad any cast!";
+    }
+}
+
+
+void Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc::set_gnss_synchro(Gnss_Synchro* p_gnss_synchro)
+{
+    d_acquisition_gnss_synchro = p_gnss_synchro;
+}
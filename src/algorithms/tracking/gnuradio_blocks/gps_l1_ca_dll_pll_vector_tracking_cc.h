@@ -0,0 +1,234 @@
+/*!
+ * \file gps_l1_ca_dll_pll_vector_tracking_cc.h
+ * \brief Interface of a code DLL + carrier PLL tracking block aided by the
+ * PVT solution (vector DLL / FLL)
+ *
+ * Scalar code DLL + carrier PLL according to the algorithms described in:
+ * K.Borre, D.M.Akos, N.Bertelsen, P.Rinder, and S.H.Jensen,
+ * A Software-Defined GPS and Galileo Receiver. A Single-Frequency Approach,
+ * Birkhauser, 2007
+ * and vector aiding as described in:
+ * M. Lashley, D. M. Bevly, J. Y. Hung, Performance Analysis of Vector
+ * Tracking Algorithms for Weak GPS Signals in High Dynamics, IEEE Journal
+ * of Selected Topics in Signal Processing, vol. 3, no. 4, 2009
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GPS_L1_CA_DLL_PLL_VECTOR_TRACKING_CC_H
+#define GNSS_SDR_GPS_L1_CA_DLL_PLL_VECTOR_TRACKING_CC_H
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <gnuradio/block.h>
+#include "gnss_synchro.h"
+#include "gnss_vector_aid.h"
+#include "tracking_2nd_DLL_filter.h"
+#include "tracking_2nd_PLL_filter.h"
+#include "tracking_lock_detector.h"
+#include "cpu_multicorrelator.h"
+
+class Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc;
+
+typedef boost::shared_ptr<Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc>
+        gps_l1_ca_dll_pll_vector_tracking_cc_sptr;
+
+gps_l1_ca_dll_pll_vector_tracking_cc_sptr
+gps_l1_ca_dll_pll_make_vector_tracking_cc(long if_freq,
+                                   long fs_in, unsigned
+                                   int vector_length,
+                                   bool dump,
+                                   std::string dump_filename,
+                                   float pll_bw_hz,
+                                   float dll_bw_hz,
+                                   float early_late_space_chips,
+                                   float vector_dll_bw_hz,
+                                   float vector_code_gain,
+                                   float vector_carrier_gain,
+                                   float aid_timeout_s,
+                                   float coast_time_s,
+                                   float max_aid_doppler_error_hz);
+
+
+
+/*!
+ * \brief This class implements a DLL + PLL tracking loop block closed
+ * through the navigation solution.
+ *
+ * The block runs the scalar loops of Gps_L1_Ca_Dll_Pll_Tracking_cc, and
+ * receives on its "vector_aid" message port the code residual and the
+ * predicted Doppler of its satellite, computed by the PVT block from the
+ * position, velocity and clock of the receiver:
+ * - VDLL: a fraction of the pseudorange residual is removed from the code
+ *   phase at each fix, and the scalar DLL bandwidth is narrowed while aids
+ *   keep arriving, so that the code is mostly steered by the solution.
+ * - VFLL: while the carrier lock detector fails, the PLL center frequency
+ *   is pulled toward the predicted Doppler.
+ * - Coasting: when the lock detector would declare a loss of lock, the
+ *   channel keeps tracking on the predicted Doppler as long as fresh aids
+ *   arrive, up to a maximum coast time, instead of going back to acquisition.
+ * Without aids (e.g. before the first fix) it behaves as the scalar block.
+ * An aid whose Doppler is further than a bound from the tracked Doppler
+ * (from the previous aid while the carrier lock test fails) comes from a
+ * bad solution: it is dropped, and the channel stops being aided until a
+ * consistent one arrives.
+ *
+ * The aids arrive through the message port at the PVT output rate, with
+ * the latency of the telemetry decoder, observables and PVT blocks, so the
+ * loops are only steered once per fix.
+ */
+class Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc: public gr::block
+{
+public:
+    ~Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc();
+
+    void set_channel(unsigned int channel);
+    void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro);
+    void start_tracking();
+
+    int general_work (int noutput_items, gr_vector_int &ninput_items,
+            gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
+
+    void forecast (int noutput_items, gr_vector_int &ninput_items_required);
+
+private:
+    void msg_handler_vector_aid(pmt::pmt_t msg);
+
+    friend gps_l1_ca_dll_pll_vector_tracking_cc_sptr
+    gps_l1_ca_dll_pll_make_vector_tracking_cc(long if_freq,
+            long fs_in, unsigned
+            int vector_length,
+            bool dump,
+            std::string dump_filename,
+            float pll_bw_hz,
+            float dll_bw_hz,
+            float early_late_space_chips,
+            float vector_dll_bw_hz,
+            float vector_code_gain,
+            float vector_carrier_gain,
+            float aid_timeout_s,
+            float coast_time_s,
+            float max_aid_doppler_error_hz);
+
+    Gps_L1_Ca_Dll_Pll_Vector_Tracking_cc(long if_freq,
+            long fs_in, unsigned
+            int vector_length,
+            bool dump,
+            std::string dump_filename,
+            float pll_bw_hz,
+            float dll_bw_hz,
+            float early_late_space_chips,
+            float vector_dll_bw_hz,
+            float vector_code_gain,
+            float vector_carrier_gain,
+            float aid_timeout_s,
+            float coast_time_s,
+            float max_aid_doppler_error_hz);
+
+    // tracking configuration vars
+    unsigned int d_vector_length;
+    bool d_dump;
+
+    Gnss_Synchro* d_acquisition_gnss_synchro;
+    unsigned int d_channel;
+
+    long d_if_freq;
+    long d_fs_in;
+
+    double d_early_late_spc_chips;
+
+    // remaining code phase and carrier phase between tracking loops
+    double d_rem_code_phase_samples;
+    double d_rem_code_phase_chips;
+    double d_rem_carr_phase_rad;
+
+    // PLL and DLL filter library
+    Tracking_2nd_DLL_filter d_code_loop_filter;
+    Tracking_2nd_PLL_filter d_carrier_loop_filter;
+
+    // acquisition
+    double d_acq_code_phase_samples;
+    double d_acq_carrier_doppler_hz;
+    // correlator
+    int d_n_correlator_taps;
+    gr_complex* d_ca_code;
+    float* d_local_code_shift_chips;
+    gr_complex* d_correlator_outs;
+    cpu_multicorrelator multicorrelator_cpu;
+
+
+    // tracking vars
+    double d_code_freq_chips;
+    double d_code_phase_step_chips;
+    double d_carrier_doppler_hz;
+    double d_carrier_phase_step_rad;
+    double d_acc_carrier_phase_rad;
+    double d_code_phase_samples;
+    double d_acc_code_phase_secs;
+
+    //PRN period in samples
+    int d_current_prn_length_samples;
+
+    //processing samples counters
+    unsigned long int d_sample_counter;
+    unsigned long int d_acq_sample_stamp;
+
+    // CN0 estimation and lock detector
+    Tracking_Lock_Detector d_lock_detector;
+    double d_carrier_lock_test;
+    double d_CN0_SNV_dB_Hz;
+    int d_carrier_lock_fail_counter;
+
+    // control vars
+    bool d_enable_tracking;
+    bool d_pull_in;
+
+    // vector tracking
+    double d_dll_bw_hz;
+    double d_vector_dll_bw_hz;
+    double d_vector_code_gain;     // [1/s]
+    double d_vector_carrier_gain;  // [1/s]
+    double d_aid_timeout_s;
+    double d_coast_time_s;
+    double d_max_aid_doppler_error_hz;
+    unsigned int d_rejected_aids;
+    Gnss_Vector_Aid d_aid;     // last aid received for the satellite in track
+    bool d_aid_pending;        // d_aid not applied yet
+    double d_last_aid_timestamp_s;
+    double d_last_aid_doppler_hz;  // Doppler of the last aid applied
+    bool d_vector_dll;         // the DLL runs at d_vector_dll_bw_hz
+    bool d_coasting;
+    double d_coast_start_s;
+
+    // file dump
+    std::string d_dump_filename;
+    std::ofstream d_dump_file;
+
+    std::map<std::string, std::string> systemName;
+    std::string sys;
+};
+
+#endif //GNSS_SDR_GPS_L1_CA_DLL_PLL_VECTOR_TRACKING_CC_H
@@ -43,6 +43,8 @@
 #include "gnss_synchro.h"
 #include "tracking_2nd_DLL_filter.h"
 #include "tracking_2nd_PLL_filter.h"
+#include "tracking_kalman_filter.h"
+#include "tracking_lock_detector.h"
 #include "cpu_multicorrelator.h"
 
 class gps_l2_m_dll_pll_tracking_cc;
@@ -74,6 +76,12 @@ public:
     void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro);
     void start_tracking();
 
+    /*!
+     * \brief Replaces the PLL and DLL loop filters by a Kalman filter with the
+     * given process noise (see Tracking_Kalman_filter::set_process_noise)
+     */
+    void enable_kalman_filter(float clock_noise, float dynamics_noise, float code_noise);
+
     int general_work (int noutput_items, gr_vector_int &ninput_items,
             gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
@@ -118,6 +126,8 @@ private:
     // PLL and DLL filter library
     Tracking_2nd_DLL_filter d_code_loop_filter;
     Tracking_2nd_PLL_filter d_carrier_loop_filter;
+    Tracking_Kalman_filter d_kalman_filter;
+    bool d_use_kalman_filter;
 
     // acquisition
     double d_acq_code_phase_samples;
@@ -146,11 +156,9 @@ private:
     unsigned long int d_acq_sample_stamp;
 
     // CN0 estimation and lock detector
-    int d_cn0_estimation_counter;
-    gr_complex* d_Prompt_buffer;
+    Tracking_Lock_Detector d_lock_detector;
     double d_carrier_lock_test;
     double d_CN0_SNV_dB_Hz;
-    double d_carrier_lock_threshold;
     int d_carrier_lock_fail_counter;
 
     // control vars
@@ -118,12 +118,13 @@ bool cpu_multicorrelator::Carrier_wipeoff_multicorrelator_resampler(
         float code_phase_step_chips,
         int signal_length_samples)
 {
-    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips);
     // Regenerate phase at each call in order to avoid numerical issues
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
-    // call VOLK_GNSSSDR kernel
-    volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0, - phase_step_rad)), phase_offset_as_complex, (const lv_32fc_t**)d_local_codes_resampled, d_n_correlators, signal_length_samples);
+    // call VOLK_GNSSSDR kernel. The code replicas are resampled on the fly,
+    // so d_local_codes_resampled is only filled by update_local_code()
+    volk_gnsssdr_32fc_x2_rotator_resampler_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0, - phase_step_rad)), phase_offset_as_complex,
+            d_local_code_in, rem_code_phase_chips, code_phase_step_chips, d_shifts_chips, d_code_length_chips, d_n_correlators, signal_length_samples);
     return true;
 }
 
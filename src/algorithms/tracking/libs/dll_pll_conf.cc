@@ -0,0 +1,52 @@
+/*!
+ * \file dll_pll_conf.cc
+ * \brief Configuration of the generic DLL/PLL tracking block
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "dll_pll_conf.h"
+
+Dll_Pll_Conf::Dll_Pll_Conf()
+{
+    if_freq = 0;
+    fs_in = 0;
+    vector_length = 0;
+    dump = false;
+    dump_filename = "./dll_pll_tracking_ch_";
+    pll_bw_hz = 50.0;
+    dll_bw_hz = 2.0;
+    pll_bw_narrow_hz = 20.0;
+    dll_bw_narrow_hz = 2.0;
+    early_late_space_chips = 0.5;
+    very_early_late_space_chips = 0.6;
+    extend_correlation_ms = 1;
+    cn0_samples = 0;
+    cn0_min = 25.0;
+    carrier_lock_th = 0.0;
+    monitor_taps = 0;
+    monitor_spacing_chips = 0.1;
+    monitor_period = 1000;
+}
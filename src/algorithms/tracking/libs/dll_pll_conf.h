@@ -0,0 +1,64 @@
+/*!
+ * \file dll_pll_conf.h
+ * \brief Configuration of the generic DLL/PLL tracking block
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DLL_PLL_CONF_H_
+#define GNSS_SDR_DLL_PLL_CONF_H_
+
+#include <string>
+
+/*!
+ * \brief Parameters of the dll_pll_tracking blocks, read from the
+ * configuration by their adapter
+ */
+class Dll_Pll_Conf
+{
+public:
+    long if_freq;
+    long fs_in;
+    unsigned int vector_length;          //!< Samples of one primary code period
+    bool dump;
+    std::string dump_filename;
+    float pll_bw_hz;                     //!< PLL bandwidth [Hz]
+    float dll_bw_hz;                     //!< DLL bandwidth [Hz]
+    float pll_bw_narrow_hz;              //!< PLL bandwidth once the secondary code is synchronized [Hz]
+    float dll_bw_narrow_hz;              //!< DLL bandwidth once the secondary code is synchronized [Hz]
+    float early_late_space_chips;
+    float very_early_late_space_chips;   //!< Only used by the signals with Very Early and Very Late correlators
+    int extend_correlation_ms;           //!< Coherent integration once the secondary code is synchronized [ms]
+    int cn0_samples;                     //!< Prompts of each C/N0 and lock estimate, 0 for the default of the signal
+    float cn0_min;                       //!< Minimum C/N0 of the code lock [dB-Hz]
+    float carrier_lock_th;               //!< Minimum carrier lock indicator, 0 for the default of the signal
+    int monitor_taps;                    //!< Correlators of the correlation shape monitor, 0 to disable it
+    float monitor_spacing_chips;         //!< Spacing of the correlation shape monitor correlators [chips]
+    int monitor_period;                  //!< Primary code periods between two correlation shapes
+
+    Dll_Pll_Conf();
+};
+
+#endif
@@ -52,9 +52,13 @@ void Tracking_2nd_DLL_filter::calculate_lopp_coef(float* tau1,float* tau2, float
 
 void Tracking_2nd_DLL_filter::set_DLL_BW(float dll_bw_hz)
 {
+    float old_gain = d_tau1_code > 0 ? d_tau2_code / d_tau1_code : 0.0;
     //Calculate filter coefficient values
     d_dllnoisebandwidth  = dll_bw_hz;
     calculate_lopp_coef(&d_tau1_code, &d_tau2_code, d_dllnoisebandwidth, d_dlldampingratio, 1.0);// Calculate filter coefficient values
+    // The last output holds the proportional term of the last error: recompute it with
+    // the new gain, so that a change of bandwidth while tracking does not leave an offset
+    d_old_code_nco += (d_tau2_code / d_tau1_code - old_gain) * d_old_code_error;
 }
 
 
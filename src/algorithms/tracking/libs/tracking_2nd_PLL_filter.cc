@@ -51,9 +51,13 @@ void Tracking_2nd_PLL_filter::calculate_lopp_coef(float* tau1,float* tau2, float
 
 void Tracking_2nd_PLL_filter::set_PLL_BW(float pll_bw_hz)
 {
+    float old_gain = d_tau1_carr > 0 ? d_tau2_carr / d_tau1_carr : 0.0;
     //Calculate filter coefficient values
     d_pllnoisebandwidth = pll_bw_hz;
     calculate_lopp_coef(&d_tau1_carr, &d_tau2_carr, d_pllnoisebandwidth, d_plldampingratio, 0.25); // Calculate filter coefficient values
+    // The last output holds the proportional term of the last error: recompute it with
+    // the new gain, so that a change of bandwidth while tracking does not leave an offset
+    d_old_carr_nco += (d_tau2_carr / d_tau1_carr - old_gain) * d_old_carr_error;
 }
 
 
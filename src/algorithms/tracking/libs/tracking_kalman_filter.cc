@@ -0,0 +1,233 @@
+/*!
+ * \file tracking_kalman_filter.cc
+ * \brief Implementation of a Kalman filter that replaces the PLL and DLL loop
+ * filters of the tracking blocks
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "tracking_kalman_filter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+const double TWO_PI = 6.283185307179586;
+const double MIN_CN0_DB_HZ = 10.0;
+const double MAX_CN0_DB_HZ = 60.0;
+const double DEFAULT_CN0_DB_HZ = 40.0;     // until the first C/N0 estimate
+const double INITIAL_PHASE_STD_CYCLES = 0.25;
+const double INITIAL_DOPPLER_RATE_STD_HZ_S = 10.0;
+const double INITIAL_CODE_STD_CHIPS = 0.25;
+}
+
+
+Tracking_Kalman_filter::Tracking_Kalman_filter(float pdi)
+{
+    d_pdi = pdi;
+    d_early_late_space_chips = 0.5;
+    d_clock_noise = 1.0;
+    d_dynamics_noise = 1.0;
+    d_code_noise = 1e-4;
+    initialize(0.0, 0.0);
+}
+
+
+Tracking_Kalman_filter::Tracking_Kalman_filter() : Tracking_Kalman_filter(0.001)
+{}
+
+
+void Tracking_Kalman_filter::set_pdi(float pdi)
+{
+    d_pdi = pdi;
+    update_measurement_noise();
+}
+
+
+void Tracking_Kalman_filter::set_early_late_space_chips(float early_late_space_chips)
+{
+    d_early_late_space_chips = early_late_space_chips;
+    update_measurement_noise();
+}
+
+
+void Tracking_Kalman_filter::set_process_noise(float clock_noise, float dynamics_noise, float code_noise)
+{
+    d_clock_noise = clock_noise;
+    d_dynamics_noise = dynamics_noise;
+    d_code_noise = code_noise;
+}
+
+
+void Tracking_Kalman_filter::set_cn0(float cn0_db_hz)
+{
+    d_cn0_db_hz = std::min(std::max(static_cast<double>(cn0_db_hz), MIN_CN0_DB_HZ), MAX_CN0_DB_HZ);
+    update_measurement_noise();
+}
+
+
+void Tracking_Kalman_filter::update_measurement_noise()
+{
+    // Variance of the discriminators, in thermal noise only
+    double cn0_t = std::pow(10.0, d_cn0_db_hz / 10.0) * d_pdi;
+    // two-quadrant arctangent PLL discriminator
+    d_r_carrier = (1.0 / (2.0 * cn0_t)) * (1.0 + 1.0 / (2.0 * cn0_t)) / (TWO_PI * TWO_PI);
+    // normalized noncoherent early minus late envelope, with an early-late spacing D < 2 chips
+    double spacing = std::min(2.0 * d_early_late_space_chips, 1.9);
+    d_r_code = spacing / (4.0 * cn0_t) * (1.0 + 2.0 / ((2.0 - spacing) * cn0_t));
+}
+
+
+void Tracking_Kalman_filter::initialize(double carrier_doppler_hz, double doppler_uncertainty_hz)
+{
+    d_x[0] = 0.0;
+    d_x[1] = carrier_doppler_hz;
+    d_x[2] = 0.0;
+    d_x[3] = 0.0;
+    for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 4; j++)
+                {
+                    d_p[i][j] = 0.0;
+                }
+        }
+    d_p[0][0] = INITIAL_PHASE_STD_CYCLES * INITIAL_PHASE_STD_CYCLES;
+    d_p[1][1] = doppler_uncertainty_hz * doppler_uncertainty_hz;
+    d_p[2][2] = INITIAL_DOPPLER_RATE_STD_HZ_S * INITIAL_DOPPLER_RATE_STD_HZ_S;
+    d_p[3][3] = INITIAL_CODE_STD_CHIPS * INITIAL_CODE_STD_CHIPS;
+    d_nco_doppler_hz = carrier_doppler_hz;
+    d_code_correction_chips = 0.0;
+    d_cn0_db_hz = DEFAULT_CN0_DB_HZ;
+    update_measurement_noise();
+}
+
+
+void Tracking_Kalman_filter::update(double carrier_error_cycles, double code_error_chips)
+{
+    const double T = d_pdi;
+
+    // The PLL discriminator measures the phase error averaged over the interval, with the NCO at d_nco_doppler_hz
+    const double h[4] = {1.0, T / 2.0, T * T / 6.0, 0.0};
+    double innovation[2];
+    innovation[0] = carrier_error_cycles - (h[0] * d_x[0] + h[1] * (d_x[1] - d_nco_doppler_hz) + h[2] * d_x[2]);
+    innovation[1] = code_error_chips - d_x[3];
+
+    // P H' (4 x 2) and S = H P H' + R (2 x 2)
+    double ph[4][2];
+    for (int i = 0; i < 4; i++)
+        {
+            ph[i][0] = d_p[i][0] * h[0] + d_p[i][1] * h[1] + d_p[i][2] * h[2];
+            ph[i][1] = d_p[i][3];
+        }
+    double s00 = h[0] * ph[0][0] + h[1] * ph[1][0] + h[2] * ph[2][0] + d_r_carrier;
+    double s01 = h[0] * ph[0][1] + h[1] * ph[1][1] + h[2] * ph[2][1];
+    double s11 = ph[3][1] + d_r_code;
+    double det = s00 * s11 - s01 * s01;
+    if (det <= 0.0)
+        {
+            return;
+        }
+    double si00 = s11 / det;
+    double si01 = -s01 / det;
+    double si11 = s00 / det;
+
+    // K = P H' S^-1, x = x + K y, P = P - K H P
+    double k[4][2];
+    for (int i = 0; i < 4; i++)
+        {
+            k[i][0] = ph[i][0] * si00 + ph[i][1] * si01;
+            k[i][1] = ph[i][0] * si01 + ph[i][1] * si11;
+            d_x[i] += k[i][0] * innovation[0] + k[i][1] * innovation[1];
+        }
+    for (int i = 0; i < 4; i++)
+        {
+            for (int j = i; j < 4; j++)
+                {
+                    // (H P)(:, j) is ph[j][:], since P is symmetric
+                    double value = d_p[i][j] - k[i][0] * ph[j][0] - k[i][1] * ph[j][1];
+                    d_p[i][j] = value;
+                    d_p[j][i] = value;
+                }
+        }
+
+    predict();
+
+    // NCO commands: remove the code error now, and the phase error within the next interval
+    d_code_correction_chips = d_x[3];
+    d_x[3] = 0.0;
+    d_nco_doppler_hz = d_x[1] + d_x[2] * T / 2.0 + d_x[0] / T;
+}
+
+
+void Tracking_Kalman_filter::predict()
+{
+    const double T = d_pdi;
+    const double T2 = T * T;
+    const double T3 = T2 * T;
+
+    // State transition to the end of the interval, with the NCO at d_nco_doppler_hz
+    d_x[0] += (d_x[1] - d_nco_doppler_hz) * T + d_x[2] * T2 / 2.0;
+    d_x[1] += d_x[2] * T;
+
+    // P = F P F' with F = [1 T T^2/2 0; 0 1 T 0; 0 0 1 0; 0 0 0 1]
+    const double f[3][3] = {{1.0, T, T2 / 2.0}, {0.0, 1.0, T}, {0.0, 0.0, 1.0}};
+    double fp[3][4];
+    for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 4; j++)
+                {
+                    fp[i][j] = f[i][0] * d_p[0][j] + f[i][1] * d_p[1][j] + f[i][2] * d_p[2][j];
+                }
+        }
+    for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+                {
+                    d_p[i][j] = fp[i][0] * f[j][0] + fp[i][1] * f[j][1] + fp[i][2] * f[j][2];
+                }
+            d_p[i][3] = fp[i][3];
+            d_p[3][i] = fp[i][3];
+        }
+
+    // Q: Doppler rate random walk, clock frequency random walk and code phase random walk
+    const double qa = d_dynamics_noise;
+    const double qf = d_clock_noise;
+    d_p[0][0] += qa * T2 * T3 / 20.0 + qf * T3 / 3.0;
+    d_p[0][1] += qa * T2 * T2 / 8.0 + qf * T2 / 2.0;
+    d_p[1][0] += qa * T2 * T2 / 8.0 + qf * T2 / 2.0;
+    d_p[0][2] += qa * T3 / 6.0;
+    d_p[2][0] += qa * T3 / 6.0;
+    d_p[1][1] += qa * T3 / 3.0 + qf * T;
+    d_p[1][2] += qa * T2 / 2.0;
+    d_p[2][1] += qa * T2 / 2.0;
+    d_p[2][2] += qa * T;
+    d_p[3][3] += d_code_noise * T;
+}
+
+
+double Tracking_Kalman_filter::get_carrier_phase_std_cycles() const
+{
+    return std::sqrt(d_p[0][0]);
+}
@@ -0,0 +1,120 @@
+/*!
+ * \file tracking_kalman_filter.h
+ * \brief Interface of a Kalman filter that replaces the PLL and DLL loop
+ * filters of the tracking blocks
+ *
+ * The filter estimates the carrier phase error, the carrier Doppler, the
+ * Doppler rate and the code phase error from the discriminator outputs, with
+ * a measurement noise computed from the C/N0 estimate, as described in:
+ * J. H. Won, T. Pany, B. Eissfeller, Characteristics of Kalman Filters for
+ * GNSS Signal Tracking Loop, IEEE Transactions on Aerospace and Electronic
+ * Systems, vol. 48, no. 4, 2012
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_KALMAN_FILTER_H_
+#define GNSS_SDR_TRACKING_KALMAN_FILTER_H_
+
+/*!
+ * \brief This class implements a Kalman filter for the carrier and code
+ * tracking loops.
+ *
+ * The state is [carrier phase error [cycles], carrier Doppler [Hz], Doppler
+ * rate [Hz/s], code phase error [chips]], where both errors are the ones of
+ * the local replica at the start of the next integration interval. The
+ * measurements are the PLL discriminator (phase error averaged over the
+ * interval, in cycles) and the DLL discriminator (in chips).
+ *
+ * The measurement noise follows the C/N0 estimate, so the equivalent loop
+ * bandwidth narrows by itself as the signal weakens, instead of being fixed.
+ * The process noise models the receiver clock frequency random walk, the
+ * line of sight dynamics (a random walk of the Doppler rate) and the code
+ * carrier divergence.
+ *
+ * The carrier NCO is commanded with the Doppler estimate plus the phase
+ * error to be removed within the next interval, and the code NCO with the
+ * estimated code phase error, which is then removed from the state.
+ */
+class Tracking_Kalman_filter
+{
+public:
+    Tracking_Kalman_filter();
+    Tracking_Kalman_filter(float pdi);
+
+    void set_pdi(float pdi);                                  //!< Set the integration time [s]
+    void set_early_late_space_chips(float early_late_space_chips); //!< Set the Early-Prompt spacing [chips]
+
+    /*!
+     * \brief Sets the process noise spectral densities
+     * \param[in] clock_noise Receiver clock frequency random walk [Hz^2/s]
+     * \param[in] dynamics_noise Doppler rate random walk [Hz^2/s^3]
+     * \param[in] code_noise Code phase random walk [chips^2/s]
+     */
+    void set_process_noise(float clock_noise, float dynamics_noise, float code_noise);
+
+    //! Sets the measurement noise from the C/N0 estimate [dB-Hz]
+    void set_cn0(float cn0_db_hz);
+
+    //! Starts a new track at carrier_doppler_hz, known within doppler_uncertainty_hz (1 sigma), at a nominal C/N0
+    void initialize(double carrier_doppler_hz, double doppler_uncertainty_hz);
+
+    /*!
+     * \brief Processes the discriminator outputs of the last interval
+     * \param[in] carrier_error_cycles PLL discriminator [cycles]
+     * \param[in] code_error_chips DLL discriminator [chips]
+     */
+    void update(double carrier_error_cycles, double code_error_chips);
+
+    //! Carrier NCO frequency for the next interval [Hz]
+    double get_nco_doppler_hz() const { return d_nco_doppler_hz; }
+
+    //! Code phase shift to apply at the start of the next interval [chips]
+    double get_code_correction_chips() const { return d_code_correction_chips; }
+
+    double get_doppler_hz() const { return d_x[1]; }         //!< Filtered carrier Doppler [Hz]
+    double get_doppler_rate_hz_s() const { return d_x[2]; }  //!< Filtered Doppler rate [Hz/s]
+    double get_carrier_phase_std_cycles() const;              //!< Standard deviation of the phase error [cycles]
+
+private:
+    void predict();
+    void update_measurement_noise();
+
+    double d_pdi;
+    double d_early_late_space_chips;
+    double d_clock_noise;
+    double d_dynamics_noise;
+    double d_code_noise;
+    double d_cn0_db_hz;
+    double d_r_carrier;    // measurement noise variances
+    double d_r_code;
+
+    double d_x[4];         // state
+    double d_p[4][4];      // state covariance
+    double d_nco_doppler_hz;
+    double d_code_correction_chips;
+};
+
+#endif
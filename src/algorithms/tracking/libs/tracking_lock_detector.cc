@@ -0,0 +1,177 @@
+/*!
+ * \file tracking_lock_detector.cc
+ * \brief Implementation of a streaming C/N0 estimator and lock detector for
+ * the tracking blocks
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "tracking_lock_detector.h"
+#include <algorithm>
+#include <cmath>
+
+#define LOCK_DETECTOR_DEFAULT_WINDOW 20
+#define LOCK_DETECTOR_DEFAULT_CN0_THRESHOLD 25.0
+#define LOCK_DETECTOR_DEFAULT_CARRIER_LOCK_THRESHOLD 0.85
+#define LOCK_DETECTOR_DEFAULT_FLL_LOCK_THRESHOLD 0.2
+#define LOCK_DETECTOR_MINIMUM_SNR 1e-10
+
+
+Tracking_Lock_Detector::Tracking_Lock_Detector()
+{
+    d_window = LOCK_DETECTOR_DEFAULT_WINDOW;
+    d_cn0_offset_db = 0.0;
+    d_cn0_threshold = LOCK_DETECTOR_DEFAULT_CN0_THRESHOLD;
+    d_carrier_lock_threshold = LOCK_DETECTOR_DEFAULT_CARRIER_LOCK_THRESHOLD;
+    d_fll_lock_threshold = LOCK_DETECTOR_DEFAULT_FLL_LOCK_THRESHOLD;
+    reset();
+}
+
+
+Tracking_Lock_Detector::Tracking_Lock_Detector(int window) : Tracking_Lock_Detector()
+{
+    set_window(window);
+}
+
+
+void Tracking_Lock_Detector::set_window(int window)
+{
+    d_window = std::max(window, 2);
+}
+
+
+void Tracking_Lock_Detector::set_integration(long fs_in, double code_length)
+{
+    d_cn0_offset_db = 10.0 * std::log10(static_cast<double>(fs_in) / 2.0) - 10.0 * std::log10(code_length);
+}
+
+
+void Tracking_Lock_Detector::set_cn0_threshold(double cn0_db_hz)
+{
+    d_cn0_threshold = cn0_db_hz;
+}
+
+
+void Tracking_Lock_Detector::set_carrier_lock_threshold(double threshold)
+{
+    d_carrier_lock_threshold = threshold;
+}
+
+
+void Tracking_Lock_Detector::set_fll_lock_threshold(double threshold)
+{
+    d_fll_lock_threshold = threshold;
+}
+
+
+void Tracking_Lock_Detector::reset()
+{
+    d_count = 0;
+    d_sum_i = 0.0;
+    d_sum_q = 0.0;
+    d_sum_abs_i = 0.0;
+    d_sum_power = 0.0;
+    d_sum_power2 = 0.0;
+    d_sum_fll_dot = 0.0;
+    d_sum_fll_power = 0.0;
+    d_last_prompt = gr_complex(0.0, 0.0);
+    d_last_prompt_valid = false;
+
+    d_cn0_snv_db_hz = 0.0;
+    d_cn0_m2m4_db_hz = 0.0;
+    d_carrier_lock_test = 1.0;
+    d_fll_lock_test = 1.0;
+    d_carrier_locked = false;
+    d_cycle_slip = false;
+}
+
+
+bool Tracking_Lock_Detector::update(const gr_complex& prompt)
+{
+    const double i = prompt.real();
+    const double q = prompt.imag();
+    const double power = i * i + q * q;
+    d_sum_i += i;
+    d_sum_q += q;
+    d_sum_abs_i += std::fabs(i);
+    d_sum_power += power;
+    d_sum_power2 += power * power;
+    if (d_last_prompt_valid)
+        {
+            // z = P(k) conj(P(k-1)) rotates by the carrier phase change between
+            // the two prompts, and z^2 does not depend on a data bit transition
+            const double dot = i * d_last_prompt.real() + q * d_last_prompt.imag();
+            const double cross = q * d_last_prompt.real() - i * d_last_prompt.imag();
+            d_sum_fll_dot += dot * dot - cross * cross;
+            d_sum_fll_power += dot * dot + cross * cross;
+        }
+    d_last_prompt = prompt;
+    d_last_prompt_valid = true;
+
+    d_count++;
+    if (d_count < d_window)
+        {
+            return false;
+        }
+    estimate();
+    d_count = 0;
+    d_sum_i = 0.0;
+    d_sum_q = 0.0;
+    d_sum_abs_i = 0.0;
+    d_sum_power = 0.0;
+    d_sum_power2 = 0.0;
+    d_sum_fll_dot = 0.0;
+    d_sum_fll_power = 0.0;
+    return true;
+}
+
+
+void Tracking_Lock_Detector::estimate()
+{
+    const double n = static_cast<double>(d_count);
+
+    // SNV: the signal power is the squared mean of |I|, the noise the rest of the total power
+    const double m2 = d_sum_power / n;
+    double signal_power = (d_sum_abs_i / n) * (d_sum_abs_i / n);
+    double snr = signal_power / std::max(m2 - signal_power, LOCK_DETECTOR_MINIMUM_SNR * signal_power);
+    d_cn0_snv_db_hz = 10.0 * std::log10(std::max(snr, LOCK_DETECTOR_MINIMUM_SNR)) + d_cn0_offset_db;
+
+    // M2M4: for a constant envelope signal in Gaussian noise, M4 = 2 M2^2 - S^2
+    const double m4 = d_sum_power2 / n;
+    signal_power = std::sqrt(std::max(2.0 * m2 * m2 - m4, 0.0));
+    snr = signal_power / std::max(m2 - signal_power, LOCK_DETECTOR_MINIMUM_SNR * signal_power);
+    d_cn0_m2m4_db_hz = 10.0 * std::log10(std::max(snr, LOCK_DETECTOR_MINIMUM_SNR)) + d_cn0_offset_db;
+
+    // Carrier lock: NBD / NBP, the cosine of twice the carrier phase error
+    const double nbp = d_sum_i * d_sum_i + d_sum_q * d_sum_q;
+    d_carrier_lock_test = nbp > 0.0 ? (d_sum_i * d_sum_i - d_sum_q * d_sum_q) / nbp : 0.0;
+
+    // Frequency lock: the cosine of twice the carrier phase change between prompts
+    d_fll_lock_test = d_sum_fll_power > 0.0 ? d_sum_fll_dot / d_sum_fll_power : 0.0;
+
+    const bool carrier_locked = carrier_lock();
+    d_cycle_slip = d_carrier_locked and !carrier_locked and fll_lock();
+    d_carrier_locked = carrier_locked;
+}
@@ -0,0 +1,126 @@
+/*!
+ * \file tracking_lock_detector.h
+ * \brief Interface of a streaming C/N0 estimator and lock detector for the
+ * tracking blocks
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_LOCK_DETECTOR_H_
+#define GNSS_SDR_TRACKING_LOCK_DETECTOR_H_
+
+#include <gnuradio/gr_complex.h>
+
+/*!
+ * \brief This class estimates the C/N0 and the lock indicators of a tracking
+ * loop from its prompt correlator outputs, one at a time.
+ *
+ * Instead of buffering the prompts and running cn0_svn_estimator() and
+ * carrier_lock_detector() (see lock_detectors.h) over the buffer, each call
+ * to update() adds the prompt to running sums, so the cost per prompt is
+ * constant. Every window prompts the estimates are computed from the sums,
+ * which then start over:
+ *
+ *  - C/N0 with the Signal-to-Noise Variance (SNV) estimator, the same as
+ *    cn0_svn_estimator(), and with the second and fourth order moments (M2M4)
+ *    estimator, which does not need the data bits to be known.
+ *  - Carrier (phase) lock indicator, the cosine of twice the carrier phase
+ *    error NBD / NBP, as carrier_lock_detector().
+ *  - Frequency lock indicator, the cosine of twice the carrier phase rotation
+ *    between consecutive prompts, which does not depend on the data bits
+ *    either and stays high while a PLL slips cycles. The noise lowers it:
+ *    it is about 0.25 at a prompt SNR of 0 dB, and 0.9 at 15 dB.
+ *  - Code lock, a C/N0 (SNV) above a minimum.
+ *  - Cycle slip flag, set when the carrier lock is lost in a window after a
+ *    locked one while the frequency stays locked, which is how a slip of the
+ *    PLL shows in the indicators.
+ */
+class Tracking_Lock_Detector
+{
+public:
+    Tracking_Lock_Detector();
+    Tracking_Lock_Detector(int window);
+
+    void set_window(int window);                          //!< Set the number of prompts of each estimate
+    int get_window() const { return d_window; }
+
+    /*!
+     * \brief Sets the conversion of the prompt SNR to C/N0, as in cn0_svn_estimator()
+     * \param[in] fs_in Sampling frequency [Hz]
+     * \param[in] code_length Chips of each prompt integration
+     */
+    void set_integration(long fs_in, double code_length);
+
+    void set_cn0_threshold(double cn0_db_hz);             //!< Minimum C/N0 of the code lock [dB-Hz]
+    void set_carrier_lock_threshold(double threshold);    //!< Minimum carrier lock indicator
+    void set_fll_lock_threshold(double threshold);        //!< Minimum frequency lock indicator
+
+    //! Discards the prompts of the current window and the previous estimates
+    void reset();
+
+    //! Adds a prompt correlator output. Returns true when a new estimate is available
+    bool update(const gr_complex& prompt);
+
+    double get_cn0_snv_db_hz() const { return d_cn0_snv_db_hz; }      //!< C/N0, SNV estimator [dB-Hz]
+    double get_cn0_m2m4_db_hz() const { return d_cn0_m2m4_db_hz; }    //!< C/N0, M2M4 estimator [dB-Hz]
+    double get_carrier_lock_test() const { return d_carrier_lock_test; } //!< NBD / NBP
+    double get_fll_lock_test() const { return d_fll_lock_test; }      //!< Frequency lock indicator
+
+    bool code_lock() const { return d_cn0_snv_db_hz >= d_cn0_threshold; }
+    bool carrier_lock() const { return d_carrier_lock_test >= d_carrier_lock_threshold; }
+    bool fll_lock() const { return d_fll_lock_test >= d_fll_lock_threshold; }
+    bool cycle_slip() const { return d_cycle_slip; }
+
+private:
+    void estimate();
+
+    int d_window;
+    double d_cn0_offset_db;     // 10 log10(fs / 2) - 10 log10(code length)
+    double d_cn0_threshold;
+    double d_carrier_lock_threshold;
+    double d_fll_lock_threshold;
+
+    // running sums of the current window
+    int d_count;
+    double d_sum_i;             // NBD / NBP
+    double d_sum_q;
+    double d_sum_abs_i;         // SNV
+    double d_sum_power;         // SNV and M2M4
+    double d_sum_power2;        // M2M4
+    double d_sum_fll_dot;       // frequency lock
+    double d_sum_fll_power;
+    gr_complex d_last_prompt;
+    bool d_last_prompt_valid;
+
+    // estimates of the last window
+    double d_cn0_snv_db_hz;
+    double d_cn0_m2m4_db_hz;
+    double d_carrier_lock_test;
+    double d_fll_lock_test;
+    bool d_carrier_locked;
+    bool d_cycle_slip;
+};
+
+#endif
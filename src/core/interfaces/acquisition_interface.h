@@ -59,6 +59,13 @@ public:
     virtual void set_threshold(float threshold) = 0;
     virtual void set_doppler_max(unsigned int doppler_max) = 0;
     virtual void set_doppler_step(unsigned int doppler_step) = 0;
+    /*!
+     * \brief Restricts the Doppler search to doppler_center +/- doppler_window [Hz]
+     * within the configured grid (a window of 0 searches the whole grid). It is a
+     * hint, so implementations that cannot narrow their search ignore it.
+     */
+    virtual void set_doppler_window(int doppler_center __attribute__((unused)),
+            unsigned int doppler_window __attribute__((unused))) {}
     virtual void init() = 0;
     virtual void set_local_code() = 0;
     virtual signed int mag() = 0;
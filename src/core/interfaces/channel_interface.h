@@ -37,9 +37,12 @@
 #ifndef GNSS_SDR_CHANNEL_INTERFACE_H_
 #define GNSS_SDR_CHANNEL_INTERFACE_H_
 
+#include <memory>
 #include "gnss_block_interface.h"
 #include "gnss_signal.h"
 
+class Channel_Event_Queue;
+
 /*!
  * \brief This abstract class represents an interface to a channel GNSS block.
  *
@@ -54,6 +57,14 @@ public:
     virtual Gnss_Signal get_signal() const = 0;
     virtual void start_acquisition() = 0;
     virtual void set_signal(const Gnss_Signal&) = 0;
+    //! Feeds acquisition and tracking from the given block instead of the internal pass-through
+    virtual void set_sample_source(gr::basic_block_sptr source) = 0;
+    //! Restricts the acquisition Doppler search to doppler_center +/- doppler_window [Hz] (0: whole grid)
+    virtual void set_doppler_window(int doppler_center, unsigned int doppler_window) = 0;
+    //! Posts the acquisition and tracking events to the control thread through events
+    virtual void set_event_queue(std::shared_ptr<Channel_Event_Queue> events) = 0;
+    //! Block of the tracking implementation, target of the feedback from the PVT block
+    virtual gr::basic_block_sptr get_tracking_block() = 0;
 };
 
 #endif /* GNSS_SDR_CHANNEL_INTERFACE_H_ */
@@ -71,6 +71,9 @@ public:
     //! Get an integer (long) value from INI file, returning default_value if not found.
     long GetInteger(std::string section, std::string name, long default_value);
 
+    //! All the values read, with "section.name" lower case keys
+    const std::map<std::string, std::string>& GetValues() const { return _values; }
+
 private:
     int _error;
     std::map<std::string, std::string> _values;
@@ -0,0 +1,222 @@
+/*!
+ * \file property_table.cc
+ * \brief Configuration properties parsed once into typed values
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "property_table.h"
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <tuple>
+#include <utility>
+#include <glog/logging.h>
+
+using google::LogMessage;
+
+namespace
+{
+// Same conversion as StringConverter::convert
+template<typename T>
+void convert(const std::string& text, bool& valid, T& value)
+{
+    std::stringstream stream(text);
+    stream >> value;
+    valid = !stream.fail();
+}
+}
+
+
+Property_Table::Property_Table()
+{}
+
+
+std::size_t Property_Table::Hash::operator()(const std::string& name) const
+{
+    // FNV-1a of the lowercase name
+    std::size_t hash = 2166136261u;
+    for (std::string::const_iterator it = name.begin(); it != name.end(); ++it)
+        {
+            hash ^= static_cast<std::size_t>(std::tolower(static_cast<unsigned char>(*it)));
+            hash *= 16777619u;
+        }
+    return hash;
+}
+
+
+bool Property_Table::Equal::operator()(const std::string& a, const std::string& b) const
+{
+    if (a.size() != b.size())
+        {
+            return false;
+        }
+    for (std::size_t i = 0; i < a.size(); i++)
+        {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+                {
+                    return false;
+                }
+        }
+    return true;
+}
+
+
+void Property_Table::parse(Property& property)
+{
+    property.as_bool.valid = (property.value.compare("true") == 0) || (property.value.compare("false") == 0);
+    property.as_bool.value = (property.value.compare("true") == 0);
+    convert(property.value, property.as_long.valid, property.as_long.value);
+    convert(property.value, property.as_int.valid, property.as_int.value);
+    convert(property.value, property.as_unsigned_int.valid, property.as_unsigned_int.value);
+    convert(property.value, property.as_unsigned_short.valid, property.as_unsigned_short.value);
+    convert(property.value, property.as_float.valid, property.as_float.value);
+    convert(property.value, property.as_double.valid, property.as_double.value);
+}
+
+
+void Property_Table::set(const std::string& name, const std::string& value, bool overriding)
+{
+    std::unordered_map<std::string, Property, Hash, Equal>::iterator it = d_properties.find(name);
+    if (it == d_properties.end())
+        {
+            // Property holds an atomic, so it is built in place
+            it = d_properties.emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple()).first;
+            it->second.name = name;
+            it->second.used.store(false, std::memory_order_relaxed);
+        }
+    else if (it->second.overriding)
+        {
+            return;
+        }
+    it->second.value = value;
+    it->second.overriding = overriding;
+    parse(it->second);
+}
+
+
+const Property_Table::Property* Property_Table::find(const std::string& name) const
+{
+    std::unordered_map<std::string, Property, Hash, Equal>::const_iterator it = d_properties.find(name);
+    if (it == d_properties.end())
+        {
+            return nullptr;
+        }
+    it->second.used.store(true, std::memory_order_relaxed);
+    return &it->second;
+}
+
+
+bool Property_Table::is_present(const std::string& name) const
+{
+    return d_properties.count(name) > 0;
+}
+
+
+template<typename T>
+T Property_Table::typed(const std::string& name, const Typed<T> Property::*member, T default_value, const char* type_name) const
+{
+    const Property* property = find(name);
+    if (property == nullptr)
+        {
+            return default_value;
+        }
+    const Typed<T>& typed_value = property->*member;
+    if (!typed_value.valid)
+        {
+            if (!property->value.empty())
+                {
+                    LOG(WARNING) << "Configuration: " << property->name << "=" << property->value
+                                 << " is not a valid " << type_name << ". Using " << default_value;
+                }
+            return default_value;
+        }
+    return typed_value.value;
+}
+
+
+std::string Property_Table::get(const std::string& name, const std::string& default_value) const
+{
+    const Property* property = find(name);
+    return property == nullptr ? default_value : property->value;
+}
+
+
+bool Property_Table::get(const std::string& name, bool default_value) const
+{
+    return typed(name, &Property::as_bool, default_value, "boolean (true or false)");
+}
+
+
+long Property_Table::get(const std::string& name, long default_value) const
+{
+    return typed(name, &Property::as_long, default_value, "integer");
+}
+
+
+int Property_Table::get(const std::string& name, int default_value) const
+{
+    return typed(name, &Property::as_int, default_value, "integer");
+}
+
+
+unsigned int Property_Table::get(const std::string& name, unsigned int default_value) const
+{
+    return typed(name, &Property::as_unsigned_int, default_value, "unsigned integer");
+}
+
+
+unsigned short Property_Table::get(const std::string& name, unsigned short default_value) const
+{
+    return typed(name, &Property::as_unsigned_short, default_value, "unsigned integer");
+}
+
+
+float Property_Table::get(const std::string& name, float default_value) const
+{
+    return typed(name, &Property::as_float, default_value, "number");
+}
+
+
+double Property_Table::get(const std::string& name, double default_value) const
+{
+    return typed(name, &Property::as_double, default_value, "number");
+}
+
+
+std::vector<std::string> Property_Table::unused() const
+{
+    std::vector<std::string> names;
+    for (std::unordered_map<std::string, Property, Hash, Equal>::const_iterator it = d_properties.begin(); it != d_properties.end(); ++it)
+        {
+            if (!it->second.used.load(std::memory_order_relaxed))
+                {
+                    names.push_back(it->second.name);
+                }
+        }
+    std::sort(names.begin(), names.end());
+    return names;
+}
@@ -0,0 +1,124 @@
+/*!
+ * \file property_table.h
+ * \brief Configuration properties parsed once into typed values
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PROPERTY_TABLE_H_
+#define GNSS_SDR_PROPERTY_TABLE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*!
+ * \brief Table of configuration properties with typed values.
+ *
+ * Each value is converted to every type a block may ask for (with the same
+ * rules as StringConverter) when it is stored, so a lookup is one hash table
+ * search, without building a lowercase key or parsing a string. Names are
+ * case-insensitive, like in the INI reader.
+ *
+ * The table remembers which properties were read, so that the ones never
+ * used (usually misspelled names) can be reported, and warns when a value
+ * cannot be converted to the type it is read as.
+ *
+ * Lookups can run concurrently (the channels are built in parallel), but
+ * not at the same time as set().
+ */
+class Property_Table
+{
+public:
+    Property_Table();
+
+    /*!
+     * \brief Stores a property.
+     * \param[in] overriding If true, the value cannot be replaced by a later
+     * overriding value, but it replaces a value that was not overriding
+     */
+    void set(const std::string& name, const std::string& value, bool overriding = false);
+
+    bool is_present(const std::string& name) const;
+
+    std::string get(const std::string& name, const std::string& default_value) const;
+    bool get(const std::string& name, bool default_value) const;
+    long get(const std::string& name, long default_value) const;
+    int get(const std::string& name, int default_value) const;
+    unsigned int get(const std::string& name, unsigned int default_value) const;
+    unsigned short get(const std::string& name, unsigned short default_value) const;
+    float get(const std::string& name, float default_value) const;
+    double get(const std::string& name, double default_value) const;
+
+    //! Properties set but never read, in alphabetical order
+    std::vector<std::string> unused() const;
+
+    std::size_t size() const { return d_properties.size(); }
+
+private:
+    template<typename T>
+    struct Typed
+    {
+        bool valid;
+        T value;
+    };
+
+    struct Property
+    {
+        std::string name;  // as first written
+        std::string value;
+        bool overriding;
+        mutable std::atomic<bool> used; // set by lookups, which may run in parallel
+        Typed<bool> as_bool;
+        Typed<long> as_long;
+        Typed<int> as_int;
+        Typed<unsigned int> as_unsigned_int;
+        Typed<unsigned short> as_unsigned_short;
+        Typed<float> as_float;
+        Typed<double> as_double;
+    };
+
+    struct Hash
+    {
+        std::size_t operator()(const std::string& name) const;
+    };
+
+    struct Equal
+    {
+        bool operator()(const std::string& a, const std::string& b) const;
+    };
+
+    static void parse(Property& property);
+    const Property* find(const std::string& name) const;
+    template<typename T>
+    T typed(const std::string& name, const Typed<T> Property::*member, T default_value, const char* type_name) const;
+
+    std::unordered_map<std::string, Property, Hash, Equal> d_properties;
+};
+
+#endif /* GNSS_SDR_PROPERTY_TABLE_H_ */
@@ -0,0 +1,203 @@
+/*!
+ * \file channel_event_queue.h
+ * \brief Lock-free queue of the events posted by the channels to the
+ * control thread
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CHANNEL_EVENT_QUEUE_H_
+#define GNSS_SDR_CHANNEL_EVENT_QUEUE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+/*!
+ * \brief Event posted by a channel. The codes are the ones of the control
+ * messages: 0 acquisition failed, 1 acquisition succeeded, 2 tracking lost
+ */
+struct Channel_Event
+{
+    unsigned int channel;
+    unsigned int event;
+};
+
+/*!
+ * \brief Bounded multi-producer, single-consumer queue of channel events.
+ *
+ * The channels post their events from the GNU Radio block threads, and the
+ * control thread drains them in batches. Unlike gr::msg_queue, posting an
+ * event takes no lock and allocates no memory: each slot of the ring carries
+ * a sequence number that tells producers and the consumer whether it is free
+ * or filled (D. Vyukov's bounded queue). The consumer only takes a mutex to
+ * sleep when the queue is empty, and producers only take it to wake it up.
+ *
+ * push() fails if the queue is full, so that the caller can fall back to
+ * the control message queue and no event is ever lost.
+ */
+class Channel_Event_Queue
+{
+public:
+    //! The capacity is rounded up to a power of two
+    explicit Channel_Event_Queue(unsigned int capacity = 1024) :
+            d_enqueue_pos(0),
+            d_dequeue_pos(0),
+            d_sleeping(false),
+            d_woken(false)
+    {
+        d_capacity = 2;
+        while (d_capacity < capacity)
+            {
+                d_capacity *= 2;
+            }
+        d_mask = d_capacity - 1;
+        d_cells.reset(new Cell[d_capacity]);
+        for (std::size_t i = 0; i < d_capacity; i++)
+            {
+                d_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+    }
+
+    //! Posts an event. Safe from any thread. Returns false if the queue is full
+    bool push(unsigned int channel, unsigned int event)
+    {
+        Cell* cell;
+        std::size_t pos = d_enqueue_pos.load(std::memory_order_relaxed);
+        for (;;)
+            {
+                cell = &d_cells[pos & d_mask];
+                std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (difference == 0)
+                    {
+                        if (d_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                    }
+                else if (difference < 0)
+                    {
+                        return false;
+                    }
+                else
+                    {
+                        pos = d_enqueue_pos.load(std::memory_order_relaxed);
+                    }
+            }
+        cell->event.channel = channel;
+        cell->event.event = event;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        // Pairs with the fence in wait(): either the consumer sees the event, or we see it sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (d_sleeping.load(std::memory_order_relaxed))
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_condition.notify_one();
+            }
+        return true;
+    }
+
+    /*!
+     * \brief Takes up to max_events events, in the order they were posted.
+     * Only the consumer thread may call it.
+     * \return Number of events written to events
+     */
+    unsigned int pop(Channel_Event* events, unsigned int max_events)
+    {
+        unsigned int count = 0;
+        while (count < max_events)
+            {
+                Cell& cell = d_cells[d_dequeue_pos & d_mask];
+                if (cell.sequence.load(std::memory_order_acquire) != d_dequeue_pos + 1)
+                    {
+                        break; // empty, or the next event is still being written
+                    }
+                events[count++] = cell.event;
+                cell.sequence.store(d_dequeue_pos + d_capacity, std::memory_order_release);
+                d_dequeue_pos++;
+            }
+        return count;
+    }
+
+    //! True if there is an event to pop. Only the consumer thread may call it
+    bool ready() const
+    {
+        return d_cells[d_dequeue_pos & d_mask].sequence.load(std::memory_order_acquire) == d_dequeue_pos + 1;
+    }
+
+    /*!
+     * \brief Blocks the consumer until there is an event, wake_up() is called
+     * or the timeout expires.
+     * \return true if there is an event to pop
+     */
+    bool wait(unsigned int timeout_ms)
+    {
+        if (ready())
+            {
+                return true;
+            }
+        std::unique_lock<std::mutex> lock(d_mutex);
+        d_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        d_condition.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] { return d_woken || ready(); });
+        d_sleeping.store(false, std::memory_order_relaxed);
+        d_woken = false;
+        return ready();
+    }
+
+    //! Wakes the consumer up even if there are no events
+    void wake_up()
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_woken = true;
+        d_condition.notify_one();
+    }
+
+    unsigned int capacity() const { return d_capacity; }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        Channel_Event event;
+    };
+
+    std::unique_ptr<Cell[]> d_cells;
+    std::size_t d_capacity;
+    std::size_t d_mask;
+    std::atomic<std::size_t> d_enqueue_pos;
+    std::size_t d_dequeue_pos;  // only used by the consumer
+    std::atomic<bool> d_sleeping;
+    bool d_woken;               // guarded by d_mutex
+    std::mutex d_mutex;
+    std::condition_variable d_condition;
+};
+
+#endif /* GNSS_SDR_CHANNEL_EVENT_QUEUE_H_ */
@@ -31,7 +31,9 @@
 #ifndef GNSS_SDR_CONCURRENT_MAP_H
 #define GNSS_SDR_CONCURRENT_MAP_H
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <utility>
 #include <boost/thread/mutex.hpp>
 
@@ -41,63 +43,117 @@ template<typename Data>
 /*!
  * \brief This class implements a thread-safe std::map
  *
+ * The map is published as immutable snapshots (read-copy-update): a writer
+ * copies the current snapshot, which only holds pointers to the values,
+ * replaces one value and publishes the new snapshot. Readers take a
+ * reference to the current snapshot and read it without any lock, while
+ * writers publish newer ones. The only synchronization on the read side is a
+ * spinlock held while the snapshot pointer is copied, so readers never wait
+ * for a writer to copy data.
+ *
+ * Writes are expected to be rare (ephemerides, assistance records, fixes)
+ * compared to reads.
  */
 class concurrent_map
 {
-    typedef typename std::map<int,Data>::iterator Data_iterator; // iterator is scope dependent
-private:
-    std::map<int,Data> the_map;
-    boost::mutex the_mutex;
 public:
+    typedef std::map<int, std::shared_ptr<const Data>> Snapshot_map;
+    typedef std::shared_ptr<const Snapshot_map> Snapshot;
+
+    concurrent_map() : the_snapshot(std::make_shared<Snapshot_map>()), the_version(0)
+    {
+        the_pointer_lock.clear();
+    }
+
     void write(int key, Data const& data)
     {
-        boost::mutex::scoped_lock lock(the_mutex);
-        Data_iterator data_iter;
-        data_iter = the_map.find(key);
-        if (data_iter != the_map.end())
-            {
-                data_iter->second = data; // update
-            }
-        else
+        std::shared_ptr<const Data> value = std::make_shared<Data>(data);
+        boost::mutex::scoped_lock lock(the_writers_mutex);
+        std::shared_ptr<Snapshot_map> next = std::make_shared<Snapshot_map>(*load());
+        (*next)[key] = value;
+        publish(next);
+    }
+
+    //! Current state of the whole map, which later writes leave untouched
+    Snapshot snapshot() const
+    {
+        return load();
+    }
+
+    //! Value of key, or an empty pointer. The value is immutable and outlives later writes
+    std::shared_ptr<const Data> find(int key) const
+    {
+        Snapshot current = load();
+        typename Snapshot_map::const_iterator data_iter = current->find(key);
+        if (data_iter == current->end())
             {
-                the_map.insert(std::pair<int, Data>(key, data)); // insert SILENTLY fails if the item already exists in the map!
+                return std::shared_ptr<const Data>();
             }
-        lock.unlock();
+        return data_iter->second;
+    }
+
+    //! Number of writes so far. Readers can skip work if it has not changed
+    unsigned long version() const
+    {
+        return the_version.load(std::memory_order_acquire);
     }
 
-    std::map<int,Data> get_map_copy()
+    std::map<int,Data> get_map_copy() const
     {
-        boost::mutex::scoped_lock lock(the_mutex);
-        std::map<int,Data> map_aux = the_map;
-        lock.unlock();
+        Snapshot current = load();
+        std::map<int,Data> map_aux;
+        for (typename Snapshot_map::const_iterator data_iter = current->begin(); data_iter != current->end(); ++data_iter)
+            {
+                map_aux.insert(std::pair<int, Data>(data_iter->first, *data_iter->second));
+            }
         return map_aux;
     }
 
-    size_t size()
+    size_t size() const
     {
-        boost::mutex::scoped_lock lock(the_mutex);
-        size_t size_ = the_map.size();
-        lock.unlock();
-        return size_;
+        return load()->size();
     }
 
-    bool read(int key, Data& p_data)
+    bool read(int key, Data& p_data) const
     {
-        boost::mutex::scoped_lock lock(the_mutex);
-        Data_iterator data_iter;
-        data_iter = the_map.find(key);
-        if (data_iter != the_map.end())
+        std::shared_ptr<const Data> value = find(key);
+        if (value)
             {
-                p_data = data_iter->second;
-                lock.unlock();
+                p_data = *value;
                 return true;
             }
         else
             {
-                lock.unlock();
                 return false;
             }
     }
+
+private:
+    Snapshot load() const
+    {
+        while (the_pointer_lock.test_and_set(std::memory_order_acquire))
+            {
+            }
+        Snapshot current = the_snapshot;
+        the_pointer_lock.clear(std::memory_order_release);
+        return current;
+    }
+
+    void publish(Snapshot next)
+    {
+        while (the_pointer_lock.test_and_set(std::memory_order_acquire))
+            {
+            }
+        the_snapshot.swap(next);
+        the_version.fetch_add(1, std::memory_order_release);
+        the_pointer_lock.clear(std::memory_order_release);
+        // The previous snapshot is freed here, or by its last reader
+    }
+
+    Snapshot the_snapshot;
+    mutable std::atomic_flag the_pointer_lock; // only guards copies of the_snapshot
+    std::atomic<unsigned long> the_version;
+    boost::mutex the_writers_mutex;
 };
 
 #endif
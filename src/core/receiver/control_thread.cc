@@ -34,11 +34,18 @@
 
 #include "control_thread.h"
 #include <unistd.h>
+#include <cmath>
+#include <ctime>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <string>
+#include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/xml_oarchive.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/chrono.hpp>
+#include <boost/serialization/map.hpp>
 #include <gnuradio/message.h>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
@@ -50,17 +57,78 @@
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
 #include "galileo_almanac.h"
+#include "gps_ref_location.h"
+#include "gps_ref_time.h"
 #include "concurrent_queue.h"
 #include "concurrent_map.h"
 #include "gnss_flowgraph.h"
+#include "gnss_fft.h"
 #include "file_configuration.h"
 #include "control_message_factory.h"
 
+#define GNSS_SDR_CHANNEL_EVENT_QUEUE_SIZE 1024
+#define GNSS_SDR_CONTROL_WAIT_MS 100 // Longest delay of the messages that are not channel events
+
 extern concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
 extern concurrent_queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
+extern concurrent_map<Gps_Ephemeris> global_gps_ephemeris_map;
+extern concurrent_map<Gps_Almanac> global_gps_almanac_map;
+extern concurrent_map<Galileo_Ephemeris> global_galileo_ephemeris_map;
+extern concurrent_map<Gps_Ref_Location> global_gps_ref_location_map;
+extern concurrent_map<Gps_Ref_Time> global_gps_ref_time_map;
 
 using google::LogMessage;
 
+namespace
+{
+// Cached navigation data older than this is not used for the local assistance
+const double MAX_ASSISTANCE_CACHE_AGE_S = 3.0 * 24.0 * 3600.0;
+
+template<class T>
+bool load_assistance_map(const std::string& file_name, const char* tag, std::map<int, T>& data_map)
+{
+    try
+    {
+            if (!boost::filesystem::exists(file_name) ||
+                    std::difftime(std::time(0), boost::filesystem::last_write_time(file_name)) > MAX_ASSISTANCE_CACHE_AGE_S)
+                {
+                    return false;
+                }
+            std::ifstream ifs(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
+            boost::archive::xml_iarchive xml(ifs);
+            data_map.clear();
+            xml >> boost::serialization::make_nvp(tag, data_map);
+    }
+    catch (std::exception& e)
+    {
+            LOG(WARNING) << "Unable to read " << file_name << ": " << e.what();
+            return false;
+    }
+    return true;
+}
+
+template<class T>
+bool save_assistance_map(const std::string& file_name, const char* tag, const std::map<int, T>& data_map)
+{
+    if (data_map.empty())
+        {
+            return false;
+        }
+    try
+    {
+            std::ofstream ofs(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
+            boost::archive::xml_oarchive xml(ofs);
+            xml << boost::serialization::make_nvp(tag, data_map);
+    }
+    catch (std::exception& e)
+    {
+            LOG(WARNING) << "Unable to write " << file_name << ": " << e.what();
+            return false;
+    }
+    return true;
+}
+}
+
 DEFINE_string(config_file, std::string(GNSSSDR_INSTALL_DIR "/share/gnss-sdr/conf/default.conf"),
         "File containing the configuration parameters");
 
@@ -85,6 +153,11 @@ ControlThread::~ControlThread()
 {
     // save navigation data to files
    // if (save_assistance_to_XML() == true) {}
+
+    // Free the shared FFT plans with the blocks that used them, instead of
+    // leaving them to the destruction of the static plan registry
+    flowgraph_.reset();
+    Gnss_Fft_Registry::instance().release_plans();
 }
 
 
@@ -99,6 +172,10 @@ ControlThread::~ControlThread()
  */
 void ControlThread::run()
 {
+    // The navigation data cached by the last run are needed before the
+    // channels get their first satellites
+    read_local_assistance();
+
     // Connect the flowgraph
     flowgraph_->connect();
     if (flowgraph_->connected())
@@ -110,6 +187,12 @@ void ControlThread::run()
             LOG(ERROR) << "Unable to connect flowgraph";
             return;
         }
+    // All the blocks have read their properties by now: the others are probably misspelled
+    std::shared_ptr<FileConfiguration> file_configuration = std::dynamic_pointer_cast<FileConfiguration>(configuration_);
+    if (file_configuration)
+        {
+            file_configuration->report_unused_properties();
+        }
     // Start the flowgraph
     flowgraph_->start();
     if (flowgraph_->running())
@@ -130,9 +213,17 @@ void ControlThread::run()
     // Main loop to read and process the control messages
     while (flowgraph_->running() && !stop_)
         {
-            //TODO re-enable the blocking read messages functions and fork the process
-            read_control_messages();
-            if (control_messages_ != 0) process_control_messages();
+            // Channel events arrive through the lock-free queue. The other messages (stop,
+            // overruns) are rare and still come through the message queue, which is polled
+            if (channel_events_->wait(GNSS_SDR_CONTROL_WAIT_MS))
+                {
+                    process_channel_events();
+                }
+            while (!stop_ && control_queue_->count() > 0)
+                {
+                    read_control_messages();
+                    if (control_messages_ != 0) process_control_messages();
+                }
         }
     std::cout << "Stopping GNSS-SDR, please wait!" << std::endl;
     flowgraph_->stop();
@@ -147,6 +238,8 @@ void ControlThread::run()
 #endif
 
     LOG(INFO) << "Flowgraph stopped";
+
+    save_local_assistance();
 }
 
 
@@ -184,6 +277,7 @@ bool ControlThread::read_assistance_from_XML()
                     gps_eph_iter++)
                 {
                     std::cout << "SUPL: Read XML Ephemeris for GPS SV " << gps_eph_iter->first << std::endl;
+                    global_gps_ephemeris_map.write(gps_eph_iter->first, gps_eph_iter->second);
                     std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(gps_eph_iter->second);
                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
                 }
@@ -228,6 +322,7 @@ bool ControlThread::read_assistance_from_XML()
                     LOG(INFO) << "SUPL: Read XML Ref Time";
                     std::shared_ptr<Gps_Ref_Time> tmp_obj = std::make_shared<Gps_Ref_Time>(supl_client_acquisition_.gps_time);
                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    global_gps_ref_time_map.write(0, supl_client_acquisition_.gps_time);
                 }
             else
                 {
@@ -240,6 +335,7 @@ bool ControlThread::read_assistance_from_XML()
                     LOG(INFO) << "SUPL: Read XML Ref Location";
                     std::shared_ptr<Gps_Ref_Location> tmp_obj = std::make_shared<Gps_Ref_Location>(supl_client_acquisition_.gps_ref_loc);
                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    global_gps_ref_location_map.write(0, supl_client_acquisition_.gps_ref_loc);
                 }
             else
                 {
@@ -250,6 +346,59 @@ bool ControlThread::read_assistance_from_XML()
     return ret;
 }
 
+void ControlThread::read_local_assistance()
+{
+    if (!configuration_->property("GNSS-SDR.local_assistance", false))
+        {
+            return;
+        }
+    std::string prefix = configuration_->property("GNSS-SDR.local_assistance_cache", local_assistance_default_cache);
+    std::map<int, Gps_Ephemeris> gps_ephemeris_map;
+    if (load_assistance_map(prefix + "_gps_ephemeris.xml", "GNSS-SDR_ephemeris_map", gps_ephemeris_map))
+        {
+            for (std::map<int, Gps_Ephemeris>::iterator it = gps_ephemeris_map.begin(); it != gps_ephemeris_map.end(); ++it)
+                {
+                    global_gps_ephemeris_map.write(it->first, it->second);
+                }
+        }
+    std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;
+    if (load_assistance_map(prefix + "_galileo_ephemeris.xml", "GNSS-SDR_galileo_ephemeris_map", galileo_ephemeris_map))
+        {
+            for (std::map<int, Galileo_Ephemeris>::iterator it = galileo_ephemeris_map.begin(); it != galileo_ephemeris_map.end(); ++it)
+                {
+                    global_galileo_ephemeris_map.write(it->first, it->second);
+                }
+        }
+    std::map<int, Gps_Ref_Location> ref_location_map;
+    if (load_assistance_map(prefix + "_ref_location.xml", "GNSS-SDR_ref_location_map", ref_location_map) && ref_location_map.count(0))
+        {
+            global_gps_ref_location_map.write(0, ref_location_map[0]);
+        }
+    std::map<int, Gps_Ref_Time> ref_time_map;
+    if (load_assistance_map(prefix + "_ref_time.xml", "GNSS-SDR_ref_time_map", ref_time_map) && ref_time_map.count(0))
+        {
+            global_gps_ref_time_map.write(0, ref_time_map[0]);
+        }
+    LOG(INFO) << "Local assistance cache: " << gps_ephemeris_map.size() << " GPS and "
+              << galileo_ephemeris_map.size() << " Galileo ephemerides, "
+              << (ref_location_map.count(0) ? "last fix" : "no fix");
+}
+
+
+void ControlThread::save_local_assistance()
+{
+    if (!configuration_->property("GNSS-SDR.local_assistance", false))
+        {
+            return;
+        }
+    std::string prefix = configuration_->property("GNSS-SDR.local_assistance_cache", local_assistance_default_cache);
+    save_assistance_map(prefix + "_gps_ephemeris.xml", "GNSS-SDR_ephemeris_map", global_gps_ephemeris_map.get_map_copy());
+    save_assistance_map(prefix + "_galileo_ephemeris.xml", "GNSS-SDR_galileo_ephemeris_map", global_galileo_ephemeris_map.get_map_copy());
+    save_assistance_map(prefix + "_ref_location.xml", "GNSS-SDR_ref_location_map", global_gps_ref_location_map.get_map_copy());
+    save_assistance_map(prefix + "_ref_time.xml", "GNSS-SDR_ref_time_map", global_gps_ref_time_map.get_map_copy());
+}
+
+
 void ControlThread::assist_GNSS()
 {
     //######### GNSS Assistance #################################
@@ -312,6 +461,7 @@ void ControlThread::assist_GNSS()
                                     gps_eph_iter++)
                                 {
                                     std::cout << "SUPL: Received Ephemeris for GPS SV " << gps_eph_iter->first << std::endl;
+                                    global_gps_ephemeris_map.write(gps_eph_iter->first, gps_eph_iter->second);
                                     std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(gps_eph_iter->second);
                                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
                                 }
@@ -349,6 +499,7 @@ void ControlThread::assist_GNSS()
                                     gps_alm_iter++)
                                 {
                                     std::cout << "SUPL: Received Almanac for GPS SV " << gps_alm_iter->first << std::endl;
+                                    global_gps_almanac_map.write(gps_alm_iter->first, gps_alm_iter->second);
                                     std::shared_ptr<Gps_Almanac> tmp_obj = std::make_shared<Gps_Almanac>(gps_alm_iter->second);
                                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
                                 }
@@ -391,12 +542,17 @@ void ControlThread::assist_GNSS()
                                     std::cout << "SUPL: Received Ref Location (Acquisition Assistance)" << std::endl;
                                     std::shared_ptr<Gps_Ref_Location> tmp_obj = std::make_shared<Gps_Ref_Location>(supl_client_acquisition_.gps_ref_loc);
                                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                                    // SUPL gives the uncertainty as a code K, r = 10 (1.1^K - 1) m
+                                    Gps_Ref_Location ref_location = supl_client_acquisition_.gps_ref_loc;
+                                    ref_location.uncertainty = 10.0 * (std::pow(1.1, ref_location.uncertainty) - 1.0);
+                                    global_gps_ref_location_map.write(0, ref_location);
                                 }
                             if (supl_client_acquisition_.gps_time.valid == true)
                                 {
                                     std::cout << "SUPL: Received Ref Time (Acquisition Assistance)" << std::endl;
                                     std::shared_ptr<Gps_Ref_Time> tmp_obj = std::make_shared<Gps_Ref_Time>(supl_client_acquisition_.gps_time);
                                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                                    global_gps_ref_time_map.write(0, supl_client_acquisition_.gps_time);
                                 }
                         }
                     else
@@ -416,9 +572,13 @@ void ControlThread::init()
     control_queue_ = gr::msg_queue::make(0);
     flowgraph_ = std::make_shared<GNSSFlowgraph>(configuration_, control_queue_);
     control_message_factory_ = std::make_shared<ControlMessageFactory>();
+    channel_events_ = std::make_shared<Channel_Event_Queue>(GNSS_SDR_CHANNEL_EVENT_QUEUE_SIZE);
+    channel_event_batch_.resize(GNSS_SDR_CHANNEL_EVENT_QUEUE_SIZE);
+    flowgraph_->set_channel_event_queue(channel_events_);
     stop_ = false;
     processed_control_messages_ = 0;
     applied_actions_ = 0;
+    signal_source_overruns_ = 0;
     supl_mcc = 0;
     supl_mns = 0;
     supl_lac = 0;
@@ -463,6 +623,21 @@ void ControlThread::process_control_messages()
 }
 
 
+void ControlThread::process_channel_events()
+{
+    unsigned int count;
+    while (!stop_ && (count = channel_events_->pop(&channel_event_batch_[0], channel_event_batch_.size())) > 0)
+        {
+            DLOG(INFO) << "Processing " << count << " channel events";
+            for (unsigned int i = 0; i < count; i++)
+                {
+                    flowgraph_->apply_action(channel_event_batch_[i].channel, channel_event_batch_[i].event);
+                    processed_control_messages_++;
+                }
+        }
+}
+
+
 void ControlThread::apply_action(unsigned int what)
 {
     switch (what)
@@ -472,6 +647,10 @@ void ControlThread::apply_action(unsigned int what)
         stop_ = true;
         applied_actions_++;
         break;
+    case 1:
+        signal_source_overruns_++;
+        LOG(WARNING) << "Signal source overrun, samples are being lost (" << signal_source_overruns_ << " overruns so far)";
+        break;
     default:
         DLOG(INFO) << "Unrecognized action.";
         break;
@@ -526,6 +705,7 @@ void ControlThread::keyboard_listener()
                         {
                             control_queue_->handle(cmf->GetQueueMessage(200, 0));
                         }
+                    channel_events_->wake_up();
                     read_keys = false;
                 }
             usleep(500000);
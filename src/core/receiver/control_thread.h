@@ -39,6 +39,7 @@
 #include <vector>
 #include <boost/thread.hpp>
 #include <gnuradio/msg_queue.h>
+#include "channel_event_queue.h"
 #include "control_message_factory.h"
 #include "gnss_sdr_supl_client.h"
 
@@ -102,6 +103,12 @@ public:
         return applied_actions_;
     }
 
+    //! Number of overruns reported by the signal sources
+    unsigned int signal_source_overruns()
+    {
+        return signal_source_overruns_;
+    }
+
     /*!
      * \brief Instantiates a flowgraph
      *
@@ -129,10 +136,17 @@ private:
     // Save {ephemeris, iono, utc, ref loc, ref time} assistance to a local XML file
     //bool save_assistance_to_XML();
 
+    // Read and write the ephemerides and the last fix kept for the local acquisition assistance
+    void read_local_assistance();
+    void save_local_assistance();
+
     void read_control_messages();
 
     void process_control_messages();
 
+    // Applies the events posted by the channels, in batches
+    void process_channel_events();
+
     /*
      * Blocking function that reads the GPS assistance queue
      */
@@ -150,10 +164,13 @@ private:
     boost::shared_ptr<gr::msg_queue> control_queue_;
     std::shared_ptr<ControlMessageFactory> control_message_factory_;
     std::shared_ptr<std::vector<std::shared_ptr<ControlMessage>>> control_messages_;
+    std::shared_ptr<Channel_Event_Queue> channel_events_;
+    std::vector<Channel_Event> channel_event_batch_;
     bool stop_;
     bool delete_configuration_;
     unsigned int processed_control_messages_;
     unsigned int applied_actions_;
+    unsigned int signal_source_overruns_;
     boost::thread keyboard_thread_;
     boost::thread gps_acq_assist_data_collector_thread_;
     
@@ -165,6 +182,7 @@ private:
     const std::string iono_default_xml_filename = "./gps_iono.xml";
     const std::string ref_time_default_xml_filename = "./gps_ref_time.xml";
     const std::string ref_location_default_xml_filename = "./gps_ref_location.xml";
+    const std::string local_assistance_default_cache = "./gnss_sdr_assistance";
 };
 
 #endif /*GNSS_SDR_CONTROL_THREAD_H_*/
@@ -34,11 +34,10 @@
  */
 
 #include "file_configuration.h"
+#include <map>
 #include <string>
 #include <glog/logging.h>
 #include "INIReader.h"
-#include "string_converter.h"
-#include "in_memory_configuration.h"
 
 using google::LogMessage;
 
@@ -64,133 +63,92 @@ FileConfiguration::~FileConfiguration()
 
 std::string FileConfiguration::property(std::string property_name, std::string default_value)
 {
-    if(overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    else
-        {
-            return ini_reader_->Get("GNSS-SDR", property_name, default_value);
-        }
+    return properties_.get(property_name, default_value);
 }
 
 
 bool FileConfiguration::property(std::string property_name, bool default_value)
 {
-    if(overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    else
-        {
-            std::string empty = "";
-            return converter_->convert(property(property_name, empty), default_value);
-        }
+    return properties_.get(property_name, default_value);
 }
 
 
 long FileConfiguration::property(std::string property_name, long default_value)
 {
-    if(overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    else
-        {
-            std::string empty = "";
-            return converter_->convert(property(property_name, empty), default_value);
-        }
+    return properties_.get(property_name, default_value);
 }
 
 
-
 int FileConfiguration::property(std::string property_name, int default_value)
 {
-    if(overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    else
-        {
-            std::string empty = "";
-            return converter_->convert(property(property_name, empty), default_value);
-        }
+    return properties_.get(property_name, default_value);
 }
 
 
-
 unsigned int FileConfiguration::property(std::string property_name, unsigned int default_value)
 {
-    if(overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    else
-        {
-            std::string empty = "";
-            return converter_->convert(property(property_name, empty), default_value);
-        }
+    return properties_.get(property_name, default_value);
 }
 
 
-
 unsigned short FileConfiguration::property(std::string property_name, unsigned short default_value)
 {
-    if(overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    else
-        {
-            std::string empty = "";
-            return converter_->convert(property(property_name, empty), default_value);
-        }
+    return properties_.get(property_name, default_value);
 }
 
 
-
 float FileConfiguration::property(std::string property_name, float default_value)
 {
-    if(overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    else
-        {
-            std::string empty = "";
-            return converter_->convert(property(property_name, empty), default_value);
-        }
+    return properties_.get(property_name, default_value);
 }
 
 
 double FileConfiguration::property(std::string property_name, double default_value)
 {
-    if(overrided_->is_present(property_name))
-        {
-            return overrided_->property(property_name, default_value);
-        }
-    else
-        {
-            std::string empty = "";
-            return converter_->convert(property(property_name, empty), default_value);
-        }
+    return properties_.get(property_name, default_value);
 }
 
 
-
 void FileConfiguration::set_property(std::string property_name, std::string value)
 {
-    overrided_->set_property(property_name, value);
+    // The first value set by the program overrides the file, and is kept
+    properties_.set(property_name, value, true);
 }
 
 
+std::vector<std::string> FileConfiguration::unused_properties() const
+{
+    return properties_.unused();
+}
+
+
+void FileConfiguration::report_unused_properties() const
+{
+    std::vector<std::string> unused = properties_.unused();
+    for (unsigned int i = 0; i < unused.size(); i++)
+        {
+            LOG(WARNING) << "Configuration property " << unused.at(i) << " is not used by any block";
+        }
+}
+
 
 void FileConfiguration::init()
 {
-    std::unique_ptr<StringConverter> converter_(new StringConverter);
-    overrided_ = std::make_shared<InMemoryConfiguration>();
-    ini_reader_ = std::make_shared<INIReader>(filename_);
-    error_ = ini_reader_->ParseError();
+    INIReader ini_reader(filename_);
+    error_ = ini_reader.ParseError();
+    const std::string section = "gnss-sdr.";
+    const std::map<std::string, std::string>& values = ini_reader.GetValues();
+    for (std::map<std::string, std::string>::const_iterator it = values.begin(); it != values.end(); ++it)
+        {
+            if (it->first.compare(0, section.size(), section) == 0)
+                {
+                    properties_.set(it->first.substr(section.size()), it->second);
+                }
+            else
+                {
+                    LOG(WARNING) << "Configuration property " << it->first << " ignored: only the [GNSS-SDR] section is read";
+                }
+        }
     if(error_ == 0)
         {
             DLOG(INFO) << "Configuration file " << filename_ << " opened with no errors";
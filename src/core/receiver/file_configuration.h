@@ -40,10 +40,8 @@
 #include "configuration_interface.h"
 #include <memory>
 #include <string>
-
-class INIReader;
-class StringConverter;
-class InMemoryConfiguration;
+#include <vector>
+#include "property_table.h"
 
 /*!
  * \brief This class is an implementation of the interface ConfigurationInterface
@@ -53,6 +51,9 @@ class InMemoryConfiguration;
  * for the values of the parameters.
  * The file is in the INI format, containing sections and pairs of names and values.
  * For more information about the INI format, see http://en.wikipedia.org/wiki/INI_file
+ *
+ * The file is parsed once into a Property_Table, which also holds the
+ * properties set by the program, so each lookup is a single hash table search.
  */
 class FileConfiguration : public ConfigurationInterface
 {
@@ -70,12 +71,14 @@ public:
     float property(std::string property_name, float default_value);
     double property(std::string property_name, double default_value);
     void set_property(std::string property_name, std::string value);
+
+    //! Properties of the file that no block has read so far, usually misspelled names
+    std::vector<std::string> unused_properties() const;
+    void report_unused_properties() const;
 private:
     void init();
     std::string filename_;
-    std::shared_ptr<INIReader> ini_reader_;
-    std::shared_ptr<InMemoryConfiguration> overrided_;
-    std::unique_ptr<StringConverter> converter_;
+    Property_Table properties_;
     int error_;
 };
 
@@ -0,0 +1,360 @@
+/*!
+ * \file gnss_assistance_engine.cc
+ * \brief Predicts satellite visibility and Doppler from the navigation data
+ * already known by the receiver, to assist acquisition.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_assistance_engine.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "GPS_L1_CA.h"
+#include "GPS_L2C.h"
+#include "Galileo_E1.h"
+#include "Galileo_E5a.h"
+
+namespace
+{
+const double WEEK_S = 604800.0;
+const double MAX_EPHEMERIS_AGE_S = 4.0 * 3600.0;      // Curve fit interval of the broadcast ephemeris
+const double ALMANAC_DOPPLER_UNCERTAINTY_HZ = 150.0;  // Includes ephemerides older than the fit interval
+const double GPS_UNIX_EPOCH_OFFSET_S = 315964800.0;   // 1980-01-06T00:00:00Z as Unix time
+const double GPS_UTC_LEAP_SECONDS = 18.0;             // Since 2017-01-01
+const double WGS84_A = 6378137.0;
+const double WGS84_E2 = 6.69437999014e-3;
+
+// Wraps a time difference to [-half week, half week)
+double wrap_half_week(double dt)
+{
+    dt = std::fmod(dt, WEEK_S);
+    if (dt >= WEEK_S / 2.0) dt -= WEEK_S;
+    if (dt < -WEEK_S / 2.0) dt += WEEK_S;
+    return dt;
+}
+
+double carrier_frequency(const std::string& signal)
+{
+    if (signal.compare("2S") == 0) return GPS_L2_FREQ_HZ;
+    if (signal.compare("1B") == 0) return Galileo_E1_FREQ_HZ;
+    if (signal.compare("5X") == 0) return Galileo_E5a_FREQ_HZ;
+    return GPS_L1_FREQ_HZ;
+}
+}
+
+
+Gnss_Assistance_Engine::Gnss_Assistance_Engine()
+{
+    d_elevation_mask_deg = 5.0;
+    d_doppler_margin_hz = 1000.0;
+    d_location_uncertainty_m = 0.0;
+    d_latitude_rad = 0.0;
+    d_longitude_rad = 0.0;
+    d_receiver_position[0] = 0.0;
+    d_receiver_position[1] = 0.0;
+    d_receiver_position[2] = 0.0;
+    d_has_location = false;
+}
+
+
+void Gnss_Assistance_Engine::set_elevation_mask(double elevation_mask_deg)
+{
+    d_elevation_mask_deg = elevation_mask_deg;
+}
+
+
+void Gnss_Assistance_Engine::set_doppler_margin(double doppler_margin_hz)
+{
+    d_doppler_margin_hz = doppler_margin_hz;
+}
+
+
+void Gnss_Assistance_Engine::set_reference_location(double latitude_deg, double longitude_deg, double height_m, double uncertainty_m)
+{
+    d_latitude_rad = latitude_deg * GPS_PI / 180.0;
+    d_longitude_rad = longitude_deg * GPS_PI / 180.0;
+    double sin_lat = std::sin(d_latitude_rad);
+    double N = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat);
+    d_receiver_position[0] = (N + height_m) * std::cos(d_latitude_rad) * std::cos(d_longitude_rad);
+    d_receiver_position[1] = (N + height_m) * std::cos(d_latitude_rad) * std::sin(d_longitude_rad);
+    d_receiver_position[2] = (N * (1.0 - WGS84_E2) + height_m) * sin_lat;
+    d_location_uncertainty_m = uncertainty_m;
+    d_has_location = true;
+}
+
+
+void Gnss_Assistance_Engine::set_gps_ephemeris(const std::map<int, Gps_Ephemeris>& gps_ephemeris_map)
+{
+    d_gps_ephemeris = gps_ephemeris_map;
+}
+
+
+void Gnss_Assistance_Engine::set_gps_almanac(const std::map<int, Gps_Almanac>& gps_almanac_map)
+{
+    d_gps_almanac = gps_almanac_map;
+}
+
+
+void Gnss_Assistance_Engine::set_galileo_ephemeris(const std::map<int, Galileo_Ephemeris>& galileo_ephemeris_map)
+{
+    d_galileo_ephemeris = galileo_ephemeris_map;
+}
+
+
+bool Gnss_Assistance_Engine::ready() const
+{
+    return d_has_location && (!d_gps_ephemeris.empty() || !d_gps_almanac.empty() || !d_galileo_ephemeris.empty());
+}
+
+
+double Gnss_Assistance_Engine::time_of_week(std::time_t now, const Gps_Ref_Time& ref_time)
+{
+    double tow;
+    if (ref_time.valid)
+        {
+            tow = ref_time.d_TOW + (static_cast<double>(now) - ref_time.d_tv_sec);
+        }
+    else
+        {
+            tow = static_cast<double>(now) - GPS_UNIX_EPOCH_OFFSET_S + GPS_UTC_LEAP_SECONDS;
+        }
+    tow = std::fmod(tow, WEEK_S);
+    if (tow < 0.0) tow += WEEK_S;
+    return tow;
+}
+
+
+bool Gnss_Assistance_Engine::ephemeris_position(const Gnss_Satellite& satellite, double tow, double* position) const
+{
+    // Only called when satellite_state() found the ephemeris. The copies keep
+    // satellitePosition(), which stores its results in the object, off the maps.
+    if (satellite.get_system().compare("Galileo") == 0)
+        {
+            Galileo_Ephemeris eph = d_galileo_ephemeris.find(satellite.get_PRN())->second;
+            eph.satellitePosition(eph.t0e_1 + wrap_half_week(tow - eph.t0e_1));
+            position[0] = eph.d_satpos_X;
+            position[1] = eph.d_satpos_Y;
+            position[2] = eph.d_satpos_Z;
+        }
+    else
+        {
+            Gps_Ephemeris eph = d_gps_ephemeris.find(satellite.get_PRN())->second;
+            eph.satellitePosition(eph.d_Toe + wrap_half_week(tow - eph.d_Toe));
+            position[0] = eph.d_satpos_X;
+            position[1] = eph.d_satpos_Y;
+            position[2] = eph.d_satpos_Z;
+        }
+    return true;
+}
+
+
+bool Gnss_Assistance_Engine::almanac_position(const Gps_Almanac& almanac, double tow, double* position) const
+{
+    // Almanac angles are in semi-circles (IS-GPS-200, 20.3.3.5.1.2)
+    double a = almanac.d_sqrt_A * almanac.d_sqrt_A;
+    double tk = wrap_half_week(tow - almanac.d_Toa);
+    double n = std::sqrt(GM / (a * a * a));
+    double M = almanac.d_M_0 * GPS_PI + n * tk;
+    double E = M;
+    for (int ii = 0; ii < 20; ii++)
+        {
+            double E_old = E;
+            E = M + almanac.d_e_eccentricity * std::sin(E);
+            if (std::fabs(E - E_old) < 1e-12) break;
+        }
+    double nu = std::atan2(std::sqrt(1.0 - almanac.d_e_eccentricity * almanac.d_e_eccentricity) * std::sin(E),
+            std::cos(E) - almanac.d_e_eccentricity);
+    double u = nu + almanac.d_OMEGA * GPS_PI;
+    double r = a * (1.0 - almanac.d_e_eccentricity * std::cos(E));
+    double i = (0.3 + almanac.d_Delta_i) * GPS_PI;
+    double Omega = almanac.d_OMEGA0 * GPS_PI + (almanac.d_OMEGA_DOT * GPS_PI - OMEGA_EARTH_DOT) * tk - OMEGA_EARTH_DOT * almanac.d_Toa;
+    position[0] = r * (std::cos(u) * std::cos(Omega) - std::sin(u) * std::cos(i) * std::sin(Omega));
+    position[1] = r * (std::cos(u) * std::sin(Omega) + std::sin(u) * std::cos(i) * std::cos(Omega));
+    position[2] = r * std::sin(u) * std::sin(i);
+    return true;
+}
+
+
+bool Gnss_Assistance_Engine::satellite_state(const Gnss_Satellite& satellite, double tow,
+        double* position, double* velocity, bool& from_almanac) const
+{
+    unsigned int prn = satellite.get_PRN();
+    bool have_ephemeris = false;
+    double ephemeris_age = 0.0;
+    if (satellite.get_system().compare("GPS") == 0)
+        {
+            std::map<int, Gps_Ephemeris>::const_iterator it = d_gps_ephemeris.find(prn);
+            if (it != d_gps_ephemeris.end() && it->second.d_sqrt_A > 0.0)
+                {
+                    have_ephemeris = true;
+                    ephemeris_age = std::fabs(wrap_half_week(tow - it->second.d_Toe));
+                }
+        }
+    else if (satellite.get_system().compare("Galileo") == 0)
+        {
+            std::map<int, Galileo_Ephemeris>::const_iterator it = d_galileo_ephemeris.find(prn);
+            if (it != d_galileo_ephemeris.end() && it->second.A_1 > 0.0)
+                {
+                    have_ephemeris = true;
+                    ephemeris_age = std::fabs(wrap_half_week(tow - it->second.t0e_1));
+                }
+        }
+    else
+        {
+            // No SBAS orbits are kept, SBAS signals keep their place in the queue
+            return false;
+        }
+
+    const Gps_Almanac* almanac = 0;
+    if (satellite.get_system().compare("GPS") == 0)
+        {
+            std::map<int, Gps_Almanac>::const_iterator it = d_gps_almanac.find(prn);
+            if (it != d_gps_almanac.end() && it->second.d_sqrt_A > 0.0 && it->second.i_SV_health == 0)
+                {
+                    almanac = &it->second;
+                }
+        }
+
+    // Velocity from the position half a second before and after, which is
+    // accurate to a few mm/s and does not depend on the orbit model
+    double before[3];
+    double after[3];
+    if (have_ephemeris && (ephemeris_age < MAX_EPHEMERIS_AGE_S || almanac == 0))
+        {
+            ephemeris_position(satellite, tow, position);
+            ephemeris_position(satellite, tow - 0.5, before);
+            ephemeris_position(satellite, tow + 0.5, after);
+            from_almanac = ephemeris_age >= MAX_EPHEMERIS_AGE_S;
+        }
+    else if (almanac != 0)
+        {
+            almanac_position(*almanac, tow, position);
+            almanac_position(*almanac, tow - 0.5, before);
+            almanac_position(*almanac, tow + 0.5, after);
+            from_almanac = true;
+        }
+    else
+        {
+            return false;
+        }
+    for (int k = 0; k < 3; k++)
+        {
+            velocity[k] = after[k] - before[k];
+        }
+    return true;
+}
+
+
+bool Gnss_Assistance_Engine::predict(const Gnss_Signal& signal, double tow, Gnss_Assistance_Prediction& prediction) const
+{
+    if (!d_has_location)
+        {
+            return false;
+        }
+    double position[3];
+    double velocity[3];
+    bool from_almanac = false;
+    if (!satellite_state(signal.get_satellite(), tow, position, velocity, from_almanac))
+        {
+            return false;
+        }
+
+    double los[3];
+    double range = 0.0;
+    for (int k = 0; k < 3; k++)
+        {
+            los[k] = position[k] - d_receiver_position[k];
+            range += los[k] * los[k];
+        }
+    range = std::sqrt(range);
+    for (int k = 0; k < 3; k++)
+        {
+            los[k] /= range;
+        }
+
+    // Line of sight in local East-North-Up coordinates
+    double sin_lat = std::sin(d_latitude_rad);
+    double cos_lat = std::cos(d_latitude_rad);
+    double sin_lon = std::sin(d_longitude_rad);
+    double cos_lon = std::cos(d_longitude_rad);
+    double east = -sin_lon * los[0] + cos_lon * los[1];
+    double north = -sin_lat * cos_lon * los[0] - sin_lat * sin_lon * los[1] + cos_lat * los[2];
+    double up = cos_lat * cos_lon * los[0] + cos_lat * sin_lon * los[1] + sin_lat * los[2];
+    prediction.elevation_deg = std::asin(std::max(-1.0, std::min(1.0, up))) * 180.0 / GPS_PI;
+    prediction.azimuth_deg = std::atan2(east, north) * 180.0 / GPS_PI;
+    if (prediction.azimuth_deg < 0.0) prediction.azimuth_deg += 360.0;
+
+    // The receiver is assumed static in the Earth-fixed frame
+    double range_rate = velocity[0] * los[0] + velocity[1] * los[1] + velocity[2] * los[2];
+    double wavelength = GPS_C_m_s / carrier_frequency(signal.get_signal_str());
+    prediction.doppler_hz = -range_rate / wavelength;
+
+    // A horizontal location error changes the line of sight by error/range
+    // radians, which projects the (~4 km/s) satellite velocity on it
+    double speed = std::sqrt(velocity[0] * velocity[0] + velocity[1] * velocity[1] + velocity[2] * velocity[2]);
+    prediction.uncertainty_hz = d_doppler_margin_hz + speed * d_location_uncertainty_m / range / wavelength;
+    prediction.from_almanac = from_almanac;
+    if (from_almanac)
+        {
+            prediction.uncertainty_hz += ALMANAC_DOPPLER_UNCERTAINTY_HZ;
+        }
+    return true;
+}
+
+
+unsigned int Gnss_Assistance_Engine::sort_signals(std::list<Gnss_Signal>& signals, double tow) const
+{
+    std::vector<std::pair<double, Gnss_Signal>> visible;
+    std::list<Gnss_Signal> unknown;
+    std::list<Gnss_Signal> hidden;
+    for (std::list<Gnss_Signal>::const_iterator it = signals.begin(); it != signals.end(); ++it)
+        {
+            Gnss_Assistance_Prediction prediction;
+            if (!predict(*it, tow, prediction))
+                {
+                    unknown.push_back(*it);
+                }
+            else if (prediction.elevation_deg >= d_elevation_mask_deg)
+                {
+                    visible.push_back(std::make_pair(-prediction.elevation_deg, *it));
+                }
+            else
+                {
+                    hidden.push_back(*it);
+                }
+        }
+    std::stable_sort(visible.begin(), visible.end(),
+            [](const std::pair<double, Gnss_Signal>& a, const std::pair<double, Gnss_Signal>& b) { return a.first < b.first; });
+    signals.clear();
+    for (unsigned int n = 0; n < visible.size(); n++)
+        {
+            signals.push_back(visible[n].second);
+        }
+    signals.splice(signals.end(), unknown);
+    signals.splice(signals.end(), hidden);
+    return visible.size();
+}
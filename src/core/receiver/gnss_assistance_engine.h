@@ -0,0 +1,130 @@
+/*!
+ * \file gnss_assistance_engine.h
+ * \brief Predicts satellite visibility and Doppler from the navigation data
+ * already known by the receiver, to assist acquisition.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_ASSISTANCE_ENGINE_H_
+#define GNSS_SDR_GNSS_ASSISTANCE_ENGINE_H_
+
+#include <ctime>
+#include <list>
+#include <map>
+#include "galileo_ephemeris.h"
+#include "gnss_signal.h"
+#include "gps_almanac.h"
+#include "gps_ephemeris.h"
+#include "gps_ref_time.h"
+
+/*!
+ * \brief Predicted acquisition parameters of a signal
+ */
+struct Gnss_Assistance_Prediction
+{
+    double elevation_deg;
+    double azimuth_deg;
+    double doppler_hz;      //!< Doppler at the carrier of the signal [Hz]
+    double uncertainty_hz;  //!< Half width of the Doppler window to search [Hz]
+    bool from_almanac;      //!< True if no ephemeris was available
+};
+
+/*!
+ * \brief Local acquisition assistance.
+ *
+ * Computes the elevation and Doppler of every satellite for which there is
+ * an ephemeris (decoded, read from SUPL or cached on disk) or an almanac, as
+ * seen from a reference location (usually the last PVT fix). The flowgraph
+ * uses it to search the visible satellites first, and to narrow the Doppler
+ * window of each channel around the predicted value.
+ *
+ * The Doppler window covers the receiver oscillator error (the Doppler
+ * margin, which is usually the dominant term), the reference location
+ * uncertainty and, for almanac predictions, the orbit error.
+ */
+class Gnss_Assistance_Engine
+{
+public:
+    Gnss_Assistance_Engine();
+
+    void set_elevation_mask(double elevation_mask_deg);
+    void set_doppler_margin(double doppler_margin_hz);
+
+    /*!
+     * \brief Sets the receiver location.
+     * \param[in] uncertainty_m Horizontal uncertainty of the location [m]
+     */
+    void set_reference_location(double latitude_deg, double longitude_deg, double height_m, double uncertainty_m);
+    bool has_reference_location() const { return d_has_location; }
+
+    void set_gps_ephemeris(const std::map<int, Gps_Ephemeris>& gps_ephemeris_map);
+    void set_gps_almanac(const std::map<int, Gps_Almanac>& gps_almanac_map);
+    void set_galileo_ephemeris(const std::map<int, Galileo_Ephemeris>& galileo_ephemeris_map);
+
+    //! True if there is a reference location and orbits for some satellite
+    bool ready() const;
+
+    /*!
+     * \brief Predicts the elevation and Doppler of a signal.
+     * \param[in] tow GPS time of week [s]
+     * \return false if there are no orbits for the satellite
+     */
+    bool predict(const Gnss_Signal& signal, double tow, Gnss_Assistance_Prediction& prediction) const;
+
+    /*!
+     * \brief Reorders a search queue: visible satellites first (highest
+     * elevation first), then the ones without orbits, then the ones predicted
+     * below the elevation mask. The order within the last two groups is kept.
+     * \return Number of signals predicted above the elevation mask
+     */
+    unsigned int sort_signals(std::list<Gnss_Signal>& signals, double tow) const;
+
+    /*!
+     * \brief GPS time of week at now, from a reference time (a PVT fix or
+     * SUPL) if it is valid, or else from the system clock. Both assume that
+     * now is the time the samples are received, so this is only meaningful
+     * with a live front-end.
+     */
+    static double time_of_week(std::time_t now, const Gps_Ref_Time& ref_time);
+
+private:
+    bool satellite_state(const Gnss_Satellite& satellite, double tow, double* position, double* velocity, bool& from_almanac) const;
+    bool ephemeris_position(const Gnss_Satellite& satellite, double tow, double* position) const;
+    bool almanac_position(const Gps_Almanac& almanac, double tow, double* position) const;
+
+    std::map<int, Gps_Ephemeris> d_gps_ephemeris;
+    std::map<int, Gps_Almanac> d_gps_almanac;
+    std::map<int, Galileo_Ephemeris> d_galileo_ephemeris;
+    double d_elevation_mask_deg;
+    double d_doppler_margin_hz;
+    double d_location_uncertainty_m;
+    double d_latitude_rad;
+    double d_longitude_rad;
+    double d_receiver_position[3];
+    bool d_has_location;
+};
+
+#endif /* GNSS_SDR_GNSS_ASSISTANCE_ENGINE_H_ */
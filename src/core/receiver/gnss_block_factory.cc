@@ -50,9 +50,11 @@
 #include "rtl_tcp_signal_source.h"
 #include "two_bit_packed_file_signal_source.h"
 #include "channel.h"
+#include "parallel_for.h"
 
 #include "signal_conditioner.h"
 #include "array_signal_conditioner.h"
+#include "fused_signal_conditioner.h"
 #include "byte_to_short.h"
 #include "ibyte_to_cbyte.h"
 #include "ibyte_to_cshort.h"
@@ -60,6 +62,7 @@
 #include "ishort_to_cshort.h"
 #include "ishort_to_complex.h"
 #include "direct_resampler_conditioner.h"
+#include "pfb_resampler_conditioner.h"
 #include "fir_filter.h"
 #include "freq_xlating_fir_filter.h"
 #include "beamformer_filter.h"
@@ -77,12 +80,14 @@
 #include "galileo_e1_pcps_quicksync_ambiguous_acquisition.h"
 #include "galileo_e5a_noncoherent_iq_acquisition_caf.h"
 #include "gps_l1_ca_dll_pll_tracking.h"
+#include "gps_l1_ca_dll_pll_vector_tracking.h"
 #include "gps_l1_ca_dll_pll_c_aid_tracking.h"
 #include "gps_l1_ca_tcp_connector_tracking.h"
 #include "galileo_e1_dll_pll_veml_tracking.h"
 #include "galileo_e1_tcp_connector_tracking.h"
 #include "galileo_e5a_dll_pll_tracking.h"
 #include "gps_l2_m_dll_pll_tracking.h"
+#include "generic_dll_pll_tracking.h"
 #include "gps_l1_ca_telemetry_decoder.h"
 #include "gps_l2_m_telemetry_decoder.h"
 #include "galileo_e1b_telemetry_decoder.h"
@@ -202,6 +207,25 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetSignalConditioner(
                 role_conditioner, "Signal_Conditioner"));
             return conditioner_;
         }
+    else if(signal_conditioner.compare("Fused_Signal_Conditioner") == 0)
+        {
+            //single block version. Falls back to the regular chain if the stages cannot be fused
+            std::unique_ptr<FusedSignalConditioner> fused(new FusedSignalConditioner(configuration.get(),
+                std::move(GetBlock(configuration, role_datatypeadapter, data_type_adapter, 1, 1)),
+                std::move(GetBlock(configuration, role_inputfilter, input_filter, 1, 1)),
+                std::move(GetBlock(configuration, role_resampler, resampler, 1, 1)),
+                role_conditioner, "Fused_Signal_Conditioner"));
+            if (fused->fusable())
+                {
+                    std::unique_ptr<GNSSBlockInterface> conditioner_(std::move(fused));
+                    return conditioner_;
+                }
+            LOG(WARNING) << role_conditioner << ": stages cannot be fused, using Signal_Conditioner instead";
+            std::unique_ptr<GNSSBlockInterface> conditioner_(new SignalConditioner(configuration.get(),
+                fused->data_type_adapter(), fused->input_filter(), fused->resampler(),
+                role_conditioner, "Signal_Conditioner"));
+            return conditioner_;
+        }
     else
         {
             //single-antenna version
@@ -609,6 +633,25 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                 channel_absolute_id++;
            }
 
+    /*
+     * The GNU Radio blocks are created above, one channel after the other,
+     * since their constructors share the GNU Radio block registry. The
+     * acquisition grids and local codes, which take most of the start-up
+     * time, only depend on each channel and are computed in parallel. The
+     * channels keep their place in the vector, so they are connected in the
+     * same order whatever the number of threads.
+     */
+    unsigned int init_threads = configuration->property("GNSS-SDR.init_threads", 0);
+    parallel_for(total_channels, init_threads, [&channels](unsigned int i)
+        {
+            Channel* channel = dynamic_cast<Channel*>(channels->at(i).get());
+            if (channel != nullptr)
+                {
+                    channel->init();
+                }
+        });
+    LOG(INFO) << "Initialized " << total_channels << " channels";
+
     return channels;
 }
 
@@ -837,6 +880,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                     in_streams, out_streams));
             block = std::move(block_);
         }
+    else if (implementation.compare("Pfb_Resampler") == 0)
+        {
+            std::unique_ptr<GNSSBlockInterface> block_(new PfbResamplerConditioner(configuration.get(), role,
+                    in_streams, out_streams));
+            block = std::move(block_);
+        }
 
     // ACQUISITION BLOCKS ---------------------------------------------------------
     else if (implementation.compare("GPS_L1_CA_PCPS_Acquisition") == 0)
@@ -932,6 +981,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                     out_streams));
             block = std::move(block_);
         }
+    else if (implementation.compare("GPS_L1_CA_DLL_PLL_Vector_Tracking") == 0)
+        {
+            std::unique_ptr<GNSSBlockInterface> block_(new GpsL1CaDllPllVectorTracking(configuration.get(), role, in_streams,
+                    out_streams));
+            block = std::move(block_);
+        }
     else if (implementation.compare("GPS_L1_CA_DLL_PLL_C_Aid_Tracking") == 0)
         {
             std::unique_ptr<TrackingInterface> block_(new GpsL1CaDllPllCAidTracking(configuration.get(), role, in_streams,
@@ -976,6 +1031,15 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                     out_streams));
             block = std::move(block_);
         }
+    else if ((implementation.compare("GPS_L1_CA_DLL_PLL_Generic_Tracking") == 0) or
+            (implementation.compare("GPS_L2_M_DLL_PLL_Generic_Tracking") == 0) or
+            (implementation.compare("Galileo_E1_DLL_PLL_Generic_Tracking") == 0) or
+            (implementation.compare("Galileo_E5a_DLL_PLL_Generic_Tracking") == 0))
+        {
+            std::unique_ptr<GNSSBlockInterface> block_(new GenericDllPllTracking(configuration.get(), role, implementation, in_streams,
+                    out_streams));
+            block = std::move(block_);
+        }
 
     // TELEMETRY DECODERS ----------------------------------------------------------
     else if (implementation.compare("GPS_L1_CA_Telemetry_Decoder") == 0)
@@ -1180,6 +1244,12 @@ std::unique_ptr<TrackingInterface> GNSSBlockFactory::GetTrkBlock(
                     out_streams));
             block = std::move(block_);
         }
+    else if (implementation.compare("GPS_L1_CA_DLL_PLL_Vector_Tracking") == 0)
+        {
+            std::unique_ptr<TrackingInterface> block_(new GpsL1CaDllPllVectorTracking(configuration.get(), role, in_streams,
+                    out_streams));
+            block = std::move(block_);
+        }
     else if (implementation.compare("GPS_L1_CA_DLL_PLL_C_Aid_Tracking") == 0)
         {
             std::unique_ptr<TrackingInterface> block_(new GpsL1CaDllPllCAidTracking(configuration.get(), role, in_streams,
@@ -1216,6 +1286,15 @@ std::unique_ptr<TrackingInterface> GNSSBlockFactory::GetTrkBlock(
                     out_streams));
             block = std::move(block_);
         }
+    else if ((implementation.compare("GPS_L1_CA_DLL_PLL_Generic_Tracking") == 0) or
+            (implementation.compare("GPS_L2_M_DLL_PLL_Generic_Tracking") == 0) or
+            (implementation.compare("Galileo_E1_DLL_PLL_Generic_Tracking") == 0) or
+            (implementation.compare("Galileo_E5a_DLL_PLL_Generic_Tracking") == 0))
+        {
+            std::unique_ptr<TrackingInterface> block_(new GenericDllPllTracking(configuration.get(), role, implementation, in_streams,
+                    out_streams));
+            block = std::move(block_);
+        }
 #if CUDA_GPU_ACCEL
     else if (implementation.compare("GPS_L1_CA_DLL_PLL_Tracking_GPU") == 0)
         {
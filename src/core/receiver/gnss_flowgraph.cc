@@ -37,6 +37,7 @@
 
 #include <memory>
 #include <algorithm>
+#include <cmath>
 #include <exception>
 #include <iostream>
 #include <set>
@@ -47,11 +48,30 @@
 #include "gnss_block_interface.h"
 #include "channel_interface.h"
 #include "gnss_block_factory.h"
+#include "gnss_code_bank.h"
+#include "gnss_fft.h"
+#include "gnss_sample_ring.h"
+#include "gnss_sdr_sample_ring_sink.h"
+#include "gnss_sdr_sample_ring_source.h"
+#include "concurrent_map.h"
+#include "galileo_ephemeris.h"
+#include "gnss_synchro.h"
+#include "gps_almanac.h"
+#include "gps_ephemeris.h"
+#include "gps_ref_location.h"
 
 #define GNSS_SDR_ARRAY_SIGNAL_CONDITIONER_CHANNELS 8
+#define GNSS_SDR_SAMPLE_RING_MAX_READ_ITEMS 65536
 
 using google::LogMessage;
 
+extern concurrent_map<Gps_Ephemeris> global_gps_ephemeris_map;
+extern concurrent_map<Gps_Almanac> global_gps_almanac_map;
+extern concurrent_map<Galileo_Ephemeris> global_galileo_ephemeris_map;
+extern concurrent_map<Gps_Ref_Location> global_gps_ref_location_map;
+extern concurrent_map<Gps_Ref_Time> global_gps_ref_time_map;
+extern concurrent_map<Gnss_Synchro> global_channel_synchro_map;
+
 GNSSFlowgraph::GNSSFlowgraph(std::shared_ptr<ConfigurationInterface> configuration,
         boost::shared_ptr<gr::msg_queue> queue)
 {
@@ -259,6 +279,29 @@ void GNSSFlowgraph::connect()
         }
     DLOG(INFO) << "Signal source connected to signal conditioner";
 
+    // Signal conditioner (i) >> sample ring (i). The channels read the ring through their own sample ring sources
+    if (use_sample_ring_)
+        {
+            for (unsigned int i = 0; i < sig_conditioner_.size(); i++)
+                {
+                    try
+                    {
+                            top_block_->connect(sig_conditioner_.at(i)->get_right_block(), 0, sample_ring_sink_.at(i), 0);
+                    }
+                    catch (std::exception& e)
+                    {
+                            LOG(WARNING) << "Can't connect signal conditioner " << i << " to its sample ring";
+                            LOG(ERROR) << e.what();
+                            top_block_->disconnect_all();
+                            return;
+                    }
+                    DLOG(INFO) << "signal conditioner " << i << " connected to its sample ring";
+                }
+        }
+
+    // Search the satellites predicted to be visible first
+    update_assistance();
+
     // Signal conditioner (selected_signal_source) >> channels (i) (dependent of their associated SignalSource_ID)
     int selected_signal_conditioner_ID;
     for (unsigned int i = 0; i < channels_count_; i++)
@@ -266,8 +309,11 @@ void GNSSFlowgraph::connect()
             selected_signal_conditioner_ID = configuration_->property("Channel" + boost::lexical_cast<std::string>(i) + ".RF_channel_ID", 0);
             try
             {
-                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                            channels_.at(i)->get_left_block(), 0);
+                    if (!use_sample_ring_)
+                        {
+                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                    channels_.at(i)->get_left_block(), 0);
+                        }
             }
             catch (std::exception& e)
             {
@@ -293,19 +339,11 @@ void GNSSFlowgraph::connect()
                     return;
             }
 
-            std::string gnss_signal = channels_.at(i)->get_signal().get_signal_str(); // use channel's implicit signal!
-            while (gnss_signal.compare(available_GNSS_signals_.front().get_signal_str()) != 0 )
-                {
-                    available_GNSS_signals_.push_back(available_GNSS_signals_.front());
-                    available_GNSS_signals_.pop_front();
-                }
-            channels_.at(i)->set_signal(available_GNSS_signals_.front());
-
             if (channels_state_[i] == 1)
                 {
+                    assign_signal(i); // the band is given by the channel's implicit signal
                     channels_.at(i)->start_acquisition();
-                    available_GNSS_signals_.pop_front();
-                    LOG(INFO) << "Channel " << i << " assigned to " << available_GNSS_signals_.front();
+                    LOG(INFO) << "Channel " << i << " assigned to " << channels_.at(i)->get_signal();
                     LOG(INFO) << "Channel " << i << " connected to observables and ready for acquisition";
                 }
             else
@@ -323,6 +361,13 @@ void GNSSFlowgraph::connect()
                 {
                     top_block_->connect(observables_->get_right_block(), i, pvt_->get_left_block(), i);
                     top_block_->msg_connect(channels_.at(i)->get_right_block(), pmt::mp("telemetry"), pvt_->get_left_block(), pmt::mp("telemetry"));
+                    // Vector tracking: PVT solution feedback to the tracking loops that accept it
+                    if (pvt_->get_left_block()->has_msg_port(pmt::mp("vector_aid"))
+                            && channels_.at(i)->get_tracking_block()->has_msg_port(pmt::mp("vector_aid")))
+                        {
+                            top_block_->msg_connect(pvt_->get_left_block(), pmt::mp("vector_aid"), channels_.at(i)->get_tracking_block(), pmt::mp("vector_aid"));
+                            LOG(INFO) << "Channel " << i << " tracking aided by the PVT solution";
+                        }
                 }
     }
     catch (std::exception& e)
@@ -369,63 +414,64 @@ bool GNSSFlowgraph::send_telemetry_msg(pmt::pmt_t msg)
 void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
 {
     DLOG(INFO) << "received " << what << " from " << who;
+    double now = static_cast<double>(std::time(0));
+
+    if (local_assistance_ && std::difftime(std::time(0), assistance_last_update_) >= assistance_refresh_s_)
+        {
+            update_assistance();
+        }
 
     switch (what)
     {
     case 0:
         LOG(INFO) << "Channel " << who << " ACQ FAILED satellite " << channels_.at(who)->get_signal().get_satellite() << ", Signal " << channels_.at(who)->get_signal().get_signal_str();
-        available_GNSS_signals_.push_back(channels_.at(who)->get_signal());
-        //TODO: Optimize the channel and signal matching!
-        while ( channels_.at(who)->get_signal().get_signal_str().compare(available_GNSS_signals_.front().get_signal_str()) != 0 )
-            {
-                available_GNSS_signals_.push_back(available_GNSS_signals_.front());
-                available_GNSS_signals_.pop_front();
-            }
-        channels_.at(who)->set_signal(available_GNSS_signals_.front());
-        available_GNSS_signals_.pop_front();
+        // The failed signal backs off, but it is taken again if nothing else is queued in its band
+        scheduler_.release(channels_.at(who)->get_signal(), now, true);
+        assign_signal(who);
         usleep(100);
         channels_.at(who)->start_acquisition();
         break;
     case 1:
         LOG(INFO) << "Channel " << who << " ACQ SUCCESS satellite " << channels_.at(who)->get_signal().get_satellite();
+        scheduler_.acquired(channels_.at(who)->get_signal());
         channels_state_[who] = 2;
         acq_channels_count_--;
-        if (!available_GNSS_signals_.empty() && acq_channels_count_ < max_acq_channels_)
+        scheduler_.acquisition_finished(channels_.at(who)->get_signal().get_signal_str());
+        for (unsigned int i = 0; i < channels_count_ && acq_channels_count_ < max_acq_channels_; i++)
             {
-                for (unsigned int i = 0; i < channels_count_; i++)
+                if (channels_state_[i] == 0)
                     {
-                        if (channels_state_[i] == 0)
+                        std::string gnss_signal = channels_.at(i)->get_signal().get_signal_str();
+                        if (!scheduler_.acquisition_slot_available(gnss_signal) || !assign_signal(i))
                             {
-                                channels_state_[i] = 1;
-                                while (channels_.at(i)->get_signal().get_signal_str().compare(available_GNSS_signals_.front().get_signal_str()) != 0 )
-                                    {
-                                        available_GNSS_signals_.push_back(available_GNSS_signals_.front());
-                                        available_GNSS_signals_.pop_front();
-                                    }
-                                channels_.at(i)->set_signal(available_GNSS_signals_.front());
-                                available_GNSS_signals_.pop_front();
-                                acq_channels_count_++;
-                                channels_.at(i)->start_acquisition();
-                                break;
+                                continue;
                             }
-                        DLOG(INFO) << "Channel " << i << " in state " << channels_state_[i];
+                        channels_state_[i] = 1;
+                        acq_channels_count_++;
+                        scheduler_.acquisition_started(gnss_signal);
+                        channels_.at(i)->start_acquisition();
                     }
+                DLOG(INFO) << "Channel " << i << " in state " << channels_state_[i];
             }
 
         break;
 
     case 2:
         LOG(INFO) << "Channel " << who << " TRK FAILED satellite " << channels_.at(who)->get_signal().get_satellite();
-        if (acq_channels_count_ < max_acq_channels_)
+        update_cn0(who);
+        scheduler_.release(channels_.at(who)->get_signal(), now, false);
+        if (acq_channels_count_ < max_acq_channels_
+                && scheduler_.acquisition_slot_available(channels_.at(who)->get_signal().get_signal_str())
+                && assign_signal(who))
             {
                 channels_state_[who] = 1;
                 acq_channels_count_++;
+                scheduler_.acquisition_started(channels_.at(who)->get_signal().get_signal_str());
                 channels_.at(who)->start_acquisition();
             }
         else
             {
                 channels_state_[who] = 0;
-                available_GNSS_signals_.push_back( channels_.at(who)->get_signal() );
             }
 
         // for (unsigned int i = 0; i < channels_count_; i++)
@@ -437,7 +483,7 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
     default:
         break;
     }
-    DLOG(INFO) << "Number of available signals: " << available_GNSS_signals_.size();
+    DLOG(INFO) << "Number of available signals: " << scheduler_.queued();
 }
 
 
@@ -466,6 +512,15 @@ void GNSSFlowgraph::init()
      */
     std::unique_ptr<GNSSBlockFactory> block_factory_(new GNSSBlockFactory());
 
+    // All the blocks get their FFT plans from a process-wide registry, which
+    // reads the FFTW wisdom once before the first acquisition block is built
+    Gnss_Fft_Registry::instance().configure(configuration_->property("GNSS-SDR.fftw_wisdom_file", std::string("")),
+            configuration_->property("GNSS-SDR.fftw_planning", std::string("measure")));
+
+    // The local codes of all the blocks are expanded from a shared bank of
+    // packed codes, generated here once for all the PRNs
+    Gnss_Code_Bank::instance();
+
     // 1. read the number of RF front-ends available (one file_source per RF front-end)
     sources_count_ = configuration_->property("Receiver.sources_count", 1);
 
@@ -526,9 +581,78 @@ void GNSSFlowgraph::init()
             channels_.push_back(std::dynamic_pointer_cast<ChannelInterface>(chan_));
         }
 
+    /*
+     * Optionally, each signal conditioner writes into a large sample ring and every
+     * channel reads it with its own cursor, so that a slow channel does not
+     * throttle the RF chain through the GNU Radio buffers
+     */
+    use_sample_ring_ = configuration_->property("GNSS-SDR.sample_ring", false);
+    if (use_sample_ring_)
+        {
+            uint64_t ring_size = configuration_->property("GNSS-SDR.sample_ring_size", 4194304);
+            bool hugepages = configuration_->property("GNSS-SDR.sample_ring_hugepages", true);
+            for (unsigned int i = 0; i < sig_conditioner_.size(); i++)
+                {
+                    size_t item_size = sig_conditioner_.at(i)->get_right_block()->output_signature()->sizeof_stream_item(0);
+                    std::shared_ptr<Gnss_Sample_Ring> ring = std::make_shared<Gnss_Sample_Ring>(item_size, ring_size,
+                            GNSS_SDR_SAMPLE_RING_MAX_READ_ITEMS, hugepages);
+                    sample_ring_.push_back(ring);
+                    sample_ring_sink_.push_back(gnss_sdr_make_sample_ring_sink(ring));
+                }
+            for (unsigned int i = 0; i < channels_count_; i++)
+                {
+                    unsigned int ring_ID = configuration_->property("Channel" + boost::lexical_cast<std::string>(i) + ".RF_channel_ID", 0);
+                    channels_.at(i)->set_sample_source(gnss_sdr_make_sample_ring_source(sample_ring_.at(ring_ID)));
+                }
+        }
+
+    // Keep the plans measured for the new blocks for the next run
+    if (!Gnss_Fft_Registry::instance().save_wisdom())
+        {
+            LOG(WARNING) << "Unable to save the FFTW wisdom to " << Gnss_Fft_Registry::instance().wisdom_filename();
+        }
+    LOG(INFO) << Gnss_Fft_Registry::instance().plans_created() << " FFT plans created, "
+              << Gnss_Fft_Registry::instance().plans_reused() << " reused";
+
     top_block_ = gr::make_top_block("GNSSFlowgraph");
 
-    // fill the available_GNSS_signals_ queue with the satellites ID's to be searched by the acquisition
+    /*
+     * Local acquisition assistance: visibility and Doppler predicted from the
+     * ephemerides and almanacs already known (decoded, SUPL or cached on disk)
+     * and the last fix, or a configured location
+     */
+    local_assistance_ = configuration_->property("GNSS-SDR.local_assistance", false);
+    if (local_assistance_ && file_signal_source())
+        {
+            // The predictions are made for the current wall-clock time, which
+            // has nothing to do with the time the samples were recorded
+            LOG(WARNING) << "Local acquisition assistance disabled: it only works with live front-ends, not with file signal sources";
+            local_assistance_ = false;
+        }
+    assistance_height_m_ = configuration_->property("GNSS-SDR.local_assistance_height_m", 0.0);
+    assistance_refresh_s_ = configuration_->property("GNSS-SDR.local_assistance_refresh_s", 30.0);
+    assistance_last_update_ = 0;
+    assistance_orbits_version_ = 0;
+    assistance_.set_elevation_mask(configuration_->property("GNSS-SDR.local_assistance_elevation_mask_deg", 5.0));
+    assistance_.set_doppler_margin(configuration_->property("GNSS-SDR.local_assistance_doppler_margin_hz", 1000.0));
+    double latitude = configuration_->property("GNSS-SDR.local_assistance_latitude_deg", 0.0);
+    double longitude = configuration_->property("GNSS-SDR.local_assistance_longitude_deg", 0.0);
+    if (latitude != 0.0 || longitude != 0.0)
+        {
+            assistance_.set_reference_location(latitude, longitude, assistance_height_m_,
+                    configuration_->property("GNSS-SDR.local_assistance_uncertainty_m", 10000.0));
+        }
+
+    /*
+     * Signal scheduler: the free channels take the queued signal with the
+     * best score (elevation, last C/N0, recent failures, constellation balance)
+     */
+    scheduler_.set_elevation_mask(configuration_->property("GNSS-SDR.local_assistance_elevation_mask_deg", 5.0));
+    scheduler_.set_backoff(configuration_->property("GNSS-SDR.scheduler_backoff_s", 10.0),
+            configuration_->property("GNSS-SDR.scheduler_max_backoff_s", 120.0));
+    scheduler_.set_balance_weight(configuration_->property("GNSS-SDR.scheduler_balance_weight", 5.0));
+
+    // fill the scheduler with the satellites ID's to be searched by the acquisition
     set_signals_list();
     set_channels_state();
     applied_actions_ = 0;
@@ -537,6 +661,146 @@ void GNSSFlowgraph::init()
 }
 
 
+void GNSSFlowgraph::set_channel_event_queue(std::shared_ptr<Channel_Event_Queue> events)
+{
+    for (unsigned int i = 0; i < channels_count_; i++)
+        {
+            channels_.at(i)->set_event_queue(events);
+        }
+}
+
+
+bool GNSSFlowgraph::assign_signal(unsigned int channel)
+{
+    Gnss_Signal signal;
+    if (!scheduler_.select(channels_.at(channel)->get_signal().get_signal_str(), static_cast<double>(std::time(0)), signal))
+        {
+            return false;
+        }
+    channels_.at(channel)->set_signal(signal);
+    assist_channel(channel);
+    DLOG(INFO) << "Channel " << channel << " assigned to " << signal << ", score " << scheduler_.score(signal);
+    return true;
+}
+
+
+void GNSSFlowgraph::update_cn0(unsigned int channel)
+{
+    Gnss_Synchro synchro;
+    Gnss_Signal signal = channels_.at(channel)->get_signal();
+    if (!global_channel_synchro_map.read(channel, synchro))
+        {
+            return;
+        }
+    // The channel may have lost the signal before the PVT saw it
+    if (synchro.PRN == signal.get_satellite().get_PRN()
+            && synchro.System == signal.get_satellite().get_system_short().c_str()[0]
+            && signal.get_signal_str().compare(0, 2, synchro.Signal, 2) == 0)
+        {
+            scheduler_.set_cn0(signal, synchro.CN0_dB_hz);
+        }
+}
+
+
+void GNSSFlowgraph::update_assistance()
+{
+    if (!local_assistance_)
+        {
+            return;
+        }
+    std::time_t now = std::time(0);
+    assistance_last_update_ = now;
+    // The maps only change when new navigation data is decoded, which is rare
+    unsigned long orbits_version = global_gps_ephemeris_map.version() + global_gps_almanac_map.version()
+            + global_galileo_ephemeris_map.version();
+    if (orbits_version != assistance_orbits_version_)
+        {
+            assistance_.set_gps_ephemeris(global_gps_ephemeris_map.get_map_copy());
+            assistance_.set_gps_almanac(global_gps_almanac_map.get_map_copy());
+            assistance_.set_galileo_ephemeris(global_galileo_ephemeris_map.get_map_copy());
+            assistance_orbits_version_ = orbits_version;
+        }
+    Gps_Ref_Location ref_location;
+    if (global_gps_ref_location_map.read(0, ref_location) && ref_location.valid)
+        {
+            assistance_.set_reference_location(ref_location.lat, ref_location.lon, assistance_height_m_, ref_location.uncertainty);
+        }
+    global_gps_ref_time_map.read(0, assistance_ref_time_);
+    if (!assistance_.ready())
+        {
+            DLOG(INFO) << "Not enough data for the local acquisition assistance yet";
+            return;
+        }
+    double tow = Gnss_Assistance_Engine::time_of_week(now, assistance_ref_time_);
+    std::vector<Gnss_Signal> signals = scheduler_.signals();
+    unsigned int predicted = 0;
+    for (unsigned int i = 0; i < signals.size(); i++)
+        {
+            Gnss_Assistance_Prediction prediction;
+            if (assistance_.predict(signals.at(i), tow, prediction))
+                {
+                    scheduler_.set_elevation(signals.at(i), prediction.elevation_deg);
+                    predicted++;
+                }
+            else
+                {
+                    scheduler_.clear_elevation(signals.at(i));
+                }
+        }
+    LOG(INFO) << "Local assistance: elevation predicted for " << predicted << " of the "
+              << signals.size() << " signals";
+}
+
+
+void GNSSFlowgraph::assist_channel(unsigned int channel)
+{
+    if (!local_assistance_)
+        {
+            return;
+        }
+    Gnss_Assistance_Prediction prediction;
+    double tow = Gnss_Assistance_Engine::time_of_week(std::time(0), assistance_ref_time_);
+    if (assistance_.predict(channels_.at(channel)->get_signal(), tow, prediction))
+        {
+            channels_.at(channel)->set_doppler_window(static_cast<int>(std::round(prediction.doppler_hz)),
+                    static_cast<unsigned int>(std::ceil(prediction.uncertainty_hz)));
+            DLOG(INFO) << "Channel " << channel << ": " << channels_.at(channel)->get_signal()
+                       << " predicted at " << prediction.elevation_deg << " deg elevation, Doppler "
+                       << prediction.doppler_hz << " +/- " << prediction.uncertainty_hz << " Hz";
+        }
+    else
+        {
+            channels_.at(channel)->set_doppler_window(0, 0);
+        }
+}
+
+
+bool GNSSFlowgraph::file_signal_source()
+{
+    std::vector<std::string> roles;
+    if (sources_count_ > 1)
+        {
+            for (int i = 0; i < sources_count_; i++)
+                {
+                    roles.push_back("SignalSource" + boost::lexical_cast<std::string>(i));
+                }
+        }
+    else
+        {
+            roles.push_back("SignalSource");
+        }
+    for (unsigned int i = 0; i < roles.size(); i++)
+        {
+            std::string implementation = configuration_->property(roles.at(i) + ".implementation", std::string("File_Signal_Source"));
+            if (implementation.find("File_Signal_Source") != std::string::npos)
+                {
+                    return true;
+                }
+        }
+    return false;
+}
+
+
 void GNSSFlowgraph::set_signals_list()
 {
     /*
@@ -630,7 +894,7 @@ void GNSSFlowgraph::set_signals_list()
                     available_gnss_prn_iter != available_gps_prn.end();
                     available_gnss_prn_iter++)
                 {
-                    available_GNSS_signals_.push_back(Gnss_Signal(Gnss_Satellite(std::string("GPS"),
+                    scheduler_.add(Gnss_Signal(Gnss_Satellite(std::string("GPS"),
                             *available_gnss_prn_iter), std::string("1C")));
                 }
         }
@@ -644,7 +908,7 @@ void GNSSFlowgraph::set_signals_list()
                     available_gnss_prn_iter != available_gps_prn.end();
                     available_gnss_prn_iter++)
                 {
-                    available_GNSS_signals_.push_back(Gnss_Signal(Gnss_Satellite(std::string("GPS"),
+                    scheduler_.add(Gnss_Signal(Gnss_Satellite(std::string("GPS"),
                             *available_gnss_prn_iter), std::string("2S")));
                 }
         }
@@ -658,7 +922,7 @@ void GNSSFlowgraph::set_signals_list()
                     available_gnss_prn_iter != available_sbas_prn.end();
                     available_gnss_prn_iter++)
                 {
-                    available_GNSS_signals_.push_back(Gnss_Signal(Gnss_Satellite(std::string("SBAS"),
+                    scheduler_.add(Gnss_Signal(Gnss_Satellite(std::string("SBAS"),
                             *available_gnss_prn_iter), std::string("1C")));
                 }
         }
@@ -673,7 +937,7 @@ void GNSSFlowgraph::set_signals_list()
                     available_gnss_prn_iter != available_galileo_prn.end();
                     available_gnss_prn_iter++)
                 {
-                    available_GNSS_signals_.push_back(Gnss_Signal(Gnss_Satellite(std::string("Galileo"),
+                    scheduler_.add(Gnss_Signal(Gnss_Satellite(std::string("Galileo"),
                             *available_gnss_prn_iter), std::string("1B")));
                 }
         }
@@ -687,17 +951,13 @@ void GNSSFlowgraph::set_signals_list()
                     available_gnss_prn_iter != available_galileo_prn.end();
                     available_gnss_prn_iter++)
                 {
-                    available_GNSS_signals_.push_back(Gnss_Signal(Gnss_Satellite(std::string("Galileo"),
+                    scheduler_.add(Gnss_Signal(Gnss_Satellite(std::string("Galileo"),
                             *available_gnss_prn_iter), std::string("5X")));
                 }
         }
     /*
-     * Ordering the list of signals from configuration file
+     * Signals assigned to a channel in the configuration file go first
      */
-    std::list<Gnss_Signal>::iterator gnss_it = available_GNSS_signals_.begin();
-
-    // Pre-assignation if not defined at ChannelX.signal=1C ...? In what order?
-
     for (unsigned int i = 0; i < total_channels; i++)
         {
             std::string gnss_signal = (configuration_->property("Channel" + boost::lexical_cast<std::string>(i) + ".signal", std::string("1C")));
@@ -706,25 +966,11 @@ void GNSSFlowgraph::set_signals_list()
             if((gnss_signal.compare("1B") == 0) or (gnss_signal.compare("5X") == 0) ) gnss_system = "Galileo";
             unsigned int sat = configuration_->property("Channel" + boost::lexical_cast<std::string>(i) + ".satellite", 0);
             LOG(INFO) << "Channel " << i <<  " system " << gnss_system << ", signal " << gnss_signal <<", sat "<<sat;
-            if (sat == 0) // 0 = not PRN in configuration file
-                {
-                    gnss_it++;
-                }
-            else
+            if (sat != 0) // 0 = not PRN in configuration file
                 {
-                    Gnss_Signal signal_value = Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal);
-                    available_GNSS_signals_.remove(signal_value);
-                    available_GNSS_signals_.insert(gnss_it, signal_value);
+                    scheduler_.add(Gnss_Signal(Gnss_Satellite(gnss_system, sat), gnss_signal), true);
                 }
         }
-
-    //    **** FOR DEBUGGING THE LIST OF GNSS SIGNALS ****
-    //    std::list<Gnss_Signal>::iterator available_gnss_list_iter;
-    //    for (available_gnss_list_iter = available_GNSS_signals_.begin(); available_gnss_list_iter
-    //    != available_GNSS_signals_.end(); available_gnss_list_iter++)
-    //        {
-    //            std::cout << *available_gnss_list_iter << std::endl;
-    //        }
 }
 
 
@@ -736,17 +982,30 @@ void GNSSFlowgraph::set_channels_state()
             max_acq_channels_ = channels_count_;
             LOG(WARNING) << "Channels_in_acquisition is bigger than number of channels. Variable acq_channels_count_ is set to " << channels_count_;
         }
+    // Optional limit per band, e.g. to search fewer Galileo signals at a time than GPS ones
+    const std::string bands[] = {"1C", "2S", "1B", "5X"};
+    for (unsigned int b = 0; b < 4; b++)
+        {
+            unsigned int band_max = configuration_->property("Channels_" + bands[b] + ".in_acquisition", 0);
+            if (band_max > 0)
+                {
+                    scheduler_.set_max_acquisitions(bands[b], band_max);
+                }
+        }
+    acq_channels_count_ = 0;
     channels_state_.reserve(channels_count_);
     for (unsigned int i = 0; i < channels_count_; i++)
         {
-            if (i < max_acq_channels_)
+            std::string gnss_signal = channels_.at(i)->get_signal().get_signal_str();
+            if (acq_channels_count_ < max_acq_channels_ && scheduler_.acquisition_slot_available(gnss_signal))
                 {
                     channels_state_.push_back(1);
+                    acq_channels_count_++;
+                    scheduler_.acquisition_started(gnss_signal);
                 }
             else
                 channels_state_.push_back(0);
             DLOG(INFO) << "Channel " << i << " in state " << channels_state_[i];
         }
-    acq_channels_count_ = max_acq_channels_;
     DLOG(INFO) << acq_channels_count_ << " channels in acquisition state";
 }
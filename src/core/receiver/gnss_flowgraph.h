@@ -36,7 +36,7 @@
 #ifndef GNSS_SDR_GNSS_FLOWGRAPH_H_
 #define GNSS_SDR_GNSS_FLOWGRAPH_H_
 
-#include <list>
+#include <ctime>
 #include <memory>
 #include <queue>
 #include <string>
@@ -44,12 +44,17 @@
 #include <gnuradio/top_block.h>
 #include <gnuradio/msg_queue.h>
 #include "GPS_L1_CA.h"
+#include "channel_event_queue.h"
+#include "gnss_assistance_engine.h"
 #include "gnss_signal.h"
+#include "gnss_signal_scheduler.h"
+#include "gps_ref_time.h"
 
 class GNSSBlockInterface;
 class ChannelInterface;
 class ConfigurationInterface;
 class GNSSBlockFactory;
+class Gnss_Sample_Ring;
 
 /*! \brief This class represents a GNSS flowgraph.
  *
@@ -95,6 +100,9 @@ public:
 
     void set_configuration(std::shared_ptr<ConfigurationInterface> configuration);
 
+    //! Makes all the channels post their events through events
+    void set_channel_event_queue(std::shared_ptr<Channel_Event_Queue> events);
+
     unsigned int applied_actions()
     {
         return applied_actions_;
@@ -118,6 +126,11 @@ private:
     void set_signals_list();
     void set_channels_state(); // Initializes the channels state (start acquisition or keep standby)
                                // using the configuration parameters (number of channels and max channels in acquisition)
+    bool assign_signal(unsigned int channel); // Gives the channel the best queued signal of its band
+    void update_cn0(unsigned int channel); // Passes the last C/N0 tracked by the channel to the scheduler
+    void update_assistance(); // Refreshes the assistance data and the predicted elevations of the queued signals
+    void assist_channel(unsigned int channel); // Sets the Doppler window of the channel around the predicted Doppler
+    bool file_signal_source(); // True if any signal source replays a file, whose time is not the wall-clock time
     bool connected_;
     bool running_;
     int sources_count_;
@@ -132,14 +145,28 @@ private:
     std::vector<std::shared_ptr<GNSSBlockInterface>> sig_source_;
     std::vector<std::shared_ptr<GNSSBlockInterface>> sig_conditioner_;
 
+    // Optional rings shared by all the channels fed by each signal conditioner
+    bool use_sample_ring_;
+    std::vector<std::shared_ptr<Gnss_Sample_Ring>> sample_ring_;
+    std::vector<gr::basic_block_sptr> sample_ring_sink_;
+
     std::shared_ptr<GNSSBlockInterface> observables_;
     std::shared_ptr<GNSSBlockInterface> pvt_;
 
     std::vector<std::shared_ptr<ChannelInterface>> channels_;
     gr::top_block_sptr top_block_;
     boost::shared_ptr<gr::msg_queue> queue_;
-    std::list<Gnss_Signal> available_GNSS_signals_;
+    Gnss_Signal_Scheduler scheduler_;
     std::vector<unsigned int> channels_state_;
+
+    // Local acquisition assistance
+    bool local_assistance_;
+    double assistance_height_m_;
+    double assistance_refresh_s_;
+    std::time_t assistance_last_update_;
+    unsigned long assistance_orbits_version_;
+    Gps_Ref_Time assistance_ref_time_;
+    Gnss_Assistance_Engine assistance_;
 };
 
 #endif /*GNSS_SDR_GNSS_FLOWGRAPH_H_*/
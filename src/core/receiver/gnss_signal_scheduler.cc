@@ -0,0 +1,410 @@
+/*!
+ * \file gnss_signal_scheduler.cc
+ * \brief Chooses which signal each free channel searches next
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_signal_scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+const double PINNED_SCORE = 1000.0;   // Signals assigned to a channel in the configuration
+const double VISIBLE_SCORE = 100.0;   // Plus the elevation in degrees
+const double UNKNOWN_SCORE = 50.0;    // No elevation prediction
+const double HIDDEN_SCORE = 0.0;      // Predicted below the elevation mask
+const double CN0_FLOOR_DB_HZ = 25.0;  // The C/N0 bonus is the excess over this value
+const double MAX_CN0_BONUS = 25.0;
+const double FAILURE_PENALTY = 10.0;
+const unsigned int MAX_PENALIZED_FAILURES = 5;
+}
+
+
+Gnss_Signal_Scheduler::Gnss_Signal_Scheduler()
+{
+    d_sequence = 0;
+    d_elevation_mask_deg = 5.0;
+    d_backoff_s = 10.0;
+    d_max_backoff_s = 120.0;
+    d_balance_weight = 5.0;
+}
+
+
+void Gnss_Signal_Scheduler::set_elevation_mask(double elevation_mask_deg)
+{
+    d_elevation_mask_deg = elevation_mask_deg;
+    std::vector<std::string> keys;
+    for (std::map<std::string, Entry>::const_iterator it = d_entries.begin(); it != d_entries.end(); ++it)
+        {
+            keys.push_back(it->first);
+        }
+    for (unsigned int i = 0; i < keys.size(); i++)
+        {
+            rescore(keys[i]);
+        }
+}
+
+
+void Gnss_Signal_Scheduler::set_backoff(double backoff_s, double max_backoff_s)
+{
+    d_backoff_s = backoff_s;
+    d_max_backoff_s = std::max(backoff_s, max_backoff_s);
+}
+
+
+void Gnss_Signal_Scheduler::set_balance_weight(double weight)
+{
+    d_balance_weight = weight;
+}
+
+
+std::string Gnss_Signal_Scheduler::key(const Gnss_Signal& signal)
+{
+    std::ostringstream entry_key;
+    entry_key << signal.get_signal_str() << " " << signal.get_satellite().get_system() << " " << signal.get_satellite().get_PRN();
+    return entry_key.str();
+}
+
+
+double Gnss_Signal_Scheduler::compute_score(const Entry& entry) const
+{
+    double score;
+    if (!entry.elevation_known)
+        {
+            score = UNKNOWN_SCORE;
+        }
+    else if (entry.elevation_deg >= d_elevation_mask_deg)
+        {
+            score = VISIBLE_SCORE + entry.elevation_deg;
+        }
+    else
+        {
+            score = HIDDEN_SCORE;
+        }
+    if (entry.pinned)
+        {
+            score += PINNED_SCORE;
+        }
+    score += std::max(0.0, std::min(MAX_CN0_BONUS, entry.cn0_db_hz - CN0_FLOOR_DB_HZ));
+    score -= FAILURE_PENALTY * std::min(entry.failures, MAX_PENALIZED_FAILURES);
+    return score;
+}
+
+
+void Gnss_Signal_Scheduler::enqueue(Entry& entry, const std::string& entry_key)
+{
+    entry.state = QUEUED;
+    entry.score = compute_score(entry);
+    d_queues[entry.signal.get_signal_str()][entry.signal.get_satellite().get_system()].insert(
+            Rank(std::make_pair(-entry.score, entry.sequence), entry_key));
+}
+
+
+void Gnss_Signal_Scheduler::dequeue(Entry& entry, const std::string& entry_key)
+{
+    if (entry.state == QUEUED)
+        {
+            d_queues[entry.signal.get_signal_str()][entry.signal.get_satellite().get_system()].erase(
+                    Rank(std::make_pair(-entry.score, entry.sequence), entry_key));
+        }
+    else if (entry.state == WAITING)
+        {
+            d_waiting[entry.signal.get_signal_str()].erase(std::make_pair(entry.retry_time, entry_key));
+        }
+}
+
+
+void Gnss_Signal_Scheduler::rescore(const std::string& entry_key)
+{
+    Entry& entry = d_entries[entry_key];
+    if (entry.state == QUEUED)
+        {
+            dequeue(entry, entry_key);
+            enqueue(entry, entry_key);
+        }
+    else
+        {
+            entry.score = compute_score(entry);
+        }
+}
+
+
+void Gnss_Signal_Scheduler::add(const Gnss_Signal& signal, bool pinned)
+{
+    std::string entry_key = key(signal);
+    std::map<std::string, Entry>::iterator it = d_entries.find(entry_key);
+    if (it != d_entries.end())
+        {
+            if (pinned && !it->second.pinned)
+                {
+                    it->second.pinned = true;
+                    rescore(entry_key);
+                }
+            return;
+        }
+    Entry entry;
+    entry.signal = signal;
+    entry.state = QUEUED;
+    entry.pinned = pinned;
+    entry.elevation_known = false;
+    entry.elevation_deg = 0.0;
+    entry.cn0_db_hz = 0.0;
+    entry.failures = 0;
+    entry.retry_time = 0.0;
+    entry.sequence = d_sequence++;
+    entry.score = 0.0;
+    enqueue(d_entries[entry_key] = entry, entry_key);
+}
+
+
+void Gnss_Signal_Scheduler::wake_up(const std::string& signal_str, double now)
+{
+    std::set<std::pair<double, std::string>>& waiting = d_waiting[signal_str];
+    while (!waiting.empty() && waiting.begin()->first <= now)
+        {
+            std::string entry_key = waiting.begin()->second;
+            waiting.erase(waiting.begin());
+            enqueue(d_entries[entry_key], entry_key);
+        }
+}
+
+
+bool Gnss_Signal_Scheduler::select(const std::string& signal_str, double now, Gnss_Signal& signal)
+{
+    wake_up(signal_str, now);
+    System_Queues& queues = d_queues[signal_str];
+    std::string best_key;
+    double best_score = 0.0;
+    unsigned long best_sequence = 0;
+    for (System_Queues::const_iterator it = queues.begin(); it != queues.end(); ++it)
+        {
+            if (it->second.empty())
+                {
+                    continue;
+                }
+            const Rank& head = *it->second.begin();
+            double score = -head.first.first - d_balance_weight * d_assigned[signal_str + " " + it->first];
+            if (best_key.empty() || score > best_score || (score == best_score && head.first.second < best_sequence))
+                {
+                    best_key = head.second;
+                    best_score = score;
+                    best_sequence = head.first.second;
+                }
+        }
+    if (best_key.empty())
+        {
+            // Nothing else to search: retry the signal that has waited the longest
+            std::set<std::pair<double, std::string>>& waiting = d_waiting[signal_str];
+            if (waiting.empty())
+                {
+                    return false;
+                }
+            best_key = waiting.begin()->second;
+        }
+    Entry& entry = d_entries[best_key];
+    dequeue(entry, best_key);
+    entry.state = ASSIGNED;
+    d_assigned[signal_str + " " + entry.signal.get_satellite().get_system()]++;
+    signal = entry.signal;
+    return true;
+}
+
+
+void Gnss_Signal_Scheduler::acquired(const Gnss_Signal& signal)
+{
+    std::map<std::string, Entry>::iterator it = d_entries.find(key(signal));
+    if (it != d_entries.end())
+        {
+            it->second.failures = 0;
+            it->second.score = compute_score(it->second);
+        }
+}
+
+
+void Gnss_Signal_Scheduler::release(const Gnss_Signal& signal, double now, bool failed)
+{
+    std::string entry_key = key(signal);
+    std::map<std::string, Entry>::iterator it = d_entries.find(entry_key);
+    if (it == d_entries.end())
+        {
+            // A signal that was not in the list, e.g. set by hand on a channel
+            add(signal);
+            it = d_entries.find(entry_key);
+            dequeue(it->second, entry_key);
+            it->second.state = ASSIGNED;
+            d_assigned[signal.get_signal_str() + " " + signal.get_satellite().get_system()]++;
+        }
+    Entry& entry = it->second;
+    if (entry.state != ASSIGNED)
+        {
+            return;
+        }
+    unsigned int& assigned = d_assigned[signal.get_signal_str() + " " + signal.get_satellite().get_system()];
+    if (assigned > 0)
+        {
+            assigned--;
+        }
+    entry.sequence = d_sequence++;
+    if (failed)
+        {
+            entry.failures++;
+            double backoff = d_backoff_s * std::pow(2.0, static_cast<double>(std::min(entry.failures, 16u) - 1));
+            entry.retry_time = now + std::min(backoff, d_max_backoff_s);
+            entry.state = WAITING;
+            entry.score = compute_score(entry);
+            d_waiting[signal.get_signal_str()].insert(std::make_pair(entry.retry_time, entry_key));
+        }
+    else
+        {
+            enqueue(entry, entry_key);
+        }
+}
+
+
+void Gnss_Signal_Scheduler::set_elevation(const Gnss_Signal& signal, double elevation_deg)
+{
+    std::map<std::string, Entry>::iterator it = d_entries.find(key(signal));
+    if (it != d_entries.end() && (!it->second.elevation_known || it->second.elevation_deg != elevation_deg))
+        {
+            it->second.elevation_known = true;
+            it->second.elevation_deg = elevation_deg;
+            rescore(it->first);
+        }
+}
+
+
+void Gnss_Signal_Scheduler::clear_elevation(const Gnss_Signal& signal)
+{
+    std::map<std::string, Entry>::iterator it = d_entries.find(key(signal));
+    if (it != d_entries.end() && it->second.elevation_known)
+        {
+            it->second.elevation_known = false;
+            rescore(it->first);
+        }
+}
+
+
+void Gnss_Signal_Scheduler::set_cn0(const Gnss_Signal& signal, double cn0_db_hz)
+{
+    std::map<std::string, Entry>::iterator it = d_entries.find(key(signal));
+    if (it != d_entries.end())
+        {
+            it->second.cn0_db_hz = cn0_db_hz;
+            rescore(it->first);
+        }
+}
+
+
+std::vector<Gnss_Signal> Gnss_Signal_Scheduler::signals() const
+{
+    std::vector<Gnss_Signal> all;
+    for (std::map<std::string, Entry>::const_iterator it = d_entries.begin(); it != d_entries.end(); ++it)
+        {
+            all.push_back(it->second.signal);
+        }
+    return all;
+}
+
+
+unsigned int Gnss_Signal_Scheduler::queued(const std::string& signal_str) const
+{
+    unsigned int count = 0;
+    std::map<std::string, System_Queues>::const_iterator queues = d_queues.find(signal_str);
+    if (queues != d_queues.end())
+        {
+            for (System_Queues::const_iterator it = queues->second.begin(); it != queues->second.end(); ++it)
+                {
+                    count += it->second.size();
+                }
+        }
+    std::map<std::string, std::set<std::pair<double, std::string>>>::const_iterator waiting = d_waiting.find(signal_str);
+    if (waiting != d_waiting.end())
+        {
+            count += waiting->second.size();
+        }
+    return count;
+}
+
+
+unsigned int Gnss_Signal_Scheduler::queued() const
+{
+    unsigned int count = 0;
+    for (std::map<std::string, Entry>::const_iterator it = d_entries.begin(); it != d_entries.end(); ++it)
+        {
+            if (it->second.state != ASSIGNED)
+                {
+                    count++;
+                }
+        }
+    return count;
+}
+
+
+void Gnss_Signal_Scheduler::set_max_acquisitions(const std::string& signal_str, unsigned int max_acquisitions)
+{
+    d_max_acquisitions[signal_str] = max_acquisitions;
+}
+
+
+bool Gnss_Signal_Scheduler::acquisition_slot_available(const std::string& signal_str) const
+{
+    std::map<std::string, unsigned int>::const_iterator max = d_max_acquisitions.find(signal_str);
+    if (max == d_max_acquisitions.end())
+        {
+            return true;
+        }
+    std::map<std::string, unsigned int>::const_iterator count = d_acquisitions.find(signal_str);
+    return count == d_acquisitions.end() || count->second < max->second;
+}
+
+
+void Gnss_Signal_Scheduler::acquisition_started(const std::string& signal_str)
+{
+    d_acquisitions[signal_str]++;
+}
+
+
+void Gnss_Signal_Scheduler::acquisition_finished(const std::string& signal_str)
+{
+    unsigned int& count = d_acquisitions[signal_str];
+    if (count > 0)
+        {
+            count--;
+        }
+}
+
+
+double Gnss_Signal_Scheduler::score(const Gnss_Signal& signal) const
+{
+    std::map<std::string, Entry>::const_iterator it = d_entries.find(key(signal));
+    if (it == d_entries.end())
+        {
+            return 0.0;
+        }
+    return compute_score(it->second);
+}
@@ -0,0 +1,165 @@
+/*!
+ * \file gnss_signal_scheduler.h
+ * \brief Chooses which signal each free channel searches next
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SIGNAL_SCHEDULER_H_
+#define GNSS_SDR_GNSS_SIGNAL_SCHEDULER_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "gnss_signal.h"
+
+/*!
+ * \brief Priority queue of the signals waiting for a channel.
+ *
+ * Each signal gets a score from its predicted elevation (signals above the
+ * elevation mask first, then the ones without a prediction, then the ones
+ * below the mask), the C/N0 it had the last time it was tracked, and the
+ * number of acquisitions that failed in a row. Signals pinned to a channel
+ * in the configuration go first. A signal whose acquisition failed waits for
+ * a back-off time that doubles with each failure, unless there is nothing
+ * else to search in its band.
+ *
+ * The signals of a band are kept in one ordered set per system, so that the
+ * best one is found in O(log n). Among systems sharing a band (GPS and SBAS
+ * in 1C), the score is lowered by the number of signals of that system
+ * already in the channels, which keeps the constellations balanced.
+ *
+ * The scheduler also counts the channels in acquisition of each band, so that
+ * a band can be limited to fewer concurrent searches than it has channels.
+ */
+class Gnss_Signal_Scheduler
+{
+public:
+    Gnss_Signal_Scheduler();
+
+    void set_elevation_mask(double elevation_mask_deg);
+
+    //! Back-off after the first failed acquisition, and its upper limit [s]
+    void set_backoff(double backoff_s, double max_backoff_s);
+
+    //! Score lost per channel already used by the same system in the band
+    void set_balance_weight(double weight);
+
+    /*!
+     * \brief Queues a signal. Signals with equal scores are searched in the
+     * order they were added.
+     * \param[in] pinned True if the configuration assigns it to a channel
+     */
+    void add(const Gnss_Signal& signal, bool pinned = false);
+
+    /*!
+     * \brief Takes the best queued signal of a band (e.g. "1C") and marks it
+     * as assigned to a channel.
+     * \return false if no signal of that band is queued
+     */
+    bool select(const std::string& signal_str, double now, Gnss_Signal& signal);
+
+    //! Marks an assigned signal as acquired: its failure count is reset
+    void acquired(const Gnss_Signal& signal);
+
+    /*!
+     * \brief Returns an assigned signal to the queue.
+     * \param[in] failed True if its acquisition failed, false if it was lost
+     * by the tracking or the channel is given to another signal
+     */
+    void release(const Gnss_Signal& signal, double now, bool failed);
+
+    //! Sets the predicted elevation of a signal
+    void set_elevation(const Gnss_Signal& signal, double elevation_deg);
+
+    //! Forgets the predicted elevation of a signal
+    void clear_elevation(const Gnss_Signal& signal);
+
+    //! Sets the last C/N0 at which the signal was tracked [dB-Hz]
+    void set_cn0(const Gnss_Signal& signal, double cn0_db_hz);
+
+    //! All the signals known to the scheduler, queued or not
+    std::vector<Gnss_Signal> signals() const;
+
+    //! Number of signals of a band waiting for a channel
+    unsigned int queued(const std::string& signal_str) const;
+
+    //! Number of signals waiting for a channel
+    unsigned int queued() const;
+
+    //! Limits the channels of a band in acquisition at the same time
+    void set_max_acquisitions(const std::string& signal_str, unsigned int max_acquisitions);
+    bool acquisition_slot_available(const std::string& signal_str) const;
+    void acquisition_started(const std::string& signal_str);
+    void acquisition_finished(const std::string& signal_str);
+
+    //! Current score of a signal, for logging and testing
+    double score(const Gnss_Signal& signal) const;
+
+private:
+    enum Entry_State { QUEUED, WAITING, ASSIGNED };
+
+    struct Entry
+    {
+        Gnss_Signal signal;
+        Entry_State state;
+        bool pinned;
+        bool elevation_known;
+        double elevation_deg;
+        double cn0_db_hz;
+        unsigned int failures;
+        double retry_time;
+        unsigned long sequence;
+        double score;
+    };
+
+    // Ordered by decreasing score, then by arrival
+    typedef std::pair<std::pair<double, unsigned long>, std::string> Rank;
+    typedef std::map<std::string, std::set<Rank>> System_Queues;
+
+    static std::string key(const Gnss_Signal& signal);
+    double compute_score(const Entry& entry) const;
+    void enqueue(Entry& entry, const std::string& entry_key);
+    void dequeue(Entry& entry, const std::string& entry_key);
+    void rescore(const std::string& entry_key);
+    void wake_up(const std::string& signal_str, double now);
+
+    std::map<std::string, Entry> d_entries;
+    std::map<std::string, System_Queues> d_queues;                             // band, system
+    std::map<std::string, std::set<std::pair<double, std::string>>> d_waiting; // band: retry time
+    std::map<std::string, unsigned int> d_assigned;                            // band + system
+    std::map<std::string, unsigned int> d_acquisitions;
+    std::map<std::string, unsigned int> d_max_acquisitions;
+    unsigned long d_sequence;
+    double d_elevation_mask_deg;
+    double d_backoff_s;
+    double d_max_backoff_s;
+    double d_balance_weight;
+};
+
+#endif /* GNSS_SDR_GNSS_SIGNAL_SCHEDULER_H_ */
@@ -0,0 +1,109 @@
+/*!
+ * \file parallel_for.h
+ * \brief Runs independent, indexed tasks on a pool of threads
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PARALLEL_FOR_H_
+#define GNSS_SDR_PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * \brief Calls task(i) for every i in [0, count) using up to threads
+ * threads, the calling one included (threads = 0 uses one per core).
+ *
+ * The tasks are taken in index order from a shared counter, so the load is
+ * balanced even if their costs differ, and each task writes its result in
+ * its own slot: the order of the results does not depend on which thread
+ * ran them. Returns when all the tasks have finished. If a task throws, the
+ * remaining ones are not started and the first exception is rethrown to the
+ * caller.
+ */
+inline void parallel_for(unsigned int count, unsigned int threads, const std::function<void(unsigned int)>& task)
+{
+    if (threads == 0)
+        {
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+    threads = std::min(threads, count);
+    if (threads <= 1)
+        {
+            for (unsigned int i = 0; i < count; i++)
+                {
+                    task(i);
+                }
+            return;
+        }
+
+    std::atomic<unsigned int> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    std::function<void()> worker = [&]()
+        {
+            unsigned int i;
+            while (!failed.load(std::memory_order_relaxed) && (i = next.fetch_add(1)) < count)
+                {
+                    try
+                    {
+                            task(i);
+                    }
+                    catch (...)
+                    {
+                            std::lock_guard<std::mutex> lock(error_mutex);
+                            if (!error)
+                                {
+                                    error = std::current_exception();
+                                }
+                            failed = true;
+                    }
+                }
+        };
+
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < threads; t++)
+        {
+            pool.push_back(std::thread(worker));
+        }
+    worker();
+    for (unsigned int t = 0; t < pool.size(); t++)
+        {
+            pool.at(t).join();
+        }
+    if (error)
+        {
+            std::rethrow_exception(error);
+        }
+}
+
+#endif /* GNSS_SDR_PARALLEL_FOR_H_ */
@@ -99,9 +99,9 @@ public:
     double d_satpos_Z;  //!< Earth-fixed coordinate z of the satellite [m]. The direction of the IERS (International Earth Rotation and Reference Systems Service) Reference Pole (IRP).
 
     // Satellite velocity
-    double d_satvel_X;  //!< Earth-fixed velocity coordinate x of the satellite [m]
-    double d_satvel_Y;  //!< Earth-fixed velocity coordinate y of the satellite [m]
-    double d_satvel_Z;  //!< Earth-fixed velocity coordinate z of the satellite [m]
+    double d_satvel_X;  //!< Earth-fixed velocity coordinate x of the satellite [m/s]
+    double d_satvel_Y;  //!< Earth-fixed velocity coordinate y of the satellite [m/s]
+    double d_satvel_Z;  //!< Earth-fixed velocity coordinate z of the satellite [m/s]
 
     unsigned int i_satellite_PRN; //!< SV PRN NUMBER
 
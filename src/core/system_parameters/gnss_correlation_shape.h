@@ -0,0 +1,62 @@
+/*!
+ * \file gnss_correlation_shape.h
+ * \brief  Interface of the Gnss_Correlation_Shape class, the correlation
+ * function published by the tracking blocks for signal quality monitoring.
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+#ifndef GNSS_SDR_GNSS_CORRELATION_SHAPE_H_
+#define GNSS_SDR_GNSS_CORRELATION_SHAPE_H_
+
+#include <complex>
+#include <vector>
+
+/*!
+ * \brief Correlation function of one channel around its prompt, computed by
+ * a tracking block with a dense set of correlators every few code periods and
+ * published on its "correlation_shape" message port. Distortions of its shape
+ * (asymmetry, a flattened or double peak) reveal multipath and spoofing.
+ */
+class Gnss_Correlation_Shape
+{
+public:
+    char System;                    //!< System of the satellite tracked by the channel
+    unsigned int PRN;               //!< PRN of the satellite tracked by the channel
+    int Channel_ID;                 //!< Channel that computed the correlation function
+    double Tracking_timestamp_secs; //!< Tracking timestamp of the start of the integration [s]
+    double Integration_time_s;      //!< Coherent integration time of the correlators [s]
+    double Spacing_chips;           //!< Spacing of the correlators [chips]
+    std::vector<std::complex<float> > Correlation; //!< Correlator outputs, from the earliest to the latest. The middle one is the prompt
+
+    Gnss_Correlation_Shape() :
+        System(0),
+        PRN(0),
+        Channel_ID(-1),
+        Tracking_timestamp_secs(0.0),
+        Integration_time_s(0.0),
+        Spacing_chips(0.0)
+    {}
+};
+
+#endif
@@ -0,0 +1,345 @@
+/*!
+ * \file gnss_receiver_state.cc
+ * \brief Receiver state kept on disk so that a restarted receiver does not
+ * have to decode the navigation data again
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "gnss_receiver_state.h"
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <glog/logging.h>
+
+using google::LogMessage;
+
+namespace
+{
+// Written before the state, so that files of another format are rejected
+const unsigned int RECEIVER_STATE_MAGIC = 0x47525331;  // "GRS1"
+
+// Longest interval between fixes used to estimate the clock drift [s]
+const double MAX_DRIFT_INTERVAL_S = 60.0;
+
+// Half of the curve fit interval of the GPS broadcast ephemeris [s]
+const double MAX_EPHEMERIS_AGE_S = 2.0 * 3600.0;
+
+// The iono and UTC models change much more slowly, but stale ones are
+// replaced by the first decoded ones anyway [s]
+const double MAX_MODELS_AGE_S = 2.0 * 3600.0;
+
+const double GPS_UNIX_EPOCH_OFFSET_S = 315964800.0;   // 1980-01-06T00:00:00Z as Unix time
+const double GPS_UTC_LEAP_SECONDS = 18.0;             // Since 2017-01-01
+const double WEEK_S = 604800.0;
+const int WEEK_ROLLOVER = 1024;
+
+// Doppler rates of a static receiver stay below 1 Hz/s
+const double MAX_DOPPLER_AGE_S = 300.0;
+const double DOPPLER_RATE_HZ_S = 1.0;
+const double DOPPLER_UNCERTAINTY_HZ = 100.0;
+}
+
+
+Gnss_Receiver_State::Gnss_Receiver_State()
+{
+    position_valid = false;
+    latitude_deg = 0.0;
+    longitude_deg = 0.0;
+    height_m = 0.0;
+    rx_time = 0.0;
+    clock_bias_s = 0.0;
+    clock_drift = 0.0;
+    saved_at = 0.0;
+}
+
+
+void Gnss_Receiver_State::set_fix(double time, double latitude, double longitude, double height, double clock_bias)
+{
+    double dt = time - rx_time;
+    if (position_valid && dt > 0.0 && dt <= MAX_DRIFT_INTERVAL_S)
+        {
+            clock_drift = (clock_bias - clock_bias_s) / dt;
+        }
+    position_valid = true;
+    rx_time = time;
+    latitude_deg = latitude;
+    longitude_deg = longitude;
+    height_m = height;
+    clock_bias_s = clock_bias;
+}
+
+
+void Gnss_Receiver_State::set_observations(const std::map<int, Gnss_Synchro>& gnss_pseudoranges_map)
+{
+    for (std::map<int, Gnss_Synchro>::const_iterator it = gnss_pseudoranges_map.begin(); it != gnss_pseudoranges_map.end(); ++it)
+        {
+            doppler_hz[doppler_key(it->second.System, std::string(it->second.Signal, 2), it->second.PRN)] = it->second.Carrier_Doppler_hz;
+        }
+}
+
+
+bool Gnss_Receiver_State::get_doppler(char system, const std::string& signal, unsigned int prn, double& doppler) const
+{
+    std::map<std::string, double>::const_iterator it = doppler_hz.find(doppler_key(system, signal, prn));
+    if (it == doppler_hz.end())
+        {
+            return false;
+        }
+    doppler = it->second;
+    return true;
+}
+
+
+std::string Gnss_Receiver_State::doppler_key(char system, const std::string& signal, unsigned int prn)
+{
+    char key[16];
+    std::snprintf(key, sizeof(key), "%c%.2s%02u", system, signal.c_str(), prn);
+    return std::string(key);
+}
+
+
+double Gnss_Receiver_State::age(double now) const
+{
+    return now - saved_at;
+}
+
+
+double Gnss_Receiver_State::navigation_data_age(double now, int week, double toe)
+{
+    double gps_time = now - GPS_UNIX_EPOCH_OFFSET_S + GPS_UTC_LEAP_SECONDS;
+    double week_now = std::floor(gps_time / WEEK_S);
+    double tow_now = gps_time - week_now * WEEK_S;
+    int weeks = (static_cast<int>(week_now) - week) % WEEK_ROLLOVER;
+    if (weeks < 0)
+        {
+            weeks += WEEK_ROLLOVER;
+        }
+    if (weeks > WEEK_ROLLOVER / 2)
+        {
+            weeks -= WEEK_ROLLOVER;
+        }
+    return static_cast<double>(weeks) * WEEK_S + tow_now - toe;
+}
+
+
+unsigned int Gnss_Receiver_State::remove_stale_ephemerides(double now)
+{
+    unsigned int removed = 0;
+    for (std::map<int, Gps_Ephemeris>::iterator it = gps_ephemeris_map.begin(); it != gps_ephemeris_map.end(); )
+        {
+            if (std::fabs(navigation_data_age(now, it->second.i_GPS_week, it->second.d_Toe)) > MAX_EPHEMERIS_AGE_S)
+                {
+                    it = gps_ephemeris_map.erase(it);
+                    removed++;
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+    for (std::map<int, Gps_CNAV_Ephemeris>::iterator it = gps_cnav_ephemeris_map.begin(); it != gps_cnav_ephemeris_map.end(); )
+        {
+            if (std::fabs(navigation_data_age(now, it->second.i_GPS_week, it->second.d_Toe1)) > MAX_EPHEMERIS_AGE_S)
+                {
+                    it = gps_cnav_ephemeris_map.erase(it);
+                    removed++;
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+    // Galileo week 0 is GPS week 1024, and GST has no leap seconds either
+    for (std::map<int, Galileo_Ephemeris>::iterator it = galileo_ephemeris_map.begin(); it != galileo_ephemeris_map.end(); )
+        {
+            if (std::fabs(navigation_data_age(now, static_cast<int>(it->second.WN_5), it->second.t0e_1)) > MAX_EPHEMERIS_AGE_S)
+                {
+                    it = galileo_ephemeris_map.erase(it);
+                    removed++;
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+    return removed;
+}
+
+
+bool Gnss_Receiver_State::models_usable(double now) const
+{
+    return age(now) >= 0.0 && age(now) < MAX_MODELS_AGE_S;
+}
+
+
+bool Gnss_Receiver_State::doppler_usable(double now) const
+{
+    return age(now) >= 0.0 && age(now) < MAX_DOPPLER_AGE_S;
+}
+
+
+double Gnss_Receiver_State::doppler_uncertainty(double now) const
+{
+    return DOPPLER_UNCERTAINTY_HZ + DOPPLER_RATE_HZ_S * age(now);
+}
+
+
+bool Gnss_Receiver_State::save(const std::string& filename)
+{
+    saved_at = static_cast<double>(std::time(0));
+    std::string tmp_filename = filename + ".tmp";
+    try
+    {
+            std::ofstream ofs(tmp_filename.c_str(), std::ofstream::trunc | std::ofstream::out | std::ofstream::binary);
+            if (!ofs.is_open())
+                {
+                    LOG(WARNING) << "Unable to open " << tmp_filename;
+                    return false;
+                }
+            {
+                boost::archive::binary_oarchive archive(ofs);
+                unsigned int magic = RECEIVER_STATE_MAGIC;
+                archive << magic;
+                archive << *this;
+            }
+            ofs.close();
+            if (ofs.fail())
+                {
+                    std::remove(tmp_filename.c_str());
+                    return false;
+                }
+    }
+    catch (std::exception& e)
+    {
+            LOG(WARNING) << "Unable to write the receiver state: " << e.what();
+            std::remove(tmp_filename.c_str());
+            return false;
+    }
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        {
+            std::remove(tmp_filename.c_str());
+            return false;
+        }
+    return true;
+}
+
+
+bool Gnss_Receiver_State::load(const std::string& filename)
+{
+    std::ifstream ifs(filename.c_str(), std::ifstream::in | std::ifstream::binary);
+    if (!ifs.is_open())
+        {
+            return false;
+        }
+    Gnss_Receiver_State state;
+    try
+    {
+            boost::archive::binary_iarchive archive(ifs);
+            unsigned int magic = 0;
+            archive >> magic;
+            if (magic != RECEIVER_STATE_MAGIC)
+                {
+                    LOG(WARNING) << filename << " is not a receiver state file";
+                    return false;
+                }
+            archive >> state;
+    }
+    catch (std::exception& e)
+    {
+            LOG(WARNING) << "Unable to read the receiver state from " << filename << ": " << e.what();
+            return false;
+    }
+    *this = state;
+    return true;
+}
+
+
+Gnss_Receiver_State_Writer::Gnss_Receiver_State_Writer(const std::string& filename) :
+        d_filename(filename),
+        d_has_pending(false),
+        d_writing(false),
+        d_stop(false)
+{
+    d_thread = std::thread(&Gnss_Receiver_State_Writer::run, this);
+}
+
+
+Gnss_Receiver_State_Writer::~Gnss_Receiver_State_Writer()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    d_thread.join();
+}
+
+
+void Gnss_Receiver_State_Writer::write(const Gnss_Receiver_State& state)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_pending = state;
+        d_has_pending = true;
+    }
+    d_cond.notify_all();
+}
+
+
+void Gnss_Receiver_State_Writer::flush()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_cond.wait(lock, [this]{ return !d_has_pending && !d_writing; });
+}
+
+
+void Gnss_Receiver_State_Writer::run()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cond.wait(lock, [this]{ return d_has_pending || d_stop; });
+            if (!d_has_pending)
+                {
+                    // Stopped with nothing left to write
+                    return;
+                }
+            Gnss_Receiver_State state = d_pending;
+            d_has_pending = false;
+            d_writing = true;
+            lock.unlock();
+            if (!state.save(d_filename))
+                {
+                    LOG(WARNING) << "Unable to save the receiver state to " << d_filename;
+                }
+            lock.lock();
+            d_writing = false;
+            d_cond.notify_all();
+        }
+}
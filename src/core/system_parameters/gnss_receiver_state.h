@@ -0,0 +1,209 @@
+/*!
+ * \file gnss_receiver_state.h
+ * \brief Receiver state kept on disk so that a restarted receiver does not
+ * have to decode the navigation data again
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_RECEIVER_STATE_H_
+#define GNSS_SDR_GNSS_RECEIVER_STATE_H_
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
+#include "galileo_ephemeris.h"
+#include "galileo_iono.h"
+#include "galileo_utc_model.h"
+#include "gnss_synchro.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_cnav_iono.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include "gps_utc_model.h"
+
+
+/*!
+ * \brief Snapshot of everything the receiver learned from the sky: the
+ * navigation data, the last fix with the receiver clock, and the last
+ * Doppler of each tracked signal.
+ *
+ * The PVT blocks write it periodically to a binary file, and read it back
+ * when they are built, that is, before the flowgraph is connected and the
+ * channels start acquiring.
+ */
+class Gnss_Receiver_State
+{
+public:
+    std::map<int, Gps_Ephemeris> gps_ephemeris_map;
+    std::map<int, Gps_CNAV_Ephemeris> gps_cnav_ephemeris_map;
+    std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;
+    Gps_Iono gps_iono;
+    Gps_CNAV_Iono gps_cnav_iono;
+    Gps_Utc_Model gps_utc_model;
+    Galileo_Iono galileo_iono;
+    Galileo_Utc_Model galileo_utc_model;
+
+    bool position_valid;
+    double latitude_deg;
+    double longitude_deg;
+    double height_m;
+    double rx_time;      //!< Receiver time of the last fix [s]
+    double clock_bias_s; //!< Receiver clock offset at the last fix [s]
+    double clock_drift;  //!< Receiver clock drift [s/s]
+    double saved_at;     //!< System time at which the state was written [s since the Unix epoch]
+
+    //! Last carrier Doppler of each signal [Hz], see doppler_key()
+    std::map<std::string, double> doppler_hz;
+
+    Gnss_Receiver_State();
+
+    /*!
+     * \brief Stores a fix. The clock drift is estimated from the clock
+     * offsets of consecutive fixes.
+     */
+    void set_fix(double time, double latitude, double longitude, double height, double clock_bias);
+
+    //! Stores the Doppler of the signals with a valid pseudorange
+    void set_observations(const std::map<int, Gnss_Synchro>& gnss_pseudoranges_map);
+
+    /*!
+     * \brief Returns the last Doppler of a signal.
+     * \return false if it was not tracked
+     */
+    bool get_doppler(char system, const std::string& signal, unsigned int prn, double& doppler) const;
+
+    //! Key of the Doppler map, e.g. "G1C12"
+    static std::string doppler_key(char system, const std::string& signal, unsigned int prn);
+
+    //! Age of the state at now [s since the Unix epoch]
+    double age(double now) const;
+
+    /*!
+     * \brief Age at now of a navigation message with reference time toe in
+     * the broadcast week number week [s]. It is negative before toe.
+     * The week is taken modulo 1024, as broadcast in the GPS LNAV message.
+     */
+    static double navigation_data_age(double now, int week, double toe);
+
+    /*!
+     * \brief Removes the ephemerides whose own reference time is too far
+     * from now to be used, whatever the age of the state.
+     * \return the number of ephemerides removed
+     */
+    unsigned int remove_stale_ephemerides(double now);
+
+    //! True if the iono and UTC models are recent enough to be used at startup
+    bool models_usable(double now) const;
+
+    //! True if the last Doppler values can still narrow the acquisition search
+    bool doppler_usable(double now) const;
+
+    //! Uncertainty of the last Doppler values at now [Hz]
+    double doppler_uncertainty(double now) const;
+
+    /*!
+     * \brief Writes the state. The file is written under a temporary name and
+     * then renamed, so that a crash never leaves half a state behind.
+     */
+    bool save(const std::string& filename);
+
+    //! Reads a state written by save(). The object is not modified on failure.
+    bool load(const std::string& filename);
+
+    template<class Archive>
+
+    /*!
+     * \brief Serialize is a boost standard method to be called by the boost serialization. Here is used to save the receiver state on disk file.
+     */
+    void serialize(Archive& archive, const unsigned int version)
+    {
+        using boost::serialization::make_nvp;
+        if(version){};
+        archive & make_nvp("gps_ephemeris_map", gps_ephemeris_map);
+        archive & make_nvp("gps_cnav_ephemeris_map", gps_cnav_ephemeris_map);
+        archive & make_nvp("galileo_ephemeris_map", galileo_ephemeris_map);
+        archive & make_nvp("gps_iono", gps_iono);
+        archive & make_nvp("gps_iono_valid", gps_iono.valid);
+        archive & make_nvp("gps_cnav_iono", gps_cnav_iono);
+        archive & make_nvp("gps_cnav_iono_valid", gps_cnav_iono.valid);
+        archive & make_nvp("gps_utc_model", gps_utc_model);
+        archive & make_nvp("galileo_iono", galileo_iono);
+        archive & make_nvp("galileo_utc_model", galileo_utc_model);
+        archive & make_nvp("position_valid", position_valid);
+        archive & make_nvp("latitude_deg", latitude_deg);
+        archive & make_nvp("longitude_deg", longitude_deg);
+        archive & make_nvp("height_m", height_m);
+        archive & make_nvp("rx_time", rx_time);
+        archive & make_nvp("clock_bias_s", clock_bias_s);
+        archive & make_nvp("clock_drift", clock_drift);
+        archive & make_nvp("saved_at", saved_at);
+        archive & make_nvp("doppler_hz", doppler_hz);
+    }
+};
+
+
+/*!
+ * \brief Writes receiver states to a file from its own thread, so that the
+ * file I/O never blocks the signal processing.
+ *
+ * Only the latest state is kept: a state that arrives while the previous one
+ * is being written replaces any state still waiting. The destructor writes
+ * the pending state before returning.
+ */
+class Gnss_Receiver_State_Writer
+{
+public:
+    explicit Gnss_Receiver_State_Writer(const std::string& filename);
+    ~Gnss_Receiver_State_Writer();
+
+    Gnss_Receiver_State_Writer(const Gnss_Receiver_State_Writer&) = delete;
+    Gnss_Receiver_State_Writer& operator=(const Gnss_Receiver_State_Writer&) = delete;
+
+    //! Queues a copy of the state for writing and returns at once
+    void write(const Gnss_Receiver_State& state);
+
+    //! Waits until all the queued states are written
+    void flush();
+
+private:
+    void run();
+
+    std::string d_filename;
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    Gnss_Receiver_State d_pending;
+    bool d_has_pending;
+    bool d_writing;
+    bool d_stop;
+    std::thread d_thread;
+};
+
+#endif
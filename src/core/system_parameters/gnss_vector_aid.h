@@ -0,0 +1,58 @@
+/*!
+ * \file gnss_vector_aid.h
+ * \brief  Interface of the Gnss_Vector_Aid class, the feedback sent by the
+ * PVT block to the vector tracking loops.
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+#ifndef GNSS_SDR_GNSS_VECTOR_AID_H_
+#define GNSS_SDR_GNSS_VECTOR_AID_H_
+
+
+/*!
+ * \brief Code and carrier prediction for one channel, computed by the PVT
+ * block from the navigation solution (position, velocity and clock of the
+ * receiver) and published on its "vector_aid" message port.
+ */
+class Gnss_Vector_Aid
+{
+public:
+    char System;                //!< System of the satellite tracked by the channel
+    unsigned int PRN;           //!< PRN of the satellite tracked by the channel
+    int Channel_ID;             //!< Channel the aid is addressed to
+    double Tracking_timestamp_secs; //!< Tracking timestamp of the observation the aid was computed from [s]
+    double Carrier_Doppler_hz;  //!< Doppler predicted from the receiver velocity and clock drift [Hz]
+    double Code_error_m;        //!< Pseudorange residual of the solution (measured - predicted) [m]. Positive if the local code is late
+
+    Gnss_Vector_Aid() :
+        System(0),
+        PRN(0),
+        Channel_ID(-1),
+        Tracking_timestamp_secs(0.0),
+        Carrier_Doppler_hz(0.0),
+        Code_error_m(0.0)
+    {}
+};
+
+#endif
@@ -258,9 +258,19 @@ void Gps_Ephemeris::satellitePosition(double transmitTime)
     d_satpos_Y = cos(u) * r * sin(Omega) + sin(u) * r * cos(i) * cos(Omega);
     d_satpos_Z = sin(u) * r * sin(i);
 
-    // Satellite's velocity. Can be useful for Vector Tracking loops
+    // Satellite's velocity, from the time derivatives of the orbital elements above
+    double E_dot = n / (1.0 - d_e_eccentricity * cos(E));
+    double phi_dot = sqrt(1.0 - d_e_eccentricity * d_e_eccentricity) * E_dot / (1.0 - d_e_eccentricity * cos(E));
+    double u_dot = phi_dot * (1.0 + 2.0 * (d_Cus * cos(2*phi) - d_Cuc * sin(2*phi)));
+    double r_dot = a * d_e_eccentricity * sin(E) * E_dot + 2.0 * phi_dot * (d_Crs * cos(2*phi) - d_Crc * sin(2*phi));
+    double i_dot = d_IDOT + 2.0 * phi_dot * (d_Cis * cos(2*phi) - d_Cic * sin(2*phi));
     double Omega_dot = d_OMEGA_DOT - OMEGA_EARTH_DOT;
-    d_satvel_X = - Omega_dot * (cos(u) * r + sin(u) * r * cos(i)) + d_satpos_X * cos(Omega) - d_satpos_Y * cos(i) * sin(Omega);
-    d_satvel_Y = Omega_dot * (cos(u) * r * cos(Omega) - sin(u) * r * cos(i) * sin(Omega)) + d_satpos_X * sin(Omega) + d_satpos_Y * cos(i) * cos(Omega);
-    d_satvel_Z = d_satpos_Y * sin(i);
+    // position and velocity in the orbital plane
+    double x_orb = r * cos(u);
+    double y_orb = r * sin(u);
+    double x_orb_dot = r_dot * cos(u) - y_orb * u_dot;
+    double y_orb_dot = r_dot * sin(u) + x_orb * u_dot;
+    d_satvel_X = x_orb_dot * cos(Omega) - y_orb_dot * cos(i) * sin(Omega) + y_orb * sin(i) * sin(Omega) * i_dot - d_satpos_Y * Omega_dot;
+    d_satvel_Y = x_orb_dot * sin(Omega) + y_orb_dot * cos(i) * cos(Omega) - y_orb * sin(i) * cos(Omega) * i_dot + d_satpos_X * Omega_dot;
+    d_satvel_Z = y_orb_dot * sin(i) + y_orb * cos(i) * i_dot;
 }
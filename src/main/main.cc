@@ -62,6 +62,9 @@
 #include "galileo_almanac.h"
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
+#include "gps_ref_location.h"
+#include "gps_ref_time.h"
+#include "gnss_synchro.h"
 #include "sbas_telemetry_data.h"
 #include "sbas_ionospheric_correction.h"
 #include "sbas_satellite_correction.h"
@@ -87,6 +90,14 @@ DECLARE_string(log_dir);
 concurrent_queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
 concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
 
+// Navigation data and last fix, used by the local acquisition assistance
+concurrent_map<Gps_Ephemeris> global_gps_ephemeris_map;
+concurrent_map<Gps_Almanac> global_gps_almanac_map;
+concurrent_map<Galileo_Ephemeris> global_galileo_ephemeris_map;
+concurrent_map<Gps_Ref_Location> global_gps_ref_location_map;
+concurrent_map<Gps_Ref_Time> global_gps_ref_time_map;
+concurrent_map<Gnss_Synchro> global_channel_synchro_map;
+
 int main(int argc, char** argv)
 {
     const std::string intro_help(
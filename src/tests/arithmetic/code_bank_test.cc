@@ -0,0 +1,148 @@
+/*!
+ * \file code_bank_test.cc
+ * \brief  This file implements tests for the bank of packed spreading codes.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <complex>
+#include <vector>
+#include "galileo_e5_signal_processing.h"
+#include "gnss_code_bank.h"
+#include "gps_l2c_signal.h"
+#include "gps_sdr_signal_processing.h"
+
+
+TEST(Gnss_Code_Bank_Test, PackedCodesMatchGenerators)
+{
+    Gnss_Code_Bank& bank = Gnss_Code_Bank::instance();
+    std::vector<std::complex<float>> reference(10230);
+    std::vector<std::complex<float>> expanded(10230);
+
+    for (unsigned int prn = 1; prn <= 138; prn++)
+        {
+            if (prn > 32 && prn < 120)
+                {
+                    EXPECT_EQ(bank.code(GPS_L1_CA_CODE, prn), nullptr);
+                    continue;
+                }
+            gps_l1_ca_code_gen_complex(reference.data(), prn, 4);
+            Gnss_Code_Bank::expand(expanded.data(), bank.code(GPS_L1_CA_CODE, prn), nullptr, 1023, 4, 1.0f);
+            for (unsigned int k = 0; k < 1023; k++)
+                {
+                    ASSERT_EQ(reference[k], expanded[k]) << "L1 C/A PRN " << prn << " chip " << k;
+                }
+        }
+
+    for (unsigned int prn = 1; prn <= 50; prn++)
+        {
+            gps_l2c_m_code_gen_complex(reference.data(), prn);
+            Gnss_Code_Bank::expand(expanded.data(), bank.code(GPS_L2_M_CODE, prn), nullptr, 10230, 0, 1.0f);
+            for (unsigned int k = 0; k < 10230; k++)
+                {
+                    ASSERT_EQ(reference[k], expanded[k]) << "L2 M PRN " << prn << " chip " << k;
+                }
+        }
+
+    char signal[3] = "5X";
+    for (int prn = 1; prn <= 50; prn++)
+        {
+            galileo_e5_a_code_gen_complex_primary(reference.data(), prn, signal);
+            Gnss_Code_Bank::expand(expanded.data(), bank.code(GALILEO_E5A_I_CODE, prn),
+                    bank.code(GALILEO_E5A_Q_CODE, prn), 10230, 0, 1.0f);
+            for (unsigned int k = 0; k < 10230; k++)
+                {
+                    ASSERT_EQ(reference[k], expanded[k]) << "E5a PRN " << prn << " chip " << k;
+                }
+        }
+}
+
+
+TEST(Gnss_Code_Bank_Test, SampledAtIntegerRatio)
+{
+    // Four samples per chip: sample i takes chip floor((i + 1) / 4), or
+    // floor(i / 4) if the chip edges go to the previous chip
+    const uint64_t* code = Gnss_Code_Bank::instance().code(GPS_L1_CA_CODE, 7);
+    std::vector<std::complex<float>> chips(1023);
+    std::vector<std::complex<float>> sampled(4092);
+    Gnss_Code_Bank::expand(chips.data(), code, nullptr, 1023, 0, 1.0f);
+
+    Gnss_Code_Bank::expand_sampled(sampled.data(), code, nullptr, 1023, 1023000, 4092000, 0, 0, 4092, 1.0f);
+    for (unsigned int i = 0; i < 4091; i++)
+        {
+            ASSERT_EQ(sampled[i], chips[std::min((i + 1) / 4, 1022u)]) << "sample " << i;
+        }
+    EXPECT_EQ(sampled[4091], chips[1022]);
+
+    Gnss_Code_Bank::expand_sampled(sampled.data(), code, nullptr, 1023, 1023000, 4092000, 0, 0, 4092, 1.0f, true);
+    for (unsigned int i = 0; i < 4092; i++)
+        {
+            ASSERT_EQ(sampled[i], chips[i / 4]) << "sample " << i;
+        }
+}
+
+
+TEST(Gnss_Code_Bank_Test, MatchesFormerGenerator)
+{
+    // Away from the chip edges, the sampled code is the one of the former
+    // floating point generator
+    const unsigned int fs = 4000000;
+    std::vector<std::complex<float>> chips(1023);
+    std::vector<std::complex<float>> sampled(4000);
+    gps_l1_ca_code_gen_complex(chips.data(), 12, 0);
+    gps_l1_ca_code_gen_complex_sampled(sampled.data(), 12, fs, 0);
+    for (unsigned int i = 0; i < 3999; i++)
+        {
+            double t = static_cast<double>(i + 1) * 1023000.0 / static_cast<double>(fs);
+            ASSERT_EQ(sampled[i], chips[static_cast<unsigned int>(t)]) << "sample " << i;
+        }
+    EXPECT_EQ(sampled[3999], chips[1022]);
+}
+
+
+TEST(Gnss_Code_Bank_Test, SampleTypesAndPartialExpansion)
+{
+    const uint64_t* code = Gnss_Code_Bank::instance().code(GPS_L2_M_CODE, 3);
+    const unsigned int fs = 2600000;
+    const unsigned int samples = Gnss_Code_Bank::samples_per_code(10230, 511500, fs);
+    ASSERT_EQ(samples, 52000u);
+    std::vector<std::complex<float>> full(samples);
+    std::vector<std::complex<float>> parts(samples);
+    std::vector<std::complex<int16_t>> full_16sc(samples);
+    std::vector<std::complex<int8_t>> full_8sc(samples);
+
+    Gnss_Code_Bank::expand_sampled(full.data(), code, nullptr, 10230, 511500, fs, 100, 0, samples, 1.0f);
+    Gnss_Code_Bank::expand_sampled(parts.data(), code, nullptr, 10230, 511500, fs, 100, 0, 12345, 1.0f);
+    Gnss_Code_Bank::expand_sampled(parts.data() + 12345, code, nullptr, 10230, 511500, fs, 100, 12345, samples - 12345, 1.0f);
+    Gnss_Code_Bank::expand_sampled(full_16sc.data(), code, nullptr, 10230, 511500, fs, 100, 0, samples, static_cast<int16_t>(1));
+    Gnss_Code_Bank::expand_sampled(full_8sc.data(), code, nullptr, 10230, 511500, fs, 100, 0, samples, static_cast<int8_t>(1));
+    for (unsigned int i = 0; i < samples; i++)
+        {
+            ASSERT_EQ(full[i], parts[i]) << "sample " << i;
+            ASSERT_EQ(full[i].real(), static_cast<float>(full_16sc[i].real())) << "sample " << i;
+            ASSERT_EQ(full[i].real(), static_cast<float>(full_8sc[i].real())) << "sample " << i;
+            ASSERT_EQ(0, full_8sc[i].imag());
+        }
+}
@@ -33,7 +33,9 @@
 #include <complex>
 #include <thread>
 #include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include "cpu_multicorrelator.h"
+#include "cpu_multicorrelator_8sc.h"
 #include "gps_sdr_signal_processing.h"
 #include "GPS_L1_CA.h"
 
@@ -162,3 +164,124 @@ TEST(CPU_multicorrelator_test, MeasureExecutionTime)
         correlator_pool[n]->free();
     }
 }
+
+
+TEST(CPU_multicorrelator_test, FusedResamplerMatchesResampledCodes)
+{
+    const int code_length = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    const int vector_length = 4093;
+    const int n_taps = 5;
+    float shifts_chips[n_taps] = { -0.6, -0.15, 0.0, 0.15, 0.6 };
+
+    gr_complex* ca_code = static_cast<gr_complex*>(volk_gnsssdr_malloc(code_length * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    gr_complex* in = static_cast<gr_complex*>(volk_gnsssdr_malloc(vector_length * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    gr_complex* corr_out = static_cast<gr_complex*>(volk_gnsssdr_malloc(n_taps * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    gr_complex* corr_ref = static_cast<gr_complex*>(volk_gnsssdr_malloc(n_taps * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    gr_complex** resampled = static_cast<gr_complex**>(volk_gnsssdr_malloc(n_taps * sizeof(gr_complex*), volk_gnsssdr_get_alignment()));
+    for (int n = 0; n < n_taps; n++)
+        {
+            resampled[n] = static_cast<gr_complex*>(volk_gnsssdr_malloc(vector_length * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+        }
+
+    gps_l1_ca_code_gen_complex(ca_code, 7, 0);
+    std::srand(5);
+    for (int n = 0; n < vector_length; n++)
+        {
+            in[n] = gr_complex(static_cast<float>(std::rand()) / RAND_MAX - 0.5, static_cast<float>(std::rand()) / RAND_MAX - 0.5);
+        }
+
+    cpu_multicorrelator correlator;
+    correlator.init(vector_length, n_taps);
+    correlator.set_input_output_vectors(corr_out, in);
+    correlator.set_local_code_and_taps(code_length, ca_code, shifts_chips);
+
+    // Both signs of the code phase step, and a remainder that wraps around the code start
+    float code_phase_steps_chips[2] = { 0.2557, -0.2557 };
+    float rem_code_phase_chips = -0.37;
+    float rem_carrier_phase_rad = 0.4;
+    float carrier_phase_step_rad = 0.0123;
+    for (int k = 0; k < 2; k++)
+        {
+            correlator.Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_rad, carrier_phase_step_rad, rem_code_phase_chips, code_phase_steps_chips[k], vector_length);
+
+            volk_gnsssdr_32fc_xn_resampler_32fc_xn(resampled, ca_code, rem_code_phase_chips, code_phase_steps_chips[k], shifts_chips, code_length, n_taps, vector_length);
+            lv_32fc_t phase = lv_cmake(std::cos(rem_carrier_phase_rad), -std::sin(rem_carrier_phase_rad));
+            volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn(corr_ref, in, std::exp(lv_32fc_t(0, - carrier_phase_step_rad)), &phase, (const lv_32fc_t**)resampled, n_taps, vector_length);
+
+            for (int n = 0; n < n_taps; n++)
+                {
+                    EXPECT_NEAR(corr_out[n].real(), corr_ref[n].real(), 1e-2);
+                    EXPECT_NEAR(corr_out[n].imag(), corr_ref[n].imag(), 1e-2);
+                }
+        }
+
+    correlator.free();
+    for (int n = 0; n < n_taps; n++)
+        {
+            volk_gnsssdr_free(resampled[n]);
+        }
+    volk_gnsssdr_free(resampled);
+    volk_gnsssdr_free(corr_ref);
+    volk_gnsssdr_free(corr_out);
+    volk_gnsssdr_free(in);
+    volk_gnsssdr_free(ca_code);
+}
+
+
+TEST(CPU_multicorrelator_test, Multicorrelator8scMatchesFloat)
+{
+    const int code_length = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    const int vector_length = 4093;
+    const int n_taps = 3;
+    float shifts_chips[n_taps] = { -0.5, 0.0, 0.5 };
+
+    gr_complex* ca_code = static_cast<gr_complex*>(volk_gnsssdr_malloc(code_length * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    lv_8sc_t* ca_code_8sc = static_cast<lv_8sc_t*>(volk_gnsssdr_malloc(code_length * sizeof(lv_8sc_t), volk_gnsssdr_get_alignment()));
+    gr_complex* in = static_cast<gr_complex*>(volk_gnsssdr_malloc(vector_length * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    lv_8sc_t* in_8sc = static_cast<lv_8sc_t*>(volk_gnsssdr_malloc(vector_length * sizeof(lv_8sc_t), volk_gnsssdr_get_alignment()));
+    gr_complex* corr_out = static_cast<gr_complex*>(volk_gnsssdr_malloc(n_taps * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+    gr_complex* corr_ref = static_cast<gr_complex*>(volk_gnsssdr_malloc(n_taps * sizeof(gr_complex), volk_gnsssdr_get_alignment()));
+
+    // 4 bits samples, which the 8 bits path holds exactly
+    gps_l1_ca_code_gen_complex(ca_code, 11, 0);
+    volk_gnsssdr_32fc_convert_8ic(ca_code_8sc, ca_code, code_length);
+    std::srand(7);
+    for (int n = 0; n < vector_length; n++)
+        {
+            in_8sc[n] = lv_8sc_t(std::rand() % 16 - 8, std::rand() % 16 - 8);
+            in[n] = gr_complex(in_8sc[n].real(), in_8sc[n].imag());
+        }
+
+    cpu_multicorrelator correlator;
+    correlator.init(vector_length, n_taps);
+    correlator.set_input_output_vectors(corr_ref, in);
+    correlator.set_local_code_and_taps(code_length, ca_code, shifts_chips);
+
+    cpu_multicorrelator_8sc correlator_8sc;
+    correlator_8sc.init(vector_length, n_taps);
+    correlator_8sc.set_input_output_vectors(corr_out, in_8sc);
+    correlator_8sc.set_local_code_and_taps(code_length, ca_code_8sc, shifts_chips);
+
+    float rem_code_phase_chips = 0.31;
+    float code_phase_step_chips = 0.2557;
+    float rem_carrier_phase_rad = 0.4;
+    float carrier_phase_step_rad = 0.0123;
+    correlator.Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_rad, carrier_phase_step_rad, rem_code_phase_chips, code_phase_step_chips, vector_length);
+    correlator_8sc.Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_rad, carrier_phase_step_rad, rem_code_phase_chips, code_phase_step_chips, vector_length);
+
+    // The 8 bits code replica is scaled to 127. The outputs are in the hundreds
+    for (int n = 0; n < n_taps; n++)
+        {
+            EXPECT_NEAR(corr_out[n].real() / 127.0, corr_ref[n].real(), 1e-1);
+            EXPECT_NEAR(corr_out[n].imag() / 127.0, corr_ref[n].imag(), 1e-1);
+        }
+
+    correlator.free();
+    correlator_8sc.free();
+    volk_gnsssdr_free(corr_ref);
+    volk_gnsssdr_free(corr_out);
+    volk_gnsssdr_free(in_8sc);
+    volk_gnsssdr_free(in);
+    volk_gnsssdr_free(ca_code_8sc);
+    volk_gnsssdr_free(ca_code);
+}
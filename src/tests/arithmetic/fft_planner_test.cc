@@ -0,0 +1,161 @@
+/*!
+ * \file fft_planner_test.cc
+ * \brief  This file implements tests for the selection of FFT lengths
+ * in acquisition.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <complex>
+#include <cstdlib>
+#include <vector>
+#include <gnuradio/fft/fft.h>
+#include "gnss_fft_planner.h"
+#include "gnss_signal_processing.h"
+
+
+TEST(FFT_Planner_Test, SmoothLengths)
+{
+    EXPECT_TRUE(Gnss_Fft_Planner::is_smooth(4000));
+    EXPECT_TRUE(Gnss_Fft_Planner::is_smooth(10368));
+    EXPECT_FALSE(Gnss_Fft_Planner::is_smooth(4093)); // prime
+    EXPECT_FALSE(Gnss_Fft_Planner::is_smooth(4725 * 11));
+    EXPECT_EQ(Gnss_Fft_Planner::largest_prime_factor(2 * 4093), 4093u);
+    EXPECT_EQ(Gnss_Fft_Planner::next_smooth(4093), 4096u);
+    EXPECT_EQ(Gnss_Fft_Planner::next_smooth(4001), 4032u);
+    EXPECT_EQ(Gnss_Fft_Planner::next_power_of_two(5000), 8192u);
+    EXPECT_EQ(Gnss_Fft_Planner::next_power_of_two(8192), 8192u);
+}
+
+
+TEST(FFT_Planner_Test, PlanSelection)
+{
+    // Off: the snapshot length is kept
+    Gnss_Fft_Plan plan = Gnss_Fft_Planner::plan(4093, false, "off");
+    EXPECT_EQ(plan.strategy, FFT_STRATEGY_DIRECT);
+    EXPECT_EQ(plan.fft_size, 4093u);
+
+    // Fast lengths are kept
+    plan = Gnss_Fft_Planner::plan(4000, false, "estimate");
+    EXPECT_EQ(plan.strategy, FFT_STRATEGY_DIRECT);
+    EXPECT_EQ(plan.fft_size, 4000u);
+
+    // A prime length is resampled for circular correlation...
+    plan = Gnss_Fft_Planner::plan(4093, false, "estimate");
+    EXPECT_EQ(plan.strategy, FFT_STRATEGY_RESAMPLE);
+    EXPECT_TRUE(Gnss_Fft_Planner::is_smooth(plan.fft_size));
+    EXPECT_GE(plan.fft_size, 4093u);
+    EXPECT_LT(plan.cost, plan.direct_cost);
+
+    // ... and zero-padded for linear correlation
+    plan = Gnss_Fft_Planner::plan(2 * 4093, true, "estimate");
+    EXPECT_EQ(plan.strategy, FFT_STRATEGY_ZERO_PAD);
+    EXPECT_TRUE(Gnss_Fft_Planner::is_smooth(plan.fft_size));
+    EXPECT_GE(plan.fft_size, 2u * 4093u);
+    std::cout << "Plan for 8186 samples: " << plan.to_string() << std::endl;
+}
+
+
+TEST(FFT_Planner_Test, ZeroPaddedLinearCorrelation)
+{
+    // Same buffer layout as pcps_acquisition_cc with bit_transition_flag:
+    // two code periods of signal, [0 ... 0 code] as the replica, and the
+    // correlation read from the middle of the output.
+    const unsigned int code_size = 1021;
+    const unsigned int input_size = 2 * code_size;
+    const unsigned int delay = 300;
+    Gnss_Fft_Plan plan = Gnss_Fft_Planner::plan(input_size, true, "estimate");
+    ASSERT_EQ(plan.strategy, FFT_STRATEGY_ZERO_PAD);
+    unsigned int fft_size = plan.fft_size;
+
+    std::vector<gr_complex> code(code_size);
+    std::srand(1);
+    for (unsigned int i = 0; i < code_size; i++)
+        {
+            code[i] = gr_complex((std::rand() % 2) ? 1.0 : -1.0, 0.0);
+        }
+    std::vector<gr_complex> signal(input_size);
+    for (unsigned int i = 0; i < input_size; i++)
+        {
+            signal[i] = code[(i + code_size - delay) % code_size];
+        }
+
+    gr::fft::fft_complex fft(fft_size, true);
+    gr::fft::fft_complex ifft(fft_size, false);
+    std::vector<gr_complex> code_spectrum(fft_size);
+    std::fill_n(fft.get_inbuf(), fft_size - code_size, gr_complex(0.0, 0.0));
+    std::copy(code.begin(), code.end(), fft.get_inbuf() + fft_size - code_size);
+    fft.execute();
+    for (unsigned int i = 0; i < fft_size; i++)
+        {
+            code_spectrum[i] = std::conj(fft.get_outbuf()[i]);
+        }
+    std::copy(signal.begin(), signal.end(), fft.get_inbuf());
+    std::fill_n(fft.get_inbuf() + input_size, fft_size - input_size, gr_complex(0.0, 0.0));
+    fft.execute();
+    for (unsigned int i = 0; i < fft_size; i++)
+        {
+            ifft.get_inbuf()[i] = fft.get_outbuf()[i] * code_spectrum[i];
+        }
+    ifft.execute();
+
+    // Compare with the linear correlation computed in the time domain
+    for (unsigned int lag = 0; lag < code_size; lag += 7)
+        {
+            gr_complex expected(0.0, 0.0);
+            for (unsigned int n = 0; n < code_size; n++)
+                {
+                    expected += signal[n + lag] * std::conj(code[n]);
+                }
+            gr_complex result = ifft.get_outbuf()[code_size + lag] / static_cast<float>(fft_size);
+            EXPECT_NEAR(result.real(), expected.real(), 1e-2);
+            EXPECT_NEAR(result.imag(), expected.imag(), 1e-2);
+        }
+    EXPECT_NEAR(std::abs(ifft.get_outbuf()[code_size + delay]) / static_cast<float>(fft_size), static_cast<float>(code_size), 1e-2);
+}
+
+
+TEST(FFT_Planner_Test, LinearResampler)
+{
+    const unsigned int length_in = 100;
+    const unsigned int length_out = 128;
+    std::vector<gr_complex> in(length_in);
+    std::vector<gr_complex> out(length_out);
+    for (unsigned int i = 0; i < length_in; i++)
+        {
+            in[i] = gr_complex(static_cast<float>(i), -2.0 * static_cast<float>(i));
+        }
+    linear_resampler(in.data(), out.data(), length_in, length_out);
+    // A ramp is reproduced exactly, except past the last input sample
+    for (unsigned int i = 0; i < length_out; i++)
+        {
+            float t = static_cast<float>(i) * static_cast<float>(length_in) / static_cast<float>(length_out);
+            if (t <= static_cast<float>(length_in - 1))
+                {
+                    EXPECT_NEAR(out[i].real(), t, 1e-3);
+                    EXPECT_NEAR(out[i].imag(), -2.0 * t, 1e-3);
+                }
+        }
+}
@@ -0,0 +1,143 @@
+/*!
+ * \file gnss_fft_test.cc
+ * \brief  This file implements tests for the shared FFT plans.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <gnuradio/fft/fft.h>
+#include "gnss_fft.h"
+
+
+TEST(Gnss_Fft_Test, MatchesGnuRadioFft)
+{
+    const unsigned int size = 1000;
+    Gnss_Fft fft(size, true);
+    gr::fft::fft_complex reference(size, true);
+    std::srand(1);
+    for (unsigned int i = 0; i < size; i++)
+        {
+            gr_complex x(static_cast<float>(std::rand()) / RAND_MAX - 0.5, static_cast<float>(std::rand()) / RAND_MAX - 0.5);
+            fft.get_inbuf()[i] = x;
+            reference.get_inbuf()[i] = x;
+        }
+    fft.execute();
+    reference.execute();
+    for (unsigned int i = 0; i < size; i++)
+        {
+            EXPECT_NEAR(fft.get_outbuf()[i].real(), reference.get_outbuf()[i].real(), 1e-3);
+            EXPECT_NEAR(fft.get_outbuf()[i].imag(), reference.get_outbuf()[i].imag(), 1e-3);
+        }
+}
+
+
+TEST(Gnss_Fft_Test, ForwardBackwardRoundTrip)
+{
+    const unsigned int size = 1536;
+    Gnss_Fft fft(size, true);
+    Gnss_Fft ifft(size, false);
+    for (unsigned int i = 0; i < size; i++)
+        {
+            fft.get_inbuf()[i] = gr_complex(std::cos(0.01 * i), std::sin(0.03 * i));
+        }
+    fft.execute();
+    std::copy(fft.get_outbuf(), fft.get_outbuf() + size, ifft.get_inbuf());
+    ifft.execute();
+    for (unsigned int i = 0; i < size; i++)
+        {
+            EXPECT_NEAR(ifft.get_outbuf()[i].real() / size, fft.get_inbuf()[i].real(), 1e-4);
+            EXPECT_NEAR(ifft.get_outbuf()[i].imag() / size, fft.get_inbuf()[i].imag(), 1e-4);
+        }
+}
+
+
+TEST(Gnss_Fft_Test, PlansAreShared)
+{
+    Gnss_Fft_Registry& registry = Gnss_Fft_Registry::instance();
+    unsigned int created = registry.plans_created();
+    unsigned int reused = registry.plans_reused();
+
+    Gnss_Fft first(1234, true);
+    EXPECT_EQ(registry.plans_created(), created + 1);
+
+    // Same transform: the plan is reused, but each executor has its own buffers
+    Gnss_Fft second(1234, true);
+    EXPECT_EQ(registry.plans_created(), created + 1);
+    EXPECT_EQ(registry.plans_reused(), reused + 1);
+    EXPECT_NE(first.get_inbuf(), second.get_inbuf());
+
+    // The direction is part of the key
+    Gnss_Fft third(1234, false);
+    EXPECT_EQ(registry.plans_created(), created + 2);
+
+    first.get_inbuf()[1] = gr_complex(1.0, 0.0);
+    second.get_inbuf()[2] = gr_complex(1.0, 0.0);
+    first.execute();
+    second.execute();
+    EXPECT_NE(first.get_outbuf()[1], second.get_outbuf()[1]);
+}
+
+
+TEST(Gnss_Fft_Test, ReleasePlans)
+{
+    Gnss_Fft_Registry& registry = Gnss_Fft_Registry::instance();
+    {
+        Gnss_Fft fft(2048, true);
+        // The plan is in use
+        EXPECT_FALSE(registry.release_plans());
+        EXPECT_GT(registry.plans_created(), 0);
+    }
+    EXPECT_TRUE(registry.release_plans());
+    EXPECT_EQ(0, registry.plans_created());
+
+    // The registry keeps working after the release
+    Gnss_Fft fft(2048, true);
+    fft.get_inbuf()[0] = gr_complex(1.0, 0.0);
+    fft.execute();
+    EXPECT_NEAR(1.0, fft.get_outbuf()[7].real(), 1e-6);
+}
+
+
+TEST(Gnss_Fft_Test, WisdomFile)
+{
+    std::string filename = "./gnss_fft_test_wisdom";
+    std::remove(filename.c_str());
+    Gnss_Fft_Registry& registry = Gnss_Fft_Registry::instance();
+    registry.configure(filename, "estimate");
+    EXPECT_EQ(registry.wisdom_filename(), filename);
+    {
+        Gnss_Fft fft(4321, true);
+    }
+    EXPECT_TRUE(registry.save_wisdom());
+    std::ifstream file(filename.c_str());
+    EXPECT_TRUE(file.is_open());
+    file.close();
+    std::remove(filename.c_str());
+    registry.configure("", "measure");
+}
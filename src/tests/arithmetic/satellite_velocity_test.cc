@@ -0,0 +1,155 @@
+/*!
+ * \file satellite_velocity_test.cc
+ * \brief  This file implements tests for the satellite velocities computed
+ * from the broadcast ephemerides.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include "galileo_ephemeris.h"
+#include "gps_ephemeris.h"
+#include "GPS_L1_CA.h"
+
+namespace
+{
+// Broadcast ephemeris of GPS PRN 1 (values of the order of a real one)
+Gps_Ephemeris gps_test_ephemeris()
+{
+    Gps_Ephemeris eph;
+    eph.i_satellite_PRN = 1;
+    eph.d_sqrt_A = 5153.65;
+    eph.d_e_eccentricity = 0.0107;
+    eph.d_i_0 = 0.9716;
+    eph.d_OMEGA0 = -2.2;
+    eph.d_OMEGA = 0.63;
+    eph.d_M_0 = 1.5;
+    eph.d_Delta_n = 4.5e-9;
+    eph.d_OMEGA_DOT = -8.1e-9;
+    eph.d_IDOT = 2.0e-10;
+    eph.d_Cuc = -1.5e-6;
+    eph.d_Cus = 8.3e-6;
+    eph.d_Crc = 220.0;
+    eph.d_Crs = -28.0;
+    eph.d_Cic = 5.0e-8;
+    eph.d_Cis = -1.2e-7;
+    eph.d_Toe = 345600.0;
+    return eph;
+}
+
+void gps_position(Gps_Ephemeris& eph, double t, double* pos)
+{
+    eph.satellitePosition(t);
+    pos[0] = eph.d_satpos_X;
+    pos[1] = eph.d_satpos_Y;
+    pos[2] = eph.d_satpos_Z;
+}
+
+double range(const double* sat, const double* rx)
+{
+    return std::sqrt((sat[0] - rx[0]) * (sat[0] - rx[0]) + (sat[1] - rx[1]) * (sat[1] - rx[1]) + (sat[2] - rx[2]) * (sat[2] - rx[2]));
+}
+}
+
+
+TEST(Satellite_Velocity_Test, GpsVelocityMatchesPositions)
+{
+    Gps_Ephemeris eph = gps_test_ephemeris();
+    const double dt = 0.5;
+    for (double t = 345600.0 - 7200.0; t <= 345600.0 + 7200.0; t += 1800.0)
+        {
+            double before[3];
+            double after[3];
+            gps_position(eph, t - dt, before);
+            gps_position(eph, t + dt, after);
+            eph.satellitePosition(t);
+            double vel[3] = {eph.d_satvel_X, eph.d_satvel_Y, eph.d_satvel_Z};
+            // Earth-fixed velocity of a GPS satellite: a few km/s
+            double speed = std::sqrt(vel[0] * vel[0] + vel[1] * vel[1] + vel[2] * vel[2]);
+            EXPECT_GT(speed, 1000.0);
+            EXPECT_LT(speed, 4500.0);
+            for (int k = 0; k < 3; k++)
+                {
+                    EXPECT_NEAR((after[k] - before[k]) / (2.0 * dt), vel[k], 1e-3) << "axis " << k << " at " << t;
+                }
+        }
+}
+
+
+TEST(Satellite_Velocity_Test, GpsDoppler)
+{
+    // Static receiver: the Doppler is the range rate along the line of sight
+    Gps_Ephemeris eph = gps_test_ephemeris();
+    const double rx[3] = {4789000.0, 176000.0, 4195000.0};
+    const double t = 346000.0;
+    const double dt = 0.5;
+    double before[3];
+    double after[3];
+    double sat[3];
+    gps_position(eph, t - dt, before);
+    gps_position(eph, t + dt, after);
+    gps_position(eph, t, sat);
+    double rho = range(sat, rx);
+    double range_rate = (eph.d_satvel_X * (sat[0] - rx[0]) + eph.d_satvel_Y * (sat[1] - rx[1]) + eph.d_satvel_Z * (sat[2] - rx[2])) / rho;
+    EXPECT_NEAR((range(after, rx) - range(before, rx)) / (2.0 * dt), range_rate, 1e-3);
+    // The line of sight range rate of a GPS satellite stays below its orbital speed
+    double doppler_hz = -range_rate * GPS_L1_FREQ_HZ / GPS_C_m_s;
+    EXPECT_LT(std::abs(doppler_hz), 20000.0);
+}
+
+
+TEST(Satellite_Velocity_Test, GalileoVelocityMatchesPositions)
+{
+    Galileo_Ephemeris eph;
+    eph.A_1 = 5440.6;
+    eph.e_1 = 0.0003;
+    eph.i_0_2 = 0.9599;
+    eph.OMEGA_0_2 = 1.1;
+    eph.omega_2 = -0.5;
+    eph.M0_1 = 2.3;
+    eph.delta_n_3 = 3.0e-9;
+    eph.OMEGA_dot_3 = -5.6e-9;
+    eph.iDot_2 = -1.0e-10;
+    eph.C_uc_3 = 2.0e-6;
+    eph.C_us_3 = 6.0e-6;
+    eph.C_rc_3 = 190.0;
+    eph.C_rs_3 = 40.0;
+    eph.C_ic_4 = -3.0e-8;
+    eph.C_is_4 = 4.0e-8;
+    eph.t0e_1 = 432000.0;
+    const double dt = 0.5;
+    for (double t = 432000.0 - 7200.0; t <= 432000.0 + 7200.0; t += 1800.0)
+        {
+            eph.satellitePosition(t - dt);
+            double before[3] = {eph.d_satpos_X, eph.d_satpos_Y, eph.d_satpos_Z};
+            eph.satellitePosition(t + dt);
+            double after[3] = {eph.d_satpos_X, eph.d_satpos_Y, eph.d_satpos_Z};
+            eph.satellitePosition(t);
+            EXPECT_NEAR((after[0] - before[0]) / (2.0 * dt), eph.d_satvel_X, 1e-3);
+            EXPECT_NEAR((after[1] - before[1]) / (2.0 * dt), eph.d_satvel_Y, 1e-3);
+            EXPECT_NEAR((after[2] - before[2]) / (2.0 * dt), eph.d_satvel_Z, 1e-3);
+        }
+}
@@ -0,0 +1,94 @@
+/*!
+ * \file tracking_kalman_filter_test.cc
+ * \brief  This file implements tests for the Kalman filter tracking loop.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include "tracking_kalman_filter.h"
+
+namespace
+{
+// Closes the loop on a noise free carrier of constant Doppler and code offset
+void run_kalman_loop(Tracking_Kalman_filter& kf, double doppler_hz, double nco_doppler_hz, double code_chips,
+        int epochs, double T, double& phase_error_cycles, double& nco_code_chips)
+{
+    double true_phase = 0.3;
+    double nco_phase = 0.0;
+    nco_code_chips = 0.0;
+    for (int k = 0; k < epochs; k++)
+        {
+            // Phase error averaged over the integration interval
+            double error = true_phase - nco_phase + (doppler_hz - nco_doppler_hz) * T / 2.0;
+            double carrier_error_cycles = std::atan(std::tan(2.0 * M_PI * error)) / (2.0 * M_PI);
+            kf.update(carrier_error_cycles, code_chips - nco_code_chips);
+            true_phase += doppler_hz * T;
+            nco_phase += nco_doppler_hz * T;
+            nco_doppler_hz = kf.get_nco_doppler_hz();
+            nco_code_chips += kf.get_code_correction_chips();
+        }
+    phase_error_cycles = true_phase - nco_phase;
+    phase_error_cycles -= std::round(phase_error_cycles * 2.0) / 2.0;
+}
+}
+
+
+TEST(TrackingKalmanFilterTest, ConvergesToConstantDoppler)
+{
+    const double T = 0.001;
+    Tracking_Kalman_filter kf(T);
+    kf.initialize(1020.0, 50.0);
+    kf.set_cn0(45.0);
+    double phase_error_cycles;
+    double nco_code_chips;
+    run_kalman_loop(kf, 1000.0, 1020.0, 0.1, 2000, T, phase_error_cycles, nco_code_chips);
+
+    EXPECT_NEAR(kf.get_doppler_hz(), 1000.0, 0.1);
+    EXPECT_NEAR(kf.get_doppler_rate_hz_s(), 0.0, 1.0);
+    EXPECT_NEAR(phase_error_cycles, 0.0, 0.01);
+    EXPECT_NEAR(nco_code_chips, 0.1, 0.005);
+}
+
+
+TEST(TrackingKalmanFilterTest, GainsFollowCn0)
+{
+    const double T = 0.001;
+    Tracking_Kalman_filter strong(T);
+    Tracking_Kalman_filter weak(T);
+    strong.initialize(1000.0, 50.0);
+    weak.initialize(1000.0, 50.0);
+    strong.set_cn0(50.0);
+    weak.set_cn0(25.0);
+    double phase_error_cycles;
+    double nco_code_chips;
+    run_kalman_loop(strong, 1000.0, 1000.0, 0.0, 1000, T, phase_error_cycles, nco_code_chips);
+    run_kalman_loop(weak, 1000.0, 1000.0, 0.0, 1000, T, phase_error_cycles, nco_code_chips);
+
+    // A weaker signal weights the model more, and the carrier phase is known with less certainty
+    EXPECT_GT(weak.get_carrier_phase_std_cycles(), strong.get_carrier_phase_std_cycles());
+    EXPECT_LT(strong.get_carrier_phase_std_cycles(), 0.05);
+}
@@ -0,0 +1,142 @@
+/*!
+ * \file tracking_lock_detector_test.cc
+ * \brief  This file implements tests for the streaming C/N0 estimator and
+ * lock detector of the tracking blocks.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "lock_detectors.h"
+#include "tracking_lock_detector.h"
+
+namespace
+{
+// Prompts of a BPSK signal of amplitude a, with random data bits every 20 prompts,
+// a residual carrier phase of phase0 + 2 pi f k T, and complex Gaussian noise
+// of standard deviation sigma per component
+std::vector<gr_complex> make_prompts(int length, double a, double sigma, double phase0, double f_hz, double T)
+{
+    std::mt19937 gen(1234);
+    std::normal_distribution<double> noise(0.0, sigma);
+    std::bernoulli_distribution bit(0.5);
+    std::vector<gr_complex> prompts(length);
+    double sign = 1.0;
+    for (int k = 0; k < length; k++)
+        {
+            if (k % 20 == 0) sign = bit(gen) ? 1.0 : -1.0;
+            double phase = phase0 + 2.0 * M_PI * f_hz * k * T;
+            prompts[k] = gr_complex(static_cast<float>(sign * a * std::cos(phase) + noise(gen)),
+                    static_cast<float>(sign * a * std::sin(phase) + noise(gen)));
+        }
+    return prompts;
+}
+}
+
+
+TEST(TrackingLockDetectorTest, MatchesBufferedEstimators)
+{
+    const int window = 20;
+    const long fs_in = 4000000;
+    const double code_length = 1023.0;
+    std::vector<gr_complex> prompts = make_prompts(window, 100.0, 30.0, 0.2, 0.0, 0.001);
+
+    Tracking_Lock_Detector detector(window);
+    detector.set_integration(fs_in, code_length);
+    for (int k = 0; k < window - 1; k++)
+        {
+            EXPECT_FALSE(detector.update(prompts[k]));
+        }
+    EXPECT_TRUE(detector.update(prompts[window - 1]));
+
+    EXPECT_NEAR(detector.get_cn0_snv_db_hz(), cn0_svn_estimator(prompts.data(), window, fs_in, code_length), 1e-3);
+    EXPECT_NEAR(detector.get_carrier_lock_test(), carrier_lock_detector(prompts.data(), window), 1e-4);
+}
+
+
+TEST(TrackingLockDetectorTest, EstimatesCn0)
+{
+    const int window = 2000;
+    const long fs_in = 4000000;
+    const double code_length = 1023.0;
+    const double a = 1.0;
+    const double sigma = 0.5;  // SNR = a^2 / (2 sigma^2) = 2
+    const double cn0_db_hz = 10.0 * std::log10(2.0) + 10.0 * std::log10(fs_in / 2.0) - 10.0 * std::log10(code_length);
+    std::vector<gr_complex> prompts = make_prompts(window, a, sigma, 0.0, 0.0, 0.001);
+
+    Tracking_Lock_Detector detector(window);
+    detector.set_integration(fs_in, code_length);
+    for (int k = 0; k < window; k++)
+        {
+            detector.update(prompts[k]);
+        }
+    EXPECT_NEAR(detector.get_cn0_snv_db_hz(), cn0_db_hz, 0.5);
+    EXPECT_NEAR(detector.get_cn0_m2m4_db_hz(), cn0_db_hz, 0.5);
+    EXPECT_TRUE(detector.code_lock());
+    EXPECT_TRUE(detector.carrier_lock());
+    EXPECT_TRUE(detector.fll_lock());
+}
+
+
+TEST(TrackingLockDetectorTest, FlagsCycleSlip)
+{
+    const int window = 20;
+    const double T = 0.001;
+    Tracking_Lock_Detector detector(window);
+    detector.set_integration(4000000, 1023.0);
+
+    // Locked window
+    std::vector<gr_complex> prompts = make_prompts(window, 100.0, 5.0, 0.0, 0.0, T);
+    for (int k = 0; k < window; k++)
+        {
+            detector.update(prompts[k]);
+        }
+    EXPECT_TRUE(detector.carrier_lock());
+    EXPECT_FALSE(detector.cycle_slip());
+
+    // The phase slips a quarter of a cycle within the next window, slowly enough for the frequency lock to hold
+    prompts = make_prompts(window, 100.0, 5.0, 0.0, 12.5, T);
+    for (int k = 0; k < window; k++)
+        {
+            detector.update(prompts[k]);
+        }
+    EXPECT_FALSE(detector.carrier_lock());
+    EXPECT_TRUE(detector.fll_lock());
+    EXPECT_TRUE(detector.cycle_slip());
+
+    // A carrier far from the replica frequency is not frequency locked
+    detector.reset();
+    prompts = make_prompts(window, 100.0, 5.0, 0.0, 200.0, T);
+    for (int k = 0; k < window; k++)
+        {
+            detector.update(prompts[k]);
+        }
+    EXPECT_FALSE(detector.fll_lock());
+    EXPECT_FALSE(detector.cycle_slip());
+}
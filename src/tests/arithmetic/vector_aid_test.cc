@@ -0,0 +1,206 @@
+/*!
+ * \file vector_aid_test.cc
+ * \brief Tests the receiver velocity, clock drift and vector tracking aids
+ * computed by the GPS L1 C/A least squares PVT solver
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+#include <armadillo>
+#include <gtest/gtest.h>
+#include "gps_l1_ca_ls_pvt.h"
+#include "gnss_synchro.h"
+#include "gps_ephemeris.h"
+#include "GPS_L1_CA.h"
+
+namespace
+{
+const double vector_aid_rx_time = 346000.0;
+const double vector_aid_rx_pos[3] = {4789000.0, 176000.0, 4195000.0}; // ECEF [m]
+const double vector_aid_rx_vel[3] = {12.0, -7.0, 3.0};                // ECEF [m/s]
+const double vector_aid_rx_clock_bias_m = 3000.0;
+const double vector_aid_rx_clock_drift_m_s = 45.0;
+
+// Synthetic GPS satellite, spread over the orbital planes with the PRN
+Gps_Ephemeris vector_aid_ephemeris(unsigned int prn)
+{
+    Gps_Ephemeris eph;
+    eph.i_satellite_PRN = prn;
+    eph.d_sqrt_A = 5153.65;
+    eph.d_e_eccentricity = 0.0107;
+    eph.d_i_0 = 0.9716;
+    eph.d_OMEGA0 = -3.0 + static_cast<double>(prn % 6);
+    eph.d_OMEGA = 0.63;
+    eph.d_M_0 = 0.8 * static_cast<double>(prn / 6);
+    eph.d_OMEGA_DOT = -8.1e-9;
+    eph.d_Toe = 345600.0;
+    eph.d_Toc = 345600.0;
+    eph.d_A_f0 = 1.0e-5 * static_cast<double>(prn % 3);
+    eph.d_A_f1 = 1.0e-12;
+    return eph;
+}
+
+/*
+ * Observables of the receiver, built with the model of the solver: the satellite
+ * position is computed at the transmit time derived from the pseudorange, and
+ * rotated with the Earth during the travel time, and the troposphere is added.
+ * The Doppler is the range rate along the line of sight plus the clock drift.
+ * Only the satellites above 15 degrees of elevation are kept.
+ */
+void vector_aid_observables(gps_l1_ca_ls_pvt& pvt, std::map<int, Gnss_Synchro>& observables, std::map<int, double>& doppler_hz)
+{
+    const double lambda_m = GPS_C_m_s / GPS_L1_FREQ_HZ;
+    arma::vec rx = arma::zeros(3);
+    for (int k = 0; k < 3; k++) rx(k) = vector_aid_rx_pos[k];
+    double lat;
+    double lon;
+    double height;
+    pvt.togeod(&lat, &lon, &height, 6378137.0, 298.257223563, rx(0), rx(1), rx(2));
+
+    for (unsigned int prn = 1; prn <= 32; prn++)
+        {
+            Gps_Ephemeris eph = vector_aid_ephemeris(prn);
+            double pseudorange_m = 0.075 * GPS_C_m_s;
+            double az = 0.0;
+            double el = 0.0;
+            double distance = 0.0;
+            arma::vec sat = arma::zeros(3);
+            arma::vec sat_vel = arma::zeros(3);
+            for (int iter = 0; iter < 5; iter++)
+                {
+                    double tx_time = vector_aid_rx_time - pseudorange_m / GPS_C_m_s;
+                    double sv_clock_bias_s = eph.sv_clock_drift(tx_time);
+                    eph.satellitePosition(tx_time - sv_clock_bias_s);
+                    sat(0) = eph.d_satpos_X;
+                    sat(1) = eph.d_satpos_Y;
+                    sat(2) = eph.d_satpos_Z;
+                    sat_vel(0) = eph.d_satvel_X;
+                    sat_vel(1) = eph.d_satvel_Y;
+                    sat_vel(2) = eph.d_satvel_Z;
+                    double traveltime = arma::norm(sat - rx, 2) / GPS_C_m_s;
+                    arma::vec rot_sat = pvt.rotateSatellite(traveltime, sat);
+                    pvt.topocent(&az, &el, &distance, rx, rot_sat - rx);
+                    double trop = 0.0;
+                    pvt.tropo(&trop, sin(el * GPS_PI / 180.0), height / 1000.0, 1013.0, 293.0, 50.0, 0.0, 0.0, 0.0);
+                    double corrected_m = arma::norm(rot_sat - rx, 2) + vector_aid_rx_clock_bias_m + trop;
+                    pseudorange_m = corrected_m - sv_clock_bias_s * GPS_C_m_s;
+                }
+            if (el < 15.0) continue;
+
+            arma::vec los = (sat - rx) / arma::norm(sat - rx, 2);
+            double range_rate = 0.0;
+            for (int k = 0; k < 3; k++) range_rate += (sat_vel(k) - vector_aid_rx_vel[k]) * los(k);
+
+            Gnss_Synchro synchro = Gnss_Synchro();
+            synchro.System = 'G';
+            synchro.PRN = prn;
+            synchro.Channel_ID = observables.size();
+            synchro.Tracking_timestamp_secs = 12.5;
+            synchro.CN0_dB_hz = 45.0;
+            synchro.Pseudorange_m = pseudorange_m;
+            synchro.Carrier_Doppler_hz = -(range_rate + vector_aid_rx_clock_drift_m_s) / lambda_m;
+            synchro.Flag_valid_pseudorange = true;
+            observables[prn] = synchro;
+            doppler_hz[prn] = synchro.Carrier_Doppler_hz;
+            pvt.gps_ephemeris_map[prn] = vector_aid_ephemeris(prn);
+        }
+}
+}
+
+
+TEST(Vector_Aid_Test, VelocityAndClockDrift)
+{
+    gps_l1_ca_ls_pvt pvt(12, "", false);
+    std::map<int, Gnss_Synchro> observables;
+    std::map<int, double> doppler_hz;
+    vector_aid_observables(pvt, observables, doppler_hz);
+    ASSERT_GE(observables.size(), 6);
+
+    ASSERT_TRUE(pvt.get_PVT(observables, vector_aid_rx_time, false));
+    EXPECT_NEAR(vector_aid_rx_pos[0], pvt.d_x_m, 0.01);
+    EXPECT_NEAR(vector_aid_rx_pos[1], pvt.d_y_m, 0.01);
+    EXPECT_NEAR(vector_aid_rx_pos[2], pvt.d_z_m, 0.01);
+    for (int k = 0; k < 3; k++)
+        {
+            EXPECT_NEAR(vector_aid_rx_vel[k], pvt.d_rx_vel_m_s[k], 1e-3) << "axis " << k;
+        }
+    EXPECT_NEAR(vector_aid_rx_clock_drift_m_s, pvt.d_rx_clock_drift_m_s, 1e-3);
+
+    // One aid per channel, addressed to it and predicting its Doppler
+    ASSERT_EQ(observables.size(), pvt.d_vector_aids.size());
+    for (unsigned int k = 0; k < pvt.d_vector_aids.size(); k++)
+        {
+            const Gnss_Vector_Aid& aid = pvt.d_vector_aids.at(k);
+            const Gnss_Synchro& synchro = observables.at(aid.PRN);
+            EXPECT_EQ('G', aid.System);
+            EXPECT_EQ(synchro.Channel_ID, aid.Channel_ID);
+            EXPECT_DOUBLE_EQ(synchro.Tracking_timestamp_secs, aid.Tracking_timestamp_secs);
+            EXPECT_NEAR(doppler_hz.at(aid.PRN), aid.Carrier_Doppler_hz, 0.01) << "PRN " << aid.PRN;
+            EXPECT_NEAR(0.0, aid.Code_error_m, 0.01) << "PRN " << aid.PRN;
+        }
+}
+
+
+TEST(Vector_Aid_Test, CodeErrorAndUnusedChannels)
+{
+    gps_l1_ca_ls_pvt pvt(12, "", false);
+    std::map<int, Gnss_Synchro> observables;
+    std::map<int, double> doppler_hz;
+    vector_aid_observables(pvt, observables, doppler_hz);
+    ASSERT_GE(observables.size(), 6);
+
+    // A channel whose local code is 30 m late, and a channel without ephemeris
+    std::map<int, Gnss_Synchro>::iterator it = observables.begin();
+    unsigned int late_prn = it->first;
+    it->second.Pseudorange_m += 30.0;
+    it++;
+    unsigned int unused_prn = it->first;
+    pvt.gps_ephemeris_map.erase(unused_prn);
+
+    ASSERT_TRUE(pvt.get_PVT(observables, vector_aid_rx_time, false));
+    ASSERT_EQ(observables.size() - 1, pvt.d_vector_aids.size());
+    double late_error_m = 0.0;
+    double largest_other_error_m = 0.0;
+    for (unsigned int k = 0; k < pvt.d_vector_aids.size(); k++)
+        {
+            const Gnss_Vector_Aid& aid = pvt.d_vector_aids.at(k);
+            EXPECT_NE(unused_prn, aid.PRN);
+            if (aid.PRN == late_prn)
+                {
+                    late_error_m = aid.Code_error_m;
+                }
+            else
+                {
+                    largest_other_error_m = std::max(largest_other_error_m, std::abs(aid.Code_error_m));
+                }
+        }
+    EXPECT_GT(late_error_m, 5.0);
+    EXPECT_LT(largest_other_error_m, late_error_m);
+}
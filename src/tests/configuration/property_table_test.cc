@@ -0,0 +1,111 @@
+/*!
+ * \file property_table_test.cc
+ * \brief  This file implements tests for the typed configuration properties.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "file_configuration.h"
+#include "property_table.h"
+
+
+TEST(Property_Table_Test, TypedValues)
+{
+    Property_Table table;
+    table.set("Foo.count", "12");
+    table.set("Foo.ratio", "0.25");
+    table.set("Foo.flag", "true");
+    table.set("Foo.name", "File_Signal_Source");
+    table.set("Foo.negative", "-3");
+
+    EXPECT_EQ(table.get("Foo.count", 0), 12);
+    EXPECT_EQ(table.get("Foo.count", 0u), 12u);
+    EXPECT_EQ(table.get("Foo.count", 0L), 12L);
+    EXPECT_EQ(table.get("Foo.count", static_cast<unsigned short>(0)), 12);
+    EXPECT_DOUBLE_EQ(table.get("Foo.ratio", 0.0), 0.25);
+    EXPECT_FLOAT_EQ(table.get("Foo.ratio", 0.0f), 0.25f);
+    EXPECT_TRUE(table.get("Foo.flag", false));
+    EXPECT_EQ(table.get("Foo.name", std::string("")), "File_Signal_Source");
+    EXPECT_EQ(table.get("Foo.negative", 0), -3);
+
+    // Values that cannot be converted give the default, as with StringConverter
+    EXPECT_EQ(table.get("Foo.name", 7), 7);
+    EXPECT_FALSE(table.get("Foo.count", false));
+    EXPECT_EQ(table.get("Foo.missing", 5), 5);
+}
+
+
+TEST(Property_Table_Test, CaseInsensitiveNames)
+{
+    Property_Table table;
+    table.set("channels_1c.count", "8");
+    EXPECT_TRUE(table.is_present("Channels_1C.count"));
+    EXPECT_EQ(table.get("Channels_1C.count", 0), 8);
+    EXPECT_EQ(table.size(), 1u);
+}
+
+
+TEST(Property_Table_Test, Overrides)
+{
+    Property_Table table;
+    table.set("Foo.value", "1");
+    table.set("Foo.value", "2", true);
+    EXPECT_EQ(table.get("Foo.value", 0), 2);
+    // The first override is kept, like in InMemoryConfiguration
+    table.set("Foo.value", "3", true);
+    table.set("Foo.value", "4");
+    EXPECT_EQ(table.get("Foo.value", 0), 2);
+}
+
+
+TEST(Property_Table_Test, UnusedProperties)
+{
+    Property_Table table;
+    table.set("b.used", "1");
+    table.set("c.unused", "1");
+    table.set("a.unused", "1");
+    table.get("B.USED", 0);
+    std::vector<std::string> unused = table.unused();
+    ASSERT_EQ(unused.size(), 2u);
+    EXPECT_EQ(unused.at(0), "a.unused");
+    EXPECT_EQ(unused.at(1), "c.unused");
+}
+
+
+TEST(Property_Table_Test, FileConfigurationUnusedProperties)
+{
+    std::string path = std::string(TEST_PATH);
+    std::string filename = path + "data/config_file_sample.txt";
+    FileConfiguration configuration(filename);
+    EXPECT_EQ(configuration.property("Foo.param1", std::string("")), "value");
+    EXPECT_EQ(configuration.property("SignalSource.item_size", 0), 4);
+    EXPECT_FALSE(configuration.property("SignalSource.repeat", true));
+    std::vector<std::string> unused = configuration.unused_properties();
+    EXPECT_TRUE(std::find(unused.begin(), unused.end(), "foo.param1") == unused.end());
+    EXPECT_TRUE(std::find(unused.begin(), unused.end(), "signalconditioner.implementation") != unused.end());
+}
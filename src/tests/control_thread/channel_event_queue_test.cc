@@ -0,0 +1,143 @@
+/*!
+ * \file channel_event_queue_test.cc
+ * \brief  This file implements tests for the queue of channel events.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "channel_event_queue.h"
+
+
+TEST(Channel_Event_Queue_Test, BatchesInOrder)
+{
+    Channel_Event_Queue events(8);
+    EXPECT_EQ(events.capacity(), 8u);
+    EXPECT_FALSE(events.ready());
+    for (unsigned int i = 0; i < 5; i++)
+        {
+            EXPECT_TRUE(events.push(i, i % 3));
+        }
+    EXPECT_TRUE(events.ready());
+
+    Channel_Event batch[4];
+    EXPECT_EQ(events.pop(batch, 4), 4u);
+    for (unsigned int i = 0; i < 4; i++)
+        {
+            EXPECT_EQ(batch[i].channel, i);
+            EXPECT_EQ(batch[i].event, i % 3);
+        }
+    EXPECT_EQ(events.pop(batch, 4), 1u);
+    EXPECT_EQ(batch[0].channel, 4u);
+    EXPECT_EQ(events.pop(batch, 4), 0u);
+}
+
+
+TEST(Channel_Event_Queue_Test, FullQueue)
+{
+    Channel_Event_Queue events(5); // rounded up to 8
+    for (unsigned int i = 0; i < 8; i++)
+        {
+            EXPECT_TRUE(events.push(i, 1));
+        }
+    EXPECT_FALSE(events.push(8, 1));
+
+    // The slots are reused once the consumer has freed them
+    Channel_Event batch[8];
+    EXPECT_EQ(events.pop(batch, 2), 2u);
+    EXPECT_TRUE(events.push(8, 1));
+    EXPECT_TRUE(events.push(9, 1));
+    EXPECT_FALSE(events.push(10, 1));
+    EXPECT_EQ(events.pop(batch, 8), 8u);
+    EXPECT_EQ(batch[7].channel, 9u);
+}
+
+
+TEST(Channel_Event_Queue_Test, WaitTimeoutAndWakeUp)
+{
+    Channel_Event_Queue events;
+    EXPECT_FALSE(events.wait(1));
+
+    std::thread waker([&events]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        events.wake_up();
+    });
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(events.wait(10000));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    waker.join();
+
+    events.push(3, 2);
+    EXPECT_TRUE(events.wait(0));
+}
+
+
+TEST(Channel_Event_Queue_Test, ConcurrentProducers)
+{
+    const unsigned int producers = 4;
+    const unsigned int events_per_producer = 20000;
+    Channel_Event_Queue events(64);
+
+    std::vector<std::thread> threads;
+    for (unsigned int p = 0; p < producers; p++)
+        {
+            threads.push_back(std::thread([&events, p, events_per_producer]() {
+                for (unsigned int i = 0; i < events_per_producer; i++)
+                    {
+                        while (!events.push(p, i))
+                            {
+                                std::this_thread::yield();
+                            }
+                    }
+            }));
+        }
+
+    // Each producer's events must arrive complete and in order
+    std::vector<unsigned int> next(producers, 0);
+    unsigned int received = 0;
+    Channel_Event batch[64];
+    while (received < producers * events_per_producer)
+        {
+            if (!events.wait(1000))
+                {
+                    break;
+                }
+            unsigned int count = events.pop(batch, 64);
+            for (unsigned int i = 0; i < count; i++)
+                {
+                    ASSERT_LT(batch[i].channel, producers);
+                    ASSERT_EQ(batch[i].event, next[batch[i].channel]);
+                    next[batch[i].channel]++;
+                }
+            received += count;
+        }
+    for (unsigned int p = 0; p < producers; p++)
+        {
+            threads.at(p).join();
+        }
+    EXPECT_EQ(received, producers * events_per_producer);
+}
@@ -0,0 +1,131 @@
+/*!
+ * \file concurrent_map_test.cc
+ * \brief  This file implements tests for the snapshots of concurrent_map.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+#include "concurrent_map.h"
+
+
+TEST(Concurrent_Map_Test, ReadWrite)
+{
+    concurrent_map<double> map;
+    double value = 0.0;
+    EXPECT_EQ(map.size(), 0u);
+    EXPECT_FALSE(map.read(3, value));
+    EXPECT_FALSE(map.find(3));
+
+    map.write(3, 1.5);
+    map.write(7, 2.5);
+    map.write(3, 4.5); // update
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.version(), 3u);
+    EXPECT_TRUE(map.read(3, value));
+    EXPECT_DOUBLE_EQ(value, 4.5);
+    EXPECT_DOUBLE_EQ(*map.find(7), 2.5);
+
+    std::map<int, double> copy = map.get_map_copy();
+    EXPECT_EQ(copy.size(), 2u);
+    EXPECT_DOUBLE_EQ(copy[3], 4.5);
+}
+
+
+TEST(Concurrent_Map_Test, SnapshotsAreImmutable)
+{
+    concurrent_map<int> map;
+    map.write(1, 10);
+    concurrent_map<int>::Snapshot before = map.snapshot();
+    std::shared_ptr<const int> value = map.find(1);
+
+    map.write(1, 20);
+    map.write(2, 30);
+    EXPECT_EQ(before->size(), 1u);
+    EXPECT_EQ(*before->at(1), 10);
+    EXPECT_EQ(*value, 10);
+    EXPECT_EQ(*map.find(1), 20);
+    EXPECT_EQ(map.snapshot()->size(), 2u);
+}
+
+
+TEST(Concurrent_Map_Test, ConcurrentReadersAndWriters)
+{
+    // Each value is a pair of equal numbers, so a torn read would show
+    concurrent_map<std::pair<unsigned int, unsigned int>> map;
+    const unsigned int writes = 20000;
+    std::atomic<bool> done(false);
+    std::atomic<unsigned int> torn(0);
+
+    std::vector<std::thread> readers;
+    for (unsigned int r = 0; r < 3; r++)
+        {
+            readers.push_back(std::thread([&map, &done, &torn]() {
+                unsigned int last = 0;
+                while (!done.load())
+                    {
+                        std::shared_ptr<const std::pair<unsigned int, unsigned int>> value = map.find(0);
+                        if (value)
+                            {
+                                if (value->first != value->second || value->first < last)
+                                    {
+                                        torn++;
+                                    }
+                                last = value->first;
+                            }
+                    }
+            }));
+        }
+    std::vector<std::thread> writers;
+    for (unsigned int w = 0; w < 2; w++)
+        {
+            writers.push_back(std::thread([&map, w, writes]() {
+                for (unsigned int i = 0; i < writes; i++)
+                    {
+                        map.write(static_cast<int>(w + 1), std::make_pair(i, i));
+                    }
+            }));
+        }
+    for (unsigned int i = 1; i <= writes; i++)
+        {
+            map.write(0, std::make_pair(i, i));
+        }
+    for (unsigned int w = 0; w < writers.size(); w++)
+        {
+            writers.at(w).join();
+        }
+    done = true;
+    for (unsigned int r = 0; r < readers.size(); r++)
+        {
+            readers.at(r).join();
+        }
+    EXPECT_EQ(torn.load(), 0u);
+    EXPECT_EQ(map.version(), 3 * writes);
+    EXPECT_EQ(map.find(0)->first, writes);
+    EXPECT_EQ(map.find(1)->first, writes - 1);
+}
@@ -0,0 +1,94 @@
+/*!
+ * \file parallel_for_test.cc
+ * \brief  This file implements tests for parallel_for.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "parallel_for.h"
+
+
+TEST(Parallel_For_Test, EveryTaskRunsOnceInItsSlot)
+{
+    const unsigned int count = 1000;
+    std::vector<unsigned int> results(count, 0);
+    std::atomic<unsigned int> calls(0);
+    parallel_for(count, 8, [&](unsigned int i)
+        {
+            results.at(i) += i * i;
+            calls++;
+        });
+    EXPECT_EQ(calls.load(), count);
+    for (unsigned int i = 0; i < count; i++)
+        {
+            EXPECT_EQ(results.at(i), i * i);
+        }
+}
+
+
+TEST(Parallel_For_Test, SameResultWithAnyNumberOfThreads)
+{
+    const unsigned int count = 48;
+    std::vector<double> serial(count);
+    std::vector<double> parallel(count);
+    std::function<double(unsigned int)> work = [](unsigned int i)
+        {
+            double x = 0.0;
+            for (unsigned int k = 0; k < 10000; k++)
+                {
+                    x += static_cast<double>((i + 1) * k) / (k + 1.0);
+                }
+            return x;
+        };
+    parallel_for(count, 1, [&](unsigned int i) { serial.at(i) = work(i); });
+    parallel_for(count, 0, [&](unsigned int i) { parallel.at(i) = work(i); });
+    EXPECT_EQ(serial, parallel);
+}
+
+
+TEST(Parallel_For_Test, NoTasks)
+{
+    unsigned int calls = 0;
+    parallel_for(0, 4, [&](unsigned int) { calls++; });
+    EXPECT_EQ(calls, 0u);
+}
+
+
+TEST(Parallel_For_Test, ExceptionReachesTheCaller)
+{
+    std::atomic<unsigned int> calls(0);
+    EXPECT_THROW(parallel_for(100, 4, [&](unsigned int i)
+        {
+            calls++;
+            if (i == 10)
+                {
+                    throw std::runtime_error("task failed");
+                }
+        }), std::runtime_error);
+    EXPECT_LE(calls.load(), 100u);
+}
@@ -0,0 +1,124 @@
+/*!
+ * \file gnss_assistance_engine_test.cc
+ * \brief  Tests of the local acquisition assistance predictions
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <cmath>
+#include <ctime>
+#include <list>
+#include <map>
+#include "gnss_assistance_engine.h"
+#include "gnss_signal.h"
+#include "gps_almanac.h"
+
+
+// Circular GPS orbit whose argument of latitude is u (in semi-circles) at
+// t = 0, in the orbital plane with node at longitude 0
+Gps_Almanac assistance_test_almanac(unsigned int prn, double u)
+{
+    Gps_Almanac almanac;
+    almanac.i_satellite_PRN = prn;
+    almanac.d_sqrt_A = std::sqrt(26560e3);
+    almanac.d_Delta_i = 55.0 / 180.0 - 0.3;
+    almanac.d_M_0 = u;
+    almanac.d_Toa = 0.0;
+    return almanac;
+}
+
+
+TEST(Gnss_Assistance_Engine_Test, TimeOfWeek)
+{
+    Gps_Ref_Time ref_time;
+    ref_time.valid = true;
+    ref_time.d_TOW = 604790.0;
+    ref_time.d_tv_sec = 1000000.0;
+    EXPECT_DOUBLE_EQ(Gnss_Assistance_Engine::time_of_week(1000000, ref_time), 604790.0);
+    EXPECT_DOUBLE_EQ(Gnss_Assistance_Engine::time_of_week(1000020, ref_time), 10.0);
+
+    // 2017-01-08T00:00:00Z is the start of GPS week 1931, plus the leap seconds
+    ref_time.valid = false;
+    EXPECT_DOUBLE_EQ(Gnss_Assistance_Engine::time_of_week(1483833600, ref_time), 18.0);
+}
+
+
+TEST(Gnss_Assistance_Engine_Test, AlmanacPrediction)
+{
+    Gnss_Assistance_Engine engine;
+    std::map<int, Gps_Almanac> almanacs;
+    almanacs[1] = assistance_test_almanac(1, 0.0);
+    almanacs[2] = assistance_test_almanac(2, 1.0);
+    engine.set_gps_almanac(almanacs);
+    EXPECT_FALSE(engine.ready());
+    engine.set_reference_location(0.0, 0.0, 0.0, 0.0);
+    EXPECT_TRUE(engine.ready());
+
+    Gnss_Assistance_Prediction prediction;
+    // PRN 1 is at the zenith, where the range rate is minimum
+    ASSERT_TRUE(engine.predict(Gnss_Signal(Gnss_Satellite("GPS", 1), "1C"), 0.0, prediction));
+    EXPECT_NEAR(prediction.elevation_deg, 90.0, 0.1);
+    EXPECT_LT(std::fabs(prediction.doppler_hz), 100.0);
+    EXPECT_TRUE(prediction.from_almanac);
+    EXPECT_DOUBLE_EQ(prediction.uncertainty_hz, 1150.0);
+
+    // Two minutes later it is moving away
+    ASSERT_TRUE(engine.predict(Gnss_Signal(Gnss_Satellite("GPS", 1), "1C"), 120.0, prediction));
+    EXPECT_LT(prediction.doppler_hz, -50.0);
+    EXPECT_GT(prediction.doppler_hz, -5000.0);
+
+    // PRN 2 is on the other side of the Earth
+    ASSERT_TRUE(engine.predict(Gnss_Signal(Gnss_Satellite("GPS", 2), "1C"), 0.0, prediction));
+    EXPECT_LT(prediction.elevation_deg, 0.0);
+
+    // No orbits
+    EXPECT_FALSE(engine.predict(Gnss_Signal(Gnss_Satellite("GPS", 3), "1C"), 0.0, prediction));
+    EXPECT_FALSE(engine.predict(Gnss_Signal(Gnss_Satellite("SBAS", 120), "1C"), 0.0, prediction));
+}
+
+
+TEST(Gnss_Assistance_Engine_Test, SortSignals)
+{
+    Gnss_Assistance_Engine engine;
+    std::map<int, Gps_Almanac> almanacs;
+    almanacs[1] = assistance_test_almanac(1, 1.0);
+    almanacs[2] = assistance_test_almanac(2, 0.1);
+    almanacs[4] = assistance_test_almanac(4, 0.0);
+    engine.set_gps_almanac(almanacs);
+    engine.set_reference_location(0.0, 0.0, 0.0, 1000.0);
+
+    std::list<Gnss_Signal> signals;
+    for (unsigned int prn = 1; prn <= 4; prn++)
+        {
+            signals.push_back(Gnss_Signal(Gnss_Satellite("GPS", prn), "1C"));
+        }
+    EXPECT_EQ(engine.sort_signals(signals, 0.0), 2u);
+    ASSERT_EQ(signals.size(), 4u);
+    std::list<Gnss_Signal>::const_iterator it = signals.begin();
+    EXPECT_EQ((it++)->get_satellite().get_PRN(), 4u); // Zenith
+    EXPECT_EQ((it++)->get_satellite().get_PRN(), 2u); // Visible, lower
+    EXPECT_EQ((it++)->get_satellite().get_PRN(), 3u); // Unknown
+    EXPECT_EQ((it++)->get_satellite().get_PRN(), 1u); // Below the horizon
+}
@@ -0,0 +1,165 @@
+/*!
+ * \file gnss_signal_scheduler_test.cc
+ * \brief  This file implements tests for the signal scheduler of the flowgraph.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <string>
+#include <vector>
+#include "gnss_signal.h"
+#include "gnss_signal_scheduler.h"
+
+
+Gnss_Signal scheduler_test_signal(const std::string& system, unsigned int prn, const std::string& band)
+{
+    return Gnss_Signal(Gnss_Satellite(system, prn), band);
+}
+
+
+TEST(Gnss_Signal_Scheduler_Test, ArrivalOrderWithoutPriorities)
+{
+    Gnss_Signal_Scheduler scheduler;
+    for (unsigned int prn = 1; prn <= 5; prn++)
+        {
+            scheduler.add(scheduler_test_signal("GPS", prn, "1C"));
+        }
+    scheduler.set_balance_weight(0.0);
+    Gnss_Signal signal;
+    for (unsigned int prn = 1; prn <= 5; prn++)
+        {
+            ASSERT_TRUE(scheduler.select("1C", 0.0, signal));
+            EXPECT_EQ(signal.get_satellite().get_PRN(), prn);
+        }
+    EXPECT_FALSE(scheduler.select("1C", 0.0, signal));
+    EXPECT_FALSE(scheduler.select("1B", 0.0, signal));
+    EXPECT_EQ(scheduler.queued(), 0u);
+}
+
+
+TEST(Gnss_Signal_Scheduler_Test, ElevationAndPinnedSignals)
+{
+    Gnss_Signal_Scheduler scheduler;
+    scheduler.set_elevation_mask(10.0);
+    for (unsigned int prn = 1; prn <= 4; prn++)
+        {
+            scheduler.add(scheduler_test_signal("GPS", prn, "1C"));
+        }
+    scheduler.set_elevation(scheduler_test_signal("GPS", 1, "1C"), 5.0);   // below the mask
+    scheduler.set_elevation(scheduler_test_signal("GPS", 2, "1C"), 30.0);
+    scheduler.set_elevation(scheduler_test_signal("GPS", 3, "1C"), 60.0);
+    scheduler.add(scheduler_test_signal("GPS", 4, "1C"), true);            // pinned in the configuration
+
+    Gnss_Signal signal;
+    unsigned int expected[] = {4, 3, 2, 1};
+    for (unsigned int i = 0; i < 4; i++)
+        {
+            ASSERT_TRUE(scheduler.select("1C", 0.0, signal));
+            EXPECT_EQ(signal.get_satellite().get_PRN(), expected[i]);
+        }
+}
+
+
+TEST(Gnss_Signal_Scheduler_Test, FailedSignalsBackOff)
+{
+    Gnss_Signal_Scheduler scheduler;
+    scheduler.set_backoff(10.0, 40.0);
+    scheduler.add(scheduler_test_signal("GPS", 1, "1C"));
+    scheduler.add(scheduler_test_signal("GPS", 2, "1C"));
+
+    Gnss_Signal signal;
+    ASSERT_TRUE(scheduler.select("1C", 0.0, signal));
+    EXPECT_EQ(signal.get_satellite().get_PRN(), 1u);
+    scheduler.release(signal, 0.0, true);
+    EXPECT_EQ(scheduler.queued("1C"), 2u);
+
+    // PRN 1 waits 10 s, so PRN 2 goes first
+    ASSERT_TRUE(scheduler.select("1C", 1.0, signal));
+    EXPECT_EQ(signal.get_satellite().get_PRN(), 2u);
+    scheduler.release(signal, 1.0, true);
+
+    // Both are waiting: the one that has waited the longest is retried
+    ASSERT_TRUE(scheduler.select("1C", 2.0, signal));
+    EXPECT_EQ(signal.get_satellite().get_PRN(), 1u);
+    scheduler.release(signal, 2.0, true); // second failure: waits 20 s, until 22 s
+
+    ASSERT_TRUE(scheduler.select("1C", 12.0, signal));
+    EXPECT_EQ(signal.get_satellite().get_PRN(), 2u);
+    scheduler.acquired(signal);
+    EXPECT_GT(scheduler.score(scheduler_test_signal("GPS", 2, "1C")), scheduler.score(scheduler_test_signal("GPS", 1, "1C")));
+}
+
+
+TEST(Gnss_Signal_Scheduler_Test, ConstellationBalance)
+{
+    Gnss_Signal_Scheduler scheduler;
+    for (unsigned int prn = 1; prn <= 4; prn++)
+        {
+            scheduler.add(scheduler_test_signal("GPS", prn, "1C"));
+        }
+    scheduler.add(scheduler_test_signal("SBAS", 120, "1C"));
+    scheduler.add(scheduler_test_signal("SBAS", 124, "1C"));
+
+    Gnss_Signal signal;
+    std::vector<std::string> systems;
+    for (unsigned int i = 0; i < 4; i++)
+        {
+            ASSERT_TRUE(scheduler.select("1C", 0.0, signal));
+            systems.push_back(signal.get_satellite().get_system());
+        }
+    EXPECT_EQ(systems.at(0), "GPS");
+    EXPECT_EQ(systems.at(1), "SBAS");
+    EXPECT_EQ(systems.at(2), "GPS");
+    EXPECT_EQ(systems.at(3), "SBAS");
+}
+
+
+TEST(Gnss_Signal_Scheduler_Test, LastCn0)
+{
+    Gnss_Signal_Scheduler scheduler;
+    scheduler.add(scheduler_test_signal("Galileo", 11, "1B"));
+    scheduler.add(scheduler_test_signal("Galileo", 12, "1B"));
+    scheduler.set_cn0(scheduler_test_signal("Galileo", 12, "1B"), 45.0);
+
+    Gnss_Signal signal;
+    ASSERT_TRUE(scheduler.select("1B", 0.0, signal));
+    EXPECT_EQ(signal.get_satellite().get_PRN(), 12u);
+}
+
+
+TEST(Gnss_Signal_Scheduler_Test, AcquisitionSlotsPerBand)
+{
+    Gnss_Signal_Scheduler scheduler;
+    scheduler.set_max_acquisitions("1B", 1);
+    EXPECT_TRUE(scheduler.acquisition_slot_available("1C"));
+    EXPECT_TRUE(scheduler.acquisition_slot_available("1B"));
+    scheduler.acquisition_started("1B");
+    EXPECT_FALSE(scheduler.acquisition_slot_available("1B"));
+    scheduler.acquisition_started("1C");
+    scheduler.acquisition_started("1C");
+    EXPECT_TRUE(scheduler.acquisition_slot_available("1C"));
+    scheduler.acquisition_finished("1B");
+    EXPECT_TRUE(scheduler.acquisition_slot_available("1B"));
+}
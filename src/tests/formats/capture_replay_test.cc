@@ -0,0 +1,133 @@
+/*!
+ * \file capture_replay_test.cc
+ * \brief Tests the segment planning and RINEX merging of gnss-sdr-replay
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include "capture_replay.h"
+
+
+TEST(Capture_Replay_Test, PlanSegments)
+{
+    long long total = 1000003;
+    long long overlap = 50000;
+    std::vector<Replay_Segment> plan = CaptureReplay::plan_segments(total, 4, overlap);
+    ASSERT_EQ(4, plan.size());
+
+    EXPECT_EQ(0, plan.at(0).first_sample);
+    EXPECT_EQ(0, plan.at(0).warmup_samples);
+    long long covered = 0;
+    for (unsigned int k = 0; k < plan.size(); k++)
+        {
+            // Every nominal segment starts right where the previous one ended
+            EXPECT_EQ(covered, plan.at(k).first_sample + plan.at(k).warmup_samples);
+            covered = plan.at(k).first_sample + plan.at(k).samples;
+            if (k > 0)
+                {
+                    EXPECT_EQ(overlap, plan.at(k).warmup_samples);
+                }
+        }
+    EXPECT_EQ(total, covered);
+    EXPECT_EQ("segment_3", plan.at(3).directory);
+
+    // Overlap longer than the elapsed time is clipped at the start of the file
+    plan = CaptureReplay::plan_segments(100, 2, 1000);
+    EXPECT_EQ(0, plan.at(1).first_sample);
+    EXPECT_EQ(50, plan.at(1).warmup_samples);
+}
+
+
+TEST(Capture_Replay_Test, MergeRinexObs)
+{
+    std::string header = "     3.02           OBSERVATION DATA    M (MIXED)           RINEX VERSION / TYPE\n"
+            "                                                            END OF HEADER\n";
+    std::istringstream first(header +
+            "> 2015 10 19 12 00 00.0000000  0  1\n"
+            "G01  20000000.000\n"
+            "> 2015 10 19 12 00 01.0000000  0  1\n"
+            "G01  20000001.000\n");
+    std::istringstream second(header +
+            "> 2015 10 19 12 00 00.5000000  0  1\n"
+            "G01  99999999.000\n"
+            "> 2015 10 19 12 00 01.0000000  0  1\n"
+            "G01  99999999.000\n"
+            "> 2015 10 19 12 00 02.0000000  0  1\n"
+            "G01  20000002.000\n");
+    std::vector<std::istream*> inputs;
+    inputs.push_back(&first);
+    inputs.push_back(&second);
+    std::ostringstream output;
+
+    EXPECT_EQ(3, CaptureReplay::merge_rinex_obs(inputs, output));
+    std::string merged = output.str();
+    EXPECT_EQ(merged.find("END OF HEADER"), merged.rfind("END OF HEADER"));
+    EXPECT_EQ(std::string::npos, merged.find("99999999"));
+    EXPECT_NE(std::string::npos, merged.find("20000002.000"));
+}
+
+
+TEST(Capture_Replay_Test, RelativePaths)
+{
+    // Everything relative to a scratch working directory, with the default output folder
+    boost::filesystem::path previous = boost::filesystem::current_path();
+    boost::filesystem::path scratch = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("capture_replay_%%%%%%%%");
+    boost::filesystem::create_directories(scratch / "captures");
+    boost::filesystem::current_path(scratch);
+
+    std::ofstream("captures/capture.dat") << std::string(4000, '\0');
+    std::ofstream("replay.conf") << "[GNSS-SDR]" << std::endl;
+    // Stand-in for gnss-sdr: it fails unless the capture and the log folder can
+    // be reached from its working directory, and writes a RINEX observation file
+    {
+        std::ofstream receiver("receiver.sh");
+        receiver << "#!/bin/sh\n"
+                 << "for arg in \"$@\"; do\n"
+                 << "  case \"$arg\" in\n"
+                 << "    --signal_source=*) [ -r \"${arg#--signal_source=}\" ] || exit 2 ;;\n"
+                 << "    --log_dir=*) [ -d \"${arg#--log_dir=}\" ] || exit 3 ;;\n"
+                 << "  esac\n"
+                 << "done\n"
+                 << "printf '%s\\n' '                                                            END OF HEADER' "
+                 << "'> 2015 10 19 12 00 00.0000000  0  1' > GSDR2920.15O\n";
+    }
+    boost::filesystem::permissions("receiver.sh", boost::filesystem::owner_all);
+
+    CaptureReplay replay("./receiver.sh", "replay.conf", "captures/capture.dat", "./replay", 2, 0.0);
+    std::vector<Replay_Segment> plan = CaptureReplay::plan_segments(1000, 2, 100);
+    EXPECT_TRUE(replay.run(plan));
+    EXPECT_TRUE(replay.merge(plan, "replay/merged.obs"));
+    EXPECT_TRUE(boost::filesystem::exists("replay/segment_1/GSDR2920.15O"));
+    EXPECT_TRUE(boost::filesystem::exists("replay/merged.obs"));
+
+    boost::filesystem::current_path(previous);
+    boost::filesystem::remove_all(scratch);
+}
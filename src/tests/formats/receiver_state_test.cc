@@ -0,0 +1,184 @@
+/*!
+ * \file receiver_state_test.cc
+ * \brief Tests the receiver state file used for hot restarts
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <string>
+#include "gnss_receiver_state.h"
+
+
+TEST(Receiver_State_Test, SaveAndLoad)
+{
+    std::string filename = "./receiver_state_test.bin";
+    Gnss_Receiver_State state;
+    Gps_Ephemeris gps_eph;
+    gps_eph.i_satellite_PRN = 5;
+    gps_eph.d_sqrt_A = 5153.7;
+    gps_eph.d_Toe = 345600.0;
+    state.gps_ephemeris_map[5] = gps_eph;
+    Galileo_Ephemeris galileo_eph;
+    galileo_eph.i_satellite_PRN = 11;
+    galileo_eph.A_1 = 5440.6;
+    state.galileo_ephemeris_map[11] = galileo_eph;
+    state.gps_iono.valid = true;
+    state.gps_iono.d_alpha0 = 1.2e-8;
+    state.galileo_utc_model.A0_6 = 3.5e-9;
+    state.set_fix(1000.0, 41.27, 1.98, 120.0, 1e-3);
+
+    std::map<int, Gnss_Synchro> observations;
+    Gnss_Synchro gps;
+    gps.System = 'G';
+    gps.Signal[0] = '1'; gps.Signal[1] = 'C'; gps.Signal[2] = '\0';
+    gps.PRN = 5;
+    gps.Carrier_Doppler_hz = -1234.5;
+    observations[0] = gps;
+    state.set_observations(observations);
+
+    ASSERT_TRUE(state.save(filename));
+    Gnss_Receiver_State loaded;
+    ASSERT_TRUE(loaded.load(filename));
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(loaded.gps_ephemeris_map.count(5), 1u);
+    EXPECT_DOUBLE_EQ(loaded.gps_ephemeris_map[5].d_sqrt_A, 5153.7);
+    EXPECT_DOUBLE_EQ(loaded.gps_ephemeris_map[5].d_Toe, 345600.0);
+    ASSERT_EQ(loaded.galileo_ephemeris_map.count(11), 1u);
+    EXPECT_DOUBLE_EQ(loaded.galileo_ephemeris_map[11].A_1, 5440.6);
+    EXPECT_TRUE(loaded.gps_iono.valid);
+    EXPECT_DOUBLE_EQ(loaded.gps_iono.d_alpha0, 1.2e-8);
+    EXPECT_DOUBLE_EQ(loaded.galileo_utc_model.A0_6, 3.5e-9);
+    EXPECT_TRUE(loaded.position_valid);
+    EXPECT_DOUBLE_EQ(loaded.latitude_deg, 41.27);
+    EXPECT_DOUBLE_EQ(loaded.height_m, 120.0);
+    double doppler = 0.0;
+    EXPECT_TRUE(loaded.get_doppler('G', "1C", 5, doppler));
+    EXPECT_DOUBLE_EQ(doppler, -1234.5);
+    EXPECT_FALSE(loaded.get_doppler('E', "1B", 5, doppler));
+
+    double now = static_cast<double>(std::time(0));
+    EXPECT_TRUE(loaded.models_usable(now));
+    EXPECT_TRUE(loaded.doppler_usable(now));
+    EXPECT_FALSE(loaded.doppler_usable(now + 3600.0));
+    EXPECT_FALSE(loaded.models_usable(now + 86400.0));
+}
+
+
+TEST(Receiver_State_Test, StaleEphemerides)
+{
+    // 2024-01-01T00:00:00Z is GPS week 2295 (247 broadcast), TOW 86418
+    double now = 1704067200.0;
+    EXPECT_NEAR(Gnss_Receiver_State::navigation_data_age(now, 247, 86418.0), 0.0, 1e-6);
+    EXPECT_NEAR(Gnss_Receiver_State::navigation_data_age(now, 247, 93600.0), -7182.0, 1e-6);
+    EXPECT_NEAR(Gnss_Receiver_State::navigation_data_age(now, 2295, 86418.0), 0.0, 1e-6);
+    // Across the end of the week
+    double next_week = now + 518382.0 + 17.0;
+    EXPECT_NEAR(Gnss_Receiver_State::navigation_data_age(next_week, 248, 0.0), 17.0, 1e-6);
+    EXPECT_NEAR(Gnss_Receiver_State::navigation_data_age(next_week, 247, 604000.0), 817.0, 1e-6);
+
+    // The state is recent, but only the ephemerides within their own
+    // validity interval are kept
+    Gnss_Receiver_State state;
+    state.saved_at = now - 60.0;
+    Gps_Ephemeris current;
+    current.i_GPS_week = 247;
+    current.d_Toe = 86400.0;
+    state.gps_ephemeris_map[1] = current;
+    Gps_Ephemeris old;
+    old.i_GPS_week = 247;
+    old.d_Toe = 72000.0;
+    state.gps_ephemeris_map[2] = old;
+    Galileo_Ephemeris galileo_current;
+    galileo_current.WN_5 = 1271.0;
+    galileo_current.t0e_1 = 87000.0;
+    state.galileo_ephemeris_map[3] = galileo_current;
+    Galileo_Ephemeris galileo_old;
+    galileo_old.WN_5 = 1270.0;
+    galileo_old.t0e_1 = 86400.0;
+    state.galileo_ephemeris_map[4] = galileo_old;
+    EXPECT_TRUE(state.models_usable(now));
+    EXPECT_EQ(2u, state.remove_stale_ephemerides(now));
+    EXPECT_EQ(1u, state.gps_ephemeris_map.count(1));
+    EXPECT_EQ(0u, state.gps_ephemeris_map.count(2));
+    EXPECT_EQ(1u, state.galileo_ephemeris_map.count(3));
+    EXPECT_EQ(0u, state.galileo_ephemeris_map.count(4));
+}
+
+
+TEST(Receiver_State_Test, Writer)
+{
+    std::string filename = "./receiver_state_writer_test.bin";
+    {
+        Gnss_Receiver_State_Writer writer(filename);
+        Gnss_Receiver_State state;
+        state.set_fix(1000.0, 41.27, 1.98, 120.0, 1e-3);
+        writer.write(state);
+        writer.flush();
+        Gnss_Receiver_State loaded;
+        ASSERT_TRUE(loaded.load(filename));
+        EXPECT_DOUBLE_EQ(loaded.latitude_deg, 41.27);
+        // The last state queued is written before the writer is destroyed
+        state.set_fix(1001.0, 42.0, 1.98, 120.0, 1e-3);
+        writer.write(state);
+    }
+    Gnss_Receiver_State loaded;
+    ASSERT_TRUE(loaded.load(filename));
+    EXPECT_DOUBLE_EQ(loaded.latitude_deg, 42.0);
+    std::remove(filename.c_str());
+}
+
+
+TEST(Receiver_State_Test, ClockDrift)
+{
+    Gnss_Receiver_State state;
+    state.set_fix(100.0, 0.0, 0.0, 0.0, 1e-3);
+    EXPECT_DOUBLE_EQ(state.clock_drift, 0.0);
+    state.set_fix(101.0, 0.0, 0.0, 0.0, 1e-3 + 2e-7);
+    EXPECT_NEAR(state.clock_drift, 2e-7, 1e-15);
+    // Fixes too far apart do not change the estimate
+    state.set_fix(1000.0, 0.0, 0.0, 0.0, 5e-3);
+    EXPECT_NEAR(state.clock_drift, 2e-7, 1e-15);
+}
+
+
+TEST(Receiver_State_Test, RejectsOtherFiles)
+{
+    std::string filename = "./receiver_state_test.bin";
+    std::ofstream file(filename.c_str());
+    file << "not a receiver state";
+    file.close();
+    Gnss_Receiver_State state;
+    state.latitude_deg = 10.0;
+    EXPECT_FALSE(state.load(filename));
+    EXPECT_DOUBLE_EQ(state.latitude_deg, 10.0);
+    std::remove(filename.c_str());
+    EXPECT_FALSE(state.load(filename));
+}
@@ -236,6 +236,33 @@ TEST(GNSS_Block_Factory_Test, InstantiateGpsL1CaDllPllTracking)
 }
 
 
+TEST(GNSS_Block_Factory_Test, InstantiateGpsL1CaDllPllVectorTracking)
+{
+    std::shared_ptr<InMemoryConfiguration> configuration = std::make_shared<InMemoryConfiguration>();
+    configuration->set_property("Tracking.implementation", "GPS_L1_CA_DLL_PLL_Vector_Tracking");
+    std::unique_ptr<GNSSBlockFactory> factory;
+    std::shared_ptr<GNSSBlockInterface> trk_ = factory->GetBlock(configuration, "Tracking", "GPS_L1_CA_DLL_PLL_Vector_Tracking", 1, 1);
+    std::shared_ptr<TrackingInterface> tracking = std::dynamic_pointer_cast<TrackingInterface>(trk_);
+    EXPECT_STREQ("Tracking", tracking->role().c_str());
+    EXPECT_STREQ("GPS_L1_CA_DLL_PLL_Vector_Tracking", tracking->implementation().c_str());
+    EXPECT_TRUE(tracking->get_right_block()->has_msg_port(pmt::mp("vector_aid")));
+}
+
+
+TEST(GNSS_Block_Factory_Test, InstantiateGalileoE5aDllPllGenericTracking)
+{
+    std::shared_ptr<InMemoryConfiguration> configuration = std::make_shared<InMemoryConfiguration>();
+    configuration->set_property("Tracking.implementation", "Galileo_E5a_DLL_PLL_Generic_Tracking");
+    configuration->set_property("Tracking.item_type", "cshort");
+    std::unique_ptr<GNSSBlockFactory> factory;
+    std::shared_ptr<GNSSBlockInterface> trk_ = factory->GetBlock(configuration, "Tracking", "Galileo_E5a_DLL_PLL_Generic_Tracking", 1, 1);
+    std::shared_ptr<TrackingInterface> tracking = std::dynamic_pointer_cast<TrackingInterface>(trk_);
+    EXPECT_STREQ("Tracking", tracking->role().c_str());
+    EXPECT_STREQ("Galileo_E5a_DLL_PLL_Generic_Tracking", tracking->implementation().c_str());
+    EXPECT_EQ(2 * sizeof(short), tracking->item_size());
+}
+
+
 TEST(GNSS_Block_Factory_Test, InstantiateGpsL1CaTcpConnectorTracking)
 {
     std::shared_ptr<InMemoryConfiguration> configuration = std::make_shared<InMemoryConfiguration>();
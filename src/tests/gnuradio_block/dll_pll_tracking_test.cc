@@ -0,0 +1,539 @@
+/*!
+ * \file dll_pll_tracking_test.cc
+ * \brief  Runs the DLL/PLL tracking block template on synthetic signals of
+ * known Doppler and code delay, and checks the loops, the synchronization of
+ * the secondary code and the data symbols.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include <glog/logging.h>
+#include <gnuradio/top_block.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#include <gnuradio/blocks/vector_sink_b.h>
+#include "dll_pll_conf.h"
+#include "dll_pll_signal_traits.h"
+#include "dll_pll_tracking.h"
+#include "gnss_correlation_shape.h"
+#include "gnss_synchro.h"
+
+
+// ######## GNURADIO BLOCK MESSAGE RECEVER #########
+class DllPllTrackingTest_msg_rx;
+
+typedef boost::shared_ptr<DllPllTrackingTest_msg_rx> DllPllTrackingTest_msg_rx_sptr;
+
+DllPllTrackingTest_msg_rx_sptr DllPllTrackingTest_msg_rx_make();
+
+/*
+ * Keeps the last event and all the correlation shapes published by the
+ * tracking block
+ */
+class DllPllTrackingTest_msg_rx : public gr::block
+{
+private:
+    friend DllPllTrackingTest_msg_rx_sptr DllPllTrackingTest_msg_rx_make();
+    void msg_handler_events(pmt::pmt_t msg);
+    void msg_handler_correlation_shape(pmt::pmt_t msg);
+    DllPllTrackingTest_msg_rx();
+
+public:
+    int rx_message;
+    std::vector<Gnss_Correlation_Shape> shapes;
+    ~DllPllTrackingTest_msg_rx(); //!< Default destructor
+};
+
+DllPllTrackingTest_msg_rx_sptr DllPllTrackingTest_msg_rx_make()
+{
+    return DllPllTrackingTest_msg_rx_sptr(new DllPllTrackingTest_msg_rx());
+}
+
+void DllPllTrackingTest_msg_rx::msg_handler_events(pmt::pmt_t msg)
+{
+    try
+    {
+            long int message = pmt::to_long(msg);
+            rx_message = message;
+    }
+    catch(boost::bad_any_cast& e)
+    {
+            LOG(WARNING) << "msg_handler_events Bad any cast!";
+            rx_message = 0;
+    }
+}
+
+void DllPllTrackingTest_msg_rx::msg_handler_correlation_shape(pmt::pmt_t msg)
+{
+    try
+    {
+            std::shared_ptr<Gnss_Correlation_Shape> shape = boost::any_cast<std::shared_ptr<Gnss_Correlation_Shape>>(pmt::any_ref(msg));
+            shapes.push_back(*shape);
+    }
+    catch(boost::bad_any_cast& e)
+    {
+            LOG(WARNING) << "msg_handler_correlation_shape Bad any cast!";
+    }
+}
+
+DllPllTrackingTest_msg_rx::DllPllTrackingTest_msg_rx() :
+            gr::block("DllPllTrackingTest_msg_rx", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
+{
+    this->message_port_register_in(pmt::mp("events"));
+    this->set_msg_handler(pmt::mp("events"), boost::bind(&DllPllTrackingTest_msg_rx::msg_handler_events, this, _1));
+    this->message_port_register_in(pmt::mp("correlation_shape"));
+    this->set_msg_handler(pmt::mp("correlation_shape"), boost::bind(&DllPllTrackingTest_msg_rx::msg_handler_correlation_shape, this, _1));
+    rx_message = 0;
+}
+
+DllPllTrackingTest_msg_rx::~DllPllTrackingTest_msg_rx()
+{}
+
+// ###########################################################
+
+
+namespace
+{
+const unsigned int dll_pll_test_prn = 11;
+
+/*
+ * Samples of the signal of Traits, with a constant Doppler, a code period
+ * starting delay_chips after the first sample, and white noise at the given
+ * C/N0. Each data symbol lasts 20 primary code periods. In the first
+ * sign_error_epochs code periods, the loop component of one period out of ten
+ * is inverted, as sign errors of its prompt.
+ */
+template <class Traits>
+std::vector<gr_complex> dll_pll_test_signal(double fs, double doppler_hz, double delay_chips, double cn0_db_hz,
+        double duration_s, const std::vector<int>& bits, int sign_error_epochs)
+{
+    const int code_length = Traits::code_length_chips;
+    const int samples_per_chip = Traits::samples_per_chip;
+    const int secondary_length = Traits::secondary_code_length;
+    const int data_secondary_length = Traits::data_secondary_code_length;
+    std::vector<gr_complex> loop_code(code_length * samples_per_chip);
+    std::vector<gr_complex> data_code(code_length * samples_per_chip);
+    Traits::loop_code(loop_code.data(), dll_pll_test_prn);
+    Traits::data_code(data_code.data(), dll_pll_test_prn);
+
+    const double code_rate_hz = Traits::code_rate_hz() * (1.0 + doppler_hz / Traits::carrier_freq_hz());
+    const float amplitude = std::sqrt(std::pow(10.0, cn0_db_hz / 10.0) / fs);
+    std::mt19937 generator(5);
+    std::normal_distribution<float> noise(0.0, std::sqrt(0.5));
+
+    std::vector<gr_complex> samples(static_cast<size_t>(duration_s * fs));
+    for (size_t n = 0; n < samples.size(); n++)
+        {
+            // A whole number of secondary code periods ahead, so that the code phase is positive
+            double chips = static_cast<double>(n) / fs * code_rate_hz + static_cast<double>(secondary_length * code_length) - delay_chips;
+            long epoch = static_cast<long>(std::floor(chips / code_length));
+            long replica_index = static_cast<long>(std::floor(chips * samples_per_chip)) % (code_length * samples_per_chip);
+            int secondary = Traits::secondary_chip(dll_pll_test_prn, epoch % secondary_length);
+            if (epoch - secondary_length < sign_error_epochs && epoch % 10 == 3)
+                {
+                    secondary = -secondary;
+                }
+            float symbol = static_cast<float>(bits[(epoch / 20) % bits.size()]);
+            gr_complex value;
+            if (samples_per_chip == 1)
+                {
+                    // E5a: data on the in-phase component, pilot on the quadrature one
+                    int data_secondary = data_secondary_length > 0 ? Traits::data_secondary_chip(epoch % data_secondary_length) : 1;
+                    value = gr_complex(data_code[replica_index].real() * data_secondary * symbol,
+                            loop_code[replica_index].imag() * secondary);
+                }
+            else
+                {
+                    // E1: data minus pilot, both in phase
+                    value = gr_complex(data_code[replica_index].real() * symbol - loop_code[replica_index].real() * secondary, 0.0);
+                }
+            double phase_rad = 2.0 * M_PI * doppler_hz * static_cast<double>(n) / fs + 0.7;
+            samples[n] = value / static_cast<float>(std::sqrt(2.0)) * std::polar(amplitude, static_cast<float>(phase_rad))
+                    + gr_complex(noise(generator), noise(generator));
+        }
+    return samples;
+}
+
+
+std::vector<int> dll_pll_test_bits(int nbits)
+{
+    std::srand(3);
+    std::vector<int> bits(nbits);
+    for (int i = 0; i < nbits; i++)
+        {
+            bits[i] = (std::rand() % 2) ? 1 : -1;
+        }
+    return bits;
+}
+
+
+/*
+ * Tracks the samples from the given acquisition, and returns the tracking
+ * outputs, one per primary code period. The messages of the block go to
+ * msg_rx, if given.
+ */
+template <class Traits>
+std::vector<Gnss_Synchro> dll_pll_test_track(const Dll_Pll_Conf& conf, const std::vector<gr_complex>& samples,
+        double acq_delay_samples, double acq_doppler_hz, DllPllTrackingTest_msg_rx_sptr msg_rx = DllPllTrackingTest_msg_rx_sptr())
+{
+    Gnss_Synchro gnss_synchro = Gnss_Synchro();
+    gnss_synchro.Channel_ID = 0;
+    gnss_synchro.System = Traits::system;
+    std::string signal = Traits::signal();
+    signal.copy(gnss_synchro.Signal, 2, 0);
+    gnss_synchro.PRN = dll_pll_test_prn;
+    gnss_synchro.Acq_delay_samples = acq_delay_samples;
+    gnss_synchro.Acq_doppler_hz = acq_doppler_hz;
+    gnss_synchro.Acq_samplestamp_samples = 0;
+
+    gr::top_block_sptr top_block = gr::make_top_block("dll_pll_tracking_test");
+    gr::blocks::vector_source_c::sptr source = gr::blocks::vector_source_c::make(samples);
+    dll_pll_tracking_base_sptr tracking = dll_pll_make_tracking<Traits, gr_complex>(conf);
+    gr::blocks::vector_sink_b::sptr sink = gr::blocks::vector_sink_b::make(sizeof(Gnss_Synchro));
+    tracking->set_channel(gnss_synchro.Channel_ID);
+    tracking->set_gnss_synchro(&gnss_synchro);
+    top_block->connect(source, 0, tracking, 0);
+    top_block->connect(tracking, 0, sink, 0);
+    if (msg_rx)
+        {
+            top_block->msg_connect(tracking, pmt::mp("events"), msg_rx, pmt::mp("events"));
+            top_block->msg_connect(tracking, pmt::mp("correlation_shape"), msg_rx, pmt::mp("correlation_shape"));
+        }
+    tracking->start_tracking();
+    EXPECT_NO_THROW( {
+        top_block->run();
+        top_block->stop();
+    }) << "Failure running dll_pll_tracking.";
+
+    std::vector<unsigned char> bytes = sink->data();
+    std::vector<Gnss_Synchro> outputs(bytes.size() / sizeof(Gnss_Synchro));
+    if (!outputs.empty())
+        {
+            std::memcpy(outputs.data(), bytes.data(), outputs.size() * sizeof(Gnss_Synchro));
+        }
+    return outputs;
+}
+
+
+/*
+ * Checks that the last outputs follow the Doppler and the code phase of the
+ * signal, and that the data symbols of the second half are output with the
+ * right signs. Until the secondary code is synchronized the sign of the E1 B
+ * symbols is not known.
+ */
+template <class Traits>
+void dll_pll_test_check(const std::vector<Gnss_Synchro>& outputs, double doppler_hz, double delay_chips,
+        const std::vector<int>& bits)
+{
+    ASSERT_GT(outputs.size(), 200u);
+    const int code_length = Traits::code_length_chips;
+    const int secondary_length = Traits::secondary_code_length;
+    const double code_rate_hz = Traits::code_rate_hz() * (1.0 + doppler_hz / Traits::carrier_freq_hz());
+    double doppler_error_hz = 0.0;
+    double max_code_error_chips = 0.0;
+    for (size_t k = outputs.size() - 100; k < outputs.size(); k++)
+        {
+            doppler_error_hz += (outputs[k].Carrier_Doppler_hz - doppler_hz) / 100.0;
+            // The timestamp is the start of a code period
+            double chips = outputs[k].Tracking_timestamp_secs * code_rate_hz - delay_chips;
+            double code_error_chips = chips - code_length * std::round(chips / code_length);
+            max_code_error_chips = std::max(max_code_error_chips, std::abs(code_error_chips));
+        }
+    EXPECT_NEAR(0.0, doppler_error_hz, 1.0);
+    // The sampled correlators leave a residual bias of a few hundredths of chip
+    EXPECT_LT(max_code_error_chips, 0.1);
+
+    EXPECT_TRUE(outputs.back().Flag_valid_symbol_output);
+    // The E1 C replica is +C while the signal is B - C, so the PLL locks 180 deg
+    // away and the E1 B symbols come out inverted, which the telemetry decoder allows
+    const double polarity = Traits::samples_per_chip == 1 ? 1.0 : -1.0;
+    int symbols = 0;
+    int wrong_symbols = 0;
+    for (size_t k = outputs.size() / 2; k < outputs.size(); k++)
+        {
+            if (outputs[k].Flag_valid_symbol_output)
+                {
+                    double chips = outputs[k].Tracking_timestamp_secs * code_rate_hz + static_cast<double>(secondary_length * code_length) - delay_chips;
+                    long epoch = std::lround(chips / code_length);
+                    symbols++;
+                    if (polarity * outputs[k].Prompt_I * bits[(epoch / 20) % bits.size()] < 0.0)
+                        {
+                            wrong_symbols++;
+                        }
+                }
+        }
+    EXPECT_GT(symbols, 100);
+    EXPECT_EQ(0, wrong_symbols);
+}
+}
+
+
+TEST(Dll_Pll_Tracking_Test, GalileoE5aConvergence)
+{
+    double fs_in = 12000000.0;
+    double doppler_hz = -2100.0;
+    double delay_chips = 5000.6;
+    std::vector<int> bits = dll_pll_test_bits(100);
+    std::vector<gr_complex> samples = dll_pll_test_signal<Galileo_E5a_Dll_Pll_Traits>(fs_in, doppler_hz, delay_chips, 45.0, 0.6, bits, 0);
+
+    Dll_Pll_Conf conf;
+    conf.fs_in = fs_in;
+    conf.vector_length = std::round(fs_in * Galileo_E5a_Dll_Pll_Traits::code_period_s());
+    conf.pll_bw_hz = 20.0;
+    conf.dll_bw_hz = 20.0;
+    conf.pll_bw_narrow_hz = 5.0;
+    conf.dll_bw_narrow_hz = 2.0;
+    conf.early_late_space_chips = 0.5;
+    // Acquisition errors of 0.3 chips and 20 Hz
+    double acq_delay_samples = (delay_chips + 0.3) * fs_in / Galileo_E5a_CODE_CHIP_RATE_HZ;
+    std::vector<Gnss_Synchro> outputs = dll_pll_test_track<Galileo_E5a_Dll_Pll_Traits>(conf, samples, acq_delay_samples, doppler_hz + 20.0);
+    dll_pll_test_check<Galileo_E5a_Dll_Pll_Traits>(outputs, doppler_hz, delay_chips, bits);
+}
+
+
+TEST(Dll_Pll_Tracking_Test, GalileoE5aSecondaryWithSignErrors)
+{
+    // One pilot prompt sign out of ten is wrong in the first 300 ms, so that
+    // no 20 ms or longer stretch of them matches the secondary code
+    double fs_in = 12000000.0;
+    double doppler_hz = 1500.0;
+    double delay_chips = 2000.2;
+    int sign_error_epochs = 300;
+    std::vector<int> bits = dll_pll_test_bits(100);
+    std::vector<gr_complex> samples = dll_pll_test_signal<Galileo_E5a_Dll_Pll_Traits>(fs_in, doppler_hz, delay_chips, 45.0, 0.8, bits, sign_error_epochs);
+
+    Dll_Pll_Conf conf;
+    conf.fs_in = fs_in;
+    conf.vector_length = std::round(fs_in * Galileo_E5a_Dll_Pll_Traits::code_period_s());
+    conf.pll_bw_hz = 20.0;
+    conf.dll_bw_hz = 20.0;
+    conf.pll_bw_narrow_hz = 5.0;
+    conf.dll_bw_narrow_hz = 2.0;
+    conf.early_late_space_chips = 0.5;
+    double acq_delay_samples = delay_chips * fs_in / Galileo_E5a_CODE_CHIP_RATE_HZ;
+    std::vector<Gnss_Synchro> outputs = dll_pll_test_track<Galileo_E5a_Dll_Pll_Traits>(conf, samples, acq_delay_samples, doppler_hz - 20.0);
+    // The secondary code is synchronized in spite of the sign errors
+    int first_symbol = 0;
+    while (first_symbol < static_cast<int>(outputs.size()) && !outputs[first_symbol].Flag_valid_symbol_output)
+        {
+            first_symbol++;
+        }
+    EXPECT_LT(first_symbol, sign_error_epochs);
+    dll_pll_test_check<Galileo_E5a_Dll_Pll_Traits>(outputs, doppler_hz, delay_chips, bits);
+}
+
+
+TEST(Dll_Pll_Tracking_Test, GalileoE1cExtendedIntegration)
+{
+    // The narrow PLL bandwidth is far too wide for 100 ms integrations, and
+    // has to be clamped for the loop to stay locked
+    double fs_in = 4000000.0;
+    double doppler_hz = 800.0;
+    double delay_chips = 1000.3;
+    std::vector<int> bits = dll_pll_test_bits(100);
+    std::vector<gr_complex> samples = dll_pll_test_signal<Galileo_E1_C_Dll_Pll_Traits>(fs_in, doppler_hz, delay_chips, 45.0, 2.0, bits, 0);
+
+    Dll_Pll_Conf conf;
+    conf.fs_in = fs_in;
+    conf.vector_length = std::round(fs_in * Galileo_E1_C_Dll_Pll_Traits::code_period_s());
+    conf.pll_bw_hz = 15.0;
+    conf.dll_bw_hz = 2.0;
+    conf.pll_bw_narrow_hz = 15.0;
+    conf.dll_bw_narrow_hz = 2.0;
+    conf.early_late_space_chips = 0.15;
+    conf.very_early_late_space_chips = 0.6;
+    conf.extend_correlation_ms = 100;
+    // Every coherent integration is monitored, to follow its length
+    conf.monitor_taps = 3;
+    conf.monitor_period = 1;
+    double acq_delay_samples = delay_chips * fs_in / Galileo_E1_CODE_CHIP_RATE_HZ;
+    DllPllTrackingTest_msg_rx_sptr msg_rx = DllPllTrackingTest_msg_rx_make();
+    std::vector<Gnss_Synchro> outputs = dll_pll_test_track<Galileo_E1_C_Dll_Pll_Traits>(conf, samples, acq_delay_samples, doppler_hz + 10.0, msg_rx);
+
+    // The integration is extended in steps of four code periods, up to 100 ms,
+    // and never shortened
+    std::vector<double> integration_times_s;
+    for (size_t k = 0; k < msg_rx->shapes.size(); k++)
+        {
+            if (integration_times_s.empty() || msg_rx->shapes[k].Integration_time_s != integration_times_s.back())
+                {
+                    integration_times_s.push_back(msg_rx->shapes[k].Integration_time_s);
+                }
+        }
+    ASSERT_EQ(4u, integration_times_s.size());
+    EXPECT_NEAR(0.004, integration_times_s[0], 1e-9);
+    EXPECT_NEAR(0.016, integration_times_s[1], 1e-9);
+    EXPECT_NEAR(0.064, integration_times_s[2], 1e-9);
+    EXPECT_NEAR(0.1, integration_times_s[3], 1e-9);
+    EXPECT_EQ(0, msg_rx->rx_message);
+    dll_pll_test_check<Galileo_E1_C_Dll_Pll_Traits>(outputs, doppler_hz, delay_chips, bits);
+}
+
+
+TEST(Dll_Pll_Tracking_Test, GalileoE1cLossOfLockAtExtendedIntegration)
+{
+    // The signal is tracked with 100 ms integrations when it disappears
+    double fs_in = 4000000.0;
+    double doppler_hz = -1200.0;
+    double delay_chips = 3000.7;
+    double signal_s = 1.2;
+    std::vector<int> bits = dll_pll_test_bits(100);
+    std::vector<gr_complex> samples = dll_pll_test_signal<Galileo_E1_C_Dll_Pll_Traits>(fs_in, doppler_hz, delay_chips, 45.0, signal_s, bits, 0);
+    std::vector<gr_complex> noise = dll_pll_test_signal<Galileo_E1_C_Dll_Pll_Traits>(fs_in, doppler_hz, delay_chips, -100.0, 2.8, bits, 0);
+    samples.insert(samples.end(), noise.begin(), noise.end());
+
+    Dll_Pll_Conf conf;
+    conf.fs_in = fs_in;
+    conf.vector_length = std::round(fs_in * Galileo_E1_C_Dll_Pll_Traits::code_period_s());
+    conf.pll_bw_hz = 15.0;
+    conf.dll_bw_hz = 2.0;
+    conf.pll_bw_narrow_hz = 5.0;
+    conf.dll_bw_narrow_hz = 1.0;
+    conf.early_late_space_chips = 0.15;
+    conf.very_early_late_space_chips = 0.6;
+    conf.extend_correlation_ms = 100;
+    // Lock estimates of 40 ms with one code period integrations: a loss of
+    // lock is declared after 50 of them, 2 s
+    conf.cn0_samples = 10;
+    conf.monitor_taps = 3;
+    conf.monitor_period = 1;
+    double acq_delay_samples = delay_chips * fs_in / Galileo_E1_CODE_CHIP_RATE_HZ;
+    DllPllTrackingTest_msg_rx_sptr msg_rx = DllPllTrackingTest_msg_rx_make();
+    std::vector<Gnss_Synchro> outputs = dll_pll_test_track<Galileo_E1_C_Dll_Pll_Traits>(conf, samples, acq_delay_samples, doppler_hz, msg_rx);
+
+    // Fully extended before the signal disappears, and back to one code period after
+    size_t last_signal_shape = 0;
+    while (last_signal_shape < msg_rx->shapes.size() && msg_rx->shapes[last_signal_shape].Tracking_timestamp_secs < signal_s - 0.1)
+        {
+            last_signal_shape++;
+        }
+    ASSERT_LT(last_signal_shape, msg_rx->shapes.size());
+    EXPECT_NEAR(0.1, msg_rx->shapes[last_signal_shape].Integration_time_s, 1e-9);
+    EXPECT_NEAR(0.004, msg_rx->shapes.back().Integration_time_s, 1e-9);
+
+    // The loss of lock takes about as long as with one code period integrations
+    EXPECT_EQ(3, msg_rx->rx_message);
+    size_t lost = 0;
+    while (lost < outputs.size() && (outputs[lost].Tracking_timestamp_secs < signal_s || outputs[lost].Flag_valid_symbol_output))
+        {
+            lost++;
+        }
+    ASSERT_LT(lost, outputs.size());
+    double loss_time_s = outputs[lost].Tracking_timestamp_secs - signal_s;
+    EXPECT_GT(loss_time_s, 1.5);
+    EXPECT_LT(loss_time_s, 2.6);
+}
+
+
+TEST(Dll_Pll_Tracking_Test, GalileoE5aCorrelationShape)
+{
+    double fs_in = 12000000.0;
+    double doppler_hz = 700.0;
+    double delay_chips = 8000.4;
+    std::vector<int> bits = dll_pll_test_bits(100);
+    std::vector<gr_complex> samples = dll_pll_test_signal<Galileo_E5a_Dll_Pll_Traits>(fs_in, doppler_hz, delay_chips, 45.0, 0.6, bits, 0);
+
+    Dll_Pll_Conf conf;
+    conf.fs_in = fs_in;
+    conf.vector_length = std::round(fs_in * Galileo_E5a_Dll_Pll_Traits::code_period_s());
+    conf.pll_bw_hz = 20.0;
+    conf.dll_bw_hz = 20.0;
+    conf.pll_bw_narrow_hz = 5.0;
+    // The DLL stays wide, to settle well within the signal
+    conf.dll_bw_narrow_hz = 20.0;
+    conf.early_late_space_chips = 0.5;
+    // From -1 to +1 chip around the prompt, every code period
+    const int taps = 21;
+    const int center = taps / 2;
+    const double spacing_chips = 0.1;
+    conf.monitor_taps = taps;
+    conf.monitor_spacing_chips = spacing_chips;
+    conf.monitor_period = 1;
+    double acq_delay_samples = (delay_chips - 0.2) * fs_in / Galileo_E5a_CODE_CHIP_RATE_HZ;
+    DllPllTrackingTest_msg_rx_sptr msg_rx = DllPllTrackingTest_msg_rx_make();
+    std::vector<Gnss_Synchro> outputs = dll_pll_test_track<Galileo_E5a_Dll_Pll_Traits>(conf, samples, acq_delay_samples, doppler_hz, msg_rx);
+    dll_pll_test_check<Galileo_E5a_Dll_Pll_Traits>(outputs, doppler_hz, delay_chips, bits);
+
+    // The shapes of the last 200 ms, with the secondary code wiped off, are
+    // averaged coherently to lower the noise
+    ASSERT_GT(msg_rx->shapes.size(), 400u);
+    std::vector<gr_complex> shape(taps, gr_complex(0, 0));
+    EXPECT_EQ('E', msg_rx->shapes.back().System);
+    EXPECT_EQ(dll_pll_test_prn, msg_rx->shapes.back().PRN);
+    EXPECT_NEAR(spacing_chips, msg_rx->shapes.back().Spacing_chips, 1e-6);
+    EXPECT_NEAR(Galileo_E5a_Dll_Pll_Traits::code_period_s(), msg_rx->shapes.back().Integration_time_s, 1e-9);
+    for (size_t k = msg_rx->shapes.size() - 200; k < msg_rx->shapes.size(); k++)
+        {
+            ASSERT_EQ(static_cast<size_t>(taps), msg_rx->shapes[k].Correlation.size());
+            for (int n = 0; n < taps; n++)
+                {
+                    shape[n] += msg_rx->shapes[k].Correlation[n];
+                }
+        }
+
+    // The code is tracked at the right delay, so the shape peaks at the prompt
+    // and follows the triangle of the BPSK code autocorrelation on both sides
+    int peak = std::max_element(shape.begin(), shape.end(),
+            [](const gr_complex& a, const gr_complex& b) { return std::abs(a) < std::abs(b); }) - shape.begin();
+    EXPECT_EQ(center, peak);
+    for (int n = 0; n < taps; n++)
+        {
+            double offset_chips = (n - center) * spacing_chips;
+            double triangle = std::max(0.0, 1.0 - std::abs(offset_chips));
+            EXPECT_NEAR(triangle, std::abs(shape[n]) / std::abs(shape[center]), 0.1) << "tap " << n;
+            EXPECT_NEAR(std::abs(shape[n]), std::abs(shape[taps - 1 - n]), 0.05 * std::abs(shape[center])) << "tap " << n;
+        }
+}
+
+
+TEST(Dll_Pll_Tracking_Test, EvenMonitorTaps)
+{
+    // An even number of monitor taps is rounded up, so that the prompt stays in the middle
+    double fs_in = 12000000.0;
+    std::vector<int> bits = dll_pll_test_bits(100);
+    std::vector<gr_complex> samples = dll_pll_test_signal<Galileo_E5a_Dll_Pll_Traits>(fs_in, 0.0, 100.0, 45.0, 0.05, bits, 0);
+
+    Dll_Pll_Conf conf;
+    conf.fs_in = fs_in;
+    conf.vector_length = std::round(fs_in * Galileo_E5a_Dll_Pll_Traits::code_period_s());
+    conf.monitor_taps = 20;
+    conf.monitor_period = 1;
+    double acq_delay_samples = 100.0 * fs_in / Galileo_E5a_CODE_CHIP_RATE_HZ;
+    DllPllTrackingTest_msg_rx_sptr msg_rx = DllPllTrackingTest_msg_rx_make();
+    dll_pll_test_track<Galileo_E5a_Dll_Pll_Traits>(conf, samples, acq_delay_samples, 0.0, msg_rx);
+    ASSERT_FALSE(msg_rx->shapes.empty());
+    EXPECT_EQ(21u, msg_rx->shapes.back().Correlation.size());
+}
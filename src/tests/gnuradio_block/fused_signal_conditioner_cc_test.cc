@@ -0,0 +1,102 @@
+/*!
+ * \file fused_signal_conditioner_cc_test.cc
+ * \brief  Runs the fused signal conditioner on a tone and checks its output.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <gnuradio/top_block.h>
+#include <gnuradio/blocks/vector_source_s.h>
+#include <gnuradio/blocks/vector_sink_c.h>
+#include "fused_signal_conditioner_cc.h"
+
+
+TEST(Fused_Signal_Conditioner_Test, ToneTest)
+{
+    double fs_in = 8000000.0;
+    double intermediate_freq = 1200000.0;
+    double fs_out = 2048000.0;
+    double f_tone = 100000.0;
+    unsigned int decimation = 2;
+    unsigned int nsamples = 400000;
+
+    // Interleaved short samples of a tone placed f_tone above the IF
+    std::vector<short> samples(2 * nsamples);
+    for (unsigned int i = 0; i < nsamples; i++)
+        {
+            std::complex<double> c = std::polar<double>(1000.0, 2.0 * M_PI * (intermediate_freq + f_tone) * static_cast<double>(i) / fs_in);
+            samples[2 * i] = static_cast<short>(std::round(c.real()));
+            samples[2 * i + 1] = static_cast<short>(std::round(c.imag()));
+        }
+
+    // Hamming-windowed low-pass filter with unit DC gain, cutoff at 0.2 fs_in
+    unsigned int ntaps = 31;
+    std::vector<float> taps(ntaps);
+    double sum = 0.0;
+    for (unsigned int k = 0; k < ntaps; k++)
+        {
+            double t = static_cast<double>(k) - static_cast<double>(ntaps - 1) / 2.0;
+            double sinc = (t == 0.0) ? 0.4 : std::sin(2.0 * M_PI * 0.2 * t) / (M_PI * t);
+            taps[k] = sinc * (0.54 - 0.46 * std::cos(2.0 * M_PI * static_cast<double>(k) / static_cast<double>(ntaps - 1)));
+            sum += taps[k];
+        }
+    for (unsigned int k = 0; k < ntaps; k++)
+        {
+            taps[k] = taps[k] / sum;
+        }
+
+    gr::top_block_sptr top_block = gr::make_top_block("fused_signal_conditioner_test");
+    gr::blocks::vector_source_s::sptr source = gr::blocks::vector_source_s::make(samples);
+    fused_signal_conditioner_cc_sptr conditioner = fused_signal_conditioner_make_cc("ishort", taps, decimation,
+            intermediate_freq, fs_in, fs_out, 0.8, 0, 4096);
+    gr::blocks::vector_sink_c::sptr sink = gr::blocks::vector_sink_c::make();
+
+    top_block->connect(source, 0, conditioner, 0);
+    top_block->connect(conditioner, 0, sink, 0);
+    EXPECT_NO_THROW( {
+        top_block->run();
+        top_block->stop();
+    }) << "Failure running fused_signal_conditioner.";
+
+    std::vector<gr_complex> output = sink->data();
+    // Stage histories are not flushed, so allow some slack on the output count
+    double expected = static_cast<double>(nsamples) * fs_out / fs_in;
+    EXPECT_GE(static_cast<double>(output.size()), 0.99 * expected);
+    EXPECT_LE(static_cast<double>(output.size()), expected + 1.0);
+
+    // The tone must appear at f_tone after mixing, filtering and resampling
+    std::complex<double> phase_acc(0.0, 0.0);
+    for (unsigned int i = 200; i < output.size(); i++)
+        {
+            phase_acc += std::complex<double>(output[i] * std::conj(output[i - 1]));
+        }
+    double f_measured = std::arg(phase_acc) * fs_out / (2.0 * M_PI);
+    EXPECT_NEAR(f_tone, f_measured, 1.0);
+}
@@ -0,0 +1,157 @@
+/*!
+ * \file gnss_sdr_sample_ring_test.cc
+ * \brief  Tests the sample ring shared by the channels and its GNU Radio blocks.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <gnuradio/top_block.h>
+#include <gnuradio/blocks/vector_source_s.h>
+#include <gnuradio/blocks/vector_sink_s.h>
+#include "gnss_sample_ring.h"
+#include "gnss_sdr_sample_ring_sink.h"
+#include "gnss_sdr_sample_ring_source.h"
+
+
+TEST(Gnss_Sample_Ring_Test, ReadersAndOverrun)
+{
+    Gnss_Sample_Ring ring(sizeof(int), 1000, 16, false);
+    EXPECT_EQ(1024, ring.capacity());
+
+    unsigned int fast = ring.add_reader();
+    unsigned int slow = ring.add_reader();
+    std::vector<int> data(700);
+    std::vector<int> out(700);
+    uint64_t lost = 0;
+    int next = 0;
+    for (unsigned int i = 0; i < data.size(); i++) data[i] = next++;
+    ring.write(data.data(), data.size());
+
+    // Both readers see the same samples through their own cursors
+    ASSERT_EQ(700, ring.read(fast, out.data(), 700, lost));
+    EXPECT_EQ(0, lost);
+    EXPECT_EQ(699, out[699]);
+    ASSERT_EQ(100, ring.read(slow, out.data(), 100, lost));
+    EXPECT_EQ(99, out[99]);
+    EXPECT_EQ(0, ring.available(fast));
+    EXPECT_EQ(600, ring.available(slow));
+
+    // Historical access and contiguous peek across the wrap point
+    std::vector<int> snapshot(10);
+    EXPECT_TRUE(ring.read_at(500, snapshot.data(), 10));
+    EXPECT_EQ(509, snapshot[9]);
+    for (unsigned int i = 0; i < data.size(); i++) data[i] = next++;
+    ring.write(data.data(), data.size());
+    const int* window = static_cast<const int*>(ring.peek(1020));
+    EXPECT_EQ(1035, window[15]);
+    EXPECT_TRUE(ring.is_valid(1020));
+
+    // The slow reader has been lapped: it skips to the live data
+    EXPECT_FALSE(ring.read_at(0, snapshot.data(), 10));
+    ASSERT_EQ(0, ring.read(slow, out.data(), 100, lost));
+    EXPECT_EQ(1300, lost);
+    EXPECT_EQ(1300, ring.overrun_items(slow));
+    EXPECT_EQ(1400, ring.cursor(slow));
+    ASSERT_EQ(700, ring.read(fast, out.data(), 700, lost));
+    EXPECT_EQ(0, lost);
+    EXPECT_EQ(1399, out[699]);
+}
+
+
+TEST(Gnss_Sample_Ring_Test, ZeroFilledOverrun)
+{
+    Gnss_Sample_Ring ring(sizeof(int), 1000, 16, false);
+    unsigned int reader = ring.add_reader();
+    std::vector<int> data(700);
+    std::vector<int> out(2000);
+    uint64_t lost = 0;
+    int next = 1;
+    for (unsigned int i = 0; i < data.size(); i++) data[i] = next++;
+    ring.write(data.data(), data.size());
+    ASSERT_EQ(100, ring.read_zero_filled(reader, out.data(), 100, lost));
+    EXPECT_EQ(0, lost);
+    EXPECT_EQ(100, out[99]);
+    for (int k = 0; k < 2; k++)
+        {
+            for (unsigned int i = 0; i < data.size(); i++) data[i] = next++;
+            ring.write(data.data(), data.size());
+        }
+
+    // The lapped samples come out as zeros, and the live data follows them
+    // at the position of its stamp
+    unsigned int total = 0;
+    uint64_t total_lost = 0;
+    while (total < 2000)
+        {
+            unsigned int n = ring.read_zero_filled(reader, out.data() + total, 2000 - total, lost);
+            total_lost += lost;
+            if (n == 0 && lost == 0) break;
+            total += n;
+        }
+    ASSERT_EQ(2000, total);
+    EXPECT_EQ(ring.overrun_items(reader), total_lost);
+    EXPECT_EQ(2100, ring.cursor(reader));
+    for (unsigned int i = 0; i < total_lost; i++)
+        {
+            ASSERT_EQ(0, out[i]);
+        }
+    for (unsigned int i = total_lost; i < total; i++)
+        {
+            ASSERT_EQ(static_cast<int>(100 + i + 1), out[i]);
+        }
+}
+
+
+TEST(Gnss_Sample_Ring_Test, FlowgraphTest)
+{
+    unsigned int nsamples = 100000;
+    std::vector<short> data(nsamples);
+    for (unsigned int i = 0; i < nsamples; i++) data[i] = static_cast<short>(i);
+
+    std::shared_ptr<Gnss_Sample_Ring> ring = std::make_shared<Gnss_Sample_Ring>(sizeof(short), 1 << 20, 4096, false);
+    gr::top_block_sptr top_block = gr::make_top_block("gnss_sdr_sample_ring_test");
+    gr::blocks::vector_source_s::sptr source = gr::blocks::vector_source_s::make(data);
+    gnss_sdr_sample_ring_sink_sptr ring_sink = gnss_sdr_make_sample_ring_sink(ring);
+    gnss_sdr_sample_ring_source_sptr reader_a = gnss_sdr_make_sample_ring_source(ring);
+    gnss_sdr_sample_ring_source_sptr reader_b = gnss_sdr_make_sample_ring_source(ring);
+    gr::blocks::vector_sink_s::sptr sink_a = gr::blocks::vector_sink_s::make();
+    gr::blocks::vector_sink_s::sptr sink_b = gr::blocks::vector_sink_s::make();
+
+    top_block->connect(source, 0, ring_sink, 0);
+    top_block->connect(reader_a, 0, sink_a, 0);
+    top_block->connect(reader_b, 0, sink_b, 0);
+    EXPECT_NO_THROW( {
+        top_block->run();
+        top_block->stop();
+    }) << "Failure running the sample ring.";
+
+    EXPECT_EQ(data, sink_a->data());
+    EXPECT_EQ(data, sink_b->data());
+    EXPECT_EQ(0, ring->overrun_items(reader_a->reader()));
+}
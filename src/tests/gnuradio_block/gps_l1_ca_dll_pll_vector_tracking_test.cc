@@ -0,0 +1,321 @@
+/*!
+ * \file gps_l1_ca_dll_pll_vector_tracking_test.cc
+ * \brief Tests the handling of the PVT aids by the GPS L1 C/A vector
+ * tracking block: use, rejection, coasting and timeout
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2016  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <random>
+#include <vector>
+#include <boost/any.hpp>
+#include <boost/bind.hpp>
+#include <glog/logging.h>
+#include <gnuradio/top_block.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#include "gps_l1_ca_dll_pll_vector_tracking_cc.h"
+#include "gps_sdr_signal_processing.h"
+#include "gnss_synchro.h"
+#include "gnss_vector_aid.h"
+#include "GPS_L1_CA.h"
+
+
+// ######## GNURADIO BLOCK EMULATING THE PVT #########
+class VectorTrackingTest_pvt;
+
+typedef boost::shared_ptr<VectorTrackingTest_pvt> VectorTrackingTest_pvt_sptr;
+
+VectorTrackingTest_pvt_sptr VectorTrackingTest_pvt_make(double aid_doppler_hz, double bad_aid_doppler_hz,
+        double bad_aid_start_s, double aid_stop_s);
+
+/*
+ * Keeps the tracking outputs and the last event of the block, and sends it
+ * an aid every 100 outputs, as the PVT block would. The predicted Doppler is
+ * aid_doppler_hz until bad_aid_start_s, and bad_aid_doppler_hz after. No aid
+ * is sent after aid_stop_s.
+ */
+class VectorTrackingTest_pvt : public gr::block
+{
+private:
+    friend VectorTrackingTest_pvt_sptr VectorTrackingTest_pvt_make(double aid_doppler_hz, double bad_aid_doppler_hz,
+            double bad_aid_start_s, double aid_stop_s);
+    void msg_handler_events(pmt::pmt_t msg);
+    VectorTrackingTest_pvt(double aid_doppler_hz, double bad_aid_doppler_hz, double bad_aid_start_s, double aid_stop_s);
+    double d_aid_doppler_hz;
+    double d_bad_aid_doppler_hz;
+    double d_bad_aid_start_s;
+    double d_aid_stop_s;
+
+public:
+    int rx_message;
+    double rx_message_timestamp_s;
+    std::vector<Gnss_Synchro> outputs;
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+            gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
+    ~VectorTrackingTest_pvt(); //!< Default destructor
+};
+
+VectorTrackingTest_pvt_sptr VectorTrackingTest_pvt_make(double aid_doppler_hz, double bad_aid_doppler_hz,
+        double bad_aid_start_s, double aid_stop_s)
+{
+    return VectorTrackingTest_pvt_sptr(new VectorTrackingTest_pvt(aid_doppler_hz, bad_aid_doppler_hz, bad_aid_start_s, aid_stop_s));
+}
+
+void VectorTrackingTest_pvt::msg_handler_events(pmt::pmt_t msg)
+{
+    try
+    {
+            long int message = pmt::to_long(msg);
+            rx_message = message;
+            if (!outputs.empty()) rx_message_timestamp_s = outputs.back().Tracking_timestamp_secs;
+    }
+    catch(boost::bad_any_cast& e)
+    {
+            LOG(WARNING) << "msg_handler_events Bad any cast!";
+            rx_message = 0;
+    }
+}
+
+int VectorTrackingTest_pvt::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items, gr_vector_void_star &output_items __attribute__((unused)))
+{
+    const Gnss_Synchro *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);
+    for (int i = 0; i < ninput_items[0]; i++)
+        {
+            outputs.push_back(in[i]);
+            double timestamp_s = in[i].Tracking_timestamp_secs;
+            if (in[i].Flag_valid_symbol_output and outputs.size() % 100 == 0 and timestamp_s < d_aid_stop_s)
+                {
+                    std::shared_ptr<Gnss_Vector_Aid> aid = std::make_shared<Gnss_Vector_Aid>();
+                    aid->System = 'G';
+                    aid->PRN = in[i].PRN;
+                    aid->Channel_ID = in[i].Channel_ID;
+                    aid->Tracking_timestamp_secs = timestamp_s;
+                    aid->Carrier_Doppler_hz = timestamp_s < d_bad_aid_start_s ? d_aid_doppler_hz : d_bad_aid_doppler_hz;
+                    aid->Code_error_m = 0.0;
+                    this->message_port_pub(pmt::mp("vector_aid"), pmt::make_any(aid));
+                }
+        }
+    consume_each(ninput_items[0]);
+    return 0;
+}
+
+VectorTrackingTest_pvt::VectorTrackingTest_pvt(double aid_doppler_hz, double bad_aid_doppler_hz,
+        double bad_aid_start_s, double aid_stop_s) :
+            gr::block("VectorTrackingTest_pvt", gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)), gr::io_signature::make(0, 0, 0))
+{
+    this->message_port_register_in(pmt::mp("events"));
+    this->set_msg_handler(pmt::mp("events"), boost::bind(&VectorTrackingTest_pvt::msg_handler_events, this, _1));
+    this->message_port_register_out(pmt::mp("vector_aid"));
+    d_aid_doppler_hz = aid_doppler_hz;
+    d_bad_aid_doppler_hz = bad_aid_doppler_hz;
+    d_bad_aid_start_s = bad_aid_start_s;
+    d_aid_stop_s = aid_stop_s;
+    rx_message = 0;
+    rx_message_timestamp_s = 0.0;
+}
+
+VectorTrackingTest_pvt::~VectorTrackingTest_pvt()
+{}
+
+// ###########################################################
+
+
+namespace
+{
+const unsigned int vector_tracking_test_prn = 7;
+const double vector_tracking_test_fs = 2048000.0;
+const double vector_tracking_test_doppler_hz = 1250.0;
+const double vector_tracking_test_delay_chips = 300.4;
+const double vector_tracking_test_signal_s = 1.0; // the signal is blocked after it
+const double vector_tracking_test_aid_timeout_s = 1.0;
+
+/*
+ * GPS L1 C/A samples at 45 dB-Hz, blocked after vector_tracking_test_signal_s,
+ * in white noise
+ */
+std::vector<gr_complex> vector_tracking_test_signal(double duration_s)
+{
+    std::vector<gr_complex> code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_complex(code.data(), vector_tracking_test_prn, 0);
+    const double fs = vector_tracking_test_fs;
+    const double doppler_hz = vector_tracking_test_doppler_hz;
+    const double code_rate_hz = GPS_L1_CA_CODE_RATE_HZ * (1.0 + doppler_hz / GPS_L1_FREQ_HZ);
+    const float amplitude = std::sqrt(std::pow(10.0, 45.0 / 10.0) / fs);
+    std::mt19937 generator(7);
+    std::normal_distribution<float> noise(0.0, std::sqrt(0.5));
+
+    std::vector<gr_complex> samples(static_cast<size_t>(duration_s * fs));
+    for (size_t n = 0; n < samples.size(); n++)
+        {
+            samples[n] = gr_complex(noise(generator), noise(generator));
+            double t = static_cast<double>(n) / fs;
+            if (t < vector_tracking_test_signal_s)
+                {
+                    double chips = t * code_rate_hz + GPS_L1_CA_CODE_LENGTH_CHIPS - vector_tracking_test_delay_chips;
+                    long chip = static_cast<long>(std::floor(chips)) % static_cast<long>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+                    double phase_rad = 2.0 * M_PI * doppler_hz * t + 0.3;
+                    samples[n] += code[chip].real() * std::polar(amplitude, static_cast<float>(phase_rad));
+                }
+        }
+    return samples;
+}
+
+
+/*
+ * Tracks the samples with the aids of pvt, and returns the tracking outputs
+ */
+std::vector<Gnss_Synchro> vector_tracking_test_track(const std::vector<gr_complex>& samples, VectorTrackingTest_pvt_sptr pvt)
+{
+    Gnss_Synchro gnss_synchro = Gnss_Synchro();
+    gnss_synchro.Channel_ID = 0;
+    gnss_synchro.System = 'G';
+    std::string signal = "1C";
+    signal.copy(gnss_synchro.Signal, 2, 0);
+    gnss_synchro.PRN = vector_tracking_test_prn;
+    // Acquisition errors of 0.2 chips and 10 Hz
+    gnss_synchro.Acq_delay_samples = (vector_tracking_test_delay_chips + 0.2) * vector_tracking_test_fs / GPS_L1_CA_CODE_RATE_HZ;
+    gnss_synchro.Acq_doppler_hz = vector_tracking_test_doppler_hz + 10.0;
+    gnss_synchro.Acq_samplestamp_samples = 0;
+
+    gr::top_block_sptr top_block = gr::make_top_block("vector_tracking_test");
+    gr::blocks::vector_source_c::sptr source = gr::blocks::vector_source_c::make(samples);
+    gps_l1_ca_dll_pll_vector_tracking_cc_sptr tracking = gps_l1_ca_dll_pll_make_vector_tracking_cc(0,
+            vector_tracking_test_fs, std::round(vector_tracking_test_fs * GPS_L1_CA_CODE_PERIOD), false, "",
+            50.0, 2.0, 0.5, 0.5, 1.0, 2.0, vector_tracking_test_aid_timeout_s, 10.0, 100.0);
+    tracking->set_channel(gnss_synchro.Channel_ID);
+    tracking->set_gnss_synchro(&gnss_synchro);
+    top_block->connect(source, 0, tracking, 0);
+    top_block->connect(tracking, 0, pvt, 0);
+    top_block->msg_connect(tracking, pmt::mp("events"), pvt, pmt::mp("events"));
+    top_block->msg_connect(pvt, pmt::mp("vector_aid"), tracking, pmt::mp("vector_aid"));
+    tracking->start_tracking();
+    EXPECT_NO_THROW( {
+        top_block->run();
+        top_block->stop();
+    }) << "Failure running the vector tracking block.";
+    return pvt->outputs;
+}
+
+
+// Timestamp of the first output after the loss of lock
+double vector_tracking_test_loss_s(const std::vector<Gnss_Synchro>& outputs)
+{
+    for (size_t k = 1; k < outputs.size(); k++)
+        {
+            if (!outputs[k].Flag_valid_symbol_output) return outputs[k].Tracking_timestamp_secs;
+        }
+    return outputs.back().Tracking_timestamp_secs;
+}
+}
+
+
+TEST(Gps_L1_Ca_Dll_Pll_Vector_Tracking_Test, UnaidedLossOfLock)
+{
+    // Reference for the aided cases: the lock is lost a while after the signal
+    std::vector<gr_complex> samples = vector_tracking_test_signal(4.0);
+    VectorTrackingTest_pvt_sptr pvt = VectorTrackingTest_pvt_make(0.0, 0.0, 0.0, 0.0);
+    std::vector<Gnss_Synchro> outputs = vector_tracking_test_track(samples, pvt);
+    ASSERT_GT(outputs.size(), 3000u);
+    double doppler_hz = 0.0;
+    for (size_t k = 500; k < 900; k++)
+        {
+            doppler_hz += outputs[k].Carrier_Doppler_hz / 400.0;
+        }
+    EXPECT_NEAR(vector_tracking_test_doppler_hz, doppler_hz, 3.0);
+    EXPECT_EQ(3, pvt->rx_message);
+    double loss_s = vector_tracking_test_loss_s(outputs);
+    EXPECT_GT(loss_s, vector_tracking_test_signal_s + 0.3);
+    EXPECT_LT(loss_s, vector_tracking_test_signal_s + 2.5);
+}
+
+
+TEST(Gps_L1_Ca_Dll_Pll_Vector_Tracking_Test, CoastingAndAidTimeout)
+{
+    // The aids predict the Doppler 30 Hz away, within the accepted error, until
+    // well after the unaided loss of lock
+    const double aid_doppler_hz = vector_tracking_test_doppler_hz + 30.0;
+    const double aid_stop_s = 4.5;
+    std::vector<gr_complex> samples = vector_tracking_test_signal(6.5);
+    VectorTrackingTest_pvt_sptr pvt = VectorTrackingTest_pvt_make(aid_doppler_hz, aid_doppler_hz, aid_stop_s, aid_stop_s);
+    std::vector<Gnss_Synchro> outputs = vector_tracking_test_track(samples, pvt);
+    ASSERT_GT(outputs.size(), 6000u);
+
+    // The channel coasts on the predicted Doppler: the PLL is reset to it at each aid
+    int coast_aids = 0;
+    for (size_t k = 1; k < outputs.size(); k++)
+        {
+            double timestamp_s = outputs[k].Tracking_timestamp_secs;
+            if (timestamp_s < aid_stop_s)
+                {
+                    EXPECT_TRUE(outputs[k].Flag_valid_symbol_output) << "at " << timestamp_s << " s";
+                }
+            if (timestamp_s > aid_stop_s - 1.0 and timestamp_s < aid_stop_s
+                    and std::abs(outputs[k].Carrier_Doppler_hz - aid_doppler_hz) < 0.01)
+                {
+                    coast_aids++;
+                }
+        }
+    EXPECT_GE(coast_aids, 9);
+
+    // Without aids, the prediction is used until it times out
+    EXPECT_EQ(3, pvt->rx_message);
+    double loss_s = vector_tracking_test_loss_s(outputs);
+    EXPECT_GT(loss_s, aid_stop_s + vector_tracking_test_aid_timeout_s - 0.2);
+    EXPECT_LT(loss_s, aid_stop_s + vector_tracking_test_aid_timeout_s + 0.3);
+}
+
+
+TEST(Gps_L1_Ca_Dll_Pll_Vector_Tracking_Test, InconsistentAidRejected)
+{
+    // While coasting, the aids jump 500 Hz away from the tracked Doppler
+    const double aid_doppler_hz = vector_tracking_test_doppler_hz + 30.0;
+    const double bad_aid_doppler_hz = vector_tracking_test_doppler_hz + 500.0;
+    const double bad_aid_start_s = 4.0;
+    std::vector<gr_complex> samples = vector_tracking_test_signal(5.5);
+    VectorTrackingTest_pvt_sptr pvt = VectorTrackingTest_pvt_make(aid_doppler_hz, bad_aid_doppler_hz, bad_aid_start_s, 10.0);
+    std::vector<Gnss_Synchro> outputs = vector_tracking_test_track(samples, pvt);
+    ASSERT_GT(outputs.size(), 5000u);
+
+    // The channel coasts on the good aids, never on the wrong ones, and stops
+    // coasting when they arrive
+    int good_aids = 0;
+    int bad_aids = 0;
+    for (size_t k = 1; k < outputs.size(); k++)
+        {
+            if (std::abs(outputs[k].Carrier_Doppler_hz - aid_doppler_hz) < 0.01) good_aids++;
+            if (std::abs(outputs[k].Carrier_Doppler_hz - bad_aid_doppler_hz) < 0.01) bad_aids++;
+        }
+    EXPECT_GT(good_aids, 5);
+    EXPECT_EQ(0, bad_aids);
+    EXPECT_EQ(3, pvt->rx_message);
+    double loss_s = vector_tracking_test_loss_s(outputs);
+    EXPECT_GT(loss_s, bad_aid_start_s);
+    EXPECT_LT(loss_s, bad_aid_start_s + 0.3);
+}
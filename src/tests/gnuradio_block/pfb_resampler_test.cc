@@ -0,0 +1,126 @@
+/*!
+ * \file pfb_resampler_test.cc
+ * \brief  Executes the polyphase filterbank resampler based on some input parameters.
+ *
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include <complex>
+#include <ctime>
+#include <iostream>
+#include <vector>
+#include <gnuradio/top_block.h>
+#include <gnuradio/analog/sig_source_waveform.h>
+#include <gnuradio/analog/sig_source_c.h>
+#include <gnuradio/msg_queue.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#include <gnuradio/blocks/vector_sink_c.h>
+#include "gnss_sdr_valve.h"
+#include "pfb_resampler.h"
+
+
+TEST(Pfb_Resampler_Test, InstantiationAndRunTest)
+{
+    double fs_in = 25000000.0; // Input sampling frequency in Hz
+    double fs_out = 4000000.0; // sampling frequency of the resampled signal in Hz
+    struct timeval tv;
+    int nsamples = 1000000; //Number of samples to be computed
+    gr::msg_queue::sptr queue = gr::msg_queue::make(0);
+    gr::top_block_sptr top_block = gr::make_top_block("pfb_resampler_test");
+    boost::shared_ptr<gr::analog::sig_source_c> source = gr::analog::sig_source_c::make(fs_in, gr::analog::GR_SIN_WAVE, 1000.0, 1.0, gr_complex(0.0));
+    boost::shared_ptr<gr::block> valve = gnss_sdr_make_valve(sizeof(gr_complex), nsamples, queue);
+    long long int begin = 0;
+    long long int end = 0;
+
+    EXPECT_NO_THROW({
+        pfb_resampler_cc_sptr resampler = pfb_make_resampler_cc(fs_in, fs_out);
+    }) << "Failure in instantiation of pfb_resampler.";
+
+    pfb_resampler_cc_sptr resampler = pfb_make_resampler_cc(fs_in, fs_out);
+    gr::blocks::null_sink::sptr sink = gr::blocks::null_sink::make(sizeof(gr_complex));
+
+    EXPECT_NO_THROW( {
+        top_block->connect(source, 0, valve, 0);
+        top_block->connect(valve, 0, resampler, 0);
+        top_block->connect(resampler, 0, sink, 0);
+    }) << "Connection failure of pfb_resampler.";
+
+    EXPECT_NO_THROW( {
+        gettimeofday(&tv, NULL);
+        begin = tv.tv_sec *1000000 + tv.tv_usec;
+        top_block->run(); // Start threads and wait
+        gettimeofday(&tv, NULL);
+        end = tv.tv_sec *1000000 + tv.tv_usec;
+        top_block->stop();
+    }) << "Failure running pfb_resampler.";
+
+    std::cout <<  "Resampled " << nsamples << " samples in " << (end-begin) << " microseconds" << std::endl;
+}
+
+
+
+TEST(Pfb_Resampler_Test, ToneTest)
+{
+    double fs_in = 4000000.0;
+    double fs_out = 2048000.0;
+    double f_tone = 200000.0;
+    unsigned int nsamples = 400000;
+    std::vector<gr_complex> tone(nsamples);
+    for (unsigned int i = 0; i < nsamples; i++)
+        {
+            tone[i] = std::polar<float>(1.0, 2.0 * M_PI * f_tone * static_cast<double>(i) / fs_in);
+        }
+
+    gr::top_block_sptr top_block = gr::make_top_block("pfb_resampler_tone_test");
+    gr::blocks::vector_source_c::sptr source = gr::blocks::vector_source_c::make(tone);
+    pfb_resampler_cc_sptr resampler = pfb_make_resampler_cc(fs_in, fs_out);
+    gr::blocks::vector_sink_c::sptr sink = gr::blocks::vector_sink_c::make();
+
+    top_block->connect(source, 0, resampler, 0);
+    top_block->connect(resampler, 0, sink, 0);
+    EXPECT_NO_THROW( {
+        top_block->run();
+        top_block->stop();
+    }) << "Failure running pfb_resampler.";
+
+    std::vector<gr_complex> resampled = sink->data();
+    // The filter window is not flushed at the end of the stream
+    unsigned int expected = static_cast<unsigned int>(static_cast<double>(nsamples - resampler->taps_per_phase()) * fs_out / fs_in);
+    ASSERT_LE(resampled.size(), expected + 1);
+    ASSERT_GE(resampled.size(), expected - 1);
+
+    // In-band tone: unit amplitude and unchanged frequency after the filter transient
+    std::complex<double> phase_acc(0.0, 0.0);
+    for (unsigned int i = resampler->taps_per_phase(); i < resampled.size(); i++)
+        {
+            EXPECT_NEAR(1.0, std::abs(resampled[i]), 1e-2);
+            phase_acc += std::complex<double>(resampled[i] * std::conj(resampled[i - 1]));
+        }
+    double f_measured = std::arg(phase_acc) * fs_out / (2.0 * M_PI);
+    EXPECT_NEAR(f_tone, f_measured, 1.0);
+}
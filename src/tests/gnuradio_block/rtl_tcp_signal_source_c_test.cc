@@ -0,0 +1,83 @@
+/*!
+ * \file rtl_tcp_signal_source_c_test.cc
+ * \brief  Feeds the rtl_tcp signal source from a local TCP server.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+
+#include <complex>
+#include <cstring>
+#include <vector>
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+#include <gnuradio/top_block.h>
+#include <gnuradio/blocks/vector_sink_c.h>
+#include "rtl_tcp_signal_source_c.h"
+
+
+TEST(Rtl_Tcp_Signal_Source_Test, LocalServerTest)
+{
+    unsigned int nsamples = 200000;
+    std::vector<unsigned char> samples(2 * nsamples);
+    for (unsigned int i = 0; i < samples.size(); i++)
+        {
+            samples[i] = static_cast<unsigned char>((i * 7) & 0xff);
+        }
+
+    // Stand-in for rtl_tcp: sends the dongle info, then the samples, then closes the connection
+    boost::asio::io_service io_service;
+    boost::asio::ip::tcp::acceptor acceptor(io_service,
+            boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 0));
+    unsigned short port = acceptor.local_endpoint().port();
+    boost::thread server([&]()
+            {
+                boost::asio::ip::tcp::socket socket(io_service);
+                acceptor.accept(socket);
+                unsigned char header[12] = { 'R', 'T', 'L', '0', 0, 0, 0, 5, 0, 0, 0, 29 };
+                boost::asio::write(socket, boost::asio::buffer(header));
+                boost::asio::write(socket, boost::asio::buffer(samples));
+                socket.close();
+            });
+
+    rtl_tcp_signal_source_c_sptr source = rtl_tcp_make_signal_source_c("127.0.0.1", static_cast<short>(port), false, "gr_complex");
+    gr::blocks::vector_sink_c::sptr sink = gr::blocks::vector_sink_c::make();
+    gr::top_block_sptr top_block = gr::make_top_block("rtl_tcp_signal_source_test");
+    top_block->connect(source, 0, sink, 0);
+    EXPECT_NO_THROW( {
+        top_block->run();
+        top_block->stop();
+    }) << "Failure running rtl_tcp_signal_source_c.";
+    server.join();
+
+    std::vector<gr_complex> output = sink->data();
+    ASSERT_EQ(nsamples, output.size());
+    for (unsigned int i = 0; i < nsamples; i++)
+        {
+            EXPECT_FLOAT_EQ((static_cast<float>(samples[2 * i]) - 128.0f) / 128.0f, output[i].real());
+            EXPECT_FLOAT_EQ((static_cast<float>(samples[2 * i + 1]) - 128.0f) / 128.0f, output[i].imag());
+        }
+    EXPECT_EQ(0, source->overruns());
+}
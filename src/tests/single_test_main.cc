@@ -42,12 +42,15 @@
 #include "concurrent_map.h"
 #include "gps_navigation_message.h"
 #include "gps_ephemeris.h"
+#include "gps_almanac.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_cnav_iono.h"
 #include "gps_acq_assist.h"
 #include "gps_ref_location.h"
 #include "gps_ref_time.h"
+#include "gnss_synchro.h"
 #include "galileo_navigation_message.h"
+#include "galileo_ephemeris.h"
 #include "sbas_ionospheric_correction.h"
 #include "sbas_telemetry_data.h"
 #include "sbas_ephemeris.h"
@@ -56,6 +59,12 @@
 concurrent_queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
 
 concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
+concurrent_map<Gps_Ephemeris> global_gps_ephemeris_map;
+concurrent_map<Gps_Almanac> global_gps_almanac_map;
+concurrent_map<Galileo_Ephemeris> global_galileo_ephemeris_map;
+concurrent_map<Gps_Ref_Location> global_gps_ref_location_map;
+concurrent_map<Gps_Ref_Time> global_gps_ref_time_map;
+concurrent_map<Gnss_Synchro> global_channel_synchro_map;
 
 
 int main(int argc, char **argv)
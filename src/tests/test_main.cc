@@ -56,6 +56,9 @@
 #include "galileo_almanac.h"
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
+#include "gps_ref_location.h"
+#include "gps_ref_time.h"
+#include "gnss_synchro.h"
 
 #include "sbas_ephemeris.h"
 #include "sbas_telemetry_data.h"
@@ -75,15 +78,30 @@ DECLARE_string(log_dir);
 #include "arithmetic/multiply_test.cc"
 #include "arithmetic/code_generation_test.cc"
 #include "arithmetic/tracking_loop_filter_test.cc"
+#include "arithmetic/tracking_kalman_filter_test.cc"
+#include "arithmetic/tracking_lock_detector_test.cc"
 #include "arithmetic/fft_length_test.cc"
+#include "arithmetic/fft_planner_test.cc"
+#include "arithmetic/gnss_fft_test.cc"
+#include "arithmetic/code_bank_test.cc"
+#include "arithmetic/satellite_velocity_test.cc"
+#include "arithmetic/vector_aid_test.cc"
 #include "configuration/file_configuration_test.cc"
 #include "configuration/in_memory_configuration_test.cc"
+#include "configuration/property_table_test.cc"
 #include "control_thread/control_message_factory_test.cc"
 #include "control_thread/control_thread_test.cc"
+#include "control_thread/channel_event_queue_test.cc"
+#include "control_thread/concurrent_map_test.cc"
+#include "control_thread/parallel_for_test.cc"
 #include "flowgraph/pass_through_test.cc"
 #include "flowgraph/gnss_flowgraph_test.cc"
+#include "flowgraph/gnss_assistance_engine_test.cc"
+#include "flowgraph/gnss_signal_scheduler_test.cc"
 #include "formats/string_converter_test.cc"
 #include "formats/rtcm_test.cc"
+#include "formats/capture_replay_test.cc"
+#include "formats/receiver_state_test.cc"
 #include "gnss_block/gnss_block_factory_test.cc"
 #include "gnss_block/rtcm_printer_test.cc"
 #include "gnss_block/file_signal_source_test.cc"
@@ -113,6 +131,12 @@ DECLARE_string(log_dir);
 #include "gnss_block/galileo_e1_dll_pll_veml_tracking_test.cc"
 #include "gnuradio_block/gnss_sdr_valve_test.cc"
 #include "gnuradio_block/direct_resampler_conditioner_cc_test.cc"
+#include "gnuradio_block/pfb_resampler_test.cc"
+#include "gnuradio_block/fused_signal_conditioner_cc_test.cc"
+#include "gnuradio_block/gnss_sdr_sample_ring_test.cc"
+#include "gnuradio_block/rtl_tcp_signal_source_c_test.cc"
+#include "gnuradio_block/dll_pll_tracking_test.cc"
+#include "gnuradio_block/gps_l1_ca_dll_pll_vector_tracking_test.cc"
 #include "gnss_block/galileo_e5a_pcps_acquisition_gsoc2014_gensource_test.cc"
 #include "gnss_block/galileo_e5a_tracking_test.cc"
 #include "gnss_block/gps_l2_m_dll_pll_tracking_test.cc"
@@ -122,6 +146,12 @@ DECLARE_string(log_dir);
 
 concurrent_queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
 concurrent_map<Gps_Acq_Assist> global_gps_acq_assist_map;
+concurrent_map<Gps_Ephemeris> global_gps_ephemeris_map;
+concurrent_map<Gps_Almanac> global_gps_almanac_map;
+concurrent_map<Galileo_Ephemeris> global_galileo_ephemeris_map;
+concurrent_map<Gps_Ref_Location> global_gps_ref_location_map;
+concurrent_map<Gps_Ref_Time> global_gps_ref_time_map;
+concurrent_map<Gnss_Synchro> global_channel_synchro_map;
 
 int main(int argc, char **argv)
 {
@@ -0,0 +1,287 @@
+/*!
+ * \file capture_replay.cc
+ * \brief Replays a recorded capture by splitting it into time segments that
+ * are processed in parallel by independent GNSS-SDR instances.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "capture_replay.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <glog/logging.h>
+
+using google::LogMessage;
+
+CaptureReplay::CaptureReplay(std::string gnss_sdr, std::string config_file, std::string signal_source,
+        std::string output_dir, unsigned int jobs, double replay_speed) :
+        gnss_sdr_(gnss_sdr),
+        jobs_(jobs > 0 ? jobs : 1),
+        replay_speed_(replay_speed)
+{
+    // The receivers run in their own directories
+    config_file_ = boost::filesystem::absolute(config_file).string();
+    output_dir_ = boost::filesystem::absolute(output_dir).string();
+    if (!signal_source.empty())
+        {
+            signal_source_ = boost::filesystem::absolute(signal_source).string();
+        }
+    // execvp only searches the PATH for a bare name
+    if (gnss_sdr.find('/') != std::string::npos)
+        {
+            gnss_sdr_ = boost::filesystem::absolute(gnss_sdr).string();
+        }
+}
+
+
+std::vector<Replay_Segment> CaptureReplay::plan_segments(long long total_samples,
+        unsigned int segments, long long overlap_samples)
+{
+    std::vector<Replay_Segment> plan;
+    if ((segments == 0) || (total_samples <= 0))
+        {
+            return plan;
+        }
+    for (unsigned int k = 0; k < segments; k++)
+        {
+            // Nominal boundaries, computed from the total so that rounding errors do not accumulate
+            long long begin = (total_samples * k) / segments;
+            long long end = (total_samples * (k + 1)) / segments;
+            if (end <= begin)
+                {
+                    continue;
+                }
+            Replay_Segment segment;
+            segment.index = plan.size();
+            segment.warmup_samples = std::min(begin, overlap_samples);
+            segment.first_sample = begin - segment.warmup_samples;
+            segment.samples = end - segment.first_sample;
+            segment.directory = "segment_" + boost::lexical_cast<std::string>(segment.index);
+            plan.push_back(segment);
+        }
+    return plan;
+}
+
+
+unsigned int CaptureReplay::merge_rinex_obs(std::vector<std::istream*>& inputs, std::ostream& output)
+{
+    unsigned int epochs = 0;
+    bool header_written = false;
+    std::string last_epoch;
+    for (unsigned int i = 0; i < inputs.size(); i++)
+        {
+            std::string line;
+            bool in_header = true;
+            bool keep = false;
+            while (std::getline(*inputs.at(i), line))
+                {
+                    if (in_header)
+                        {
+                            if (!header_written)
+                                {
+                                    output << line << std::endl;
+                                }
+                            if (line.find("END OF HEADER") != std::string::npos)
+                                {
+                                    in_header = false;
+                                    header_written = true;
+                                }
+                            continue;
+                        }
+                    if ((line.size() > 0) && (line.at(0) == '>'))
+                        {
+                            // Epoch record: "> yyyy mm dd hh mm ss.sssssss". The fixed-width
+                            // time field sorts lexicographically
+                            std::string epoch = line.substr(0, std::min<size_t>(line.size(), 29));
+                            keep = last_epoch.empty() || (epoch.compare(last_epoch) > 0);
+                            if (keep)
+                                {
+                                    last_epoch = epoch;
+                                    epochs++;
+                                }
+                        }
+                    if (keep)
+                        {
+                            output << line << std::endl;
+                        }
+                }
+        }
+    return epochs;
+}
+
+
+int CaptureReplay::launch(const Replay_Segment& segment)
+{
+    boost::filesystem::path directory = boost::filesystem::path(output_dir_) / segment.directory;
+    boost::filesystem::create_directories(directory);
+
+    std::vector<std::string> args;
+    args.push_back(gnss_sdr_);
+    args.push_back("--config_file=" + config_file_);
+    if (!signal_source_.empty())
+        {
+            args.push_back("--signal_source=" + signal_source_);
+        }
+    args.push_back("--log_dir=" + directory.string());
+    args.push_back("--signal_source_first_sample=" + boost::lexical_cast<std::string>(segment.first_sample));
+    args.push_back("--signal_source_samples=" + boost::lexical_cast<std::string>(segment.samples));
+    if (replay_speed_ > 0.0)
+        {
+            args.push_back("--signal_source_replay_speed=" + boost::lexical_cast<std::string>(replay_speed_));
+        }
+
+    pid_t pid = fork();
+    if (pid == 0)
+        {
+            std::vector<char*> argv;
+            for (unsigned int i = 0; i < args.size(); i++)
+                {
+                    argv.push_back(const_cast<char*>(args.at(i).c_str()));
+                }
+            argv.push_back(nullptr);
+            // Discard the console output of the receivers, their logs are kept in the segment directory
+            if ((chdir(directory.c_str()) != 0) || (freopen("stdout.txt", "w", stdout) == nullptr))
+                {
+                    _exit(127);
+                }
+            execvp(argv.at(0), argv.data());
+            _exit(127);
+        }
+    if (pid < 0)
+        {
+            LOG(ERROR) << "Unable to start the receiver for segment " << segment.index;
+        }
+    else
+        {
+            LOG(INFO) << "Segment " << segment.index << ": samples " << segment.first_sample
+                      << " to " << segment.first_sample + segment.samples
+                      << " (" << segment.warmup_samples << " for warm-up), pid " << pid;
+        }
+    return pid;
+}
+
+
+bool CaptureReplay::run(std::vector<Replay_Segment>& segments)
+{
+    std::map<pid_t, unsigned int> running;
+    unsigned int next = 0;
+    bool success = true;
+    while ((next < segments.size()) || !running.empty())
+        {
+            while ((next < segments.size()) && (running.size() < jobs_))
+                {
+                    pid_t pid = launch(segments.at(next));
+                    if (pid < 0)
+                        {
+                            success = false;
+                        }
+                    else
+                        {
+                            running[pid] = next;
+                        }
+                    next++;
+                }
+            if (running.empty())
+                {
+                    continue;
+                }
+            int status = 0;
+            pid_t pid = waitpid(-1, &status, 0);
+            if (pid < 0)
+                {
+                    LOG(ERROR) << "Lost track of the receiver instances";
+                    return false;
+                }
+            std::map<pid_t, unsigned int>::iterator it = running.find(pid);
+            if (it == running.end())
+                {
+                    continue;
+                }
+            if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+                {
+                    LOG(WARNING) << "Receiver for segment " << it->second << " failed";
+                    success = false;
+                }
+            else
+                {
+                    LOG(INFO) << "Segment " << it->second << " done";
+                }
+            running.erase(it);
+        }
+    return success;
+}
+
+
+std::string CaptureReplay::find_obs_file(const std::string& directory)
+{
+    // RINEX observation files are named GSDRdddhmm.yyO
+    boost::filesystem::path path = boost::filesystem::path(output_dir_) / directory;
+    if (!boost::filesystem::is_directory(path))
+        {
+            return std::string();
+        }
+    for (boost::filesystem::directory_iterator it(path); it != boost::filesystem::directory_iterator(); ++it)
+        {
+            std::string name = it->path().filename().string();
+            if ((name.compare(0, 4, "GSDR") == 0) && (name.size() > 0) && (name.at(name.size() - 1) == 'O'))
+                {
+                    return it->path().string();
+                }
+        }
+    return std::string();
+}
+
+
+bool CaptureReplay::merge(const std::vector<Replay_Segment>& segments, const std::string& output_file)
+{
+    std::vector<std::ifstream*> files;
+    std::vector<std::istream*> inputs;
+    for (unsigned int i = 0; i < segments.size(); i++)
+        {
+            std::string filename = find_obs_file(segments.at(i).directory);
+            if (filename.empty())
+                {
+                    LOG(WARNING) << "No RINEX observation file for segment " << segments.at(i).index;
+                    continue;
+                }
+            files.push_back(new std::ifstream(filename.c_str()));
+            inputs.push_back(files.back());
+        }
+    std::ofstream output(output_file.c_str(), std::ios::out | std::ios::trunc);
+    unsigned int epochs = merge_rinex_obs(inputs, output);
+    for (unsigned int i = 0; i < files.size(); i++)
+        {
+            delete files.at(i);
+        }
+    LOG(INFO) << "Merged " << epochs << " epochs from " << inputs.size() << " segments into " << output_file;
+    return !inputs.empty();
+}
@@ -0,0 +1,104 @@
+/*!
+ * \file capture_replay.h
+ * \brief Replays a recorded capture by splitting it into time segments that
+ * are processed in parallel by independent GNSS-SDR instances.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CAPTURE_REPLAY_H_
+#define GNSS_SDR_CAPTURE_REPLAY_H_
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Portion of the capture processed by one receiver instance
+ */
+struct Replay_Segment
+{
+    unsigned int index;
+    long long first_sample;   //!< First sample read by the receiver, warm-up included
+    long long samples;        //!< Number of samples read by the receiver
+    long long warmup_samples; //!< Leading samples only used to acquire and lock the signals
+    std::string directory;    //!< Working directory of the receiver instance
+};
+
+
+/*!
+ * \brief Runs one GNSS-SDR process per segment of a capture file, at most
+ * \p jobs at a time, and merges their RINEX observation files.
+ *
+ * Segments overlap by a warm-up interval so that every receiver has already
+ * acquired the satellites and decoded the navigation data when its nominal
+ * segment starts. The merge keeps the epochs of each segment that are later
+ * than the last epoch written by the previous one.
+ */
+class CaptureReplay
+{
+public:
+    /*!
+     * \brief The receivers run in the directories of their segments, so the
+     * relative paths are resolved here, from the current working directory.
+     * A gnss_sdr without any directory is searched for in the PATH.
+     */
+    CaptureReplay(std::string gnss_sdr, std::string config_file, std::string signal_source,
+            std::string output_dir, unsigned int jobs, double replay_speed);
+
+    /*!
+     * \brief Splits total_samples into the given number of segments, each one
+     * extended backwards by overlap_samples (except the first one)
+     */
+    static std::vector<Replay_Segment> plan_segments(long long total_samples,
+            unsigned int segments, long long overlap_samples);
+
+    /*!
+     * \brief Concatenates RINEX 3 observation files in time order, keeping the
+     * header of the first one and dropping repeated epochs. Returns the number
+     * of epochs written.
+     */
+    static unsigned int merge_rinex_obs(std::vector<std::istream*>& inputs, std::ostream& output);
+
+    //! Runs all the segments. Returns true if every receiver instance succeeded.
+    bool run(std::vector<Replay_Segment>& segments);
+
+    //! Merges the observation files of the segments into output_file
+    bool merge(const std::vector<Replay_Segment>& segments, const std::string& output_file);
+
+private:
+    int launch(const Replay_Segment& segment);
+    std::string find_obs_file(const std::string& directory);
+
+    std::string gnss_sdr_;
+    std::string config_file_;
+    std::string signal_source_;
+    std::string output_dir_;
+    unsigned int jobs_;
+    double replay_speed_;
+};
+
+#endif /* GNSS_SDR_CAPTURE_REPLAY_H_ */
@@ -0,0 +1,147 @@
+/*!
+ * \file main.cc
+ * \brief Main file of the gnss-sdr-replay program, which reprocesses a
+ * capture file with several receiver instances running in parallel.
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2015  (see AUTHORS file for a list of contributors)
+ *
+ * GNSS-SDR is a software defined Global Navigation
+ *          Satellite Systems receiver
+ *
+ * This file is part of GNSS-SDR.
+ *
+ * GNSS-SDR is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GNSS-SDR is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNSS-SDR. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include "INIReader.h"
+#include "capture_replay.h"
+
+using google::LogMessage;
+
+DEFINE_string(config_file, "",
+        "Path to the configuration file of the receivers. It must use a File_Signal_Source");
+
+DEFINE_string(gnss_sdr, "gnss-sdr",
+        "Path to the gnss-sdr executable");
+
+DEFINE_string(output_dir, "./replay",
+        "Folder where the segments and the merged RINEX file are written");
+
+DEFINE_int32(segments, 0,
+        "Number of time segments in which the capture is split (0: one per CPU core)");
+
+DEFINE_int32(jobs, 0,
+        "Maximum number of receivers running at the same time (0: one per CPU core)");
+
+DEFINE_double(overlap_s, 60.0,
+        "Warm-up time prepended to every segment but the first one, in seconds");
+
+DEFINE_double(replay_speed, 0.0,
+        "Paces each receiver at this multiple of real time (0: as fast as possible)");
+
+
+int main(int argc, char** argv)
+{
+    google::SetUsageMessage("\ngnss-sdr-replay splits a capture file in time segments, processes them\n"
+            "with parallel GNSS-SDR instances and merges their RINEX observation files.\n");
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    INIReader config(FLAGS_config_file);
+    if (FLAGS_config_file.empty() || (config.ParseError() < 0))
+        {
+            std::cout << "Please provide a valid configuration file with --config_file" << std::endl;
+            return 1;
+        }
+
+    // Only the parameters needed to size the capture are read here
+    std::string filename = config.Get("GNSS-SDR", "SignalSource.filename", "");
+    std::string item_type = config.Get("GNSS-SDR", "SignalSource.item_type", "short");
+    double sampling_frequency = static_cast<double>(config.GetInteger("GNSS-SDR", "SignalSource.sampling_frequency", 0));
+    long header_size = config.GetInteger("GNSS-SDR", "SignalSource.header_size", 0);
+
+    // Same item types as FileSignalSource. Interleaved I/Q types carry two items per sample
+    long long item_size = 1;
+    long long items_per_sample = 1;
+    if (item_type.compare("gr_complex") == 0)
+        {
+            item_size = 8;
+        }
+    else if (item_type.compare("float") == 0)
+        {
+            item_size = 4;
+        }
+    else if (item_type.compare("short") == 0)
+        {
+            item_size = 2;
+        }
+    else if (item_type.compare("ishort") == 0)
+        {
+            item_size = 2;
+            items_per_sample = 2;
+        }
+    else if (item_type.compare("ibyte") == 0)
+        {
+            items_per_sample = 2;
+        }
+
+    // Resolved once here: the receivers run in the directories of their segments
+    if (!filename.empty())
+        {
+            filename = boost::filesystem::absolute(filename).string();
+        }
+    boost::system::error_code ec;
+    long long file_size = static_cast<long long>(boost::filesystem::file_size(filename, ec));
+    if (ec || (sampling_frequency <= 0.0))
+        {
+            std::cout << "Unable to size the capture " << filename << ". Check SignalSource.filename and SignalSource.sampling_frequency" << std::endl;
+            return 1;
+        }
+    // Leave out the last 2 ms, as the receiver does when it reads the whole file
+    long long total_samples = (file_size - header_size * item_size) / (item_size * items_per_sample)
+            - static_cast<long long>(std::ceil(0.002 * sampling_frequency));
+
+    unsigned int cores = boost::thread::hardware_concurrency();
+    unsigned int segments = (FLAGS_segments > 0) ? FLAGS_segments : cores;
+    unsigned int jobs = (FLAGS_jobs > 0) ? FLAGS_jobs : cores;
+    long long overlap_samples = static_cast<long long>(std::round(FLAGS_overlap_s * sampling_frequency));
+
+    std::vector<Replay_Segment> plan = CaptureReplay::plan_segments(total_samples, segments, overlap_samples);
+    std::cout << "Replaying " << static_cast<double>(total_samples) / sampling_frequency << " s of " << filename
+              << " in " << plan.size() << " segments, " << jobs << " at a time" << std::endl;
+
+    CaptureReplay replay(FLAGS_gnss_sdr, FLAGS_config_file, filename, FLAGS_output_dir, jobs, FLAGS_replay_speed);
+    bool success = replay.run(plan);
+
+    std::string merged = (boost::filesystem::path(FLAGS_output_dir) / "merged.obs").string();
+    if (replay.merge(plan, merged))
+        {
+            std::cout << "Merged observations written to " << merged << std::endl;
+        }
+    google::ShutDownCommandLineFlags();
+    return success ? 0 : 1;
+}